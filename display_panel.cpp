@@ -274,4 +274,16 @@ void registerTouchDriver() {
     indev_drv.read_cb = my_touchpad_read;  // ESP_Panel touch function
     indev_drv.user_data = (void *)touch;   // Pass touch instance to read function
     lv_indev_drv_register(&indev_drv);
-}
\ No newline at end of file
+}
+
+// Keep the small, frequently drawn UI images in internal RAM and the large ones in PSRAM
+static lv_img_cache_mem_t img_cache_mem_hint(const lv_img_decoder_dsc_t *dsc) {
+    uint32_t size = lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf);
+    if (size <= 16 * 1024) return LV_IMG_CACHE_MEM_INTERNAL;
+    return LV_IMG_CACHE_MEM_EXTERNAL;
+}
+
+// Configure where the image cache keeps the decoded images
+void registerImageCacheHints() {
+    lv_img_cache_set_mem_hint_cb(img_cache_mem_hint);
+}
@@ -51,5 +51,6 @@ IRAM_ATTR bool onRefreshFinishCallback(void *user_data);
 // Display driver registration
 lv_disp_t* registerDisplayDriver();
 void registerTouchDriver();
+void registerImageCacheHints();
 
 #endif
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include "mqtt_control.h"    // MQTT module
 #include "display_panel.h"   // Display Panel module
 #include "ui_events.h"       // UI Events module
+#include "ui_sounds.h"       // UI Sounds module
 
 /*Don't forget to set Sketchbook location in File/Preferences to the path of your UI project (the parent folder of this INO file)*/
 
@@ -163,10 +164,14 @@ void setup()
 
     lv_disp_t *disp = registerDisplayDriver();
     registerTouchDriver();
+    registerImageCacheHints();
 
     // Initialize UI
     ui_init();
 
+    // Initialize UI sounds (SD card and I2S output)
+    initUISounds();
+
     // Initialize WiFi
     connectToWiFi();
     
@@ -199,6 +204,8 @@ void setup()
     // Initialize screen dimming
     initializeScreenDimming();
 
+    playUISound(UI_SOUND_STARTUP);
+
     Serial.println("Setup complete - Modular Smart Home Controller with Screen Dimming!");
     Serial.println("SMOOTH ARC CONTROL ACTIVE:");
     Serial.println("- Single tap any lamp button to select it for brightness control (no visual change)");
@@ -221,6 +228,7 @@ void setup()
     Serial.println("- ui_Arc1: Controls brightness of currently selected lamp (SMOOTH & STABLE)");
     Serial.println("- ui_time: Displays current time");
     Serial.println("- ui_temp: Displays temperature from ESP32 DHT22 sensor");
+    Serial.println("- UI sounds: lamp and AC buttons play notification.wav, error.wav if MQTT is not connected");
     Serial.print("Currently selected for arc control: ");
     Serial.println(lampNames[lastSelectedLamp]);
 }
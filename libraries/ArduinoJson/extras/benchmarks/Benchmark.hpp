@@ -0,0 +1,40 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+inline std::string loadFile(const std::string& path) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file)
+    throw std::runtime_error("Can't open " + path);
+  std::stringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+// Calls the function repeatedly for at least `minDuration` seconds and returns
+// the average duration of a call in seconds
+template <typename TFunction>
+double measure(TFunction function, double minDuration = 0.2) {
+  using clock = std::chrono::steady_clock;
+  auto start = clock::now();
+  std::chrono::duration<double> elapsed(0);
+  long iterations = 0;
+  while (elapsed.count() < minDuration) {
+    function();
+    iterations++;
+    elapsed = clock::now() - start;
+  }
+  return elapsed.count() / static_cast<double>(iterations);
+}
+
+inline double megabytesPerSecond(size_t bytes, double seconds) {
+  return static_cast<double>(bytes) / seconds / 1e6;
+}
@@ -0,0 +1,33 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Returns the average duration in seconds of serializing an array that
+// contains all the values, stored as floats or as doubles.
+// Each function is compiled with a different
+// ARDUINOJSON_ENABLE_SHORTEST_FLOAT_FORMATTING
+double measureShortestFloatFormat(const std::vector<double>& values,
+                                  bool asFloats, std::string& output);
+double measureLegacyFloatFormat(const std::vector<double>& values,
+                                bool asFloats, std::string& output);
+
+#define FLOAT_FORMAT_BENCHMARK(NAME)                                        \
+  double NAME(const std::vector<double>& values, bool asFloats,            \
+              std::string& output) {                                       \
+    JsonDocument doc;                                                      \
+    for (double value : values) {                                          \
+      if (asFloats)                                                        \
+        doc.add(static_cast<float>(value));                                \
+      else                                                                 \
+        doc.add(value);                                                    \
+    }                                                                      \
+    return measure([&]() {                                                 \
+      output.clear();                                                      \
+      serializeJson(doc, output);                                          \
+    });                                                                    \
+  }
@@ -0,0 +1,10 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include "../Benchmark.hpp"
+#include "FloatFormat.hpp"
+
+FLOAT_FORMAT_BENCHMARK(measureLegacyFloatFormat)
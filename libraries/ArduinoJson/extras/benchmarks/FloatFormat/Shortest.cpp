@@ -0,0 +1,12 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_VERSION_NAMESPACE ShortestFloatFormat
+#define ARDUINOJSON_ENABLE_SHORTEST_FLOAT_FORMATTING 1
+#include <ArduinoJson.h>
+
+#include "../Benchmark.hpp"
+#include "FloatFormat.hpp"
+
+FLOAT_FORMAT_BENCHMARK(measureShortestFloatFormat)
@@ -0,0 +1,66 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+// Compares the serialization of float-heavy documents with the shortest
+// representation and with the legacy fixed number of decimal places.
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "FloatFormat.hpp"
+
+// Same values on every run
+static uint32_t nextRandom() {
+  static uint32_t state = 2463534242;
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+static std::vector<double> makeValues(int decimals, int maxExponent) {
+  std::vector<double> values;
+  for (int i = 0; i < 1000; i++) {
+    double value = nextRandom() / 4294967296.0;
+    int exponent =
+        static_cast<int>(nextRandom() % uint32_t(2 * maxExponent + 1)) -
+        maxExponent;
+    value *= pow(10, exponent);
+    if (decimals)
+      value = round(value * pow(10, decimals)) / pow(10, decimals);
+    values.push_back(value);
+  }
+  return values;
+}
+
+int main() {
+  struct {
+    const char* name;
+    bool asFloats;
+    int decimals;
+    int maxExponent;
+  } shapes[] = {
+      {"sensor", true, 2, 2},    // floats like 23.45
+      {"float", true, 0, 38},    // any float
+      {"double", false, 0, 300},  // any double
+  };
+
+  printf("%8s %20s %20s %8s\n", "values", "shortest", "legacy", "ratio");
+
+  for (auto& shape : shapes) {
+    auto values = makeValues(shape.decimals, shape.maxExponent);
+    std::string shortestOutput, legacyOutput;
+    double shortest =
+        measureShortestFloatFormat(values, shape.asFloats, shortestOutput);
+    double legacy =
+        measureLegacyFloatFormat(values, shape.asFloats, legacyOutput);
+    double n = static_cast<double>(values.size());
+    printf("%8s %6.2f Mvalue/s %4zu kB %6.2f Mvalue/s %4zu kB %7.2fx\n",
+           shape.name, n / shortest / 1e6, shortestOutput.size() / 1000,
+           n / legacy / 1e6, legacyOutput.size() / 1000, legacy / shortest);
+  }
+
+  return 0;
+}
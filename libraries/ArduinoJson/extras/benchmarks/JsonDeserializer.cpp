@@ -0,0 +1,76 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+// Compares the throughput of deserializeJson() on inputs in RAM (a const char*
+// and a std::string), which are scanned in bulk, with the same inputs read one
+// character at a time.
+
+#include <ArduinoJson.h>
+
+#include <stdio.h>
+
+#include "Benchmark.hpp"
+
+// A reader that hides the fact that the input is contiguous
+class CharByCharReader {
+ public:
+  CharByCharReader(const std::string& input)
+      : ptr_(input.c_str()), end_(ptr_ + input.size()) {}
+
+  int read() {
+    return ptr_ < end_ ? static_cast<unsigned char>(*ptr_++) : -1;
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    size_t n = 0;
+    while (n < length && ptr_ < end_)
+      buffer[n++] = *ptr_++;
+    return n;
+  }
+
+ private:
+  const char* ptr_;
+  const char* end_;
+};
+
+static void run(const char* name, const std::string& input) {
+  JsonDocument doc;
+
+  DeserializationError err = deserializeJson(doc, input.c_str());
+  if (err) {
+    // invalid inputs are part of the fuzzing corpus
+    printf("%-28s %s\n", name, err.c_str());
+    return;
+  }
+
+  double contiguous = measure([&]() { deserializeJson(doc, input.c_str()); });
+  double stdString = measure([&]() { deserializeJson(doc, input); });
+  double charByChar = measure([&]() {
+    CharByCharReader reader(input);
+    deserializeJson(doc, reader);
+  });
+
+  printf("%-28s %8zu B %10.1f MB/s %10.1f MB/s %10.1f MB/s %6.2fx\n", name,
+         input.size(), megabytesPerSecond(input.size(), contiguous),
+         megabytesPerSecond(input.size(), stdString),
+         megabytesPerSecond(input.size(), charByChar), charByChar / contiguous);
+}
+
+int main() {
+  static const char* benchmarkCorpus[] = {"ha_state.json", "ha_states.json"};
+  static const char* fuzzingCorpus[] = {
+      "Comments.json",        "Numbers.json",       "OpenWeatherMap.json",
+      "Strings.json",         "WeatherUnderground.json",
+  };
+
+  printf("%-28s %10s %15s %15s %15s %7s\n", "input", "size", "const char*",
+         "std::string", "char by char", "ratio");
+
+  for (auto name : benchmarkCorpus)
+    run(name, loadFile(std::string(BENCHMARK_CORPUS_DIR "/") + name));
+  for (auto name : fuzzingCorpus)
+    run(name, loadFile(std::string(FUZZING_CORPUS_DIR "/") + name));
+
+  return 0;
+}
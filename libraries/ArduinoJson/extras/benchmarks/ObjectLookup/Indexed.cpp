@@ -0,0 +1,14 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_VERSION_NAMESPACE IndexedLookup
+#define ARDUINOJSON_OBJECT_INDEX_THRESHOLD 16
+#include <ArduinoJson.h>
+
+#include <stdio.h>
+
+#include "../Benchmark.hpp"
+#include "ObjectLookup.hpp"
+
+OBJECT_LOOKUP_BENCHMARK(measureIndexedLookup)
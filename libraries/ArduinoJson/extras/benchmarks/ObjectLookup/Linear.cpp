@@ -0,0 +1,13 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_OBJECT_INDEX_THRESHOLD 0
+#include <ArduinoJson.h>
+
+#include <stdio.h>
+
+#include "../Benchmark.hpp"
+#include "ObjectLookup.hpp"
+
+OBJECT_LOOKUP_BENCHMARK(measureLinearLookup)
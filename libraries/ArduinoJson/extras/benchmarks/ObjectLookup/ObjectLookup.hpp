@@ -0,0 +1,29 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Returns the average duration in seconds of looking up each key once in an
+// object that contains all of them.
+// Each function is compiled with a different ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+double measureIndexedLookup(const std::vector<std::string>& keys);
+double measureLinearLookup(const std::vector<std::string>& keys);
+
+#define OBJECT_LOOKUP_BENCHMARK(NAME)                  \
+  double NAME(const std::vector<std::string>& keys) {  \
+    JsonDocument doc;                                  \
+    for (const auto& key : keys)                       \
+      doc[key] = key.size();                           \
+    size_t sum = 0;                                    \
+    double duration = measure([&]() {                  \
+      for (const auto& key : keys)                     \
+        sum += doc[key].as<size_t>();                  \
+    });                                                \
+    if (sum == 0)                                      \
+      printf("The lookups failed\n");                  \
+    return duration;                                   \
+  }
@@ -0,0 +1,34 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+// Compares the member lookup with and without the object index, for a growing
+// number of members.
+
+#include <stdio.h>
+
+#include "ObjectLookup.hpp"
+
+static std::vector<std::string> makeKeys(size_t count) {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < count; i++)
+    keys.push_back("sensor." + std::to_string(i) + ".state");
+  return keys;
+}
+
+int main() {
+  static const size_t counts[] = {8, 64, 512, 4096};
+
+  printf("%8s %18s %18s %8s\n", "members", "indexed", "linear", "ratio");
+
+  for (size_t count : counts) {
+    auto keys = makeKeys(count);
+    double indexed = measureIndexedLookup(keys);
+    double linear = measureLinearLookup(keys);
+    double n = static_cast<double>(count);
+    printf("%8zu %10.2f Mlookup/s %10.2f Mlookup/s %7.2fx\n", count,
+           n / indexed / 1e6, n / linear / 1e6, linear / indexed);
+  }
+
+  return 0;
+}
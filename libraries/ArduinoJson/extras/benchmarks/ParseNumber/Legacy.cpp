@@ -0,0 +1,12 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_VERSION_NAMESPACE LegacyParseNumber
+#define ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING 0
+#include <ArduinoJson.h>
+
+#include "../Benchmark.hpp"
+#include "ParseNumber.hpp"
+
+PARSE_NUMBER_BENCHMARK(measureLegacyParseNumber)
@@ -0,0 +1,24 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Returns the average duration in seconds of parsing all the numbers.
+// Each function is compiled with a different
+// ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING
+double measureFastParseNumber(const std::vector<std::string>& numbers);
+double measureLegacyParseNumber(const std::vector<std::string>& numbers);
+
+#define PARSE_NUMBER_BENCHMARK(NAME)                           \
+  double NAME(const std::vector<std::string>& numbers) {       \
+    using namespace ArduinoJson::detail;                       \
+    volatile double sink = 0;                                  \
+    return measure([&]() {                                     \
+      for (const auto& number : numbers)                       \
+        sink = sink + parseNumber(number.c_str()).asDouble();  \
+    });                                                        \
+  }
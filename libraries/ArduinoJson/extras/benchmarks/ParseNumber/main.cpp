@@ -0,0 +1,66 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+// Compares the float parser with and without the Eisel-Lemire algorithm, for
+// numbers of different shapes.
+
+#include <stdio.h>
+#include <math.h>
+#include <stdint.h>
+
+#include "ParseNumber.hpp"
+
+// Same numbers on every run
+static uint32_t nextRandom() {
+  static uint32_t state = 2463534242;
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+static std::vector<std::string> makeNumbers(bool fixed, int digits,
+                                            int maxExponent) {
+  std::vector<std::string> numbers;
+  char buffer[64];
+  for (int i = 0; i < 1000; i++) {
+    double mantissa = nextRandom() / 4294967296.0;
+    int exponent =
+        static_cast<int>(nextRandom() % uint32_t(2 * maxExponent + 1)) -
+        maxExponent;
+    double value = mantissa * pow(10, exponent);
+    if (fixed)
+      snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+    else
+      snprintf(buffer, sizeof(buffer), "%.*g", digits, value);
+    numbers.push_back(buffer);
+  }
+  return numbers;
+}
+
+int main() {
+  struct {
+    const char* name;
+    bool fixed;
+    int digits;
+    int maxExponent;
+  } shapes[] = {
+      {"sensor", true, 2, 2},       // like 23.45
+      {"float", false, 9, 38},      // like 1.23456789e-12
+      {"double", false, 17, 300},   // like 1.2345678901234567e+123
+  };
+
+  printf("%8s %12s %12s %8s\n", "numbers", "fast", "legacy", "ratio");
+
+  for (auto& shape : shapes) {
+    auto numbers = makeNumbers(shape.fixed, shape.digits, shape.maxExponent);
+    double fast = measureFastParseNumber(numbers);
+    double legacy = measureLegacyParseNumber(numbers);
+    printf("%8s %9.1f ns %9.1f ns %7.2fx\n", shape.name,
+           fast * 1e9 / static_cast<double>(numbers.size()),
+           legacy * 1e9 / static_cast<double>(numbers.size()), legacy / fast);
+  }
+
+  return 0;
+}
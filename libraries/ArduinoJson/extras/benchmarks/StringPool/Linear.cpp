@@ -0,0 +1,12 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_VERSION_NAMESPACE LinearStringPool
+#define ARDUINOJSON_STRING_INDEX_THRESHOLD 0
+#include <ArduinoJson.h>
+
+#include "../Benchmark.hpp"
+#include "StringPool.hpp"
+
+STRING_POOL_BENCHMARK(measureLinearStringPool)
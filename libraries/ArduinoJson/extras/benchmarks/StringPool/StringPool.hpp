@@ -0,0 +1,26 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Returns the average duration in seconds of saving each key twice in a
+// ResourceManager: the first time adds the string, the second finds it.
+// Each function is compiled with a different ARDUINOJSON_STRING_INDEX_THRESHOLD
+double measureIndexedStringPool(const std::vector<std::string>& keys);
+double measureLinearStringPool(const std::vector<std::string>& keys);
+
+#define STRING_POOL_BENCHMARK(NAME)                                \
+  double NAME(const std::vector<std::string>& keys) {              \
+    using namespace ArduinoJson::detail;                           \
+    return measure([&]() {                                         \
+      ResourceManager resources;                                   \
+      for (int pass = 0; pass < 2; pass++) {                       \
+        for (const auto& key : keys)                               \
+          resources.saveString(adaptString(key));                  \
+      }                                                            \
+    });                                                            \
+  }
@@ -0,0 +1,33 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+// Compares the string pool with and without its hash table, for a growing
+// number of distinct strings.
+
+#include <stdio.h>
+
+#include "StringPool.hpp"
+
+static std::vector<std::string> makeKeys(size_t count) {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < count; i++)
+    keys.push_back("sensor." + std::to_string(i) + ".state");
+  return keys;
+}
+
+int main() {
+  static const size_t counts[] = {10, 100, 1000, 10000};
+
+  printf("%8s %15s %15s %8s\n", "strings", "indexed", "linear", "ratio");
+
+  for (size_t count : counts) {
+    auto keys = makeKeys(count);
+    double indexed = measureIndexedStringPool(keys);
+    double linear = measureLinearStringPool(keys);
+    printf("%8zu %12.1f us %12.1f us %7.2fx\n", count, indexed * 1e6,
+           linear * 1e6, linear / indexed);
+  }
+
+  return 0;
+}
@@ -0,0 +1,15 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+// The program that the other ones are compared to: it reads the standard
+// input and writes to the standard output, without ArduinoJson.
+
+#include <stdio.h>
+
+int main() {
+  static char buffer[1024];
+  size_t n = fread(buffer, 1, sizeof(buffer), stdin);
+  fwrite(buffer, 1, n, stdout);
+  return 0;
+}
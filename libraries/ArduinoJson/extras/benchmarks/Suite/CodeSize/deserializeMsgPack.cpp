@@ -0,0 +1,17 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <stdio.h>
+
+int main() {
+  static char buffer[1024];
+  size_t n = fread(buffer, 1, sizeof(buffer), stdin);
+  JsonDocument doc;
+  deserializeMsgPack(doc, buffer, n);
+  n = doc["value"].as<size_t>();
+  fwrite(buffer, 1, n, stdout);
+  return 0;
+}
@@ -0,0 +1,71 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson.h>
+
+#include <stdlib.h>
+
+// Counts the calls to the allocator, and the bytes in use.
+// The Allocator interface doesn't pass the size to deallocate(), so each block
+// starts with its size.
+class CountingAllocator : public ArduinoJson::Allocator {
+ public:
+  virtual ~CountingAllocator() = default;
+
+  void* allocate(size_t n) override {
+    calls_++;
+    auto block = static_cast<size_t*>(malloc(sizeof(size_t) + n));
+    if (!block)
+      return nullptr;
+    *block = n;
+    grow(n);
+    return block + 1;
+  }
+
+  void deallocate(void* p) override {
+    if (!p)
+      return;
+    auto block = static_cast<size_t*>(p) - 1;
+    current_ -= *block;
+    free(block);
+  }
+
+  void* reallocate(void* p, size_t n) override {
+    if (!p)
+      return allocate(n);
+    calls_++;
+    auto block = static_cast<size_t*>(p) - 1;
+    size_t oldSize = *block;
+    block = static_cast<size_t*>(realloc(block, sizeof(size_t) + n));
+    if (!block)
+      return nullptr;
+    *block = n;
+    current_ -= oldSize;
+    grow(n);
+    return block + 1;
+  }
+
+  // Number of calls to allocate() and reallocate()
+  size_t calls() const {
+    return calls_;
+  }
+
+  // Maximum number of bytes in use at the same time
+  size_t peak() const {
+    return peak_;
+  }
+
+ private:
+  void grow(size_t n) {
+    current_ += n;
+    if (current_ > peak_)
+      peak_ = current_;
+  }
+
+  size_t calls_ = 0;
+  size_t current_ = 0;
+  size_t peak_ = 0;
+};
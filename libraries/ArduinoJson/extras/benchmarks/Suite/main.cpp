@@ -0,0 +1,273 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+// Measures, for each payload of the corpus, in JSON, MessagePack, and CBOR:
+// - the throughput of deserialization and serialization,
+// - the number of allocations and the peak memory usage of deserialization.
+// Also measures the code size of each function, as the size of a program
+// that calls it minus the size of a program that doesn't use ArduinoJson.
+//
+// Prints a table, or a JSON document with --json, to track the results over
+// time.
+
+#include <ArduinoJson.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../Benchmark.hpp"
+#include "CountingAllocator.hpp"
+
+struct Payload {
+  std::string name;
+  std::string json;
+  uint8_t nestingLimit;
+};
+
+struct Result {
+  std::string payload;
+  const char* format;
+  size_t bytes;
+  double deserializeSpeed;  // MB/s
+  double serializeSpeed;    // MB/s
+  size_t allocations;
+  size_t peakBytes;
+};
+
+static std::string makeLargeArray(int count) {
+  std::string json = "[";
+  for (int i = 0; i < count; i++) {
+    if (i)
+      json += ",";
+    json += std::to_string(i * 7919 % 100000);
+    json += ",";
+    json += std::to_string(i % 1000) + "." + std::to_string(i % 97);
+  }
+  return json + "]";
+}
+
+static std::string makeDeepNesting(int depth) {
+  std::string json;
+  for (int i = 0; i < depth; i++)
+    json += "{\"level\":" + std::to_string(i) + ",\"children\":[";
+  for (int i = 0; i < depth; i++)
+    json += "]}";
+  return json;
+}
+
+static std::vector<Payload> loadCorpus() {
+  auto load = [](const char* name) {
+    return loadFile(std::string(BENCHMARK_CORPUS_DIR "/") + name);
+  };
+  return {
+      {"mqtt_state", load("mqtt_state.json"), 10},
+      {"ha_state", load("ha_state.json"), 10},
+      {"ha_states", load("ha_states.json"), 10},
+      {"large_array", makeLargeArray(5000), 10},
+      {"deep_nesting", makeDeepNesting(100), 200},
+  };
+}
+
+template <typename TDeserialize, typename TSerialize>
+static Result run(const Payload& payload, const char* format,
+                  const std::string& input, TDeserialize deserialize,
+                  TSerialize serialize) {
+  Result result;
+  result.payload = payload.name;
+  result.format = format;
+  result.bytes = input.size();
+
+  // first parse in a new document, like most programs do
+  CountingAllocator allocator;
+  {
+    JsonDocument doc(&allocator);
+    auto err = deserialize(doc, input);
+    if (err)
+      throw std::runtime_error(payload.name + ": " + err.c_str());
+  }
+  result.allocations = allocator.calls();
+  result.peakBytes = allocator.peak();
+
+  JsonDocument doc;
+  double duration = measure([&]() { deserialize(doc, input); });
+  result.deserializeSpeed = megabytesPerSecond(input.size(), duration);
+
+  std::vector<char> output(input.size() * 2 + 16);
+  size_t outputSize = 0;
+  duration = measure(
+      [&]() { outputSize = serialize(doc, output.data(), output.size()); });
+  result.serializeSpeed = megabytesPerSecond(outputSize, duration);
+
+  return result;
+}
+
+static std::vector<Result> runAll() {
+  std::vector<Result> results;
+  for (auto& payload : loadCorpus()) {
+    DeserializationOption::NestingLimit nestingLimit(payload.nestingLimit);
+
+    results.push_back(run(
+        payload, "json", payload.json,
+        [&](JsonDocument& doc, const std::string& input) {
+          return deserializeJson(doc, input.c_str(), input.size(),
+                                 nestingLimit);
+        },
+        [](const JsonDocument& doc, char* output, size_t size) {
+          return serializeJson(doc, output, size);
+        }));
+
+    JsonDocument source;
+    deserializeJson(source, payload.json, nestingLimit);
+    std::string msgPack;
+    serializeMsgPack(source, msgPack);
+
+    results.push_back(run(
+        payload, "msgpack", msgPack,
+        [&](JsonDocument& doc, const std::string& input) {
+          return deserializeMsgPack(doc, input.data(), input.size(),
+                                    nestingLimit);
+        },
+        [](const JsonDocument& doc, char* output, size_t size) {
+          return serializeMsgPack(doc, output, size);
+        }));
+
+    std::string cbor;
+    serializeCbor(source, cbor);
+
+    results.push_back(run(
+        payload, "cbor", cbor,
+        [&](JsonDocument& doc, const std::string& input) {
+          return deserializeCbor(doc, input.data(), input.size(),
+                                 nestingLimit);
+        },
+        [](const JsonDocument& doc, char* output, size_t size) {
+          return serializeCbor(doc, output, size);
+        }));
+  }
+  return results;
+}
+
+struct CodeSize {
+  const char* function;
+  long bytes;  // -1 if unknown
+};
+
+// Returns the size of the text segment of a program, or -1 if unknown
+static long textSize(const char* program) {
+#if defined(SIZE_COMMAND) && !defined(_WIN32)
+  std::string command = std::string(SIZE_COMMAND " \"") + program + "\"";
+  FILE* pipe = popen(command.c_str(), "r");
+  if (!pipe)
+    return -1;
+  // text data bss dec hex filename
+  // 1234 ...
+  char header[256];
+  long text = -1;
+  if (!fgets(header, sizeof(header), pipe) || fscanf(pipe, "%ld", &text) != 1)
+    text = -1;
+  pclose(pipe);
+  return text;
+#else
+  (void)program;
+  return -1;
+#endif
+}
+
+static std::vector<CodeSize> measureCodeSize() {
+#ifdef CODE_SIZE_BASELINE
+  long baseline = textSize(CODE_SIZE_BASELINE);
+  auto sizeOf = [&](const char* function, const char* program) {
+    long size = textSize(program);
+    return CodeSize{function, size < 0 || baseline < 0 ? -1 : size - baseline};
+  };
+  return {
+      sizeOf("deserializeJson", CODE_SIZE_DESERIALIZE_JSON),
+      sizeOf("serializeJson", CODE_SIZE_SERIALIZE_JSON),
+      sizeOf("deserializeMsgPack", CODE_SIZE_DESERIALIZE_MSGPACK),
+      sizeOf("serializeMsgPack", CODE_SIZE_SERIALIZE_MSGPACK),
+      sizeOf("deserializeCbor", CODE_SIZE_DESERIALIZE_CBOR),
+      sizeOf("serializeCbor", CODE_SIZE_SERIALIZE_CBOR),
+  };
+#else
+  return {};
+#endif
+}
+
+static void printTable(const std::vector<Result>& results,
+                       const std::vector<CodeSize>& codeSizes) {
+  printf("%-14s %-8s %9s %12s %12s %7s %10s\n", "payload", "format", "size",
+         "deserialize", "serialize", "allocs", "peak");
+  for (auto& r : results)
+    printf("%-14s %-8s %7zu B %7.1f MB/s %7.1f MB/s %7zu %8zu B\n",
+           r.payload.c_str(), r.format, r.bytes, r.deserializeSpeed,
+           r.serializeSpeed, r.allocations, r.peakBytes);
+
+  printf("\n%-20s %10s\n", "function", "code size");
+  for (auto& c : codeSizes) {
+    if (c.bytes < 0)
+      printf("%-20s %10s\n", c.function, "?");
+    else
+      printf("%-20s %8ld B\n", c.function, c.bytes);
+  }
+}
+
+static void printJson(const std::vector<Result>& results,
+                      const std::vector<CodeSize>& codeSizes) {
+  JsonDocument doc;
+  doc["version"] = ARDUINOJSON_VERSION;
+
+  JsonObject config = doc["config"].to<JsonObject>();
+  config["ARDUINOJSON_USE_DOUBLE"] = ARDUINOJSON_USE_DOUBLE;
+  config["ARDUINOJSON_USE_LONG_LONG"] = ARDUINOJSON_USE_LONG_LONG;
+  config["ARDUINOJSON_POOL_CAPACITY"] = ARDUINOJSON_POOL_CAPACITY;
+  config["ARDUINOJSON_STRING_INDEX_THRESHOLD"] =
+      ARDUINOJSON_STRING_INDEX_THRESHOLD;
+  config["ARDUINOJSON_OBJECT_INDEX_THRESHOLD"] =
+      ARDUINOJSON_OBJECT_INDEX_THRESHOLD;
+  config["ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING"] =
+      ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING;
+  config["ARDUINOJSON_ENABLE_SHORTEST_FLOAT_FORMATTING"] =
+      ARDUINOJSON_ENABLE_SHORTEST_FLOAT_FORMATTING;
+
+  JsonArray array = doc["results"].to<JsonArray>();
+  for (auto& r : results) {
+    JsonObject obj = array.add<JsonObject>();
+    obj["payload"] = r.payload;
+    obj["format"] = r.format;
+    obj["bytes"] = r.bytes;
+    obj["deserialize_mb_per_s"] = r.deserializeSpeed;
+    obj["serialize_mb_per_s"] = r.serializeSpeed;
+    obj["allocations"] = r.allocations;
+    obj["peak_bytes"] = r.peakBytes;
+  }
+
+  JsonObject sizes = doc["code_size"].to<JsonObject>();
+  for (auto& c : codeSizes) {
+    if (c.bytes < 0)
+      sizes[c.function] = nullptr;
+    else
+      sizes[c.function] = c.bytes;
+  }
+
+  std::string output;
+  serializeJsonPretty(doc, output);
+  puts(output.c_str());
+}
+
+int main(int argc, char* argv[]) {
+  bool json = argc > 1 && strcmp(argv[1], "--json") == 0;
+
+  auto results = runAll();
+  auto codeSizes = measureCodeSize();
+
+  if (json)
+    printJson(results, codeSizes);
+  else
+    printTable(results, codeSizes);
+
+  return 0;
+}
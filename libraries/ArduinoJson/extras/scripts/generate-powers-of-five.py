@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+
+# Generates src/ArduinoJson/Numbers/PowersOfFive.hpp, the table used by
+# decimalToFloat() (Eisel-Lemire algorithm) and floatToDecimal() (Schubfach).
+#
+# Each power of five is normalized so that its most significant bit is the bit
+# 127, and stored on two 64-bit words (high word first). The negative powers
+# are rounded up, the positive powers are truncated.
+#
+# Usage: extras/scripts/generate-powers-of-five.py > src/ArduinoJson/Numbers/PowersOfFive.hpp
+
+DOUBLE_RANGE = (-342, 324)
+FLOAT_RANGE = (-64, 45)
+
+
+def power_of_five(q):
+    if q >= 0:
+        power5 = 5**q
+        while power5 < (1 << 127):
+            power5 *= 2
+        while power5 >= (1 << 128):
+            power5 //= 2
+        return power5
+    power5 = 5**-q
+    z = 0
+    while (1 << z) < power5:
+        z += 1
+    if q >= -27:
+        b = z + 127
+        c = 2**b // power5 + 1
+    else:
+        b = 2 * z + 2 * 64
+        c = 2**b // power5 + 1
+        while c >= (1 << 128):
+            c //= 2
+    return c
+
+
+def table(first, last):
+    lines = []
+    for q in range(first, last + 1):
+        c = power_of_five(q)
+        lines.append(
+            "                0x%016X, 0x%016X,  // 5^%d"
+            % (c >> 64, c & 0xFFFFFFFFFFFFFFFF, q)
+        )
+    return "\n".join(lines)
+
+
+print(
+    """// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+// This file is generated by extras/scripts/generate-powers-of-five.py
+
+#pragma once
+
+#include <ArduinoJson/Configuration.hpp>
+#include <ArduinoJson/Polyfills/pgmspace_generic.hpp>
+
+#include <stdint.h>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+#if ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING || \\
+    ARDUINOJSON_ENABLE_SHORTEST_FLOAT_FORMATTING
+
+// 128-bit approximations of the powers of five, normalized so that the most
+// significant bit is set
+struct PowersOfFive {
+#  if ARDUINOJSON_USE_DOUBLE
+  static const int16_t first = %d;
+  static const int16_t last = %d;
+#  else
+  static const int16_t first = %d;
+  static const int16_t last = %d;
+#  endif
+
+  // Returns the two words of 5^first, then 5^(first+1), etc.
+  static pgm_ptr<uint64_t> table() {
+#  if ARDUINOJSON_USE_DOUBLE
+    ARDUINOJSON_DEFINE_PROGMEM_ARRAY(  //
+        uint64_t, words,
+        {
+%s
+        });
+#  else
+    ARDUINOJSON_DEFINE_PROGMEM_ARRAY(  //
+        uint64_t, words,
+        {
+%s
+        });
+#  endif
+    return pgm_ptr<uint64_t>(words);
+  }
+};
+
+#endif
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE"""
+    % (
+        DOUBLE_RANGE[0],
+        DOUBLE_RANGE[1],
+        FLOAT_RANGE[0],
+        FLOAT_RANGE[1],
+        table(*DOUBLE_RANGE),
+        table(*FLOAT_RANGE),
+    )
+)
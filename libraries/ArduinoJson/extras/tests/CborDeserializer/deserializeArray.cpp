@@ -0,0 +1,79 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "Allocators.hpp"
+
+TEST_CASE("deserialize CBOR array") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("empty") {
+    DeserializationError error = deserializeCbor(doc, "\x80", 1);
+
+    REQUIRE(error == DeserializationError::Ok);
+    REQUIRE(doc.is<JsonArray>());
+    REQUIRE(doc.size() == 0);
+  }
+
+  SECTION("[1,2,3]") {
+    DeserializationError error = deserializeCbor(doc, "\x83\x01\x02\x03", 4);
+
+    REQUIRE(error == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[1,2,3]");
+  }
+
+  SECTION("[1,[2,3],[4,5]]") {
+    DeserializationError error =
+        deserializeCbor(doc, "\x83\x01\x82\x02\x03\x82\x04\x05", 8);
+
+    REQUIRE(error == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[1,[2,3],[4,5]]");
+  }
+
+  SECTION("25 elements") {
+    const char input[] =
+        "\x98\x19\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f"
+        "\x10\x11\x12\x13\x14\x15\x16\x17\x18\x18\x18\x19";
+
+    DeserializationError error = deserializeCbor(doc, input, sizeof(input) - 1);
+
+    REQUIRE(error == DeserializationError::Ok);
+    REQUIRE(doc.size() == 25);
+    REQUIRE(doc[0] == 1);
+    REQUIRE(doc[24] == 25);
+  }
+
+  SECTION("[\"a\",{\"b\":\"c\"}]") {
+    DeserializationError error =
+        deserializeCbor(doc, "\x82\x61\x61\xa1\x61\x62\x61\x63", 8);
+
+    REQUIRE(error == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[\"a\",{\"b\":\"c\"}]");
+  }
+
+  SECTION("empty, of indefinite length") {
+    DeserializationError error = deserializeCbor(doc, "\x9f\xff", 2);
+
+    REQUIRE(error == DeserializationError::Ok);
+    REQUIRE(doc.is<JsonArray>());
+    REQUIRE(doc.size() == 0);
+  }
+
+  SECTION("[1,[2,3],[4,5]], of indefinite length") {
+    DeserializationError error = deserializeCbor(
+        doc, "\x9f\x01\x82\x02\x03\x9f\x04\x05\xff\xff", 10);
+
+    REQUIRE(error == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[1,[2,3],[4,5]]");
+  }
+
+  SECTION("break code in an array of definite length") {
+    DeserializationError error = deserializeCbor(doc, "\x82\x01\xff", 3);
+
+    REQUIRE(error == DeserializationError::InvalidInput);
+  }
+}
@@ -0,0 +1,65 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+TEST_CASE("deserialize CBOR map") {
+  JsonDocument doc;
+
+  SECTION("empty") {
+    DeserializationError error = deserializeCbor(doc, "\xa0", 1);
+
+    REQUIRE(error == DeserializationError::Ok);
+    REQUIRE(doc.is<JsonObject>());
+    REQUIRE(doc.size() == 0);
+  }
+
+  SECTION("{\"a\":1,\"b\":[2,3]}") {
+    DeserializationError error =
+        deserializeCbor(doc, "\xa2\x61\x61\x01\x61\x62\x82\x02\x03", 9);
+
+    REQUIRE(error == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1,\"b\":[2,3]}");
+  }
+
+  SECTION("keys of 8 bytes and more") {
+    DeserializationError error = deserializeCbor(
+        doc, "\xa2\x6btemperature\x15\x68humidity\x18\x2a", 25);
+
+    REQUIRE(error == DeserializationError::Ok);
+    REQUIRE(doc["temperature"] == 21);
+    REQUIRE(doc["humidity"] == 42);
+  }
+
+  SECTION("{_ \"a\":1,\"b\":[_ 2,3]}") {
+    DeserializationError error = deserializeCbor(
+        doc, "\xbf\x61\x61\x01\x61\x62\x9f\x02\x03\xff\xff", 11);
+
+    REQUIRE(error == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1,\"b\":[2,3]}");
+  }
+
+  SECTION("{_ \"Fun\":true,\"Amt\":-2}") {
+    DeserializationError error = deserializeCbor(
+        doc, "\xbf\x63" "Fun\xf5\x63" "Amt\x21\xff", 12);
+
+    REQUIRE(error == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"Fun\":true,\"Amt\":-2}");
+  }
+
+  SECTION("key of indefinite length") {
+    DeserializationError error =
+        deserializeCbor(doc, "\xa1\x7f\x62he\x63llo\xff\x01", 11);
+
+    REQUIRE(error == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"hello\":1}");
+  }
+
+  SECTION("integer keys are not supported") {
+    DeserializationError error = deserializeCbor(doc, "\xa2\x01\x02\x03\x04", 5);
+
+    REQUIRE(error == DeserializationError::InvalidInput);
+  }
+}
@@ -0,0 +1,236 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <math.h>
+
+#include "Allocators.hpp"
+
+// The inputs come from the examples of RFC 8949, Appendix A
+
+template <typename T, size_t N>
+static void checkValue(const char (&input)[N], T expected) {
+  JsonDocument doc;
+
+  DeserializationError error = deserializeCbor(doc, input, N - 1);
+
+  REQUIRE(error == DeserializationError::Ok);
+  REQUIRE(doc.is<T>());
+  REQUIRE(doc.as<T>() == expected);
+}
+
+// Checks that the item is stored as is, so it serializes to the same bytes
+template <size_t N>
+static void checkRaw(const char (&input)[N]) {
+  JsonDocument doc;
+
+  DeserializationError error = deserializeCbor(doc, input, N - 1);
+
+  REQUIRE(error == DeserializationError::Ok);
+  std::string output;
+  serializeCbor(doc, output);
+  REQUIRE(output == std::string(input, N - 1));
+}
+
+static void checkError(size_t timebombCountDown, const char* input, size_t n,
+                       DeserializationError expected) {
+  TimebombAllocator timebomb(timebombCountDown);
+  JsonDocument doc(&timebomb);
+
+  DeserializationError error = deserializeCbor(doc, input, n);
+
+  CAPTURE(input);
+  REQUIRE(error == expected);
+}
+
+TEST_CASE("deserialize CBOR value") {
+  SECTION("unsigned integer") {
+    checkValue<int>("\x00", 0);
+    checkValue<int>("\x01", 1);
+    checkValue<int>("\x0a", 10);
+    checkValue<int>("\x17", 23);
+    checkValue<int>("\x18\x18", 24);
+    checkValue<int>("\x18\x19", 25);
+    checkValue<int>("\x18\x64", 100);
+    checkValue<int>("\x19\x03\xe8", 1000);
+    checkValue<uint32_t>("\x1a\x00\x0f\x42\x40", 1000000);
+    checkValue<uint32_t>("\x1a\xff\xff\xff\xff", 0xFFFFFFFF);
+  }
+
+  SECTION("unsigned integer 64") {
+#if ARDUINOJSON_USE_LONG_LONG
+    checkValue<uint64_t>("\x1b\x00\x00\x00\xe8\xd4\xa5\x10\x00",
+                         1000000000000U);
+    checkValue<uint64_t>("\x1b\xff\xff\xff\xff\xff\xff\xff\xff",
+                         0xFFFFFFFFFFFFFFFFU);
+#else
+    checkValue("\x1b\x00\x00\x00\xe8\xd4\xa5\x10\x00", nullptr);
+    checkValue("\x1b\xff\xff\xff\xff\xff\xff\xff\xff", nullptr);
+#endif
+  }
+
+  SECTION("negative integer") {
+    checkValue<int>("\x20", -1);
+    checkValue<int>("\x29", -10);
+    checkValue<int>("\x38\x63", -100);
+    checkValue<int>("\x39\x03\xe7", -1000);
+    checkValue<int32_t>("\x3a\x7f\xff\xff\xff", -2147483648);
+  }
+
+  SECTION("negative integer 64") {
+#if ARDUINOJSON_USE_LONG_LONG
+    checkValue<int64_t>("\x3b\x7f\xff\xff\xff\xff\xff\xff\xff",
+                        -9223372036854775807LL - 1);
+#else
+    checkValue("\x3b\x7f\xff\xff\xff\xff\xff\xff\xff", nullptr);
+#endif
+    // -18446744073709551616 doesn't fit
+    checkValue("\x3b\xff\xff\xff\xff\xff\xff\xff\xff", nullptr);
+  }
+
+  SECTION("half-precision float") {
+    checkValue<double>("\xf9\x00\x00", 0.0);
+    checkValue<double>("\xf9\x80\x00", -0.0);
+    checkValue<double>("\xf9\x3c\x00", 1.0);
+    checkValue<double>("\xf9\x3e\x00", 1.5);
+    checkValue<double>("\xf9\x7b\xff", 65504.0);
+    checkValue<double>("\xf9\x00\x01", 5.960464477539063e-8);
+    checkValue<double>("\xf9\x04\x00", 0.00006103515625);
+    checkValue<double>("\xf9\xc4\x00", -4.0);
+  }
+
+  SECTION("single-precision float") {
+    checkValue<double>("\xfa\x47\xc3\x50\x00", 100000.0);
+    checkValue<float>("\xfa\x7f\x7f\xff\xff", 3.4028234663852886e+38f);
+  }
+
+  SECTION("double-precision float") {
+    checkValue<double>("\xfb\x3f\xf1\x99\x99\x99\x99\x99\x9a", 1.1);
+    checkValue<double>("\xfb\x7e\x37\xe4\x3c\x88\x00\x75\x9c", 1.0e+300);
+    checkValue<double>("\xfb\xc0\x10\x66\x66\x66\x66\x66\x66", -4.1);
+  }
+
+  SECTION("infinity and NaN") {
+    JsonDocument doc;
+
+    deserializeCbor(doc, "\xf9\x7c\x00", 3);
+    REQUIRE(isinf(doc.as<double>()));
+    REQUIRE(doc.as<double>() > 0);
+
+    deserializeCbor(doc, "\xf9\xfc\x00", 3);
+    REQUIRE(isinf(doc.as<double>()));
+    REQUIRE(doc.as<double>() < 0);
+
+    deserializeCbor(doc, "\xf9\x7e\x00", 3);
+    REQUIRE(isnan(doc.as<double>()));
+
+    deserializeCbor(doc, "\xfa\x7f\xc0\x00\x00", 5);
+    REQUIRE(isnan(doc.as<double>()));
+
+    deserializeCbor(doc, "\xfb\x7f\xf0\x00\x00\x00\x00\x00\x00", 9);
+    REQUIRE(isinf(doc.as<double>()));
+  }
+
+  SECTION("simple values") {
+    checkValue<bool>("\xf4", false);
+    checkValue<bool>("\xf5", true);
+    checkValue("\xf6", nullptr);  // null
+    checkValue("\xf7", nullptr);  // undefined
+    checkValue("\xf0", nullptr);  // simple(16)
+    checkValue("\xf8\xff", nullptr);  // simple(255)
+  }
+
+  SECTION("text string") {
+    checkValue<std::string>("\x60", "");
+    checkValue<std::string>("\x61\x61", "a");
+    checkValue<std::string>("\x64IETF", "IETF");
+    checkValue<std::string>("\x62\x22\x5c", "\"\\");
+    checkValue<std::string>("\x62\xc3\xbc", "\xc3\xbc");
+    checkValue<std::string>("\x63\xe6\xb0\xb4", "\xe6\xb0\xb4");
+    checkValue<std::string>("\x78\x1a" "abcdefghijklmnopqrstuvwxyz",
+                            "abcdefghijklmnopqrstuvwxyz");
+    checkValue<std::string>("\x79\x00\x05hello", "hello");
+    checkValue<std::string>("\x7a\x00\x00\x00\x05hello", "hello");
+  }
+
+  SECTION("text string of indefinite length") {
+    checkValue<std::string>("\x7f\x65strea\x64ming\xff", "streaming");
+    checkValue<std::string>("\x7f\xff", "");
+    checkValue<std::string>("\x7f\x60\x61\x61\x60\xff", "a");
+  }
+
+  SECTION("text string with NUL") {
+    checkValue<std::string>("\x63" "a\0b", std::string("a\0b", 3));
+  }
+
+  SECTION("byte string") {
+    checkRaw("\x40");
+    checkRaw("\x44\x01\x02\x03\x04");
+    checkRaw("\x58\x02\x01\x02");
+  }
+
+  SECTION("byte string of indefinite length") {
+    checkRaw("\x5f\x42\x01\x02\x43\x03\x04\x05\xff");
+    checkRaw("\x5f\xff");
+  }
+
+  SECTION("tags are ignored") {
+    checkValue<std::string>(
+        "\xc0\x74" "2013-03-21T20:04:00Z", "2013-03-21T20:04:00Z");
+    checkValue<uint32_t>("\xc1\x1a\x51\x4b\x67\xb0", 1363896240);
+    checkValue<double>("\xc1\xfb\x41\xd4\x52\xd9\xec\x20\x00\x00",
+                       1363896240.5);
+    checkValue<std::string>(
+        "\xd8\x20\x76http://www.example.com", "http://www.example.com");
+    checkValue<int>("\xc2\xc3\x01", 1);  // nested tags
+  }
+
+  SECTION("tagged byte string") {
+    JsonDocument doc;
+    DeserializationError error =
+        deserializeCbor(doc, "\xd7\x44\x01\x02\x03\x04", 6);
+    REQUIRE(error == DeserializationError::Ok);
+
+    std::string output;
+    serializeCbor(doc, output);
+    REQUIRE(output == "\x44\x01\x02\x03\x04");  // the tag is lost
+  }
+}
+
+TEST_CASE("deserializeCbor() under memory constaints") {
+  SECTION("single-precision float") {
+    checkError(0, "\xfa\x47\xc3\x50\x00", 5, DeserializationError::Ok);
+  }
+
+  SECTION("double-precision float") {
+#if ARDUINOJSON_USE_DOUBLE
+    checkError(0, "\xfb\x3f\xf1\x99\x99\x99\x99\x99\x9a", 9,
+               DeserializationError::NoMemory);
+#endif
+    checkError(1, "\xfb\x3f\xf1\x99\x99\x99\x99\x99\x9a", 9,
+               DeserializationError::Ok);
+  }
+
+  SECTION("text string") {
+    checkError(0, "\x63" "abc", 4, DeserializationError::NoMemory);
+    checkError(1, "\x63" "abc", 4, DeserializationError::Ok);  // tiny string
+    checkError(0, "\x68" "ArduinoJ", 9, DeserializationError::NoMemory);
+    checkError(1, "\x68" "ArduinoJ", 9, DeserializationError::Ok);
+  }
+
+  SECTION("text string of indefinite length") {
+    checkError(0, "\x7f\x65strea\x64ming\xff", 13,
+               DeserializationError::NoMemory);
+    checkError(1, "\x7f\x65strea\x64ming\xff", 13,
+               DeserializationError::NoMemory);
+    checkError(3, "\x7f\x65strea\x64ming\xff", 13, DeserializationError::Ok);
+  }
+
+  SECTION("byte string") {
+    checkError(0, "\x44\x01\x02\x03\x04", 5, DeserializationError::NoMemory);
+    checkError(1, "\x44\x01\x02\x03\x04", 5, DeserializationError::Ok);
+  }
+}
@@ -0,0 +1,129 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+
+template <size_t N>
+static void checkInvalidInput(const char (&input)[N]) {
+  JsonDocument doc;
+  auto err = deserializeCbor(doc, input, N - 1);
+  CAPTURE(input);
+  REQUIRE(err == DeserializationError::InvalidInput);
+}
+
+TEST_CASE("deserializeCbor() returns InvalidInput") {
+  SECTION("reserved additional information") {
+    checkInvalidInput("\x1c");
+    checkInvalidInput("\x3d");
+    checkInvalidInput("\xfe");
+  }
+
+  SECTION("indefinite length of an integer, a tag, or a simple value") {
+    checkInvalidInput("\x1f");
+    checkInvalidInput("\x3f");
+    checkInvalidInput("\xdf\x01");
+  }
+
+  SECTION("unexpected break code") {
+    checkInvalidInput("\xff");
+    checkInvalidInput("\x81\xff");
+    checkInvalidInput("\xa1\x61" "a\xff");
+  }
+
+  SECTION("chunk of the wrong type") {
+    checkInvalidInput("\x7f\x41\x61\xff");
+    checkInvalidInput("\x5f\x61\x61\xff");
+    checkInvalidInput("\x7f\x01\xff");
+  }
+
+  SECTION("chunk of indefinite length") {
+    checkInvalidInput("\x7f\x7f\xff\xff");
+    checkInvalidInput("\x5f\x5f\xff\xff");
+  }
+
+  SECTION("keys that are not text strings") {
+    checkInvalidInput("\xa1\x01\x02");
+    checkInvalidInput("\xa1\x41\x61\x02");
+    checkInvalidInput("\xa1\xc1\x61\x61\x02");
+  }
+}
+
+TEST_CASE("deserializeCbor() returns EmptyInput") {
+  JsonDocument doc;
+
+  SECTION("from sized buffer") {
+    auto err = deserializeCbor(doc, "", 0);
+
+    REQUIRE(err == DeserializationError::EmptyInput);
+  }
+
+  SECTION("from stream") {
+    std::istringstream input("");
+
+    auto err = deserializeCbor(doc, input);
+
+    REQUIRE(err == DeserializationError::EmptyInput);
+  }
+}
+
+template <size_t N>
+static void testIncompleteInput(const char (&input)[N]) {
+  size_t len = N - 1;
+  JsonDocument doc;
+  REQUIRE(deserializeCbor(doc, input, len) == DeserializationError::Ok);
+
+  while (--len) {
+    CAPTURE(len);
+    REQUIRE(deserializeCbor(doc, input, len) ==
+            DeserializationError::IncompleteInput);
+  }
+}
+
+TEST_CASE("deserializeCbor() returns IncompleteInput") {
+  SECTION("unsigned integer") {
+    testIncompleteInput("\x18\x18");
+    testIncompleteInput("\x19\x03\xe8");
+    testIncompleteInput("\x1a\x00\x0f\x42\x40");
+    testIncompleteInput("\x1b\x00\x00\x00\xe8\xd4\xa5\x10\x00");
+  }
+
+  SECTION("negative integer") {
+    testIncompleteInput("\x39\x03\xe7");
+  }
+
+  SECTION("floats") {
+    testIncompleteInput("\xf9\x3c\x00");
+    testIncompleteInput("\xfa\x47\xc3\x50\x00");
+    testIncompleteInput("\xfb\x3f\xf1\x99\x99\x99\x99\x99\x9a");
+  }
+
+  SECTION("text string") {
+    testIncompleteInput("\x64IETF");
+    testIncompleteInput("\x78\x04IETF");
+    testIncompleteInput("\x7f\x65strea\x64ming\xff");
+  }
+
+  SECTION("byte string") {
+    testIncompleteInput("\x44\x01\x02\x03\x04");
+    testIncompleteInput("\x5f\x42\x01\x02\x43\x03\x04\x05\xff");
+  }
+
+  SECTION("array") {
+    testIncompleteInput("\x82\x01\x02");
+    testIncompleteInput("\x98\x02\x01\x02");
+    testIncompleteInput("\x9f\x01\x02\xff");
+  }
+
+  SECTION("map") {
+    testIncompleteInput("\xa1\x63one\x01");
+    testIncompleteInput("\xbf\x63one\x01\xff");
+  }
+
+  SECTION("tag") {
+    testIncompleteInput("\xd8\x20\x61H");
+  }
+}
@@ -0,0 +1,192 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+
+#include "Allocators.hpp"
+#include "Literals.hpp"
+
+using namespace ArduinoJson::detail;
+
+TEST_CASE("deserializeCbor() filter") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+  DeserializationError error;
+
+  JsonDocument filter;
+  DeserializationOption::Filter filterOpt(filter);
+
+  SECTION("root is a map") {
+    SECTION("filter = {include:true,ignore:false)") {
+      filter["include"] = true;
+      filter["ignore"] = false;
+
+      // {"ignore":<value>,"include":42}
+      auto check = [&](const std::string& value) {
+        std::string input =
+            "\xa2\x66ignore"_s + value + "\x67include\x18\x2a"_s;
+        CAPTURE(input);
+
+        error = deserializeCbor(doc, input, filterOpt);
+
+        CHECK(error == DeserializationError::Ok);
+        CHECK(doc.as<std::string>() == "{\"include\":42}");
+      };
+
+      SECTION("skip integers") {
+        check("\x00"_s);
+        check("\x18\x18"_s);
+        check("\x1b\x00\x00\x00\xe8\xd4\xa5\x10\x00"_s);
+        check("\x39\x03\xe7"_s);
+      }
+
+      SECTION("skip simple values and floats") {
+        check("\xf4"_s);
+        check("\xf6"_s);
+        check("\xf8\xff"_s);
+        check("\xf9\x3c\x00"_s);
+        check("\xfa\x47\xc3\x50\x00"_s);
+        check("\xfb\x3f\xf1\x99\x99\x99\x99\x99\x9a"_s);
+      }
+
+      SECTION("skip strings") {
+        check("\x64IETF"_s);
+        check("\x79\x00\x04IETF"_s);
+        check("\x7f\x65strea\x64ming\xff"_s);
+        check("\x44\x01\x02\x03\x04"_s);
+        check("\x5f\x42\x01\x02\x43\x03\x04\x05\xff"_s);
+      }
+
+      SECTION("skip collections") {
+        check("\x83\x01\x82\x02\x03\x82\x04\x05"_s);
+        check("\x9f\x01\x9f\x02\xff\xff"_s);
+        check("\xa1\x61\x61\xa1\x61\x62\x01"_s);
+        check("\xbf\x61\x61\x01\xff"_s);
+      }
+
+      SECTION("skip tagged values") {
+        check("\xc1\x1a\x51\x4b\x67\xb0"_s);
+        check("\xd8\x20\x61H"_s);
+      }
+
+      SECTION("skipped strings are not allocated") {
+        error = deserializeCbor(
+            doc, "\xa2\x66ignore\x68" "ArduinoJ\x67include\x18\x2a", 27,
+            filterOpt);
+
+        CHECK(error == DeserializationError::Ok);
+        CHECK(spy.log() == AllocatorLog{
+                               Allocate(sizeofString("ignore")),
+                               Deallocate(sizeofString("ignore")),
+                               Allocate(sizeofString("include")),
+                               Allocate(sizeofPool()),
+                               Reallocate(sizeofPool(), sizeofObject(1)),
+                           });
+      }
+
+      SECTION("input truncated in a skipped string") {
+        error = deserializeCbor(doc, "\xa2\x66ignore\x68" "Ardu", 13, filterOpt);
+
+        CHECK(error == DeserializationError::IncompleteInput);
+        CHECK(doc.as<std::string>() == "{}");
+      }
+
+      SECTION("invalid skipped value") {
+        error = deserializeCbor(doc, "\xa2\x66ignore\x1c", 9, filterOpt);
+
+        CHECK(error == DeserializationError::InvalidInput);
+      }
+    }
+  }
+
+  SECTION("root is an array") {
+    SECTION("filter = [false]") {
+      filter[0] = false;
+
+      error = deserializeCbor(doc, "\x83\x01\x02\x03", 4, filterOpt);
+
+      CHECK(error == DeserializationError::Ok);
+      CHECK(doc.as<std::string>() == "[]");
+      CHECK(spy.log() == AllocatorLog());
+    }
+
+    SECTION("filter = [true]") {
+      filter[0] = true;
+
+      error = deserializeCbor(doc, "\x9f\x01\x02\x03\xff", 5, filterOpt);
+
+      CHECK(error == DeserializationError::Ok);
+      CHECK(doc.as<std::string>() == "[1,2,3]");
+    }
+
+    SECTION("filter = [{value:true}]") {
+      filter[0]["value"] = true;
+
+      error = deserializeCbor(
+          doc, "\x82\xa2\x65value\x01\x62id\x02\xa1\x62id\x03", 19,
+          filterOpt);
+
+      CHECK(error == DeserializationError::Ok);
+      CHECK(doc.as<std::string>() == "[{\"value\":1},{}]");
+    }
+  }
+
+  SECTION("filter = false") {
+    filter.set(false);
+
+    SECTION("input = array") {
+      error = deserializeCbor(doc, "\x82\x01\x02", 3, filterOpt);
+
+      CHECK(error == DeserializationError::Ok);
+      CHECK(doc.isNull() == true);
+    }
+
+    SECTION("array too deep") {
+      error = deserializeCbor(doc, "\x81\x81\x81\x81\x81", 5, filterOpt,
+                              DeserializationOption::NestingLimit(4));
+
+      CHECK(error == DeserializationError::TooDeep);
+    }
+
+    SECTION("map too deep") {
+      error = deserializeCbor(
+          doc, "\xa1\x61z\xa1\x61z\xa1\x61z\xa1\x61z\xa1\x61z", 15, filterOpt,
+          DeserializationOption::NestingLimit(4));
+
+      CHECK(error == DeserializationError::TooDeep);
+    }
+  }
+}
+
+TEST_CASE("deserializeCbor() overloads") {
+  JsonDocument doc;
+  JsonDocument filter;
+
+  using namespace DeserializationOption;
+
+  SECTION("const char*, size_t, Filter") {
+    deserializeCbor(doc, "\xa0", 1, Filter(filter));
+  }
+
+  SECTION("const std::string&, Filter") {
+    deserializeCbor(doc, "\xa0"_s, Filter(filter));
+  }
+
+  SECTION("std::istream&, Filter") {
+    std::stringstream s("\xa0");
+    deserializeCbor(doc, s, Filter(filter));
+  }
+
+  SECTION("const char*, size_t, Filter, NestingLimit") {
+    deserializeCbor(doc, "\xa0", 1, Filter(filter), NestingLimit(5));
+  }
+
+  SECTION("std::istream&, NestingLimit, Filter") {
+    std::stringstream s("\xa0");
+    deserializeCbor(doc, s, NestingLimit(5), Filter(filter));
+  }
+}
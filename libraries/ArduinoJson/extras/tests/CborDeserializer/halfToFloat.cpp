@@ -0,0 +1,38 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <math.h>
+
+using namespace ArduinoJson::detail;
+
+TEST_CASE("halfToFloat()") {
+  SECTION("zero") {
+    CHECK(halfToFloat(0x0000) == 0.0f);
+    CHECK(signbit(halfToFloat(0x8000)));
+  }
+
+  SECTION("normal numbers") {
+    CHECK(halfToFloat(0x3c00) == 1.0f);
+    CHECK(halfToFloat(0x3e00) == 1.5f);
+    CHECK(halfToFloat(0xc400) == -4.0f);
+    CHECK(halfToFloat(0x7bff) == 65504.0f);
+    CHECK(halfToFloat(0x0400) == 0.00006103515625f);
+    CHECK(halfToFloat(0x3555) == 0.333251953125f);
+  }
+
+  SECTION("subnormal numbers") {
+    CHECK(halfToFloat(0x0001) == 5.9604644775390625e-8f);
+    CHECK(halfToFloat(0x03ff) == 0.00006097555160522461f);
+    CHECK(halfToFloat(0x8001) == -5.9604644775390625e-8f);
+  }
+
+  SECTION("infinity and NaN") {
+    CHECK(isinf(halfToFloat(0x7c00)));
+    CHECK(halfToFloat(0xfc00) < 0);
+    CHECK(isnan(halfToFloat(0x7e00)));
+  }
+}
@@ -0,0 +1,58 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+
+#define SHOULD_WORK(expression) REQUIRE(DeserializationError::Ok == expression);
+#define SHOULD_FAIL(expression) \
+  REQUIRE(DeserializationError::TooDeep == expression);
+
+TEST_CASE("deserializeCbor() nesting") {
+  JsonDocument doc;
+
+  SECTION("char* and size_t") {
+    SECTION("limit = 0") {
+      DeserializationOption::NestingLimit nesting(0);
+      SHOULD_WORK(deserializeCbor(doc, "\x61H", 2, nesting));  // "H"
+      SHOULD_FAIL(deserializeCbor(doc, "\x80", 1, nesting));   // []
+      SHOULD_FAIL(deserializeCbor(doc, "\xa0", 1, nesting));   // {}
+      SHOULD_FAIL(deserializeCbor(doc, "\x9f\xff", 2, nesting));
+    }
+
+    SECTION("limit = 1") {
+      DeserializationOption::NestingLimit nesting(1);
+      SHOULD_WORK(deserializeCbor(doc, "\x80", 1, nesting));  // []
+      SHOULD_WORK(deserializeCbor(doc, "\xa0", 1, nesting));  // {}
+      SHOULD_FAIL(deserializeCbor(doc, "\xa1\x61H\xa0", 4, nesting));  // {H:{}}
+      SHOULD_FAIL(deserializeCbor(doc, "\x81\x80", 2, nesting));  // [[]]
+      SHOULD_FAIL(deserializeCbor(doc, "\x9f\x9f\xff\xff", 4, nesting));
+    }
+
+    SECTION("tags don't count") {
+      DeserializationOption::NestingLimit nesting(1);
+      SHOULD_WORK(deserializeCbor(doc, "\xc1\x81\xc1\x01", 4, nesting));
+    }
+  }
+
+  SECTION("Input = std::istream") {
+    SECTION("limit = 0") {
+      DeserializationOption::NestingLimit nesting(0);
+      std::istringstream good("\x61H");  // "H"
+      std::istringstream bad("\x80");    // []
+      SHOULD_WORK(deserializeCbor(doc, good, nesting));
+      SHOULD_FAIL(deserializeCbor(doc, bad, nesting));
+    }
+
+    SECTION("limit = 1") {
+      DeserializationOption::NestingLimit nesting(1);
+      std::istringstream good("\x80");     // []
+      std::istringstream bad("\x81\x80");  // [[]]
+      SHOULD_WORK(deserializeCbor(doc, good, nesting));
+      SHOULD_FAIL(deserializeCbor(doc, bad, nesting));
+    }
+  }
+}
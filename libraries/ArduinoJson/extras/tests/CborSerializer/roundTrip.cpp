@@ -0,0 +1,30 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+static void checkRoundTrip(const char* json) {
+  JsonDocument doc;
+  REQUIRE(deserializeJson(doc, json) == DeserializationError::Ok);
+
+  std::string cbor;
+  serializeCbor(doc, cbor);
+  REQUIRE(cbor.size() == measureCbor(doc));
+
+  JsonDocument copy;
+  REQUIRE(deserializeCbor(copy, cbor) == DeserializationError::Ok);
+  REQUIRE(copy == doc);
+  REQUIRE(copy.as<std::string>() == json);
+}
+
+TEST_CASE("serializeCbor() then deserializeCbor()") {
+  checkRoundTrip("null");
+  checkRoundTrip("[true,false,null]");
+  checkRoundTrip("[0,-1,23,-24,24,-25,65536,-65537,4294967295]");
+  checkRoundTrip("[0.5,-1.25,3.14159,1e300]");
+  checkRoundTrip("{\"state\":\"ON\",\"brightness\":254,\"color\":"
+                 "{\"x\":0.4573,\"y\":0.41},\"linkquality\":120}");
+  checkRoundTrip("[[[[[]]]],{\"a\":{\"b\":{\"c\":{}}}}]");
+}
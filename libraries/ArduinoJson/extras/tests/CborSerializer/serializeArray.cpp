@@ -0,0 +1,59 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+static void check(const JsonArray array, const char* expected_data,
+                  size_t expected_len) {
+  std::string expected(expected_data, expected_data + expected_len);
+  std::string actual;
+  size_t len = serializeCbor(array, actual);
+  CAPTURE(array);
+  REQUIRE(len == expected_len);
+  REQUIRE(actual == expected);
+}
+
+template <size_t N>
+static void check(const JsonArray array, const char (&expected_data)[N]) {
+  const size_t expected_len = N - 1;
+  check(array, expected_data, expected_len);
+}
+
+TEST_CASE("serialize CBOR array") {
+  JsonDocument doc;
+  JsonArray array = doc.to<JsonArray>();
+
+  SECTION("empty") {
+    check(array, "\x80");
+  }
+
+  SECTION("[1,[2,3],[4,5]]") {
+    array.add(1);
+    JsonArray a = array.add<JsonArray>();
+    a.add(2);
+    a.add(3);
+    JsonArray b = array.add<JsonArray>();
+    b.add(4);
+    b.add(5);
+
+    check(array, "\x83\x01\x82\x02\x03\x82\x04\x05");
+  }
+
+  SECTION("25 elements") {
+    for (int i = 1; i <= 25; i++)
+      array.add(i);
+
+    check(array,
+          "\x98\x19\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e"
+          "\x0f\x10\x11\x12\x13\x14\x15\x16\x17\x18\x18\x18\x19");
+  }
+
+  SECTION("[\"a\",{\"b\":\"c\"}]") {
+    array.add("a");
+    array.add<JsonObject>()["b"] = "c";
+
+    check(array, "\x82\x61\x61\xa1\x61\x62\x61\x63");
+  }
+}
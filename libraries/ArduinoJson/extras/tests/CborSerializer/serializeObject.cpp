@@ -0,0 +1,60 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <stdio.h>
+#include <catch.hpp>
+
+static void check(const JsonObject object, const char* expected_data,
+                  size_t expected_len) {
+  std::string expected(expected_data, expected_data + expected_len);
+  std::string actual;
+  size_t len = serializeCbor(object, actual);
+  CAPTURE(object);
+  REQUIRE(len == expected_len);
+  REQUIRE(actual == expected);
+}
+
+template <size_t N>
+static void check(const JsonObject object, const char (&expected_data)[N]) {
+  const size_t expected_len = N - 1;
+  check(object, expected_data, expected_len);
+}
+
+TEST_CASE("serialize CBOR map") {
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  SECTION("empty") {
+    check(object, "\xa0");
+  }
+
+  SECTION("{\"a\":1,\"b\":[2,3]}") {
+    object["a"] = 1;
+    JsonArray b = object["b"].to<JsonArray>();
+    b.add(2);
+    b.add(3);
+
+    check(object, "\xa2\x61\x61\x01\x61\x62\x82\x02\x03");
+  }
+
+  SECTION("24 members") {
+    std::string expected = "\xb8\x18";
+    for (int i = 0; i < 24; ++i) {
+      char key[4];
+      snprintf(key, sizeof(key), "k%c", 'A' + i);
+      object[key] = i;
+      expected += '\x62';
+      expected += key;
+      expected += char(i);
+    }
+
+    check(object, expected.data(), expected.size());
+  }
+
+  SECTION("serialized(const char*)") {
+    object["hello"] = serialized("\x44\x01\x02\x03\x04", 5);
+    check(object, "\xa1\x65hello\x44\x01\x02\x03\x04");
+  }
+}
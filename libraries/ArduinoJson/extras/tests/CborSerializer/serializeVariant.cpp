@@ -0,0 +1,129 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "Literals.hpp"
+
+// The expected outputs come from the examples of RFC 8949, Appendix A
+
+template <typename T>
+static void checkVariant(T value, const char* expected_data,
+                         size_t expected_len) {
+  JsonDocument doc;
+  JsonVariant variant = doc.to<JsonVariant>();
+  variant.set(value);
+  std::string expected(expected_data, expected_data + expected_len);
+  std::string actual;
+  size_t len = serializeCbor(variant, actual);
+  CAPTURE(variant);
+  REQUIRE(len == expected_len);
+  REQUIRE(actual == expected);
+}
+
+template <typename T, size_t N>
+static void checkVariant(T value, const char (&expected_data)[N]) {
+  const size_t expected_len = N - 1;
+  checkVariant(value, expected_data, expected_len);
+}
+
+TEST_CASE("serialize CBOR value") {
+  SECTION("unbound") {
+    checkVariant(JsonVariant(), "\xf6");  // we represent undefined as null
+  }
+
+  SECTION("null") {
+    const char* nil = 0;  // ArduinoJson uses a string for null
+    checkVariant(nil, "\xf6");
+  }
+
+  SECTION("bool") {
+    checkVariant(false, "\xf4");
+    checkVariant(true, "\xf5");
+  }
+
+  SECTION("unsigned integer") {
+    checkVariant(0, "\x00");
+    checkVariant(1, "\x01");
+    checkVariant(10, "\x0a");
+    checkVariant(23, "\x17");
+    checkVariant(24, "\x18\x18");
+    checkVariant(25U, "\x18\x19");
+    checkVariant(100, "\x18\x64");
+    checkVariant(255, "\x18\xff");
+    checkVariant(256, "\x19\x01\x00");
+    checkVariant(1000, "\x19\x03\xe8");
+    checkVariant(65535U, "\x19\xff\xff");
+    checkVariant(65536, "\x1a\x00\x01\x00\x00");
+    checkVariant(1000000, "\x1a\x00\x0f\x42\x40");
+    checkVariant(0xFFFFFFFFU, "\x1a\xff\xff\xff\xff");
+  }
+
+  SECTION("unsigned integer 64") {
+#if ARDUINOJSON_USE_LONG_LONG
+    checkVariant(1000000000000U, "\x1b\x00\x00\x00\xe8\xd4\xa5\x10\x00");
+    checkVariant(0xFFFFFFFFFFFFFFFFU, "\x1b\xff\xff\xff\xff\xff\xff\xff\xff");
+#endif
+  }
+
+  SECTION("negative integer") {
+    checkVariant(-1, "\x20");
+    checkVariant(-10, "\x29");
+    checkVariant(-24, "\x37");
+    checkVariant(-25, "\x38\x18");
+    checkVariant(-100, "\x38\x63");
+    checkVariant(-256, "\x38\xff");
+    checkVariant(-257, "\x39\x01\x00");
+    checkVariant(-1000, "\x39\x03\xe7");
+    checkVariant(-2147483647 - 1, "\x3a\x7f\xff\xff\xff");
+  }
+
+  SECTION("negative integer 64") {
+#if ARDUINOJSON_USE_LONG_LONG
+    checkVariant(int64_t(-4294967297), "\x3b\x00\x00\x00\x01\x00\x00\x00\x00");
+    checkVariant(int64_t(-9223372036854775807LL - 1),
+                 "\x3b\x7f\xff\xff\xff\xff\xff\xff\xff");
+#endif
+  }
+
+  SECTION("float") {
+    checkVariant(0.0f, "\x00");  // integral values are written as integers
+    checkVariant(1.5f, "\xfa\x3f\xc0\x00\x00");
+    checkVariant(100000.5f, "\xfa\x47\xc3\x50\x40");
+    checkVariant(3.4028234663852886e+38f, "\xfa\x7f\x7f\xff\xff");
+  }
+
+  SECTION("double") {
+    checkVariant(-4.0, "\x23");
+    checkVariant(1.5, "\xfa\x3f\xc0\x00\x00");  // fits in a float
+    checkVariant(1.1, "\xfb\x3f\xf1\x99\x99\x99\x99\x99\x9a");
+    checkVariant(-4.1, "\xfb\xc0\x10\x66\x66\x66\x66\x66\x66");
+    checkVariant(1.0e+300, "\xfb\x7e\x37\xe4\x3c\x88\x00\x75\x9c");
+  }
+
+  SECTION("text string") {
+    checkVariant("", "\x60");
+    checkVariant("a", "\x61\x61");
+    checkVariant("IETF", "\x64IETF");
+    checkVariant("\"\\", "\x62\x22\x5c");
+    checkVariant("\xc3\xbc", "\x62\xc3\xbc");
+    checkVariant("abcdefghijklmnopqrstuvwxyz",
+                 "\x78\x1a"
+                 "abcdefghijklmnopqrstuvwxyz");
+  }
+
+  SECTION("text string of 256 bytes") {
+    std::string value(256, '?');
+    checkVariant(value, ("\x79\x01\x00"_s + value).c_str(), 259);
+  }
+
+  SECTION("text string with NUL") {
+    checkVariant("a\0b"_s, "\x63" "a\0b");
+  }
+
+  SECTION("serialized(const char*)") {
+    checkVariant(serialized("\x44\x01\x02\x03\x04"), "\x44\x01\x02\x03\x04");
+  }
+}
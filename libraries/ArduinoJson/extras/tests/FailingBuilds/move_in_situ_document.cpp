@@ -0,0 +1,15 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+// The strings of an InSituJsonDocument point to its buffer, so it must not be
+// moved to a JsonDocument that could outlive the buffer
+
+int main() {
+  char input[] = "{\"hello\":\"world\"}";
+  InSituJsonDocument doc(input);
+  deserializeJson(doc);
+  JsonDocument other(std::move(doc));
+}
@@ -24,9 +24,7 @@ TEST_CASE("deserializeJson(JsonDocument&)") {
   REQUIRE(err == DeserializationError::Ok);
   REQUIRE(doc.as<std::string>() == "[42]");
   REQUIRE(spy.log() == AllocatorLog{
-                           Deallocate(sizeofPool()),
                            Deallocate(sizeofString("hello")),
-                           Allocate(sizeofPool()),
                            Reallocate(sizeofPool(), sizeofArray(1)),
                        });
 }
@@ -0,0 +1,178 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_DECODE_UNICODE 1
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string.h>
+
+#include "Allocators.hpp"
+
+TEST_CASE("deserializeJson(InSituJsonDocument&)") {
+  SpyingAllocator spy;
+
+  SECTION("Strings point to the buffer") {
+    char input[] = "{\"hello\":\"world\"}";
+    InSituJsonDocument doc(input, &spy);
+
+    DeserializationError err = deserializeJson(doc);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["hello"] == "world");
+    REQUIRE(doc["hello"].as<const char*>() == input + 10);
+    REQUIRE(doc.as<JsonObject>().begin()->key().c_str() == input + 2);
+  }
+
+  SECTION("Escape sequences are unescaped in place") {
+    char input[] =
+        "[\"1\\\"2\\\\3\\/4\\b5\\f6\\n7\\r8\\t9\",\"\\u00e4\\u3042\","
+        "\"\\ud83d\\udda4!\"]";
+    InSituJsonDocument doc(input, &spy);
+
+    DeserializationError err = deserializeJson(doc);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == "1\"2\\3/4\b5\f6\n7\r8\t9");
+    REQUIRE(doc[1] == "\xc3\xa4\xe3\x81\x82");
+    REQUIRE(doc[2] == "\xf0\x9f\x96\xa4!");
+    REQUIRE(doc[0].as<const char*>() == input + 2);
+  }
+
+  SECTION("Single quotes") {
+    char input[] = "{'hello':'world'}";
+    InSituJsonDocument doc(input, &spy);
+
+    DeserializationError err = deserializeJson(doc);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["hello"] == "world");
+  }
+
+  SECTION("Buffer without terminator") {
+    char input[] = {'[', '"', 'a', 'b', 'c', 'd', '"', ']', 'x'};
+    InSituJsonDocument doc(input, 8, &spy);
+
+    DeserializationError err = deserializeJson(doc);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == "abcd");
+  }
+
+  SECTION("uint8_t buffer") {
+    uint8_t input[] = "[\"hello\"]";
+    InSituJsonDocument doc(input, sizeof(input) - 1, &spy);
+
+    DeserializationError err = deserializeJson(doc);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == "hello");
+  }
+
+  SECTION("Strings with a NUL are copied") {
+    char input[] = "[\"wx\\u0000yz\"]";
+    InSituJsonDocument doc(input, &spy);
+
+    DeserializationError err = deserializeJson(doc);
+
+    REQUIRE(err == DeserializationError::Ok);
+    JsonString result = doc[0];
+    REQUIRE(result.size() == 5);
+    REQUIRE(memcmp(result.c_str(), "wx\0yz", 5) == 0);
+  }
+
+  SECTION("Non-quoted keys are copied") {
+    char input[] = "{hello:\"world\"}";
+    InSituJsonDocument doc(input, &spy);
+
+    DeserializationError err = deserializeJson(doc);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["hello"] == "world");
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofStringBuffer()),
+                             Allocate(sizeofPool()),
+                             Reallocate(sizeofStringBuffer(),
+                                        sizeofString("hello")),
+                             Reallocate(sizeofPool(), sizeofPool(2)),
+                         });
+  }
+
+  SECTION("Filter") {
+    char input[] = "{\"a\":\"hello\",\"b\":\"world\"}";
+    InSituJsonDocument doc(input, &spy);
+    JsonDocument filter;
+    filter["b"] = true;
+
+    DeserializationError err =
+        deserializeJson(doc, DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"b\":\"world\"}");
+  }
+
+  SECTION("Incomplete input") {
+    char input[] = "{\"hello\":\"wor";
+    InSituJsonDocument doc(input, &spy);
+
+    DeserializationError err = deserializeJson(doc);
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("The buffer can only be parsed once") {
+    char input[] = "{\"hello\":\"w\\u00f6rld\"}";
+    InSituJsonDocument doc(input, &spy);
+
+    REQUIRE(deserializeJson(doc) == DeserializationError::Ok);
+    REQUIRE(deserializeJson(doc) == DeserializationError::InvalidInput);
+    REQUIRE(doc["hello"] == "w\xc3\xb6rld");
+  }
+
+  SECTION("A failed parse also consumes the buffer") {
+    char input[] = "{\"hello\":\"wor";
+    InSituJsonDocument doc(input, &spy);
+
+    REQUIRE(deserializeJson(doc) == DeserializationError::IncompleteInput);
+    REQUIRE(deserializeJson(doc) == DeserializationError::InvalidInput);
+  }
+
+  SECTION("Copy to a JsonDocument") {
+    char input[] = "{\"hello\":\"world\"}";
+    JsonDocument copy;
+    {
+      InSituJsonDocument doc(input, &spy);
+      deserializeJson(doc);
+      copy = doc;
+    }
+    strcpy(input, "{\"xxxxx\":\"xxxxx\"}");
+
+    REQUIRE(copy.as<std::string>() == "{\"hello\":\"world\"}");
+  }
+
+  SECTION("Move through a JsonDocument reference") {
+    char input[] = "{\"hello\":\"world\"}";
+    InSituJsonDocument doc(input, &spy);
+    deserializeJson(doc);
+
+    JsonDocument moved(std::move(static_cast<JsonDocument&>(doc)));
+    strcpy(input, "{\"xxxxx\":\"xxxxx\"}");
+
+    REQUIRE(moved.as<std::string>() == "{\"hello\":\"world\"}");
+  }
+
+  SECTION("Swap through a JsonDocument reference") {
+    char input[] = "{\"hello\":\"world\"}";
+    InSituJsonDocument doc(input, &spy);
+    deserializeJson(doc);
+    JsonDocument other;
+    other["answer"] = 42;
+
+    swap(other, static_cast<JsonDocument&>(doc));
+    strcpy(input, "{\"xxxxx\":\"xxxxx\"}");
+
+    REQUIRE(other.as<std::string>() == "{\"hello\":\"world\"}");
+    REQUIRE(doc.as<std::string>() == "{\"answer\":42}");
+  }
+}
@@ -230,3 +230,38 @@ TEST_CASE("deserializeJson(JsonDocument&, ElementProxy)") {
   REQUIRE(doc2[0] == 4);
   REQUIRE(doc2[1] == 2);
 }
+
+TEST_CASE("deserializeJson() same result for contiguous and streamed inputs") {
+  // the long runs cross the look-ahead of null-terminated inputs (64 bytes)
+  std::string inputs[] = {
+      "{\"state\":\"on\",\"attributes\":{\"friendly_name\":\"Kitchen light\","
+      "\"brightness\":255}}",
+      "[\r\n\t  1,\r\n\t  2.5,\r\n\t  \"three\"\r\n]",
+      "{\n        \"a\": {\n            \"b\": [true, false, null]\n"
+      "        }\n    }",
+      "  [\"escaped \\\"quotes\\\" and \\\\ backslashes\",'single']  ",
+      "[\"unterminated",
+      "{\"key\":   ",
+      std::string(150, ' ') + "[" + std::string(70, '\n') + "1]",
+      "[\"" + std::string(200, 'a') + "\\n" + std::string(61, 'b') + "\"]",
+      "[" + std::string(61, ' ') + "1.25]",
+      "[\"" + std::string(100, 'a'),
+  };
+
+  for (auto& input : inputs) {
+    CAPTURE(input);
+    JsonDocument doc1, doc2, doc3;
+    CustomReader reader(input.c_str());
+    DeserializationError err1 = deserializeJson(doc1, input.c_str());
+    DeserializationError err2 = deserializeJson(doc2, reader);
+    DeserializationError err3 = deserializeJson(doc3, input);
+    CHECK(err1 == err2);
+    CHECK(err3 == err2);
+    std::string output1, output2, output3;
+    serializeJson(doc1, output1);
+    serializeJson(doc2, output2);
+    serializeJson(doc3, output3);
+    CHECK(output1 == output2);
+    CHECK(output3 == output2);
+  }
+}
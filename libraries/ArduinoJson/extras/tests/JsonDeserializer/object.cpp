@@ -341,9 +341,9 @@ TEST_CASE("deserialize JSON object") {
     REQUIRE(doc.is<JsonObject>());
     REQUIRE(doc.size() == 0);
     REQUIRE(spy.log() == AllocatorLog{
-                             Deallocate(sizeofObject(1)),
                              Deallocate(sizeofString("hello")),
                              Deallocate(sizeofString("world")),
+                             Deallocate(sizeofObject(1)),
                          });
   }
 
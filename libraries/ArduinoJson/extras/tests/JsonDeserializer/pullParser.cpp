@@ -0,0 +1,223 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+#include "Allocators.hpp"
+
+// Returns the tokens as a string, with the keys and the values
+template <typename TInput>
+static std::string readAll(JsonPullParser<TInput>& parser) {
+  std::string result;
+  for (;;) {
+    switch (parser.next()) {
+      case JsonToken::ObjectStart:
+        result += "{";
+        break;
+      case JsonToken::ObjectEnd:
+        result += "}";
+        break;
+      case JsonToken::ArrayStart:
+        result += "[";
+        break;
+      case JsonToken::ArrayEnd:
+        result += "]";
+        break;
+      case JsonToken::Key:
+        result += "K:" + std::string(parser.key().c_str()) + " ";
+        break;
+      case JsonToken::Value:
+        result += "V:" + parser.value().template as<std::string>() + " ";
+        break;
+      case JsonToken::EndOfDocument:
+        return result;
+      case JsonToken::Error:
+        return result + "!" + parser.error().c_str();
+    }
+  }
+}
+
+static std::string readAll(const char* input) {
+  JsonPullParser<const char*> parser(input);
+  return readAll(parser);
+}
+
+TEST_CASE("JsonPullParser") {
+  SECTION("Values") {
+    REQUIRE(readAll("42") == "V:42 ");
+    REQUIRE(readAll("-3.5") == "V:-3.5 ");
+    REQUIRE(readAll("true") == "V:true ");
+    REQUIRE(readAll("false") == "V:false ");
+    REQUIRE(readAll("null") == "V:null ");
+    REQUIRE(readAll("'hello'") == "V:hello ");
+    REQUIRE(readAll("\"\\u00e4\\n\"") == "V:\xc3\xa4\n ");
+  }
+
+  SECTION("Empty array") {
+    REQUIRE(readAll("[]") == "[]");
+  }
+
+  SECTION("Empty object") {
+    REQUIRE(readAll(" { } ") == "{}");
+  }
+
+  SECTION("Nested") {
+    REQUIRE(readAll("{\"a\":[1,{\"b\":\"c\"},[]],d:null}") ==
+            "{K:a [V:1 {K:b V:c }[]]K:d V:null }");
+  }
+
+  SECTION("Keeps returning EndOfDocument") {
+    JsonPullParser<const char*> parser("[]");
+    parser.next();
+    parser.next();
+
+    REQUIRE(parser.next() == JsonToken::EndOfDocument);
+    REQUIRE(parser.next() == JsonToken::EndOfDocument);
+    REQUIRE(parser.error() == DeserializationError::Ok);
+  }
+
+  SECTION("Depth") {
+    JsonPullParser<const char*> parser("[[1]]");
+
+    REQUIRE(parser.depth() == 0);
+    parser.next();
+    REQUIRE(parser.depth() == 1);
+    parser.next();
+    REQUIRE(parser.depth() == 2);
+    parser.next();
+    REQUIRE(parser.depth() == 2);
+    parser.next();
+    REQUIRE(parser.depth() == 1);
+    parser.next();
+    REQUIRE(parser.depth() == 0);
+  }
+
+  SECTION("Errors") {
+    REQUIRE(readAll("") == "!EmptyInput");
+    REQUIRE(readAll("[1,") == "[V:1 !IncompleteInput");
+    REQUIRE(readAll("[1}") == "[V:1 !InvalidInput");
+    REQUIRE(readAll("{\"a\" 1}") == "{!InvalidInput");
+    REQUIRE(readAll("{\"a\":tru}") == "{K:a !InvalidInput");
+  }
+
+  SECTION("Keeps returning Error") {
+    JsonPullParser<const char*> parser("[}");
+    parser.next();
+
+    REQUIRE(parser.next() == JsonToken::Error);
+    REQUIRE(parser.next() == JsonToken::Error);
+    REQUIRE(parser.error() == DeserializationError::InvalidInput);
+  }
+
+  SECTION("Nesting limit") {
+    JsonPullParser<const char*> parser(
+        "[[[]]]", DeserializationOption::NestingLimit(2));
+
+    REQUIRE(readAll(parser) == "[[!TooDeep");
+  }
+}
+
+TEST_CASE("JsonPullParser::skip()") {
+  SECTION("Value of a key") {
+    JsonPullParser<const char*> parser(
+        "{\"a\":{\"b\":[1,2,{}]},\"c\":\"d\",\"e\":3}");
+
+    REQUIRE(parser.next() == JsonToken::ObjectStart);
+    REQUIRE(parser.next() == JsonToken::Key);
+    REQUIRE(parser.skip() == JsonToken::Value);
+    REQUIRE(parser.next() == JsonToken::Key);
+    REQUIRE(parser.key() == "c");
+    REQUIRE(parser.skip() == JsonToken::Value);
+    REQUIRE(readAll(parser) == "K:e V:3 }");
+  }
+
+  SECTION("Rest of an array") {
+    JsonPullParser<const char*> parser("[[1,[2]],3]");
+
+    REQUIRE(parser.next() == JsonToken::ArrayStart);
+    REQUIRE(parser.next() == JsonToken::ArrayStart);
+    REQUIRE(parser.skip() == JsonToken::ArrayEnd);
+    REQUIRE(readAll(parser) == "V:3 ]");
+  }
+
+  SECTION("Rest of an object") {
+    JsonPullParser<const char*> parser("{\"a\":{\"b\":1},\"c\":2}");
+
+    REQUIRE(parser.next() == JsonToken::ObjectStart);
+    REQUIRE(parser.skip() == JsonToken::ObjectEnd);
+    REQUIRE(parser.next() == JsonToken::EndOfDocument);
+  }
+
+  SECTION("Too deep") {
+    JsonPullParser<const char*> parser(
+        "{\"a\":[[1]]}", DeserializationOption::NestingLimit(2));
+
+    parser.next();
+    parser.next();
+
+    REQUIRE(parser.skip() == JsonToken::Error);
+    REQUIRE(parser.error() == DeserializationError::TooDeep);
+  }
+}
+
+TEST_CASE("JsonPullParser input types") {
+  SECTION("std::string") {
+    std::string input = "[\"hello\"]";
+    JsonPullParser<std::string> parser(input);
+
+    REQUIRE(readAll(parser) == "[V:hello ]");
+  }
+
+  SECTION("std::istream") {
+    std::istringstream input("{\"hello\":\"world\"}");
+    JsonPullParser<std::istream> parser(input);
+
+    REQUIRE(readAll(parser) == "{K:hello V:world }");
+  }
+
+  SECTION("Stream") {
+    struct StreamStub : Stream {
+      StreamStub(const char* s) : stream_(s) {}
+
+      int read() {
+        return stream_.get();
+      }
+
+      size_t readBytes(char* buffer, size_t length) {
+        stream_.read(buffer, static_cast<std::streamsize>(length));
+        return static_cast<size_t>(stream_.gcount());
+      }
+
+      std::istringstream stream_;
+    };
+
+    StreamStub input("[1,\"two\"]");
+    JsonPullParser<StreamStub> parser(input);
+
+    REQUIRE(readAll(parser) == "[V:1 V:two ]");
+  }
+}
+
+TEST_CASE("JsonPullParser memory usage") {
+  SpyingAllocator spy;
+  std::string input = "[";
+  for (int i = 0; i < 1000; i++)
+    input += "{\"id\":\"sensor.temperature\",\"value\":1234567890123},";
+  input += "{}]";
+
+  JsonPullParser<std::string> parser(input, {}, &spy);
+  while (parser.next() != JsonToken::EndOfDocument)
+    REQUIRE(parser.error() == DeserializationError::Ok);
+
+  // the string buffer is reused, and so is the slot of the 64-bit integers
+  REQUIRE(spy.log() == AllocatorLog{
+                           Allocate(sizeofStringBuffer()),
+                           Allocate(sizeofPool()),
+                       });
+}
@@ -212,3 +212,46 @@ TEST_CASE("Deduplicate keys") {
               Reallocate(sizeofPool(), sizeofArray(2) + 2 * sizeofObject(1)),
           });
 }
+
+TEST_CASE("Long strings") {
+  JsonDocument doc;
+
+  SECTION("Escape sequences at every offset") {
+    for (size_t i = 0; i < 40; i++) {
+      std::string expected = std::string(i, 'a') + "\n" + std::string(i, 'b');
+      std::string input =
+          "\"" + std::string(i, 'a') + "\\n" + std::string(i, 'b') + "\"";
+      CAPTURE(input);
+      REQUIRE(deserializeJson(doc, input.c_str()) == DeserializationError::Ok);
+      CHECK(doc.as<std::string>() == expected);
+    }
+  }
+
+  SECTION("Other quote in the string") {
+    REQUIRE(deserializeJson(doc, "'0123456789\"0123456789'") ==
+            DeserializationError::Ok);
+    CHECK(doc.as<std::string>() == "0123456789\"0123456789");
+  }
+
+  SECTION("Growing buffer") {
+    std::string expected(1000, 'x');
+    REQUIRE(deserializeJson(doc, ("\"" + expected + "\"").c_str()) ==
+            DeserializationError::Ok);
+    CHECK(doc.as<std::string>() == expected);
+  }
+
+  SECTION("Truncated") {
+    for (size_t i = 0; i < 20; i++) {
+      std::string input = "[\"" + std::string(i, 'a');
+      CAPTURE(input);
+      REQUIRE(deserializeJson(doc, input.c_str()) ==
+              DeserializationError::IncompleteInput);
+    }
+  }
+
+  SECTION("Null character in bounded input") {
+    const char input[] = "\"0123456789\0abcdef\"";
+    REQUIRE(deserializeJson(doc, input, sizeof(input) - 1) ==
+            DeserializationError::IncompleteInput);
+  }
+}
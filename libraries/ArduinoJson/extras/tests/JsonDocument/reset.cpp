@@ -0,0 +1,59 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+#include "Literals.hpp"
+
+TEST_CASE("JsonDocument::reset()") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("null") {
+    doc.reset();
+
+    REQUIRE(doc.isNull());
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("releases the strings but keeps the pool") {
+    doc["hello"_s] = "world"_s;
+    spy.clearLog();
+
+    doc.reset();
+
+    REQUIRE(doc.isNull());
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofString("hello")),
+                             Deallocate(sizeofString("world")),
+                         });
+  }
+
+  SECTION("reuses the pool") {
+    doc["a"] = 1;
+    doc.reset();
+    spy.clearLog();
+
+    doc["b"] = 2;
+
+    REQUIRE(doc.as<std::string>() == "{\"b\":2}");
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("shrinkToFit() releases the unused pool") {
+    doc["a"] = 1;
+    doc.reset();
+    spy.clearLog();
+
+    doc.shrinkToFit();
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofPool()),
+                         });
+  }
+}
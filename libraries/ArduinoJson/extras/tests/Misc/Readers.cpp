@@ -185,6 +185,27 @@ class StreamStub : public Stream {
   std::istringstream stream_;
 };
 
+TEST_CASE("IsContiguousReader") {
+  SECTION("const char*") {
+    REQUIRE(IsContiguousReader<Reader<const char*>>::value);
+    REQUIRE(IsNullTerminatedReader<Reader<const char*>>::value);
+  }
+
+  SECTION("BoundedReader<const char*>") {
+    REQUIRE(IsContiguousReader<BoundedReader<const char*>>::value);
+    REQUIRE_FALSE(IsNullTerminatedReader<BoundedReader<const char*>>::value);
+  }
+
+  SECTION("std::string") {
+    REQUIRE(IsContiguousReader<Reader<std::string>>::value);
+    REQUIRE_FALSE(IsNullTerminatedReader<Reader<std::string>>::value);
+  }
+
+  SECTION("std::istringstream") {
+    REQUIRE_FALSE(IsContiguousReader<Reader<std::istringstream>>::value);
+  }
+}
+
 TEST_CASE("Reader<Stream>") {
   SECTION("read()") {
     StreamStub src("\x01\xFF");
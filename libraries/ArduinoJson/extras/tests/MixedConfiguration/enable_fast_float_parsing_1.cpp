@@ -0,0 +1,24 @@
+#define ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING == 1") {
+  JsonDocument doc;
+
+  SECTION("float") {
+    deserializeJson(doc, "[23.4,-0.5,1e3]");
+
+    REQUIRE(doc[0].as<float>() == 23.4f);
+    REQUIRE(doc[1].as<float>() == -0.5f);
+    REQUIRE(doc[2].as<float>() == 1000.0f);
+  }
+
+  SECTION("double") {
+    deserializeJson(doc, "[3.141592653589793,1.7976931348623157e308,1e-300]");
+
+    REQUIRE(doc[0].as<double>() == 3.141592653589793);
+    REQUIRE(doc[1].as<double>() == 1.7976931348623157e308);
+    REQUIRE(doc[2].as<double>() == 1e-300);
+  }
+}
@@ -0,0 +1,31 @@
+#define ARDUINOJSON_VERSION_NAMESPACE ShortestFloatFormatting
+#define ARDUINOJSON_ENABLE_SHORTEST_FLOAT_FORMATTING 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_SHORTEST_FLOAT_FORMATTING == 1") {
+  JsonDocument doc;
+
+  SECTION("serializeJson()") {
+    doc.add(3.141592653589793);
+    doc.add(0.1f);
+    doc.add(-1e-7);
+    doc.add(1.5e300);
+
+    std::string json;
+    serializeJson(doc, json);
+
+    REQUIRE(json == "[3.141592653589793,0.1,-1e-7,1.5e300]");
+    REQUIRE(measureJson(doc) == json.size());
+  }
+
+  SECTION("round-trip") {
+    deserializeJson(doc, "[0.30000000000000004,1.7976931348623157e308]");
+
+    std::string json;
+    serializeJson(doc, json);
+
+    REQUIRE(json == "[0.30000000000000004,1.7976931348623157e308]");
+  }
+}
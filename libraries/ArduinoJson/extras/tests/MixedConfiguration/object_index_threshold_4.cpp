@@ -0,0 +1,182 @@
+#define ARDUINOJSON_VERSION_NAMESPACE ObjectIndexThreshold4
+#define ARDUINOJSON_OBJECT_INDEX_THRESHOLD 4
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+#include "Allocators.hpp"
+
+using ArduinoJson::detail::MemberIndex;
+
+static std::string key(int i) {
+  return "key" + std::to_string(i);
+}
+
+static void addMembers(JsonDocument& doc, int begin, int end) {
+  for (int i = begin; i < end; i++)
+    doc[key(i)] = i;
+}
+
+static bool logContains(const SpyingAllocator& spy,
+                        const AllocatorLogEntry& entry) {
+  return spy.log().str().find(entry.str()) != std::string::npos;
+}
+
+static void checkMembers(JsonDocument& doc, int begin, int end) {
+  for (int i = begin; i < end; i++)
+    REQUIRE(doc[key(i)] == i);
+}
+
+TEST_CASE("ARDUINOJSON_OBJECT_INDEX_THRESHOLD == 4") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("builds the index past the threshold") {
+    addMembers(doc, 0, 4);
+    spy.clearLog();
+
+    REQUIRE(doc["missing"].isNull());
+    REQUIRE(spy.log() == AllocatorLog{});
+
+    addMembers(doc, 4, 5);
+    spy.clearLog();
+
+    REQUIRE(doc["missing"].isNull());
+    REQUIRE(spy.log() ==
+            AllocatorLog{
+                Allocate(MemberIndex::sizeForCapacity(32)),
+            });
+    spy.clearLog();
+
+    checkMembers(doc, 0, 5);
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("indexes the members added afterwards") {
+    addMembers(doc, 0, 100);
+
+    checkMembers(doc, 0, 100);
+    REQUIRE(doc.size() == 100);
+    REQUIRE(doc["missing"].isNull());
+  }
+
+  SECTION("updates the index on remove") {
+    addMembers(doc, 0, 100);
+
+    for (int i = 0; i < 100; i += 2)
+      doc.remove(key(i));
+    doc.remove(key(99));  // the tail
+
+    REQUIRE(doc.size() == 49);
+    for (int i = 0; i < 100; i++)
+      REQUIRE(doc[key(i)].isNull() == (i % 2 == 0 || i == 99));
+
+    addMembers(doc, 99, 101);
+    checkMembers(doc, 99, 101);
+    REQUIRE(doc.size() == 51);
+  }
+
+  SECTION("removes with an iterator") {
+    addMembers(doc, 0, 10);
+    REQUIRE(doc["missing"].isNull());
+
+    JsonObject obj = doc.as<JsonObject>();
+    for (JsonObject::iterator it = obj.begin(); it != obj.end(); ++it) {
+      if (it->key() == "key3")
+        obj.remove(it);
+    }
+
+    REQUIRE(doc["key3"].isNull());
+    checkMembers(doc, 4, 10);
+  }
+
+  SECTION("drops the index when the object shrinks below the threshold") {
+    addMembers(doc, 0, 5);
+    REQUIRE(doc["missing"].isNull());
+    spy.clearLog();
+
+    doc.remove(key(0));
+    REQUIRE(spy.log() ==
+            AllocatorLog{
+                Deallocate(sizeofString("key0")),
+            });
+    spy.clearLog();
+
+    doc.remove(key(1));
+    REQUIRE(spy.log() ==
+            AllocatorLog{
+                Deallocate(sizeofString("key1")),
+                Deallocate(MemberIndex::sizeForCapacity(32)),
+            });
+
+    checkMembers(doc, 2, 5);
+  }
+
+  SECTION("drops the index when the object is cleared") {
+    JsonObject obj = doc["obj"].to<JsonObject>();
+    for (int i = 0; i < 5; i++)
+      obj[key(i)] = i;
+    REQUIRE(obj["missing"].isNull());
+    spy.clearLog();
+
+    doc["obj"] = 42;
+
+    REQUIRE(logContains(spy, Deallocate(MemberIndex::sizeForCapacity(32))));
+  }
+
+  SECTION("drops the indexes on shrinkToFit()") {
+    addMembers(doc, 0, 5);
+    REQUIRE(doc["missing"].isNull());
+
+    spy.clearLog();
+
+    doc.shrinkToFit();
+
+    REQUIRE(logContains(spy, Deallocate(MemberIndex::sizeForCapacity(32))));
+    checkMembers(doc, 0, 5);
+  }
+
+  SECTION("frees the indexes on clear()") {
+    addMembers(doc, 0, 5);
+    REQUIRE(doc["missing"].isNull());
+
+    doc.clear();
+
+    REQUIRE(spy.allocatedBytes() == 0);
+  }
+
+  SECTION("works after the document is moved") {
+    addMembers(doc, 0, 10);
+    REQUIRE(doc["missing"].isNull());
+
+    JsonDocument doc2(std::move(doc));
+
+    checkMembers(doc2, 0, 10);
+    addMembers(doc2, 10, 20);
+    checkMembers(doc2, 0, 20);
+  }
+
+  SECTION("keeps the last duplicate key") {
+    std::string json = "{";
+    for (int i = 0; i < 20; i++)
+      json += "\"" + key(i) + "\":" + std::to_string(i) + ",";
+    json += "\"key5\":\"dup\"}";
+
+    deserializeJson(doc, json);
+
+    REQUIRE(doc.size() == 20);
+    REQUIRE(doc["key5"] == "dup");
+    checkMembers(doc, 6, 20);
+  }
+
+  SECTION("falls back to a linear search when allocation fails") {
+    KillswitchAllocator killswitch;
+    JsonDocument doc2(&killswitch);
+    addMembers(doc2, 0, 10);
+    killswitch.on();
+
+    checkMembers(doc2, 0, 10);
+    REQUIRE(doc2["missing"].isNull());
+  }
+}
@@ -0,0 +1,19 @@
+#define ARDUINOJSON_VERSION_NAMESPACE StringIndexThreshold0
+#define ARDUINOJSON_STRING_INDEX_THRESHOLD 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_STRING_INDEX_THRESHOLD == 0") {
+  JsonDocument doc;
+
+  for (int i = 0; i < 100; i++) {
+    std::string key = "key" + std::to_string(i);
+    doc[key] = key;
+  }
+
+  REQUIRE(doc.size() == 100);
+  for (JsonPair kv : doc.as<JsonObject>())
+    REQUIRE(kv.key().c_str() == kv.value().as<const char*>());
+}
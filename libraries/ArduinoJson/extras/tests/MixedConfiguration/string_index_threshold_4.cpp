@@ -0,0 +1,26 @@
+#define ARDUINOJSON_VERSION_NAMESPACE StringIndexThreshold4
+#define ARDUINOJSON_STRING_INDEX_THRESHOLD 4
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_STRING_INDEX_THRESHOLD == 4") {
+  JsonDocument doc;
+
+  for (int i = 0; i < 100; i++) {
+    std::string key = "key" + std::to_string(i);
+    doc[key] = key;
+  }
+
+  REQUIRE(doc.size() == 100);
+  for (JsonPair kv : doc.as<JsonObject>())
+    REQUIRE(kv.key().c_str() == kv.value().as<const char*>());
+
+  for (int i = 0; i < 100; i += 2)
+    doc.remove("key" + std::to_string(i));
+
+  REQUIRE(doc.size() == 50);
+  REQUIRE(doc["key1"] == "key1");
+  REQUIRE(doc["key99"] == "key99");
+}
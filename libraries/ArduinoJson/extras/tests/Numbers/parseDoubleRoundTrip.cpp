@@ -0,0 +1,120 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_USE_DOUBLE 1
+
+#include <ArduinoJson.hpp>
+#include <catch.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace ArduinoJson::detail;
+
+#if ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING
+
+static uint64_t bitsOf(double value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+static uint32_t bitsOf(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+static double doubleFromBits(uint64_t bits) {
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+static uint64_t random64() {
+  // xorshift64, with a fixed seed for reproducibility
+  static uint64_t state = 0x9E3779B97F4A7C15;
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+// Checks that parseNumber() gives the same result as strtof() or strtod(),
+// depending on the type it picked
+static bool sameAsStrtod(const char* input) {
+  auto result = parseNumber(input);
+  switch (result.type()) {
+    case NumberType::Float:
+      return bitsOf(result.asFloat()) == bitsOf(strtof(input, nullptr));
+    case NumberType::Double:
+      return bitsOf(result.asDouble()) == bitsOf(strtod(input, nullptr));
+    default:
+      return false;
+  }
+}
+
+TEST_CASE("parseNumber() round-trips doubles") {
+  char buffer[64];
+
+  SECTION("Random doubles") {
+    for (int i = 0; i < 200000; i++) {
+      uint64_t bits = random64() & 0x7FFFFFFFFFFFFFFF;
+      double value = doubleFromBits(bits);
+      if (value != value || value * 2 == value)  // NaN or infinity
+        continue;
+
+      snprintf(buffer, sizeof(buffer), "%.17g", value);
+      if (bitsOf(parseNumber<double>(buffer)) != bits) {
+        CAPTURE(buffer);
+        REQUIRE(parseNumber<double>(buffer) == value);
+      }
+
+      snprintf(buffer, sizeof(buffer), "%.15g", -value);
+      if (!sameAsStrtod(buffer)) {
+        CAPTURE(buffer);
+        REQUIRE(parseNumber<double>(buffer) == strtod(buffer, nullptr));
+      }
+    }
+  }
+
+  SECTION("Random decimals") {
+    // Random mantissas of up to 19 digits with random exponents
+    for (int i = 0; i < 200000; i++) {
+      uint64_t mantissa = random64() >> (random64() % 64);
+      int exponent = int(random64() % 700) - 350;
+      snprintf(buffer, sizeof(buffer), "%llue%d",
+               static_cast<unsigned long long>(mantissa % 10000000000000000000u),
+               exponent);
+      if (!sameAsStrtod(buffer)) {
+        CAPTURE(buffer);
+        REQUIRE(parseNumber<double>(buffer) == strtod(buffer, nullptr));
+      }
+    }
+  }
+
+  SECTION("Halfway between two doubles") {
+    // 2^53 + 1 is exactly between 2^53 and 2^53 + 2, ties go to even
+    REQUIRE(sameAsStrtod("9007199254740993.0"));
+    REQUIRE(sameAsStrtod("9007199254740995.0"));
+    REQUIRE(sameAsStrtod("1.00000000000000011102230246251565404236316680908203125"));
+    REQUIRE(sameAsStrtod("1.00000000000000011102230246251565404236316680908203124"));
+  }
+
+  SECTION("Classic hard cases") {
+    REQUIRE(sameAsStrtod("2.2250738585072011e-308"));
+    REQUIRE(sameAsStrtod("2.2250738585072012e-308"));
+    REQUIRE(sameAsStrtod("4.9406564584124654e-324"));  // smallest subnormal
+    REQUIRE(sameAsStrtod("2.4703282292062328e-324"));  // rounds up
+    REQUIRE(sameAsStrtod("2.4703282292062327e-324"));  // rounds to zero
+    REQUIRE(sameAsStrtod("1.7976931348623157e308"));
+    REQUIRE(sameAsStrtod("1.7976931348623158e308"));
+    REQUIRE(sameAsStrtod("0.30000000000000004"));
+    REQUIRE(sameAsStrtod("7.3177701707893310e+15"));
+    REQUIRE(sameAsStrtod("8.988465674311579e307"));
+  }
+}
+
+#endif
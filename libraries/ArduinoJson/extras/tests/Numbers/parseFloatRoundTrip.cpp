@@ -0,0 +1,94 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_USE_DOUBLE 0
+
+#include <ArduinoJson.hpp>
+#include <catch.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace ArduinoJson::detail;
+
+#if ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING
+
+static uint32_t bitsOf(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+static float floatFromBits(uint32_t bits) {
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Checks that parseNumber() and strtof() give the same float, to the bit
+static bool sameAsStrtof(const char* input) {
+  auto result = parseNumber(input);
+  return result.type() == NumberType::Float &&
+         bitsOf(result.asFloat()) == bitsOf(strtof(input, nullptr));
+}
+
+// Checks the positive floats whose bits are multiples of step.
+// With 9 digits, the float must be read back exactly; with fewer digits, the
+// result must be the same as strtof().
+static void checkFloats(uint32_t step) {
+  char buffer[32];
+  for (uint64_t bits = 0; bits < 0x7F800000; bits += step) {
+    float value = floatFromBits(uint32_t(bits));
+
+    snprintf(buffer, sizeof(buffer), "%.9g", double(value));
+    if (bitsOf(parseNumber<float>(buffer)) != uint32_t(bits)) {
+      CAPTURE(buffer);
+      REQUIRE(parseNumber<float>(buffer) == value);
+    }
+
+    snprintf(buffer, sizeof(buffer), "%.6g", double(-value));
+    if (!sameAsStrtof(buffer)) {
+      CAPTURE(buffer);
+      REQUIRE(parseNumber<float>(buffer) == strtof(buffer, nullptr));
+    }
+  }
+}
+
+TEST_CASE("parseNumber() round-trips floats") {
+  SECTION("Every 1999th float") {
+    checkFloats(1999);
+  }
+
+  SECTION("Halfway between two floats") {
+    // 2^24 + 1 is exactly between 2^24 and 2^24 + 2, ties go to even
+    REQUIRE(sameAsStrtof("16777217.0"));
+    REQUIRE(parseNumber<float>("16777217.0") == 16777216.0f);
+    REQUIRE(parseNumber<float>("16777219.0") == 16777220.0f);
+    REQUIRE(sameAsStrtof("33554434.0"));
+    REQUIRE(sameAsStrtof("33554438.0"));
+    REQUIRE(sameAsStrtof("1.6777217e7"));
+  }
+
+  SECTION("Subnormals") {
+    REQUIRE(sameAsStrtof("1e-45"));
+    REQUIRE(sameAsStrtof("7e-46"));
+    REQUIRE(sameAsStrtof("7.1e-46"));
+    REQUIRE(sameAsStrtof("1.17549421e-38"));
+    REQUIRE(sameAsStrtof("1.1754942e-38"));
+  }
+
+  SECTION("Limits") {
+    REQUIRE(sameAsStrtof("3.4028234e38"));
+    REQUIRE(sameAsStrtof("3.4028235e38"));
+    REQUIRE(sameAsStrtof("3.4028236e38"));  // infinity
+  }
+}
+
+// Takes a few minutes; run with NumbersTests "[exhaustive]"
+TEST_CASE("parseNumber() round-trips all the floats", "[.exhaustive]") {
+  checkFloats(1);
+}
+
+#endif
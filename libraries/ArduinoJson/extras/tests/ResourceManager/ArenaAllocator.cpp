@@ -0,0 +1,139 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.hpp>
+#include <catch.hpp>
+
+#include <string.h>
+
+using namespace ArduinoJson;
+
+TEST_CASE("ArenaAllocator") {
+  alignas(void*) char buffer[256];
+  ArenaAllocator arena(buffer, sizeof(buffer));
+
+  SECTION("Allocates from the buffer") {
+    void* p = arena.allocate(10);
+
+    REQUIRE(p > buffer);
+    REQUIRE(p < buffer + sizeof(buffer));
+    REQUIRE(arena.size() > 10);
+  }
+
+  SECTION("Returns null when full") {
+    REQUIRE(arena.allocate(100) != nullptr);
+    REQUIRE(arena.allocate(200) == nullptr);
+    REQUIRE(arena.allocate(50) != nullptr);
+  }
+
+  SECTION("Freeing the top block releases it") {
+    arena.allocate(10);
+    size_t size = arena.size();
+
+    arena.deallocate(arena.allocate(20));
+
+    REQUIRE(arena.size() == size);
+  }
+
+  SECTION("Freeing the top block releases the freed blocks below") {
+    arena.allocate(10);
+    size_t size = arena.size();
+    void* a = arena.allocate(20);
+    void* b = arena.allocate(30);
+
+    arena.deallocate(a);
+    REQUIRE(arena.size() > size);
+
+    arena.deallocate(b);
+    REQUIRE(arena.size() == size);
+  }
+
+  SECTION("Freeing all the blocks releases the buffer") {
+    void* a = arena.allocate(10);
+    void* b = arena.allocate(20);
+
+    arena.deallocate(a);
+    arena.deallocate(b);
+
+    REQUIRE(arena.size() == 0);
+  }
+
+  SECTION("Top block grows in place") {
+    auto p = static_cast<char*>(arena.allocate(10));
+    strcpy(p, "hello");
+
+    REQUIRE(arena.reallocate(p, 100) == p);
+    REQUIRE(strcmp(p, "hello") == 0);
+    REQUIRE(arena.reallocate(p, 5) == p);
+  }
+
+  SECTION("Other blocks are moved") {
+    auto p = static_cast<char*>(arena.allocate(10));
+    strcpy(p, "hello");
+    arena.allocate(10);
+
+    auto q = static_cast<char*>(arena.reallocate(p, 100));
+
+    REQUIRE(q != p);
+    REQUIRE(strcmp(q, "hello") == 0);
+  }
+
+  SECTION("Failed reallocation keeps the block") {
+    auto p = static_cast<char*>(arena.allocate(10));
+    strcpy(p, "hello");
+
+    REQUIRE(arena.reallocate(p, 1000) == nullptr);
+    REQUIRE(strcmp(p, "hello") == 0);
+  }
+
+  SECTION("reset()") {
+    arena.allocate(10);
+    arena.allocate(20);
+
+    arena.reset();
+
+    REQUIRE(arena.size() == 0);
+    REQUIRE(arena.allocate(200) != nullptr);
+  }
+
+  SECTION("Unaligned buffer") {
+    ArenaAllocator unaligned(buffer + 1, sizeof(buffer) - 1);
+    void* p = unaligned.allocate(1);
+
+    REQUIRE(reinterpret_cast<size_t>(p) % sizeof(void*) == 0);
+  }
+}
+
+TEST_CASE("JsonDocument with ArenaAllocator") {
+  char buffer[1024];
+  ArenaAllocator arena(buffer, sizeof(buffer));
+  JsonDocument doc(&arena);
+
+  SECTION("Deserializes in the buffer") {
+    auto err = deserializeJson(doc, "{\"hello\":\"world\"}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["hello"] == "world");
+    REQUIRE(arena.size() > 0);
+  }
+
+  SECTION("Reports NoMemory when the buffer is full") {
+    std::string input = "[";
+    for (int i = 0; i < 100; i++)
+      input += "\"a long string that doesn't fit\",";
+    input += "0]";
+
+    auto err = deserializeJson(doc, input);
+
+    REQUIRE(err == DeserializationError::NoMemory);
+  }
+
+  SECTION("clear() releases the buffer") {
+    deserializeJson(doc, "{\"hello\":\"world\"}");
+
+    doc.clear();
+
+    REQUIRE(arena.size() == 0);
+  }
+}
@@ -0,0 +1,145 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.hpp>
+#include <catch.hpp>
+
+#include "Allocators.hpp"
+
+using namespace ArduinoJson;
+using namespace ArduinoJson::detail;
+
+TEST_CASE("InSituStringBuilder") {
+  SpyingAllocator spyingAllocator;
+  ResourceManager resources(&spyingAllocator);
+  InSituStringBuilder str(&resources);
+  VariantData data;
+
+  SECTION("Empty string") {
+    char buffer[] = "\"\"";
+
+    str.startString();
+    str.append(buffer + 1, 0);
+    str.save(&data);
+
+    REQUIRE(spyingAllocator.log() == AllocatorLog{});
+    REQUIRE(data.type() == VariantType::TinyString);
+  }
+
+  SECTION("Tiny string") {
+    char buffer[] = "\"url\"";
+
+    str.startString();
+    str.append(buffer + 1, 3);
+    str.save(&data);
+
+    REQUIRE(spyingAllocator.log() == AllocatorLog{});
+    REQUIRE(data.type() == VariantType::TinyString);
+    REQUIRE(data.asString() == "url");
+  }
+
+  SECTION("String stays in the buffer") {
+    char buffer[] = "\"hello world\"";
+
+    str.startString();
+    str.append(buffer + 1, 11);
+
+    REQUIRE(str.isValid() == true);
+    REQUIRE(str.str() == "hello world");
+
+    str.save(&data);
+
+    REQUIRE(spyingAllocator.log() == AllocatorLog{});
+    REQUIRE(data.type() == VariantType::BorrowedString);
+    REQUIRE(data.asString().c_str() == buffer + 1);
+    REQUIRE(data.asString() == "hello world");
+  }
+
+  SECTION("Escaped characters move the rest of the string") {
+    char buffer[] = "\"hello\\tworld\"";
+
+    str.startString();
+    str.append(buffer + 1, 5);
+    str.append('\t');
+    str.append(buffer + 8, 5);
+    str.save(&data);
+
+    REQUIRE(spyingAllocator.log() == AllocatorLog{});
+    REQUIRE(data.asString() == "hello\tworld");
+    REQUIRE(data.asString().c_str() == buffer + 1);
+  }
+
+  SECTION("String with a NUL is copied") {
+    char buffer[] = "\"hello\\u0000world\"";
+
+    str.startString();
+    str.append(buffer + 1, 5);
+    str.append('\0');
+    str.append(buffer + 12, 5);
+
+    REQUIRE(str.isValid() == true);
+    REQUIRE(str.size() == 11);
+
+    str.save(&data);
+
+    REQUIRE(spyingAllocator.log() == AllocatorLog{
+                                         Allocate(sizeofStringBuffer()),
+                                         Reallocate(sizeofStringBuffer(),
+                                                    sizeofString(11)),
+                                     });
+    REQUIRE(data.type() == VariantType::OwnedString);
+    REQUIRE(data.asString().size() == 11);
+  }
+
+  SECTION("Non-quoted string is copied") {
+    str.startString();
+    str.append('h');
+    str.append('e');
+    str.append('l');
+    str.append('l');
+    str.append('o');
+    str.save(&data);
+
+    REQUIRE(spyingAllocator.log() == AllocatorLog{
+                                         Allocate(sizeofStringBuffer()),
+                                         Reallocate(sizeofStringBuffer(),
+                                                    sizeofString("hello")),
+                                     });
+    REQUIRE(data.type() == VariantType::OwnedString);
+    REQUIRE(data.asString() == "hello");
+  }
+}
+
+TEST_CASE("InSituJsonDocument") {
+  SpyingAllocator spyingAllocator;
+  char input[] = "{\"name\":\"ArduinoJson\",\"tags\":[\"json\",\"fast\"]}";
+
+  InSituJsonDocument doc(input, &spyingAllocator);
+  deserializeJson(doc);
+
+  SECTION("Allocates no string") {
+    REQUIRE(spyingAllocator.log() ==
+            AllocatorLog{
+                Allocate(sizeofPool()),
+                Reallocate(sizeofPool(), sizeofPool(6)),
+            });
+  }
+
+  SECTION("Copies the strings when copied to a JsonDocument") {
+    spyingAllocator.clearLog();
+
+    JsonDocument copy(doc);
+
+    REQUIRE(copy["name"] == "ArduinoJson");
+    REQUIRE(spyingAllocator.log() ==
+            AllocatorLog{
+                Allocate(sizeofPool()),
+                Allocate(sizeofString("name")),
+                Allocate(sizeofString("ArduinoJson")),
+                Allocate(sizeofString("tags")),
+                Allocate(sizeofString("json")),
+                Allocate(sizeofString("fast")),
+            });
+  }
+}
@@ -0,0 +1,115 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.hpp>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+
+using namespace ArduinoJson;
+using namespace ArduinoJson::detail;
+
+TEST_CASE("ResourceManager::reset()") {
+  SpyingAllocator spy;
+  ResourceManager resources(&spy);
+
+  SECTION("Keeps the pools") {
+    for (size_t i = 0; i < 2 * ARDUINOJSON_POOL_CAPACITY; i++)
+      resources.allocVariant();
+    spy.clearLog();
+
+    resources.reset();
+    for (size_t i = 0; i < 2 * ARDUINOJSON_POOL_CAPACITY; i++)
+      resources.allocVariant();
+
+    REQUIRE(resources.size() == sizeofPool(2 * ARDUINOJSON_POOL_CAPACITY));
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("Releases the strings") {
+    resources.saveString(adaptString("hello"));
+    spy.clearLog();
+
+    resources.reset();
+
+    REQUIRE(resources.size() == 0);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofString("hello")),
+                         });
+  }
+
+  SECTION("shrinkToFit() releases the pools that are still empty") {
+    for (size_t i = 0; i < 2 * ARDUINOJSON_POOL_CAPACITY; i++)
+      resources.allocVariant();
+    resources.reset();
+    resources.allocVariant();
+    spy.clearLog();
+
+    resources.shrinkToFit();
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofPool()),
+                             Reallocate(sizeofPool(), sizeofPool(1)),
+                         });
+  }
+}
+
+TEST_CASE("Repeated parse cycles") {
+  SECTION("Pools are allocated once") {
+    SpyingAllocator spy;
+    JsonDocument doc(&spy);
+
+    for (int i = 0; i < 3; i++) {
+      spy.clearLog();
+      deserializeJson(doc, "[1,2,3,[4,5,6,[7]],8,9,10,11,12,13,14,15,16]");
+      REQUIRE(doc[3][3][0] == 7);
+    }
+
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("Strings are allocated at each cycle") {
+    SpyingAllocator spy;
+    JsonDocument doc(&spy);
+
+    for (int i = 0; i < 3; i++) {
+      spy.clearLog();
+      deserializeJson(doc, "{\"hello\":\"world\"}");
+      REQUIRE(doc["hello"] == "world");
+    }
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofString("world")),
+                             Deallocate(sizeofString("hello")),
+                             Allocate(sizeofStringBuffer()),
+                             Reallocate(sizeofStringBuffer(),
+                                        sizeofString("hello")),
+                             Allocate(sizeofStringBuffer()),
+                             Reallocate(sizeofStringBuffer(),
+                                        sizeofString("world")),
+                         });
+  }
+
+  SECTION("ArenaAllocator doesn't grow") {
+    char buffer[2048];
+    ArenaAllocator arena(buffer, sizeof(buffer));
+    SpyingAllocator spy(&arena);
+    JsonDocument doc(&spy);
+
+    // the strings of the first cycle leave a hole below the pool
+    for (int i = 0; i < 2; i++)
+      deserializeJson(doc,
+                      "{\"key\":\"value\",\"list\":[\"hello\",\"world\"]}");
+    size_t size = arena.size();
+
+    for (int i = 0; i < 10; i++) {
+      deserializeJson(doc,
+                      "{\"key\":\"value\",\"list\":[\"hello\",\"world\"]}");
+      REQUIRE(doc["list"][1] == "world");
+      REQUIRE(arena.size() == size);
+    }
+  }
+}
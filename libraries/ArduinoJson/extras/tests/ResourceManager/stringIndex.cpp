@@ -0,0 +1,135 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson/Memory/ResourceManager.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+#include <catch.hpp>
+
+#include <string>
+#include <vector>
+
+#include "Allocators.hpp"
+
+using namespace ArduinoJson::detail;
+
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+
+static StringNode* saveString(ResourceManager& resources,
+                              const std::string& s) {
+  return resources.saveString(adaptString(s));
+}
+
+static std::string key(size_t i) {
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "key%04zu", i);
+  return buffer;
+}
+
+// Fails the allocations that are too large for a string
+class NoIndexAllocator : public ArduinoJson::Allocator {
+ public:
+  virtual ~NoIndexAllocator() {}
+
+  void* allocate(size_t n) override {
+    return n < 64 ? upstream_->allocate(n) : nullptr;
+  }
+
+  void deallocate(void* p) override {
+    upstream_->deallocate(p);
+  }
+
+  void* reallocate(void* ptr, size_t n) override {
+    return n < 64 ? upstream_->reallocate(ptr, n) : nullptr;
+  }
+
+ private:
+  Allocator* upstream_ = DefaultAllocator::instance();
+};
+
+TEST_CASE("ResourceManager string index") {
+  const size_t n = ARDUINOJSON_STRING_INDEX_THRESHOLD * 10;
+
+  SECTION("Deduplicates strings past the threshold") {
+    ResourceManager resources;
+    std::vector<StringNode*> nodes;
+    size_t expectedSize = 0;
+    for (size_t i = 0; i < n; i++) {
+      nodes.push_back(saveString(resources, key(i)));
+      expectedSize += sizeofString(key(i).c_str());
+    }
+
+    for (size_t i = 0; i < n; i++) {
+      auto node = saveString(resources, key(i));
+      REQUIRE(node == nodes[i]);
+      REQUIRE(node->references == 2);
+    }
+
+    REQUIRE(resources.size() == expectedSize);
+    REQUIRE(resources.getString(adaptString("missing")) == nullptr);
+  }
+
+  SECTION("Allocates the index past the threshold") {
+    SpyingAllocator spy;
+    ResourceManager resources(&spy);
+
+    for (size_t i = 0; i < ARDUINOJSON_STRING_INDEX_THRESHOLD; i++)
+      saveString(resources, key(i));
+    REQUIRE(spy.log() ==
+            AllocatorLog{
+                Allocate(sizeofString("key0000")) *
+                    ARDUINOJSON_STRING_INDEX_THRESHOLD,
+            });
+
+    spy.clearLog();
+    saveString(resources, "last");
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofString("last")),
+                             Allocate(64 * sizeof(void*)),
+                         });
+  }
+
+  SECTION("Finds the other strings after removing some") {
+    ResourceManager resources;
+    std::vector<StringNode*> nodes;
+    for (size_t i = 0; i < n; i++)
+      nodes.push_back(saveString(resources, key(i)));
+
+    for (size_t i = 0; i < n; i += 3)
+      resources.dereferenceString(nodes[i]);
+
+    for (size_t i = 0; i < n; i++) {
+      auto node = resources.getString(adaptString(key(i)));
+      if (i % 3 == 0)
+        REQUIRE(node == nullptr);
+      else
+        REQUIRE(node == nodes[i]);
+    }
+  }
+
+  SECTION("Keeps working when the index can't be allocated") {
+    NoIndexAllocator allocator;
+    ResourceManager resources(&allocator);
+    std::vector<StringNode*> nodes;
+    for (size_t i = 0; i < ARDUINOJSON_STRING_INDEX_THRESHOLD * 2; i++)
+      nodes.push_back(saveString(resources, key(i)));
+
+    for (size_t i = 0; i < nodes.size(); i++) {
+      REQUIRE(nodes[i] != nullptr);
+      REQUIRE(resources.getString(adaptString(key(i))) == nodes[i]);
+    }
+  }
+
+  SECTION("Clear releases the index") {
+    SpyingAllocator spy;
+    ResourceManager resources(&spy);
+    for (size_t i = 0; i < n; i++)
+      saveString(resources, key(i));
+
+    resources.clear();
+    REQUIRE(resources.size() == 0);
+    REQUIRE(spy.allocatedBytes() == 0);
+  }
+}
+
+#endif
@@ -0,0 +1,195 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <catch.hpp>
+#include <limits>
+#include <string>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARDUINOJSON_VERSION_NAMESPACE ShortestFloat
+#define ARDUINOJSON_ENABLE_SHORTEST_FLOAT_FORMATTING 1
+#define ARDUINOJSON_ENABLE_NAN 1
+#define ARDUINOJSON_ENABLE_INFINITY 1
+#include <ArduinoJson/Json/TextFormatter.hpp>
+#include <ArduinoJson/Serialization/Writer.hpp>
+
+using namespace ArduinoJson::detail;
+
+template <typename TFloat>
+static std::string format(TFloat input) {
+  std::string output;
+  Writer<std::string> sb(output);
+  TextFormatter<Writer<std::string>> writer(sb);
+  writer.writeFloat(input);
+  REQUIRE(writer.bytesWritten() == output.size());
+  return output;
+}
+
+template <typename TFloat>
+static void check(TFloat input, const std::string& expected) {
+  CHECK(format(input) == expected);
+}
+
+static double readBack(const char* s, double) {
+  return strtod(s, nullptr);
+}
+
+static float readBack(const char* s, float) {
+  return strtof(s, nullptr);
+}
+
+// Returns the number of significant digits of the output of writeFloat()
+static int countDigits(const std::string& s) {
+  int count = 0, zeros = 0;
+  for (char c : s) {
+    if (c == 'e')
+      break;
+    if (c == '0') {
+      if (count)
+        zeros++;
+    } else if (c >= '1' && c <= '9') {
+      count += zeros + 1;
+      zeros = 0;
+    }
+  }
+  return count;
+}
+
+// Returns true if a decimal with this many digits reads back as the value
+template <typename TFloat>
+static bool readsBackWith(int digits, TFloat value) {
+  char buffer[40];
+  snprintf(buffer, sizeof(buffer), "%.*e", digits - 1, double(value));
+  if (readBack(buffer, value) == value)
+    return true;
+
+  // For powers of two, the decimal above may be inside the rounding interval
+  // even if the closest isn't, because the interval is asymmetric
+  unsigned long long significand = 0;
+  const char* c = buffer;
+  for (; *c != 'e'; c++) {
+    if (*c != '.')
+      significand = significand * 10 + unsigned(*c - '0');
+  }
+  int exponent = atoi(c + 1) - (digits - 1);
+  snprintf(buffer, sizeof(buffer), "%llue%d", significand + 1, exponent);
+  return readBack(buffer, value) == value;
+}
+
+// Returns the smallest number of digits that read back as the value
+template <typename TFloat>
+static int shortestDigits(TFloat value) {
+  int digits = 1;
+  while (!readsBackWith(digits, value))
+    digits++;
+  return digits;
+}
+
+// Checks that the output reads back as the same value, with as few digits as
+// possible
+template <typename TFloat>
+static void checkRoundTrip(TFloat value) {
+  std::string output = format(value);
+  if (readBack(output.c_str(), value) != value ||
+      countDigits(output) != shortestDigits(value)) {
+    CAPTURE(output);
+    CAPTURE(shortestDigits(value));
+    REQUIRE(readBack(output.c_str(), value) == value);
+    REQUIRE(countDigits(output) == shortestDigits(value));
+  }
+}
+
+static void checkFloats(uint32_t step) {
+  for (uint64_t bits = 1; bits < 0x7F800000; bits += step) {
+    uint32_t bits32 = uint32_t(bits);
+    float value;
+    memcpy(&value, &bits32, sizeof(value));
+    checkRoundTrip(value);
+  }
+}
+
+TEST_CASE("TextFormatter::writeFloat() with shortest representation") {
+  SECTION("Zero") {
+    check<double>(0.0, "0");
+    check<double>(-0.0, "0");
+    check<float>(0.0f, "0");
+  }
+
+  SECTION("NaN and Infinity") {
+    check<double>(std::numeric_limits<double>::quiet_NaN(), "NaN");
+    check<double>(std::numeric_limits<double>::infinity(), "Infinity");
+    check<float>(-std::numeric_limits<float>::infinity(), "-Infinity");
+  }
+
+  SECTION("Pi") {
+    check<double>(3.14159265359, "3.14159265359");
+    check<double>(3.141592653589793, "3.141592653589793");
+    check<float>(3.14159265f, "3.1415927");
+  }
+
+  SECTION("Floats are written as floats") {
+    check<float>(0.1f, "0.1");
+    check<float>(-23.4f, "-23.4");
+    check<double>(double(0.1f), "0.10000000149011612");
+  }
+
+  SECTION("Integers") {
+    check<double>(1.0, "1");
+    check<double>(100.0, "100");
+    check<double>(9999999.0, "9999999");
+    check<float>(1234567.0f, "1234567");
+  }
+
+  SECTION("Positive exponentiation") {
+    check<double>(1e7, "1e7");
+    check<double>(12345678.0, "1.2345678e7");
+    check<double>(1.7976931348623157E+308, "1.7976931348623157e308");
+    check<float>(3.4028235e38f, "3.4028235e38");
+  }
+
+  SECTION("Negative exponentiation") {
+    check<double>(0.0001, "0.0001");
+    check<double>(0.000012, "0.000012");
+    check<double>(1e-5, "1e-5");
+    check<double>(2.2250738585072014E-308, "2.2250738585072014e-308");
+    check<double>(5e-324, "5e-324");
+    check<float>(1e-45f, "1e-45");
+  }
+
+  SECTION("Powers of two") {
+    // the lower boundary is closer to the value than the upper one
+    for (double value = 1.0; value < 1e300; value *= 2)
+      checkRoundTrip(value);
+    for (double value = 1.0; value > 1e-300; value /= 2)
+      checkRoundTrip(value);
+  }
+
+  SECTION("Every 9973th float") {
+    checkFloats(9973);
+  }
+
+  SECTION("Random doubles") {
+    uint64_t state = 88172645463325252;
+    for (int i = 0; i < 100000; i++) {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      uint64_t bits = state & 0x7FFFFFFFFFFFFFFF;
+      if (bits == 0 || bits >= 0x7FF0000000000000)  // zero, NaN or infinity
+        continue;
+      double value;
+      memcpy(&value, &bits, sizeof(value));
+      checkRoundTrip(value);
+    }
+  }
+}
+
+// Takes a few minutes; run with TextFormatterTests "[exhaustive]"
+TEST_CASE("TextFormatter::writeFloat() round-trips all the floats",
+          "[.exhaustive]") {
+  checkFloats(1);
+}
@@ -39,7 +39,9 @@
 #include "ArduinoJson/Object/JsonObject.hpp"
 #include "ArduinoJson/Variant/JsonVariantConst.hpp"
 
+#include "ArduinoJson/Document/InSituJsonDocument.hpp"
 #include "ArduinoJson/Document/JsonDocument.hpp"
+#include "ArduinoJson/Memory/ArenaAllocator.hpp"
 
 #include "ArduinoJson/Array/ArrayImpl.hpp"
 #include "ArduinoJson/Array/ElementProxy.hpp"
@@ -54,7 +56,10 @@
 #include "ArduinoJson/Variant/VariantImpl.hpp"
 #include "ArduinoJson/Variant/VariantRefBaseImpl.hpp"
 
+#include "ArduinoJson/Cbor/CborDeserializer.hpp"
+#include "ArduinoJson/Cbor/CborSerializer.hpp"
 #include "ArduinoJson/Json/JsonDeserializer.hpp"
+#include "ArduinoJson/Json/JsonPullParser.hpp"
 #include "ArduinoJson/Json/JsonSerializer.hpp"
 #include "ArduinoJson/Json/PrettyJsonSerializer.hpp"
 #include "ArduinoJson/MsgPack/MsgPackBinary.hpp"
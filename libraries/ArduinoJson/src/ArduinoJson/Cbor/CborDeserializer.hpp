@@ -0,0 +1,598 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Cbor/halfToFloat.hpp>
+#include <ArduinoJson/Deserialization/deserialize.hpp>
+#include <ArduinoJson/Memory/ResourceManager.hpp>
+#include <ArduinoJson/Memory/StringBuffer.hpp>
+#include <ArduinoJson/MsgPack/endianness.hpp>
+#include <ArduinoJson/MsgPack/ieee754.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Parses a CBOR input (RFC 8949).
+// Tags are ignored: the tagged item is stored as if it wasn't tagged.
+// Byte strings are stored as raw strings containing the CBOR item, so they
+// can be serialized back with serializeCbor().
+template <typename TReader>
+class CborDeserializer {
+ public:
+  CborDeserializer(ResourceManager* resources, TReader reader)
+      : resources_(resources),
+        reader_(reader),
+        stringBuffer_(resources),
+        foundSomething_(false) {}
+
+  template <typename TFilter>
+  DeserializationError parse(VariantData& variant, TFilter filter,
+                             DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+    err = parseVariant(&variant, filter, nestingLimit);
+    return foundSomething_ ? err : DeserializationError::EmptyInput;
+  }
+
+ private:
+  // The major types, in the upper 3 bits of the initial byte
+  enum MajorType : uint8_t {
+    UnsignedInteger = 0,
+    NegativeInteger = 1,
+    ByteString = 2,
+    TextString = 3,
+    Array = 4,
+    Map = 5,
+    Tag = 6,
+    SimpleValue = 7,
+  };
+
+  // The lower 5 bits of the initial byte of strings, arrays and maps whose
+  // length is unknown
+  static const uint8_t indefiniteLength = 31;
+
+  // Terminates the items of indefinite length
+  static const uint8_t breakCode = 0xff;
+
+  // The initial byte and the argument that follows (length, value, or tag)
+  struct Header {
+    uint8_t bytes[9];
+    uint8_t size;
+    uint64_t argument;
+
+    MajorType majorType() const {
+      return MajorType(bytes[0] >> 5);
+    }
+
+    uint8_t info() const {
+      return bytes[0] & 0x1f;
+    }
+
+    bool isIndefinite() const {
+      return info() == indefiniteLength;
+    }
+  };
+
+  template <typename TFilter>
+  DeserializationError::Code parseVariant(
+      VariantData* variant, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    uint8_t code;
+    auto err = readByte(code);
+    if (err)
+      return err;
+
+    foundSomething_ = true;
+
+    return parseVariant(code, variant, filter, nestingLimit);
+  }
+
+  template <typename TFilter>
+  DeserializationError::Code parseVariant(
+      uint8_t code, VariantData* variant, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+    Header header;
+
+    bool allowValue = filter.allowValue();
+
+    if (allowValue) {
+      // callers pass a null pointer only when value must be ignored
+      ARDUINOJSON_ASSERT(variant != 0);
+    }
+
+    err = readHeader(code, header);
+    if (err)
+      return err;
+
+    // skip the tags
+    while (header.majorType() == Tag) {
+      err = readByte(code);
+      if (err)
+        return err;
+      err = readHeader(code, header);
+      if (err)
+        return err;
+    }
+
+    switch (header.majorType()) {
+      case UnsignedInteger:
+        if (allowValue)
+          return readUnsignedInteger(variant, header.argument);
+        return DeserializationError::Ok;
+
+      case NegativeInteger:
+        if (allowValue)
+          return readNegativeInteger(variant, header.argument);
+        return DeserializationError::Ok;
+
+      case ByteString:
+        if (!allowValue)
+          return skipString(header);
+        if (header.isIndefinite())
+          return readChunkedByteString(variant);
+        return readByteString(variant, header);
+
+      case TextString:
+        if (!allowValue)
+          return skipString(header);
+        err = readString(header);
+        if (err)
+          return err;
+        stringBuffer_.save(variant);
+        return DeserializationError::Ok;
+
+      case Array:
+        return readArray(variant, header, filter, nestingLimit);
+
+      case Map:
+        return readObject(variant, header, filter, nestingLimit);
+
+      default:
+        return readSimpleValue(allowValue ? variant : 0, header);
+    }
+  }
+
+  // Reads the argument that follows the initial byte
+  DeserializationError::Code readHeader(uint8_t code, Header& header) {
+    header.bytes[0] = code;
+    header.size = 1;
+    header.argument = header.info();
+
+    if (header.info() < 24)
+      return DeserializationError::Ok;
+
+    if (header.info() <= 27) {
+      auto width = uint8_t(1U << (header.info() - 24));
+      auto err = readBytes(header.bytes + 1, width);
+      if (err)
+        return err;
+      header.size = uint8_t(1 + width);
+      header.argument = 0;
+      for (uint8_t i = 1; i <= width; i++)
+        header.argument = (header.argument << 8) | header.bytes[i];
+      return DeserializationError::Ok;
+    }
+
+    if (header.isIndefinite()) {
+      switch (header.majorType()) {
+        case ByteString:
+        case TextString:
+        case Array:
+        case Map:
+          return DeserializationError::Ok;
+        default:  // break code outside of an item of indefinite length
+          return DeserializationError::InvalidInput;
+      }
+    }
+
+    return DeserializationError::InvalidInput;  // reserved values
+  }
+
+  DeserializationError::Code readByte(uint8_t& value) {
+    int c = reader_.read();
+    if (c < 0)
+      return DeserializationError::IncompleteInput;
+    value = static_cast<uint8_t>(c);
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code readBytes(void* p, size_t n) {
+    if (reader_.readBytes(reinterpret_cast<char*>(p), n) == n)
+      return DeserializationError::Ok;
+    return DeserializationError::IncompleteInput;
+  }
+
+  DeserializationError::Code skipBytes(size_t n) {
+    for (; n; --n) {
+      if (reader_.read() < 0)
+        return DeserializationError::IncompleteInput;
+    }
+    return DeserializationError::Ok;
+  }
+
+  static DeserializationError::Code getLength(const Header& header,
+                                              size_t& length) {
+    length = size_t(header.argument);
+    if (length != header.argument)            // integer overflow
+      return DeserializationError::NoMemory;  // (not testable on 64-bit)
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code readUnsignedInteger(VariantData* variant,
+                                                 uint64_t value) {
+    auto truncatedValue = static_cast<JsonUInt>(value);
+    if (truncatedValue == value) {
+      if (!variant->setInteger(truncatedValue, resources_))
+        return DeserializationError::NoMemory;
+    }
+    // else set null on overflow
+    return DeserializationError::Ok;
+  }
+
+  // The value is -1 - n
+  DeserializationError::Code readNegativeInteger(VariantData* variant,
+                                                 uint64_t n) {
+    auto truncatedValue = static_cast<JsonInteger>(n);
+    if (truncatedValue >= 0 && static_cast<uint64_t>(truncatedValue) == n) {
+      if (!variant->setInteger(-1 - truncatedValue, resources_))
+        return DeserializationError::NoMemory;
+    }
+    // else set null on overflow
+    return DeserializationError::Ok;
+  }
+
+  // Booleans, null, undefined, floats, and other simple values
+  DeserializationError::Code readSimpleValue(VariantData* variant,
+                                             const Header& header) {
+    switch (header.info()) {
+      case 20:  // false
+      case 21:  // true
+        if (variant)
+          variant->setBoolean(header.info() == 21);
+        return DeserializationError::Ok;
+
+      case 25:  // half-precision float
+        if (variant)
+          variant->setFloat(halfToFloat(uint16_t(header.argument)),
+                            resources_);
+        return DeserializationError::Ok;
+
+      case 26:  // single-precision float
+        if (variant)
+          return readFloat<float>(variant, header);
+        return DeserializationError::Ok;
+
+      case 27:  // double-precision float
+        if (variant)
+          return readDouble<JsonFloat>(variant, header);
+        return DeserializationError::Ok;
+
+      default:  // null, undefined, or unassigned
+        // already null
+        return DeserializationError::Ok;
+    }
+  }
+
+  template <typename T>
+  enable_if_t<sizeof(T) == 4, DeserializationError::Code> readFloat(
+      VariantData* variant, const Header& header) {
+    T value;
+    memcpy(&value, header.bytes + 1, 4);
+    fixEndianness(value);
+    variant->setFloat(value, resources_);
+    return DeserializationError::Ok;
+  }
+
+  template <typename T>
+  enable_if_t<sizeof(T) == 8, DeserializationError::Code> readDouble(
+      VariantData* variant, const Header& header) {
+    T value;
+    memcpy(&value, header.bytes + 1, 8);
+    fixEndianness(value);
+    if (variant->setFloat(value, resources_))
+      return DeserializationError::Ok;
+    else
+      return DeserializationError::NoMemory;
+  }
+
+  template <typename T>
+  enable_if_t<sizeof(T) == 4, DeserializationError::Code> readDouble(
+      VariantData* variant, const Header& header) {
+    T value;  // output is 4 bytes
+    doubleToFloat(header.bytes + 1, reinterpret_cast<uint8_t*>(&value));
+    fixEndianness(value);
+    variant->setFloat(value, resources_);
+    return DeserializationError::Ok;
+  }
+
+  // Reads a text string in the string buffer
+  DeserializationError::Code readString(const Header& header) {
+    if (header.isIndefinite())
+      return readChunks(TextString, false);
+
+    size_t n;
+    auto err = getLength(header, n);
+    if (err)
+      return err;
+
+    char* p = stringBuffer_.reserve(n);
+    if (!p)
+      return DeserializationError::NoMemory;
+
+    return readBytes(p, n);
+  }
+
+  DeserializationError::Code readByteString(VariantData* variant,
+                                            const Header& header) {
+    size_t n;
+    auto err = getLength(header, n);
+    if (err)
+      return err;
+
+    auto totalSize = size_t(header.size + n);
+    if (totalSize < n)                        // integer overflow
+      return DeserializationError::NoMemory;  // (not testable on 64-bit)
+
+    char* p = stringBuffer_.reserve(totalSize);
+    if (!p)
+      return DeserializationError::NoMemory;
+
+    memcpy(p, header.bytes, header.size);
+
+    err = readBytes(p + header.size, n);
+    if (err)
+      return err;
+
+    stringBuffer_.saveRaw(variant);
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code readChunkedByteString(VariantData* variant) {
+    char* p = stringBuffer_.reserve(1);
+    if (!p)
+      return DeserializationError::NoMemory;
+    p[0] = char(ByteString << 5 | indefiniteLength);
+
+    auto err = readChunks(ByteString, true);
+    if (err)
+      return err;
+
+    p = stringBuffer_.extend(1);
+    if (!p)
+      return DeserializationError::NoMemory;
+    p[0] = char(breakCode);
+
+    stringBuffer_.saveRaw(variant);
+    return DeserializationError::Ok;
+  }
+
+  // Appends the chunks of a string of indefinite length to the string buffer.
+  // Keeps the header of each chunk if keepHeaders is true.
+  DeserializationError::Code readChunks(MajorType majorType, bool keepHeaders) {
+    if (!keepHeaders && !stringBuffer_.reserve(0))
+      return DeserializationError::NoMemory;
+
+    for (;;) {
+      uint8_t code;
+      auto err = readByte(code);
+      if (err)
+        return err;
+
+      if (code == breakCode)
+        return DeserializationError::Ok;
+
+      Header chunk;
+      err = readHeader(code, chunk);
+      if (err)
+        return err;
+
+      // chunks must be strings of the same type and of definite length
+      if (chunk.majorType() != majorType || chunk.isIndefinite())
+        return DeserializationError::InvalidInput;
+
+      size_t n;
+      err = getLength(chunk, n);
+      if (err)
+        return err;
+
+      if (keepHeaders) {
+        char* p = stringBuffer_.extend(chunk.size);
+        if (!p)
+          return DeserializationError::NoMemory;
+        memcpy(p, chunk.bytes, chunk.size);
+      }
+
+      char* p = stringBuffer_.extend(n);
+      if (!p)
+        return DeserializationError::NoMemory;
+
+      err = readBytes(p, n);
+      if (err)
+        return err;
+    }
+  }
+
+  DeserializationError::Code skipString(const Header& header) {
+    if (!header.isIndefinite()) {
+      size_t n;
+      auto err = getLength(header, n);
+      if (err)
+        return err;
+      return skipBytes(n);
+    }
+
+    for (;;) {
+      uint8_t code;
+      auto err = readByte(code);
+      if (err)
+        return err;
+
+      if (code == breakCode)
+        return DeserializationError::Ok;
+
+      Header chunk;
+      err = readHeader(code, chunk);
+      if (err)
+        return err;
+
+      if (chunk.majorType() != header.majorType() || chunk.isIndefinite())
+        return DeserializationError::InvalidInput;
+
+      err = skipString(chunk);
+      if (err)
+        return err;
+    }
+  }
+
+  template <typename TFilter>
+  DeserializationError::Code readArray(
+      VariantData* variant, const Header& header, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    bool allowArray = filter.allowArray();
+
+    ArrayData* array;
+    if (allowArray) {
+      ARDUINOJSON_ASSERT(variant != 0);
+      array = &variant->toArray();
+    } else {
+      array = 0;
+    }
+
+    TFilter elementFilter = filter[0U];
+
+    bool indefinite = header.isIndefinite();
+    for (uint64_t n = header.argument; indefinite || n; --n) {
+      uint8_t code;
+      err = readByte(code);
+      if (err)
+        return err;
+
+      if (indefinite && code == breakCode)
+        break;
+
+      VariantData* value;
+
+      if (elementFilter.allow()) {
+        ARDUINOJSON_ASSERT(array != 0);
+        value = array->addElement(resources_);
+        if (!value)
+          return DeserializationError::NoMemory;
+      } else {
+        value = 0;
+      }
+
+      err = parseVariant(code, value, elementFilter, nestingLimit.decrement());
+      if (err)
+        return err;
+    }
+
+    return DeserializationError::Ok;
+  }
+
+  template <typename TFilter>
+  DeserializationError::Code readObject(
+      VariantData* variant, const Header& header, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    ObjectData* object;
+    if (filter.allowObject()) {
+      ARDUINOJSON_ASSERT(variant != 0);
+      object = &variant->toObject();
+    } else {
+      object = 0;
+    }
+
+    bool indefinite = header.isIndefinite();
+    for (uint64_t n = header.argument; indefinite || n; --n) {
+      uint8_t code;
+      err = readByte(code);
+      if (err)
+        return err;
+
+      if (indefinite && code == breakCode)
+        break;
+
+      err = readKey(code);
+      if (err)
+        return err;
+
+      JsonString key = stringBuffer_.str();
+      TFilter memberFilter = filter[key.c_str()];
+      VariantData* member = 0;
+
+      if (memberFilter.allow()) {
+        ARDUINOJSON_ASSERT(object != 0);
+
+        auto keyVariant = object->addPair(&member, resources_);
+        if (!keyVariant)
+          return DeserializationError::NoMemory;
+
+        stringBuffer_.save(keyVariant);
+      }
+
+      err = parseVariant(member, memberFilter, nestingLimit.decrement());
+      if (err)
+        return err;
+    }
+
+    return DeserializationError::Ok;
+  }
+
+  // Only text strings are supported as keys
+  DeserializationError::Code readKey(uint8_t code) {
+    if ((code >> 5) != TextString)
+      return DeserializationError::InvalidInput;
+
+    Header header;
+    auto err = readHeader(code, header);
+    if (err)
+      return err;
+
+    return readString(header);
+  }
+
+  ResourceManager* resources_;
+  TReader reader_;
+  StringBuffer stringBuffer_;
+  bool foundSomething_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Parses a CBOR input and puts the result in a JsonDocument.
+template <typename TDestination, typename... Args,
+          detail::enable_if_t<
+              detail::is_deserialize_destination<TDestination>::value, int> = 0>
+inline DeserializationError deserializeCbor(TDestination&& dst,
+                                            Args&&... args) {
+  using namespace detail;
+  return deserialize<CborDeserializer>(detail::forward<TDestination>(dst),
+                                       detail::forward<Args>(args)...);
+}
+
+// Parses a CBOR input and puts the result in a JsonDocument.
+template <typename TDestination, typename TChar, typename... Args,
+          detail::enable_if_t<
+              detail::is_deserialize_destination<TDestination>::value, int> = 0>
+inline DeserializationError deserializeCbor(TDestination&& dst, TChar* input,
+                                            Args&&... args) {
+  using namespace detail;
+  return deserialize<CborDeserializer>(detail::forward<TDestination>(dst),
+                                       input, detail::forward<Args>(args)...);
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,197 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/MsgPack/endianness.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Serialization/CountingDecorator.hpp>
+#include <ArduinoJson/Serialization/measure.hpp>
+#include <ArduinoJson/Serialization/serialize.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Produces a CBOR output (RFC 8949) with the shortest encoding of each item,
+// and the lengths of arrays, maps, and strings in the headers.
+template <typename TWriter>
+class CborSerializer : public VariantDataVisitor<size_t> {
+ public:
+  static const bool producesText = false;
+
+  CborSerializer(TWriter writer, const ResourceManager* resources)
+      : writer_(writer), resources_(resources) {}
+
+  template <typename T>
+  enable_if_t<is_floating_point<T>::value && sizeof(T) == 4, size_t> visit(
+      T value32) {
+    if (canConvertNumber<JsonInteger>(value32)) {
+      JsonInteger truncatedValue = JsonInteger(value32);
+      if (value32 == T(truncatedValue))
+        return visit(truncatedValue);
+    }
+    writeByte(0xFA);
+    writeInteger(value32);
+    return bytesWritten();
+  }
+
+  template <typename T>
+  ARDUINOJSON_NO_SANITIZE("float-cast-overflow")
+  enable_if_t<is_floating_point<T>::value && sizeof(T) == 8, size_t> visit(
+      T value64) {
+    float value32 = float(value64);
+    if (value32 == value64)
+      return visit(value32);
+    writeByte(0xFB);
+    writeInteger(value64);
+    return bytesWritten();
+  }
+
+  size_t visit(const ArrayData& array) {
+    writeHeader(4 /*array*/, array.size(resources_));
+
+    auto slotId = array.head();
+    while (slotId != NULL_SLOT) {
+      auto slot = resources_->getVariant(slotId);
+      slot->accept(*this, resources_);
+      slotId = slot->next();
+    }
+
+    return bytesWritten();
+  }
+
+  size_t visit(const ObjectData& object) {
+    writeHeader(5 /*map*/, object.size(resources_));
+
+    auto slotId = object.head();
+    while (slotId != NULL_SLOT) {
+      auto slot = resources_->getVariant(slotId);
+      slot->accept(*this, resources_);
+      slotId = slot->next();
+    }
+
+    return bytesWritten();
+  }
+
+  size_t visit(const char* value) {
+    return visit(JsonString(value));
+  }
+
+  size_t visit(JsonString value) {
+    ARDUINOJSON_ASSERT(!value.isNull());
+
+    auto n = value.size();
+    writeHeader(3 /*text string*/, n);
+    writeBytes(reinterpret_cast<const uint8_t*>(value.c_str()), n);
+    return bytesWritten();
+  }
+
+  size_t visit(RawString value) {
+    writeBytes(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+    return bytesWritten();
+  }
+
+  size_t visit(JsonInteger value) {
+    if (value >= 0)
+      writeHeader(0 /*unsigned*/, JsonUInt(value));
+    else
+      writeHeader(1 /*negative*/, JsonUInt(-1 - value));
+    return bytesWritten();
+  }
+
+  size_t visit(JsonUInt value) {
+    writeHeader(0 /*unsigned*/, value);
+    return bytesWritten();
+  }
+
+  size_t visit(bool value) {
+    writeByte(value ? 0xF5 : 0xF4);
+    return bytesWritten();
+  }
+
+  size_t visit(nullptr_t) {
+    writeByte(0xF6);
+    return bytesWritten();
+  }
+
+ private:
+  size_t bytesWritten() const {
+    return writer_.count();
+  }
+
+  void writeByte(uint8_t c) {
+    writer_.write(c);
+  }
+
+  void writeBytes(const uint8_t* p, size_t n) {
+    writer_.write(p, n);
+  }
+
+  template <typename T>
+  void writeInteger(T value) {
+    fixEndianness(value);
+    writeBytes(reinterpret_cast<uint8_t*>(&value), sizeof(value));
+  }
+
+  // Writes the initial byte and the argument that follows (value or length)
+  void writeHeader(uint8_t majorType, JsonUInt argument) {
+    auto code = uint8_t(majorType << 5);
+    if (argument < 24) {
+      writeByte(uint8_t(code | argument));
+    } else if (argument <= 0xFF) {
+      writeByte(uint8_t(code | 24));
+      writeInteger(uint8_t(argument));
+    } else if (argument <= 0xFFFF) {
+      writeByte(uint8_t(code | 25));
+      writeInteger(uint16_t(argument));
+    }
+#if ARDUINOJSON_USE_LONG_LONG
+    else if (argument <= 0xFFFFFFFF)
+#else
+    else
+#endif
+    {
+      writeByte(uint8_t(code | 26));
+      writeInteger(uint32_t(argument));
+    }
+#if ARDUINOJSON_USE_LONG_LONG
+    else {
+      writeByte(uint8_t(code | 27));
+      writeInteger(uint64_t(argument));
+    }
+#endif
+  }
+
+  CountingDecorator<TWriter> writer_;
+  const ResourceManager* resources_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Produces a CBOR document.
+template <
+    typename TDestination,
+    detail::enable_if_t<!detail::is_pointer<TDestination>::value, int> = 0>
+inline size_t serializeCbor(JsonVariantConst source, TDestination& output) {
+  using namespace ArduinoJson::detail;
+  return serialize<CborSerializer>(source, output);
+}
+
+// Produces a CBOR document.
+inline size_t serializeCbor(JsonVariantConst source, void* output,
+                            size_t size) {
+  using namespace ArduinoJson::detail;
+  return serialize<CborSerializer>(source, output, size);
+}
+
+// Computes the length of the document that serializeCbor() produces.
+inline size_t measureCbor(JsonVariantConst source) {
+  using namespace ArduinoJson::detail;
+  return measure<CborSerializer>(source);
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
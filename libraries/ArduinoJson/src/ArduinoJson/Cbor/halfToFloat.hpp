@@ -0,0 +1,31 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Polyfills/alias_cast.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Converts an IEEE 754 half-precision float to a single-precision float.
+// The conversion is exact.
+inline float halfToFloat(uint16_t half) {
+  uint32_t sign = uint32_t(half & 0x8000) << 16;
+  uint32_t exponent = (half >> 10) & 0x1f;
+  uint32_t mantissa = half & 0x3ff;
+
+  if (exponent == 0) {  // zero or subnormal: mantissa * 2^-24
+    float value = float(mantissa) * 5.9604644775390625e-8f;
+    return sign ? -value : value;
+  }
+
+  if (exponent == 0x1f)  // infinity or NaN
+    exponent = 0xff;
+  else
+    exponent += 127 - 15;
+
+  return alias_cast<float>(sign | exponent << 23 | mantissa << 13);
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
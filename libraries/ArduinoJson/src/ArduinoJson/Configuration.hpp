@@ -145,6 +145,45 @@
 #  endif
 #endif
 
+// Number of strings above which the string pool builds a hash table to find
+// duplicates in constant time (0 to always use a linear search)
+// Disabled by default on 8-bit platforms because it's not worth the increase in
+// code size
+#ifndef ARDUINOJSON_STRING_INDEX_THRESHOLD
+#  if ARDUINOJSON_SIZEOF_POINTER <= 2
+#    define ARDUINOJSON_STRING_INDEX_THRESHOLD 0
+#  else
+#    define ARDUINOJSON_STRING_INDEX_THRESHOLD 16
+#  endif
+#endif
+
+// Number of members above which an object builds a hash table to find its keys
+// in constant time (0 to always use a linear search)
+// Disabled by default because each index takes some memory in addition to the
+// document
+#ifndef ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+#  define ARDUINOJSON_OBJECT_INDEX_THRESHOLD 0
+#endif
+
+// Convert the decimal numbers to the nearest float or double with the
+// Eisel-Lemire algorithm, instead of multiplying by powers of ten
+// Disabled by default on 8-bit platforms because the table of powers takes
+// 10KB (1.8KB when ARDUINOJSON_USE_DOUBLE is 0)
+#ifndef ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING
+#  if ARDUINOJSON_SIZEOF_POINTER <= 2
+#    define ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING 0
+#  else
+#    define ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING 1
+#  endif
+#endif
+
+// Write the floats and doubles with the fewest digits that read back as the
+// same value (Schubfach algorithm), instead of a fixed number of decimal places
+// Disabled by default because doubles can produce up to 17 digits instead of 9
+#ifndef ARDUINOJSON_ENABLE_SHORTEST_FLOAT_FORMATTING
+#  define ARDUINOJSON_ENABLE_SHORTEST_FLOAT_FORMATTING 0
+#endif
+
 #ifdef ARDUINO
 
 // Enable support for Arduino's String class
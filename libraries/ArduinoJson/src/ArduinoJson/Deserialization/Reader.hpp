@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
 
 #include <stdlib.h>  // for size_t
@@ -37,9 +38,30 @@ struct BoundedReader {
   // constructor
 };
 
+// A reader of a contiguous buffer in RAM exposes it with begin(), allowing
+// the deserializers to scan it in bulk. It also exposes end(), unless the
+// buffer is null-terminated: then the end is found as the scan goes, so the
+// input isn't read further than the deserializer needs.
+template <typename TReader, typename Enable = void>
+struct IsContiguousReader : false_type {};
+
+template <typename TReader>
+struct IsContiguousReader<TReader,
+                          void_t<decltype(declval<const TReader&>().begin())>>
+    : is_same<decltype(declval<const TReader&>().begin()), const char*> {};
+
+template <typename TReader, typename Enable = void>
+struct IsNullTerminatedReader : IsContiguousReader<TReader> {};
+
+template <typename TReader>
+struct IsNullTerminatedReader<TReader,
+                              void_t<decltype(declval<const TReader&>().end())>>
+    : false_type {};
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
 
 #include <ArduinoJson/Deserialization/Readers/IteratorReader.hpp>
+#include <ArduinoJson/Deserialization/Readers/InSituReader.hpp>
 #include <ArduinoJson/Deserialization/Readers/RamReader.hpp>
 #include <ArduinoJson/Deserialization/Readers/VariantReader.hpp>
 
@@ -0,0 +1,26 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Reads the buffer of an InSituJsonDocument.
+// The deserializer writes the strings back in the buffer, so it selects the
+// InSituStringBuilder for this reader.
+class InSituReader : public IteratorReader<const char*> {
+ public:
+  InSituReader(char* buffer, size_t size)
+      : IteratorReader<const char*>(buffer, buffer + size) {}
+};
+
+template <typename TReader>
+struct IsInSituReader : false_type {};
+
+template <>
+struct IsInSituReader<InSituReader> : true_type {};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -29,14 +29,40 @@ class IteratorReader {
       buffer[i++] = *ptr_++;
     return i;
   }
+
+  TIterator begin() const {
+    return ptr_;
+  }
+
+  TIterator end() const {
+    return end_;
+  }
 };
 
-template <typename TSource>
-struct Reader<TSource, void_t<typename TSource::const_iterator>>
-    : IteratorReader<typename TSource::const_iterator> {
-  explicit Reader(const TSource& source)
+template <typename TSource, typename Enable = void>
+struct ContainerReader : IteratorReader<typename TSource::const_iterator> {
+  explicit ContainerReader(const TSource& source)
       : IteratorReader<typename TSource::const_iterator>(source.begin(),
                                                          source.end()) {}
 };
 
+// The containers that store their characters contiguously (std::string,
+// std::string_view, std::vector<char>...) are read through a pointer, so
+// they can be scanned in bulk
+template <typename TSource>
+struct ContainerReader<
+    TSource, enable_if_t<is_same<decltype(declval<const TSource&>().data()),
+                                 const char*>::value>>
+    : IteratorReader<const char*> {
+  explicit ContainerReader(const TSource& source)
+      : IteratorReader<const char*>(source.data(),
+                                    source.data() + source.size()) {}
+};
+
+template <typename TSource>
+struct Reader<TSource, void_t<typename TSource::const_iterator>>
+    : ContainerReader<TSource> {
+  explicit Reader(const TSource& source) : ContainerReader<TSource>(source) {}
+};
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -35,6 +35,11 @@ struct Reader<TSource*, enable_if_t<IsCharOrVoid<TSource>::value>> {
       buffer[i] = *ptr_++;
     return length;
   }
+
+  // The input ends at the first null character, there is no end()
+  const char* begin() const {
+    return ptr_;
+  }
 };
 
 template <typename TSource>
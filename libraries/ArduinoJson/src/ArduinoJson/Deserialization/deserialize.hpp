@@ -40,6 +40,16 @@ inline void shrinkJsonDocument(JsonDocument& doc) {
 }
 #endif
 
+template <typename TDestination>
+inline void resetDestination(TDestination& dst) {
+  dst.clear();
+}
+
+// Keep the memory pools of a document that is parsed again
+inline void resetDestination(JsonDocument& doc) {
+  doc.reset();
+}
+
 template <template <typename> class TDeserializer, typename TDestination,
           typename TReader, typename TOptions>
 DeserializationError doDeserialize(TDestination&& dst, TReader reader,
@@ -48,7 +58,7 @@ DeserializationError doDeserialize(TDestination&& dst, TReader reader,
   if (!data)
     return DeserializationError::NoMemory;
   auto resources = VariantAttorney::getResourceManager(dst);
-  dst.clear();
+  resetDestination(dst);
   auto err = TDeserializer<TReader>(resources, reader)
                  .parse(*data, options.filter, options.nestingLimit);
   shrinkJsonDocument(dst);
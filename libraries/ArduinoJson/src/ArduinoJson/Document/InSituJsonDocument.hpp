@@ -0,0 +1,58 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Document/JsonDocument.hpp>
+
+#include <string.h>  // strlen
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A JSON document that parses a mutable buffer in place.
+// The strings are unescaped in the buffer, and the document points to them
+// instead of copying them, so the buffer must outlive the document.
+// For this reason, the document can be copied to a JsonDocument (which copies
+// the strings) but it cannot be moved or swapped into one. Through a
+// JsonDocument reference, a move or a swap copies the strings as well.
+// The buffer can only be parsed once: the next deserializeJson() returns
+// InvalidInput.
+class InSituJsonDocument : public JsonDocument {
+ public:
+  template <typename TChar,
+            detail::enable_if_t<detail::IsCharOrVoid<TChar>::value &&
+                                    !detail::is_const<TChar>::value,
+                                int> = 0>
+  InSituJsonDocument(TChar* buffer, size_t size,
+                     Allocator* alloc = detail::DefaultAllocator::instance())
+      : JsonDocument(alloc),
+        buffer_(reinterpret_cast<char*>(buffer)),
+        size_(size) {
+    borrowsStrings_ = true;
+  }
+
+  // The input ends at the first null character
+  explicit InSituJsonDocument(
+      char* buffer, Allocator* alloc = detail::DefaultAllocator::instance())
+      : InSituJsonDocument(buffer, buffer ? strlen(buffer) : 0, alloc) {}
+
+  InSituJsonDocument(const InSituJsonDocument&) = delete;
+  InSituJsonDocument& operator=(const InSituJsonDocument&) = delete;
+
+  friend void swap(InSituJsonDocument&, JsonDocument&) = delete;
+  friend void swap(JsonDocument&, InSituJsonDocument&) = delete;
+
+  template <typename... Args>
+  friend DeserializationError deserializeJson(InSituJsonDocument& doc,
+                                              Args&&... args);
+
+ private:
+  char* buffer_;
+  size_t size_;
+  bool consumed_ = false;  // the strings of the buffer have been unescaped
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
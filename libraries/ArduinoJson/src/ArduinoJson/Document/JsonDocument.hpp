@@ -15,10 +15,13 @@
 
 ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
 
+class InSituJsonDocument;
+
 // A JSON document.
 // https://arduinojson.org/v7/api/jsondocument/
 class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
   friend class detail::VariantAttorney;
+  friend class InSituJsonDocument;
 
  public:
   explicit JsonDocument(Allocator* alloc = detail::DefaultAllocator::instance())
@@ -30,11 +33,19 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
   }
 
   // Move-constructor
+  // (copies an InSituJsonDocument passed as a JsonDocument, see swap())
   JsonDocument(JsonDocument&& src)
       : JsonDocument(detail::DefaultAllocator::instance()) {
-    swap(*this, src);
+    if (src.borrowsStrings_)
+      set(src);
+    else
+      swap(*this, src);
   }
 
+  // The strings of an InSituJsonDocument belong to its buffer, so it can only
+  // be copied
+  JsonDocument(InSituJsonDocument&&) = delete;
+
   // Construct from variant, array, or object
   template <typename T,
             detail::enable_if_t<detail::IsVariant<T>::value ||
@@ -91,6 +102,14 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
     data_.reset();
   }
 
+  // Empties the document, but keeps the memory pools for the next values.
+  // deserializeJson() and deserializeMsgPack() do this, so that parsing into
+  // the same document again doesn't allocate the pools again.
+  void reset() {
+    resources_.reset();
+    data_.reset();
+  }
+
   // Returns true if the root is of the specified type.
   // https://arduinojson.org/v7/api/jsondocument/is/
   template <typename T>
@@ -333,7 +352,16 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
     return getVariant();
   }
 
+  // The strings of an InSituJsonDocument point to its buffer: when one is
+  // reached through a JsonDocument reference, the contents are exchanged by
+  // copies, which own their strings
   friend void swap(JsonDocument& a, JsonDocument& b) {
+    if (a.borrowsStrings_ || b.borrowsStrings_) {
+      JsonDocument tmp(a);
+      a.set(b);
+      b.set(tmp);
+      return;
+    }
     swap(a.resources_, b.resources_);
     swap_(a.data_, b.data_);
   }
@@ -417,6 +445,7 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
 
   detail::ResourceManager resources_;
   detail::VariantData data_;
+  bool borrowsStrings_ = false;  // an InSituJsonDocument
 };
 
 inline void convertToJson(const JsonDocument& src, JsonVariant dst) {
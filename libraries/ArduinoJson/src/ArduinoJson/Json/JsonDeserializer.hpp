@@ -9,6 +9,7 @@
 #include <ArduinoJson/Json/Latch.hpp>
 #include <ArduinoJson/Json/Utf16.hpp>
 #include <ArduinoJson/Json/Utf8.hpp>
+#include <ArduinoJson/Memory/InSituStringBuilder.hpp>
 #include <ArduinoJson/Memory/ResourceManager.hpp>
 #include <ArduinoJson/Numbers/parseNumber.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
@@ -16,10 +17,19 @@
 #include <ArduinoJson/Polyfills/utility.hpp>
 #include <ArduinoJson/Variant/VariantData.hpp>
 
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+template <typename TInput>
+class JsonPullParser;
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 template <typename TReader>
 class JsonDeserializer {
+  // JsonPullParser reads the tokens one by one
+  template <typename>
+  friend class ArduinoJson::JsonPullParser;
+
  public:
   JsonDeserializer(ResourceManager* resources, TReader reader)
       : stringBuilder_(resources),
@@ -402,6 +412,8 @@ class JsonDeserializer {
 
     move();
     for (;;) {
+      latch_.readStringRun(stopChar, stringBuilder_);
+
       char c = current();
       move();
       if (c == stopChar)
@@ -480,6 +492,8 @@ class JsonDeserializer {
 
     move();
     for (;;) {
+      latch_.skipStringRun(stopChar);
+
       char c = current();
       move();
       if (c == stopChar)
@@ -614,7 +628,7 @@ class JsonDeserializer {
         case '\t':
         case '\r':
         case '\n':
-          move();
+          latch_.skipSpaces();
           continue;
 
 #if ARDUINOJSON_ENABLE_COMMENTS
@@ -680,7 +694,9 @@ class JsonDeserializer {
     return DeserializationError::Ok;
   }
 
-  StringBuilder stringBuilder_;
+  conditional_t<IsInSituReader<TReader>::value, InSituStringBuilder,
+                StringBuilder>
+      stringBuilder_;
   bool foundSomething_;
   Latch<TReader> latch_;
   ResourceManager* resources_;
@@ -717,4 +733,19 @@ inline DeserializationError deserializeJson(TDestination&& dst, TChar* input,
                                        input, detail::forward<Args>(args)...);
 }
 
+// Parses the buffer of an InSituJsonDocument, leaving the strings in place.
+// The buffer is modified, so it can only be parsed once.
+// https://arduinojson.org/v7/api/json/deserializejson/
+template <typename... Args>
+inline DeserializationError deserializeJson(InSituJsonDocument& doc,
+                                            Args&&... args) {
+  using namespace detail;
+  if (doc.consumed_)
+    return DeserializationError::InvalidInput;
+  doc.consumed_ = true;
+  return doDeserialize<JsonDeserializer>(
+      static_cast<JsonDocument&>(doc), InSituReader(doc.buffer_, doc.size_),
+      makeDeserializationOptions(args...));
+}
+
 ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,260 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+#include <ArduinoJson/Variant/JsonVariantConst.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+enum class JsonToken : uint8_t {
+  ObjectStart,
+  ObjectEnd,
+  ArrayStart,
+  ArrayEnd,
+  Key,
+  Value,
+  EndOfDocument,
+  Error,
+};
+
+// Reads a JSON input one token at a time, instead of building a JsonDocument.
+// The memory usage doesn't depend on the size of the input: only the longest
+// string and the last value are kept.
+template <typename TInput>
+class JsonPullParser {
+  using reader_type = detail::Reader<TInput>;
+
+ public:
+  template <typename T>
+  explicit JsonPullParser(
+      T&& input, DeserializationOption::NestingLimit nestingLimit = {},
+      Allocator* alloc = detail::DefaultAllocator::instance())
+      : resources_(alloc),
+        deserializer_(&resources_, reader_type(detail::forward<T>(input))),
+        maxDepth_(countLevels(nestingLimit)) {}
+
+  JsonPullParser(const JsonPullParser&) = delete;
+  JsonPullParser& operator=(const JsonPullParser&) = delete;
+
+  // Reads the next token.
+  // After Key, the key is available in key(); after Value, the value is
+  // available in value(). Both remain valid until the next call.
+  JsonToken next() {
+    value_.clear(&resources_);
+    token_ = readToken();
+    return token_;
+  }
+
+  // Skips the value of the last Key, or the rest of the last ObjectStart or
+  // ArrayStart.
+  // Returns the last token skipped.
+  JsonToken skip() {
+    switch (token_) {
+      case JsonToken::Key: {
+        auto err = deserializer_.skipVariant(
+            DeserializationOption::NestingLimit(uint8_t(maxDepth_ - depth_)));
+        if (err)
+          return token_ = fail(err);
+        state_ = State::AfterValue;
+        return token_ = JsonToken::Value;
+      }
+
+      case JsonToken::ObjectStart:
+      case JsonToken::ArrayStart: {
+        uint8_t depth = depth_;
+        while (depth_ >= depth && next() != JsonToken::Error)
+          ;
+        return token_;
+      }
+
+      default:
+        return token_;
+    }
+  }
+
+  JsonString key() const {
+    ARDUINOJSON_ASSERT(token_ == JsonToken::Key);
+    return deserializer_.stringBuilder_.str();
+  }
+
+  JsonVariantConst value() const {
+    return JsonVariantConst(&value_, &resources_);
+  }
+
+  DeserializationError error() const {
+    return error_;
+  }
+
+  // Returns the number of objects and arrays that contain the current token
+  uint8_t depth() const {
+    return depth_;
+  }
+
+ private:
+  enum class State : uint8_t {
+    Value,
+    FirstElement,
+    Key,
+    FirstKey,
+    AfterValue,
+    Done,
+  };
+
+  JsonToken readToken() {
+    if (error_)
+      return JsonToken::Error;
+    if (state_ == State::Done)
+      return JsonToken::EndOfDocument;
+
+    for (;;) {
+      auto err = deserializer_.skipSpacesAndComments();
+      if (err)
+        return fail(err);
+
+      char c = deserializer_.current();
+      switch (state_) {
+        case State::FirstElement:
+          if (c == ']') {
+            deserializer_.move();
+            return leave(JsonToken::ArrayEnd);
+          }
+          return readValue(c);
+
+        case State::Value:
+          return readValue(c);
+
+        case State::FirstKey:
+          if (c == '}') {
+            deserializer_.move();
+            return leave(JsonToken::ObjectEnd);
+          }
+          return readKey();
+
+        case State::Key:
+          return readKey();
+
+        default:
+          ARDUINOJSON_ASSERT(state_ == State::AfterValue);
+          if (c == (inObject() ? '}' : ']')) {
+            deserializer_.move();
+            return leave(inObject() ? JsonToken::ObjectEnd
+                                    : JsonToken::ArrayEnd);
+          }
+          if (c != ',')
+            return fail(DeserializationError::InvalidInput);
+          deserializer_.move();
+          state_ = inObject() ? State::Key : State::Value;
+          break;
+      }
+    }
+  }
+
+  JsonToken readValue(char c) {
+    DeserializationError::Code err;
+
+    switch (c) {
+      case '[':
+        return enter(false);
+
+      case '{':
+        return enter(true);
+
+      case '\"':
+      case '\'':
+        deserializer_.stringBuilder_.startString();
+        err = deserializer_.parseQuotedString();
+        if (!err)
+          value_.setBorrowedString(deserializer_.stringBuilder_.str().c_str());
+        break;
+
+      case 't':
+        value_.setBoolean(true);
+        err = deserializer_.skipKeyword("true");
+        break;
+
+      case 'f':
+        value_.setBoolean(false);
+        err = deserializer_.skipKeyword("false");
+        break;
+
+      case 'n':
+        err = deserializer_.skipKeyword("null");
+        break;
+
+      default:
+        err = deserializer_.parseNumericValue(value_);
+        break;
+    }
+
+    if (err)
+      return fail(err);
+    state_ = depth_ ? State::AfterValue : State::Done;
+    return JsonToken::Value;
+  }
+
+  JsonToken readKey() {
+    auto err = deserializer_.parseKey();
+    if (!err)
+      err = deserializer_.skipSpacesAndComments();
+    if (err)
+      return fail(err);
+    if (!deserializer_.eat(':'))
+      return fail(DeserializationError::InvalidInput);
+    state_ = State::Value;
+    return JsonToken::Key;
+  }
+
+  JsonToken enter(bool isObject) {
+    if (depth_ >= maxDepth_)
+      return fail(DeserializationError::TooDeep);
+    deserializer_.move();
+    uint8_t mask = uint8_t(1 << (depth_ % 8));
+    if (isObject)
+      objects_[depth_ / 8] |= mask;
+    else
+      objects_[depth_ / 8] &= uint8_t(~mask);
+    depth_++;
+    state_ = isObject ? State::FirstKey : State::FirstElement;
+    return isObject ? JsonToken::ObjectStart : JsonToken::ArrayStart;
+  }
+
+  JsonToken leave(JsonToken token) {
+    depth_--;
+    state_ = depth_ ? State::AfterValue : State::Done;
+    return token;
+  }
+
+  JsonToken fail(DeserializationError::Code err) {
+    error_ = err;
+    return JsonToken::Error;
+  }
+
+  bool inObject() const {
+    ARDUINOJSON_ASSERT(depth_ > 0);
+    return (objects_[(depth_ - 1) / 8] >> ((depth_ - 1) % 8)) & 1;
+  }
+
+  static uint8_t countLevels(DeserializationOption::NestingLimit limit) {
+    uint8_t n = 0;
+    while (!limit.reached()) {
+      limit = limit.decrement();
+      n++;
+    }
+    return n;
+  }
+
+  detail::ResourceManager resources_;
+  detail::JsonDeserializer<reader_type> deserializer_;
+  detail::VariantData value_;
+  DeserializationError::Code error_ = DeserializationError::Ok;
+  JsonToken token_ = JsonToken::EndOfDocument;
+  State state_ = State::Value;
+  uint8_t depth_ = 0;
+  uint8_t maxDepth_;
+  uint8_t objects_[32];  // one bit per level: 1 for objects, 0 for arrays
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -4,11 +4,14 @@
 
 #pragma once
 
+#include <ArduinoJson/Deserialization/Reader.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 
+#include <string.h>  // memchr, memcpy
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
-template <typename TReader>
+template <typename TReader, typename Enable = void>
 class Latch {
  public:
   Latch(TReader reader) : reader_(reader), loaded_(false) {
@@ -32,7 +35,35 @@ class Latch {
     return current_;
   }
 
+  void skipSpaces() {
+    while (isSpace(current()))
+      clear();
+  }
+
+  // Appends the characters up to `stopChar`, a backslash or the end
+  template <typename TString>
+  void readStringRun(char stopChar, TString& str) {
+    char c = current();
+    while (c != stopChar && c != '\\' && c != '\0') {
+      str.append(c);
+      clear();
+      c = current();
+    }
+  }
+
+  void skipStringRun(char stopChar) {
+    char c = current();
+    while (c != stopChar && c != '\\' && c != '\0') {
+      clear();
+      c = current();
+    }
+  }
+
  private:
+  static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+  }
+
   void load() {
     ARDUINOJSON_ASSERT(!ended_);
     int c = reader_.read();
@@ -53,4 +84,142 @@ class Latch {
 #endif
 };
 
+// When the whole input is in RAM, there is no need to read it one character
+// at a time: whitespace and string runs are scanned a word at a time.
+// The end of a null-terminated input is looked for a few bytes ahead of the
+// scan, so that the rest of the buffer isn't read when parsing stops early.
+template <typename TReader>
+class Latch<TReader, enable_if_t<IsContiguousReader<TReader>::value>> {
+  using word_t = size_t;
+  static const size_t lookAhead = 64;
+
+ public:
+  Latch(TReader reader)
+      : ptr_(reader.begin()),
+        end_(endOf(reader, IsNullTerminatedReader<TReader>())),
+        ended_(!IsNullTerminatedReader<TReader>::value) {}
+
+  void clear() {
+    if (ptr_ < end_)
+      ptr_++;
+  }
+
+  int last() const {
+    return ptr_ < end_ ? *ptr_ : 0;
+  }
+
+  FORCE_INLINE char current() {
+    return (ptr_ < end_ || extend()) ? *ptr_ : '\0';
+  }
+
+  void skipSpaces() {
+    // Most runs are short, so the words are only used for the long ones
+    size_t n = 0;
+    while ((ptr_ < end_ || extend()) && isSpace(*ptr_)) {
+      ptr_++;
+      if (++n == sizeof(word_t)) {
+        skipSpaceWords();
+        n = 0;
+      }
+    }
+  }
+
+  template <typename TString>
+  void readStringRun(char stopChar, TString& str) {
+    do {
+      const char* start = ptr_;
+      ptr_ = findStringEnd(ptr_, end_, stopChar);
+      str.append(start, size_t(ptr_ - start));
+    } while (ptr_ == end_ && extend());
+  }
+
+  void skipStringRun(char stopChar) {
+    do {
+      ptr_ = findStringEnd(ptr_, end_, stopChar);
+    } while (ptr_ == end_ && extend());
+  }
+
+ private:
+  static const char* endOf(const TReader& reader, false_type) {
+    return reader.end();
+  }
+
+  static const char* endOf(const TReader& reader, true_type) {
+    return reader.begin();
+  }
+
+  // Moves end_ forward, up to the null terminator, returns false at the end
+  bool extend() {
+    if (ended_)
+      return false;
+    const void* nul = memchr(end_, 0, lookAhead);
+    if (nul) {
+      ended_ = true;
+      bool moved = nul != end_;
+      end_ = static_cast<const char*>(nul);
+      return moved;
+    }
+    end_ += lookAhead;
+    return true;
+  }
+  static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+  }
+
+  void skipSpaceWords() {
+    const word_t spaces = repeat(' ');
+    const word_t tabs = repeat('\t');
+    const word_t crs = repeat('\r');
+    const word_t lfs = repeat('\n');
+    while (size_t(end_ - ptr_) >= sizeof(word_t)) {
+      word_t w = load(ptr_);
+      word_t matches = zeroBytes(w ^ spaces) | zeroBytes(w ^ tabs) |
+                       zeroBytes(w ^ crs) | zeroBytes(w ^ lfs);
+      if (matches != highBits())
+        break;
+      ptr_ += sizeof(word_t);
+    }
+  }
+
+  static constexpr word_t repeat(char c) {
+    return word_t(~word_t(0) / 0xFF) * static_cast<unsigned char>(c);
+  }
+
+  static constexpr word_t highBits() {
+    return repeat('\x80');
+  }
+
+  static word_t load(const char* p) {
+    word_t w;
+    memcpy(&w, p, sizeof(w));  // unaligned loads are fine with memcpy()
+    return w;
+  }
+
+  // Sets the high bit of each zero byte, and only of them
+  static word_t zeroBytes(word_t w) {
+    const word_t low7 = repeat('\x7F');
+    return ~(((w & low7) + low7) | w | low7);
+  }
+
+  // Finds the first `stopChar`, backslash or null character
+  static const char* findStringEnd(const char* p, const char* end,
+                                   char stopChar) {
+    const word_t stops = repeat(stopChar);
+    const word_t backslashes = repeat('\\');
+    while (size_t(end - p) >= sizeof(word_t)) {
+      word_t w = load(p);
+      if (zeroBytes(w) | zeroBytes(w ^ stops) | zeroBytes(w ^ backslashes))
+        break;
+      p += sizeof(word_t);
+    }
+    while (p < end && *p != stopChar && *p != '\\' && *p != '\0')
+      p++;
+    return p;
+  }
+
+  const char* ptr_;
+  const char* end_;  // the part of a null-terminated input found so far
+  bool ended_;
+};
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -10,6 +10,7 @@
 #include <ArduinoJson/Json/EscapeSequence.hpp>
 #include <ArduinoJson/Numbers/FloatParts.hpp>
 #include <ArduinoJson/Numbers/JsonInteger.hpp>
+#include <ArduinoJson/Numbers/floatToDecimal.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/attributes.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
@@ -66,30 +67,19 @@ class TextFormatter {
 
   template <typename T>
   void writeFloat(T value) {
+#if ARDUINOJSON_ENABLE_SHORTEST_FLOAT_FORMATTING
+    // Keep floats as floats, so that 0.1f is written as 0.1
+    using float_type =
+        conditional_t<(sizeof(T) < sizeof(JsonFloat)), T, JsonFloat>;
+    writeShortestFloat(float_type(value));
+#else
     writeFloat(JsonFloat(value), sizeof(T) >= 8 ? 9 : 6);
+#endif
   }
 
   void writeFloat(JsonFloat value, int8_t decimalPlaces) {
-    if (isnan(value))
-      return writeRaw(ARDUINOJSON_ENABLE_NAN ? "NaN" : "null");
-
-#if ARDUINOJSON_ENABLE_INFINITY
-    if (value < 0.0) {
-      writeRaw('-');
-      value = -value;
-    }
-
-    if (isinf(value))
-      return writeRaw("Infinity");
-#else
-    if (isinf(value))
-      return writeRaw("null");
-
-    if (value < 0.0) {
-      writeRaw('-');
-      value = -value;
-    }
-#endif
+    if (writeSignOrSpecialFloat(value))
+      return;
 
     auto parts = decomposeFloat(value, decimalPlaces);
 
@@ -103,6 +93,56 @@ class TextFormatter {
     }
   }
 
+#if ARDUINOJSON_ENABLE_SHORTEST_FLOAT_FORMATTING
+  // Writes the fewest digits that read back as the same value
+  template <typename T>
+  void writeShortestFloat(T value) {
+    if (writeSignOrSpecialFloat(value))
+      return;
+
+    if (value == 0)
+      return writeRaw('0');
+
+    auto decimal = floatToDecimal(value);
+
+    // write the digits in reverse order
+    char buffer[20];
+    char* end = buffer + sizeof(buffer);
+    char* begin = end;
+    do {
+      *--begin = char(decimal.significand % 10 + '0');
+      decimal.significand /= 10;
+    } while (decimal.significand);
+
+    int digits = int(end - begin);
+    int exponent = digits - 1 + decimal.exponent;  // of the first digit
+
+    if (value >= ARDUINOJSON_POSITIVE_EXPONENTIATION_THRESHOLD ||
+        value <= ARDUINOJSON_NEGATIVE_EXPONENTIATION_THRESHOLD) {
+      writeRaw(*begin);
+      if (digits > 1) {
+        writeRaw('.');
+        writeRaw(begin + 1, end);
+      }
+      writeRaw('e');
+      writeInteger(int16_t(exponent));
+    } else if (exponent < 0) {
+      writeRaw("0.");
+      for (int i = exponent + 1; i < 0; i++)
+        writeRaw('0');
+      writeRaw(begin, end);
+    } else if (exponent + 1 < digits) {
+      writeRaw(begin, begin + exponent + 1);
+      writeRaw('.');
+      writeRaw(begin + exponent + 1, end);
+    } else {
+      writeRaw(begin, end);
+      for (int i = digits; i <= exponent; i++)
+        writeRaw('0');
+    }
+  }
+#endif
+
   template <typename T>
   enable_if_t<is_signed<T>::value> writeInteger(T value) {
     using unsigned_type = make_unsigned_t<T>;
@@ -149,6 +189,40 @@ class TextFormatter {
     writeRaw(begin, end);
   }
 
+  // Writes NaN, Infinity or the minus sign.
+  // Returns true if there is nothing else to write.
+  template <typename T>
+  bool writeSignOrSpecialFloat(T& value) {
+    if (isnan(value)) {
+      writeRaw(ARDUINOJSON_ENABLE_NAN ? "NaN" : "null");
+      return true;
+    }
+
+#if ARDUINOJSON_ENABLE_INFINITY
+    if (value < 0.0) {
+      writeRaw('-');
+      value = -value;
+    }
+
+    if (isinf(value)) {
+      writeRaw("Infinity");
+      return true;
+    }
+#else
+    if (isinf(value)) {
+      writeRaw("null");
+      return true;
+    }
+
+    if (value < 0.0) {
+      writeRaw('-');
+      value = -value;
+    }
+#endif
+
+    return false;
+  }
+
   void writeRaw(const char* s) {
     writer_.write(reinterpret_cast<const uint8_t*>(s), strlen(s));
   }
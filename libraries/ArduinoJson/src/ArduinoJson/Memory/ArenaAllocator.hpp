@@ -0,0 +1,136 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Alignment.hpp>
+#include <ArduinoJson/Memory/Allocator.hpp>
+
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// An allocator that takes the memory from a fixed buffer, like
+// StaticJsonDocument did in ArduinoJson 6.
+// The blocks are stacked: freeing the top block releases it, as well as the
+// blocks below that were already freed. When all the blocks are freed, the
+// whole buffer is available again.
+class ArenaAllocator : public Allocator {
+  struct Header {
+    size_t size;      // bytes after the header, excluding the padding
+    size_t previous;  // offset of the previous block, or noBlock
+    bool freed;
+  };
+
+  static const size_t noBlock = size_t(-1);
+  static const size_t headerSize = detail::AddPadding<sizeof(Header)>::value;
+
+ public:
+  ArenaAllocator(void* buffer, size_t capacity) {
+    auto begin = reinterpret_cast<char*>(buffer);
+    buffer_ = detail::addPadding(begin);
+    size_t padding = size_t(buffer_ - begin);
+    capacity_ = capacity > padding ? capacity - padding : 0;
+  }
+
+  virtual ~ArenaAllocator() = default;
+
+  ArenaAllocator(const ArenaAllocator&) = delete;
+  ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+  void* allocate(size_t size) override {
+    size_t end = top_ + headerSize + detail::addPadding(size);
+    if (end > capacity_ || end < top_)
+      return nullptr;
+    auto header = headerAt(top_);
+    header->size = size;
+    header->previous = last_;
+    header->freed = false;
+    last_ = top_;
+    top_ = end;
+    count_++;
+    return payload(last_);
+  }
+
+  void deallocate(void* ptr) override {
+    if (!ptr)
+      return;
+    headerOf(ptr)->freed = true;
+    if (--count_ == 0) {
+      reset();
+      return;
+    }
+    while (last_ != noBlock && headerAt(last_)->freed) {
+      top_ = last_;
+      last_ = headerAt(last_)->previous;
+    }
+  }
+
+  void* reallocate(void* ptr, size_t newSize) override {
+    if (!ptr)
+      return allocate(newSize);
+
+    auto header = headerOf(ptr);
+    if (offsetOf(ptr) == last_) {  // the top block can grow in place
+      size_t end = last_ + headerSize + detail::addPadding(newSize);
+      if (end > capacity_ || end < last_)
+        return nullptr;
+      header->size = newSize;
+      top_ = end;
+      return ptr;
+    }
+
+    if (newSize <= header->size)
+      return ptr;
+
+    void* newPtr = allocate(newSize);
+    if (newPtr) {
+      memcpy(newPtr, ptr, header->size);
+      deallocate(ptr);
+    }
+    return newPtr;
+  }
+
+  // Makes the whole buffer available again, in constant time.
+  // The blocks allocated so far must not be used anymore.
+  void reset() {
+    top_ = 0;
+    last_ = noBlock;
+    count_ = 0;
+  }
+
+  // Returns the number of bytes in use, including the headers of the blocks
+  size_t size() const {
+    return top_;
+  }
+
+  size_t capacity() const {
+    return capacity_;
+  }
+
+ private:
+  Header* headerAt(size_t offset) const {
+    return reinterpret_cast<Header*>(buffer_ + offset);
+  }
+
+  Header* headerOf(void* ptr) const {
+    return headerAt(offsetOf(ptr));
+  }
+
+  size_t offsetOf(void* ptr) const {
+    return size_t(reinterpret_cast<char*>(ptr) - buffer_) - headerSize;
+  }
+
+  void* payload(size_t offset) const {
+    return buffer_ + offset + headerSize;
+  }
+
+  char* buffer_;
+  size_t capacity_;
+  size_t top_ = 0;
+  size_t last_ = noBlock;
+  size_t count_ = 0;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,94 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/StringBuilder.hpp>
+
+#include <string.h>  // memmove
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Builds the strings of an InSituJsonDocument in the input buffer.
+// The unescaped string is never longer than the escaped one, so it's written
+// over the characters that were already read, and the closing quote leaves
+// room for the terminator.
+// A string is copied to the pool like with StringBuilder when it can't stay
+// in place: when it contains a NUL, or when it's a non-quoted key.
+class InSituStringBuilder {
+ public:
+  InSituStringBuilder(ResourceManager* resources) : copy_(resources) {}
+
+  void startString() {
+    begin_ = end_ = nullptr;
+    copying_ = false;
+  }
+
+  // The characters come from the buffer: the first run tells where the
+  // string starts
+  void append(const char* s, size_t n) {
+    if (copying_)
+      return copy_.append(s, n);
+    if (!begin_)
+      begin_ = end_ = const_cast<char*>(s);
+    if (end_ != s)
+      memmove(end_, s, n);
+    end_ += n;
+  }
+
+  void append(char c) {
+    if (!begin_ && !copying_)  // non-quoted keys aren't read in runs
+      startCopy();
+    else if (c == '\0' && !copying_)
+      startCopy();
+    if (copying_)
+      copy_.append(c);
+    else
+      *end_++ = c;
+  }
+
+  bool isValid() const {
+    return copying_ ? copy_.isValid() : true;
+  }
+
+  size_t size() const {
+    return copying_ ? copy_.size() : size_t(end_ - begin_);
+  }
+
+  JsonString str() const {
+    if (copying_)
+      return copy_.str();
+    *end_ = 0;  // the closing quote was already read
+    return JsonString(begin_, size());
+  }
+
+  void save(VariantData* variant) {
+    ARDUINOJSON_ASSERT(variant != nullptr);
+
+    if (copying_)
+      return copy_.save(variant);
+
+    size_t n = size();
+    *end_ = 0;
+    if (isTinyString(begin_, n))
+      variant->setTinyString(adaptString(begin_, n));
+    else
+      variant->setBorrowedString(begin_);
+  }
+
+ private:
+  void startCopy() {
+    copy_.startString();
+    if (begin_)
+      copy_.append(begin_, size());
+    copying_ = true;
+  }
+
+  StringBuilder copy_;
+  char* begin_ = nullptr;
+  char* end_ = nullptr;
+  bool copying_ = false;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
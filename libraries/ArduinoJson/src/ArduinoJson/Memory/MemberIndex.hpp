@@ -0,0 +1,182 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/MemoryPool.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+
+#include <stddef.h>  // offsetof
+#include <stdint.h>  // uint32_t
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+class CollectionData;
+
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+
+// A hash table of the keys of a large object (open addressing with linear
+// probing). It stores the slot ids of the keys; the hashes are recomputed from
+// the strings when needed.
+struct MemberIndex {
+  MemberIndex* next;
+  const CollectionData* object;
+  size_t capacity;  // always a power of two
+  size_t count;
+  SlotId tail;  // the last slot of the object that was indexed
+  SlotId keys[1];
+
+  static constexpr size_t sizeForCapacity(size_t n) {
+    return offsetof(MemberIndex, keys) + n * sizeof(SlotId);
+  }
+
+  static MemberIndex* create(const CollectionData* object, size_t capacity,
+                             Allocator* allocator) {
+    auto index = reinterpret_cast<MemberIndex*>(
+        allocator->allocate(sizeForCapacity(capacity)));
+    if (!index)
+      return nullptr;
+    index->object = object;
+    index->capacity = capacity;
+    index->count = 0;
+    index->tail = NULL_SLOT;
+    for (size_t i = 0; i < capacity; i++)
+      index->keys[i] = NULL_SLOT;
+    return index;
+  }
+
+  static void destroy(MemberIndex* index, Allocator* allocator) {
+    allocator->deallocate(index);
+  }
+
+  bool full() const {
+    return count * 2 >= capacity;
+  }
+
+  void insert(SlotId key, uint32_t hash) {
+    ARDUINOJSON_ASSERT(!full());
+    size_t mask = capacity - 1;
+    size_t i = hash & mask;
+    while (keys[i] != NULL_SLOT)
+      i = (i + 1) & mask;
+    keys[i] = key;
+    count++;
+  }
+
+  // Calls `match(slotId)` on each candidate until it returns true.
+  // Returns NULL_SLOT if there is none.
+  template <typename TMatch>
+  SlotId find(uint32_t hash, TMatch match) const {
+    size_t mask = capacity - 1;
+    for (size_t i = hash & mask; keys[i] != NULL_SLOT; i = (i + 1) & mask) {
+      if (match(keys[i]))
+        return keys[i];
+    }
+    return NULL_SLOT;
+  }
+
+  // `hashOf(slotId)` returns the hash of the key in the slot
+  template <typename THashOf>
+  void remove(SlotId key, THashOf hashOf) {
+    size_t mask = capacity - 1;
+    size_t i = hashOf(key) & mask;
+    while (keys[i] != key) {
+      if (keys[i] == NULL_SLOT)
+        return;
+      i = (i + 1) & mask;
+    }
+    count--;
+
+    // Move back the following keys that wouldn't be found anymore
+    size_t hole = i;
+    for (;;) {
+      i = (i + 1) & mask;
+      if (keys[i] == NULL_SLOT)
+        break;
+      size_t home = hashOf(keys[i]) & mask;
+      if (((i - home) & mask) >= ((i - hole) & mask)) {
+        keys[hole] = keys[i];
+        hole = i;
+      }
+    }
+    keys[hole] = NULL_SLOT;
+  }
+};
+
+// The indexes of the objects of a document.
+// There are few of them, so they are stored in a list where the last one used
+// comes first.
+class MemberIndexList {
+ public:
+  MemberIndexList() = default;
+  MemberIndexList(const MemberIndexList&) = delete;
+  void operator=(const MemberIndexList&) = delete;
+
+  ~MemberIndexList() {
+    ARDUINOJSON_ASSERT(head_ == nullptr);
+  }
+
+  bool empty() const {
+    return head_ == nullptr;
+  }
+
+  MemberIndex* find(const CollectionData* object) {
+    MemberIndex* prev = nullptr;
+    for (auto index = head_; index; index = index->next) {
+      if (index->object == object) {
+        if (prev) {
+          prev->next = index->next;
+          index->next = head_;
+          head_ = index;
+        }
+        return index;
+      }
+      prev = index;
+    }
+    return nullptr;
+  }
+
+  // Replaces the index of the object, if any
+  MemberIndex* create(const CollectionData* object, size_t capacity,
+                      Allocator* allocator) {
+    remove(object, allocator);
+    auto index = MemberIndex::create(object, capacity, allocator);
+    if (index) {
+      index->next = head_;
+      head_ = index;
+    }
+    return index;
+  }
+
+  void remove(const CollectionData* object, Allocator* allocator) {
+    MemberIndex* prev = nullptr;
+    for (auto index = head_; index; index = index->next) {
+      if (index->object == object) {
+        if (prev)
+          prev->next = index->next;
+        else
+          head_ = index->next;
+        MemberIndex::destroy(index, allocator);
+        return;
+      }
+      prev = index;
+    }
+  }
+
+  void clear(Allocator* allocator) {
+    while (head_) {
+      auto index = head_;
+      head_ = index->next;
+      MemberIndex::destroy(index, allocator);
+    }
+  }
+
+ private:
+  MemberIndex* head_ = nullptr;
+};
+
+#endif
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -81,6 +81,8 @@ class MemoryPool {
   }
 
   void shrinkToFit(Allocator* allocator) {
+    if (usage_ == capacity_)
+      return;
     auto newSlots = reinterpret_cast<T*>(
         allocator->reallocate(slots_, slotsToBytes(usage_)));
     if (newSlots) {
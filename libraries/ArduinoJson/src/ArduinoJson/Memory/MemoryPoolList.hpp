@@ -58,6 +58,7 @@ class MemoryPoolList {
     }
 
     swap_(a.count_, b.count_);
+    swap_(a.current_, b.current_);
     swap_(a.capacity_, b.capacity_);
     swap_(a.freeList_, b.freeList_);
   }
@@ -73,8 +74,10 @@ class MemoryPoolList {
       src.pools_ = nullptr;
     }
     count_ = src.count_;
+    current_ = src.current_;
     capacity_ = src.capacity_;
     src.count_ = 0;
+    src.current_ = 0;
     src.capacity_ = 0;
     return *this;
   }
@@ -85,9 +88,10 @@ class MemoryPoolList {
       return allocFromFreeList();
     }
 
-    // try to allocate from last pool (other pools are full)
-    if (count_) {
-      auto slot = allocFromLastPool();
+    // try to allocate from the current pool (the previous pools are full, and
+    // the next ones were emptied by reset())
+    for (; current_ < count_; current_++) {
+      auto slot = allocFromPool(current_);
       if (slot)
         return slot;
     }
@@ -97,7 +101,7 @@ class MemoryPoolList {
     if (!pool)
       return {};
 
-    return allocFromLastPool();
+    return allocFromPool(current_);
   }
 
   void freeSlot(Slot<T> slot) {
@@ -118,6 +122,7 @@ class MemoryPoolList {
     for (PoolCount i = 0; i < count_; i++)
       pools_[i].destroy(allocator);
     count_ = 0;
+    current_ = 0;
     freeList_ = NULL_SLOT;
     if (pools_ != preallocatedPools_) {
       allocator->deallocate(pools_);
@@ -126,6 +131,14 @@ class MemoryPoolList {
     }
   }
 
+  // Empties the pools, but keeps them for the next slots
+  void reset() {
+    for (PoolCount i = 0; i < count_; i++)
+      pools_[i].clear();
+    current_ = 0;
+    freeList_ = NULL_SLOT;
+  }
+
   SlotCount usage() const {
     SlotCount total = 0;
     for (PoolCount i = 0; i < count_; i++)
@@ -138,6 +151,11 @@ class MemoryPoolList {
   }
 
   void shrinkToFit(Allocator* allocator) {
+    // release the pools that reset() kept but that are still empty
+    while (count_ > 0 && pools_[count_ - 1].usage() == 0)
+      pools_[--count_].destroy(allocator);
+    if (current_ > count_)
+      current_ = count_;
     if (count_ > 0)
       pools_[count_ - 1].shrinkToFit(allocator);
     if (pools_ != preallocatedPools_ && count_ != capacity_) {
@@ -157,9 +175,8 @@ class MemoryPoolList {
     return {slot, id};
   }
 
-  Slot<T> allocFromLastPool() {
-    ARDUINOJSON_ASSERT(count_ > 0);
-    auto poolIndex = SlotId(count_ - 1);
+  Slot<T> allocFromPool(PoolCount poolIndex) {
+    ARDUINOJSON_ASSERT(poolIndex < count_);
     auto slot = pools_[poolIndex].allocSlot();
     if (!slot)
       return {};
@@ -170,6 +187,7 @@ class MemoryPoolList {
   Pool* addPool(Allocator* allocator) {
     if (count_ == capacity_ && !increaseCapacity(allocator))
       return nullptr;
+    current_ = count_;
     auto pool = &pools_[count_++];
     SlotCount poolCapacity = ARDUINOJSON_POOL_CAPACITY;
     if (count_ == maxPools)  // last pool is smaller because of NULL_SLOT
@@ -203,6 +221,7 @@ class MemoryPoolList {
   Pool preallocatedPools_[ARDUINOJSON_INITIAL_POOL_COUNT];
   Pool* pools_ = preallocatedPools_;
   PoolCount count_ = 0;
+  PoolCount current_ = 0;
   PoolCount capacity_ = ARDUINOJSON_INITIAL_POOL_COUNT;
   SlotId freeList_ = NULL_SLOT;
 
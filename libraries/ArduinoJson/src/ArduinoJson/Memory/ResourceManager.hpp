@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/MemberIndex.hpp>
 #include <ArduinoJson/Memory/MemoryPoolList.hpp>
 #include <ArduinoJson/Memory/StringPool.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
@@ -32,6 +33,9 @@ class ResourceManager {
       : allocator_(allocator), overflowed_(false) {}
 
   ~ResourceManager() {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    memberIndexes_.clear(allocator_);
+#endif
     stringPool_.clear(allocator_);
     variantPools_.clear(allocator_);
   }
@@ -40,6 +44,11 @@ class ResourceManager {
   ResourceManager& operator=(const ResourceManager& src) = delete;
 
   friend void swap(ResourceManager& a, ResourceManager& b) {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    // the root objects are not in the pools, so their addresses change
+    a.memberIndexes_.clear(a.allocator_);
+    b.memberIndexes_.clear(b.allocator_);
+#endif
     swap(a.stringPool_, b.stringPool_);
     swap(a.variantPools_, b.variantPools_);
     swap_(a.allocator_, b.allocator_);
@@ -81,7 +90,7 @@ class ResourceManager {
   }
 
   void saveString(StringNode* node) {
-    stringPool_.add(node);
+    stringPool_.add(node, allocator_);
   }
 
   template <typename TAdaptedString>
@@ -107,17 +116,56 @@ class ResourceManager {
     StringNode::destroy(node, allocator_);
   }
 
-  void dereferenceString(const char* s) {
-    stringPool_.dereference(s, allocator_);
+  void dereferenceString(StringNode* node) {
+    stringPool_.dereference(node, allocator_);
+  }
+
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  // The indexes are a cache: they are built on demand and not counted in
+  // size(), that's why these functions are const.
+
+  bool hasMemberIndexes() const {
+    return !memberIndexes_.empty();
+  }
+
+  MemberIndex* getMemberIndex(const CollectionData* object) const {
+    return memberIndexes_.find(object);
+  }
+
+  MemberIndex* createMemberIndex(const CollectionData* object,
+                                 size_t capacity) const {
+    return memberIndexes_.create(object, capacity, allocator_);
+  }
+
+  void removeMemberIndex(const CollectionData* object) const {
+    memberIndexes_.remove(object, allocator_);
   }
+#endif
 
   void clear() {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    memberIndexes_.clear(allocator_);
+#endif
     variantPools_.clear(allocator_);
     overflowed_ = false;
     stringPool_.clear(allocator_);
   }
 
+  // Like clear(), but keeps the variant pools for the next values
+  void reset() {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    memberIndexes_.clear(allocator_);
+#endif
+    variantPools_.reset();
+    overflowed_ = false;
+    stringPool_.clear(allocator_);
+  }
+
   void shrinkToFit() {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    // the slots may move
+    memberIndexes_.clear(allocator_);
+#endif
     variantPools_.shrinkToFit(allocator_);
   }
 
@@ -126,6 +174,9 @@ class ResourceManager {
   bool overflowed_;
   StringPool stringPool_;
   MemoryPoolList<SlotData> variantPools_;
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  mutable MemberIndexList memberIndexes_;
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
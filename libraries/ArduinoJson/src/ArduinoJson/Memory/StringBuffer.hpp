@@ -32,6 +32,24 @@ class StringBuffer {
     return node_->data;
   }
 
+  // Grows the string by n bytes, keeping its content, and returns a pointer
+  // to the new bytes
+  char* extend(size_t n) {
+    ARDUINOJSON_ASSERT(node_ != nullptr);
+    size_t size = size_ + n;
+    if (size < n)  // integer overflow
+      return nullptr;
+    if (size > node_->length) {
+      node_ = resources_->resizeString(node_, size);
+      if (!node_)
+        return nullptr;
+    }
+    char* p = node_->data + size_;
+    size_ = size;
+    node_->data[size] = 0;
+    return p;
+  }
+
   JsonString str() const {
     ARDUINOJSON_ASSERT(node_ != nullptr);
     return JsonString(node_->data, node_->length);
@@ -12,6 +12,10 @@
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
+// The strings are stored in a linked list.
+// Past ARDUINOJSON_STRING_INDEX_THRESHOLD strings, they are moved to a hash
+// table (open addressing with linear probing) so that add(), get() and
+// dereference() don't need to walk all the strings.
 class StringPool {
  public:
   StringPool() = default;
@@ -20,13 +24,31 @@ class StringPool {
 
   ~StringPool() {
     ARDUINOJSON_ASSERT(strings_ == nullptr);
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    ARDUINOJSON_ASSERT(index_ == nullptr);
+#endif
   }
 
   friend void swap(StringPool& a, StringPool& b) {
     swap_(a.strings_, b.strings_);
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    swap_(a.index_, b.index_);
+    swap_(a.indexCapacity_, b.indexCapacity_);
+    swap_(a.count_, b.count_);
+#endif
   }
 
   void clear(Allocator* allocator) {
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    if (index_) {
+      for (size_t i = 0; i < indexCapacity_; i++) {
+        if (index_[i])
+          StringNode::destroy(index_[i], allocator);
+      }
+      freeIndex(allocator);
+    }
+    count_ = 0;
+#endif
     while (strings_) {
       auto node = strings_;
       strings_ = node->next;
@@ -36,6 +58,15 @@ class StringPool {
 
   size_t size() const {
     size_t total = 0;
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    if (index_) {
+      for (size_t i = 0; i < indexCapacity_; i++) {
+        if (index_[i])
+          total += sizeofString(index_[i]->length);
+      }
+      return total;
+    }
+#endif
     for (auto node = strings_; node; node = node->next)
       total += sizeofString(node->length);
     return total;
@@ -59,18 +90,40 @@ class StringPool {
 
     stringGetChars(str, node->data, n);
     node->data[n] = 0;  // force NUL terminator
-    add(node);
+    add(node, allocator);
     return node;
   }
 
-  void add(StringNode* node) {
+  void add(StringNode* node, Allocator* allocator) {
     ARDUINOJSON_ASSERT(node != nullptr);
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    count_++;
+    if (index_ || count_ > ARDUINOJSON_STRING_INDEX_THRESHOLD) {
+      if (reserveIndex(allocator)) {
+        insertInIndex(node);
+        return;
+      }
+    }
+#else
+    (void)allocator;
+#endif
     node->next = strings_;
     strings_ = node;
   }
 
   template <typename TAdaptedString>
   StringNode* get(const TAdaptedString& str) const {
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    if (index_) {
+      for (size_t i = stringHash(str);; i++) {
+        auto node = index_[i & (indexCapacity_ - 1)];
+        if (!node)
+          return nullptr;
+        if (stringEquals(str, adaptString(node->data, node->length)))
+          return node;
+      }
+    }
+#endif
     for (auto node = strings_; node; node = node->next) {
       if (stringEquals(str, adaptString(node->data, node->length)))
         return node;
@@ -78,15 +131,29 @@ class StringPool {
     return nullptr;
   }
 
-  void dereference(const char* s, Allocator* allocator) {
+  void dereference(StringNode* target, Allocator* allocator) {
+    ARDUINOJSON_ASSERT(target != nullptr);
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    if (index_) {
+      if (--target->references == 0) {
+        removeFromIndex(target);
+        count_--;
+        StringNode::destroy(target, allocator);
+      }
+      return;
+    }
+#endif
     StringNode* prev = nullptr;
     for (auto node = strings_; node; node = node->next) {
-      if (node->data == s) {
+      if (node == target) {
         if (--node->references == 0) {
           if (prev)
             prev->next = node->next;
           else
             strings_ = node->next;
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+          count_--;
+#endif
           StringNode::destroy(node, allocator);
         }
         return;
@@ -96,6 +163,110 @@ class StringPool {
   }
 
  private:
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+  static size_t hashOf(const StringNode* node) {
+    return stringHash(adaptString(node->data, node->length));
+  }
+
+  // Makes sure the hash table can hold `count_` strings, keeping it at most
+  // half full. Moves the strings from the list when the table is created.
+  bool reserveIndex(Allocator* allocator) {
+    if (count_ * 2 <= indexCapacity_)
+      return true;
+
+    size_t newCapacity = indexCapacity_ ? indexCapacity_ * 2 : 4;
+    while (newCapacity < count_ * 2)
+      newCapacity *= 2;
+
+    auto newIndex = reinterpret_cast<StringNode**>(
+        allocator->allocate(newCapacity * sizeof(StringNode*)));
+    if (!newIndex) {
+      // keep a full table as long as there is an empty slot to stop the search
+      if (index_ && count_ < indexCapacity_)
+        return true;
+      moveIndexToList(allocator);
+      return false;
+    }
+
+    for (size_t i = 0; i < newCapacity; i++)
+      newIndex[i] = nullptr;
+
+    auto oldIndex = index_;
+    auto oldCapacity = indexCapacity_;
+    index_ = newIndex;
+    indexCapacity_ = newCapacity;
+
+    if (oldIndex) {
+      for (size_t i = 0; i < oldCapacity; i++) {
+        if (oldIndex[i])
+          insertInIndex(oldIndex[i]);
+      }
+      allocator->deallocate(oldIndex);
+    }
+
+    while (strings_) {
+      auto node = strings_;
+      strings_ = node->next;
+      insertInIndex(node);
+    }
+
+    return true;
+  }
+
+  void insertInIndex(StringNode* node) {
+    size_t mask = indexCapacity_ - 1;
+    size_t i = hashOf(node) & mask;
+    while (index_[i])
+      i = (i + 1) & mask;
+    index_[i] = node;
+  }
+
+  void removeFromIndex(StringNode* node) {
+    size_t mask = indexCapacity_ - 1;
+    size_t i = hashOf(node) & mask;
+    while (index_[i] != node) {
+      ARDUINOJSON_ASSERT(index_[i] != nullptr);
+      i = (i + 1) & mask;
+    }
+
+    // Move back the following strings that wouldn't be found anymore
+    size_t hole = i;
+    for (;;) {
+      i = (i + 1) & mask;
+      if (!index_[i])
+        break;
+      size_t home = hashOf(index_[i]) & mask;
+      if (((i - home) & mask) >= ((i - hole) & mask)) {
+        index_[hole] = index_[i];
+        hole = i;
+      }
+    }
+    index_[hole] = nullptr;
+  }
+
+  void moveIndexToList(Allocator* allocator) {
+    if (!index_)
+      return;
+    for (size_t i = 0; i < indexCapacity_; i++) {
+      if (index_[i]) {
+        index_[i]->next = strings_;
+        strings_ = index_[i];
+      }
+    }
+    freeIndex(allocator);
+  }
+
+  void freeIndex(Allocator* allocator) {
+    allocator->deallocate(index_);
+    index_ = nullptr;
+    indexCapacity_ = 0;
+  }
+
+  StringNode** index_ = nullptr;
+  size_t indexCapacity_ = 0;  // always a power of two
+  size_t count_ = 0;
+#endif
+
   StringNode* strings_ = nullptr;
 };
 
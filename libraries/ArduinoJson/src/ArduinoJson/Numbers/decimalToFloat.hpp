@@ -0,0 +1,129 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Numbers/FloatTraits.hpp>
+#include <ArduinoJson/Numbers/PowersOfFive.hpp>
+#include <ArduinoJson/Polyfills/uint128.hpp>
+
+#include <stdint.h>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+#if ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING
+
+template <typename T, size_t = sizeof(T)>
+struct EiselLemireTraits {};
+
+template <typename T>
+struct EiselLemireTraits<T, 8 /*64bits*/> {
+  using bits_type = uint64_t;
+  static const int mantissaBits = 52;
+  static const int minExponent = -1023;
+  static const int infinitePower = 0x7FF;
+  static const int minExponentRoundToEven = -4;
+  static const int maxExponentRoundToEven = 23;
+  static const int smallestPowerOfTen = -342;
+  static const int largestPowerOfTen = 308;
+};
+
+template <typename T>
+struct EiselLemireTraits<T, 4 /*32bits*/> {
+  using bits_type = uint32_t;
+  static const int mantissaBits = 23;
+  static const int minExponent = -127;
+  static const int infinitePower = 0xFF;
+  static const int minExponentRoundToEven = -17;
+  static const int maxExponentRoundToEven = 10;
+  static const int smallestPowerOfTen = -64;
+  static const int largestPowerOfTen = 38;
+};
+
+inline int countLeadingZeros(uint64_t x) {
+  ARDUINOJSON_ASSERT(x != 0);
+#  if defined(__GNUC__)
+  return __builtin_clzll(x);
+#  else
+  int n = 0;
+  while (!(x & (uint64_t(1) << 63))) {
+    x <<= 1;
+    n++;
+  }
+  return n;
+#  endif
+}
+
+// Returns the float or double closest to mantissa * 10^exponent.
+// The mantissa must have been read entirely (19 digits at most).
+// Daniel Lemire, "Number Parsing at a Gigabyte per Second", 2021
+// Noble Mushtak & Daniel Lemire, "Fast Number Parsing Without Fallback", 2023
+template <typename T>
+T decimalToFloat(uint64_t mantissa, int exponent) {
+  using traits = EiselLemireTraits<T>;
+  using bits_type = typename traits::bits_type;
+
+  if (mantissa == 0 || exponent < traits::smallestPowerOfTen)
+    return 0;
+  if (exponent > traits::largestPowerOfTen)
+    return FloatTraits<T>::inf();
+
+  int leadingZeros = countLeadingZeros(mantissa);
+  mantissa <<= leadingZeros;
+
+  // Multiply by the power of five, with enough precision for the bits we need
+  auto powers = PowersOfFive::table();
+  auto index = 2 * (exponent - PowersOfFive::first);
+  auto product = multiply128(mantissa, powers[index]);
+  const uint64_t precisionMask = ~uint64_t(0) >> (traits::mantissaBits + 3);
+  if ((product.high & precisionMask) == precisionMask) {
+    auto lowProduct = multiply128(mantissa, powers[index + 1]);
+    product.low += lowProduct.high;
+    if (lowProduct.high > product.low)
+      product.high++;
+  }
+
+  int upperBit = int(product.high >> 63);
+  int shift = upperBit + 64 - traits::mantissaBits - 3;
+  uint64_t m = product.high >> shift;
+  // 2^(log2(10) * exponent), in fixed-point
+  int power2 = int((int32_t(152170 + 65536) * exponent) >> 16) + 63 +
+               upperBit - leadingZeros - traits::minExponent;
+
+  if (power2 <= 0) {  // subnormal
+    if (-power2 + 1 >= 64)
+      return 0;
+    m >>= -power2 + 1;
+    m += m & 1;  // round up
+    m >>= 1;
+    // the rounding may turn a subnormal into a normal number
+    power2 = m < (uint64_t(1) << traits::mantissaBits) ? 0 : 1;
+    return FloatTraits<T>::forge(
+        bits_type(m | (uint64_t(power2) << traits::mantissaBits)));
+  }
+
+  // When exactly halfway, round to even instead of up
+  if (product.low <= 1 && exponent >= traits::minExponentRoundToEven &&
+      exponent <= traits::maxExponentRoundToEven && (m & 3) == 1 &&
+      (m << shift) == product.high)
+    m &= ~uint64_t(1);
+
+  m += m & 1;
+  m >>= 1;
+  if (m >= (uint64_t(2) << traits::mantissaBits)) {
+    m = uint64_t(1) << traits::mantissaBits;
+    power2++;
+  }
+  m &= ~(uint64_t(1) << traits::mantissaBits);
+
+  if (power2 >= traits::infinitePower)
+    return FloatTraits<T>::inf();
+
+  return FloatTraits<T>::forge(
+      bits_type(m | (uint64_t(power2) << traits::mantissaBits)));
+}
+
+#endif
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,179 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Numbers/FloatTraits.hpp>
+#include <ArduinoJson/Numbers/PowersOfFive.hpp>
+#include <ArduinoJson/Polyfills/alias_cast.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/uint128.hpp>
+
+#include <stdint.h>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+#if ARDUINOJSON_ENABLE_SHORTEST_FLOAT_FORMATTING
+
+// Returns floor(10^k * 2^r) + 1, where r is chosen so that the result has 128
+// significant bits
+inline uint128_parts powerOfTenCeiling(int k) {
+  auto powers = PowersOfFive::table();
+  auto index = 2 * (k - PowersOfFive::first);
+  uint128_parts g = {powers[index], powers[index + 1]};
+  // the table is truncated, except for 5^-27 to 5^-1 which are rounded up
+  if (k < -27 || k >= 0) {
+    g.low++;
+    if (g.low == 0)
+      g.high++;
+  }
+  return g;
+}
+
+template <typename T, size_t = sizeof(T)>
+struct SchubfachTraits {};
+
+template <typename T>
+struct SchubfachTraits<T, 8 /*64bits*/> {
+  using bits_type = uint64_t;
+  using power_type = uint128_parts;
+  static const int mantissaBits = 52;
+  static const int exponentBias = 1075;  // 1023 + 52
+
+  static power_type powerOfTen(int k) {
+    return powerOfTenCeiling(k);
+  }
+
+  // Returns the integral part of g * cp / 2^128, with the lowest bit set if
+  // the fractional part is not zero
+  static bits_type roundToOdd(power_type g, bits_type cp) {
+    auto low = multiply128(g.low, cp);
+    auto high = multiply128(g.high, cp);
+    high.low += low.high;
+    if (high.low < low.high)
+      high.high++;
+    return high.high | (high.low > 1);
+  }
+};
+
+template <typename T>
+struct SchubfachTraits<T, 4 /*32bits*/> {
+  using bits_type = uint32_t;
+  using power_type = uint64_t;
+  static const int mantissaBits = 23;
+  static const int exponentBias = 150;  // 127 + 23
+
+  static power_type powerOfTen(int k) {
+    auto powers = PowersOfFive::table();
+    auto index = 2 * (k - PowersOfFive::first);
+    uint64_t high = powers[index];
+    // undo the rounding of 5^-27 to 5^-1 to get floor(10^k * 2^r)
+    if (k >= -27 && k < 0 && powers[index + 1] == 0)
+      high--;
+    return high + 1;
+  }
+
+  // Returns the integral part of g * cp / 2^64, with the lowest bit set if the
+  // fractional part is not zero
+  static bits_type roundToOdd(power_type g, bits_type cp) {
+    uint64_t low = uint64_t(cp) * uint32_t(g);
+    uint64_t high = uint64_t(cp) * (g >> 32) + (low >> 32);
+    return bits_type(high >> 32) | (uint32_t(high) > 1);
+  }
+};
+
+template <typename TSignificand>
+struct DecimalFloat {
+  TSignificand significand;
+  int16_t exponent;
+};
+
+template <typename TSignificand>
+DecimalFloat<TSignificand> removeTrailingZeros(DecimalFloat<TSignificand> d) {
+  while (d.significand % 10 == 0) {
+    d.significand = TSignificand(d.significand / 10);
+    d.exponent++;
+  }
+  return d;
+}
+
+// Returns the shortest decimal that reads back as the same float or double:
+// the value is significand * 10^exponent.
+// The value must be positive and finite.
+// Raffaello Giulietti, "The Schubfach way to render doubles", 2020
+template <typename T>
+DecimalFloat<typename SchubfachTraits<T>::bits_type> floatToDecimal(T value) {
+  using traits = SchubfachTraits<T>;
+  using bits_type = typename traits::bits_type;
+
+  ARDUINOJSON_ASSERT(value > 0);
+
+  const bits_type hiddenBit = bits_type(1) << traits::mantissaBits;
+  bits_type bits = alias_cast<bits_type>(value);
+  bits_type fraction = bits & (hiddenBit - 1);
+  int biasedExponent = int(bits >> traits::mantissaBits);
+
+  // value = c * 2^q
+  bits_type c;
+  int32_t q;
+  if (biasedExponent != 0) {
+    c = fraction | hiddenBit;
+    q = biasedExponent - traits::exponentBias;
+    // small integers are exact
+    if (q <= 0 && -q <= traits::mantissaBits &&
+        (c & ((bits_type(1) << -q) - 1)) == 0) {
+      return removeTrailingZeros<bits_type>({bits_type(c >> -q), 0});
+    }
+  } else {
+    c = fraction;
+    q = 1 - traits::exponentBias;
+  }
+
+  // The interval of the decimals that read back as the value is
+  // [cbl, cbr] * 2^(q-2), bounds included when c is even
+  bool isEven = (c & 1) == 0;
+  bool lowerBoundaryIsCloser = fraction == 0 && biasedExponent > 1;
+  bits_type cbl = bits_type(4 * c - 2 + lowerBoundaryIsCloser);
+  bits_type cb = bits_type(4 * c);
+  bits_type cbr = bits_type(4 * c + 2);
+
+  // k = floor(log10(2^q)), or floor(log10(3/4 * 2^q)) if the lower boundary
+  // is closer
+  int32_t k =
+      int32_t((q * 1262611L - (lowerBoundaryIsCloser ? 524031L : 0L)) >> 22);
+  // h = q + floor(log2(10^-k)) + 1, between 1 and 4
+  int h = int(q + ((-k * 1741647L) >> 19) + 1);
+
+  auto g = traits::powerOfTen(-k);
+  bits_type vbl = traits::roundToOdd(g, bits_type(cbl << h));
+  bits_type vb = traits::roundToOdd(g, bits_type(cb << h));
+  bits_type vbr = traits::roundToOdd(g, bits_type(cbr << h));
+  bits_type lower = bits_type(vbl + !isEven);
+  bits_type upper = bits_type(vbr - !isEven);
+
+  // Try with one digit less
+  bits_type s = vb / 4;
+  if (s >= 10) {
+    bits_type sp = s / 10;
+    bool upInside = lower <= 40 * sp;
+    bool wpInside = 40 * sp + 40 <= upper;
+    if (upInside != wpInside)
+      return removeTrailingZeros<bits_type>(
+          {bits_type(sp + wpInside), int16_t(k + 1)});
+  }
+
+  bool uInside = lower <= 4 * s;
+  bool wInside = 4 * s + 4 <= upper;
+  if (uInside != wInside)
+    return removeTrailingZeros<bits_type>({bits_type(s + wInside), int16_t(k)});
+
+  // Pick the closest of s and s + 1
+  bits_type mid = 4 * s + 2;
+  bool roundUp = vb > mid || (vb == mid && (s & 1) != 0);
+  return removeTrailingZeros<bits_type>({bits_type(s + roundUp), int16_t(k)});
+}
+
+#endif
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
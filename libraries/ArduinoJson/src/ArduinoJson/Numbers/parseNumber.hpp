@@ -7,6 +7,7 @@
 #include <ArduinoJson/Numbers/FloatTraits.hpp>
 #include <ArduinoJson/Numbers/JsonFloat.hpp>
 #include <ArduinoJson/Numbers/convertNumber.hpp>
+#include <ArduinoJson/Numbers/decimalToFloat.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/ctype.hpp>
 #include <ArduinoJson/Polyfills/math.hpp>
@@ -102,10 +103,83 @@ class Number {
 #endif
 };
 
+#if ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING
+// Parses the digits, the dot and the exponent of a decimal number.
+// Only the first 19 significant digits are used (they always fit in a
+// uint64_t), so longer numbers can be one ulp below the nearest value.
+inline Number parseDecimal(const char* s, bool is_negative) {
+  const int maxDigits = 19;
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int exponent = 0;
+
+  while (isdigit(*s)) {
+    if (digits < maxDigits) {
+      mantissa = mantissa * 10 + uint8_t(*s - '0');
+      if (mantissa)  // not a leading zero
+        digits++;
+    } else {
+      exponent++;
+    }
+    s++;
+  }
+
+  if (*s == '.') {
+    s++;
+    while (isdigit(*s)) {
+      if (digits < maxDigits) {
+        mantissa = mantissa * 10 + uint8_t(*s - '0');
+        exponent--;
+        if (mantissa)
+          digits++;
+      }
+      s++;
+    }
+  }
+
+  if (*s == 'e' || *s == 'E') {
+    s++;
+    bool negative_exponent = false;
+    if (*s == '-') {
+      negative_exponent = true;
+      s++;
+    } else if (*s == '+') {
+      s++;
+    }
+
+    int explicit_exponent = 0;
+    while (isdigit(*s)) {
+      // past this value, the result is always zero or infinity
+      if (explicit_exponent < 10000)
+        explicit_exponent = explicit_exponent * 10 + (*s - '0');
+      s++;
+    }
+    exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+  }
+
+  // we should be at the end of the string, otherwise it's an error
+  if (*s != '\0')
+    return Number();
+
+#  if ARDUINOJSON_USE_DOUBLE
+  bool isDouble = exponent < -FloatTraits<float>::exponent_max ||
+                  exponent > FloatTraits<float>::exponent_max ||
+                  mantissa > FloatTraits<float>::mantissa_max;
+  if (isDouble) {
+    auto result = decimalToFloat<double>(mantissa, exponent);
+    return Number(is_negative ? -result : result);
+  } else
+#  endif
+  {
+    auto result = decimalToFloat<float>(mantissa, exponent);
+    return Number(is_negative ? -result : result);
+  }
+}
+#endif
+
 inline Number parseNumber(const char* s) {
   using traits = FloatTraits<JsonFloat>;
   using mantissa_t = largest_type<traits::mantissa_type, JsonUInt>;
-  using exponent_t = traits::exponent_type;
 
   ARDUINOJSON_ASSERT(s != 0);
 
@@ -135,8 +209,11 @@ inline Number parseNumber(const char* s) {
   if (!isdigit(*s) && *s != '.')
     return Number();
 
+#if ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING
+  const char* digits = s;
+#endif
+
   mantissa_t mantissa = 0;
-  exponent_t exponent_offset = 0;
   const mantissa_t maxUint = JsonUInt(-1);
 
   while (isdigit(*s)) {
@@ -162,6 +239,12 @@ inline Number parseNumber(const char* s) {
     }
   }
 
+#if ARDUINOJSON_ENABLE_FAST_FLOAT_PARSING
+  return parseDecimal(digits, is_negative);
+#else
+  using exponent_t = traits::exponent_type;
+  exponent_t exponent_offset = 0;
+
   // avoid mantissa overflow
   while (mantissa > traits::mantissa_max) {
     mantissa /= 10;
@@ -228,6 +311,7 @@ inline Number parseNumber(const char* s) {
     auto final_result = make_float(float(mantissa), exponent);
     return Number(is_negative ? -final_result : final_result);
   }
+#endif
 }
 
 template <typename T>
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Collection/CollectionData.hpp>
+#include <ArduinoJson/Memory/MemberIndex.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
@@ -41,9 +42,7 @@ class ObjectData : public CollectionData {
     obj->removeMember(key, resources);
   }
 
-  void remove(iterator it, ResourceManager* resources) {
-    CollectionData::removePair(it, resources);
-  }
+  void remove(iterator it, ResourceManager* resources);
 
   static void remove(ObjectData* obj, ObjectData::iterator it,
                      ResourceManager* resources) {
@@ -65,6 +64,13 @@ class ObjectData : public CollectionData {
  private:
   template <typename TAdaptedString>
   iterator findKey(TAdaptedString key, const ResourceManager* resources) const;
+
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  MemberIndex* getIndex(const ResourceManager* resources) const;
+  MemberIndex* buildIndex(size_t count, const ResourceManager* resources) const;
+  MemberIndex* updateIndex(MemberIndex* index,
+                           const ResourceManager* resources) const;
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
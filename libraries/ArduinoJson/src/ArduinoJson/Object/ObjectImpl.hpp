@@ -34,21 +34,116 @@ inline ObjectData::iterator ObjectData::findKey(
     TAdaptedString key, const ResourceManager* resources) const {
   if (key.isNull())
     return iterator();
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  auto index = getIndex(resources);
+  if (index) {
+    auto keyId = index->find(stringHash(key), [&](SlotId id) {
+      return stringEquals(
+          key, adaptString(resources->getVariant(id)->asString()));
+    });
+    return iterator(resources->getVariant(keyId), keyId);
+  }
+  size_t slotCount = 0;
+#endif
   bool isKey = true;
   for (auto it = createIterator(resources); !it.done(); it.next(resources)) {
-    if (isKey && stringEquals(key, adaptString(it->asString())))
+    if (isKey && stringEquals(key, adaptString(it->asString()))) {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+      if (slotCount > 2 * ARDUINOJSON_OBJECT_INDEX_THRESHOLD)
+        buildIndex(slotCount / 2, resources);
+#endif
       return it;
+    }
     isKey = !isKey;
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    slotCount++;
+#endif
   }
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  // the next lookups will use the index
+  if (slotCount > 2 * ARDUINOJSON_OBJECT_INDEX_THRESHOLD)
+    buildIndex(slotCount / 2, resources);
+#endif
   return iterator();
 }
 
+inline void ObjectData::remove(iterator it, ResourceManager* resources) {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  auto index = it.done() ? nullptr : getIndex(resources);
+  if (index && !it->asString().isNull()) {
+    index->remove(it.currentId_, [resources](SlotId id) {
+      return stringHash(adaptString(resources->getVariant(id)->asString()));
+    });
+  }
+#endif
+  CollectionData::removePair(it, resources);
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  if (index) {
+    if (index->count < ARDUINOJSON_OBJECT_INDEX_THRESHOLD)
+      resources->removeMemberIndex(this);
+    else
+      index->tail = tail();
+  }
+#endif
+}
+
 template <typename TAdaptedString>
 inline void ObjectData::removeMember(TAdaptedString key,
                                      ResourceManager* resources) {
   remove(findKey(key, resources), resources);
 }
 
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+// Returns the index of this object, if any, after adding the members that were
+// appended since the last call
+inline MemberIndex* ObjectData::getIndex(
+    const ResourceManager* resources) const {
+  if (!resources->hasMemberIndexes())
+    return nullptr;
+  auto index = resources->getMemberIndex(this);
+  if (index && index->tail != tail())
+    index = updateIndex(index, resources);
+  return index;
+}
+
+inline MemberIndex* ObjectData::buildIndex(
+    size_t count, const ResourceManager* resources) const {
+  size_t capacity = 8;
+  while (capacity < count * 4)
+    capacity *= 2;
+  auto index = resources->createMemberIndex(this, capacity);
+  if (!index)
+    return nullptr;
+  return updateIndex(index, resources);
+}
+
+inline MemberIndex* ObjectData::updateIndex(
+    MemberIndex* index, const ResourceManager* resources) const {
+  auto id = index->tail == NULL_SLOT
+                ? head()
+                : resources->getVariant(index->tail)->next();
+  while (id != NULL_SLOT) {
+    if (index->full()) {
+      // start over with a larger table
+      index = resources->createMemberIndex(this, index->capacity * 2);
+      if (!index)
+        return nullptr;
+      id = head();
+      continue;
+    }
+    auto key = resources->getVariant(id);
+    auto valueId = key->next();
+    // the key is null if it couldn't be saved
+    auto keyString = key->asString();
+    if (!keyString.isNull())
+      index->insert(id, stringHash(adaptString(keyString)));
+    index->tail = valueId;
+    id = resources->getVariant(valueId)->next();
+  }
+  return index;
+}
+#endif
+
 template <typename TAdaptedString>
 inline VariantData* ObjectData::addMember(TAdaptedString key,
                                           ResourceManager* resources) {
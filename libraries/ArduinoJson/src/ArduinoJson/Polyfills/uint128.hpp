@@ -0,0 +1,36 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stdint.h>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+struct uint128_parts {
+  uint64_t high;
+  uint64_t low;
+};
+
+inline uint128_parts multiply128(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+  __extension__ using uint128_t = unsigned __int128;
+  uint128_t product = uint128_t(a) * b;
+  return {uint64_t(product >> 64), uint64_t(product)};
+#else
+  uint64_t aLow = uint32_t(a), aHigh = a >> 32;
+  uint64_t bLow = uint32_t(b), bHigh = b >> 32;
+  uint64_t lowLow = aLow * bLow;
+  uint64_t lowHigh = aLow * bHigh;
+  uint64_t highLow = aHigh * bLow;
+  uint64_t highHigh = aHigh * bHigh;
+  uint64_t middle = (lowLow >> 32) + uint32_t(lowHigh) + uint32_t(highLow);
+  return {highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32),
+          (middle << 32) | uint32_t(lowLow)};
+#endif
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -41,6 +41,7 @@ enum class VariantType : uint8_t {
 #endif
   Object = 0x20,
   Array = 0x40,
+  BorrowedString = 0x84,  // 1000 0100
 };
 
 inline bool operator&(VariantType type, VariantTypeBits bit) {
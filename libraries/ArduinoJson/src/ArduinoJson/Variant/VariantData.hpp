@@ -79,6 +79,9 @@ class VariantData {
       case VariantType::LinkedString:
         return visit.visit(JsonString(content_.asLinkedString, true));
 
+      case VariantType::BorrowedString:
+        return visit.visit(JsonString(content_.asLinkedString));
+
       case VariantType::OwnedString:
         return visit.visit(JsonString(content_.asOwnedString->data,
                                       content_.asOwnedString->length));
@@ -216,6 +219,7 @@ class VariantData {
         str = content_.asTinyString;
         break;
       case VariantType::LinkedString:
+      case VariantType::BorrowedString:
         str = content_.asLinkedString;
         break;
       case VariantType::OwnedString:
@@ -261,6 +265,7 @@ class VariantData {
         str = content_.asTinyString;
         break;
       case VariantType::LinkedString:
+      case VariantType::BorrowedString:
         str = content_.asLinkedString;
         break;
       case VariantType::OwnedString:
@@ -304,6 +309,8 @@ class VariantData {
         return JsonString(content_.asTinyString);
       case VariantType::LinkedString:
         return JsonString(content_.asLinkedString, true);
+      case VariantType::BorrowedString:
+        return JsonString(content_.asLinkedString);
       case VariantType::OwnedString:
         return JsonString(content_.asOwnedString->data,
                           content_.asOwnedString->length);
@@ -417,7 +424,8 @@ class VariantData {
   bool isString() const {
     return type_ == VariantType::LinkedString ||
            type_ == VariantType::OwnedString ||
-           type_ == VariantType::TinyString;
+           type_ == VariantType::TinyString ||
+           type_ == VariantType::BorrowedString;
   }
 
   size_t nesting(const ResourceManager* resources) const {
@@ -526,6 +534,15 @@ class VariantData {
     content_.asLinkedString = s;
   }
 
+  // The string belongs to the input buffer of an InSituJsonDocument.
+  // Unlike a linked string, it gets copied when the variant is copied.
+  void setBorrowedString(const char* s) {
+    ARDUINOJSON_ASSERT(type_ == VariantType::Null);  // must call clear() first
+    ARDUINOJSON_ASSERT(s);
+    type_ = VariantType::BorrowedString;
+    content_.asLinkedString = s;
+  }
+
   template <typename TAdaptedString>
   void setTinyString(const TAdaptedString& s) {
     ARDUINOJSON_ASSERT(type_ == VariantType::Null);  // must call clear() first
@@ -0,0 +1,79 @@
+// alloc_counter.cpp
+
+#include "alloc_counter.h"
+
+#include <atomic>
+
+#if defined(__GLIBC__) && !defined(HOST_NO_ALLOC_COUNTER)
+
+#include <errno.h>
+#include <malloc.h>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void  __libc_free(void* ptr);
+}
+
+static std::atomic<uint64_t> s_allocations{0};
+static std::atomic<uint64_t> s_frees{0};
+static std::atomic<size_t>   s_currentBytes{0};
+static std::atomic<size_t>   s_peakBytes{0};
+
+static void* added(void* ptr) {
+    if(!ptr) return ptr;
+    s_allocations++;
+    size_t current = s_currentBytes += malloc_usable_size(ptr);
+    size_t peak = s_peakBytes.load();
+    while(current > peak && !s_peakBytes.compare_exchange_weak(peak, current)) {}
+    return ptr;
+}
+
+extern "C" {
+void* malloc(size_t size) { return added(__libc_malloc(size)); }
+void* calloc(size_t n, size_t size) { return added(__libc_calloc(n, size)); }
+void* memalign(size_t alignment, size_t size) { return added(__libc_memalign(alignment, size)); }
+void* aligned_alloc(size_t alignment, size_t size) { return added(__libc_memalign(alignment, size)); }
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) {
+    void* p = added(__libc_memalign(alignment, size));
+    if(!p) return ENOMEM;
+    *ptr = p;
+    return 0;
+}
+
+void* realloc(void* ptr, size_t size) {
+    size_t oldSize = ptr ? malloc_usable_size(ptr) : 0;
+    void* p = __libc_realloc(ptr, size);
+    if(!p && size) return p; // failed, the old block is unchanged
+    s_currentBytes -= oldSize;
+    if(!p && ptr) s_frees++; // realloc(ptr, 0) freed the block
+    return added(p);
+}
+
+void free(void* ptr) {
+    if(ptr) {
+        s_frees++;
+        s_currentBytes -= malloc_usable_size(ptr);
+    }
+    __libc_free(ptr);
+}
+}
+
+bool allocCounterAvailable() { return true; }
+
+AllocStats allocCounterGet() {
+    return AllocStats{s_allocations.load(), s_frees.load(), s_currentBytes.load(), s_peakBytes.load()};
+}
+
+void allocCounterResetPeak() { s_peakBytes = s_currentBytes.load(); }
+
+#else
+
+bool allocCounterAvailable() { return false; }
+AllocStats allocCounterGet() { return AllocStats{0, 0, 0, 0}; }
+void allocCounterResetPeak() {}
+
+#endif
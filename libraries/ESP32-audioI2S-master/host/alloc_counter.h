@@ -0,0 +1,20 @@
+// alloc_counter.h
+// Counts the heap operations of the whole process by replacing malloc() and friends (glibc only).
+// On the ESP32 the decoders get their memory from ps_malloc() and heap_caps_malloc(), which the
+// shim maps to malloc(), so this sees every allocation the decoders make.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct AllocStats {
+    uint64_t allocations;   // malloc, calloc, realloc (a realloc counts as one allocation)
+    uint64_t frees;
+    size_t   currentBytes;
+    size_t   peakBytes;
+};
+
+bool       allocCounterAvailable(); // false if the build could not replace malloc (e.g. with sanitizers)
+AllocStats allocCounterGet();
+void       allocCounterResetPeak(); // peak := current
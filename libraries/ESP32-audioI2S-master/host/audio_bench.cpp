@@ -0,0 +1,162 @@
+// audio_bench.cpp
+// Decode benchmark: speed (x realtime), peak heap and heap operations of each decoder.
+//
+// usage: audio_bench [--repeat <n>] [--max-steady <n>] [--parallel] [<file or directory>...]
+//
+// Without arguments, decodes the files in additional_info/Testfiles. The speed is the best of <n> runs (default 3)
+// and counts the time spent inside the decoder only. The peak heap is the largest amount of memory allocated while
+// decoding, including the input block and the output buffer that Audio owns (InBuff, m_outBuff).
+// "steady" is the number of heap operations after the first decoded frame, it should be 0.
+//
+// --max-steady fails (exit code 1) if a file needs more heap operations after its first frame, exit code 77 if the
+// heap can't be counted in this build.
+//
+// --parallel decodes all files at the same time, one thread and one decoder instance per file, and fails if the
+// output of a file differs from its sequential decode.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "alloc_counter.h"
+#include "host_decoder.h"
+#include "md5.h"
+
+#ifndef AUDIO_TESTFILES_DIR
+#define AUDIO_TESTFILES_DIR "additional_info/Testfiles"
+#endif
+
+struct BenchResult {
+    HostDecodeResult decode;
+    size_t   peakBytes = 0;
+    uint64_t allocations = 0;
+    uint64_t steadyHeapOps = 0;
+};
+
+static BenchResult bench(HostDecoder& decoder, int repeat) {
+    BenchResult b;
+    for(int i = 0; i < repeat; i++) {
+        allocCounterResetPeak();
+        AllocStats before = allocCounterGet();
+        AllocStats firstFrame = before;
+        HostDecodeResult r = decoder.decode(nullptr, [&]() { firstFrame = allocCounterGet(); });
+        AllocStats after = allocCounterGet();
+        if(!r.ok) {b.decode = r; return b;}
+        if(i == 0 || r.decodeSeconds < b.decode.decodeSeconds) b.decode = r;
+        if(i == 0) { // the first run, as on the board
+            b.peakBytes = after.peakBytes - before.currentBytes;
+            b.allocations = after.allocations - before.allocations;
+            // the decoder is freed at the end of decode(), these frees are not steady state
+            b.steadyHeapOps = (after.allocations - firstFrame.allocations);
+        }
+    }
+    return b;
+}
+
+static void collect(const std::filesystem::path& path, std::vector<std::string>& files) {
+    std::error_code ec;
+    if(std::filesystem::is_directory(path, ec)) {
+        for(const auto& entry : std::filesystem::directory_iterator(path, ec)) {
+            if(entry.is_regular_file()) files.push_back(entry.path().string());
+        }
+    }
+    else files.push_back(path.string());
+}
+
+struct ParallelResult {
+    HostDecodeResult decode;
+    uint8_t digest[16] = {0}; // MD5 of the PCM output
+};
+
+static void decodeToDigest(HostDecoder& decoder, ParallelResult& p) {
+    MD5 md5;
+    p.decode = decoder.decode([&](const int16_t* pcm, size_t frames, uint8_t channels) { md5.update(pcm, frames * channels * sizeof(int16_t)); });
+    md5.final(p.digest);
+}
+
+static int parallel(const std::vector<std::string>& files) {
+    std::vector<std::unique_ptr<HostDecoder>> decoders;
+    std::vector<std::string> names;
+    for(const std::string& file : files) {
+        auto decoder = std::make_unique<HostDecoder>();
+        if(!decoder->load(file.c_str())) continue;
+        decoders.push_back(std::move(decoder));
+        names.push_back(std::filesystem::path(file).filename().string());
+    }
+    size_t n = decoders.size();
+    std::vector<ParallelResult> sequential(n), concurrent(n);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < n; i++) decodeToDigest(*decoders[i], sequential[i]);
+    auto t1 = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < n; i++) threads.emplace_back(decodeToDigest, std::ref(*decoders[i]), std::ref(concurrent[i]));
+    for(std::thread& t : threads) t.join();
+    auto t2 = std::chrono::steady_clock::now();
+
+    printf("%-28s %-6s %8s %s\n", "file", "codec", "seconds", "parallel output");
+    int failed = 0;
+    for(size_t i = 0; i < n; i++) {
+        const char* state = "same";
+        if(!sequential[i].decode.ok || !concurrent[i].decode.ok) state = "failed";
+        else if(sequential[i].decode.frames != concurrent[i].decode.frames || memcmp(sequential[i].digest, concurrent[i].digest, 16)) state = "differs";
+        printf("%-28s %-6s %8.2f %s\n", names[i].c_str(), hostCodecName(decoders[i]->codec()), sequential[i].decode.durationSeconds(), state);
+        if(strcmp(state, "same")) failed++;
+    }
+    printf("wall time: sequential %.3f s, parallel %.3f s (%u hardware threads)\n", std::chrono::duration<double>(t1 - t0).count(),
+           std::chrono::duration<double>(t2 - t1).count(), std::thread::hardware_concurrency());
+    return failed ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    int repeat = 3;
+    long maxSteady = -1;
+    bool f_parallel = false;
+    std::vector<std::string> files;
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "--repeat") && i + 1 < argc) repeat = std::max(1, atoi(argv[++i]));
+        else if(!strcmp(argv[i], "--max-steady") && i + 1 < argc) maxSteady = std::max(0L, atol(argv[++i]));
+        else if(!strcmp(argv[i], "--parallel")) f_parallel = true;
+        else if(argv[i][0] == '-') {fprintf(stderr, "usage: audio_bench [--repeat <n>] [--max-steady <n>] [--parallel] [<file or directory>...]\n"); return 2;}
+        else collect(argv[i], files);
+    }
+    if(files.empty()) collect(AUDIO_TESTFILES_DIR, files);
+    std::sort(files.begin(), files.end());
+    if(f_parallel) return parallel(files);
+
+    if(!allocCounterAvailable()) {
+        fprintf(stderr, "heap counters not available in this build\n");
+        if(maxSteady >= 0) return 77;
+    }
+
+    printf("%-28s %-6s %6s %2s %8s %10s %10s %7s %7s\n", "file", "codec", "rate", "ch", "seconds", "x realtime", "peak heap", "allocs", "steady");
+    int failed = 0;
+    for(const std::string& file : files) {
+        HostDecoder decoder;
+        if(!decoder.load(file.c_str())) continue; // not an encoded audio file (wav, m3u...)
+        BenchResult b = bench(decoder, repeat);
+        std::string name = std::filesystem::path(file).filename().string();
+        if(!b.decode.ok) {
+            printf("%-28s %-6s failed: %s\n", name.c_str(), hostCodecName(decoder.codec()), b.decode.error.c_str());
+            failed++;
+            continue;
+        }
+        printf("%-28s %-6s %6u %2u %8.2f %10.1f %10zu %7llu %7llu\n", name.c_str(), hostCodecName(b.decode.codec),
+               (unsigned)b.decode.sampleRate, (unsigned)b.decode.channels, b.decode.durationSeconds(), b.decode.realtimeFactor(),
+               b.peakBytes, (unsigned long long)b.allocations, (unsigned long long)b.steadyHeapOps);
+        if(maxSteady >= 0 && b.steadyHeapOps > (uint64_t)maxSteady) {
+            fprintf(stderr, "%s: %llu heap operations after the first frame, at most %ld allowed\n", name.c_str(),
+                    (unsigned long long)b.steadyHeapOps, maxSteady);
+            failed++;
+        }
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,133 @@
+// audio_decode.cpp
+// Decodes an audio file to raw PCM (signed 16 bit, little endian, interleaved) with the decoders of src/.
+//
+// usage: audio_decode <input> [<output.pcm>] [--reference <ref.pcm>] [--tolerance <n>] [--check-md5] [-q]
+//
+//   --reference  compares the output with a reference decode of the same file, e.g. made with
+//                ffmpeg -i <input> -f s16le -acodec pcm_s16le <ref.pcm>
+//   --tolerance  the largest difference allowed per sample, default 0 (bit exact)
+//   --check-md5  native FLAC only: compares the output with the MD5 signature in STREAMINFO
+//
+// exit code: 0 ok, 1 decode error or mismatch, 2 usage, 77 check not possible (ctest SKIP_RETURN_CODE)
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "host_decoder.h"
+#include "md5.h"
+
+struct Comparison {
+    std::vector<int16_t> reference;
+    uint64_t compared = 0;
+    int32_t  maxDiff = 0;
+    double   signalPower = 0;
+    double   errorPower = 0;
+
+    void add(const int16_t* pcm, size_t n) {
+        for(size_t i = 0; i < n; i++, compared++) {
+            if(compared >= reference.size()) continue; // counted as a length mismatch
+            int32_t diff = abs((int32_t)pcm[i] - reference[compared]);
+            if(diff > maxDiff) maxDiff = diff;
+            signalPower += (double)reference[compared] * reference[compared];
+            errorPower += (double)diff * diff;
+        }
+    }
+};
+
+static bool readFile(const char* path, std::vector<int16_t>& samples) {
+    FILE* f = fopen(path, "rb");
+    if(!f) return false;
+    int16_t buf[4096];
+    size_t n;
+    while((n = fread(buf, sizeof(int16_t), 4096, f)) > 0) samples.insert(samples.end(), buf, buf + n);
+    fclose(f);
+    return true;
+}
+
+static int usage() {
+    fprintf(stderr, "usage: audio_decode <input> [<output.pcm>] [--reference <ref.pcm>] [--tolerance <n>] [--check-md5] [-q]\n");
+    return 2;
+}
+
+int main(int argc, char* argv[]) {
+    const char* input = nullptr;
+    const char* output = nullptr;
+    const char* reference = nullptr;
+    int32_t     tolerance = 0;
+    bool        checkMD5 = false;
+    bool        quiet = false;
+
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "--reference") && i + 1 < argc) reference = argv[++i];
+        else if(!strcmp(argv[i], "--tolerance") && i + 1 < argc) tolerance = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--check-md5")) checkMD5 = true;
+        else if(!strcmp(argv[i], "-q")) quiet = true;
+        else if(argv[i][0] == '-') return usage();
+        else if(!input) input = argv[i];
+        else if(!output) output = argv[i];
+        else return usage();
+    }
+    if(!input) return usage();
+
+    HostDecoder decoder;
+    if(!decoder.load(input)) {
+        fprintf(stderr, "%s: can't read the file or unsupported format\n", input);
+        return 1;
+    }
+
+    FILE* out = nullptr;
+    if(output) {
+        out = fopen(output, "wb");
+        if(!out) {fprintf(stderr, "%s: can't create the file\n", output); return 1;}
+    }
+
+    Comparison cmp;
+    if(reference && !readFile(reference, cmp.reference)) {
+        fprintf(stderr, "%s: can't read the file\n", reference);
+        return 1;
+    }
+
+    MD5 md5;
+    HostDecodeResult r = decoder.decode([&](const int16_t* pcm, size_t frames, uint8_t channels) {
+        size_t n = frames * channels;
+        if(out) fwrite(pcm, sizeof(int16_t), n, out);
+        if(reference) cmp.add(pcm, n);
+        if(checkMD5) md5.update(pcm, n * sizeof(int16_t)); // little endian host, the FLAC signature byte order
+    });
+    if(out) fclose(out);
+
+    if(!quiet || !r.ok) {
+        fprintf(stderr, "%s: %s %u Hz %u ch, %.2f s, %.1fx realtime, %u decode errors%s%s\n", input,
+                hostCodecName(r.codec), (unsigned)r.sampleRate, (unsigned)r.channels, r.durationSeconds(),
+                r.realtimeFactor(), (unsigned)r.decodeErrors, r.ok ? "" : ", failed: ", r.error.c_str());
+    }
+    if(!r.ok) return 1;
+
+    int ret = 0;
+    if(reference) {
+        double snr = cmp.errorPower > 0 ? 10 * log10(cmp.signalPower / cmp.errorPower) : INFINITY;
+        bool sameLength = cmp.compared == cmp.reference.size();
+        bool pass = sameLength && cmp.maxDiff <= tolerance;
+        fprintf(stderr, "%s: %s, %llu of %llu samples, max diff %d (tolerance %d), SNR %.1f dB\n", reference,
+                pass ? "match" : "MISMATCH", (unsigned long long)cmp.compared, (unsigned long long)cmp.reference.size(),
+                (int)cmp.maxDiff, (int)tolerance, snr);
+        if(!pass) ret = 1;
+    }
+    if(checkMD5) {
+        if(!decoder.flacMD5() || decoder.flacBitsPerSample() != 16) {
+            fprintf(stderr, "%s: no MD5 signature to check (native 16 bit FLAC only)\n", input);
+            return ret ? ret : 77;
+        }
+        uint8_t digest[16];
+        md5.final(digest);
+        bool pass = !memcmp(digest, decoder.flacMD5(), 16);
+        fprintf(stderr, "%s: MD5 %s\n", input, pass ? "match" : "MISMATCH");
+        if(!pass) ret = 1;
+    }
+    return ret;
+}
@@ -0,0 +1,238 @@
+// dsp_bench.cpp
+// Benchmark of the post decoder chain of Audio::playChunk() (src/audio_dsp), in cycles per sample (one left and
+// one right value) for each configuration.
+//
+// usage: dsp_bench [--repeat <n>] [--check]
+//
+// The input is 10 s of a 44.1kHz stereo test signal, processed in chunks of 1152 samples (an MP3
+// frame) as in playChunk().
+// "per sample" is the chain as it was before the block processing: one call per sample for the VU meter, each
+// biquad and the gain, with the filters running even at 0 dB. It is the reference for --check.
+//
+// --check fails (exit code 1) if the float chain differs from the reference by more than 1 plus one per bypassed
+// filter (the reference truncates the output of its unity filters), if the fixed point chain has an SNR below 50 dB
+// against the float chain or if the VU level is off by more than 8.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <type_traits>
+#include <vector>
+
+#include "../src/audio_dsp/audio_dsp.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static uint64_t cycles() { return __rdtsc(); }
+static const char* s_unit = "cycles";
+#else
+static uint64_t cycles() { // no cycle counter, nanoseconds
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+static const char* s_unit = "ns";
+#endif
+
+static const uint32_t s_sampleRate = 44100;
+static const uint32_t s_chunk = 1152;
+
+// the chain of playChunk() before the block processing, one sample at a time
+struct PerSampleChain {
+    AudioDSP::biquad_t filter[3];
+    float   filterBuff[3][2][2][2] = {}; // [filter][z1, z2][in, out][channel]
+    float   corr = 1.0;
+    double  limitLeft = 1, limitRight = 1;
+    bool    forceMono = false;
+    uint8_t sampleArray[2][4][8] = {};
+    uint8_t cnt0 = 0, cnt1 = 0, cnt2 = 0, cnt3 = 0, cnt4 = 0;
+    bool    f_vu = false;
+    uint8_t vuLeft = 0, vuRight = 0;
+
+    void computeVUlevel(int16_t sample[2]) {
+        auto avg = [&](uint8_t* a) { uint16_t av = 0; for(int i = 0; i < 8; i++) av += a[i]; return av >> 3; };
+        auto largest = [&](uint8_t* a) { uint16_t m = 0; for(int i = 0; i < 8; i++) if(m < a[i]) m = a[i]; return m; };
+        if(cnt0 == 64) {cnt0 = 0; cnt1++;}
+        if(cnt1 == 8) {cnt1 = 0; cnt2++;}
+        if(cnt2 == 8) {cnt2 = 0; cnt3++;}
+        if(cnt3 == 8) {cnt3 = 0; cnt4++; f_vu = true;}
+        if(cnt4 == 8) cnt4 = 0;
+        for(int ch = 0; ch < 2; ch++) {
+            if(!cnt0) sampleArray[ch][0][cnt1] = abs(sample[ch] >> 7);
+            if(!cnt1) sampleArray[ch][1][cnt2] = largest(sampleArray[ch][0]);
+            if(!cnt2) sampleArray[ch][2][cnt3] = largest(sampleArray[ch][1]);
+            if(!cnt3) sampleArray[ch][3][cnt4] = avg(sampleArray[ch][2]);
+        }
+        if(f_vu) {f_vu = false; vuLeft = avg(sampleArray[0][3]); vuRight = avg(sampleArray[1][3]);}
+        cnt1++;
+    }
+
+    void biquad(int f, int16_t s[2]) {
+        for(int ch = 0; ch < 2; ch++) {
+            float in = s[ch];
+            float out = filter[f].a0 * in + filter[f].a1 * filterBuff[f][0][0][ch] + filter[f].a2 * filterBuff[f][1][0][ch] -
+                        filter[f].b1 * filterBuff[f][0][1][ch] - filter[f].b2 * filterBuff[f][1][1][ch];
+            filterBuff[f][1][0][ch] = filterBuff[f][0][0][ch];
+            filterBuff[f][0][0][ch] = in;
+            filterBuff[f][1][1][ch] = filterBuff[f][0][1][ch];
+            filterBuff[f][0][1][ch] = out;
+            s[ch] = (int16_t)out;
+        }
+    }
+
+    void process(int16_t* samples, uint32_t frames) {
+        for(uint32_t i = 0; i < frames; i++) {
+            int16_t* s = samples + 2 * i;
+            computeVUlevel(s);
+            if(corr > 1) {s[0] /= corr; s[1] /= corr;}
+            biquad(0, s);
+            biquad(1, s);
+            biquad(2, s);
+            if(forceMono) {int32_t xy = (s[1] + s[0]) / 2; s[0] = s[1] = (int16_t)xy;}
+            s[0] *= limitLeft;
+            s[1] *= limitRight;
+        }
+    }
+};
+
+struct Config {
+    const char* name;
+    int8_t      g0, g1, g2;     // tone, dB
+    float       gainLeft, gainRight;
+    bool        mono;
+    bool        fixedPoint;
+};
+
+static const Config s_configs[] = {
+    {"bypass (0 dB, full volume)",   0,  0,  0, 1.0f, 1.0f, false, false},
+    {"volume",                       0,  0,  0, 0.5f, 0.5f, false, false},
+    {"volume + mono",                0,  0,  0, 0.5f, 0.5f, true,  false},
+    {"one filter (low shelf +6 dB)", 6,  0,  0, 0.5f, 0.5f, false, false},
+    {"tone float",                   6, -3,  4, 0.5f, 0.4f, false, false},
+    {"tone fixed point",             6, -3,  4, 0.5f, 0.4f, false, true},
+    {"tone float + mono",            6, -3,  4, 0.5f, 0.4f, true,  false},
+    {"tone fixed point + mono",      6, -3,  4, 0.5f, 0.4f, true,  true},
+    {"cut float",                  -20, -10, -30, 1.0f, 1.0f, false, false},
+    {"cut fixed point",            -20, -10, -30, 1.0f, 1.0f, false, true},
+};
+
+static std::vector<int16_t> testSignal() {
+    uint32_t frames = s_sampleRate * 10;
+    std::vector<int16_t> pcm(frames * 2);
+    uint32_t noise = 1;
+    for(uint32_t i = 0; i < frames; i++) {
+        double t = (double)i / s_sampleRate;
+        double env = 0.55 + 0.45 * sin(2 * M_PI * 0.25 * t);
+        double s = 0.35 * sin(2 * M_PI * 80 * t) + 0.25 * sin(2 * M_PI * 440 * t) + 0.15 * sin(2 * M_PI * 3000 * t) +
+                   0.1 * sin(2 * M_PI * 9000 * t);
+        noise = noise * 1664525 + 1013904223;
+        double n = ((int32_t)noise >> 16) / 32768.0 * 0.05;
+        pcm[2 * i]     = (int16_t)lrint(32767 * env * (s + n) * 0.9);
+        pcm[2 * i + 1] = (int16_t)lrint(32767 * env * (0.8 * s - n) * 0.9);
+    }
+    return pcm;
+}
+
+static void setup(AudioDSP& dsp, const Config& c) {
+    AudioDSP::biquad_t f[AudioDSP::NUM_FILTERS];
+    AudioDSP::calculateTone(c.g0, c.g1, c.g2, s_sampleRate, f);
+    int db = std::max(c.g0, std::max(c.g1, c.g2)); // as Audio::setTone()
+    dsp.setLevelCorrection(powf(10, (float)db / 20));
+    dsp.setFilters(f);
+    dsp.setFixedPoint(c.fixedPoint);
+    dsp.setGain(c.gainLeft, c.gainRight);
+    dsp.setForceMono(c.mono);
+}
+
+static void setup(PerSampleChain& ref, const Config& c) {
+    AudioDSP::calculateTone(c.g0, c.g1, c.g2, s_sampleRate, ref.filter);
+    int db = std::max(c.g0, std::max(c.g1, c.g2));
+    ref.corr = powf(10, (float)db / 20);
+    ref.limitLeft = c.gainLeft;
+    ref.limitRight = c.gainRight;
+    ref.forceMono = c.mono;
+}
+
+// best of <repeat> runs, cycles per sample
+template <typename Chain>
+static double run(const Config& c, const std::vector<int16_t>& in, std::vector<int16_t>& out, int repeat, uint16_t* vu) {
+    double best = 1e30;
+    uint32_t frames = in.size() / 2;
+    for(int r = 0; r < repeat; r++) {
+        Chain chain;
+        setup(chain, c);
+        out = in;
+        uint64_t total = 0;
+        for(uint32_t pos = 0; pos < frames; pos += s_chunk) {
+            uint32_t n = std::min(s_chunk, frames - pos);
+            uint64_t t0 = cycles();
+            chain.process(out.data() + 2 * pos, n);
+            total += cycles() - t0;
+        }
+        best = std::min(best, (double)total / frames);
+        if(vu) {
+            if constexpr(std::is_same_v<Chain, AudioDSP>) *vu = chain.getVUlevel();
+            else *vu = (chain.vuLeft << 8) + chain.vuRight;
+        }
+    }
+    return best;
+}
+
+static void compare(const std::vector<int16_t>& a, const std::vector<int16_t>& b, int32_t& maxDiff, double& snr) {
+    double sig = 0, err = 0;
+    maxDiff = 0;
+    for(size_t i = 0; i < a.size(); i++) {
+        int32_t d = abs((int32_t)a[i] - b[i]);
+        maxDiff = std::max(maxDiff, d);
+        sig += (double)b[i] * b[i];
+        err += (double)d * d;
+    }
+    snr = err > 0 ? 10 * log10(sig / err) : INFINITY;
+}
+
+int main(int argc, char* argv[]) {
+    int  repeat = 5;
+    bool check = false;
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "--repeat") && i + 1 < argc) repeat = std::max(1, atoi(argv[++i]));
+        else if(!strcmp(argv[i], "--check")) check = true;
+        else {fprintf(stderr, "usage: dsp_bench [--repeat <n>] [--check]\n"); return 2;}
+    }
+
+    std::vector<int16_t> in = testSignal();
+    std::vector<int16_t> out, ref, flt;
+    int failed = 0;
+
+    printf("%-30s %12s %12s %9s %9s %8s\n", "configuration", "per sample", "block", "max diff", "SNR dB", "VU");
+    for(const Config& c : s_configs) {
+        uint16_t vu = 0, refVu = 0;
+        Config refCfg = c;
+        refCfg.fixedPoint = false;
+        double tRef = run<PerSampleChain>(refCfg, in, ref, repeat, &refVu);
+        double t = run<AudioDSP>(c, in, out, repeat, &vu);
+        int32_t maxDiff;
+        double  snr;
+        compare(out, ref, maxDiff, snr);
+        printf("%-30s %8.1f %-3s %8.1f %-3s %9d %9.1f %4u/%-4u\n", c.name, tRef, s_unit, t, s_unit, (int)maxDiff, snr,
+               (unsigned)(vu >> 8), (unsigned)(refVu >> 8));
+        if(!check) continue;
+        if(!c.fixedPoint) {
+            AudioDSP dsp;
+            setup(dsp, c);
+            int32_t allowed = 1;
+            for(uint8_t i = 0; i < AudioDSP::NUM_FILTERS; i++) allowed += !dsp.isFilterActive(i);
+            if(maxDiff > allowed) {fprintf(stderr, "%s: differs from the per sample chain by %d\n", c.name, (int)maxDiff); failed++;}
+        }
+        if(c.fixedPoint) {
+            Config fc = c;
+            fc.fixedPoint = false;
+            run<AudioDSP>(fc, in, flt, 1, nullptr);
+            compare(out, flt, maxDiff, snr);
+            if(snr < 50) {fprintf(stderr, "%s: SNR %.1f dB against float\n", c.name, snr); failed++;}
+        }
+        if(abs((int)(vu >> 8) - (int)(refVu >> 8)) > 8) {fprintf(stderr, "%s: VU %u, expected %u\n", c.name, vu >> 8, refVu >> 8); failed++;}
+    }
+    return failed ? 1 : 0;
+}
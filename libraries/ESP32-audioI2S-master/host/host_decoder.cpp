@@ -0,0 +1,412 @@
+// host_decoder.cpp
+// Mirrors Audio::processLocalFile(), Audio::sendBytes(), Audio::findNextSync(), Audio::decodeError() and
+// Audio::decodeContinue() without the I2S output, so that what is measured here is what the board decodes.
+
+#include "host_decoder.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/mp3_decoder/mp3_decoder.h"
+#include "../src/flac_decoder/flac_decoder.h"
+#include "../src/opus_decoder/opus_decoder.h"
+#include "../src/vorbis_decoder/vorbis_decoder.h"
+#include "../src/aac_decoder/aac_decoder.h" // last, libfaad defines min() and max()
+
+#undef min // defined by libfaad/neaacdec.h
+#undef max
+
+// the same values as in Audio.h
+static const size_t s_frameSizeMP3    = 1600 * 2;
+static const size_t s_frameSizeAAC    = 1600;
+static const size_t s_frameSizeFLAC   = 4096 * 6;
+static const size_t s_frameSizeOPUS   = 2048;
+static const size_t s_frameSizeVORBIS = 4096 * 2;
+static const size_t s_outbuffSize     = 4096 * 2;
+
+static uint32_t bigEndian(const uint8_t* p, uint8_t len) {
+    uint32_t v = 0;
+    for(uint8_t i = 0; i < len; i++) v = (v << 8) | p[i];
+    return v;
+}
+
+static bool endsWith(const char* s, const char* suffix) {
+    size_t ls = strlen(s), lx = strlen(suffix);
+    if(lx > ls) return false;
+    for(size_t i = 0; i < lx; i++) {
+        if(tolower((unsigned char)s[ls - lx + i]) != suffix[i]) return false;
+    }
+    return true;
+}
+//----------------------------------------------------------------------------------------------------------------------
+HostDecoder::HostDecoder() = default;
+HostDecoder::~HostDecoder() = default;
+//----------------------------------------------------------------------------------------------------------------------
+const char* hostCodecName(HostCodec codec) {
+    switch(codec) {
+        case HostCodec::MP3:    return "MP3";
+        case HostCodec::AAC:    return "AAC";
+        case HostCodec::M4A:    return "M4A";
+        case HostCodec::FLAC:   return "FLAC";
+        case HostCodec::OPUS:   return "OPUS";
+        case HostCodec::VORBIS: return "VORBIS";
+        default:                return "NONE";
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------
+bool HostDecoder::load(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if(!f) return false;
+    std::vector<uint8_t> file;
+    uint8_t buf[16384];
+    size_t n;
+    while((n = fread(buf, 1, sizeof(buf), f)) > 0) file.insert(file.end(), buf, buf + n);
+    fclose(f);
+    return load(std::move(file), path);
+}
+//----------------------------------------------------------------------------------------------------------------------
+bool HostDecoder::load(std::vector<uint8_t> file, const char* name) {
+    m_file = std::move(file);
+    m_audioDataStart = 0;
+    m_audioDataEnd = m_file.size();
+    m_f_flacMD5 = false;
+    m_f_flacOgg = false;
+    m_codec = detectCodec(name);
+    return m_codec != HostCodec::NONE;
+}
+//----------------------------------------------------------------------------------------------------------------------
+HostCodec HostDecoder::detectCodec(const char* name) {
+    skipID3();
+    const uint8_t* d = m_file.data() + m_audioDataStart;
+    size_t len = m_audioDataEnd - m_audioDataStart;
+
+    if(len >= 4 && !memcmp(d, "fLaC", 4)) return HostCodec::FLAC;
+    if(len >= 8 && !memcmp(d + 4, "ftyp", 4)) return HostCodec::M4A;
+    if(len >= 28 && !memcmp(d, "OggS", 4)) { // the first page tells which codec is wrapped
+        size_t payload = 27 + d[26];
+        if(payload + 8 > len) return HostCodec::NONE;
+        if(!memcmp(d + payload, "OpusHead", 8)) return HostCodec::OPUS;
+        if(!memcmp(d + payload, "\x01vorbis", 7)) return HostCodec::VORBIS;
+        if(!memcmp(d + payload, "\x7f" "FLAC", 5)) {m_f_flacOgg = true; return HostCodec::FLAC;}
+        return HostCodec::NONE;
+    }
+    if(len >= 2 && d[0] == 0xFF && (d[1] & 0xF0) == 0xF0) {
+        if((d[1] & 0x06) == 0) return HostCodec::AAC; // ADTS, layer is always 0
+        return HostCodec::MP3;
+    }
+    if(endsWith(name, ".mp3")) return HostCodec::MP3; // the first frame may not be at the start
+    if(endsWith(name, ".aac")) return HostCodec::AAC;
+    return HostCodec::NONE;
+}
+//----------------------------------------------------------------------------------------------------------------------
+bool HostDecoder::skipID3() { // ID3v2 tags in front of the audio data, ID3v1 tag at the end
+    bool found = false;
+    while(m_audioDataEnd - m_audioDataStart >= 10 && !memcmp(m_file.data() + m_audioDataStart, "ID3", 3)) {
+        const uint8_t* h = m_file.data() + m_audioDataStart;
+        size_t size = ((h[6] & 0x7F) << 21) | ((h[7] & 0x7F) << 14) | ((h[8] & 0x7F) << 7) | (h[9] & 0x7F);
+        size += 10;
+        if(h[5] & 0x10) size += 10; // footer present
+        m_audioDataStart = std::min(m_audioDataStart + size, m_audioDataEnd);
+        found = true;
+    }
+    if(m_audioDataEnd - m_audioDataStart >= 128 && !memcmp(m_file.data() + m_audioDataEnd - 128, "TAG", 3)) {
+        m_audioDataEnd -= 128;
+        found = true;
+    }
+    return found;
+}
+//----------------------------------------------------------------------------------------------------------------------
+bool HostDecoder::parseContainer(std::string& error) {
+    if(m_codec == HostCodec::FLAC && !m_f_flacOgg) return readFlacHeader(error);
+    if(m_codec == HostCodec::M4A) return readM4AHeader(error);
+    return true; // MP3 and AAC: ID3 is already skipped, Ogg: the decoders parse the pages themselves
+}
+//----------------------------------------------------------------------------------------------------------------------
+bool HostDecoder::readFlacHeader(std::string& error) { // see Audio::read_FLAC_Header()
+    const uint8_t* d = m_file.data();
+    size_t pos = m_audioDataStart + 4; // "fLaC"
+    bool lastBlock = false;
+    while(!lastBlock) {
+        if(pos + 4 > m_audioDataEnd) {error = "truncated FLAC metadata"; return false;}
+        lastBlock = d[pos] & 0x80;
+        uint8_t blockType = d[pos] & 0x7F;
+        uint32_t blockLen = bigEndian(d + pos + 1, 3);
+        pos += 4;
+        if(pos + blockLen > m_audioDataEnd) {error = "truncated FLAC metadata"; return false;}
+        if(blockType == 0 && blockLen >= 34) { // STREAMINFO
+            const uint8_t* s = d + pos;
+            m_flacSampleRate    = (s[10] << 12) | (s[11] << 4) | (s[12] >> 4);
+            m_flacChannels      = ((s[12] >> 1) & 0x07) + 1;
+            m_flacBitsPerSample = (((s[12] & 0x01) << 4) | (s[13] >> 4)) + 1;
+            m_flacTotalSamples  = ((uint64_t)(s[13] & 0x0F) << 32) | bigEndian(s + 14, 4);
+            memcpy(m_flacMD5, s + 18, 16);
+            for(int i = 0; i < 16; i++) if(m_flacMD5[i]) m_f_flacMD5 = true; // all zero: not computed by the encoder
+        }
+        pos += blockLen;
+    }
+    if(!m_flacSampleRate) {error = "FLAC STREAMINFO not found"; return false;}
+    m_audioDataStart = pos;
+    return true;
+}
+//----------------------------------------------------------------------------------------------------------------------
+bool HostDecoder::readM4AHeader(std::string& error) { // see Audio::read_M4A_Header()
+    const uint8_t* d = m_file.data();
+    size_t moovStart = 0, moovEnd = 0, mdatStart = 0, mdatEnd = 0;
+
+    for(size_t pos = m_audioDataStart; pos + 8 <= m_audioDataEnd;) { // top level atoms
+        uint64_t size = bigEndian(d + pos, 4);
+        size_t headerSize = 8;
+        if(size == 1 && pos + 16 <= m_audioDataEnd) {size = ((uint64_t)bigEndian(d + pos + 8, 4) << 32) | bigEndian(d + pos + 12, 4); headerSize = 16;}
+        if(size == 0) size = m_audioDataEnd - pos; // extends to the end of the file
+        if(size < headerSize || pos + size > m_audioDataEnd) size = m_audioDataEnd - pos;
+        if(!memcmp(d + pos + 4, "moov", 4)) {moovStart = pos + headerSize; moovEnd = pos + size;}
+        if(!memcmp(d + pos + 4, "mdat", 4)) {mdatStart = pos + headerSize; mdatEnd = pos + size;}
+        pos += size;
+    }
+    if(!moovStart) {error = "M4A atom 'moov' not found"; return false;}
+    if(!mdatStart) {error = "M4A atom 'mdat' not found"; return false;}
+
+    // the sample entry 'mp4a' in stsd, followed by 'esds'
+    size_t mp4a = 0;
+    for(size_t i = moovStart; i + 8 + 28 <= moovEnd; i++) {
+        if(!memcmp(d + i, "mp4a", 4)) {mp4a = i - 4; break;}
+    }
+    if(!mp4a) {error = "M4A sample entry 'mp4a' not found"; return false;}
+    const uint8_t* e = d + mp4a + 8;
+    m_m4aChannels   = bigEndian(e + 16, 2);
+    m_m4aSampleRate = bigEndian(e + 24, 2);
+    size_t mp4aEnd  = std::min((size_t)(mp4a + bigEndian(d + mp4a, 4)), moovEnd);
+
+    m_m4aObjectType = 0;
+    for(size_t i = mp4a + 8 + 28; i + 8 <= mp4aEnd; i++) {
+        if(memcmp(d + i, "esds", 4)) continue;
+        size_t end = std::min((size_t)(i - 4 + bigEndian(d + i - 4, 4)), mp4aEnd);
+        size_t p = i + 4 + 4; // version and flags
+        // walk the descriptors: ES_Descriptor (3) contains DecoderConfigDescriptor (4), contains DecoderSpecificInfo (5)
+        while(p + 2 <= end) {
+            uint8_t tag = d[p++];
+            uint32_t len = 0;
+            for(int k = 0; k < 4 && p < end; k++) {
+                uint8_t b = d[p++];
+                len = (len << 7) | (b & 0x7F);
+                if(!(b & 0x80)) break;
+            }
+            if(tag == 3) {
+                uint8_t flags = d[p + 2];
+                p += 3;
+                if(flags & 0x80) p += 2;          // dependsOn_ES_ID
+                if(flags & 0x40) p += 1 + d[p];  // URL
+                if(flags & 0x20) p += 2;          // OCR_ES_ID
+                continue;
+            }
+            if(tag == 4) {p += 13; continue;}
+            if(tag == 5 && len >= 2 && p < end) {m_m4aObjectType = d[p] >> 3; break;}
+            p += len;
+        }
+        break;
+    }
+    if(!m_m4aObjectType) {error = "M4A DecoderSpecificInfo not found"; return false;}
+    if(m_m4aObjectType > 4) {error = "unsupported AAC profile " + std::to_string(m_m4aObjectType); return false;}
+
+    m_audioDataStart = mdatStart;
+    m_audioDataEnd   = std::min(mdatEnd, m_audioDataEnd);
+    return true;
+}
+//----------------------------------------------------------------------------------------------------------------------
+size_t HostDecoder::maxBlockSize() const {
+    switch(m_codec) {
+        case HostCodec::MP3:    return s_frameSizeMP3;
+        case HostCodec::AAC:
+        case HostCodec::M4A:    return s_frameSizeAAC;
+        case HostCodec::FLAC:   return s_frameSizeFLAC;
+        case HostCodec::OPUS:   return s_frameSizeOPUS;
+        case HostCodec::VORBIS: return s_frameSizeVORBIS;
+        default:                return 0;
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------
+bool HostDecoder::allocateDecoder() { // see Audio::initializeDecoder()
+    switch(m_codec) {
+        case HostCodec::MP3:    m_mp3 = std::make_unique<MP3Decoder>(); return m_mp3->allocateBuffers();
+        case HostCodec::AAC:
+        case HostCodec::M4A:    m_aac = std::make_unique<AACDecoder>(); return m_aac->allocateBuffers();
+        case HostCodec::FLAC:
+            m_flac = std::make_unique<FLACDecoder>();
+            if(!m_flac->allocateBuffers()) return false;
+            if(!m_f_flacOgg) m_flac->setRawBlockParams(m_flacChannels, m_flacSampleRate, m_flacBitsPerSample, m_flacTotalSamples, m_audioDataEnd - m_audioDataStart);
+            return true;
+        case HostCodec::OPUS:   m_opus = std::make_unique<OPUSDecoder>(); return m_opus->allocateBuffers();
+        case HostCodec::VORBIS: m_vorbis = std::make_unique<VORBISDecoder>(); return m_vorbis->allocateBuffers();
+        default:                return false;
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------
+void HostDecoder::freeDecoder() { // the destructors free the buffers
+    m_mp3.reset();
+    m_aac.reset();
+    m_flac.reset();
+    m_opus.reset();
+    m_vorbis.reset();
+}
+//----------------------------------------------------------------------------------------------------------------------
+int32_t HostDecoder::findSyncWord(uint8_t* data, int32_t len) { // see Audio::findNextSync()
+    switch(m_codec) {
+        case HostCodec::MP3: {
+            int32_t nextSync = m_mp3->findSyncWord(data, len);
+            if(nextSync == -1) return len; // syncword not found, search next block
+            m_mp3->clearBuffers();
+            return nextSync;
+        }
+        case HostCodec::AAC:    return m_aac->findSyncWord(data, len);
+        case HostCodec::M4A:
+            m_aac->setRawBlockParams(m_m4aChannels ? m_m4aChannels : 2, m_m4aSampleRate ? m_m4aSampleRate : 44100, m_m4aObjectType ? m_m4aObjectType : 2);
+            return 0;
+        case HostCodec::FLAC:   {int32_t n = m_flac->findSyncWord(data, len);   return n == -1 ? len : n;}
+        case HostCodec::OPUS:   {int32_t n = m_opus->findSyncWord(data, len);   return n == -1 ? len : n;}
+        case HostCodec::VORBIS: {int32_t n = m_vorbis->findSyncWord(data, len); return n == -1 ? len : n;}
+        default:                return -1;
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------
+int32_t HostDecoder::decodeFrame(uint8_t* data, int32_t* bytesLeft, int16_t* outBuff) {
+    switch(m_codec) {
+        case HostCodec::MP3:    return m_mp3->decode(data, bytesLeft, outBuff);
+        case HostCodec::AAC:
+        case HostCodec::M4A:    return m_aac->decode(data, bytesLeft, outBuff);
+        case HostCodec::FLAC:   return m_flac->decode(data, bytesLeft, outBuff);
+        case HostCodec::OPUS:   return m_opus->decode(data, bytesLeft, outBuff);
+        case HostCodec::VORBIS: return m_vorbis->decode(data, bytesLeft, outBuff);
+        default:                return -100;
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------
+uint8_t HostDecoder::decoderChannels() {
+    switch(m_codec) {
+        case HostCodec::MP3:    return m_mp3->getChannels();
+        case HostCodec::AAC:
+        case HostCodec::M4A:    return m_aac->getChannels();
+        case HostCodec::FLAC:   return m_flac->getChannels();
+        case HostCodec::OPUS:   return m_opus->getChannels();
+        case HostCodec::VORBIS: return m_vorbis->getChannels();
+        default:                return 0;
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t HostDecoder::decoderSampleRate() {
+    switch(m_codec) {
+        case HostCodec::MP3:    return m_mp3->getSampRate();
+        case HostCodec::AAC:
+        case HostCodec::M4A:    return m_aac->getSampRate();
+        case HostCodec::FLAC:   return m_flac->getSampRate();
+        case HostCodec::OPUS:   return m_opus->getSampRate();
+        case HostCodec::VORBIS: return m_vorbis->getSampRate();
+        default:                return 0;
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t HostDecoder::validSamples(uint8_t channels) { // see Audio::sendBytes()
+    if(!channels) return 0;
+    switch(m_codec) {
+        case HostCodec::MP3:    return m_mp3->getOutputSamps();
+        case HostCodec::AAC:
+        case HostCodec::M4A:    return m_aac->getOutputSamps() / channels;
+        case HostCodec::FLAC:   return m_flac->getOutputSamps() / channels;
+        case HostCodec::OPUS:   return m_opus->getOutputSamps();
+        case HostCodec::VORBIS: return m_vorbis->getOutputSamps();
+        default:                return 0;
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------
+HostDecodeResult HostDecoder::decode(HostPcmSink sink, std::function<void()> onFirstFrame) {
+    HostDecodeResult r;
+    r.codec = m_codec;
+
+    size_t savedStart = m_audioDataStart, savedEnd = m_audioDataEnd;
+    if(!parseContainer(r.error)) return r;
+    if(!allocateDecoder()) {r.error = "the decoder could not be initialized"; freeDecoder(); return r;}
+
+    std::vector<int16_t> outBuff(s_outbuffSize);
+    std::vector<uint8_t> block(maxBlockSize()); // the decoders may write into their input, as into InBuff
+    bool     f_playing = false;
+    bool     f_firstFrame = true;
+    uint32_t stalls = 0;
+    size_t   pos = m_audioDataStart;
+
+    while(pos < m_audioDataEnd) {
+        size_t remaining = m_audioDataEnd - pos;
+        int32_t len = (int32_t)std::min(remaining, block.size());
+        bool lastFrames = remaining < block.size();
+        memcpy(block.data(), m_file.data() + pos, len);
+        uint8_t* data = block.data();
+
+        int32_t bytesDecoded = 0;
+        if(!f_playing) {
+            int32_t nextSync = findSyncWord(data, len);
+            if(nextSync < 0) bytesDecoded = len; // no syncword found
+            else if(nextSync > 0) bytesDecoded = nextSync;
+            else f_playing = true;
+        }
+        if(f_playing && !bytesDecoded) {
+            int32_t bytesLeft = len;
+            auto t0 = std::chrono::steady_clock::now();
+            int32_t res = decodeFrame(data, &bytesLeft, outBuff.data());
+            r.decodeSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            r.decodeCalls++;
+            bytesDecoded = len - bytesLeft;
+
+            if(res < 0) { // see Audio::decodeError()
+                if(res == -100) {r.error = "serious decoder error"; break;}
+                if((m_codec == HostCodec::AAC || m_codec == HostCodec::M4A) && res == -21) { // mono <-> stereo change
+                    m_aac->freeBuffers();
+                    m_aac->allocateBuffers();
+                    bytesDecoded = 0;
+                }
+                else {
+                    r.decodeErrors++;
+                    f_playing = false; // seek for new syncword
+                    if(bytesDecoded == 0) bytesDecoded = 1;
+                }
+            }
+            else if(res > 99) { // see Audio::decodeContinue(), the decoder needs more data
+                bool done = (m_codec == HostCodec::FLAC   && res == FLAC_PARSE_OGG_DONE) ||
+                            (m_codec == HostCodec::OPUS   && (res == OPUS_PARSE_OGG_DONE || res == OPUS_END)) ||
+                            (m_codec == HostCodec::VORBIS && res == VORBIS_PARSE_OGG_DONE);
+                if(!done) bytesDecoded = 0;
+            }
+            else if(bytesDecoded == 0 && res == 0) { // unlikely framesize, seek for new syncword
+                f_playing = false;
+                bytesDecoded = 1;
+            }
+            else {
+                uint8_t channels = decoderChannels();
+                uint32_t samples = validSamples(channels);
+                if(samples) {
+                    if(f_firstFrame) {
+                        f_firstFrame = false;
+                        r.sampleRate = decoderSampleRate();
+                        r.channels = channels;
+                        if(channels != 1 && channels != 2) {r.error = "num of channels must be 1 or 2"; break;}
+                        if(onFirstFrame) onFirstFrame();
+                    }
+                    r.frames += samples;
+                    if(sink) sink(outBuff.data(), samples, channels);
+                }
+            }
+        }
+        if(bytesDecoded <= 0) { // see Audio::processLocalFile()
+            if(lastFrames) break; // end of file reached
+            if(++stalls > 10000) {r.error = "the decoder makes no progress"; break;}
+            continue;
+        }
+        stalls = 0;
+        pos += bytesDecoded;
+    }
+    freeDecoder();
+    m_audioDataStart = savedStart;
+    m_audioDataEnd = savedEnd;
+
+    if(r.error.empty() && !r.frames) r.error = "no samples decoded";
+    r.ok = r.error.empty();
+    return r;
+}
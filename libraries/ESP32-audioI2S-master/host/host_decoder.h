@@ -0,0 +1,96 @@
+// host_decoder.h
+// Drives the decoders of src/ on a desktop machine the same way Audio::sendBytes() does on the ESP32:
+// same block sizes, same sync word search, same handling of the decoder return codes.
+// The container headers (ID3, fLaC, M4A atoms) are parsed here, as Audio does before the first frame.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class HostCodec : uint8_t { NONE, MP3, AAC, M4A, FLAC, OPUS, VORBIS };
+
+const char* hostCodecName(HostCodec codec);
+
+struct HostDecodeResult {
+    HostCodec codec         = HostCodec::NONE;
+    uint32_t  sampleRate    = 0;
+    uint8_t   channels      = 0;
+    uint64_t  frames        = 0;    // sample frames (one sample per channel)
+    uint32_t  decodeCalls   = 0;
+    uint32_t  decodeErrors  = 0;    // recoverable errors, the decoder searched the next sync word
+    double    decodeSeconds = 0;    // time spent inside the decoder calls only
+    bool      ok            = false;
+    std::string error;
+
+    double durationSeconds() const { return sampleRate ? (double)frames / sampleRate : 0; }
+    double realtimeFactor() const { return decodeSeconds > 0 ? durationSeconds() / decodeSeconds : 0; }
+};
+
+// Receives interleaved 16-bit samples: 'frames' sample frames of 'channels' samples each.
+typedef std::function<void(const int16_t* pcm, size_t frames, uint8_t channels)> HostPcmSink;
+
+class MP3Decoder;
+class AACDecoder;
+class FLACDecoder;
+class OPUSDecoder;
+class VORBISDecoder;
+
+// Every HostDecoder has its own decoder instance, several HostDecoders can decode in parallel threads.
+class HostDecoder {
+public:
+    HostDecoder();
+    ~HostDecoder();
+
+    bool load(const char* path);                            // reads the whole file and detects the codec
+    bool load(std::vector<uint8_t> file, const char* name); // takes over a file already in memory
+    HostCodec codec() const { return m_codec; }
+    const uint8_t* flacMD5() const { return m_f_flacMD5 ? m_flacMD5 : nullptr; } // STREAMINFO MD5, native FLAC only
+    uint8_t flacBitsPerSample() const { return m_flacBitsPerSample; }
+
+    // Allocates the decoder, decodes the whole file and frees the decoder again.
+    // 'onFirstFrame' is called once, after the first decoded frame (e.g. to start counting allocations).
+    HostDecodeResult decode(HostPcmSink sink, std::function<void()> onFirstFrame = nullptr);
+
+private:
+    HostCodec detectCodec(const char* name);
+    bool      parseContainer(std::string& error);
+    bool      skipID3();
+    bool      readFlacHeader(std::string& error);
+    bool      readM4AHeader(std::string& error);
+    bool      allocateDecoder();
+    void      freeDecoder();
+    int32_t   findSyncWord(uint8_t* data, int32_t len);
+    int32_t   decodeFrame(uint8_t* data, int32_t* bytesLeft, int16_t* outBuff);
+    uint32_t  validSamples(uint8_t channels);
+    uint8_t   decoderChannels();
+    uint32_t  decoderSampleRate();
+    size_t    maxBlockSize() const;
+
+    std::vector<uint8_t> m_file;
+    HostCodec m_codec = HostCodec::NONE;
+    size_t    m_audioDataStart = 0;
+    size_t    m_audioDataEnd = 0;
+
+    uint8_t   m_flacChannels = 0;
+    uint32_t  m_flacSampleRate = 0;
+    uint8_t   m_flacBitsPerSample = 0;
+    uint64_t  m_flacTotalSamples = 0;
+    uint8_t   m_flacMD5[16] = {0};
+    bool      m_f_flacMD5 = false;
+    bool      m_f_flacOgg = false;
+
+    uint16_t  m_m4aChannels = 0;
+    uint32_t  m_m4aSampleRate = 0;
+    uint8_t   m_m4aObjectType = 0;
+
+    std::unique_ptr<MP3Decoder>    m_mp3;    // created by allocateDecoder() for the codec of the file
+    std::unique_ptr<AACDecoder>    m_aac;
+    std::unique_ptr<FLACDecoder>   m_flac;
+    std::unique_ptr<OPUSDecoder>   m_opus;
+    std::unique_ptr<VORBISDecoder> m_vorbis;
+};
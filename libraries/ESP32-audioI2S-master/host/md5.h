@@ -0,0 +1,81 @@
+// md5.h
+// MD5 (RFC 1321), used to check the decoded samples against the signature in the FLAC STREAMINFO block.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+class MD5 {
+public:
+    MD5() {
+        m_state[0] = 0x67452301; m_state[1] = 0xefcdab89; m_state[2] = 0x98badcfe; m_state[3] = 0x10325476;
+    }
+
+    void update(const void* data, size_t len) {
+        const uint8_t* p = (const uint8_t*)data;
+        size_t used = m_length % 64;
+        m_length += len;
+        if(used) {
+            size_t n = len < 64 - used ? len : 64 - used;
+            memcpy(m_buffer + used, p, n);
+            p += n; len -= n;
+            if(used + n < 64) return;
+            transform(m_buffer);
+        }
+        for(; len >= 64; p += 64, len -= 64) transform(p);
+        memcpy(m_buffer, p, len);
+    }
+
+    void final(uint8_t digest[16]) {
+        uint64_t bits = m_length * 8;
+        static const uint8_t pad[64] = {0x80};
+        size_t used = m_length % 64;
+        update(pad, used < 56 ? 56 - used : 120 - used);
+        uint8_t len[8];
+        for(int i = 0; i < 8; i++) len[i] = (uint8_t)(bits >> (8 * i));
+        update(len, 8);
+        for(int i = 0; i < 16; i++) digest[i] = (uint8_t)(m_state[i / 4] >> (8 * (i % 4)));
+    }
+
+private:
+    static uint32_t rotl(uint32_t x, int c) { return (x << c) | (x >> (32 - c)); }
+
+    void transform(const uint8_t* block) {
+        static const uint32_t K[64] = {
+            0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+            0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+            0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+            0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+            0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+            0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+            0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+            0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+        static const uint8_t R[16] = {7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21};
+
+        uint32_t w[16];
+        for(int i = 0; i < 16; i++) {
+            w[i] = block[i * 4] | (block[i * 4 + 1] << 8) | (block[i * 4 + 2] << 16) | ((uint32_t)block[i * 4 + 3] << 24);
+        }
+        uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+        for(int i = 0; i < 64; i++) {
+            uint32_t f;
+            int g;
+            if(i < 16)      {f = (b & c) | (~b & d); g = i;}
+            else if(i < 32) {f = (d & b) | (~d & c); g = (5 * i + 1) % 16;}
+            else if(i < 48) {f = b ^ c ^ d;          g = (3 * i + 5) % 16;}
+            else            {f = c ^ (b | ~d);       g = (7 * i) % 16;}
+            uint32_t tmp = d;
+            d = c;
+            c = b;
+            b = b + rotl(a + f + K[i] + w[g], R[(i / 16) * 4 + i % 4]);
+            a = tmp;
+        }
+        m_state[0] += a; m_state[1] += b; m_state[2] += c; m_state[3] += d;
+    }
+
+    uint32_t m_state[4];
+    uint8_t  m_buffer[64];
+    uint64_t m_length = 0;
+};
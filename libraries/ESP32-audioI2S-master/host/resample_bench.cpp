@@ -0,0 +1,229 @@
+// resample_bench.cpp
+// Benchmark and quality test of the sample rate conversion to 48kHz (SR_48K, src/audio_dsp/resampler.h).
+//
+// usage: resample_bench [--repeat <n>] [--check]
+//
+// For each input rate: cycles per output frame (left and right value), processing 10 s of a stereo signal in chunks
+// of 1152 frames as playChunk() does, and THD+N of sine tones in the passband (0.41 * input rate), the residual after
+// removing the fitted tone and DC, relative to the tone. "catmull-rom" is the interpolation that playChunk() used
+// before, it is the reference.
+//
+// --check fails (exit code 1) if THD+N of the polyphase resampler is above -75 dB or above the one of the reference
+// where that is worse than -75 dB (low tones, both are close to the 16 bit limit there), if the gain of a tone is off
+// by more than 0.1 dB, if the output depends on the chunk sizes or if setSampleRate() fails (the taps of a phase
+// could overflow the 32 bit accumulators).
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "../src/audio_dsp/resampler.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static uint64_t cycles() { return __rdtsc(); }
+static const char* s_unit = "cycles";
+#else
+static uint64_t cycles() { // no cycle counter, nanoseconds
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+static const char* s_unit = "ns";
+#endif
+
+static const uint32_t s_chunk = 1152;
+
+// Audio::resampleTo48kStereo() before the polyphase resampler
+struct CatmullRom {
+    uint32_t sampleRate = 44100;
+    int16_t  inputHistory[6] = {0};
+    float    resampleCursor = 0.0f;
+
+    bool setSampleRate(uint32_t r) { sampleRate = r; return true; }
+    size_t maxOutputFrames(size_t inFrames) const { return inFrames * 48000 / sampleRate + 4; }
+
+    size_t process(const int16_t* input, size_t inputSamples, int16_t* out, size_t) {
+        float ratio = static_cast<float>(sampleRate) / 48000.0f;
+        float cursor = resampleCursor;
+        size_t extendedSamples = inputSamples + 3;
+        std::vector<int16_t> extendedInput(extendedSamples * 2);
+        memcpy(&extendedInput[0], inputHistory, 6 * sizeof(int16_t));
+        memcpy(&extendedInput[6], input, inputSamples * 2 * sizeof(int16_t));
+        size_t outputIndex = 0;
+        auto clipToInt16 = [](float value) -> int16_t {
+            if(value > 32767.0f) return 32767;
+            if(value < -32768.0f) return -32768;
+            return static_cast<int16_t>(value);
+        };
+        auto catmullRom = [](float t, float xm1, float x0, float x1, float x2) {
+            return 0.5f * ((2.0f * x0) + (-xm1 + x1) * t + (2.0f * xm1 - 5.0f * x0 + 4.0f * x1 - x2) * t * t +
+                           (-xm1 + 3.0f * x0 - 3.0f * x1 + x2) * t * t * t);
+        };
+        for(size_t inIdx = 1; inIdx < extendedSamples - 2; ++inIdx) {
+            int32_t xm1_l = clipToInt16(extendedInput[(inIdx - 1) * 2]);
+            int32_t x0_l  = clipToInt16(extendedInput[(inIdx + 0) * 2]);
+            int32_t x1_l  = clipToInt16(extendedInput[(inIdx + 1) * 2]);
+            int32_t x2_l  = clipToInt16(extendedInput[(inIdx + 2) * 2]);
+            int32_t xm1_r = clipToInt16(extendedInput[(inIdx - 1) * 2 + 1]);
+            int32_t x0_r  = clipToInt16(extendedInput[(inIdx + 0) * 2 + 1]);
+            int32_t x1_r  = clipToInt16(extendedInput[(inIdx + 1) * 2 + 1]);
+            int32_t x2_r  = clipToInt16(extendedInput[(inIdx + 2) * 2 + 1]);
+            while(cursor < 1.0f) {
+                int16_t outLeft = static_cast<int16_t>(catmullRom(cursor, xm1_l, x0_l, x1_l, x2_l));
+                int16_t outRight = static_cast<int16_t>(catmullRom(cursor, xm1_r, x0_r, x1_r, x2_r));
+                out[outputIndex * 2] = clipToInt16(outLeft);
+                out[outputIndex * 2 + 1] = clipToInt16(outRight);
+                ++outputIndex;
+                cursor += ratio;
+            }
+            cursor -= 1.0f;
+        }
+        for(int i = 0; i < 3; ++i) {
+            size_t idx = inputSamples - 3 + i;
+            inputHistory[i * 2] = input[idx * 2];
+            inputHistory[i * 2 + 1] = input[idx * 2 + 1];
+        }
+        resampleCursor = cursor;
+        return outputIndex;
+    }
+};
+
+static std::vector<int16_t> tone(uint32_t rate, double freq, double seconds) {
+    uint32_t frames = rate * seconds;
+    std::vector<int16_t> pcm(frames * 2);
+    for(uint32_t i = 0; i < frames; i++) {
+        double s = 0.7 * 32767 * sin(2 * M_PI * freq * i / rate); // -3 dBFS
+        pcm[2 * i] = pcm[2 * i + 1] = (int16_t)lrint(s);
+    }
+    return pcm;
+}
+
+template <typename R>
+static std::vector<int16_t> resample(R& r, const std::vector<int16_t>& in, uint32_t chunk, uint64_t* time = nullptr) {
+    size_t frames = in.size() / 2;
+    std::vector<int16_t> out(r.maxOutputFrames(frames) * 2 + 2 * s_chunk * 2);
+    size_t n = 0;
+    uint32_t rnd = 1;
+    for(size_t pos = 0; pos < frames;) {
+        uint32_t c = chunk;
+        if(!c) {rnd = rnd * 1664525 + 1013904223; c = 1 + (rnd >> 8) % 2000;} // random chunk sizes
+        c = std::min<size_t>(c, frames - pos);
+        uint64_t t0 = cycles();
+        n += r.process(in.data() + 2 * pos, c, out.data() + 2 * n, out.size() / 2 - n);
+        if(time) *time += cycles() - t0;
+        pos += c;
+    }
+    out.resize(n * 2);
+    return out;
+}
+
+// least squares fit of DC + a sin(wt) + b cos(wt) to the left channel, returns THD+N in dB and the tone level
+static double thdN(const std::vector<int16_t>& pcm, double freq, double& gainDb) {
+    size_t skip = 4800, n = pcm.size() / 2 - skip - 480; // transients at the begin and the end
+    double w = 2 * M_PI * freq / 48000;
+    double ss = 0, cc = 0, sc = 0, s1 = 0, c1 = 0, ys = 0, yc = 0, y1 = 0;
+    for(size_t i = 0; i < n; i++) {
+        double s = sin(w * (i + skip)), c = cos(w * (i + skip)), y = pcm[2 * (i + skip)];
+        ss += s * s; cc += c * c; sc += s * c; s1 += s; c1 += c; ys += y * s; yc += y * c; y1 += y;
+    }
+    // normal equations, 3x3, Cramer's rule
+    double A[3][3] = {{ss, sc, s1}, {sc, cc, c1}, {s1, c1, (double)n}}, B[3] = {ys, yc, y1}, X[3];
+    auto det = [](double m[3][3]) {
+        return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+               m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    };
+    double d = det(A);
+    for(int k = 0; k < 3; k++) {
+        double M[3][3];
+        memcpy(M, A, sizeof(M));
+        for(int r = 0; r < 3; r++) M[r][k] = B[r];
+        X[k] = det(M) / d;
+    }
+    double sig = 0, err = 0;
+    for(size_t i = 0; i < n; i++) {
+        double fit = X[0] * sin(w * (i + skip)) + X[1] * cos(w * (i + skip));
+        double e = pcm[2 * (i + skip)] - fit - X[2];
+        sig += fit * fit;
+        err += e * e;
+    }
+    gainDb = 20 * log10(sqrt(X[0] * X[0] + X[1] * X[1]) / (0.7 * 32767));
+    return 10 * log10(err / sig);
+}
+
+int main(int argc, char* argv[]) {
+    int  repeat = 3;
+    bool check = false;
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "--repeat") && i + 1 < argc) repeat = std::max(1, atoi(argv[++i]));
+        else if(!strcmp(argv[i], "--check")) check = true;
+        else {fprintf(stderr, "usage: resample_bench [--repeat <n>] [--check]\n"); return 2;}
+    }
+    static const uint32_t rates[] = {8000, 11025, 16000, 22050, 24000, 32000, 44100, 88200, 96000};
+    static const double   tones[] = {100, 1000, 3000, 6000, 10000, 15000};
+    int failed = 0;
+
+    printf("%-7s %6s %5s %12s %12s   %s\n", "rate", "phases", "taps", "catmull-rom", "polyphase", "THD+N dB catmull-rom / polyphase (gain dB)");
+    for(uint32_t rate : rates) {
+        AudioResampler r;
+        if(!r.setSampleRate(rate)) { // the taps of a phase could overflow the accumulator
+            fprintf(stderr, "%u Hz: not supported\n", (unsigned)rate);
+            failed++;
+            continue;
+        }
+
+        // speed, music like signal, best of <repeat>
+        std::vector<int16_t> sig = tone(rate, 440, 10);
+        for(size_t i = 0; i < sig.size(); i += 2) sig[i + 1] = sig[i] / 2 + (int16_t)(0.2 * 32767 * sin(i * 0.37));
+        double tOld = 1e30, tNew = 1e30;
+        size_t outFrames = 0;
+        for(int k = 0; k < repeat; k++) {
+            uint64_t t = 0;
+            CatmullRom cr;
+            cr.setSampleRate(rate);
+            outFrames = resample(cr, sig, s_chunk, &t).size() / 2;
+            tOld = std::min(tOld, (double)t / outFrames);
+            t = 0;
+            AudioResampler ar;
+            ar.setSampleRate(rate);
+            outFrames = resample(ar, sig, s_chunk, &t).size() / 2;
+            tNew = std::min(tNew, (double)t / outFrames);
+        }
+        printf("%-7u %6u %5u %8.1f %-3s %8.1f %-3s  ", (unsigned)rate, r.getPhases(), r.getTaps(), tOld, s_unit, tNew, s_unit);
+
+        // the output does not depend on the chunk sizes
+        {
+            AudioResampler a, b;
+            a.setSampleRate(rate);
+            b.setSampleRate(rate);
+            if(resample(a, sig, s_chunk) != resample(b, sig, 0)) {
+                fprintf(stderr, "%u Hz: the output depends on the chunk sizes\n", (unsigned)rate);
+                failed++;
+            }
+        }
+
+        // THD+N
+        for(double f : tones) {
+            if(f > 0.41 * std::min(rate, 48000u)) continue;
+            std::vector<int16_t> in = tone(rate, f, 1);
+            CatmullRom cr;
+            cr.setSampleRate(rate);
+            AudioResampler ar;
+            ar.setSampleRate(rate);
+            double gOld, gNew;
+            double old = thdN(resample(cr, in, s_chunk), f, gOld);
+            double now = thdN(resample(ar, in, s_chunk), f, gNew);
+            printf(" %gk: %.0f / %.0f (%+.2f)", f / 1000, old, now, gNew);
+            if(!check) continue;
+            if(now > -75 || (old > -75 && now > old) || fabs(gNew) > 0.1) {
+                fprintf(stderr, "%u Hz, %g Hz tone: THD+N %.1f dB (before %.1f dB), gain %.2f dB\n", (unsigned)rate, f, now, old, gNew);
+                failed++;
+            }
+        }
+        printf("\n");
+    }
+    return failed ? 1 : 0;
+}
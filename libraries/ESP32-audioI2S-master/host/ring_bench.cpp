@@ -0,0 +1,110 @@
+// ring_bench.cpp
+// Stress test of InBuff (src/audio_buffer/audio_buffer.h), the lock-free ring between the fetch side and the audio task.
+//
+// usage: ring_bench [--megabytes <n>] [--check]
+//
+// A writer thread fills the ring as processWebStream() does (chunks of random size, up to writeSpace(), sometimes a
+// pause as a slow TCP read), a reader thread takes it out as playAudioData() does (a block of getMaxBlockSize() bytes
+// from getReadPtr(), a frame of random size is consumed, sometimes a pause as a slow decode). The ring is small, so
+// the write and read pointers wrap all the time and most blocks need the copy into the reserved space behind the end.
+// Prints the throughput, how often the reader ran short of a block (underrun) and the writer ran out of space.
+//
+// --check fails (exit code 1) if a byte arrives wrong, twice or not at all.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "../src/audio_buffer/audio_buffer.h"
+
+static const size_t s_blockSize = 1600; // m_frameSizeMP3 / m_frameSizeAAC
+static const size_t s_ringSize  = 4 * 4096;
+
+static inline uint8_t pattern(uint64_t i) { return (uint8_t)((i * 2654435761u) >> 24) ^ (uint8_t)(i >> 16); }
+
+struct Rng { // xorshift32, each thread has its own
+    uint32_t s;
+    uint32_t next() { s ^= s << 13; s ^= s >> 17; s ^= s << 5; return s; }
+    uint32_t below(uint32_t n) { return next() % n; }
+};
+
+int main(int argc, char* argv[]) {
+    uint64_t total = 16ULL << 20;
+    bool check = false;
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "--megabytes") && i + 1 < argc) total = (uint64_t)std::max(1, atoi(argv[++i])) << 20;
+        else if(!strcmp(argv[i], "--check")) check = true;
+        else {fprintf(stderr, "usage: ring_bench [--megabytes <n>] [--check]\n"); return 2;}
+    }
+
+    AudioBuffer ring(s_blockSize); // reserved space: one block
+    if(!ring.setBufsize(s_ringSize)) {fprintf(stderr, "the ring could not be allocated\n"); return 1;}
+
+    std::atomic<bool> failed{false};
+    uint64_t writerFull = 0, readerUnderruns = 0, errors = 0, received = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::thread writer([&]() {
+        Rng rng{0x12345678};
+        uint64_t pos = 0;
+        bool full = false;
+        while(pos < total && !failed) {
+            size_t space = ring.writeSpace();
+            if(!space) {if(!full) writerFull++; full = true; std::this_thread::yield(); continue;}
+            full = false;
+            size_t n = std::min<uint64_t>({(uint64_t)space, (uint64_t)rng.below(3000) + 1, total - pos});
+            uint8_t* p = ring.getWritePtr();
+            for(size_t k = 0; k < n; k++) p[k] = pattern(pos + k);
+            ring.bytesWritten(n);
+            pos += n;
+            if(rng.below(64) == 0) std::this_thread::sleep_for(std::chrono::microseconds(rng.below(200))); // slow read
+        }
+    });
+    std::thread reader([&]() {
+        Rng rng{0x9abcdef0};
+        uint64_t pos = 0;
+        bool starving = false;
+        while(pos < total && !failed) {
+            size_t filled = ring.bufferFilled();
+            bool last = total - pos < s_blockSize; // the last frames, as m_pad.lastFrames
+            if(filled < s_blockSize && !(last && filled == total - pos)) {
+                if(!starving) readerUnderruns++;
+                starving = true;
+                std::this_thread::yield();
+                continue;
+            }
+            starving = false;
+            size_t block = std::min(filled, s_blockSize);
+            const uint8_t* p = ring.getReadPtr();
+            for(size_t k = 0; k < block; k++) {
+                if(p[k] != pattern(pos + k)) {errors++; break;}
+            }
+            if(errors) {failed = true; break;}
+            size_t n = rng.below(block) + 1; // the frame the decoder consumed
+            ring.bytesWasRead(n);
+            pos += n;
+            if(rng.below(64) == 0) std::this_thread::sleep_for(std::chrono::microseconds(rng.below(200))); // slow decode
+        }
+        received = pos;
+    });
+    writer.join();
+    reader.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    printf("%llu MB through a ring of %zu bytes, blocks of %zu bytes: %.1f MB/s\n", (unsigned long long)(total >> 20), s_ringSize,
+           s_blockSize, total / seconds / (1 << 20));
+    printf("reader underruns %llu, writer full %llu, errors %llu\n", (unsigned long long)readerUnderruns,
+           (unsigned long long)writerFull, (unsigned long long)errors);
+    if(!check) return 0;
+    if(errors || received != total || ring.bufferFilled() != 0) {
+        fprintf(stderr, "ring check failed: %llu of %llu bytes received, %llu errors, %zu bytes left\n", (unsigned long long)received,
+                (unsigned long long)total, (unsigned long long)errors, ring.bufferFilled());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,405 @@
+// seek_bench.cpp
+// Test of the seek index (src/audio_seek/seek_index.h) with the test files.
+//
+// usage: seek_bench [--check] [<directory with the test files>]
+//
+// Each file is read into memory, the frames (MP3, FLAC, AAC in M4A) or pages (OGG) are listed here with a plain walk
+// over the whole file, that is the reference. The index gets the positions the header parser of Audio would give it
+// and is built completely (MP3, M4A), then 200 targets over the whole length are sought. A seek must land on the
+// frame that contains the target (OGG: the page after the last one that ends before it). FLAC is tested twice, as it
+// is (bisection over the whole file) and with a SEEKTABLE of one point per 10 s inserted in front of the frames.
+// MP3 is also sought while the index is built up to a third only: behind it the TOC of the Xing header estimates.
+// Prints per file the points of the index, the reads to build it, the most reads of one seek and the largest error.
+//
+// --check fails (exit code 1) if a seek misses the frame, if a seek reads more than 48 blocks or if the TOC estimate
+// is more than 2% of the length away.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "../src/audio_seek/seek_index.h"
+
+#ifndef AUDIO_TESTFILES_DIR
+#define AUDIO_TESTFILES_DIR "."
+#endif
+
+static const uint32_t s_maxReads = 48;
+
+struct Frame {
+    uint32_t pos;
+    uint64_t time; // first sample of the frame, OGG: granule position of the page
+    uint32_t len;  // OGG: page length
+};
+
+struct Setup {
+    uint8_t  format = SeekIndex::SI_NONE;
+    uint32_t dataStart = 0, dataEnd = 0, rate = 0;
+    uint64_t totalSamples = 0;
+    uint32_t seekTablePos = 0, seekTableLen = 0;
+    uint32_t mdhd = 0, stts = 0, stsc = 0, stco = 0, stsz = 0;
+    uint32_t preSkip = 0;
+    std::vector<Frame> frames;
+};
+
+static std::vector<uint8_t> s_file;
+static int32_t readMem(void*, uint32_t pos, uint8_t* buf, uint32_t len) {
+    if(pos >= s_file.size()) return 0;
+    if(len > s_file.size() - pos) len = s_file.size() - pos;
+    memcpy(buf, s_file.data() + pos, len);
+    return len;
+}
+
+static uint32_t be32(const uint8_t* p) { return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3]; }
+static uint32_t le32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+static uint64_t le64(const uint8_t* p) { return le32(p) | ((uint64_t)le32(p + 4) << 32); }
+
+//----------------------------------------------------------------------------------------------------------------------
+static bool mp3Frame(const uint8_t* p, uint32_t* len, uint32_t* spf, uint32_t* rate) {
+    static const int kbps[2][16] = {{0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, -1},
+                                    {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, -1}};
+    static const uint32_t rates[4] = {44100, 48000, 32000, 0};
+    if(p[0] != 0xFF || (p[1] & 0xE6) != 0xE2 || ((p[1] >> 3) & 3) == 1) return false; // layer III
+    int v = (p[1] >> 3) & 3, br = kbps[v != 3][p[2] >> 4];
+    *rate = rates[(p[2] >> 2) & 3] >> (v == 3 ? 0 : v == 2 ? 1 : 2);
+    if(br <= 0 || !*rate) return false;
+    *spf = v == 3 ? 1152 : 576;
+    *len = *spf / 8 * br * 1000 / *rate + ((p[2] >> 1) & 1);
+    return true;
+}
+
+static bool setupMP3(Setup& s) {
+    uint32_t pos = 0;
+    if(!memcmp(s_file.data(), "ID3", 3)) {
+        const uint8_t* h = s_file.data();
+        pos = 10 + ((h[6] << 21) | (h[7] << 14) | (h[8] << 7) | h[9]);
+    }
+    s.dataStart = pos;
+    s.dataEnd = s_file.size();
+    if(s.dataEnd > 128 && !memcmp(s_file.data() + s.dataEnd - 128, "TAG", 3)) s.dataEnd -= 128;
+    uint32_t len, spf, rate, len2, spf2, rate2;
+    while(pos + 8 < s.dataEnd) { // the first frame, followed by a second one
+        if(mp3Frame(&s_file[pos], &len, &spf, &rate) && pos + len + 4 <= s.dataEnd && mp3Frame(&s_file[pos + len], &len2, &spf2, &rate2))
+            break;
+        pos++;
+    }
+    s.rate = rate;
+    uint64_t time = 0;
+    while(pos + 4 <= s.dataEnd && mp3Frame(&s_file[pos], &len, &spf, &rate) && rate == s.rate) {
+        s.frames.push_back({pos, time, len});
+        pos += len;
+        time += spf;
+    }
+    s.format = SeekIndex::SI_MP3;
+    return s.frames.size() > 1;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static uint8_t s_crc8[256];
+static bool flacFrame(const uint8_t* p, uint32_t n, uint64_t* number, bool* variable, uint32_t* blockSize) {
+    if(n < 16 || p[0] != 0xFF || (p[1] & 0xFE) != 0xF8 || (p[3] & 1)) return false;
+    uint32_t bs = p[2] >> 4, sr = p[2] & 15;
+    if(!bs || sr == 15 || (p[3] >> 4) > 10 || ((p[3] >> 1) & 7) == 3) return false;
+    int extra = 0; // UTF-8 continuation bytes
+    uint64_t v = p[4];
+    if(v >= 0x80) {
+        int ones = 0;
+        while(ones < 8 && (p[4] & (0x80 >> ones))) ones++;
+        if(ones < 2 || ones > 7) return false;
+        extra = ones - 1;
+        v = p[4] & (0x7F >> ones);
+        for(int k = 1; k <= extra; k++) {
+            if((p[4 + k] & 0xC0) != 0x80) return false;
+            v = (v << 6) | (p[4 + k] & 0x3F);
+        }
+    }
+    uint32_t i = 5 + extra;
+    uint32_t size = bs == 1 ? 192 : bs <= 5 ? 576u << (bs - 2) : bs >= 8 ? 256u << (bs - 8) : 0;
+    if(bs == 6) size = p[i++] + 1;
+    if(bs == 7) {size = (p[i] << 8 | p[i + 1]) + 1; i += 2;}
+    if(sr == 12) i += 1;
+    if(sr == 13 || sr == 14) i += 2;
+    uint8_t crc = 0;
+    for(uint32_t k = 0; k < i; k++) crc = s_crc8[crc ^ p[k]];
+    if(crc != p[i]) return false;
+    *number = v;
+    *variable = p[1] & 1;
+    *blockSize = size;
+    return true;
+}
+
+static bool setupFLAC(Setup& s) {
+    for(int i = 0; i < 256; i++) {
+        uint8_t c = i;
+        for(int k = 0; k < 8; k++) c = (c & 0x80) ? (c << 1) ^ 0x07 : c << 1;
+        s_crc8[i] = c;
+    }
+    if(memcmp(s_file.data(), "fLaC", 4)) return false;
+    uint32_t pos = 4;
+    while(true) {
+        const uint8_t* b = &s_file[pos];
+        uint32_t len = (b[1] << 16) | (b[2] << 8) | b[3];
+        if((b[0] & 0x7F) == 0) {
+            s.rate = (b[4 + 10] << 12) | (b[4 + 11] << 4) | (b[4 + 12] >> 4);
+            s.totalSamples = ((uint64_t)(b[4 + 13] & 0x0F) << 32) | be32(b + 4 + 14);
+        }
+        if((b[0] & 0x7F) == 3) {s.seekTablePos = pos + 4; s.seekTableLen = len;}
+        pos += 4 + len;
+        if(b[0] & 0x80) break;
+    }
+    s.dataStart = pos;
+    s.dataEnd = s_file.size();
+    uint32_t nominal = 0;
+    for(; pos + 16 <= s.dataEnd; pos++) { // every frame header, the sync code is rare enough in the data with the CRC
+        uint64_t number;
+        bool variable;
+        uint32_t blockSize;
+        if(s_file[pos] != 0xFF || !flacFrame(&s_file[pos], s.dataEnd - pos, &number, &variable, &blockSize)) continue;
+        if(!nominal) nominal = blockSize;
+        uint64_t sample = variable ? number : number * nominal;
+        if(sample >= s.totalSamples || (!s.frames.empty() && sample <= s.frames.back().time)) continue;
+        s.frames.push_back({pos, sample, 0});
+    }
+    s.format = SeekIndex::SI_FLAC;
+    return s.frames.size() > 1;
+}
+
+static void insertSeekTable(Setup& s) { // a SEEKTABLE block behind STREAMINFO, one point per 10 s
+    std::vector<uint8_t> table;
+    uint64_t next = 0;
+    for(const Frame& f : s.frames) {
+        if(f.time < next) continue;
+        uint64_t offset = f.pos - s.dataStart;
+        for(int k = 7; k >= 0; k--) table.push_back(f.time >> (8 * k));
+        for(int k = 7; k >= 0; k--) table.push_back(offset >> (8 * k));
+        table.push_back(0x10); table.push_back(0x00);
+        next = f.time + 10 * s.rate;
+    }
+    for(int i = 0; i < 18; i++) table.push_back(i < 8 ? 0xFF : 0); // a placeholder point
+    std::vector<uint8_t> block = {3, (uint8_t)(table.size() >> 16), (uint8_t)(table.size() >> 8), (uint8_t)table.size()};
+    block.insert(block.end(), table.begin(), table.end());
+    uint32_t at = 4 + 4 + 34; // behind STREAMINFO, which is not the last block then
+    s_file[4] &= 0x7F;
+    if(s_file[at - 34 - 4] & 0x80) block[0] |= 0x80;
+    s_file.insert(s_file.begin() + at, block.begin(), block.end());
+    uint32_t shift = block.size();
+    s.seekTablePos = at + 4;
+    s.seekTableLen = table.size();
+    s.dataStart += shift;
+    s.dataEnd += shift;
+    for(Frame& f : s.frames) f.pos += shift;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static bool setupOGG(Setup& s) {
+    s.dataStart = 0;
+    s.dataEnd = s_file.size();
+    uint32_t pos = 0, serial = 0;
+    while(pos + 27 <= s.dataEnd && !memcmp(&s_file[pos], "OggS", 4)) {
+        const uint8_t* h = &s_file[pos];
+        uint32_t len = 27 + h[26];
+        for(int i = 0; i < h[26]; i++) len += h[27 + i];
+        if(pos == 0) {
+            serial = le32(h + 14);
+            const uint8_t* packet = h + 27 + h[26];
+            if(!memcmp(packet, "OpusHead", 8)) {s.rate = 48000; s.preSkip = packet[10] | (packet[11] << 8);}
+            else if(!memcmp(packet, "\x01vorbis", 7)) s.rate = le32(packet + 12);
+        }
+        uint64_t granule = le64(h + 6);
+        if(le32(h + 14) == serial && granule != UINT64_MAX) s.frames.push_back({pos, granule, len});
+        pos += len;
+    }
+    s.format = SeekIndex::SI_OGG;
+    return s.rate && s.frames.size() > 1;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static uint32_t findAtom(uint32_t pos, uint32_t end, const char* name) { // in a container
+    while(pos + 8 <= end) {
+        uint32_t size = be32(&s_file[pos]);
+        if(!memcmp(&s_file[pos + 4], name, 4)) return pos;
+        if(size < 8) return 0;
+        pos += size;
+    }
+    return 0;
+}
+
+static bool setupM4A(Setup& s) {
+    uint32_t moov = findAtom(0, s_file.size(), "moov");
+    if(!moov) return false;
+    uint32_t trak = findAtom(moov + 8, moov + be32(&s_file[moov]), "trak");
+    uint32_t mdia = trak ? findAtom(trak + 8, trak + be32(&s_file[trak]), "mdia") : 0;
+    if(!mdia) return false;
+    uint32_t mdiaEnd = mdia + be32(&s_file[mdia]);
+    s.mdhd = findAtom(mdia + 8, mdiaEnd, "mdhd");
+    uint32_t minf = findAtom(mdia + 8, mdiaEnd, "minf");
+    uint32_t stbl = minf ? findAtom(minf + 8, minf + be32(&s_file[minf]), "stbl") : 0;
+    if(!s.mdhd || !stbl) return false;
+    uint32_t stblEnd = stbl + be32(&s_file[stbl]);
+    s.stts = findAtom(stbl + 8, stblEnd, "stts");
+    s.stsc = findAtom(stbl + 8, stblEnd, "stsc");
+    s.stco = findAtom(stbl + 8, stblEnd, "stco");
+    s.stsz = findAtom(stbl + 8, stblEnd, "stsz");
+    if(!s.stts || !s.stsc || !s.stco || !s.stsz) return false;
+    const uint8_t* m = &s_file[s.mdhd];
+    s.rate = m[8] == 1 ? be32(m + 28) : be32(m + 20);
+
+    // every access unit: the position from stco, stsc and stsz, the time from stts
+    std::vector<uint32_t> sizes, chunks, times;
+    const uint8_t* z = &s_file[s.stsz];
+    for(uint32_t i = 0, n = be32(z + 16); i < n; i++) sizes.push_back(be32(z + 12) ? be32(z + 12) : be32(z + 20 + 4 * i));
+    const uint8_t* t = &s_file[s.stts];
+    for(uint32_t i = 0, n = be32(t + 12), time = 0; i < n; i++)
+        for(uint32_t k = 0; k < be32(t + 16 + 8 * i); k++) {times.push_back(time); time += be32(t + 20 + 8 * i);}
+    const uint8_t* c = &s_file[s.stsc];
+    const uint8_t* o = &s_file[s.stco];
+    uint32_t nChunks = be32(o + 12), nEntries = be32(c + 12), frame = 0;
+    for(uint32_t chunk = 0; chunk < nChunks && frame < sizes.size(); chunk++) {
+        uint32_t e = 0;
+        while(e + 1 < nEntries && be32(c + 16 + 12 * (e + 1)) - 1 <= chunk) e++;
+        uint32_t spc = be32(c + 16 + 12 * e + 4), pos = be32(o + 16 + 4 * chunk);
+        for(uint32_t k = 0; k < spc && frame < sizes.size(); k++, frame++) {
+            s.frames.push_back({pos, times[frame], sizes[frame]});
+            pos += sizes[frame];
+        }
+    }
+    s.dataStart = s.frames.empty() ? 0 : s.frames[0].pos;
+    s.dataEnd = s_file.size();
+    s.format = SeekIndex::SI_M4A;
+    return s.frames.size() > 1 && times.size() == sizes.size();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static bool begin(SeekIndex& si, const Setup& s) {
+    switch(s.format) {
+        case SeekIndex::SI_MP3:  return si.beginMP3(s.dataStart, s.dataEnd);
+        case SeekIndex::SI_FLAC: return si.beginFLAC(s.dataStart, s.dataEnd, s.rate, s.totalSamples, s.seekTablePos, s.seekTableLen);
+        case SeekIndex::SI_OGG:  return si.beginOGG(s.dataStart, s.dataEnd);
+        case SeekIndex::SI_M4A:  return si.beginM4A(s.mdhd, s.stts, s.stsc, s.stco, s.stsz);
+    }
+    return false;
+}
+
+// the frame that contains target: position and time in ms
+static void expected(const Setup& s, uint64_t target, uint32_t* pos, uint32_t* ms) {
+    if(s.format == SeekIndex::SI_OGG) { // the page after the last one that ends at or before the target
+        target += s.preSkip;
+        size_t i = 0;
+        while(i + 1 < s.frames.size() && s.frames[i + 1].time <= target) i++;
+        *pos = s.frames[i].pos + s.frames[i].len;
+        uint64_t t = s.frames[i].time > s.preSkip ? s.frames[i].time - s.preSkip : 0;
+        *ms = t * 1000 / s.rate;
+        return;
+    }
+    size_t lo = 0, hi = s.frames.size();
+    while(hi - lo > 1) {
+        size_t mid = (lo + hi) / 2;
+        if(s.frames[mid].time <= target) lo = mid;
+        else hi = mid;
+    }
+    *pos = s.frames[lo].pos;
+    *ms = s.frames[lo].time * 1000 / s.rate;
+}
+
+static bool testFile(const std::string& path, const char* label, Setup& s, bool check) {
+    SeekIndex si;
+    si.setReader(readMem, nullptr);
+    if(!begin(si, s)) {fprintf(stderr, "%s: begin failed\n", label); return false;}
+    uint64_t length = s.frames.back().time - (s.format == SeekIndex::SI_OGG ? s.preSkip : 0);
+    uint32_t lengthMs = length * 1000 / s.rate;
+    bool ok = true;
+
+    // MP3: a third of the file is indexed, behind it the TOC estimates
+    double tocError = 0;
+    if(s.format == SeekIndex::SI_MP3) {
+        while(si.build() && si.reads() * SeekIndex::BLOCK_SIZE < (s.dataEnd - s.dataStart) / 3) {}
+        for(uint32_t k = 1; k < 20; k++) {
+            uint32_t ms = (uint64_t)lengthMs * k / 20, pos, landed;
+            bool exact;
+            if(!si.seek(ms, &pos, &landed, &exact)) {fprintf(stderr, "%s: seek %u ms before the index was built failed\n", label, ms); ok = false; continue;}
+            if(exact) continue;
+            size_t i = 0; // the frame at or after the estimated position, as the sync search of Audio
+            while(i + 1 < s.frames.size() && s.frames[i].pos < pos) i++;
+            double err = fabs((double)s.frames[i].time * 1000 / s.rate - ms);
+            if(err > tocError) tocError = err;
+        }
+        if(check && tocError > lengthMs * 0.02) {fprintf(stderr, "%s: TOC estimate %.0f ms off\n", label, tocError); ok = false;}
+    }
+
+    uint32_t buildReads = 0;
+    while(si.build()) {}
+    buildReads = si.reads();
+
+    uint32_t maxReads = 0, misses = 0;
+    double maxErr = 0;
+    for(uint32_t k = 0; k <= 200; k++) {
+        uint32_t ms = (uint64_t)lengthMs * k / 200 + (k % 7) * 3, pos, landed, expPos, expMs;
+        uint64_t target = (uint64_t)ms * s.rate / 1000;
+        expected(s, target, &expPos, &expMs);
+        uint32_t r0 = si.reads();
+        bool exact = false;
+        if(!si.seek(ms, &pos, &landed, &exact)) {fprintf(stderr, "%s: seek %u ms failed\n", label, ms); ok = false; continue;}
+        uint32_t reads = si.reads() - r0;
+        if(reads > maxReads) maxReads = reads;
+        double err = fabs((double)landed - ms);
+        if(err > maxErr) maxErr = err;
+        if(!exact || pos != expPos || landed != expMs) {
+            if(misses++ < 5) fprintf(stderr, "%s: seek %u ms: position %u (%u ms), expected %u (%u ms)\n", label, ms, pos, landed, expPos, expMs);
+            ok = false;
+        }
+    }
+    if(maxReads > s_maxReads) {fprintf(stderr, "%s: a seek read %u blocks\n", label, maxReads); ok = false;}
+    printf("%-32s %-5s %6u %6u %8u %10u %10.0f %10.0f  %s\n", label, s.format == SeekIndex::SI_MP3 ? "mp3" : s.format == SeekIndex::SI_FLAC ? "flac"
+           : s.format == SeekIndex::SI_OGG ? "ogg" : "m4a", lengthMs / 1000, (unsigned)si.numPoints(), buildReads, maxReads, maxErr,
+           tocError, ok ? "ok" : "FAILED");
+    (void)path;
+    return ok;
+}
+
+static bool load(const std::string& path) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if(!f) return false;
+    fseek(f, 0, SEEK_END);
+    s_file.resize(ftell(f));
+    fseek(f, 0, SEEK_SET);
+    bool ok = fread(s_file.data(), 1, s_file.size(), f) == s_file.size();
+    fclose(f);
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    bool check = false;
+    std::string dir = AUDIO_TESTFILES_DIR;
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "--check")) check = true;
+        else if(argv[i][0] != '-') dir = argv[i];
+        else {fprintf(stderr, "usage: seek_bench [--check] [<directory with the test files>]\n"); return 2;}
+    }
+
+    printf("%-32s %-5s %6s %6s %8s %10s %10s %10s\n", "file", "", "s", "points", "reads", "reads/seek", "max ms", "TOC ms");
+    bool ok = true;
+    const char* files[] = {"Olsen-Banden.mp3", "Santiano-Wellerman.flac", "Miss-Marple.m4a", "Collide.ogg", "sample.opus"};
+    for(const char* name : files) {
+        std::string path = dir + "/" + name;
+        if(!load(path)) {fprintf(stderr, "%s: can't read\n", path.c_str()); ok = false; continue;}
+        Setup s;
+        bool res = false;
+        std::string ext = path.substr(path.rfind('.') + 1);
+        if(ext == "mp3") res = setupMP3(s);
+        if(ext == "flac") res = setupFLAC(s);
+        if(ext == "m4a") res = setupM4A(s);
+        if(ext == "ogg" || ext == "opus") res = setupOGG(s);
+        if(!res) {fprintf(stderr, "%s: no frames found\n", name); ok = false; continue;}
+        ok &= testFile(path, name, s, check);
+        if(s.format == SeekIndex::SI_FLAC && !s.seekTableLen) {
+            insertSeekTable(s);
+            ok &= testFile(path, (std::string(name) + " +SEEKTABLE").c_str(), s, check);
+        }
+    }
+    if(!check) return 0;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+// sfx_bench.cpp
+// Latency of a UI sound effect (src/audio_dsp/sound_effects.h) over a stream, from playSoundEffect() to the DAC.
+//
+// usage: sfx_bench [--decode-ms <n>] [--check]
+//
+// A model of playChunk() and the I2S DMA ring at 48kHz, in frames: the audio task decodes a chunk of 1152 frames (an
+// MP3 frame, --decode-ms of CPU time, 6 ms by default) and writes it; a write waits until the DMA buffer it fills has
+// been sent. The DMA plays frame x at the time x after the first write. A click is triggered 200 times at times that
+// are not aligned to the chunks, the real SoundEffects mixes it, its first sample in the output gives the latency.
+// Two configurations:
+//   before:  16 x 512 frames of DMA, the effects mixed into the whole chunk after the decode
+//   now:     AUDIO_SFX_DMA_DESC_NUM x AUDIO_SFX_DMA_FRAME_NUM (4 x 96), mixed into each DMA buffer just before it is
+//            written, as playChunk() does while effects are loaded
+// Prints mean and maximum latency and the underruns (the DMA ran dry because the decode took too long).
+//
+// --check fails (exit code 1) if a click is lost, or with "now" a latency above 10 ms or an underrun.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "../src/audio_dsp/sound_effects.h"
+
+static const uint32_t s_rate = 48000;
+static const uint32_t s_chunk = 1152;
+static const uint32_t s_clicks = 200;
+
+typedef struct {
+    const char* name;
+    uint32_t    descNum;
+    uint32_t    frameNum;
+    bool        perBuffer;              // mix each DMA buffer before its write, else the whole chunk after the decode
+} config_t;
+
+typedef struct {
+    uint32_t    found;
+    double      meanMs;
+    double      maxMs;
+    uint32_t    underruns;
+} result_t;
+
+static result_t run(const config_t& cfg, uint32_t decodeFrames) {
+    SoundEffects sfx;
+    std::vector<int16_t> click(48, 8000); // 1 ms, mono
+    int8_t id = sfx.addPCM(click.data(), click.size(), 1, s_rate);
+
+    const uint32_t spacing = 4801;        // 100 ms and one frame, the phase to the chunks changes from click to click
+    const uint64_t total = (uint64_t)(s_clicks + 2) * spacing + 2 * cfg.descNum * cfg.frameNum;
+    std::vector<int16_t> out(2 * total, 0);
+    std::vector<uint64_t> trigger(s_clicks);
+    for(uint32_t k = 0; k < s_clicks; k++) trigger[k] = spacing * (k + 1);
+
+    std::vector<int16_t> chunk(2 * s_chunk);
+    uint64_t now = decodeFrames, start = now, w = 0; // time, the DMA starts with the first write, frames written
+    uint32_t next = 0, underruns = 0;
+    auto fire = [&]() { while(next < s_clicks && trigger[next] <= now) {sfx.play(id); next++;} };
+
+    while(w + s_chunk <= total) {
+        std::fill(chunk.begin(), chunk.end(), 0); // the stream is silent, only the clicks are in the output
+        if(!cfg.perBuffer) {fire(); sfx.mix(chunk.data(), s_chunk, s_rate);}
+        for(uint32_t off = 0; off < s_chunk; off += cfg.frameNum) {
+            uint32_t n = std::min(cfg.frameNum, s_chunk - off);
+            if(cfg.perBuffer) {fire(); sfx.mix(chunk.data() + 2 * off, n, s_rate);}
+            // the last frame of the piece goes into DMA buffer b, it is free when buffer b - descNum has been sent
+            uint64_t b = (w + n - 1) / cfg.frameNum;
+            uint64_t free = b >= cfg.descNum ? start + (b - cfg.descNum + 1) * cfg.frameNum : 0;
+            if(free > now) now = free;
+            if(now > start + w) {underruns++; start = now - w;} // the DMA sent zeros, the output is later from now on
+            memcpy(out.data() + 2 * w, chunk.data() + 2 * off, n * 2 * sizeof(int16_t));
+            w += n;
+        }
+        now += decodeFrames;
+    }
+
+    // the first sample of each click in the output, played at start + index; start only moves on an underrun, which
+    // --check does not allow, so the last value is used
+    result_t r = {0, 0, 0, underruns};
+    double sum = 0;
+    uint64_t x = 0;
+    for(uint32_t k = 0; k < s_clicks; k++) {
+        if(k >= next) break; // not triggered before the end
+        uint64_t from = trigger[k] > start ? trigger[k] - start : 0;
+        x = std::max(x, from);
+        while(x < w && out[2 * x] == 0) x++;
+        if(x >= w) break;
+        double ms = (double)(start + x - trigger[k]) * 1000 / s_rate;
+        sum += ms;
+        r.maxMs = std::max(r.maxMs, ms);
+        r.found++;
+        x += click.size(); // behind this click
+    }
+    r.meanMs = r.found ? sum / r.found : 0;
+    return r;
+}
+
+int main(int argc, char* argv[]) {
+    double decodeMs = 6;
+    bool check = false;
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "--decode-ms") && i + 1 < argc) decodeMs = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--check")) check = true;
+        else {fprintf(stderr, "usage: sfx_bench [--decode-ms <n>] [--check]\n"); return 2;}
+    }
+    uint32_t decodeFrames = decodeMs * s_rate / 1000;
+
+    const config_t before = {"before", 16, 512, false};
+    const config_t now = {"now", 4, 96, true};
+    bool failed = false;
+    for(const config_t* cfg : {&before, &now}) {
+        result_t r = run(*cfg, decodeFrames);
+        printf("%-7s %2u x %3u frames: %u of %u clicks, latency mean %5.1f ms max %5.1f ms, %u underruns\n", cfg->name,
+               cfg->descNum, cfg->frameNum, r.found, s_clicks, r.meanMs, r.maxMs, r.underruns);
+        if(r.found != s_clicks) failed = true;
+        if(cfg == &now && (r.maxMs > 10 || r.underruns)) failed = true;
+    }
+    if(check && failed) {fprintf(stderr, "sfx check failed\n"); return 1;}
+    return 0;
+}
@@ -0,0 +1,79 @@
+// Host shim for the Arduino/ESP32 core: just what the decoders use, so they
+// can be compiled, profiled, and checked on a desktop machine.
+
+#pragma once
+
+#include <assert.h>
+#include <ctype.h>
+#include <stdarg.h>
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// the ESP32 core includes these, and some sources rely on it
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::max;
+using std::min;
+#define _min(a, b) ((a) < (b) ? (a) : (b))
+#define _max(a, b) ((a) > (b) ? (a) : (b))
+
+#ifndef CORE_DEBUG_LEVEL
+#define CORE_DEBUG_LEVEL 1 // errors only
+#endif
+
+#ifndef __unused
+#define __unused __attribute__((unused)) // from newlib's <sys/cdefs.h>
+#endif
+
+typedef bool    boolean;
+typedef uint8_t byte;
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define PROGMEM
+#define PI 3.1415926535897932384626433832795
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+
+// PSRAM: the host has a single heap, reported as PSRAM so that the decoders
+// take the same paths as on a board with PSRAM
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT  (1 << 12)
+
+inline bool  psramFound() { return true; }
+inline void* ps_malloc(size_t size) { return malloc(size); }
+inline void* ps_calloc(size_t n, size_t size) { return calloc(n, size); }
+inline void* ps_realloc(void* ptr, size_t size) { return realloc(ptr, size); }
+inline void* heap_caps_malloc(size_t size, uint32_t) { return malloc(size); }
+inline void* heap_caps_malloc_prefer(size_t size, size_t, ...) { return malloc(size); }
+
+inline unsigned long millis() {
+    using namespace std::chrono;
+    return (unsigned long)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+inline unsigned long micros() {
+    using namespace std::chrono;
+    return (unsigned long)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+inline void delay(unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+// ESP32 core log macros, printed to stderr
+#define log_e(format, ...) fprintf(stderr, "[E] " format "\n", ##__VA_ARGS__)
+#define log_w(format, ...) fprintf(stderr, "[W] " format "\n", ##__VA_ARGS__)
+#define log_i(format, ...) fprintf(stderr, "[I] " format "\n", ##__VA_ARGS__)
+#define log_d(format, ...) do {} while(0)
+#define log_v(format, ...) do {} while(0)
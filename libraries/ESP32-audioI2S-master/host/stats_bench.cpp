@@ -0,0 +1,199 @@
+// stats_bench.cpp
+// Cost and check of the pipeline statistics (src/audio_stats/audio_stats.h) behind Audio::getStats().
+//
+// usage: stats_bench [--repeat <n>] [--check]
+//
+// Measures the nanoseconds of one update of each kind (a read of the fetch side, the fill level and a decoded frame of
+// the audio task, an I2S write): a few ns, against hundreds of us per decoded frame, so the statistics stay on. Then a
+// fetch thread and an audio thread update the statistics with known values for 3 simulated seconds while a third
+// thread takes snapshots all the time, as an application that publishes them.
+//
+// Last, a connect thread starts new streams as connecttohost() does (mutex_playAudioData, setDefaults() with
+// requestReset(), stopSong()) while an audio thread decodes under mutex_audioTask and calls stopSong() after every
+// third frame, as decodeError(-100) does. Both locks are waited for at most a second.
+//
+// --check fails (exit code 1) if the final snapshot differs from the values written: counts, sums, maxima and bins
+// of the histograms, percentiles, bytes per second, the fill history, resyncs and skipped bytes, or if a snapshot
+// taken while the threads run goes backwards, or if connect and stopSong() block each other (a deadlock) or a reset
+// leaves a value behind.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "../src/audio_stats/audio_stats.h"
+
+static const uint32_t s_frames = 3 * 38;  // 3 s of MP3 frames at 44.1kHz, 1152 samples
+static const uint32_t s_reads = 3 * 50;   // 3 s of reads, 20 ms apart
+
+static bool s_failed = false;
+static void expect(bool ok, const char* what) {
+    if(ok) return;
+    fprintf(stderr, "stats check failed: %s\n", what);
+    s_failed = true;
+}
+
+static double nsPerCall(uint32_t repeat, void (*f)(AudioStats&, uint32_t)) {
+    static AudioStats stats;
+    stats.reset(0);
+    uint32_t n = 1000000 * repeat;
+    auto t0 = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < n; i++) f(stats, i);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / n;
+}
+
+// try_lock() until the limit, try_lock_for() uses pthread_mutex_clocklock(), which ThreadSanitizer does not know
+template <typename M> static bool lockWithin(M& m, std::chrono::seconds limit) {
+    auto end = std::chrono::steady_clock::now() + limit;
+    while(!m.try_lock()) {
+        if(std::chrono::steady_clock::now() > end) return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+// connect and a decode error at the same time, with the locks of Audio; false on a deadlock or a reset not applied
+static bool connectDuringDecodeError(uint32_t rounds) {
+    AudioStats stats;
+    stats.reset(0);
+    std::recursive_mutex playAudioData;              // mutex_playAudioData
+    std::mutex audioTask;                            // mutex_audioTask
+    const auto limit = std::chrono::seconds(1);
+    std::atomic<bool> running{true}, deadlock{false};
+    std::atomic<uint32_t> applied{0};
+
+    std::thread audio([&]() {                        // performAudioTask()
+        for(uint32_t i = 1; running; i++) {
+            if(stats.applyReset()) applied++;
+            if(!lockWithin(audioTask, limit)) {deadlock = true; return;}
+            stats.inBuffFill(1000, 2000, i);
+            std::this_thread::sleep_for(std::chrono::microseconds(20)); // the decode
+            stats.decoded(2, 600);
+            stats.i2sWrite(10);
+            if(i % 3 == 0) {                         // decodeError(-100): stopSong()
+                stats.decodeError();
+                if(!lockWithin(playAudioData, limit)) {deadlock = true; audioTask.unlock(); return;}
+                playAudioData.unlock();
+            }
+            audioTask.unlock();
+            std::this_thread::yield();
+        }
+    });
+    for(uint32_t r = 0; r < rounds && !deadlock; r++) { // connecttohost()
+        if(!lockWithin(playAudioData, limit)) {deadlock = true; break;}
+        std::this_thread::sleep_for(std::chrono::microseconds(20)); // the request to the server
+        playAudioData.lock();                        // setDefaults(): stopSong() takes it again
+        stats.requestReset(r);
+        playAudioData.unlock();
+        stats.fetched(1000, 100, r);
+        playAudioData.unlock();
+        std::this_thread::yield();
+    }
+    running = false;
+    audio.join();
+
+    stats.requestReset(0);                           // no writer now: every value must be back to 0
+    stats.applyReset();
+    audio_stats_t s;
+    stats.snapshot(s, 0);
+    bool cleared = !s.bytesFetched && !s.readUs.count && !s.decodeUs[2].count && !s.decodeErrors && !s.i2sWriteUs.count &&
+                   !s.inBuffMinFilled && !s.fillHistoryLen;
+    printf("connect during decode errors: %u rounds, %u resets applied by the audio thread%s\n", rounds, applied.load(),
+           deadlock ? ", DEADLOCK" : "");
+    return !deadlock && applied > 0 && cleared;
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t repeat = 3;
+    bool check = false;
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "--repeat") && i + 1 < argc) repeat = std::max(1, atoi(argv[++i]));
+        else if(!strcmp(argv[i], "--check")) check = true;
+        else {fprintf(stderr, "usage: stats_bench [--repeat <n>] [--check]\n"); return 2;}
+    }
+
+    // the cost of one update, the index varies the values so that every bin is hit
+    printf("ns per update: fetched %.1f, inBuffFill %.1f, decoded %.1f, i2sWrite %.1f\n",
+           nsPerCall(repeat, [](AudioStats& s, uint32_t i) { s.fetched(1460, i & 0x3FFF, i >> 6); }),
+           nsPerCall(repeat, [](AudioStats& s, uint32_t i) { s.inBuffFill(i & 0xFFFF, 0x10000, i >> 6); }),
+           nsPerCall(repeat, [](AudioStats& s, uint32_t i) { s.decoded(2, i & 0xFFFF); }),
+           nsPerCall(repeat, [](AudioStats& s, uint32_t i) { s.i2sWrite(i & 0x7FFF); }));
+
+    // known values from two writer threads, snapshots from a third one
+    AudioStats stats;
+    stats.reset(0);
+    std::atomic<bool> running{true};
+    std::atomic<uint32_t> snapshots{0};
+    bool backwards = false;
+    std::thread reader([&]() {
+        audio_stats_t prev = {}, s;
+        while(running) {
+            stats.snapshot(s, 0);
+            if(s.bytesFetched < prev.bytesFetched || s.decodeUs[2].count < prev.decodeUs[2].count ||
+               s.i2sWriteUs.count < prev.i2sWriteUs.count || s.fillHistoryLen < prev.fillHistoryLen)
+                backwards = true;
+            prev = s;
+            snapshots++;
+        }
+    });
+    std::thread fetch([&]() {
+        for(uint32_t i = 0; i < s_reads; i++) stats.fetched(4096, 100 + i, i * 20); // 204800 bytes per second
+    });
+    std::thread audio([&]() {
+        stats.synced();                                      // the start of the stream, no resync
+        for(uint32_t i = 0; i < s_frames; i++) {
+            uint32_t ms = i * 3000 / s_frames;
+            stats.inBuffFill(ms < 1000 ? 80000 : ms < 2000 ? 20000 : 60000, 100000, ms); // the lowest fill: 80%, 20%, 60%
+            stats.decoded(2, 600 + i);                       // 600 ... 713 us, all in bin 9
+            stats.i2sWrite(i % 2 ? 20000 : 0);               // half of the writes blocked 20 ms (bin 14)
+            if(i == 10 || i == 50) {stats.skipped(417); stats.synced();}
+        }
+        stats.synced();
+        stats.decodeError();
+    });
+    fetch.join();
+    audio.join();
+    running = false;
+    reader.join();
+
+    audio_stats_t s;
+    stats.snapshot(s, 2990);
+    printf("%u snapshots while writing\n", snapshots.load());
+    printf("fetched %u bytes, %u bytes/s, read mean %u us p50 %u us max %u us\n", s.bytesFetched, s.bytesPerSec, s.readUs.meanUs(),
+           s.readUs.percentileUs(50), s.readUs.maxUs);
+    printf("MP3 decode: %u frames, mean %u us, p99 %u us, max %u us\n", s.decodeUs[2].count, s.decodeUs[2].meanUs(),
+           s.decodeUs[2].percentileUs(99), s.decodeUs[2].maxUs);
+    printf("I2S write: %u writes, p50 %u us, p90 %u us, max %u us\n", s.i2sWriteUs.count, s.i2sWriteUs.percentileUs(50),
+           s.i2sWriteUs.percentileUs(90), s.i2sWriteUs.maxUs);
+    printf("fill history:");
+    for(uint8_t i = 0; i < s.fillHistoryLen; i++) printf(" %u%%", s.fillHistory[i]);
+    printf(", resyncs %u, skipped %u bytes, decode errors %u\n", s.resyncs, s.bytesSkipped, s.decodeErrors);
+    if(!check) return 0;
+
+    uint64_t readSum = 0;
+    for(uint32_t i = 0; i < s_reads; i++) readSum += 100 + i;
+    expect(!backwards, "a snapshot went backwards");
+    expect(s.bytesFetched == s_reads * 4096, "bytes fetched");
+    expect(s.bytesPerSec == 204800, "bytes per second");
+    expect(s.readUs.count == s_reads && s.readUs.maxUs == 100 + s_reads - 1 && s.readUs.sumMs == readSum / 1000, "read histogram");
+    expect(s.readUs.bin[6] == 28 && s.readUs.bin[7] == s_reads - 28, "read bins"); // 100 ... 127, 128 ... 249
+    expect(s.decodeUs[2].count == s_frames && s.decodeUs[2].bin[9] == s_frames && s.decodeUs[2].maxUs == 600 + s_frames - 1, "decode histogram");
+    expect(s.decodeUs[2].percentileUs(99) == s.decodeUs[2].maxUs && s.decodeUs[2].meanUs() >= 600, "decode percentile");
+    expect(s.decodeUs[0].count == 0 && s.decodeUs[5].count == 0, "decode histogram of another codec");
+    expect(s.i2sWriteUs.count == s_frames && s.i2sWriteUs.bin[0] == s_frames / 2 && s.i2sWriteUs.bin[14] == s_frames / 2, "I2S histogram");
+    expect(s.i2sWriteUs.percentileUs(50) == 1 && s.i2sWriteUs.percentileUs(90) == 20000, "I2S percentiles");
+    expect(s.i2sWriteUs.sumMs == s_frames / 2 * 20, "I2S sum");
+    expect(s.fillHistoryLen == 2 && s.fillHistory[0] == 20 && s.fillHistory[1] == 80, "fill history");
+    expect(s.inBuffMinFilled == 20000, "lowest fill");
+    expect(s.resyncs == 3 && s.bytesSkipped == 2 * 417 && s.decodeErrors == 1, "resyncs");
+    stats.snapshot(s, 2990 + 2000);
+    expect(s.bytesPerSec == 0, "bytes per second after two seconds without data");
+    expect(connectDuringDecodeError(2000), "connect during a decode error");
+    return s_failed ? 1 : 0;
+}
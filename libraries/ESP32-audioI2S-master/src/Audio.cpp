@@ -15,11 +15,11 @@
 *****************************************************************************************************************************************************/
 
 #include "Audio.h"
-#include "aac_decoder/aac_decoder.h"
 #include "flac_decoder/flac_decoder.h"
 #include "mp3_decoder/mp3_decoder.h"
 #include "opus_decoder/opus_decoder.h"
 #include "vorbis_decoder/vorbis_decoder.h"
+#include "aac_decoder/aac_decoder.h" // last, libfaad defines min() and max()
 #include "psram_unique_ptr.hpp"
 
 template <typename... Args>
@@ -105,161 +105,30 @@ void AUDIO_LOG_IMPL(uint8_t level, const char* path, int line, const char* fmt,
 #define AUDIO_LOG_INFO(fmt, ...)  AUDIO_LOG_IMPL(3, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
 #define AUDIO_LOG_DEBUG(fmt, ...) AUDIO_LOG_IMPL(4, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
 
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-AudioBuffer::AudioBuffer(size_t maxBlockSize) {
-    if(maxBlockSize) m_resBuffSize = maxBlockSize;
-    if(maxBlockSize) m_maxBlockSize = maxBlockSize;
-}
-
-AudioBuffer::~AudioBuffer() {
-    if(m_buffer) free(m_buffer);
-    m_buffer = NULL;
-}
-
-int32_t AudioBuffer::getBufsize() { return m_buffSize; }
-
-bool AudioBuffer::setBufsize(size_t mbs) {
-    if(mbs < 2 * m_resBuffSize) {
-        AUDIO_LOG_ERROR("not allowed buffer size must be greater than %i", 2 * m_resBuffSize);
-        return false;
-    }
-    m_buffSize = mbs;
-    if(!init()) return false;
-    return true;
-}
-
-size_t AudioBuffer::init() {
-    if(m_buffer) free(m_buffer);
-    m_buffer = NULL;
-    m_buffer = (uint8_t*)ps_malloc(m_buffSize + m_resBuffSize);
-
-    if(!m_buffer) return 0;
-    m_f_init = true;
-    resetBuffer();
-    return m_buffSize;
-}
-
-void AudioBuffer::changeMaxBlockSize(uint16_t mbs) {
-    m_maxBlockSize = mbs;
-    return;
-}
-
-uint16_t AudioBuffer::getMaxBlockSize() { return m_maxBlockSize; }
-
-size_t AudioBuffer::freeSpace() {
-    if(m_readPtr == m_writePtr) {
-        if(m_f_isEmpty == true) m_freeSpace = m_buffSize;
-        else m_freeSpace = 0;
-    }
-    if(m_readPtr < m_writePtr) {
-        m_freeSpace = (m_endPtr - m_writePtr) + (m_readPtr - m_buffer);
-    }
-    if(m_readPtr > m_writePtr) {
-        m_freeSpace = m_readPtr - m_writePtr;
-    }
-    return m_freeSpace;
-}
-
-size_t AudioBuffer::writeSpace() {
-    if(m_readPtr == m_writePtr) {
-        if(m_f_isEmpty == true) m_writeSpace = m_endPtr - m_writePtr;
-        else m_writeSpace = 0;
-    }
-    if(m_readPtr < m_writePtr) {
-        m_writeSpace = m_endPtr - m_writePtr;
-    }
-    if(m_readPtr > m_writePtr) {
-        m_writeSpace = m_readPtr - m_writePtr;
-    }
-    return m_writeSpace;
-}
-
-size_t AudioBuffer::bufferFilled() {
-    if(m_readPtr == m_writePtr) {
-        if(m_f_isEmpty == true) m_dataLength = 0;
-        else m_dataLength = m_buffSize;
-    }
-    if(m_readPtr < m_writePtr) {
-        m_dataLength = m_writePtr - m_readPtr;
-    }
-    if(m_readPtr > m_writePtr) {
-        m_dataLength = (m_endPtr - m_readPtr) + (m_writePtr - m_buffer);
-    }
-    return m_dataLength;
-}
-
-size_t AudioBuffer::getMaxAvailableBytes() {
-    if(m_readPtr == m_writePtr) {
-    //   if(m_f_start)m_dataLength = 0;
-        if(m_f_isEmpty == true) m_dataLength = 0;
-        else m_dataLength = (m_endPtr - m_readPtr);
-    }
-    if(m_readPtr < m_writePtr) {
-        m_dataLength = m_writePtr - m_readPtr;
-    }
-    if(m_readPtr > m_writePtr) {
-        m_dataLength = (m_endPtr - m_readPtr);
-    }
-    return m_dataLength;
-}
-
-void AudioBuffer::bytesWritten(size_t bw) {
-    if(!bw) return;
-    m_writePtr += bw;
-    if(m_writePtr == m_endPtr) { m_writePtr = m_buffer; }
-    if(m_writePtr > m_endPtr) AUDIO_LOG_ERROR("AudioBuffer: m_writePtr %i > m_endPtr %i", m_writePtr, m_endPtr);
-    m_f_isEmpty = false;
-}
-
-void AudioBuffer::bytesWasRead(size_t br) {
-    if(!br) return;
-    m_readPtr += br;
-    if(m_readPtr >= m_endPtr) {
-        size_t tmp = m_readPtr - m_endPtr;
-        m_readPtr = m_buffer + tmp;
-    }
-    if(m_readPtr == m_writePtr) m_f_isEmpty = true;
-}
-
-uint8_t* AudioBuffer::getWritePtr() { return m_writePtr; }
-
-uint8_t* AudioBuffer::getReadPtr() {
-    int32_t len = m_endPtr - m_readPtr;
-    if(len < m_maxBlockSize) {                            // be sure the last frame is completed
-        memcpy(m_endPtr, m_buffer, m_maxBlockSize - (len)); // cpy from m_buffer to m_endPtr with len
-    }
-    return m_readPtr;
-}
-
-void AudioBuffer::resetBuffer() {
-    m_writePtr = m_buffer;
-    m_readPtr = m_buffer;
-    m_endPtr = m_buffer + m_buffSize;
-    m_f_isEmpty = true;
-}
-
-uint32_t AudioBuffer::getWritePos() { return m_writePtr - m_buffer; }
-
-uint32_t AudioBuffer::getReadPos() { return m_readPtr - m_buffer; }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // clang-format off
 Audio::Audio(uint8_t i2sPort) {
 
-    mutex_playAudioData = xSemaphoreCreateMutex();
+    mutex_playAudioData = xSemaphoreCreateRecursiveMutex(); // taken again by stopSong() inside connecttohost() and the fetch task
     mutex_audioTask     = xSemaphoreCreateMutex();
 
     if(!psramFound()) AUDIO_LOG_ERROR("audioI2S requires PSRAM!");
 
+    m_mp3Decoder    = std::make_unique<MP3Decoder>();    // small objects, the buffers are allocated in initializeDecoder()
+    m_aacDecoder    = std::make_unique<AACDecoder>();
+    m_flacDecoder   = std::make_unique<FLACDecoder>();
+    m_opusDecoder   = std::make_unique<OPUSDecoder>();
+    m_vorbisDecoder = std::make_unique<VORBISDecoder>();
+
     clientsecure.setInsecure();
     m_i2s_num = i2sPort;  // i2s port number
 
     // -------- I2S configuration -------------------------------------------------------------------------------------------
     m_i2s_chan_cfg.id            = (i2s_port_t)m_i2s_num;  // I2S_NUM_AUTO, I2S_NUM_0, I2S_NUM_1
     m_i2s_chan_cfg.role          = I2S_ROLE_MASTER;        // I2S controller master role, bclk and lrc signal will be set to output
-    m_i2s_chan_cfg.dma_desc_num  = 16;                     // number of DMA buffer
-    m_i2s_chan_cfg.dma_frame_num = 512;                    // I2S frame number in one DMA buffer.
+    m_i2s_chan_cfg.dma_desc_num  = AUDIO_DMA_DESC_NUM;     // number of DMA buffer
+    m_i2s_chan_cfg.dma_frame_num = AUDIO_DMA_FRAME_NUM;    // I2S frame number in one DMA buffer.
     m_i2s_chan_cfg.auto_clear    = true;                   // i2s will always send zero automatically if no data to send
-    i2s_new_channel(&m_i2s_chan_cfg, &m_i2s_tx_handle, NULL);
 
     m_i2s_std_cfg.slot_cfg                = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_STEREO); // Set to enable bit shift in Philips mode
     m_i2s_std_cfg.gpio_cfg.bclk           = I2S_GPIO_UNUSED;           // BCLK, Assignment in setPinout()
@@ -273,22 +142,18 @@ Audio::Audio(uint8_t i2sPort) {
     m_i2s_std_cfg.clk_cfg.sample_rate_hz = 48000;
     m_i2s_std_cfg.clk_cfg.clk_src        = I2S_CLK_SRC_DEFAULT;        // Select PLL_F160M as the default source clock
     m_i2s_std_cfg.clk_cfg.mclk_multiple  = I2S_MCLK_MULTIPLE_128;      // mclk = sample_rate * 256
-    i2s_channel_init_std_mode(m_i2s_tx_handle, &m_i2s_std_cfg);
+    I2SnewChannel();
     I2Sstart();
     m_sampleRate = m_i2s_std_cfg.clk_cfg.sample_rate_hz;
 
-    for(int i = 0; i < 3; i++) {
-        m_filter[i].a0 = 1;
-        m_filter[i].a1 = 0;
-        m_filter[i].a2 = 0;
-        m_filter[i].b1 = 0;
-        m_filter[i].b2 = 0;
-    }
+    m_seekIndex.setReader(&Audio::seekIndexRead, this);
+
     computeLimit();  // first init, vol = 21, vol_steps = 21
     startAudioTask();
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 Audio::~Audio() {
+    stopFetchTask();
     stopSong();
     setDefaults();
 
@@ -319,9 +184,31 @@ esp_err_t Audio::I2Sstart() {
 esp_err_t Audio::I2Sstop() {
     m_outBuff.clear(); // Clear OutputBuffer
     m_samplesBuff48K.clear(); // Clear samplesBuff48K
-    std::fill(std::begin(m_inputHistory), std::end(m_inputHistory), 0); // Clear history in samplesBuff48K
+    m_resampler.reset(); // Clear history of the resampler
     return i2s_channel_disable(m_i2s_tx_handle);
 }
+
+void Audio::I2SnewChannel() {
+    i2s_new_channel(&m_i2s_chan_cfg, &m_i2s_tx_handle, NULL);
+    i2s_channel_init_std_mode(m_i2s_tx_handle, &m_i2s_std_cfg); // pins, clock and slots as set so far
+    i2s_event_callbacks_t i2s_cbs = {};
+    i2s_cbs.on_send_q_ovf = &Audio::i2sSendQueueOverflow; // all DMA buffers sent, no new one written: underrun
+    i2s_channel_register_event_callback(m_i2s_tx_handle, &i2s_cbs, this);
+}
+
+void Audio::I2SsetDMA(uint32_t descNum, uint32_t frameNum) {
+    // the DMA buffers are allocated with the channel, IDF can not change them, so the channel is created again
+    if(m_i2s_chan_cfg.dma_desc_num == descNum && m_i2s_chan_cfg.dma_frame_num == frameNum) return;
+    xSemaphoreTake(mutex_audioTask, portMAX_DELAY); // no i2s_channel_write() meanwhile
+    i2s_channel_disable(m_i2s_tx_handle);
+    i2s_del_channel(m_i2s_tx_handle);
+    m_i2s_chan_cfg.dma_desc_num  = descNum;
+    m_i2s_chan_cfg.dma_frame_num = frameNum;
+    I2SnewChannel();
+    I2Sstart();
+    m_sfxQueuedUntil = 0;
+    xSemaphoreGive(mutex_audioTask);
+}
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::zeroI2Sbuff(){
     uint8_t buff[2] = {0, 0}; // From IDF V5 there is no longer the zero_dma_buff() function.
@@ -334,11 +221,11 @@ void Audio::setDefaults() {
     stopSong();
     initInBuff(); // initialize InputBuffer if not already done
     InBuff.resetBuffer();
-    MP3Decoder_FreeBuffers();
-    FLACDecoder_FreeBuffers();
-    AACDecoder_FreeBuffers();
-    OPUSDecoder_FreeBuffers();
-    VORBISDecoder_FreeBuffers();
+    m_mp3Decoder->freeBuffers();
+    m_flacDecoder->freeBuffers();
+    m_aacDecoder->freeBuffers();
+    m_opusDecoder->freeBuffers();
+    m_vorbisDecoder->freeBuffers();
     m_outBuff.clear(); // Clear OutputBuffer
     m_samplesBuff48K.clear(); // Clear samplesBuff48K
     vector_clear_and_shrink(m_playlistURL);
@@ -375,6 +262,10 @@ void Audio::setDefaults() {
     m_f_ts = false;
     m_f_ogg = false;
     m_f_m4aID3dataAreRead = false;
+    // the callers hold mutex_playAudioData, the audio task may hold mutex_audioTask and wait for it in stopSong(), so
+    // the audio task resets its statistics and m_inBuffUnderruns itself, see performAudioTask()
+    m_i2sUnderruns = 0; // the I2S ISR increments it atomically
+    m_stats.requestReset(millis());
     m_f_stream = false;
     m_f_decode_ready = false;
     m_f_eof = false;
@@ -405,16 +296,20 @@ void Audio::setDefaults() {
     m_channels = 2;       // assume stereo #209
     m_ID3Size = 0;
     m_haveNewFilePos = 0;
+    m_seekIndex.reset();
+    m_resumeTimeMs = -1;
+    m_seekLandedMs = -1;
+    m_flacSeekTablePos = 0;
+    m_flacSeekTableLen = 0;
     m_validSamples = 0;
     m_M4A_chConfig = 0;
     m_M4A_objectType = 0;
     m_M4A_sampleRate = 0;
     m_opus_mode = 0;
-    m_vuLeft = m_vuRight = 0; // #835
-    std::fill(std::begin(m_inputHistory), std::end(m_inputHistory), 0);
+    m_dsp.resetVU(); // #835
+    m_resampler.reset();
     if(m_f_reset_m3u8Codec){m_m3u8Codec = CODEC_AAC;} // reset to default
     m_f_reset_m3u8Codec = true;
-    m_resampleCursor = 0.0f;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -447,7 +342,7 @@ bool Audio::openai_speech(const String& api_key, const String& model, const Stri
         stopSong();
         return false;
     }
-    xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ);
+    xSemaphoreTakeRecursive(mutex_playAudioData, portMAX_DELAY); // the fetch task gives it back after the current read
 
     setDefaults();
     m_f_ssl = true;
@@ -626,7 +521,7 @@ bool Audio::connecttohost(const char* host, const char* user, const char* pwd) {
     ps_ptr<char> path;         // extension + '?' + parameter
     ps_ptr<char> rqh;          // request header
 
-    xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ);
+    xSemaphoreTakeRecursive(mutex_playAudioData, portMAX_DELAY); // the fetch task gives it back after the current read
 
     c_host.copy_from(host);
     c_host.trim();
@@ -912,7 +807,7 @@ bool Audio::httpRange(uint32_t seek, uint32_t length){
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 bool Audio::connecttoFS(fs::FS& fs, const char* path, int32_t fileStartPos) {
 
-    xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ);
+    xSemaphoreTakeRecursive(mutex_playAudioData, portMAX_DELAY); // the fetch task gives it back after the current read
     ps_ptr<char>c_path;
     ps_ptr<char> audioPath;
     bool res = false;
@@ -957,7 +852,7 @@ exit:
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 bool Audio::connecttospeech(const char* speech, const char* lang) {
-    xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ);
+    xSemaphoreTakeRecursive(mutex_playAudioData, portMAX_DELAY); // the fetch task gives it back after the current read
 
     setDefaults();
     char host[] = "translate.google.com.vn";
@@ -1552,7 +1447,7 @@ int Audio::read_FLAC_Header(uint8_t* data, size_t len) {
         m_controlCounter = FLAC_OKAY;
         m_audioDataStart =m_rflh. headerSize;
         m_audioDataSize = m_audioFileSize - m_audioDataStart;
-        FLACSetRawBlockParams(m_flacNumChannels, m_flacSampleRate, m_flacBitsPerSample, m_flacTotalSamplesInStream, m_audioDataSize);
+        m_flacDecoder->setRawBlockParams(m_flacNumChannels, m_flacSampleRate, m_flacBitsPerSample, m_flacTotalSamplesInStream, m_audioDataSize);
         if(m_rflh.picLen) {
             size_t pos = m_audioFilePosition;
             if(audio_id3image) audio_id3image(m_audiofile, m_rflh.picPos, m_rflh.picLen);
@@ -1589,8 +1484,8 @@ int Audio::read_FLAC_Header(uint8_t* data, size_t len) {
         uint8_t bps = (nextval & 0x01) << 4;
         bps += (*(data + 16) >> 4) + 1;
         m_flacBitsPerSample = bps;
-        if((bps != 8) && (bps != 16)) {
-            AUDIO_LOG_ERROR("bits per sample must be 8 or 16, is %i", bps);
+        if((bps != 8) && (bps != 16) && (bps != 20) && (bps != 24)) { // 20 and 24 bit are played with 16 bit
+            AUDIO_LOG_ERROR("bits per sample must be 8, 16, 20 or 24, is %i", bps);
             stopSong();
             return -1;
         }
@@ -1623,6 +1518,8 @@ int Audio::read_FLAC_Header(uint8_t* data, size_t len) {
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     if(m_controlCounter == FLAC_SEEK) { /* SEEKTABLE */
         size_t l = bigEndian(data, 3);
+        m_flacSeekTablePos = m_rflh.headerSize + 3; // the seek points, used by the seek index
+        m_flacSeekTableLen = l;
         m_controlCounter = FLAC_MBH;
         m_rflh.retvalue = l + 3;
         m_rflh.headerSize += m_rflh.retvalue;
@@ -2358,6 +2255,7 @@ int Audio::read_M4A_Header(uint8_t* data, size_t len) {
         atom_name.copy_from((const char*)data + 4, 4);
         atom_size.big_endian(data, 4);
         m_m4aHdr.sizeof_mdia -= atom_size.to_uint32(16);
+        if(atom_name.equals("mdhd")) m_m4aHdr.mdhd_pos = m_m4aHdr.headerSize; // timescale and duration for the seek index
 
         if(atom_name.equals("minf")){
             AUDIO_LOG_DEBUG("atom %s @ %i, size: %i, ends @ %i", atom_name.c_get(), m_m4aHdr.headerSize, atom_size.to_uint32(16), m_m4aHdr.headerSize + atom_size.to_uint32(16));
@@ -2404,6 +2302,10 @@ int Audio::read_M4A_Header(uint8_t* data, size_t len) {
         atom_size.big_endian(data, 4);
         atom_name.copy_from((const char*)data + 4, 4);
         m_m4aHdr.sizeof_stbl -= atom_size.to_uint32(16);
+        if(atom_name.equals("stts")) m_m4aHdr.stts_pos = m_m4aHdr.headerSize; // sample tables for the seek index
+        if(atom_name.equals("stsc")) m_m4aHdr.stsc_pos = m_m4aHdr.headerSize;
+        if(atom_name.equals("stco") || atom_name.equals("co64")) m_m4aHdr.stco_pos = m_m4aHdr.headerSize;
+        if(atom_name.equals("stsz")) m_m4aHdr.stsz_pos = m_m4aHdr.headerSize;
 
         if(atom_name.equals("stsd")){
             AUDIO_LOG_DEBUG("atom %s @ %i, size: %i, ends @ %i", atom_name.c_get(), m_m4aHdr.headerSize, atom_size.to_uint32(16), m_m4aHdr.headerSize + atom_size.to_uint32(16));
@@ -2773,6 +2675,7 @@ size_t Audio::process_m3u8_ID3_Header(uint8_t* packet) {
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint32_t Audio::stopSong() {
+    xSemaphoreTakeRecursive(mutex_playAudioData, portMAX_DELAY); // the fetch task must not read into InBuff now
     m_f_lockInBuffer = true; // wait for the decoding to finish
         uint8_t maxWait = 0;
         while(m_f_audioTaskIsDecoding) {vTaskDelay(1); maxWait++; if(maxWait > 100) break;} // in case of error wait max 100ms
@@ -2789,13 +2692,13 @@ uint32_t Audio::stopSong() {
             AUDIO_INFO("Closing audio file \"%s\"", m_audiofile.name());
             m_audiofile.close();
         }
-        memset(m_filterBuff, 0, sizeof(m_filterBuff)); // Clear FilterBuffer
-        if(m_codec == CODEC_MP3) MP3Decoder_FreeBuffers();
-        if(m_codec == CODEC_AAC) AACDecoder_FreeBuffers();
-        if(m_codec == CODEC_M4A) AACDecoder_FreeBuffers();
-        if(m_codec == CODEC_FLAC) FLACDecoder_FreeBuffers();
-        if(m_codec == CODEC_OPUS) OPUSDecoder_FreeBuffers();
-        if(m_codec == CODEC_VORBIS) VORBISDecoder_FreeBuffers();
+        m_dsp.clearFilters(); // Clear FilterBuffer
+        if(m_codec == CODEC_MP3) m_mp3Decoder->freeBuffers();
+        if(m_codec == CODEC_AAC) m_aacDecoder->freeBuffers();
+        if(m_codec == CODEC_M4A) m_aacDecoder->freeBuffers();
+        if(m_codec == CODEC_FLAC) m_flacDecoder->freeBuffers();
+        if(m_codec == CODEC_OPUS) m_opusDecoder->freeBuffers();
+        if(m_codec == CODEC_VORBIS) m_vorbisDecoder->freeBuffers();
         m_validSamples = 0;
         m_audioCurrentTime = 0;
         m_audioFileDuration = 0;
@@ -2804,6 +2707,7 @@ uint32_t Audio::stopSong() {
         m_streamType = ST_NONE;
         m_playlistFormat = FORMAT_NONE;
         m_f_lockInBuffer = false;
+    xSemaphoreGiveRecursive(mutex_playAudioData);
     return pos;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -2822,93 +2726,17 @@ bool Audio::pauseResume() {
     xSemaphoreGive(mutex_audioTask);
     return retVal;
 }
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-size_t Audio::resampleTo48kStereo(const int16_t* input, size_t inputSamples) {
-
-    float ratio = static_cast<float>(m_sampleRate) / 48000.0f;
-    float cursor = m_resampleCursor;
-
-    // Anzahl Input-Samples + 3 History-Samples (vorherige 3 Stereo-Frames)
-    size_t extendedSamples = inputSamples + 3;
-
-    // Temporärer Buffer: History + aktueller Input
-    std::vector<int16_t> extendedInput(extendedSamples * 2);
-
-    // Historie an den Anfang kopieren (6 Werte = 3 Stereo-Samples)
-    memcpy(&extendedInput[0], m_inputHistory, 6 * sizeof(int16_t));
-
-    // Aktuelles Input danach einfügen
-    memcpy(&extendedInput[6], input, inputSamples * 2 * sizeof(int16_t));
-
-    size_t outputIndex = 0;
-
-    auto clipToInt16 = [](float value) -> int16_t {
-        if (value > 32767.0f){AUDIO_LOG_ERROR("overflow +"); return 32767;}
-        if (value < -32768.0f) {AUDIO_LOG_ERROR("overflow -");return -32768;}
-        return static_cast<int16_t>(value);
-    };
-
-    for (size_t inIdx = 1; inIdx < extendedSamples - 2; ++inIdx) {
-        int32_t xm1_l = clipToInt16(extendedInput[(inIdx - 1) * 2]);
-        int32_t x0_l  = clipToInt16(extendedInput[(inIdx + 0) * 2]);
-        int32_t x1_l  = clipToInt16(extendedInput[(inIdx + 1) * 2]);
-        int32_t x2_l  = clipToInt16(extendedInput[(inIdx + 2) * 2]);
-
-        int32_t xm1_r = clipToInt16(extendedInput[(inIdx - 1) * 2 + 1]);
-        int32_t x0_r  = clipToInt16(extendedInput[(inIdx + 0) * 2 + 1]);
-        int32_t x1_r  = clipToInt16(extendedInput[(inIdx + 1) * 2 + 1]);
-        int32_t x2_r  = clipToInt16(extendedInput[(inIdx + 2) * 2 + 1]);
-
-        while (cursor < 1.0f) {
-            float t = cursor;
-
-            // Catmull-Rom spline, construct a cubic curve
-            auto catmullRom = [](float t, float xm1, float x0, float x1, float x2) {
-                return 0.5f * (
-                    (2.0f * x0) +
-                    (-xm1 + x1) * t +
-                    (2.0f * xm1 - 5.0f * x0 + 4.0f * x1 - x2) * t * t +
-                    (-xm1 + 3.0f * x0 - 3.0f * x1 + x2) * t * t * t
-                );
-            };
-
-            int16_t outLeft = static_cast<int16_t>(
-                catmullRom(t, xm1_l, x0_l, x1_l, x2_l)
-            );
-            int16_t outRight = static_cast<int16_t>(
-                catmullRom(t, xm1_r, x0_r, x1_r, x2_r)
-            );
-
-            m_samplesBuff48K[outputIndex * 2]     = clipToInt16(outLeft);
-            m_samplesBuff48K[outputIndex * 2 + 1] = clipToInt16(outRight);
-
-            ++outputIndex;
-            cursor += ratio;
-        }
-
-        cursor -= 1.0f;
-    }
-
-    // Letzte 3 Stereo-Samples als neue Historie sichern
-    for (int i = 0; i < 3; ++i) {
-        size_t idx = inputSamples - 3 + i;
-        m_inputHistory[i * 2]     = input[idx * 2];
-        m_inputHistory[i * 2 + 1] = input[idx * 2 + 1];
-    }
-    m_resampleCursor = cursor;
-    return outputIndex;
-}
-
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void IRAM_ATTR Audio::playChunk() {
     if(m_validSamples == 0) return; // nothing to do
-    int16_t* outBuff_ptr = nullptr;
+#ifdef SR_48K
+    int16_t* outBuff_ptr = m_samplesBuff48K.get(); // also when the rest of a chunk is written (m_plCh.count > 0)
+#else
+    int16_t* outBuff_ptr = m_outBuff.get();
+#endif
 
     m_plCh.validSamples = 0;
     m_plCh.i2s_bytesConsumed = 0;
-    m_plCh.sample[0] = 0;
-    m_plCh.sample[1] = 0;
-    m_plCh.s2 = 0;
     m_plCh.sampleSize = 4; // 2 bytes per sample (int16_t) * 2 channels
     m_plCh.err = ESP_OK;
     m_plCh.i = 0;
@@ -2926,36 +2754,13 @@ void IRAM_ATTR Audio::playChunk() {
 
     m_plCh.validSamples = m_validSamples;
 
-    while(m_plCh.validSamples) {
-        *m_plCh.sample = m_outBuff.get() + m_plCh.i;
-        computeVUlevel(*m_plCh.sample);
-
-        //---------- Filterchain, can commented out if not used-------------
-        {
-            if(m_corr > 1) {
-                m_plCh.s2 = *m_plCh.sample;
-                m_plCh.s2[LEFTCHANNEL] /= m_corr;
-                m_plCh.s2[RIGHTCHANNEL] /= m_corr;
-            }
-            IIR_filterChain0(*m_plCh.sample);
-            IIR_filterChain1(*m_plCh.sample);
-            IIR_filterChain2(*m_plCh.sample);
-        }
-        //------------------------------------------------------------------
-        if(m_f_forceMono && m_channels == 2){
-            int32_t xy = ((*m_plCh.sample)[RIGHTCHANNEL] + (*m_plCh.sample)[LEFTCHANNEL]) / 2;
-            (*m_plCh.sample)[RIGHTCHANNEL] = (int16_t)xy;
-            (*m_plCh.sample)[LEFTCHANNEL]  = (int16_t)xy;
-        }
-        Gain(*m_plCh.sample);
-        m_plCh.i += 2;
-        m_plCh.validSamples -= 1;
-    }
+    // VU meter, level correction, filterchain, mono and gain over the whole chunk, see audio_dsp.h
+    m_dsp.setForceMono(m_f_forceMono && m_channels == 2);
+    m_dsp.process(m_outBuff.get(), m_plCh.validSamples);
     //------------------------------------------------------------------------------------------
 #ifdef SR_48K
-    m_plCh.samples48K = resampleTo48kStereo(m_outBuff.get(), m_validSamples);
+    m_plCh.samples48K = m_resampler.process(m_outBuff.get(), m_validSamples, m_samplesBuff48K.get(), m_samplesBuff48KSize / 2);
     m_validSamples = m_plCh.samples48K;
-    outBuff_ptr = m_samplesBuff48K.get();
 
     if(m_i2s_std_cfg.clk_cfg.sample_rate_hz != 48000){
         m_i2s_std_cfg.clk_cfg.sample_rate_hz = 48000;
@@ -2963,8 +2768,6 @@ void IRAM_ATTR Audio::playChunk() {
         i2s_channel_reconfig_std_clock(m_i2s_tx_handle, &m_i2s_std_cfg.clk_cfg);
         i2s_channel_enable(m_i2s_tx_handle);
     };
-#else
-    outBuff_ptr = m_outBuff.get();
 #endif
 
     if(audio_process_i2s) {
@@ -2977,27 +2780,29 @@ void IRAM_ATTR Audio::playChunk() {
             return;
         }
     }
+    m_plCh.mixed = 0;
 
 i2swrite:
-
-    m_plCh.err = i2s_channel_write(m_i2s_tx_handle, outBuff_ptr + m_plCh.count, m_validSamples * m_plCh.sampleSize, &m_plCh.i2s_bytesConsumed, 50);
-    if( ! (m_plCh.err == ESP_OK || m_plCh.err == ESP_ERR_TIMEOUT)) goto exit;
-    m_validSamples -= m_plCh.i2s_bytesConsumed / m_plCh.sampleSize;
-    m_plCh.count += m_plCh.i2s_bytesConsumed / 2;
-    if(m_validSamples <= 0) { m_validSamples = 0; m_plCh.count = 0; }
-
-// ---- statistics, bytes written to I2S (every 10s)
-    // static int cnt = 0;
-    // static uint32_t t = millis();
-
-    // if(t + 10000 < millis()){
-    //     AUDIO_LOG_INFO("%i", cnt);
-    //     cnt = 0;
-    //     t = millis();
-    // }
-    // cnt+= i2s_bytesConsumed;
-//-------------------------------------------
-
+    // one DMA buffer per write, the UI sound effects are mixed into each piece just before it is written: a new effect
+    // waits for the DMA buffers (AUDIO_SFX_DMA_...), not for the rest of the chunk
+    while(m_validSamples > 0) {
+        int16_t* piece = outBuff_ptr + m_plCh.count;
+        uint32_t frames = (uint32_t)m_validSamples < m_i2s_chan_cfg.dma_frame_num ? m_validSamples : m_i2s_chan_cfg.dma_frame_num;
+        if(m_plCh.mixed < frames) {
+            m_sfx.mix(piece + 2 * m_plCh.mixed, frames - m_plCh.mixed, m_i2s_std_cfg.clk_cfg.sample_rate_hz);
+            m_plCh.mixed = frames;
+        }
+        uint32_t t0 = micros();
+        m_plCh.err = i2s_channel_write(m_i2s_tx_handle, piece, frames * m_plCh.sampleSize, &m_plCh.i2s_bytesConsumed, 50);
+        m_stats.i2sWrite(micros() - t0); // blocks while the DMA buffers are full
+        if( ! (m_plCh.err == ESP_OK || m_plCh.err == ESP_ERR_TIMEOUT)) goto exit;
+        uint32_t written = m_plCh.i2s_bytesConsumed / m_plCh.sampleSize;
+        m_validSamples -= written;
+        m_plCh.count += written * 2;
+        m_plCh.mixed -= written;
+        if(written < frames) break; // timeout, the rest with the next call
+    }
+    if(m_validSamples <= 0) { m_validSamples = 0; m_plCh.count = 0; m_plCh.mixed = 0; }
 
     return;
 exit:
@@ -3009,6 +2814,11 @@ exit:
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::loop() {
+    if(m_f_fetchTaskIsRunning) return; // the fetch task does the work, see setFetchTaskCore()
+    fetchAudioData();
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::fetchAudioData() {
     if(!m_f_running) return;
 
     if(m_playlistFormat != FORMAT_M3U8) { // normal process
@@ -3694,6 +3504,7 @@ void Audio::processLocalFile() {
             return;
         }
         else {
+            initSeekIndex();
             m_f_stream = true;
             AUDIO_INFO("stream ready");
         }
@@ -3704,6 +3515,8 @@ void Audio::processLocalFile() {
         m_fileStartPos = -1;
     }
 
+    if(m_prlf.bytesAddedToBuffer <= 0 && !m_seekIndex.isComplete()) m_seekIndex.build(); // InBuff is full: one block of the index
+
     // end of file reached? - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     if(m_f_eof){ // m_f_eof and m_f_ID3v1TagFound will be set in playAudioData()
         if(m_f_ID3v1TagFound) readID3V1Tag();
@@ -3930,7 +3743,7 @@ exit:
 
 //     if(m_resumeFilePos >= 0 ) {  // we have a resume file position
 //         m_pwf.newFilePos = newInBuffStart(m_resumeFilePos);
-//         int x = MP3FindSyncWord(InBuff.getReadPtr(), InBuff.getMaxAvailableBytes());
+//         int x = m_mp3Decoder->findSyncWord(InBuff.getReadPtr(), InBuff.getMaxAvailableBytes());
 //         log_w("x %i", x);
 //         if(m_pwf.newFilePos < 0) AUDIO_LOG_WARN("skip to new position was not successful");
 //         m_haveNewFilePos  = m_pwf.newFilePos;
@@ -4254,8 +4067,9 @@ void Audio::processWebStreamHLS() {
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::playAudioData() {
 
-    if(!m_f_stream || m_f_eof || m_f_lockInBuffer || !m_f_running){m_validSamples = 0; return;} // guard, stream not ready or eof reached or InBuff is locked or not running
-    if(m_validSamples) {playChunk();                                                   return;} // guard, play samples first
+    m_f_audioTaskIsDecoding = true; // first the flag, then m_f_lockInBuffer, stopSong() and newInBuffStart() do it the other way round
+    if(!m_f_stream || m_f_eof || m_f_lockInBuffer || !m_f_running){m_validSamples = 0; m_f_audioTaskIsDecoding = false; return;} // guard, stream not ready or eof reached or InBuff is locked or not running
+    if(m_validSamples) {playChunk();                                 m_f_audioTaskIsDecoding = false; return;} // guard, play samples first
     //--------------------------------------------------------------------------------
     m_pad.count = 0;
     m_pad.bytesToDecode = InBuff.bufferFilled();
@@ -4269,10 +4083,9 @@ void Audio::playAudioData() {
         m_pad.lastFrames = false;
         m_f_eof = false;
     }
+    m_stats.inBuffFill(InBuff.bufferFilled(), InBuff.getBufsize(), millis());
     //--------------------------------------------------------------------------------
 
-    m_f_audioTaskIsDecoding = true;
-
     if((m_dataMode == AUDIO_LOCALFILE || m_streamType == ST_WEBFILE) && m_playlistFormat != FORMAT_M3U8)  { // local file or webfile but not m3u8 file
         if(!m_audioDataSize) goto exit; // no data to decode if filesize is 0
         if(m_audioDataSize != m_pad.oldAudioDataSize) { // Special case: Metadata in ogg files are recognized by the decoder,
@@ -4303,7 +4116,7 @@ void Audio::playAudioData() {
     }
     else{
         if(InBuff.bufferFilled() >= InBuff.getMaxBlockSize()) m_pad.bytesDecoded = sendBytes(InBuff.getReadPtr(), m_pad.bytesToDecode);
-        else m_pad.bytesDecoded = 0; // Inbuff not filled enough
+        else {m_pad.bytesDecoded = 0; m_inBuffUnderruns++;} // Inbuff not filled enough, the task waits 50ms below
     }
 
     if(m_pad.bytesDecoded <= 0) {
@@ -4679,8 +4492,8 @@ return true;
 bool Audio::initializeDecoder(uint8_t codec) {
     switch(codec) {
         case CODEC_MP3:
-            if(!MP3Decoder_IsInit()){
-                if(!MP3Decoder_AllocateBuffers()) {
+            if(!m_mp3Decoder->isInit()){
+                if(!m_mp3Decoder->allocateBuffers()) {
                     AUDIO_INFO("The MP3Decoder could not be initialized");
                     goto exit;
                 }
@@ -4689,8 +4502,8 @@ bool Audio::initializeDecoder(uint8_t codec) {
             }
             break;
         case CODEC_AAC:
-            if(!AACDecoder_IsInit()) {
-                if(!AACDecoder_AllocateBuffers()) {
+            if(!m_aacDecoder->isInit()) {
+                if(!m_aacDecoder->allocateBuffers()) {
                     AUDIO_INFO("The AACDecoder could not be initialized");
                     goto exit;
                 }
@@ -4699,8 +4512,8 @@ bool Audio::initializeDecoder(uint8_t codec) {
             }
             break;
         case CODEC_M4A:
-            if(!AACDecoder_IsInit()) {
-                if(!AACDecoder_AllocateBuffers()) {
+            if(!m_aacDecoder->isInit()) {
+                if(!m_aacDecoder->allocateBuffers()) {
                     AUDIO_INFO("The AACDecoder could not be initialized");
                     goto exit;
                 }
@@ -4713,7 +4526,7 @@ bool Audio::initializeDecoder(uint8_t codec) {
                 AUDIO_INFO("FLAC works only with PSRAM!");
                 goto exit;
             }
-            if(!FLACDecoder_AllocateBuffers()) {
+            if(!m_flacDecoder->allocateBuffers()) {
                 AUDIO_INFO("The FLACDecoder could not be initialized");
                 goto exit;
             }
@@ -4721,7 +4534,7 @@ bool Audio::initializeDecoder(uint8_t codec) {
             AUDIO_INFO("FLACDecoder has been initialized");
             break;
         case CODEC_OPUS:
-            if(!OPUSDecoder_AllocateBuffers()) {
+            if(!m_opusDecoder->allocateBuffers()) {
                 AUDIO_INFO("The OPUSDecoder could not be initialized");
                 goto exit;
             }
@@ -4733,7 +4546,7 @@ bool Audio::initializeDecoder(uint8_t codec) {
                 AUDIO_INFO("VORBIS works only with PSRAM!");
                 goto exit;
             }
-            if(!VORBISDecoder_AllocateBuffers()) {
+            if(!m_vorbisDecoder->allocateBuffers()) {
                 AUDIO_INFO("The VORBISDecoder could not be initialized");
                 goto exit;
             }
@@ -5059,12 +4872,12 @@ void Audio::showCodecParams() {
     else { AUDIO_INFO("BitRate: N/A"); }
 
     if(m_codec == CODEC_AAC) {
-        uint8_t answ = AACGetFormat();
+        uint8_t answ = m_aacDecoder->getFormat();
         if(answ < 3) {
             const char hf[4][8] = {"unknown", "ADIF", "ADTS"};
             AUDIO_INFO("AAC HeaderFormat: %s", hf[answ]);
         }
-        answ = AACGetSBR();
+        answ = m_aacDecoder->getSBR();
         if(answ > 0 && answ < 4) {
             const char sbr[4][50] = {"without SBR", "upsampled SBR", "downsampled SBR", "no SBR used, but file is upsampled by a factor 2"};
             AUDIO_INFO("Spectral band replication: %s", sbr[answ]);
@@ -5087,29 +4900,29 @@ int Audio::findNextSync(uint8_t* data, size_t len) {
         m_fnsy.nextSync = 0;
     }
     if(m_codec == CODEC_MP3) {
-        m_fnsy.nextSync = MP3FindSyncWord(data, len);
+        m_fnsy.nextSync = m_mp3Decoder->findSyncWord(data, len);
         if(m_fnsy.nextSync == -1) return len; // syncword not found, search next block
-        MP3Decoder_ClearBuffer();
+        m_mp3Decoder->clearBuffers();
     }
-    if(m_codec == CODEC_AAC) { m_fnsy.nextSync = AACFindSyncWord(data, len); }
+    if(m_codec == CODEC_AAC) { m_fnsy.nextSync = m_aacDecoder->findSyncWord(data, len); }
     if(m_codec == CODEC_M4A) {
         if(!m_M4A_chConfig)m_M4A_chConfig = 2; // guard
         if(!m_M4A_sampleRate)m_M4A_sampleRate = 44100;
         if(!m_M4A_objectType)m_M4A_objectType = 2;
-        AACSetRawBlockParams(m_M4A_chConfig, m_M4A_sampleRate, m_M4A_objectType);
+        m_aacDecoder->setRawBlockParams(m_M4A_chConfig, m_M4A_sampleRate, m_M4A_objectType);
         m_f_playing = true;
         m_fnsy.nextSync = 0;
     }
     if(m_codec == CODEC_FLAC) {
-        m_fnsy.nextSync = FLACFindSyncWord(data, len);
+        m_fnsy.nextSync = m_flacDecoder->findSyncWord(data, len);
         if(m_fnsy.nextSync == -1) return len; // OggS not found, search next block
     }
     if(m_codec == CODEC_OPUS) {
-        m_fnsy.nextSync = OPUSFindSyncWord(data, len);
+        m_fnsy.nextSync = m_opusDecoder->findSyncWord(data, len);
         if(m_fnsy.nextSync == -1) return len; // OggS not found, search next block
     }
     if(m_codec == CODEC_VORBIS) {
-        m_fnsy.nextSync = VORBISFindSyncWord(data, len);
+        m_fnsy.nextSync = m_vorbisDecoder->findSyncWord(data, len);
         if(m_fnsy.nextSync == -1) return len; // OggS not found, search next block
     }
     if(m_fnsy.nextSync == -1) {
@@ -5134,45 +4947,45 @@ int Audio::findNextSync(uint8_t* data, size_t len) {
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::setDecoderItems() {
     if(m_codec == CODEC_MP3) {
-        setChannels(MP3GetChannels());
-        setSampleRate(MP3GetSampRate());
-        setBitsPerSample(MP3GetBitsPerSample());
-        setBitrate(MP3GetBitrate());
-        AUDIO_INFO("%s %s", MP3GetMPEGVersion(), MP3GetLayer());
+        setChannels(m_mp3Decoder->getChannels());
+        setSampleRate(m_mp3Decoder->getSampRate());
+        setBitsPerSample(m_mp3Decoder->getBitsPerSample());
+        setBitrate(m_mp3Decoder->getBitRate());
+        AUDIO_INFO("%s %s", m_mp3Decoder->getMPEGVersion(), m_mp3Decoder->getLayer());
     }
     if(m_codec == CODEC_AAC || m_codec == CODEC_M4A) {
-        setChannels(AACGetChannels());
-        setSampleRate(AACGetSampRate());
-        setBitsPerSample(AACGetBitsPerSample());
-        setBitrate(AACGetBitrate());
+        setChannels(m_aacDecoder->getChannels());
+        setSampleRate(m_aacDecoder->getSampRate());
+        setBitsPerSample(m_aacDecoder->getBitsPerSample());
+        setBitrate(m_aacDecoder->getBitRate());
     }
     if(m_codec == CODEC_FLAC) {
-        setChannels(FLACGetChannels());
-        setSampleRate(FLACGetSampRate());
-        setBitsPerSample(FLACGetBitsPerSample());
-        setBitrate(FLACGetBitRate());
-        if(FLACGetAudioDataStart() > 0){ // only flac-ogg, native flac sets audioDataStart in readFlacHeader()
-            m_audioDataStart = FLACGetAudioDataStart();
+        setChannels(m_flacDecoder->getChannels());
+        setSampleRate(m_flacDecoder->getSampRate());
+        setBitsPerSample(m_flacDecoder->getBitsPerSample());
+        setBitrate(m_flacDecoder->getBitRate());
+        if(m_flacDecoder->getAudioDataStart() > 0){ // only flac-ogg, native flac sets audioDataStart in readFlacHeader()
+            m_audioDataStart = m_flacDecoder->getAudioDataStart();
             if(m_audioFileSize) m_audioDataSize = m_audioFileSize - m_audioDataStart;
         }
     }
     if(m_codec == CODEC_OPUS) {
-        setChannels(OPUSGetChannels());
-        setSampleRate(OPUSGetSampRate());
-        setBitsPerSample(OPUSGetBitsPerSample());
-        setBitrate(OPUSGetBitRate());
-        if(OPUSGetAudioDataStart() > 0){
-            m_audioDataStart = OPUSGetAudioDataStart();
+        setChannels(m_opusDecoder->getChannels());
+        setSampleRate(m_opusDecoder->getSampRate());
+        setBitsPerSample(m_opusDecoder->getBitsPerSample());
+        setBitrate(m_opusDecoder->getBitRate());
+        if(m_opusDecoder->getAudioDataStart() > 0){
+            m_audioDataStart = m_opusDecoder->getAudioDataStart();
             if(m_audioFileSize) m_audioDataSize = m_audioFileSize - m_audioDataStart;
         }
     }
     if(m_codec == CODEC_VORBIS) {
-        setChannels(VORBISGetChannels());
-        setSampleRate(VORBISGetSampRate());
-        setBitsPerSample(VORBISGetBitsPerSample());
-        setBitrate(VORBISGetBitRate());
-        if(VORBISGetAudioDataStart() > 0){
-            m_audioDataStart = VORBISGetAudioDataStart();
+        setChannels(m_vorbisDecoder->getChannels());
+        setSampleRate(m_vorbisDecoder->getSampRate());
+        setBitsPerSample(m_vorbisDecoder->getBitsPerSample());
+        setBitrate(m_vorbisDecoder->getBitRate());
+        if(m_vorbisDecoder->getAudioDataStart() > 0){
+            m_audioDataStart = m_vorbisDecoder->getAudioDataStart();
             if(m_audioFileSize) m_audioDataSize = m_audioFileSize - m_audioDataStart;
         }
     }
@@ -5184,13 +4997,14 @@ void Audio::setDecoderItems() {
         AUDIO_INFO("Num of channels must be 1 or 2, found %i", getChannels());
         stopSong();
     }
-    memset(m_filterBuff, 0, sizeof(m_filterBuff)); // Clear FilterBuffer
+    m_dsp.clearFilters(); // Clear FilterBuffer
     IIR_calculateCoefficients(m_gain0, m_gain1, m_gain2); // must be recalculated after each samplerate change
     showCodecParams();
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint32_t Audio::decodeError(int8_t res, uint8_t* data, int32_t bytesDecoded){
         // for(int i = 0; i < 10; i++){printf("0x%02X ", data[i]);} printf("\n");
+        m_stats.decodeError();
         if(res == -100){stopSong(); return bytesDecoded;} // serious error, e.g. decoder could not be initialized
         if(m_codec == CODEC_AAC && res == -21){ // mono <-> stereo change
             //  According to the specification, the channel configuration is transferred in the first ADTS header and no longer changes in the entire
@@ -5204,8 +5018,8 @@ uint32_t Audio::decodeError(int8_t res, uint8_t* data, int32_t bytesDecoded){
                     AUDIO_INFO("AAC channel config changed to %d", m_sbyt.channels);
                 }
             }
-            AACDecoder_FreeBuffers();
-            AACDecoder_AllocateBuffers();
+            m_aacDecoder->freeBuffers();
+            m_aacDecoder->allocateBuffers();
             return 0;
         }
         m_f_playing = false; // seek for new syncword
@@ -5232,9 +5046,9 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
         m_sbyt.isPS = 0;
         m_sbyt.f_setDecodeParamsOnce = true;
         m_sbyt.nextSync = findNextSync(data, len);
-        if(m_sbyt.nextSync <  0) return len; // no syncword found
-        if(m_sbyt.nextSync == 0) { m_f_playing = true; }
-        if(m_sbyt.nextSync >  0) return m_sbyt.nextSync;
+        if(m_sbyt.nextSync <  0) {m_stats.skipped(len); return len;} // no syncword found
+        if(m_sbyt.nextSync == 0) { m_f_playing = true; m_stats.synced(); }
+        if(m_sbyt.nextSync >  0) {m_stats.skipped(m_sbyt.nextSync); return m_sbyt.nextSync;}
     }
     // m_f_playing is true at this pos
     int res = 0;
@@ -5244,19 +5058,21 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
     if(m_codec == CODEC_NONE && m_playlistFormat == FORMAT_M3U8) return 0; // can happen when the m3u8 playlist is loaded
     if(!m_f_decode_ready) return 0; // find sync first
 
+    uint32_t t0 = micros();
     switch(m_codec) {
         case CODEC_WAV:    res = 0; m_sbyt.bytesLeft = 0; break;
-        case CODEC_MP3:    res = MP3Decode(   data, &m_sbyt.bytesLeft, m_outBuff.get()); break;
-        case CODEC_AAC:    res = AACDecode(   data, &m_sbyt.bytesLeft, m_outBuff.get()); break;
-        case CODEC_M4A:    res = AACDecode(   data, &m_sbyt.bytesLeft, m_outBuff.get()); break;
-        case CODEC_FLAC:   res = FLACDecode(  data, &m_sbyt.bytesLeft, m_outBuff.get()); break;
-        case CODEC_OPUS:   res = OPUSDecode(  data, &m_sbyt.bytesLeft, m_outBuff.get()); break;
-        case CODEC_VORBIS: res = VORBISDecode(data, &m_sbyt.bytesLeft, m_outBuff.get()); break;
+        case CODEC_MP3:    res = m_mp3Decoder->decode(   data, &m_sbyt.bytesLeft, m_outBuff.get()); break;
+        case CODEC_AAC:    res = m_aacDecoder->decode(   data, &m_sbyt.bytesLeft, m_outBuff.get()); break;
+        case CODEC_M4A:    res = m_aacDecoder->decode(   data, &m_sbyt.bytesLeft, m_outBuff.get()); break;
+        case CODEC_FLAC:   res = m_flacDecoder->decode(  data, &m_sbyt.bytesLeft, m_outBuff.get()); break;
+        case CODEC_OPUS:   res = m_opusDecoder->decode(  data, &m_sbyt.bytesLeft, m_outBuff.get()); break;
+        case CODEC_VORBIS: res = m_vorbisDecoder->decode(data, &m_sbyt.bytesLeft, m_outBuff.get()); break;
         default: {
             AUDIO_LOG_ERROR("no valid codec found codec = %d", m_codec);
             stopSong();
         }
     }
+    m_stats.decoded(m_codec, micros() - t0);
     bytesDecoded = len - m_sbyt.bytesLeft;
 
     // res - possible values are:
@@ -5292,24 +5108,24 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
                                 m_validSamples = len;
                             }
                             break;
-        case CODEC_MP3:     m_validSamples = MP3GetOutputSamps();
+        case CODEC_MP3:     m_validSamples = m_mp3Decoder->getOutputSamps();
                             break;
-        case CODEC_AAC:     m_validSamples = AACGetOutputSamps() / getChannels();
-                            if(!m_sbyt.isPS && AACGetParametricStereo()){ // only change 0 -> 1
+        case CODEC_AAC:     m_validSamples = m_aacDecoder->getOutputSamps() / getChannels();
+                            if(!m_sbyt.isPS && m_aacDecoder->getParametricStereo()){ // only change 0 -> 1
                                 m_sbyt.isPS = 1;
                                 AUDIO_INFO("Parametric Stereo");
                             }
-                            else m_sbyt.isPS = AACGetParametricStereo();
+                            else m_sbyt.isPS = m_aacDecoder->getParametricStereo();
                             break;
-        case CODEC_M4A:     m_validSamples = AACGetOutputSamps() / getChannels();
+        case CODEC_M4A:     m_validSamples = m_aacDecoder->getOutputSamps() / getChannels();
                             break;
-        case CODEC_FLAC:    m_validSamples = FLACGetOutputSamps() / getChannels();
-                            st = FLACgetStreamTitle();
+        case CODEC_FLAC:    m_validSamples = m_flacDecoder->getOutputSamps() / getChannels();
+                            st = m_flacDecoder->getStreamTitle();
                             if(st) {
                                 AUDIO_INFO(st);
                                 if(audio_showstreamtitle) audio_showstreamtitle(st);
                             }
-                            vec = FLACgetMetadataBlockPicture();
+                            vec = m_flacDecoder->getMetadataBlockPicture();
                             if(vec.size() > 0){ // get blockpic data
                                 // AUDIO_LOG_INFO("---------------------------------------------------------------------------");
                                 // AUDIO_LOG_INFO("ogg metadata blockpicture found:");
@@ -5318,13 +5134,13 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
                                 if(audio_oggimage) audio_oggimage(m_audiofile, vec);
                             }
                             break;
-        case CODEC_OPUS:    m_validSamples = OPUSGetOutputSamps();
-                            st = OPUSgetStreamTitle();
+        case CODEC_OPUS:    m_validSamples = m_opusDecoder->getOutputSamps();
+                            st = m_opusDecoder->getStreamTitle();
                             if(st){
                                 AUDIO_INFO(st);
                                 if(audio_showstreamtitle) audio_showstreamtitle(st);
                             }
-                            vec = OPUSgetMetadataBlockPicture();
+                            vec = m_opusDecoder->getMetadataBlockPicture();
                             if(vec.size() > 0){ // get blockpic data
                                 // AUDIO_LOG_INFO("---------------------------------------------------------------------------");
                                 // AUDIO_LOG_INFO("ogg metadata blockpicture found:");
@@ -5333,8 +5149,8 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
                                 if(audio_oggimage) audio_oggimage(m_audiofile, vec);
                             }
 
-                            if(m_opus_mode != OPUSgetMode()){
-                                m_opus_mode = OPUSgetMode();
+                            if(m_opus_mode != m_opusDecoder->getMode()){
+                                m_opus_mode = m_opusDecoder->getMode();
                                 if(m_opus_mode == MODE_CELT_ONLY) AUDIO_INFO("Opus Mode: CELT_ONLY");
                                 if(m_opus_mode == MODE_HYBRID)    AUDIO_INFO("Opus Mode: HYBRID");
                                 if(m_opus_mode == MODE_SILK_ONLY) AUDIO_INFO("Opus Mode: SILK_ONLY");
@@ -5342,13 +5158,13 @@ int Audio::sendBytes(uint8_t* data, size_t len) {
                             }
                             break;
 
-        case CODEC_VORBIS:  m_validSamples = VORBISGetOutputSamps();
-                            st = VORBISgetStreamTitle();
+        case CODEC_VORBIS:  m_validSamples = m_vorbisDecoder->getOutputSamps();
+                            st = m_vorbisDecoder->getStreamTitle();
                             if(st) {
                                 AUDIO_INFO(st);
                                 if(audio_showstreamtitle) audio_showstreamtitle(st);
                             }
-                            vec = VORBISgetMetadataBlockPicture();
+                            vec = m_vorbisDecoder->getMetadataBlockPicture();
                             if(vec.size() > 0){ // get blockpic data
                                 // AUDIO_LOG_INFO("---------------------------------------------------------------------------");
                                 // AUDIO_LOG_INFO("ogg metadata blockpicture found:");
@@ -5391,9 +5207,9 @@ void Audio::computeAudioTime(uint16_t bytesDecoderIn, uint16_t bytesDecoderOut)
         m_cat.nominalBitRate = 0;
         m_cat.syltIdx = 0;
 
-        if(m_codec == CODEC_FLAC && FLACGetAudioFileDuration()){
-            m_audioFileDuration = FLACGetAudioFileDuration();
-            m_cat.nominalBitRate = (m_audioDataSize / FLACGetAudioFileDuration()) * 8;
+        if(m_codec == CODEC_FLAC && m_flacDecoder->getAudioFileDuration()){
+            m_audioFileDuration = m_flacDecoder->getAudioFileDuration();
+            m_cat.nominalBitRate = (m_audioDataSize / m_flacDecoder->getAudioFileDuration()) * 8;
             m_avr_bitrate = m_cat.nominalBitRate;
         }
         if(m_codec == CODEC_WAV){
@@ -5402,12 +5218,10 @@ void Audio::computeAudioTime(uint16_t bytesDecoderIn, uint16_t bytesDecoderOut)
             m_audioFileDuration = m_audioDataSize  / (getSampleRate() * getChannels());
             if(getBitsPerSample() == 16) m_audioFileDuration /= 2;
         }
-        if(m_codec == CODEC_MP3){
-            // if(MP3GetAudioFileDuration() > 0){ // XING header present?
-            //     m_audioFileDuration = MP3GetAudioFileDuration();
-            //     m_cat.nominalBitRate  = MP3GetBitrate();
-            //     m_avr_bitrate = m_cat.nominalBitRate;
-            // }
+        if(!m_cat.nominalBitRate && m_seekIndex.durationMs()){ // Xing/VBRI, mdhd or the last OGG page
+            m_audioFileDuration = m_seekIndex.durationMs() / 1000;
+            m_cat.nominalBitRate = (uint64_t)m_audioDataSize * 8000 / m_seekIndex.durationMs();
+            m_avr_bitrate = m_cat.nominalBitRate;
         }
     }
 
@@ -5440,6 +5254,11 @@ void Audio::computeAudioTime(uint16_t bytesDecoderIn, uint16_t bytesDecoderOut)
     if(m_haveNewFilePos && m_avr_bitrate){
         uint32_t posWhithinAudioBlock =  m_haveNewFilePos - m_audioDataStart;
         float newTime = (float)posWhithinAudioBlock / (m_avr_bitrate / 8);
+        if(m_seekLandedMs >= 0){ // the seek index knows the time of the frame
+            newTime = (float)m_seekLandedMs / 1000;
+            posWhithinAudioBlock = (uint64_t)m_seekLandedMs * m_avr_bitrate / 8000;
+            m_seekLandedMs = -1;
+        }
         m_audioCurrentTime = round(newTime);
         m_cat.sumBytesIn = posWhithinAudioBlock;
         m_haveNewFilePos = 0;
@@ -5478,7 +5297,7 @@ bool Audio::setPinout(uint8_t BCLK, uint8_t LRC, uint8_t DOUT, int8_t MCLK) {
     trim(audioI2SVers);
     AUDIO_INFO("audioI2S %s", audioI2SVers);
 
-    i2s_std_gpio_config_t gpio_cfg = {};
+    i2s_std_gpio_config_t& gpio_cfg = m_i2s_std_cfg.gpio_cfg; // kept for a new channel, see I2SsetDMA()
     gpio_cfg.bclk = (gpio_num_t)BCLK;
     gpio_cfg.din = (gpio_num_t)I2S_GPIO_UNUSED;
     gpio_cfg.dout = (gpio_num_t)DOUT;
@@ -5521,7 +5340,12 @@ bool Audio::setAudioPlayPosition(uint16_t sec) {
     // e.g. setAudioPlayPosition(300) sets the pointer at pos 5 min
     if(sec > getAudioFileDuration()) sec = getAudioFileDuration();
     uint32_t filepos = m_audioDataStart + (m_avr_bitrate * sec / 8);
-    if(m_dataMode == AUDIO_LOCALFILE) return setFilePos(filepos);
+    if(m_dataMode == AUDIO_LOCALFILE) {
+        m_resumeTimeMs = sec * 1000; // the seek index replaces filepos if it can
+        if(setFilePos(filepos)) return true;
+        m_resumeTimeMs = -1;
+        return false;
+    }
     // if(m_streamType == ST_WEBFILE) return httpRange(m_lastHost, filepos);
     return false;
 }
@@ -5551,7 +5375,11 @@ bool Audio::setTimeOffset(int sec) { // fast forward or rewind the current posit
     int32_t  offset = oneSec * sec;                      // bytes to be wind/rewind
     int32_t pos = m_audioFilePosition - inBufferFilled();
     pos += offset;
-    setFilePos(pos);
+    if(m_dataMode == AUDIO_LOCALFILE) { // for the seek index
+        m_resumeTimeMs = (int32_t)(m_audioCurrentTime * 1000) + sec * 1000;
+        if(m_resumeTimeMs < 0) m_resumeTimeMs = 0;
+    }
+    if(!setFilePos(pos)) m_resumeTimeMs = -1;
     return true;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -5559,6 +5387,7 @@ int32_t Audio::audioFileRead(uint8_t* buff, size_t len){
     if(buff && len == 0) return 0; // nothing to do
     // This method standardized reading files, regardless of the source (local or web) and the correct number of the bytes read must be determined.
     int32_t res = -1;
+    uint32_t t0 = micros();
 
     if(m_dataMode == AUDIO_LOCALFILE){
         if(!buff && !len){
@@ -5581,6 +5410,7 @@ int32_t Audio::audioFileRead(uint8_t* buff, size_t len){
             if(res >= 0) m_audioFilePosition += res;
         }
     }
+    if(buff && res > 0) m_stats.fetched(res, micros() - t0, millis());
     return res;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -5649,7 +5479,9 @@ bool Audio::setSampleRate(uint32_t sampRate) {
         m_sampleRate = 8000;
     }
     m_sampleRate = sampRate;
-    m_resampleRatio = (float)m_sampleRate / 48000.0f;
+#ifdef SR_48K
+    if(!m_resampler.setSampleRate(m_sampleRate)) AUDIO_LOG_ERROR("can't resample %lu Hz to 48kHz", m_sampleRate); // taps once per sample rate
+#endif
 
     m_i2s_std_cfg.clk_cfg.sample_rate_hz = m_sampleRate;
     i2s_channel_disable(m_i2s_tx_handle);
@@ -5708,69 +5540,64 @@ void Audio::setI2SCommFMT_LSB(bool commFMT) {
     i2s_channel_enable(m_i2s_tx_handle);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void Audio::computeVUlevel(int16_t sample[2]) {
-
-    auto avg = [&](uint8_t* sampArr) { // lambda, inner function, compute the average of 8 samples
-        uint16_t av = 0;
-        for(int i = 0; i < 8; i++) { av += sampArr[i]; }
-        return av >> 3;
-    };
-
-    auto largest = [&](uint8_t* sampArr) { // lambda, inner function, compute the largest of 8 samples
-        uint16_t maxValue = 0;
-        for(int i = 0; i < 8; i++) {
-            if(maxValue < sampArr[i]) maxValue = sampArr[i];
-        }
-        return maxValue;
-    };
-
-    if(m_cVUl.cnt0 == 64) {
-        m_cVUl.cnt0 = 0;
-        m_cVUl.cnt1++;
-    }
-    if(m_cVUl.cnt1 == 8) {
-        m_cVUl.cnt1 = 0;
-        m_cVUl.cnt2++;
-    }
-    if(m_cVUl.cnt2 == 8) {
-        m_cVUl.cnt2 = 0;
-        m_cVUl.cnt3++;
-    }
-    if(m_cVUl.cnt3 == 8) {
-        m_cVUl.cnt3 = 0;
-        m_cVUl.cnt4++;
-        m_cVUl.f_vu = true;
-    }
-    if(m_cVUl.cnt4 == 8) { m_cVUl.cnt4 = 0; }
-
-    if(!m_cVUl.cnt0) { // store every 64th sample in the array[0]
-        m_cVUl.sampleArray[LEFTCHANNEL][0][m_cVUl.cnt1] = abs(sample[LEFTCHANNEL] >> 7);
-        m_cVUl.sampleArray[RIGHTCHANNEL][0][m_cVUl.cnt1] = abs(sample[RIGHTCHANNEL] >> 7);
-    }
-    if(!m_cVUl.cnt1) { // store argest from 64 * 8 samples in the array[1]
-        m_cVUl.sampleArray[LEFTCHANNEL][1][m_cVUl.cnt2] = largest(m_cVUl.sampleArray[LEFTCHANNEL][0]);
-        m_cVUl.sampleArray[RIGHTCHANNEL][1][m_cVUl.cnt2] = largest(m_cVUl.sampleArray[RIGHTCHANNEL][0]);
-    }
-    if(!m_cVUl.cnt2) { // store avg from 64 * 8 * 8 samples in the array[2]
-        m_cVUl.sampleArray[LEFTCHANNEL][2][m_cVUl.cnt3] = largest(m_cVUl.sampleArray[LEFTCHANNEL][1]);
-        m_cVUl.sampleArray[RIGHTCHANNEL][2][m_cVUl.cnt3] = largest(m_cVUl.sampleArray[RIGHTCHANNEL][1]);
-    }
-    if(!m_cVUl.cnt3) { // store avg from 64 * 8 * 8 * 8 samples in the array[3]
-        m_cVUl.sampleArray[LEFTCHANNEL][3][m_cVUl.cnt4] = avg(m_cVUl.sampleArray[LEFTCHANNEL][2]);
-        m_cVUl.sampleArray[RIGHTCHANNEL][3][m_cVUl.cnt4] = avg(m_cVUl.sampleArray[RIGHTCHANNEL][2]);
-    }
-    if(m_cVUl.f_vu) {
-        m_cVUl.f_vu = false;
-        m_vuLeft = avg(m_cVUl.sampleArray[LEFTCHANNEL][3]);
-        m_vuRight = avg(m_cVUl.sampleArray[RIGHTCHANNEL][3]);
-    }
-    m_cVUl.cnt1++;
+int8_t Audio::loadSoundEffect(fs::FS& fs, const char* path) {
+    // short clips (UI clicks, notifications) are decoded once and mixed over the current stream in playChunk(), the
+    // stream is not interrupted. Without a stream they are written to I2S by playSoundEffects(). WAV PCM 8/16 bit
+    // mono or stereo, any sample rate, up to 8 clips.
+    if(!path) return -1;
+    File file = fs.open(path);
+    if(!file || file.isDirectory()) {AUDIO_LOG_ERROR("sound effect \"%s\" not found", path); return -1;}
+    size_t size = file.size();
+    ps_ptr<uint8_t> data;
+    data.alloc(size, "sfx_file");
+    if(!data.valid()) {file.close(); return -1;}
+    size_t bytesRead = file.read(data.get(), size);
+    file.close();
+    int8_t id = m_sfx.addWav(data.get(), bytesRead);
+    if(id < 0) return -1;
+    AUDIO_INFO("sound effect %i: \"%s\", %lu ms", id, path, (long unsigned)m_sfx.durationMs(id));
+    // small DMA buffers while effects are loaded: 16 x 512 frames would delay a click by 170ms behind a stream
+    I2SsetDMA(AUDIO_SFX_DMA_DESC_NUM, AUDIO_SFX_DMA_FRAME_NUM);
+    return id;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool Audio::playSoundEffect(int8_t id, uint8_t volume) {
+    return m_sfx.play(id, volume); // starts with the next samples that are mixed in the audio task
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::stopSoundEffects() {
+    m_sfx.stop();
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::clearSoundEffects() {
+    xSemaphoreTake(mutex_audioTask, portMAX_DELAY); // not while mix() runs
+    m_sfx.clear();
+    xSemaphoreGive(mutex_audioTask);
+    I2SsetDMA(AUDIO_DMA_DESC_NUM, AUDIO_DMA_FRAME_NUM);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::playSoundEffects() {
+    // no stream: the clips are written one DMA buffer at a time, at most two buffers ahead of the DMA. The DMA buffers
+    // stay almost empty (auto_clear sends zeros), a new effect is heard after one DMA buffer (dma_frame_num)
+    if(!m_sfx.isActive() || !m_outBuff.valid() || m_validSamples) return;
+    const uint32_t frames = m_i2s_chan_cfg.dma_frame_num;
+    const uint32_t rate = m_i2s_std_cfg.clk_cfg.sample_rate_hz;
+    int64_t now = esp_timer_get_time();
+    if(m_sfxQueuedUntil > now + (int64_t)2 * frames * 1000000 / rate) return;
+    if(m_sfxQueuedUntil < now) m_sfxQueuedUntil = now;
+    if(xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ) != pdTRUE) return; // I2SsetDMA() replaces the channel
+    memset(m_outBuff.get(), 0, frames * 2 * sizeof(int16_t));
+    m_sfx.mix(m_outBuff.get(), frames, rate);
+    size_t bytesWritten = 0;
+    i2s_channel_write(m_i2s_tx_handle, m_outBuff.get(), frames * 2 * sizeof(int16_t), &bytesWritten, 20);
+    m_sfxQueuedUntil += (int64_t)(bytesWritten / 4) * 1000000 / rate;
+    xSemaphoreGive(mutex_audioTask);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint16_t Audio::getVUlevel() {
     // avg 0 ... 127
     if(!m_f_running) return 0;
-    return (m_vuLeft << 8) + m_vuRight;
+    return m_dsp.getVUlevel();
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::setTone(int8_t gainLowPass, int8_t gainBandPass, int8_t gainHighPass) {
@@ -5783,7 +5610,7 @@ void Audio::setTone(int8_t gainLowPass, int8_t gainBandPass, int8_t gainHighPass
 
     // gain, attenuation (set in digital filters)
     int db = max(m_gain0, max(m_gain1, m_gain2));
-    m_corr = pow10f((float)db / 20);
+    m_dsp.setLevelCorrection(pow10f((float)db / 20));
 
     IIR_calculateCoefficients(m_gain0, m_gain1, m_gain2);
 
@@ -5792,14 +5619,14 @@ void Audio::setTone(int8_t gainLowPass, int8_t gainBandPass, int8_t gainHighPass
           Because when the EQ is adjusted, the IIR filter will be cleared and played,
           mixed in the audio data frame, and a click-like sound will be produced.
 
-          int16_t tmp[2]; tmp[0] = 0; tmp[1]= 0;
-
-          IIR_filterChain0(tmp, true ); // flush the filter
-          IIR_filterChain1(tmp, true ); // flush the filter
-          IIR_filterChain2(tmp, true ); // flush the filter
+          m_dsp.clearFilters(); // flush the filter
         */
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::setToneFixedPoint(bool fixedPoint) {
+    m_dsp.setFixedPoint(fixedPoint); // Q28 biquads, no float in the sample loop
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::forceMono(bool m) { // #100 mono option
     m_f_forceMono = m;          // false stereo, true mono
 }
@@ -5848,16 +5675,11 @@ void Audio::computeLimit() {    // is calculated when the volume or balance chan
 
     m_limit_left = l * v;
     m_limit_right = r * v;
+    m_dsp.setGain(m_limit_left, m_limit_right);
 
     // AUDIO_LOG_INFO("m_limit_left %f,  m_limit_right %f ",m_limit_left, m_limit_right);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void Audio::Gain(int16_t* sample) {
-    /* important: these multiplications must all be signed ints, or the result will be invalid */
-    sample[LEFTCHANNEL]  *= m_limit_left ;
-    sample[RIGHTCHANNEL] *= m_limit_right;
-}
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint32_t Audio::inBufferFilled() {
     // current audio input buffer fillsize in bytes
     return InBuff.bufferFilled();
@@ -5868,6 +5690,25 @@ uint32_t Audio::inBufferFree() {
     return InBuff.freeSpace();
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint32_t Audio::inBufferUnderruns() {
+    // times the audio task found less than one frame in the input buffer since the stream started
+    return m_inBuffUnderruns;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint32_t Audio::i2sUnderruns() {
+    // DMA buffers sent without new samples since the stream started, each one is an audible gap
+    return m_i2sUnderruns;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::getStats(audio_stats_t& stats) {
+    // a copy of the statistics since the stream started, may be called from any task (e.g. to publish them per MQTT)
+    m_stats.snapshot(stats, millis());
+    stats.inBuffSize = InBuff.getBufsize();
+    stats.inBuffFilled = InBuff.bufferFilled();
+    stats.inBuffUnderruns = m_inBuffUnderruns;
+    stats.i2sUnderruns = m_i2sUnderruns;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint32_t Audio::getInBufferSize() {
     // current audio input buffer size in bytes
     return InBuff.getBufsize();
@@ -5894,235 +5735,18 @@ void Audio::IIR_calculateCoefficients(int8_t G0, int8_t G1, int8_t G2) { // Infi
     // G3 - gain high shelf  set between -40 ... +6 dB
     // https://www.earlevel.com/main/2012/11/26/biquad-c-source-code/
 
-    if(getSampleRate() < 1000) return; // fuse
-
-    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-    if(G0 < -40) G0 = -40; // -40dB -> Vin*0.01
-    if(G0 > 6) G0 = 6;     // +6dB -> Vin*2
-    if(G1 < -40) G1 = -40;
-    if(G1 > 6) G1 = 6;
-    if(G2 < -40) G2 = -40;
-    if(G2 > 6) G2 = 6;
-
-    const float FcLS = 500;    // Frequency LowShelf[Hz]
-    const float FcPKEQ = 3000; // Frequency PeakEQ[Hz]
-    float       FcHS = 6000;   // Frequency HighShelf[Hz]
-
-    if(getSampleRate() < FcHS * 2 - 100) { // Prevent HighShelf filter from clogging
-        FcHS = getSampleRate() / 2 - 100;
-        // according to the sampling theorem, the sample rate must be at least 2 * 6000 >= 12000Hz for a filter
-        // frequency of 6000Hz. If this is not the case, the filter frequency (plus a reserve of 100Hz) is lowered
-        AUDIO_INFO("Highshelf frequency lowered, from 6000Hz to %luHz", (long unsigned int)FcHS);
-    }
-    float K, norm, Q, Fc, V;
-
-    // LOWSHELF
-    Fc = (float)FcLS / (float)getSampleRate(); // Cutoff frequency
-    K = tanf((float)PI * Fc);
-    V = powf(10, fabs(G0) / 20.0);
-
-    if(G0 >= 0) { // boost
-        norm = 1 / (1 + sqrtf(2) * K + K * K);
-        m_filter[LOWSHELF].a0 = (1 + sqrtf(2 * V) * K + V * K * K) * norm;
-        m_filter[LOWSHELF].a1 = 2 * (V * K * K - 1) * norm;
-        m_filter[LOWSHELF].a2 = (1 - sqrtf(2 * V) * K + V * K * K) * norm;
-        m_filter[LOWSHELF].b1 = 2 * (K * K - 1) * norm;
-        m_filter[LOWSHELF].b2 = (1 - sqrtf(2) * K + K * K) * norm;
-    }
-    else { // cut
-        norm = 1 / (1 + sqrtf(2 * V) * K + V * K * K);
-        m_filter[LOWSHELF].a0 = (1 + sqrtf(2) * K + K * K) * norm;
-        m_filter[LOWSHELF].a1 = 2 * (K * K - 1) * norm;
-        m_filter[LOWSHELF].a2 = (1 - sqrtf(2) * K + K * K) * norm;
-        m_filter[LOWSHELF].b1 = 2 * (V * K * K - 1) * norm;
-        m_filter[LOWSHELF].b2 = (1 - sqrtf(2 * V) * K + V * K * K) * norm;
-    }
-
-    // PEAK EQ
-    Fc = (float)FcPKEQ / (float)getSampleRate(); // Cutoff frequency
-    K = tanf((float)PI * Fc);
-    V = powf(10, fabs(G1) / 20.0);
-    Q = 2.5;      // Quality factor
-    if(G1 >= 0) { // boost
-        norm = 1 / (1 + 1 / Q * K + K * K);
-        m_filter[PEAKEQ].a0 = (1 + V / Q * K + K * K) * norm;
-        m_filter[PEAKEQ].a1 = 2 * (K * K - 1) * norm;
-        m_filter[PEAKEQ].a2 = (1 - V / Q * K + K * K) * norm;
-        m_filter[PEAKEQ].b1 = m_filter[PEAKEQ].a1;
-        m_filter[PEAKEQ].b2 = (1 - 1 / Q * K + K * K) * norm;
-    }
-    else { // cut
-        norm = 1 / (1 + V / Q * K + K * K);
-        m_filter[PEAKEQ].a0 = (1 + 1 / Q * K + K * K) * norm;
-        m_filter[PEAKEQ].a1 = 2 * (K * K - 1) * norm;
-        m_filter[PEAKEQ].a2 = (1 - 1 / Q * K + K * K) * norm;
-        m_filter[PEAKEQ].b1 = m_filter[PEAKEQ].a1;
-        m_filter[PEAKEQ].b2 = (1 - V / Q * K + K * K) * norm;
-    }
-
-    // HIGHSHELF
-    Fc = (float)FcHS / (float)getSampleRate(); // Cutoff frequency
-    K = tanf((float)PI * Fc);
-    V = powf(10, fabs(G2) / 20.0);
-    if(G2 >= 0) { // boost
-        norm = 1 / (1 + sqrtf(2) * K + K * K);
-        m_filter[HIFGSHELF].a0 = (V + sqrtf(2 * V) * K + K * K) * norm;
-        m_filter[HIFGSHELF].a1 = 2 * (K * K - V) * norm;
-        m_filter[HIFGSHELF].a2 = (V - sqrtf(2 * V) * K + K * K) * norm;
-        m_filter[HIFGSHELF].b1 = 2 * (K * K - 1) * norm;
-        m_filter[HIFGSHELF].b2 = (1 - sqrtf(2) * K + K * K) * norm;
+    AudioDSP::biquad_t filter[AudioDSP::NUM_FILTERS];
+    if(!AudioDSP::calculateTone(G0, G1, G2, getSampleRate(), filter)) return; // fuse
+    if(AudioDSP::highShelfFrequency(getSampleRate()) < 6000) {
+        AUDIO_INFO("Highshelf frequency lowered, from 6000Hz to %luHz", (long unsigned int)AudioDSP::highShelfFrequency(getSampleRate()));
     }
-    else {
-        norm = 1 / (V + sqrtf(2 * V) * K + K * K);
-        m_filter[HIFGSHELF].a0 = (1 + sqrtf(2) * K + K * K) * norm;
-        m_filter[HIFGSHELF].a1 = 2 * (K * K - 1) * norm;
-        m_filter[HIFGSHELF].a2 = (1 - sqrtf(2) * K + K * K) * norm;
-        m_filter[HIFGSHELF].b1 = 2 * (K * K - V) * norm;
-        m_filter[HIFGSHELF].b2 = (V - sqrtf(2 * V) * K + K * K) * norm;
-    }
-
-    //    AUDIO_LOG_INFO("LS a0=%f, a1=%f, a2=%f, b1=%f, b2=%f", m_filter[0].a0, m_filter[0].a1, m_filter[0].a2,
-    //                                                  m_filter[0].b1, m_filter[0].b2);
-    //    AUDIO_LOG_INFO("EQ a0=%f, a1=%f, a2=%f, b1=%f, b2=%f", m_filter[1].a0, m_filter[1].a1, m_filter[1].a2,
-    //                                                  m_filter[1].b1, m_filter[1].b2);
-    //    AUDIO_LOG_INFO("HS a0=%f, a1=%f, a2=%f, b1=%f, b2=%f", m_filter[2].a0, m_filter[2].a1, m_filter[2].a2,
-    //                                                  m_filter[2].b1, m_filter[2].b2);
-}
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-// clang-format off
-void Audio::IIR_filterChain0(int16_t iir_in[2], bool clear) { // Infinite Impulse Response (IIR) filters
-
-    uint8_t z1 = 0, z2 = 1;
-    enum : uint8_t { in = 0, out = 1 };
-
-    if(clear) {
-        memset(m_filterBuff, 0, sizeof(m_filterBuff)); // zero IIR filterbuffer
-        m_ifCh.iir_out0[0] = 0;
-        m_ifCh.iir_out0[1] = 0;
-        iir_in[0] = 0;
-        iir_in[1] = 0;
-    }
-
-    m_ifCh.inSample0[LEFTCHANNEL] = (float)(iir_in[LEFTCHANNEL]);
-    m_ifCh.inSample0[RIGHTCHANNEL] = (float)(iir_in[RIGHTCHANNEL]);
-
-    m_ifCh.outSample0[LEFTCHANNEL] =
-        m_filter[0].a0 * m_ifCh.inSample0[LEFTCHANNEL] + m_filter[0].a1 * m_filterBuff[0][z1][in][LEFTCHANNEL] +
-        m_filter[0].a2 * m_filterBuff[0][z2][in][LEFTCHANNEL] - m_filter[0].b1 * m_filterBuff[0][z1][out][LEFTCHANNEL] -
-        m_filter[0].b2 * m_filterBuff[0][z2][out][LEFTCHANNEL];
-
-    m_filterBuff[0][z2][in][LEFTCHANNEL] = m_filterBuff[0][z1][in][LEFTCHANNEL];
-    m_filterBuff[0][z1][in][LEFTCHANNEL] = m_ifCh.inSample0[LEFTCHANNEL];
-    m_filterBuff[0][z2][out][LEFTCHANNEL] = m_filterBuff[0][z1][out][LEFTCHANNEL];
-    m_filterBuff[0][z1][out][LEFTCHANNEL] = m_ifCh.outSample0[LEFTCHANNEL];
-    m_ifCh.iir_out0[LEFTCHANNEL] = (int16_t)m_ifCh.outSample0[LEFTCHANNEL];
-
-    m_ifCh.outSample0[RIGHTCHANNEL] = m_filter[0].a0 * m_ifCh.inSample0[RIGHTCHANNEL] +
-                              m_filter[0].a1 * m_filterBuff[0][z1][in][RIGHTCHANNEL] +
-                              m_filter[0].a2 * m_filterBuff[0][z2][in][RIGHTCHANNEL] -
-                              m_filter[0].b1 * m_filterBuff[0][z1][out][RIGHTCHANNEL] -
-                              m_filter[0].b2 * m_filterBuff[0][z2][out][RIGHTCHANNEL];
-
-    m_filterBuff[0][z2][in][RIGHTCHANNEL] = m_filterBuff[0][z1][in][RIGHTCHANNEL];
-    m_filterBuff[0][z1][in][RIGHTCHANNEL] = m_ifCh.inSample0[RIGHTCHANNEL];
-    m_filterBuff[0][z2][out][RIGHTCHANNEL] = m_filterBuff[0][z1][out][RIGHTCHANNEL];
-    m_filterBuff[0][z1][out][RIGHTCHANNEL] = m_ifCh.outSample0[RIGHTCHANNEL];
-    m_ifCh.iir_out0[RIGHTCHANNEL] = (int16_t)m_ifCh.outSample0[RIGHTCHANNEL];
-
-    iir_in[LEFTCHANNEL] = m_ifCh.iir_out0[LEFTCHANNEL];
-    iir_in[RIGHTCHANNEL] = m_ifCh.iir_out0[RIGHTCHANNEL];
-    return;
-}
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void Audio::IIR_filterChain1(int16_t iir_in[2], bool clear) { // Infinite Impulse Response (IIR) filters
-
-    uint8_t z1 = 0, z2 = 1;
-    enum : uint8_t { in = 0, out = 1 };
-
-    if(clear) {
-        memset(m_filterBuff, 0, sizeof(m_filterBuff)); // zero IIR filterbuffer
-        m_ifCh.iir_out1[0] = 0;
-        m_ifCh.iir_out1[1] = 0;
-        iir_in[0] = 0;
-        iir_in[1] = 0;
-    }
-
-    m_ifCh.inSample1[LEFTCHANNEL] = (float)(iir_in[LEFTCHANNEL]);
-    m_ifCh.inSample1[RIGHTCHANNEL] = (float)(iir_in[RIGHTCHANNEL]);
-
-    m_ifCh.outSample1[LEFTCHANNEL] =
-        m_filter[1].a0 * m_ifCh.inSample1[LEFTCHANNEL] + m_filter[1].a1 * m_filterBuff[1][z1][in][LEFTCHANNEL] +
-        m_filter[1].a2 * m_filterBuff[1][z2][in][LEFTCHANNEL] - m_filter[1].b1 * m_filterBuff[1][z1][out][LEFTCHANNEL] -
-        m_filter[1].b2 * m_filterBuff[1][z2][out][LEFTCHANNEL];
-
-    m_filterBuff[1][z2][in][LEFTCHANNEL] = m_filterBuff[1][z1][in][LEFTCHANNEL];
-    m_filterBuff[1][z1][in][LEFTCHANNEL] = m_ifCh.inSample1[LEFTCHANNEL];
-    m_filterBuff[1][z2][out][LEFTCHANNEL] = m_filterBuff[1][z1][out][LEFTCHANNEL];
-    m_filterBuff[1][z1][out][LEFTCHANNEL] = m_ifCh.outSample1[LEFTCHANNEL];
-    m_ifCh.iir_out1[LEFTCHANNEL] = (int16_t)m_ifCh.outSample1[LEFTCHANNEL];
-
-    m_ifCh.outSample1[RIGHTCHANNEL] = m_filter[1].a0 * m_ifCh.inSample1[RIGHTCHANNEL] +
-                              m_filter[1].a1 * m_filterBuff[1][z1][in][RIGHTCHANNEL] +
-                              m_filter[1].a2 * m_filterBuff[1][z2][in][RIGHTCHANNEL] -
-                              m_filter[1].b1 * m_filterBuff[1][z1][out][RIGHTCHANNEL] -
-                              m_filter[1].b2 * m_filterBuff[1][z2][out][RIGHTCHANNEL];
-
-    m_filterBuff[1][z2][in][RIGHTCHANNEL] = m_filterBuff[1][z1][in][RIGHTCHANNEL];
-    m_filterBuff[1][z1][in][RIGHTCHANNEL] = m_ifCh.inSample1[RIGHTCHANNEL];
-    m_filterBuff[1][z2][out][RIGHTCHANNEL] = m_filterBuff[1][z1][out][RIGHTCHANNEL];
-    m_filterBuff[1][z1][out][RIGHTCHANNEL] = m_ifCh.outSample1[RIGHTCHANNEL];
-    m_ifCh.iir_out1[RIGHTCHANNEL] = (int16_t)m_ifCh.outSample1[RIGHTCHANNEL];
-
-    iir_in[LEFTCHANNEL] = m_ifCh.iir_out1[LEFTCHANNEL];
-    iir_in[RIGHTCHANNEL] = m_ifCh.iir_out1[RIGHTCHANNEL];
-    return;
+    m_dsp.setFilters(filter); // filters with 0 dB are bypassed
+
+    //    AUDIO_LOG_INFO("LS a0=%f, a1=%f, a2=%f, b1=%f, b2=%f", filter[0].a0, filter[0].a1, filter[0].a2, filter[0].b1, filter[0].b2);
+    //    AUDIO_LOG_INFO("EQ a0=%f, a1=%f, a2=%f, b1=%f, b2=%f", filter[1].a0, filter[1].a1, filter[1].a2, filter[1].b1, filter[1].b2);
+    //    AUDIO_LOG_INFO("HS a0=%f, a1=%f, a2=%f, b1=%f, b2=%f", filter[2].a0, filter[2].a1, filter[2].a2, filter[2].b1, filter[2].b2);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void Audio::IIR_filterChain2(int16_t iir_in[2], bool clear) { // Infinite Impulse Response (IIR) filters
-
-    uint8_t z1 = 0, z2 = 1;
-    enum : uint8_t { in = 0, out = 1 };
-
-    if(clear) {
-        memset(m_filterBuff, 0, sizeof(m_filterBuff)); // zero IIR filterbuffer
-        m_ifCh.iir_out2[0] = 0;
-        m_ifCh.iir_out2[1] = 0;
-        iir_in[0] = 0;
-        iir_in[1] = 0;
-    }
-
-    m_ifCh.inSample2[LEFTCHANNEL] = (float)(iir_in[LEFTCHANNEL]);
-    m_ifCh.inSample2[RIGHTCHANNEL] = (float)(iir_in[RIGHTCHANNEL]);
-
-    m_ifCh.outSample2[LEFTCHANNEL] =
-        m_filter[2].a0 * m_ifCh.inSample2[LEFTCHANNEL] + m_filter[2].a1 * m_filterBuff[2][z1][in][LEFTCHANNEL] +
-        m_filter[2].a2 * m_filterBuff[2][z2][in][LEFTCHANNEL] - m_filter[2].b1 * m_filterBuff[2][z1][out][LEFTCHANNEL] -
-        m_filter[2].b2 * m_filterBuff[2][z2][out][LEFTCHANNEL];
-
-    m_filterBuff[2][z2][in][LEFTCHANNEL] = m_filterBuff[2][z1][in][LEFTCHANNEL];
-    m_filterBuff[2][z1][in][LEFTCHANNEL] = m_ifCh.inSample2[LEFTCHANNEL];
-    m_filterBuff[2][z2][out][LEFTCHANNEL] = m_filterBuff[2][z1][out][LEFTCHANNEL];
-    m_filterBuff[2][z1][out][LEFTCHANNEL] = m_ifCh.outSample2[LEFTCHANNEL];
-    m_ifCh.iir_out2[LEFTCHANNEL] = (int16_t)m_ifCh.outSample2[LEFTCHANNEL];
-
-    m_ifCh.outSample2[RIGHTCHANNEL] = m_filter[2].a0 * m_ifCh.inSample2[RIGHTCHANNEL] +
-                              m_filter[2].a1 * m_filterBuff[2][z1][in][RIGHTCHANNEL] +
-                              m_filter[2].a2 * m_filterBuff[2][z2][in][RIGHTCHANNEL] -
-                              m_filter[2].b1 * m_filterBuff[2][z1][out][RIGHTCHANNEL] -
-                              m_filter[2].b2 * m_filterBuff[2][z2][out][RIGHTCHANNEL];
-
-    m_filterBuff[2][z2][in][RIGHTCHANNEL] = m_filterBuff[2][z1][in][RIGHTCHANNEL];
-    m_filterBuff[2][z1][in][RIGHTCHANNEL] = m_ifCh.inSample2[RIGHTCHANNEL];
-    m_filterBuff[2][z2][out][RIGHTCHANNEL] = m_filterBuff[2][z1][out][RIGHTCHANNEL];
-    m_filterBuff[2][z1][out][RIGHTCHANNEL] = m_ifCh.outSample2[RIGHTCHANNEL];
-    m_ifCh.iir_out2[RIGHTCHANNEL] = (int16_t)m_ifCh.outSample2[RIGHTCHANNEL];
-
-    iir_in[LEFTCHANNEL] = m_ifCh.iir_out2[LEFTCHANNEL];
-    iir_in[RIGHTCHANNEL] = m_ifCh.iir_out2[RIGHTCHANNEL];
-    return;
-}
-// clang-format on
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 //    AAC - T R A N S P O R T S T R E A M
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -6509,6 +6133,16 @@ int32_t Audio::newInBuffStart(int32_t m_resumeFilePos){
         uint16_t remaining = 0;
         int32_t  offset = 0, buffFillSize = 0, res = 0;
         uint32_t timeOut = 0;
+        bool     exact = false; // the seek index found the start of the frame
+
+        if(m_resumeTimeMs >= 0){
+            uint32_t pos = 0, landedMs = 0;
+            if(m_seekIndex.seek(m_resumeTimeMs, &pos, &landedMs, &exact)){
+                m_resumeFilePos = pos;
+                m_seekLandedMs = exact ? landedMs : -1;
+            }
+            m_resumeTimeMs = -1;
+        }
 
         if(m_controlCounter != 100){AUDIO_LOG_WARN("timeOffset not possible"); m_resumeFilePos = -1; offset = -1; goto exit;}
         if(m_resumeFilePos >= (int32_t)m_audioDataStart + m_audioDataSize) {   m_resumeFilePos = -1; offset = -1; goto exit;}
@@ -6522,7 +6156,7 @@ int32_t Audio::newInBuffStart(int32_t m_resumeFilePos){
             m_f_allDataReceived = false;
 
 /* process before */
-            if(m_codec == CODEC_M4A) m_resumeFilePos += m4a_correctResumeFilePos(); {if(m_resumeFilePos == -1) goto exit;}
+            if(m_codec == CODEC_M4A && !exact) m_resumeFilePos += m4a_correctResumeFilePos(); {if(m_resumeFilePos == -1) goto exit;}
 
 /* skip to position */
             res = audioFileSeek(m_resumeFilePos);
@@ -6544,10 +6178,10 @@ int32_t Audio::newInBuffStart(int32_t m_resumeFilePos){
             offset = 0;
             if(m_codec == CODEC_OPUS || m_codec == CODEC_VORBIS) {if(InBuff.bufferFilled() < 0xFFFF) return - 1;} // ogg frame <= 64kB
             if(m_codec == CODEC_WAV)   {while((m_resumeFilePos % 4) != 0){m_resumeFilePos++; offset++; if(m_resumeFilePos >= m_audioFileSize) goto exit;}}  // must divisible by four
-            if(m_codec == CODEC_MP3)   {offset = mp3_correctResumeFilePos();  if(offset == -1) goto exit; MP3Decoder_ClearBuffer();}
-            if(m_codec == CODEC_FLAC)  {offset = flac_correctResumeFilePos(); if(offset == -1) goto exit; FLACDecoderReset();}
-            if(m_codec == CODEC_VORBIS){offset = ogg_correctResumeFilePos();  if(offset == -1) goto exit; VORBISDecoder_ClearBuffers();}
-            if(m_codec == CODEC_OPUS)  {offset = ogg_correctResumeFilePos();  if(offset == -1) goto exit; OPUSDecoder_ClearBuffers();}
+            if(m_codec == CODEC_MP3)   {offset = exact ? 0 : mp3_correctResumeFilePos();  if(offset == -1) goto exit; m_mp3Decoder->clearBuffers();}
+            if(m_codec == CODEC_FLAC)  {offset = exact ? 0 : flac_correctResumeFilePos(); if(offset == -1) goto exit; m_flacDecoder->reset();}
+            if(m_codec == CODEC_VORBIS){offset = exact ? 0 : ogg_correctResumeFilePos();  if(offset == -1) goto exit; m_vorbisDecoder->clearBuffers();}
+            if(m_codec == CODEC_OPUS)  {offset = exact ? 0 : ogg_correctResumeFilePos();  if(offset == -1) goto exit; m_opusDecoder->clearBuffers();}
 
 
             InBuff.bytesWasRead(offset);
@@ -6710,7 +6344,7 @@ int32_t Audio::mp3_correctResumeFilePos() {
     if(av < InBuff.getMaxBlockSize()) return -1; // guard
 
     while(true) {
-        steps = MP3FindSyncWord(pos, av);
+        steps = m_mp3Decoder->findSyncWord(pos, av);
         if(steps == 0)break;
         if(steps == -1) return -1;
         pos += steps;
@@ -6720,6 +6354,38 @@ int32_t Audio::mp3_correctResumeFilePos() {
     return sumSteps; // return the position of the first byte of the frame
 }
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int32_t Audio::seekIndexRead(void* user, uint32_t pos, uint8_t* buf, uint32_t len) {
+    // reader of the seek index, leaves the file at the position the InBuffer is filled from
+    Audio* self = (Audio*)user;
+    if(!self->m_audiofile) return -1;
+    uint32_t actualPos = self->m_audiofile.position();
+    if(!self->m_audiofile.seek(pos)) return -1;
+    int32_t res = self->m_audiofile.read(buf, len);
+    self->m_audiofile.seek(actualPos);
+    return res;
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::initSeekIndex() {
+    // called once the header is read, MP3 and M4A are indexed in processLocalFile() while the InBuffer is full
+    m_seekIndex.reset();
+    if(m_dataMode != AUDIO_LOCALFILE) return;
+    bool res = false;
+    uint32_t dataEnd = m_audioDataStart + m_audioDataSize;
+    if(dataEnd > m_audioFileSize) dataEnd = m_audioFileSize;
+    switch(m_codec) {
+        case CODEC_MP3:    res = m_seekIndex.beginMP3(m_audioDataStart, dataEnd); break;
+        case CODEC_FLAC:   if(!m_f_ogg) res = m_seekIndex.beginFLAC(m_audioDataStart, m_audioFileSize, m_flacSampleRate, m_flacTotalSamplesInStream,
+                                                                    m_flacSeekTablePos, m_flacSeekTableLen);
+                           break;
+        case CODEC_M4A:    res = m_seekIndex.beginM4A(m_m4aHdr.mdhd_pos, m_m4aHdr.stts_pos, m_m4aHdr.stsc_pos, m_m4aHdr.stco_pos, m_m4aHdr.stsz_pos); break;
+        case CODEC_OPUS:
+        case CODEC_VORBIS: res = m_seekIndex.beginOGG(0, m_audioFileSize); break;
+        default: return;
+    }
+    if(!res) {m_seekIndex.reset(); AUDIO_LOG_DEBUG("no seek index, positions are estimated from the bitrate"); return;}
+    AUDIO_LOG_DEBUG("seek index: duration %lu ms, %s", (long unsigned int)m_seekIndex.durationMs(), m_seekIndex.isComplete() ? "complete" : "built while playing");
+}
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint8_t Audio::determineOggCodec(uint8_t* data, uint16_t len) {
     // if we have contentType == application/ogg; codec cn be OPUS, FLAC or VORBIS
     // let's have a look, what it is
@@ -6799,15 +6465,79 @@ void Audio::audioTask() {
 }
 
 void Audio::performAudioTask() {
-    if(!m_f_running) return;
-    if(!m_f_stream) return;
-    if(m_codec == CODEC_NONE) return; // wait for codec is  set
+    if(m_stats.applyReset()) m_inBuffUnderruns = 0; // a new stream, see setDefaults()
+    if(!m_f_running) {playSoundEffects(); return;}
+    if(!m_f_stream) {playSoundEffects(); return;}
+    if(m_codec == CODEC_NONE) {playSoundEffects(); return;} // wait for codec is  set
     if(m_codec == CODEC_OGG)  return; // wait for FLAC, VORBIS or OPUS
-    xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ);
+    if(xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ) != pdTRUE) return; // I2SsetDMA() replaces the channel
     while(m_validSamples) {vTaskDelay(20 / portTICK_PERIOD_MS); playChunk();} // I2S buffer full
     playAudioData();
     xSemaphoreGive(mutex_audioTask);
 }
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Optional second task that does the work of 'loop()': connect, read the stream or the file into the InBuffer. On a dual core
+// ESP32 it runs on the other core than the audio task, so that a slow TLS read can not hold up the decoder and vice versa.
+// The InBuffer is a lock-free ring with one writer (this task) and one reader (the audio task). The connect functions and
+// stopSong() take mutex_playAudioData, the fetch task holds it while it works, so they never run at the same time. They wait
+// without a timeout: the fetch task gives it back after each read and the audio task never takes it.
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void Audio::setFetchTaskCore(int8_t coreID){  // the other core than the audio task, -1 stops the task, loop() does the work again
+    if(coreID > 1) return;
+    stopFetchTask();
+    if(coreID < 0) return;
+    m_fetchTaskCoreId = coreID;
+    startFetchTask();
+}
+
+void Audio::startFetchTask() {
+    if(m_f_fetchTaskIsRunning) {
+        AUDIO_LOG_INFO("fetch task is already running.");
+        return;
+    }
+    BaseType_t res = xTaskCreatePinnedToCore(
+        &Audio::fetchTaskWrapper, /* Function to implement the task */
+        "FetchTask",              /* Name of the task */
+        AUDIO_FETCH_STACK_SIZE,   /* Stack size in words */
+        this,                     /* Task input parameter */
+        2,                        /* Priority of the task */
+        &m_fetchTaskHandle,       /* Task handle */
+        m_fetchTaskCoreId         /* Core where the task should run */
+    );
+    if(res != pdPASS) {AUDIO_LOG_ERROR("fetch task could not be created, loop() goes on"); m_fetchTaskHandle = nullptr; return;}
+    m_f_fetchTaskIsRunning = true;
+}
+
+void Audio::stopFetchTask() {
+    if(m_fetchTaskHandle == nullptr) return;
+    xSemaphoreTakeRecursive(mutex_playAudioData, portMAX_DELAY); // not in the middle of a read
+    vTaskDelete(m_fetchTaskHandle);
+    m_fetchTaskHandle = nullptr;
+    m_f_fetchTaskIsRunning = false;
+    xSemaphoreGiveRecursive(mutex_playAudioData);
+}
+
+void Audio::fetchTaskWrapper(void *param) {
+    Audio *runner = static_cast<Audio*>(param);
+    runner->fetchTask();
+}
+
+void Audio::fetchTask() {
+    while(true) {
+        xSemaphoreTakeRecursive(mutex_playAudioData, portMAX_DELAY);
+        fetchAudioData();
+        xSemaphoreGiveRecursive(mutex_playAudioData);
+        vTaskDelay(1); // let the user task in to connect or stop
+    }
+}
+
+bool IRAM_ATTR Audio::i2sSendQueueOverflow(i2s_chan_handle_t handle, i2s_event_data_t* event, void* user_ctx) { // I2S ISR
+    Audio *self = static_cast<Audio*>(user_ctx);
+    if(self->m_f_running && self->m_f_stream && !self->m_f_firstPlayCall && !self->m_f_eof) self->m_i2sUnderruns++;
+    return false; // no high priority task woken
+}
+
 uint32_t Audio::getHighWatermark(){
     UBaseType_t highWaterMark = uxTaskGetStackHighWaterMark(m_audioTaskHandle);
     return highWaterMark; // dwords
@@ -30,7 +30,14 @@
 #include <NetworkClient.h>
 #include <NetworkClientSecure.h>
 #include <driver/i2s_std.h>
+#include <esp_timer.h>
 #include "psram_unique_ptr.hpp"
+#include "audio_dsp/audio_dsp.h"
+#include "audio_dsp/resampler.h"
+#include "audio_dsp/sound_effects.h"
+#include "audio_buffer/audio_buffer.h"
+#include "audio_seek/seek_index.h"
+#include "audio_stats/audio_stats.h"
 
 #ifndef I2S_GPIO_UNUSED
   #define I2S_GPIO_UNUSED -1 // = I2S_PIN_NO_CHANGE in IDF < 5
@@ -54,73 +61,20 @@ extern __attribute__((weak)) void audio_eof_speech(const char*);
 extern __attribute__((weak)) void audio_eof_stream(const char*); // The webstream comes to an end
 extern __attribute__((weak)) void audio_process_i2s(int16_t* outBuff, int32_t validSamples, bool *continueI2S); // record audiodata or send via BT
 
-//----------------------------------------------------------------------------------------------------------------------
+class MP3Decoder;
+class AACDecoder;
+class FLACDecoder;
+class OPUSDecoder;
+class VORBISDecoder;
 
-class AudioBuffer {
-// AudioBuffer will be allocated in PSRAM, If PSRAM not available or has not enough space AudioBuffer will be
-// allocated in FlashRAM with reduced size
-//
-//  m_buffer            m_readPtr                 m_writePtr                 m_endPtr
-//   |                       |<------dataLength------->|<------ writeSpace ----->|
-//   ▼                       ▼                         ▼                         ▼
-//   ---------------------------------------------------------------------------------------------------------------
-//   |                     <--m_buffSize-->                                      |      <--m_resBuffSize -->     |
-//   ---------------------------------------------------------------------------------------------------------------
-//   |<-----freeSpace------->|                         |<------freeSpace-------->|
-//
-//
-//
-//   if the space between m_readPtr and buffend < m_resBuffSize copy data from the beginning to resBuff
-//   so that the mp3/aac/flac frame is always completed
-//
-//  m_buffer                      m_writePtr                 m_readPtr        m_endPtr
-//   |                                 |<-------writeSpace------>|<--dataLength-->|
-//   ▼                                 ▼                         ▼                ▼
-//   ---------------------------------------------------------------------------------------------------------------
-//   |                        <--m_buffSize-->                                    |      <--m_resBuffSize -->     |
-//   ---------------------------------------------------------------------------------------------------------------
-//   |<---  ------dataLength--  ------>|<-------freeSpace------->|
-//
-//
-
-public:
-    AudioBuffer(size_t maxBlockSize = 0);       // constructor
-    ~AudioBuffer();                             // frees the buffer
-    size_t   init();                            // set default values
-    bool     isInitialized() { return m_f_init; };
-    int32_t  getBufsize();
-    bool     setBufsize(size_t mbs);            // default is m_buffSizePSRAM for psram, and m_buffSizeRAM without psram
-    void     changeMaxBlockSize(uint16_t mbs);  // is default 1600 for mp3 and aac, set 16384 for FLAC
-    uint16_t getMaxBlockSize();                 // returns maxBlockSize
-    size_t   freeSpace();                       // number of free bytes to overwrite
-    size_t   writeSpace();                      // space fom writepointer to bufferend
-    size_t   bufferFilled();                    // returns the number of filled bytes
-    size_t   getMaxAvailableBytes();            // max readable bytes in one block
-    void     bytesWritten(size_t bw);           // update writepointer
-    void     bytesWasRead(size_t br);           // update readpointer
-    uint8_t* getWritePtr();                     // returns the current writepointer
-    uint8_t* getReadPtr();                      // returns the current readpointer
-    uint32_t getWritePos();                     // write position relative to the beginning
-    uint32_t getReadPos();                      // read position relative to the beginning
-    void     resetBuffer();                     // restore defaults
-
-protected:
-    size_t            m_buffSize         = UINT16_MAX * 10;   // most webstreams limit the advance to 100...300Kbytes
-    size_t            m_freeSpace        = 0;
-    size_t            m_writeSpace       = 0;
-    size_t            m_dataLength       = 0;
-    size_t            m_resBuffSize      = 4096 * 6; // reserved buffspace, >= one flac frame
-    size_t            m_maxBlockSize     = 1600;
-    uint8_t*          m_buffer           = NULL;
-    uint8_t*          m_writePtr         = NULL;
-    uint8_t*          m_readPtr          = NULL;
-    uint8_t*          m_endPtr           = NULL;
-    bool              m_f_init           = false;
-    bool              m_f_isEmpty        = true;
-};
 //----------------------------------------------------------------------------------------------------------------------
 
 static const size_t AUDIO_STACK_SIZE = 3300;
+static const size_t AUDIO_FETCH_STACK_SIZE = 8192; // TLS reads need more than the audio task
+static const uint32_t AUDIO_DMA_DESC_NUM = 16;      // I2S DMA buffers, 16 x 512 frames: 170ms at 48kHz
+static const uint32_t AUDIO_DMA_FRAME_NUM = 512;
+static const uint32_t AUDIO_SFX_DMA_DESC_NUM = 4;   // while sound effects are loaded, 4 x 96 frames: 8ms (host/sfx_bench)
+static const uint32_t AUDIO_SFX_DMA_FRAME_NUM = 96;
 static StaticTask_t __attribute__((unused)) xAudioTaskBuffer;
 static StackType_t  __attribute__((unused)) xAudioStack[AUDIO_STACK_SIZE];
 extern char audioI2SVers[];
@@ -216,6 +170,11 @@ private:
         uint8_t     aac_profile;
         uint32_t    stsz_num_entries;
         uint32_t    stsz_table_pos;
+        uint32_t    mdhd_pos;    // atom positions for the seek index
+        uint32_t    stts_pos;
+        uint32_t    stsc_pos;
+        uint32_t    stco_pos;    // stco or co64
+        uint32_t    stsz_pos;
         bool        progressive; // Progressive (moov before mdat)
         bool        version_flags;
     } m4aHdr_t;
@@ -225,9 +184,8 @@ private:
         int32_t     validSamples;
         int32_t     samples48K = 0;
         uint32_t    count = 0;
+        uint32_t    mixed = 0;      // frames from count on that have the sound effects
         size_t      i2s_bytesConsumed;
-        int16_t*    sample[2];
-        int16_t*    s2;
         int         sampleSize;
         esp_err_t   err;
         int         i;
@@ -272,26 +230,6 @@ private:
     } cat_t;
     cat_t m_cat;
 
-    typedef struct _cVUl{ // used in computeVUlevel
-        uint8_t sampleArray[2][4][8] = {0};
-        uint8_t cnt0 = 0, cnt1 = 0, cnt2 = 0, cnt3 = 0, cnt4 = 0;
-        bool    f_vu = false;
-    } cVUl_t;
-    cVUl_t m_cVUl;
-
-    typedef struct _ifCh{ // used in IIR_filterChain0, 1, 2
-        float   inSample0[2];
-        float   outSample0[2];
-        int16_t iir_out0[2];
-        float   inSample1[2];
-        float   outSample1[2];
-        int16_t iir_out1[2];
-        float   inSample2[2];
-        float   outSample2[2];
-        int16_t iir_out2[2];
-    } ifCh_t;
-    ifCh_t m_ifCh;
-
     typedef struct _tspp{ // used in ts_parsePacket
         int pidNumber = 0;
         int pids[4]; // PID_ARRAY_LEN
@@ -449,9 +387,17 @@ private:
     uint32_t     inBufferFilled();            // returns the number of stored bytes in the inputbuffer
     uint32_t     inBufferFree();              // returns the number of free bytes in the inputbuffer
     uint32_t     getInBufferSize();           // returns the size of the inputbuffer in bytes
+    uint32_t     inBufferUnderruns();         // times the decoder waited for the inputbuffer (50ms each), per stream
+    uint32_t     i2sUnderruns();              // DMA buffers the I2S sent without new samples while a stream played, per stream
+    void         getStats(audio_stats_t& stats); // counters and histograms of fetch, inputbuffer, decoder and I2S, per stream
     bool         setInBufferSize(size_t mbs); // sets the size of the inputbuffer in bytes
     void         setTone(int8_t gainLowPass, int8_t gainBandPass, int8_t gainHighPass);
+    void         setToneFixedPoint(bool fixedPoint); // tone control with integer biquads, for chips without FPU
     void         setI2SCommFMT_LSB(bool commFMT);
+    int8_t       loadSoundEffect(fs::FS& fs, const char* path);     // WAV, decoded once into PSRAM, returns the id or -1
+    bool         playSoundEffect(int8_t id, uint8_t volume = 100);  // mixed over the stream, may be called from any task
+    void         stopSoundEffects();
+    void         clearSoundEffects();                                // frees the clips, I2S gets its large DMA buffers back
     int          getCodec() { return m_codec; }
     const char*  getCodecname() { return codecname[m_codec]; }
     const char*  getVersion() { return audioI2SVers; }
@@ -498,11 +444,8 @@ private:
     bool         setBitsPerSample(int bits);
     bool         setChannels(int channels);
     bool         setBitrate(int br);
-    size_t       resampleTo48kStereo(const int16_t* input, size_t inputFrames);
     void         playChunk();
-    void         computeVUlevel(int16_t sample[2]);
     void         computeLimit();
-    void         Gain(int16_t* sample);
     void         showstreamtitle(char* ml);
     bool         parseContentType(char* ct);
     bool         parseHttpResponseHeader();
@@ -510,10 +453,10 @@ private:
     bool         initializeDecoder(uint8_t codec);
     esp_err_t    I2Sstart();
     esp_err_t    I2Sstop();
+    void         I2SnewChannel();
+    void         I2SsetDMA(uint32_t descNum, uint32_t frameNum); // a new channel, the configuration is kept
     void         zeroI2Sbuff();
-    void         IIR_filterChain0(int16_t iir_in[2], bool clear = false);
-    void         IIR_filterChain1(int16_t iir_in[2], bool clear = false);
-    void         IIR_filterChain2(int16_t iir_in[2], bool clear = false);
+    void         playSoundEffects(); // while no stream is played
     uint32_t     streamavail() { return m_client ? m_client->available() : 0; }
     void         IIR_calculateCoefficients(int8_t G1, int8_t G2, int8_t G3);
     bool         ts_parsePacket(uint8_t* packet, uint8_t* packetStart, uint8_t* packetLength);
@@ -521,6 +464,7 @@ private:
     //+++ create a T A S K  for playAudioData(), output via I2S +++
   public:
     void         setAudioTaskCore(uint8_t coreID);
+    void         setFetchTaskCore(int8_t coreID); // reads the stream into the inputbuffer in a task, -1: in loop() (default)
     uint32_t     getHighWatermark();
 
   private:
@@ -529,6 +473,12 @@ private:
     static void  taskWrapper(void* param);
     void         audioTask();
     void         performAudioTask();
+    void         startFetchTask();
+    void         stopFetchTask();
+    static void  fetchTaskWrapper(void* param);
+    void         fetchTask();
+    void         fetchAudioData(); // the work of loop(): connect, headers, playlists, fill the inputbuffer
+    static bool  i2sSendQueueOverflow(i2s_chan_handle_t handle, i2s_event_data_t* event, void* user_ctx);
 
     //+++ H E L P   F U N C T I O N S +++
     uint16_t     readMetadata(uint16_t b, bool first = false);
@@ -540,6 +490,8 @@ private:
     uint32_t     ogg_correctResumeFilePos();
     int32_t      flac_correctResumeFilePos();
     int32_t      mp3_correctResumeFilePos();
+    static int32_t seekIndexRead(void* user, uint32_t pos, uint8_t* buf, uint32_t len);
+    void         initSeekIndex();
     uint8_t      determineOggCodec(uint8_t* data, uint16_t len);
 
     //++++ implement several function with respect to the index of string ++++
@@ -799,16 +751,6 @@ private:
                  CODEC_AACP = 6, CODEC_OPUS = 7, CODEC_OGG = 8, CODEC_VORBIS = 9};
     enum : int { ST_NONE = 0, ST_WEBFILE = 1, ST_WEBSTREAM = 2};
     typedef enum { LEFTCHANNEL=0, RIGHTCHANNEL=1 } SampleIndex;
-    typedef enum { LOWSHELF = 0, PEAKEQ = 1, HIFGSHELF =2 } FilterType;
-
-    typedef struct _filter{
-        float a0;
-        float a1;
-        float a2;
-        float b1;
-        float b2;
-    } filter_t;
-
     typedef struct _pis_array{
         int number;
         int pids[4];
@@ -827,6 +769,7 @@ private:
     SemaphoreHandle_t     mutex_playAudioData;
     SemaphoreHandle_t     mutex_audioTask;
     TaskHandle_t          m_audioTaskHandle = nullptr;
+    TaskHandle_t          m_fetchTaskHandle = nullptr;
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wmissing-field-initializers"
@@ -867,7 +810,15 @@ private:
     ps_ptr<char>     m_streamTitle;    // stores the last StreamTitle
 
 
-    filter_t        m_filter[3];                    // digital filters
+    AudioDSP        m_dsp;                          // VU meter, tone control, mono and volume in playChunk
+    AudioResampler  m_resampler;                    // m_sampleRate -> 48kHz in playChunk (SR_48K)
+    SoundEffects    m_sfx;                          // UI sound effects, mixed in playChunk or playSoundEffects
+    std::unique_ptr<MP3Decoder>    m_mp3Decoder;    // the decoders keep their state in the instance,
+    std::unique_ptr<AACDecoder>    m_aacDecoder;    // every Audio object decodes its own stream
+    std::unique_ptr<FLACDecoder>   m_flacDecoder;
+    std::unique_ptr<OPUSDecoder>   m_opusDecoder;
+    std::unique_ptr<VORBISDecoder> m_vorbisDecoder;
+    int64_t         m_sfxQueuedUntil = 0;           // µs, end of the sound effects written to I2S without a stream
     const uint16_t  m_plsBuffEntryLen = 256;        // length of each entry in playlistBuff
     int             m_LFcount = 0;                  // Detection of end of header
     uint32_t        m_sampleRate=48000;
@@ -881,7 +832,6 @@ private:
     int8_t          m_balance = 0;                  // -16 (mute left) ... +16 (mute right)
     uint16_t        m_vol = 21;                     // volume
     uint16_t        m_vol_steps = 21;               // default
-    int16_t         m_inputHistory[6] = {0};        // used in resampleTo48kStereo()
     uint16_t        m_opus_mode = 0;                // celt_only, silk_only or hybrid
     double          m_limit_left = 0;               // limiter 0 ... 1, left channel
     double          m_limit_right = 0;              // limiter 0 ... 1, right channel
@@ -898,9 +848,8 @@ private:
     uint8_t         m_filterType[2];                // lowpass, highpass
     uint8_t         m_streamType = ST_NONE;
     uint8_t         m_ID3Size = 0;                  // lengt of ID3frame - ID3header
-    uint8_t         m_vuLeft = 0;                   // average value of samples, left channel
-    uint8_t         m_vuRight = 0;                  // average value of samples, right channel
     uint8_t         m_audioTaskCoreId = 0;
+    uint8_t         m_fetchTaskCoreId = 1;
     uint8_t         m_M4A_objectType = 0;           // set in read_M4A_Header
     uint8_t         m_M4A_chConfig = 0;             // set in read_M4A_Header
     uint16_t        m_M4A_sampleRate = 0;           // set in read_M4A_Header
@@ -927,6 +876,11 @@ private:
     uint32_t        m_stsz_numEntries = 0;          // num of entries inside stsz atom (uint32_t)
     uint32_t        m_stsz_position = 0;            // pos of stsz atom within file
     uint32_t        m_haveNewFilePos = 0;           // user changed the file position
+    SeekIndex       m_seekIndex;                    // local files: time -> frame position
+    int32_t         m_resumeTimeMs = -1;            // setAudioPlayPosition(), setTimeOffset(): target for the seek index
+    int32_t         m_seekLandedMs = -1;            // the seek index found the frame that starts at this time
+    uint32_t        m_flacSeekTablePos = 0;         // first seek point of the FLAC SEEKTABLE
+    uint32_t        m_flacSeekTableLen = 0;
     bool            m_f_metadata = false;           // assume stream without metadata
     bool            m_f_unsync = false;             // set within ID3 tag but not used
     bool            m_f_exthdr = false;             // ID3 extended header
@@ -956,24 +910,23 @@ private:
     bool            m_f_stream = false;             // stream ready for output?
     bool            m_f_decode_ready = false;       // if true data for decode are ready
     bool            m_f_eof = false;                // end of file
-    bool            m_f_lockInBuffer = false;       // lock inBuffer for manipulation
-    bool            m_f_audioTaskIsDecoding = false;
+    std::atomic<bool> m_f_lockInBuffer{false};      // lock inBuffer for manipulation
+    std::atomic<bool> m_f_audioTaskIsDecoding{false};
+    std::atomic<bool> m_f_fetchTaskIsRunning{false}; // loop() does nothing
+    std::atomic<uint32_t> m_inBuffUnderruns{0};     // audio task: less than one frame in InBuff
+    std::atomic<uint32_t> m_i2sUnderruns{0};        // I2S ISR: the DMA sent a buffer without new samples
+    AudioStats      m_stats;                        // getStats()
     bool            m_f_acceptRanges = false;
     bool            m_f_reset_m3u8Codec = true;     // reset codec for m3u8 stream
     bool            m_f_connectionClose = false;    // set in parseHttpResponseHeader
     uint32_t        m_audioFileDuration = 0;
     float           m_audioCurrentTime = 0;
-    float           m_resampleError = 0.0f;
-    float           m_resampleRatio = 1.0f;         // resample ratio for e.g. 44.1kHz to 48kHz
-    float           m_resampleCursor = 0.0f;        // next frac in resampleTo48kStereo
 
 
 
     uint32_t        m_audioDataStart = 0;           // in bytes
     size_t          m_audioDataSize = 0;            //
     size_t          m_ibuffSize = 0;                // log buffer size for audio_info()
-    float           m_filterBuff[3][2][2][2];       // IIR filters memory for Audio DSP
-    float           m_corr = 1.0;					// correction factor for level adjustment
     size_t          m_i2s_bytesWritten = 0;         // set in i2s_write() but not used
     uint16_t        m_filterFrequency[2];
     int8_t          m_gain0 = 0;                    // cut or boost filters (EQ)
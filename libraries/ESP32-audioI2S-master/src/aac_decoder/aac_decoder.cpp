@@ -11,73 +11,53 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
-#include <time.h>
 #include "libfaad/neaacdec.h"
 
 
-// Declaration of the required global variables
-
-NeAACDecHandle hAac;
-NeAACDecFrameInfo frameInfo;
-NeAACDecConfigurationPtr conf;
 const uint8_t  SYNCWORDH = 0xff; /* 12-bit syncword */
 const uint8_t  SYNCWORDL = 0xf0;
-bool f_decoderIsInit = false;
-bool f_firstCall = false;
-bool f_setRaWBlockParams = false;
-uint32_t aacSamplerate = 0;
-uint8_t aacChannels = 0;
-uint8_t aacProfile = 0;
-static uint16_t validSamples = 0;
-clock_t before;
-float compressionRatio = 1;
-mp4AudioSpecificConfig* mp4ASC;
 
 //----------------------------------------------------------------------------------------------------------------------
-bool AACDecoder_IsInit(){
-    return f_decoderIsInit;
+bool AACDecoder::isInit(){
+    return m_f_decoderIsInit;
 }
 //----------------------------------------------------------------------------------------------------------------------
-bool AACDecoder_AllocateBuffers(){
-    before = clock();
-    hAac = NeAACDecOpen();
-    conf = NeAACDecGetCurrentConfiguration(hAac);
+bool AACDecoder::allocateBuffers(){
+    m_hAac = NeAACDecOpen();
+    m_conf = NeAACDecGetCurrentConfiguration(m_hAac);
 
-    if(hAac) f_decoderIsInit = true;
-    f_firstCall = false;
-    f_setRaWBlockParams = false;
-    return f_decoderIsInit;
+    if(m_hAac) m_f_decoderIsInit = true;
+    m_f_firstCall = false;
+    m_f_setRaWBlockParams = false;
+    return m_f_decoderIsInit;
 }
 //----------------------------------------------------------------------------------------------------------------------
-void AACDecoder_FreeBuffers(){
-    NeAACDecClose(hAac);
-    hAac = NULL;
-    f_decoderIsInit = false;
-    f_firstCall = false;
-    clock_t difference = clock() - before;
-    int msec = difference  / CLOCKS_PER_SEC; (void)msec;
-//    printf("ms %li\n", difference);
+void AACDecoder::freeBuffers(){
+    NeAACDecClose(m_hAac);
+    m_hAac = NULL;
+    m_f_decoderIsInit = false;
+    m_f_firstCall = false;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint8_t AACGetFormat(){
-    return frameInfo.header_type;  // RAW        0 /* No header */
-                                   // ADIF       1 /* single ADIF header at the beginning of the file */
-                                   // ADTS       2 /* ADTS header at the beginning of each frame */
+uint8_t AACDecoder::getFormat(){
+    return m_frameInfo.header_type;  // RAW        0 /* No header */
+                                     // ADIF       1 /* single ADIF header at the beginning of the file */
+                                     // ADTS       2 /* ADTS header at the beginning of each frame */
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint8_t AACGetSBR(){
-    return frameInfo.sbr;          // NO_SBR           0 /* no SBR used in this file */
-                                   // SBR_UPSAMPLED    1 /* upsampled SBR used */
-                                   // SBR_DOWNSAMPLED  2 /* downsampled SBR used */
-                                   // NO_SBR_UPSAMPLED 3 /* no SBR used, but file is upsampled by a factor 2 anyway */
+uint8_t AACDecoder::getSBR(){
+    return m_frameInfo.sbr;          // NO_SBR           0 /* no SBR used in this file */
+                                     // SBR_UPSAMPLED    1 /* upsampled SBR used */
+                                     // SBR_DOWNSAMPLED  2 /* downsampled SBR used */
+                                     // NO_SBR_UPSAMPLED 3 /* no SBR used, but file is upsampled by a factor 2 anyway */
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint8_t AACGetParametricStereo(){  // not used (0) or used (1)
-//    log_w("frameInfo.ps %i", frameInfo.isPS);
-    return frameInfo.isPS;
+uint8_t AACDecoder::getParametricStereo(){  // not used (0) or used (1)
+//    log_w("m_frameInfo.ps %i", m_frameInfo.isPS);
+    return m_frameInfo.isPS;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int AACFindSyncWord(uint8_t *buf, int nBytes){
+int AACDecoder::findSyncWord(uint8_t *buf, int nBytes){
     const int MIN_ADTS_HEADER_SIZE = 7;
     auto validate = [](const uint8_t *buf) -> bool { // check the ADTS header for validity
         // Layer (bits 14-15) must be 00
@@ -117,32 +97,32 @@ int AACFindSyncWord(uint8_t *buf, int nBytes){
     return -1;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int AACSetRawBlockParams(int nChans, int sampRateCore, int profile){
-    f_setRaWBlockParams = true;
-    aacChannels = nChans;  // 1: Mono, 2: Stereo
-    aacSamplerate = (uint32_t)sampRateCore; // 8000, 11025, 12000, 16000, 22050, 24000, 32000, 44100, 48000
-    aacProfile = profile; //1: AAC Main, 2: AAC LC (Low Complexity), 3: AAC SSR (Scalable Sample Rate), 4: AAC LTP (Long Term Prediction)
+int AACDecoder::setRawBlockParams(int nChans, int sampRateCore, int profile){
+    m_f_setRaWBlockParams = true;
+    m_aacChannels = nChans;  // 1: Mono, 2: Stereo
+    m_aacSamplerate = (uint32_t)sampRateCore; // 8000, 11025, 12000, 16000, 22050, 24000, 32000, 44100, 48000
+    m_aacProfile = profile; //1: AAC Main, 2: AAC LC (Low Complexity), 3: AAC SSR (Scalable Sample Rate), 4: AAC LTP (Long Term Prediction)
     return 0;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int16_t AACGetOutputSamps(){
-    return validSamples;
+int16_t AACDecoder::getOutputSamps(){
+    return m_validSamples;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int AACGetBitrate(){
-    uint32_t br = AACGetBitsPerSample() * AACGetChannels() *  AACGetSampRate();
-    return (br / compressionRatio);;
+int AACDecoder::getBitRate(){
+    uint32_t br = getBitsPerSample() * getChannels() *  getSampRate();
+    return (br / m_compressionRatio);;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int AACGetChannels(){
-    return aacChannels;
+int AACDecoder::getChannels(){
+    return m_aacChannels;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int AACGetSampRate(){
-    return aacSamplerate;
+int AACDecoder::getSampRate(){
+    return m_aacSamplerate;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int AACGetBitsPerSample(){
+int AACDecoder::getBitsPerSample(){
     return 16;
 }
 //----------------------------------------------------------------------------------------------------------------------
@@ -153,38 +133,38 @@ void createAudioSpecificConfig(uint8_t* config, uint8_t audioObjectType, uint8_t
 //----------------------------------------------------------------------------------------------------------------------
 extern uint8_t get_sr_index(const uint32_t samplerate);
 
-int AACDecode(uint8_t *inbuf, int32_t *bytesLeft, short *outbuf){
+int AACDecoder::decode(uint8_t *inbuf, int32_t *bytesLeft, short *outbuf){
     uint8_t* ob = (uint8_t*)outbuf;
-    if (f_firstCall == false){
-        if(f_setRaWBlockParams){ // set raw AAC values, e.g. for M4A config.
-            f_setRaWBlockParams = false;
-            conf->defSampleRate = aacSamplerate;
-            conf->outputFormat = FAAD_FMT_16BIT;
-            conf->useOldADTSFormat = 1;
-            conf->defObjectType = 2;
-            int8_t ret = NeAACDecSetConfiguration(hAac, conf); (void)ret;
+    if (m_f_firstCall == false){
+        if(m_f_setRaWBlockParams){ // set raw AAC values, e.g. for M4A config.
+            m_f_setRaWBlockParams = false;
+            m_conf->defSampleRate = m_aacSamplerate;
+            m_conf->outputFormat = FAAD_FMT_16BIT;
+            m_conf->useOldADTSFormat = 1;
+            m_conf->defObjectType = 2;
+            int8_t ret = NeAACDecSetConfiguration(m_hAac, m_conf); (void)ret;
 
             uint8_t specificInfo[2];
-            createAudioSpecificConfig(specificInfo, aacProfile, get_sr_index(aacSamplerate), aacChannels);
-            int8_t err = NeAACDecInit2(hAac, specificInfo, 2, &aacSamplerate, &aacChannels);(void)err;
+            createAudioSpecificConfig(specificInfo, m_aacProfile, get_sr_index(m_aacSamplerate), m_aacChannels);
+            int8_t err = NeAACDecInit2(m_hAac, specificInfo, 2, &m_aacSamplerate, &m_aacChannels);(void)err;
         }
         else{
-            NeAACDecSetConfiguration(hAac, conf);
-            int8_t err = NeAACDecInit(hAac, inbuf, *bytesLeft, &aacSamplerate, &aacChannels); (void)err;
+            NeAACDecSetConfiguration(m_hAac, m_conf);
+            int8_t err = NeAACDecInit(m_hAac, inbuf, *bytesLeft, &m_aacSamplerate, &m_aacChannels); (void)err;
         }
-        f_firstCall = true;
+        m_f_firstCall = true;
     }
 
-    NeAACDecDecode2(hAac, &frameInfo, inbuf, *bytesLeft, (void**)&ob, 2048 * 2 * sizeof(int16_t));
-    *bytesLeft -= frameInfo.bytesconsumed;
-    validSamples = frameInfo.samples;
-    int8_t err = 0 - frameInfo.error;
-    compressionRatio = (float)frameInfo.samples * 2 / frameInfo.bytesconsumed;
-    if(err < 0) AAC_LOG_ERROR(AACGetErrorMessage(abs(err)));
+    NeAACDecDecode2(m_hAac, &m_frameInfo, inbuf, *bytesLeft, (void**)&ob, 2048 * 2 * sizeof(int16_t));
+    *bytesLeft -= m_frameInfo.bytesconsumed;
+    m_validSamples = m_frameInfo.samples;
+    int8_t err = 0 - m_frameInfo.error;
+    m_compressionRatio = (float)m_frameInfo.samples * 2 / m_frameInfo.bytesconsumed;
+    if(err < 0) AAC_LOG_ERROR(getErrorMessage(abs(err)));
     return err;
 }
 //----------------------------------------------------------------------------------------------------------------------
-const char* AACGetErrorMessage(int8_t err){
+const char* AACDecoder::getErrorMessage(int8_t err){
     return NeAACDecGetErrorMessage(abs(err));
 }
 //----------------------------------------------------------------------------------------------------------------------
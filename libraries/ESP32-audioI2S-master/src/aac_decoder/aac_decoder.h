@@ -19,21 +19,40 @@ struct AudioSpecificConfig {
     uint8_t channelConfiguration;
 };
 
-bool        AACDecoder_IsInit();
-bool        AACDecoder_AllocateBuffers();
-void        AACDecoder_FreeBuffers();
-uint8_t     AACGetFormat();
-uint8_t     AACGetParametricStereo();
-uint8_t     AACGetSBR();
-int         AACFindSyncWord(uint8_t *buf, int nBytes);
-int         AACSetRawBlockParams(int nChans, int sampRateCore, int profile);
-int16_t     AACGetOutputSamps();
-int         AACGetBitrate();
-int         AACGetChannels();
-int         AACGetSampRate();
-int         AACGetBitsPerSample();
-int         AACDecode(uint8_t *inbuf, int32_t *bytesLeft, short *outbuf);
-const char* AACGetErrorMessage(int8_t err);
+// Decoder instance, all state of a stream lives in the object. Several instances can decode different streams
+// concurrently (e.g. in tasks on both cores), one instance must not be used by two tasks at the same time.
+class AACDecoder {
+public:
+    ~AACDecoder() { freeBuffers(); }
+    bool        isInit();
+    bool        allocateBuffers();
+    void        freeBuffers();
+    uint8_t     getFormat();
+    uint8_t     getParametricStereo();
+    uint8_t     getSBR();
+    int         findSyncWord(uint8_t *buf, int nBytes);
+    int         setRawBlockParams(int nChans, int sampRateCore, int profile);
+    int16_t     getOutputSamps();
+    int         getBitRate();
+    int         getChannels();
+    int         getSampRate();
+    int         getBitsPerSample();
+    int         decode(uint8_t *inbuf, int32_t *bytesLeft, short *outbuf);
+    const char* getErrorMessage(int8_t err);
+
+private:
+    NeAACDecHandle           m_hAac = NULL;
+    NeAACDecFrameInfo        m_frameInfo = {};
+    NeAACDecConfigurationPtr m_conf = NULL;
+    bool                     m_f_decoderIsInit = false;
+    bool                     m_f_firstCall = false;
+    bool                     m_f_setRaWBlockParams = false;
+    uint32_t                 m_aacSamplerate = 0;
+    uint8_t                  m_aacChannels = 0;
+    uint8_t                  m_aacProfile = 0;
+    uint16_t                 m_validSamples = 0;
+    float                    m_compressionRatio = 1;
+};
 
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
     // 📌📌📌  L O G G I N G   📌📌📌
@@ -0,0 +1,112 @@
+/*
+ * audio_buffer.cpp
+ *
+ * Lock-free single producer, single consumer ring of Audio, see audio_buffer.h
+ */
+
+#include "audio_buffer.h"
+#include "Arduino.h"
+
+AudioBuffer::AudioBuffer(size_t maxBlockSize) {
+    if(maxBlockSize) m_resBuffSize = maxBlockSize;
+    if(maxBlockSize) m_maxBlockSize = maxBlockSize;
+}
+
+AudioBuffer::~AudioBuffer() {
+    if(m_buffer) free(m_buffer);
+    m_buffer = NULL;
+}
+
+int32_t AudioBuffer::getBufsize() { return m_buffSize; }
+
+bool AudioBuffer::setBufsize(size_t mbs) {
+    if(mbs < 2 * m_resBuffSize) {
+        log_e("not allowed buffer size must be greater than %u", (unsigned)(2 * m_resBuffSize));
+        return false;
+    }
+    m_buffSize = mbs;
+    if(!init()) return false;
+    return true;
+}
+
+size_t AudioBuffer::init() {
+    if(m_buffer) free(m_buffer);
+    m_buffer = NULL;
+    m_buffer = (uint8_t*)ps_malloc(m_buffSize + m_resBuffSize);
+
+    if(!m_buffer) return 0;
+    m_f_init = true;
+    resetBuffer();
+    return m_buffSize;
+}
+
+void AudioBuffer::changeMaxBlockSize(uint16_t mbs) {
+    m_maxBlockSize = mbs;
+    return;
+}
+
+uint16_t AudioBuffer::getMaxBlockSize() { return m_maxBlockSize; }
+
+size_t AudioBuffer::freeSpace() { // writer
+    return m_buffSize - m_filled.load(std::memory_order_acquire);
+}
+
+size_t AudioBuffer::writeSpace() { // writer, the free space ends at m_endPtr or at m_readPtr
+    size_t space = m_buffSize - m_filled.load(std::memory_order_acquire);
+    size_t toEnd = m_endPtr - m_writePtr;
+    return space < toEnd ? space : toEnd;
+}
+
+size_t AudioBuffer::bufferFilled() {
+    return m_filled.load(std::memory_order_acquire);
+}
+
+size_t AudioBuffer::getMaxAvailableBytes() { // reader, the data ends at m_endPtr or at m_writePtr
+    size_t filled = m_filled.load(std::memory_order_acquire);
+    size_t toEnd = m_endPtr - m_readPtr;
+    return filled < toEnd ? filled : toEnd;
+}
+
+void AudioBuffer::bytesWritten(size_t bw) {
+    if(!bw) return;
+    m_writePtr += bw;
+    if(m_writePtr == m_endPtr) { m_writePtr = m_buffer; }
+    if(m_writePtr > m_endPtr) log_e("AudioBuffer: m_writePtr %p > m_endPtr %p", m_writePtr, m_endPtr);
+    m_filled.fetch_add(bw, std::memory_order_release); // the data is written before the reader can see it
+}
+
+void AudioBuffer::bytesWasRead(size_t br) {
+    if(!br) return;
+    size_t filled = m_filled.load(std::memory_order_acquire);
+    if(br > filled) br = filled; // never behind the writer
+    m_readPtr += br;
+    if(m_readPtr >= m_endPtr) {
+        size_t tmp = m_readPtr - m_endPtr;
+        m_readPtr = m_buffer + tmp;
+    }
+    m_filled.fetch_sub(br, std::memory_order_release); // the data is read before the writer can overwrite it
+}
+
+uint8_t* AudioBuffer::getWritePtr() { return m_writePtr; }
+
+uint8_t* AudioBuffer::getReadPtr() {
+    size_t len = m_endPtr - m_readPtr;
+    if(len < m_maxBlockSize) { // be sure the last frame is completed
+        // only the bytes the writer has published, the rest of the block may be written at this moment
+        size_t filled = m_filled.load(std::memory_order_acquire);
+        size_t n = min(m_maxBlockSize, filled);
+        if(n > len) memcpy(m_endPtr, m_buffer, n - len); // cpy from m_buffer to m_endPtr with len
+    }
+    return m_readPtr;
+}
+
+void AudioBuffer::resetBuffer() {
+    m_writePtr = m_buffer;
+    m_readPtr = m_buffer;
+    m_endPtr = m_buffer + m_buffSize;
+    m_filled.store(0, std::memory_order_release);
+}
+
+uint32_t AudioBuffer::getWritePos() { return m_writePtr - m_buffer; }
+
+uint32_t AudioBuffer::getReadPos() { return m_readPtr - m_buffer; }
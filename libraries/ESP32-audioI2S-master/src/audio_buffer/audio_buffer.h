@@ -0,0 +1,75 @@
+/*
+ * audio_buffer.h
+ *
+ * InBuff of Audio, the ring between the task that fetches the stream (Audio::loop() or the fetch task) and the audio
+ * task that decodes it. One task writes (getWritePtr, writeSpace, freeSpace, bytesWritten), one task reads (getReadPtr,
+ * getMaxAvailableBytes, bytesWasRead), without a lock: each side owns its pointer, the number of filled bytes is the
+ * only shared variable. bytesWritten() publishes the data with a release, the reader sees it with an acquire in
+ * bufferFilled() and the other way round for the space freed by bytesWasRead().
+ * init(), setBufsize() and resetBuffer() touch both sides, the reader must not run at that time (m_f_lockInBuffer).
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+class AudioBuffer {
+// AudioBuffer will be allocated in PSRAM, If PSRAM not available or has not enough space AudioBuffer will be
+// allocated in FlashRAM with reduced size
+//
+//  m_buffer            m_readPtr                 m_writePtr                 m_endPtr
+//   |                       |<------dataLength------->|<------ writeSpace ----->|
+//   ▼                       ▼                         ▼                         ▼
+//   ---------------------------------------------------------------------------------------------------------------
+//   |                     <--m_buffSize-->                                      |      <--m_resBuffSize -->     |
+//   ---------------------------------------------------------------------------------------------------------------
+//   |<-----freeSpace------->|                         |<------freeSpace-------->|
+//
+//
+//
+//   if the space between m_readPtr and buffend < m_resBuffSize copy data from the beginning to resBuff
+//   so that the mp3/aac/flac frame is always completed
+//
+//  m_buffer                      m_writePtr                 m_readPtr        m_endPtr
+//   |                                 |<-------writeSpace------>|<--dataLength-->|
+//   ▼                                 ▼                         ▼                ▼
+//   ---------------------------------------------------------------------------------------------------------------
+//   |                        <--m_buffSize-->                                    |      <--m_resBuffSize -->     |
+//   ---------------------------------------------------------------------------------------------------------------
+//   |<---  ------dataLength--  ------>|<-------freeSpace------->|
+//
+//
+
+public:
+    AudioBuffer(size_t maxBlockSize = 0);       // constructor
+    ~AudioBuffer();                             // frees the buffer
+    size_t   init();                            // set default values
+    bool     isInitialized() { return m_f_init; };
+    int32_t  getBufsize();
+    bool     setBufsize(size_t mbs);            // default is m_buffSizePSRAM for psram, and m_buffSizeRAM without psram
+    void     changeMaxBlockSize(uint16_t mbs);  // is default 1600 for mp3 and aac, set 16384 for FLAC
+    uint16_t getMaxBlockSize();                 // returns maxBlockSize
+    size_t   freeSpace();                       // number of free bytes to overwrite
+    size_t   writeSpace();                      // space fom writepointer to bufferend
+    size_t   bufferFilled();                    // returns the number of filled bytes
+    size_t   getMaxAvailableBytes();            // max readable bytes in one block
+    void     bytesWritten(size_t bw);           // update writepointer
+    void     bytesWasRead(size_t br);           // update readpointer
+    uint8_t* getWritePtr();                     // returns the current writepointer
+    uint8_t* getReadPtr();                      // returns the current readpointer
+    uint32_t getWritePos();                     // write position relative to the beginning
+    uint32_t getReadPos();                      // read position relative to the beginning
+    void     resetBuffer();                     // restore defaults
+
+protected:
+    size_t              m_buffSize         = UINT16_MAX * 10;   // most webstreams limit the advance to 100...300Kbytes
+    size_t              m_resBuffSize      = 4096 * 6; // reserved buffspace, >= one flac frame
+    size_t              m_maxBlockSize     = 1600;
+    uint8_t*            m_buffer           = NULL;
+    uint8_t*            m_writePtr         = NULL;     // writer only
+    uint8_t*            m_readPtr          = NULL;     // reader only
+    uint8_t*            m_endPtr           = NULL;
+    std::atomic<size_t> m_filled{0};                   // bytes from m_readPtr to m_writePtr, 0 ... m_buffSize
+    bool                m_f_init           = false;
+};
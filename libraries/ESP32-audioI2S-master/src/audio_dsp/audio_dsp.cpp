@@ -0,0 +1,286 @@
+/*
+ * audio_dsp.cpp
+ *
+ * block processing of the post decoder chain, see audio_dsp.h
+ */
+
+#include "audio_dsp.h"
+#include "Arduino.h"
+
+static inline int16_t clip16(int32_t v) {
+    if(v > 32767) return 32767;
+    if(v < -32768) return -32768;
+    return (int16_t)v;
+}
+
+static inline int32_t toQ(float v, uint8_t frac) {
+    return (int32_t)lroundf(v * (float)(1 << frac));
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+float AudioDSP::highShelfFrequency(uint32_t sampleRate) {
+    float FcHS = 6000; // Frequency HighShelf[Hz]
+    // according to the sampling theorem, the sample rate must be at least 2 * 6000 >= 12000Hz for a filter
+    // frequency of 6000Hz. If this is not the case, the filter frequency (plus a reserve of 100Hz) is lowered
+    if(sampleRate < FcHS * 2 - 100) FcHS = sampleRate / 2 - 100; // Prevent HighShelf filter from clogging
+    return FcHS;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool AudioDSP::calculateTone(int8_t G0, int8_t G1, int8_t G2, uint32_t sampleRate, biquad_t f[NUM_FILTERS]) {
+
+    // G0 - gain low shelf   set between -40 ... +6 dB
+    // G1 - gain peakEQ      set between -40 ... +6 dB
+    // G2 - gain high shelf  set between -40 ... +6 dB
+    // https://www.earlevel.com/main/2012/11/26/biquad-c-source-code/
+
+    if(sampleRate < 1000) return false; // fuse
+
+    if(G0 < -40) G0 = -40; // -40dB -> Vin*0.01
+    if(G0 > 6) G0 = 6;     // +6dB -> Vin*2
+    if(G1 < -40) G1 = -40;
+    if(G1 > 6) G1 = 6;
+    if(G2 < -40) G2 = -40;
+    if(G2 > 6) G2 = 6;
+
+    const float FcLS = 500;    // Frequency LowShelf[Hz]
+    const float FcPKEQ = 3000; // Frequency PeakEQ[Hz]
+    float       FcHS = highShelfFrequency(sampleRate);
+    float K, norm, Q, Fc, V;
+
+    // LOWSHELF
+    Fc = (float)FcLS / (float)sampleRate; // Cutoff frequency
+    K = tanf((float)PI * Fc);
+    V = powf(10, fabs(G0) / 20.0);
+
+    if(G0 >= 0) { // boost
+        norm = 1 / (1 + sqrtf(2) * K + K * K);
+        f[LOWSHELF].a0 = (1 + sqrtf(2 * V) * K + V * K * K) * norm;
+        f[LOWSHELF].a1 = 2 * (V * K * K - 1) * norm;
+        f[LOWSHELF].a2 = (1 - sqrtf(2 * V) * K + V * K * K) * norm;
+        f[LOWSHELF].b1 = 2 * (K * K - 1) * norm;
+        f[LOWSHELF].b2 = (1 - sqrtf(2) * K + K * K) * norm;
+    }
+    else { // cut
+        norm = 1 / (1 + sqrtf(2 * V) * K + V * K * K);
+        f[LOWSHELF].a0 = (1 + sqrtf(2) * K + K * K) * norm;
+        f[LOWSHELF].a1 = 2 * (K * K - 1) * norm;
+        f[LOWSHELF].a2 = (1 - sqrtf(2) * K + K * K) * norm;
+        f[LOWSHELF].b1 = 2 * (V * K * K - 1) * norm;
+        f[LOWSHELF].b2 = (1 - sqrtf(2 * V) * K + V * K * K) * norm;
+    }
+
+    // PEAK EQ
+    Fc = (float)FcPKEQ / (float)sampleRate; // Cutoff frequency
+    K = tanf((float)PI * Fc);
+    V = powf(10, fabs(G1) / 20.0);
+    Q = 2.5;      // Quality factor
+    if(G1 >= 0) { // boost
+        norm = 1 / (1 + 1 / Q * K + K * K);
+        f[PEAKEQ].a0 = (1 + V / Q * K + K * K) * norm;
+        f[PEAKEQ].a1 = 2 * (K * K - 1) * norm;
+        f[PEAKEQ].a2 = (1 - V / Q * K + K * K) * norm;
+        f[PEAKEQ].b1 = f[PEAKEQ].a1;
+        f[PEAKEQ].b2 = (1 - 1 / Q * K + K * K) * norm;
+    }
+    else { // cut
+        norm = 1 / (1 + V / Q * K + K * K);
+        f[PEAKEQ].a0 = (1 + 1 / Q * K + K * K) * norm;
+        f[PEAKEQ].a1 = 2 * (K * K - 1) * norm;
+        f[PEAKEQ].a2 = (1 - 1 / Q * K + K * K) * norm;
+        f[PEAKEQ].b1 = f[PEAKEQ].a1;
+        f[PEAKEQ].b2 = (1 - V / Q * K + K * K) * norm;
+    }
+
+    // HIGHSHELF
+    Fc = (float)FcHS / (float)sampleRate; // Cutoff frequency
+    K = tanf((float)PI * Fc);
+    V = powf(10, fabs(G2) / 20.0);
+    if(G2 >= 0) { // boost
+        norm = 1 / (1 + sqrtf(2) * K + K * K);
+        f[HIGHSHELF].a0 = (V + sqrtf(2 * V) * K + K * K) * norm;
+        f[HIGHSHELF].a1 = 2 * (K * K - V) * norm;
+        f[HIGHSHELF].a2 = (V - sqrtf(2 * V) * K + K * K) * norm;
+        f[HIGHSHELF].b1 = 2 * (K * K - 1) * norm;
+        f[HIGHSHELF].b2 = (1 - sqrtf(2) * K + K * K) * norm;
+    }
+    else {
+        norm = 1 / (V + sqrtf(2 * V) * K + K * K);
+        f[HIGHSHELF].a0 = (1 + sqrtf(2) * K + K * K) * norm;
+        f[HIGHSHELF].a1 = 2 * (K * K - 1) * norm;
+        f[HIGHSHELF].a2 = (1 - sqrtf(2) * K + K * K) * norm;
+        f[HIGHSHELF].b1 = 2 * (K * K - V) * norm;
+        f[HIGHSHELF].b2 = (V - sqrtf(2 * V) * K + K * K) * norm;
+    }
+    return true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioDSP::setFilters(const biquad_t f[NUM_FILTERS]) {
+    const float eps = 1e-5f;
+    for(int i = 0; i < NUM_FILTERS; i++) {
+        stage_t& s = m_stage[i];
+        // H(z) = (a0 + a1 z^-1 + a2 z^-2) / (1 + b1 z^-1 + b2 z^-2) is 1 if a0 == 1, a1 == b1 and a2 == b2 (0 dB)
+        bool active = fabsf(f[i].a0 - 1) > eps || fabsf(f[i].a1 - f[i].b1) > eps || fabsf(f[i].a2 - f[i].b2) > eps;
+        if(active && !s.active) clearStage(i); // the memory is stale while bypassed
+        s.coef = f[i];
+        s.q[0] = toQ(f[i].a0, 28);
+        s.q[1] = toQ(f[i].a1, 28);
+        s.q[2] = toQ(f[i].a2, 28);
+        s.q[3] = toQ(f[i].b1, 28);
+        s.q[4] = toQ(f[i].b2, 28);
+        s.active = active;
+    }
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioDSP::setLevelCorrection(float corr) {
+    m_corr = corr;
+    m_f_corr = corr > 1;
+    m_qCorr = m_f_corr ? toQ(1 / corr, 15) : 1 << 15;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioDSP::setFixedPoint(bool fixedPoint) {
+    if(fixedPoint != m_f_fixedPoint) clearFilters(); // the memory of the other implementation is not up to date
+    m_f_fixedPoint = fixedPoint;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioDSP::setGain(float left, float right) {
+    m_gainLeft = left;
+    m_gainRight = right;
+    m_qGainLeft = toQ(left, 15);
+    m_qGainRight = toQ(right, 15);
+    m_f_gain = left != 1.0f || right != 1.0f;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioDSP::setForceMono(bool mono) {
+    m_f_forceMono = mono;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioDSP::clearFilters() {
+    for(int i = 0; i < NUM_FILTERS; i++) clearStage(i);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioDSP::clearStage(uint8_t i) {
+    stage_t& s = m_stage[i];
+    memset(s.x1, 0, sizeof(s.x1)); memset(s.x2, 0, sizeof(s.x2)); memset(s.y1, 0, sizeof(s.y1)); memset(s.y2, 0, sizeof(s.y2));
+    memset(s.qx1, 0, sizeof(s.qx1)); memset(s.qx2, 0, sizeof(s.qx2)); memset(s.qy1, 0, sizeof(s.qy1)); memset(s.qy2, 0, sizeof(s.qy2));
+    memset(s.qerr, 0, sizeof(s.qerr));
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioDSP::resetVU() {
+    memset(m_vuPeak, 0, sizeof(m_vuPeak));
+    memset(m_vuPeaks, 0, sizeof(m_vuPeaks));
+    memset(m_vuAvg, 0, sizeof(m_vuAvg));
+    m_vuCnt = m_vuPeakIdx = m_vuAvgIdx = 0;
+    m_vuLeft = m_vuRight = 0;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioDSP::computeVU(uint8_t peakLeft, uint8_t peakRight) { // called every 64 samples
+
+    auto avg = [&](uint8_t* sampArr) { // lambda, inner function, compute the average of 8 values
+        uint16_t av = 0;
+        for(int i = 0; i < 8; i++) { av += sampArr[i]; }
+        return (uint8_t)(av >> 3);
+    };
+
+    m_vuPeaks[0][m_vuPeakIdx] = peakLeft;
+    m_vuPeaks[1][m_vuPeakIdx] = peakRight;
+    if(++m_vuPeakIdx < 8) return;
+    m_vuPeakIdx = 0;
+    m_vuAvg[0][m_vuAvgIdx] = avg(m_vuPeaks[0]);
+    m_vuAvg[1][m_vuAvgIdx] = avg(m_vuPeaks[1]);
+    m_vuAvgIdx = (m_vuAvgIdx + 1) & 7;
+    m_vuLeft = avg(m_vuAvg[0]);
+    m_vuRight = avg(m_vuAvg[1]);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void IRAM_ATTR AudioDSP::process(int16_t* samples, uint32_t frames) {
+    // 1. VU peak of the decoded samples and the level correction, in one pass
+    uint8_t peakL = m_vuPeak[0], peakR = m_vuPeak[1], vuCnt = m_vuCnt;
+    const bool f_corr = m_f_corr;
+    const float corr = m_corr;
+    const int32_t qCorr = m_qCorr;
+    for(uint32_t i = 0; i < frames; i++) {
+        int32_t l = samples[2 * i];
+        int32_t r = samples[2 * i + 1];
+        int32_t al = abs(l >> 7), ar = abs(r >> 7);
+        if(al > peakL) peakL = al > 255 ? 255 : al;
+        if(ar > peakR) peakR = ar > 255 ? 255 : ar;
+        if(++vuCnt == 64) { computeVU(peakL, peakR); peakL = peakR = 0; vuCnt = 0; }
+        if(!f_corr) continue;
+        if(m_f_fixedPoint) {
+            samples[2 * i] = (l * qCorr) >> 15;
+            samples[2 * i + 1] = (r * qCorr) >> 15;
+        }
+        else {
+            samples[2 * i] = (int16_t)(l / corr);
+            samples[2 * i + 1] = (int16_t)(r / corr);
+        }
+    }
+    m_vuPeak[0] = peakL; m_vuPeak[1] = peakR; m_vuCnt = vuCnt;
+
+    // 2. the active filters, one after the other over the whole chunk
+    for(int i = 0; i < NUM_FILTERS; i++) {
+        if(!m_stage[i].active) continue;
+        if(m_f_fixedPoint) biquadFixed(m_stage[i], samples, frames);
+        else biquadFloat(m_stage[i], samples, frames);
+    }
+
+    // 3. mono and gain
+    if(!m_f_forceMono && !m_f_gain) return;
+    const bool f_mono = m_f_forceMono, f_gain = m_f_gain;
+    if(m_f_fixedPoint) {
+        const int32_t gainL = m_qGainLeft, gainR = m_qGainRight;
+        for(uint32_t i = 0; i < frames; i++) {
+            int32_t l = samples[2 * i];
+            int32_t r = samples[2 * i + 1];
+            if(f_mono) l = r = (r + l) / 2;
+            if(f_gain) { l = (l * gainL) >> 15; r = (r * gainR) >> 15; }
+            samples[2 * i] = (int16_t)l;
+            samples[2 * i + 1] = (int16_t)r;
+        }
+    }
+    else {
+        const float gainL = m_gainLeft, gainR = m_gainRight;
+        for(uint32_t i = 0; i < frames; i++) {
+            int32_t l = samples[2 * i];
+            int32_t r = samples[2 * i + 1];
+            if(f_mono) l = r = (r + l) / 2;
+            if(f_gain) { l = (int32_t)(l * gainL); r = (int32_t)(r * gainR); }
+            samples[2 * i] = (int16_t)l;
+            samples[2 * i + 1] = (int16_t)r;
+        }
+    }
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void IRAM_ATTR AudioDSP::biquadFloat(stage_t& s, int16_t* samples, uint32_t frames) {
+    const float a0 = s.coef.a0, a1 = s.coef.a1, a2 = s.coef.a2, b1 = s.coef.b1, b2 = s.coef.b2;
+    float x1l = s.x1[0], x2l = s.x2[0], y1l = s.y1[0], y2l = s.y2[0]; // the memory is held in registers
+    float x1r = s.x1[1], x2r = s.x2[1], y1r = s.y1[1], y2r = s.y2[1];
+    for(uint32_t i = 0; i < frames; i++) {
+        float xl = samples[2 * i];
+        float xr = samples[2 * i + 1];
+        float yl = a0 * xl + a1 * x1l + a2 * x2l - b1 * y1l - b2 * y2l;
+        float yr = a0 * xr + a1 * x1r + a2 * x2r - b1 * y1r - b2 * y2r;
+        x2l = x1l; x1l = xl; y2l = y1l; y1l = yl;
+        x2r = x1r; x1r = xr; y2r = y1r; y1r = yr;
+        samples[2 * i] = clip16((int32_t)yl);
+        samples[2 * i + 1] = clip16((int32_t)yr);
+    }
+    s.x1[0] = x1l; s.x2[0] = x2l; s.y1[0] = y1l; s.y2[0] = y2l;
+    s.x1[1] = x1r; s.x2[1] = x2r; s.y1[1] = y1r; s.y2[1] = y2r;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void IRAM_ATTR AudioDSP::biquadFixed(stage_t& s, int16_t* samples, uint32_t frames) {
+    const int64_t a0 = s.q[0], a1 = s.q[1], a2 = s.q[2], b1 = s.q[3], b2 = s.q[4];
+    for(int c = 0; c < 2; c++) { // left, right
+        int32_t x1 = s.qx1[c], x2 = s.qx2[c], y1 = s.qy1[c], y2 = s.qy2[c], err = s.qerr[c];
+        int16_t* p = samples + c;
+        for(uint32_t i = 0; i < frames; i++) {
+            int32_t x = p[2 * i];
+            int64_t acc = a0 * x + a1 * x1 + a2 * x2 - b1 * y1 - b2 * y2 + err;
+            int32_t y = (int32_t)(acc >> 28);
+            err = (int32_t)(acc - ((int64_t)y << 28)); // first order error feedback, keeps the low shelf clean
+            x2 = x1; x1 = x; y2 = y1; y1 = y;
+            p[2 * i] = clip16(y);
+        }
+        s.qx1[c] = x1; s.qx2[c] = x2; s.qy1[c] = y1; s.qy2[c] = y2; s.qerr[c] = err;
+    }
+}
@@ -0,0 +1,84 @@
+/*
+ * audio_dsp.h
+ *
+ * Post decoder chain of Audio::playChunk(): VU meter, level correction, tone control (low shelf, peak EQ and
+ * high shelf biquads), force mono and volume/balance. A chunk of interleaved stereo samples is processed block by
+ * block: VU and level correction in one pass, then each active filter over the whole chunk with its memory in
+ * registers, then mono and gain. Filters with unity response, a unity gain and an inactive level correction are
+ * bypassed.
+ *
+ * The biquads run in float (default) or in fixed point (Q28 coefficients, 64 bit accumulator, first order error
+ * feedback), the fixed point version is faster on chips without FPU (ESP32-C3) and has no float in the sample loop.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+class AudioDSP {
+public:
+    typedef struct _biquad { // coefficients, y = a0 * x + a1 * x1 + a2 * x2 - b1 * y1 - b2 * y2
+        float a0 = 1;
+        float a1 = 0;
+        float a2 = 0;
+        float b1 = 0;
+        float b2 = 0;
+    } biquad_t;
+
+    enum : uint8_t { LOWSHELF = 0, PEAKEQ = 1, HIGHSHELF = 2, NUM_FILTERS = 3 };
+
+    // computes the tone control filters, G0 low shelf (500Hz), G1 peak EQ (3000Hz), G2 high shelf (6000Hz) in dB
+    // between -40 ... +6, returns false if the sample rate is too low (the filters are not changed)
+    static bool     calculateTone(int8_t G0, int8_t G1, int8_t G2, uint32_t sampleRate, biquad_t f[NUM_FILTERS]);
+    static float    highShelfFrequency(uint32_t sampleRate);
+
+    void            setFilters(const biquad_t f[NUM_FILTERS]);
+    void            setLevelCorrection(float corr);     // samples are divided by corr before the filters, if corr > 1
+    void            setFixedPoint(bool fixedPoint);
+    void            setGain(float left, float right);   // 0 ... 1
+    void            setForceMono(bool mono);
+    void            clearFilters();                     // zero the filter memory
+    void            resetVU();
+    uint16_t        getVUlevel() const { return (m_vuLeft << 8) + m_vuRight; } // avg 0 ... 127 per channel
+    bool            isFilterActive(uint8_t i) const { return m_stage[i].active; }
+    bool            isFixedPoint() const { return m_f_fixedPoint; }
+
+    void            process(int16_t* samples, uint32_t frames); // interleaved stereo, in place
+
+private:
+    typedef struct _stage {
+        biquad_t coef;
+        int32_t  q[5];                  // a0, a1, a2, b1, b2 in Q28
+        float    x1[2], x2[2], y1[2], y2[2];       // float memory, left and right
+        int32_t  qx1[2], qx2[2], qy1[2], qy2[2];   // fixed point memory
+        int32_t  qerr[2];                          // fraction of the last output (error feedback)
+        bool     active;
+    } stage_t;
+
+    void            clearStage(uint8_t i);
+    void            computeVU(uint8_t peakLeft, uint8_t peakRight);
+    void            biquadFloat(stage_t& s, int16_t* samples, uint32_t frames);
+    void            biquadFixed(stage_t& s, int16_t* samples, uint32_t frames);
+
+    stage_t         m_stage[NUM_FILTERS] = {};
+    float           m_corr = 1.0f;              // level correction, > 1 if a filter boosts
+    float           m_gainLeft = 1.0f;
+    float           m_gainRight = 1.0f;
+    int32_t         m_qCorr = 1 << 15;          // 1 / m_corr in Q15
+    int32_t         m_qGainLeft = 1 << 15;      // Q15
+    int32_t         m_qGainRight = 1 << 15;
+    bool            m_f_fixedPoint = false;
+    bool            m_f_forceMono = false;
+    bool            m_f_gain = false;           // gain != 1
+    bool            m_f_corr = false;           // m_corr > 1
+
+    // VU meter: peak of 64 samples, 8 peaks are averaged (512 samples), the level is the average of the last 8 averages
+    uint8_t         m_vuPeak[2] = {0};
+    uint8_t         m_vuPeaks[2][8] = {0};
+    uint8_t         m_vuAvg[2][8] = {0};
+    uint8_t         m_vuCnt = 0;                // samples of the current peak
+    uint8_t         m_vuPeakIdx = 0;
+    uint8_t         m_vuAvgIdx = 0;
+    uint8_t         m_vuLeft = 0;
+    uint8_t         m_vuRight = 0;
+};
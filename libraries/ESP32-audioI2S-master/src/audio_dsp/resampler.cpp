@@ -0,0 +1,157 @@
+/*
+ * resampler.cpp
+ *
+ * polyphase sample rate converter, see resampler.h
+ */
+
+#include "resampler.h"
+#include "Arduino.h"
+
+static inline int16_t clip16(int32_t v) {
+    if(v > 32767) return 32767;
+    if(v < -32768) return -32768;
+    return (int16_t)v;
+}
+
+static double besselI0(double x) { // modified Bessel function of the first kind, order 0 (Kaiser window)
+    double sum = 1, term = 1;
+    for(int k = 1; k < 50; k++) {
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+        if(term < sum * 1e-12) break;
+    }
+    return sum;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool AudioResampler::setSampleRate(uint32_t inRate) {
+    if(inRate == m_inRate && (m_taps.valid() || inRate == OUT_RATE)) return true;
+    if(inRate < 6000 || inRate > 192000) return false;
+    m_taps.reset();
+    m_inRate = inRate;
+    if(inRate == OUT_RATE) {m_L = m_M = 1; m_T = 0; reset(); return true;}
+
+    uint32_t a = OUT_RATE, b = inRate; // greatest common divisor
+    while(b) {uint32_t t = a % b; a = b; b = t;}
+    uint32_t L = OUT_RATE / a, M = inRate / a;
+    if(L > 1024) {log_e("can't resample %lu Hz to 48kHz", (unsigned long)inRate); m_inRate = 0; return false;}
+
+    // upsampling: the images above the input band are removed, downsampling: the band above 24kHz
+    uint32_t T = 32;
+    if(M > L) T = (32 * M + L - 1) / L;
+    T = (T + 7) & ~7;
+    if(T > MAX_TAPS) T = MAX_TAPS;
+
+    m_taps.alloc(L * T * sizeof(int16_t), "m_taps", L * T * sizeof(int16_t) > 16384);
+    if(!m_taps.valid()) {m_inRate = 0; return false;}
+    m_L = L; m_M = M; m_T = T;
+    m_stepInt = M / L;
+    m_stepFrac = M % L;
+    reset();
+
+    // prototype filter at L * inRate, cutoff half way between passband (0.41) and stopband (0.59) of the lower rate
+    const double beta = 8.6;                                // ~86dB
+    const double fc = 0.5 * (inRate < OUT_RATE ? 1.0 : (double)L / M) / L; // cycles per prototype sample
+    const double center = (L * T - 1) / 2.0;
+    const double i0beta = besselI0(beta);
+    int16_t* taps = m_taps.get();
+    int32_t  maxMagnitude = 0;
+    for(uint32_t p = 0; p < L; p++) {
+        double h[MAX_TAPS];
+        double sum = 0;
+        for(uint32_t j = 0; j < T; j++) { // tap j of phase p weights the input frame j frames before the newest
+            double n = j * L + p - center;
+            double sinc = n == 0 ? 2 * fc : sin(2 * PI * fc * n) / (PI * n);
+            double r = n / (center + 1);
+            double w = besselI0(beta * sqrt(1 - r * r)) / i0beta;
+            h[j] = sinc * w;
+            sum += h[j];
+        }
+        int32_t  q[MAX_TAPS] = {}, qSum = 0;
+        uint32_t jMax = 0;
+        for(uint32_t j = 0; j < T; j++) { // normalized, each phase has a DC gain of exactly 1.0
+            q[j] = (int32_t)lround(h[j] / sum * 32768);
+            qSum += q[j];
+            if(fabs(h[j]) > fabs(h[jMax])) jMax = j;
+        }
+        q[jMax] += 32768 - qSum; // rounding error to the largest tap
+        if(q[jMax] > 32767) { // a phase that hits an input frame is ~1.0, the rest goes to a neighbour
+            uint32_t k = jMax == 0 ? 1 : jMax == T - 1 ? T - 2 : q[jMax - 1] > q[jMax + 1] ? jMax - 1 : jMax + 1;
+            q[k] += q[jMax] - 32767;
+            q[jMax] = 32767;
+        }
+        for(uint32_t j = 0; j < T; j++) taps[p * T + (T - 1 - j)] = q[j];
+        for(uint32_t half = 0; half < 2; half++) {
+            int32_t magnitude = 0;
+            for(uint32_t j = half * T / 2; j < (half + 1) * T / 2; j++) magnitude += abs(taps[p * T + j]);
+            if(magnitude > maxMagnitude) maxMagnitude = magnitude;
+        }
+    }
+    if(maxMagnitude >= 65536) { // sum |taps| * 32768 of a half must fit in a 32 bit accumulator, a phase has ~2.4
+        log_e("resampler taps too large for %lu Hz", (unsigned long)inRate);
+        m_taps.reset(); m_inRate = 0;
+        return false;
+    }
+    log_d("resampler %lu -> 48000 Hz, %lu phases, %lu taps", (unsigned long)inRate, (unsigned long)L, (unsigned long)T);
+    return true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioResampler::reset() {
+    memset(m_bufL, 0, sizeof(m_bufL));
+    memset(m_bufR, 0, sizeof(m_bufR));
+    m_phase = 0;
+    m_pos = m_T ? m_T - 1 : 0;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+size_t IRAM_ATTR AudioResampler::process(const int16_t* in, size_t inFrames, int16_t* out, size_t outMax) {
+    if(isPassthrough()) {
+        size_t n = inFrames < outMax ? inFrames : outMax;
+        if(out != in) memmove(out, in, n * 2 * sizeof(int16_t));
+        return n;
+    }
+    const int16_t* taps = m_taps.get();
+    const uint32_t T = m_T, L = m_L;
+    const uint32_t hist = T - 1;
+    size_t outFrames = 0;
+
+    while(inFrames) {
+        uint32_t n = inFrames < BLOCK ? inFrames : BLOCK; // m_bufL/R: T-1 frames history, then n new frames
+        for(uint32_t i = 0; i < n; i++) {
+            m_bufL[hist + i] = in[2 * i];
+            m_bufR[hist + i] = in[2 * i + 1];
+        }
+        in += 2 * n;
+        inFrames -= n;
+        const uint32_t end = hist + n;
+        uint32_t pos = m_pos, phase = m_phase;
+        while(pos < end && outFrames < outMax) {
+            const int16_t* xl = m_bufL + pos - hist; // oldest frame of the window
+            const int16_t* xr = m_bufR + pos - hist;
+            const int16_t* h = taps + phase * T;
+            int32_t accL0 = 0, accR0 = 0, accL1 = 0, accR1 = 0; // each half of a phase has a sum |taps| < 2.0
+            for(uint32_t j = 0; j < T / 2; j++) {
+                accL0 += h[j] * xl[j];
+                accR0 += h[j] * xr[j];
+            }
+            for(uint32_t j = T / 2; j < T; j++) {
+                accL1 += h[j] * xl[j];
+                accR1 += h[j] * xr[j];
+            }
+            out[2 * outFrames]     = clip16(((accL0 >> 1) + (accL1 >> 1) + (1 << 13)) >> 14);
+            out[2 * outFrames + 1] = clip16(((accR0 >> 1) + (accR1 >> 1) + (1 << 13)) >> 14);
+            outFrames++;
+            pos += m_stepInt;
+            phase += m_stepFrac;
+            if(phase >= L) {phase -= L; pos++;}
+        }
+        if(pos < end) { // output buffer full, the rest of the input is dropped
+            log_e("resampler output buffer too small");
+            pos = end;
+            phase = 0;
+        }
+        memmove(m_bufL, m_bufL + n, hist * sizeof(int16_t)); // the newest T-1 frames are the next history
+        memmove(m_bufR, m_bufR + n, hist * sizeof(int16_t));
+        m_pos = pos - n;
+        m_phase = phase;
+    }
+    return outFrames;
+}
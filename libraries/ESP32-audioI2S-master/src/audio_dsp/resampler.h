@@ -0,0 +1,47 @@
+/*
+ * resampler.h
+ *
+ * Streaming polyphase FIR sample rate converter to 48kHz for interleaved stereo int16 samples (SR_48K in Audio.h).
+ * The ratio is exact, L / M from the greatest common divisor of the two rates, e.g. 44.1kHz -> 48kHz: 160 / 147,
+ * 32kHz: 3 / 2, 22.05kHz: 320 / 147, 16kHz: 3 / 1. The taps of the L phases are computed once per sample rate
+ * (Kaiser windowed sinc, passband 0.41 * the lower rate, > 70dB stopband) and stored in Q15, the sum of each phase
+ * is exactly 1.0. The sample loop is integer only, the history of the last frames is kept between the calls, so a
+ * chunk can have any length and nothing is allocated per call.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "../psram_unique_ptr.hpp"
+
+class AudioResampler {
+public:
+    static const uint32_t OUT_RATE = 48000;
+    static const uint16_t MAX_TAPS = 64;        // taps per phase
+
+    bool            setSampleRate(uint32_t inRate); // computes the taps if the rate changes, false if not supported
+    void            reset();                        // clears the history, e.g. after a seek
+    bool            isPassthrough() const { return m_inRate == OUT_RATE || !m_taps.valid(); }
+    uint32_t        getSampleRate() const { return m_inRate; }
+    uint16_t        getPhases() const { return m_L; }
+    uint16_t        getTaps() const { return m_T; }
+    size_t          maxOutputFrames(size_t inFrames) const { return (inFrames * m_L) / m_M + 2; }
+
+    // resamples <inFrames> interleaved stereo frames, returns the number of frames written to out (at most outMax)
+    size_t          process(const int16_t* in, size_t inFrames, int16_t* out, size_t outMax);
+
+private:
+    static const uint16_t BLOCK = 256;          // input frames per pass through m_bufL/R
+
+    uint32_t        m_inRate = 0;
+    uint16_t        m_L = 1;                    // interpolation, number of phases
+    uint16_t        m_M = 1;                    // decimation
+    uint16_t        m_T = 0;                    // taps per phase
+    uint16_t        m_stepInt = 0;              // M / L
+    uint16_t        m_stepFrac = 0;             // M % L
+    uint16_t        m_phase = 0;                // 0 ... L-1, position between two input frames
+    uint32_t        m_pos = 0;                  // newest input frame of the next output in m_bufL/R
+    ps_ptr<int16_t> m_taps;                     // [L][T], reversed, Q15
+    int16_t         m_bufL[MAX_TAPS - 1 + BLOCK] = {0}; // history + input block, left
+    int16_t         m_bufR[MAX_TAPS - 1 + BLOCK] = {0};
+};
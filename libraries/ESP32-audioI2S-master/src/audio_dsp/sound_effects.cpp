@@ -0,0 +1,163 @@
+/*
+ * sound_effects.cpp
+ *
+ * PCM cache and mixer of the sound effects, see sound_effects.h
+ */
+
+#include "sound_effects.h"
+#include "Arduino.h"
+
+static inline int16_t clip16(int32_t v) {
+    if(v > 32767) return 32767;
+    if(v < -32768) return -32768;
+    return (int16_t)v;
+}
+
+static inline uint32_t le16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+static inline uint32_t le32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int8_t SoundEffects::addWav(const uint8_t* data, size_t len) {
+    if(len < 12 || memcmp(data, "RIFF", 4) || memcmp(data + 8, "WAVE", 4)) {log_e("sound effect: not a WAV file"); return -1;}
+    uint32_t format = 0, channels = 0, sampleRate = 0, bits = 0;
+    size_t pos = 12;
+    while(pos + 8 <= len) {
+        uint32_t size = le32(data + pos + 4);
+        const uint8_t* chunk = data + pos + 8;
+        if(size > len - pos - 8) size = len - pos - 8; // truncated file
+        if(!memcmp(data + pos, "fmt ", 4) && size >= 16) {
+            format = le16(chunk);
+            channels = le16(chunk + 2);
+            sampleRate = le32(chunk + 4);
+            bits = le16(chunk + 14);
+            if(format == 0xFFFE && size >= 26) format = le16(chunk + 24); // WAVE_FORMAT_EXTENSIBLE, sub format
+        }
+        if(!memcmp(data + pos, "data", 4)) {
+            if(format != 1 || (bits != 8 && bits != 16) || channels < 1 || channels > 2) {
+                log_e("sound effect: only PCM 8/16 bit mono/stereo, format %lu, %lu bits, %lu channels", (unsigned long)format,
+                      (unsigned long)bits, (unsigned long)channels);
+                return -1;
+            }
+            uint32_t frames = size / (channels * bits / 8);
+            if(bits == 16) {
+                if(((uintptr_t)chunk & 1) == 0) return addPCM((const int16_t*)chunk, frames, channels, sampleRate);
+                ps_ptr<int16_t> tmp; // odd address, a chunk after an odd sized chunk
+                tmp.alloc(frames * channels * sizeof(int16_t), "sfx_tmp");
+                if(!tmp.valid()) return -1;
+                memcpy(tmp.get(), chunk, frames * channels * sizeof(int16_t));
+                return addPCM(tmp.get(), frames, channels, sampleRate);
+            }
+            ps_ptr<int16_t> tmp; // 8 bit unsigned
+            tmp.alloc(frames * channels * sizeof(int16_t), "sfx_tmp");
+            if(!tmp.valid()) return -1;
+            for(uint32_t i = 0; i < frames * channels; i++) tmp.get()[i] = ((int16_t)chunk[i] - 128) << 8;
+            return addPCM(tmp.get(), frames, channels, sampleRate);
+        }
+        pos += 8 + size + (size & 1); // chunks are word aligned
+    }
+    log_e("sound effect: no data chunk");
+    return -1;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int8_t SoundEffects::addPCM(const int16_t* pcm, uint32_t frames, uint8_t channels, uint32_t sampleRate) {
+    uint8_t id = m_count.load(std::memory_order_relaxed);
+    if(id >= MAX_EFFECTS) {log_e("sound effect: more than %u clips", MAX_EFFECTS); return -1;}
+    if(!frames || sampleRate < 1000 || channels < 1 || channels > 2) return -1;
+    effect_t& e = m_effect[id];
+    e.pcm.alloc(frames * channels * sizeof(int16_t), "sfx_pcm");
+    if(!e.pcm.valid()) return -1;
+    memcpy(e.pcm.get(), pcm, frames * channels * sizeof(int16_t));
+    e.frames = frames;
+    e.channels = channels;
+    e.sampleRate = sampleRate;
+    m_count.store(id + 1, std::memory_order_release); // the clip is complete before play() can see it
+    return id;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void SoundEffects::clear() {
+    m_count.store(0, std::memory_order_release);
+    m_pending.store(0);
+    for(uint8_t i = 0; i < MAX_VOICES; i++) m_voice[i].effect = nullptr;
+    m_active = false;
+    for(uint8_t i = 0; i < MAX_EFFECTS; i++) {m_effect[i].pcm.reset(); m_effect[i].frames = 0;}
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint32_t SoundEffects::durationMs(int8_t id) const {
+    if(id < 0 || id >= count()) return 0;
+    return (uint64_t)m_effect[id].frames * 1000 / m_effect[id].sampleRate;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool SoundEffects::play(int8_t id, uint8_t volume) {
+    if(id < 0 || id >= count()) return false;
+    if(volume > 100) volume = 100;
+    m_volume[id].store(volume, std::memory_order_relaxed);
+    m_pending.fetch_or(1UL << id, std::memory_order_release);
+    return true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void SoundEffects::stop() {
+    m_pending.store(0);
+    m_stop.store(true);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void IRAM_ATTR SoundEffects::mix(int16_t* samples, uint32_t frames, uint32_t sampleRate) {
+    if(m_stop.exchange(false)) {
+        for(uint8_t v = 0; v < MAX_VOICES; v++) m_voice[v].effect = nullptr;
+        m_active = false;
+    }
+    uint32_t pending = m_pending.exchange(0, std::memory_order_acquire);
+    while(pending) { // start the requested clips, a free voice or the one that has played longest
+        uint8_t id = __builtin_ctz(pending);
+        pending &= pending - 1;
+        uint8_t v = 0;
+        for(uint8_t i = 0; i < MAX_VOICES; i++) {
+            if(!m_voice[i].effect) {v = i; break;}
+            if(m_voice[i].pos > m_voice[v].pos) v = i;
+        }
+        voice_t& voice = m_voice[v];
+        voice.effect = &m_effect[id];
+        voice.pos = 0;
+        voice.frac = 0;
+        voice.step = (uint32_t)(((uint64_t)m_effect[id].sampleRate << 16) / sampleRate);
+        voice.volume = m_volume[id].load(std::memory_order_relaxed) * 32768 / 100;
+        m_active = true;
+    }
+    if(!m_active) return;
+
+    m_active = false;
+    for(uint8_t v = 0; v < MAX_VOICES; v++) {
+        voice_t& voice = m_voice[v];
+        if(!voice.effect) continue;
+        const int16_t* pcm = voice.effect->pcm.get();
+        const uint32_t last = voice.effect->frames - 1;
+        const uint8_t  ch = voice.effect->channels;
+        const int32_t  vol = voice.volume;
+        uint32_t pos = voice.pos, frac = voice.frac;
+        uint32_t i = 0;
+        if(voice.step == 0x10000) { // same sample rate, no interpolation
+            uint32_t n = last + 1 - pos < frames ? last + 1 - pos : frames;
+            for(; i < n; i++, pos++) {
+                int32_t l = pcm[pos * ch], r = pcm[pos * ch + ch - 1];
+                samples[2 * i]     = clip16(samples[2 * i]     + ((l * vol) >> 15));
+                samples[2 * i + 1] = clip16(samples[2 * i + 1] + ((r * vol) >> 15));
+            }
+        }
+        else {
+            for(; i < frames && pos < last; i++) {
+                const int16_t* a = pcm + pos * ch;
+                const int16_t* b = a + ch;
+                int32_t f = frac >> 1; // Q15, the product fits in 32 bit
+                int32_t l = a[0] + (((b[0] - a[0]) * f) >> 15);
+                int32_t r = a[ch - 1] + (((b[ch - 1] - a[ch - 1]) * f) >> 15);
+                samples[2 * i]     = clip16(samples[2 * i]     + ((l * vol) >> 15));
+                samples[2 * i + 1] = clip16(samples[2 * i + 1] + ((r * vol) >> 15));
+                frac += voice.step;
+                pos += frac >> 16;
+                frac &= 0xFFFF;
+            }
+        }
+        voice.pos = pos;
+        voice.frac = frac;
+        if(pos >= last + (voice.step == 0x10000)) voice.effect = nullptr; // finished
+        else m_active = true;
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ * sound_effects.h
+ *
+ * Short sound effects (UI clicks, notifications) that are mixed over the output of Audio::playChunk(). The clips are
+ * decoded once into a PCM cache in PSRAM (WAV, PCM 8 or 16 bit, mono or stereo, any sample rate), play() only marks
+ * a clip as requested and can be called from any task. mix() runs in the audio task, starts the requested clips and
+ * adds all playing voices to the output with saturation. Clips with another sample rate than the output are
+ * converted by linear interpolation while they are mixed.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "../psram_unique_ptr.hpp"
+
+class SoundEffects {
+public:
+    static const uint8_t MAX_EFFECTS = 8;
+    static const uint8_t MAX_VOICES = 4;       // clips that can play at the same time
+
+    int8_t          addWav(const uint8_t* data, size_t len); // returns the id of the clip or -1
+    int8_t          addPCM(const int16_t* pcm, uint32_t frames, uint8_t channels, uint32_t sampleRate);
+    void            clear();                    // frees the cache, not while mix() runs
+    uint8_t         count() const { return m_count.load(std::memory_order_acquire); }
+    uint32_t        durationMs(int8_t id) const;
+
+    bool            play(int8_t id, uint8_t volume = 100); // volume 0 ... 100 %, any task
+    void            stop();                                // any task
+    bool            isActive() const { return m_active || m_pending.load(std::memory_order_relaxed); }
+
+    void            mix(int16_t* samples, uint32_t frames, uint32_t sampleRate); // interleaved stereo, audio task
+
+private:
+    typedef struct _effect {
+        ps_ptr<int16_t> pcm;
+        uint32_t        frames = 0;
+        uint32_t        sampleRate = 0;
+        uint8_t         channels = 0;
+    } effect_t;
+
+    typedef struct _voice {
+        const effect_t* effect = nullptr;       // nullptr: free
+        uint32_t        pos = 0;                // frame
+        uint16_t        frac = 0;               // fraction of a frame, Q16
+        uint32_t        step = 0;               // Q16, clip rate / output rate
+        int32_t         volume = 0;             // Q15
+    } voice_t;
+
+    effect_t                m_effect[MAX_EFFECTS];
+    voice_t                 m_voice[MAX_VOICES];
+    std::atomic<uint8_t>    m_count{0};
+    std::atomic<uint32_t>   m_pending{0};       // bit i: clip i requested
+    std::atomic<uint8_t>    m_volume[MAX_EFFECTS] = {};
+    std::atomic<bool>       m_stop{false};
+    bool                    m_active = false;   // a voice is playing
+};
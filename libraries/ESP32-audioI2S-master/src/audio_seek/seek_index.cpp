@@ -0,0 +1,530 @@
+/*
+ * seek_index.cpp
+ *
+ * Seek index of local MP3, M4A, FLAC and OGG files, see seek_index.h
+ */
+
+#include "seek_index.h"
+#include "Arduino.h"
+
+static inline uint32_t be16(const uint8_t* p) { return (p[0] << 8) | p[1]; }
+static inline uint32_t be32(const uint8_t* p) { return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3]; }
+static inline uint64_t be64(const uint8_t* p) { return ((uint64_t)be32(p) << 32) | be32(p + 4); }
+static inline uint32_t le16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+static inline uint32_t le32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+static inline uint64_t le64(const uint8_t* p) { return le32(p) | ((uint64_t)le32(p + 4) << 32); }
+
+typedef struct _mp3Hdr {
+    uint32_t rate;
+    uint32_t spf;     // samples per frame
+    uint32_t len;     // bytes
+    uint8_t  id;      // version and layer
+    bool     mono;
+} mp3Hdr_t;
+
+static bool mp3_header(const uint8_t* p, mp3Hdr_t* h) { // layer III, MPEG 1, 2 and 2.5
+    static const uint16_t kbps1[16] = {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0};
+    static const uint16_t kbps2[16] = {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0};
+    static const uint32_t rates[3] = {44100, 48000, 32000};
+    if(p[0] != 0xFF || (p[1] & 0xE0) != 0xE0) return false;
+    uint8_t version = (p[1] >> 3) & 3; // 0: MPEG 2.5, 1: reserved, 2: MPEG 2, 3: MPEG 1
+    uint8_t layer = (p[1] >> 1) & 3;   // 1: layer III
+    uint8_t brIdx = p[2] >> 4, srIdx = (p[2] >> 2) & 3;
+    if(version == 1 || layer != 1 || brIdx == 0 || brIdx == 15 || srIdx == 3) return false; // no free format
+    h->rate = rates[srIdx] >> (version == 3 ? 0 : version == 2 ? 1 : 2);
+    h->spf = version == 3 ? 1152 : 576;
+    uint32_t kbps = version == 3 ? kbps1[brIdx] : kbps2[brIdx];
+    h->len = (h->spf / 8) * kbps * 1000 / h->rate + ((p[2] >> 1) & 1);
+    h->id = p[1] & 0x1E;
+    h->mono = (p[3] >> 6) == 3;
+    return true;
+}
+
+static uint8_t crc8(const uint8_t* p, uint32_t n) { // FLAC frame header, polynomial x^8 + x^2 + x + 1
+    uint8_t crc = 0;
+    while(n--) {
+        crc ^= *p++;
+        for(int i = 0; i < 8; i++) crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+    }
+    return crc;
+}
+
+static bool flac_header(const uint8_t* p, uint32_t n, uint64_t* number, bool* variable) { // n >= 16
+    if(n < 16 || p[0] != 0xFF || (p[1] & 0xFE) != 0xF8) return false;
+    uint8_t bsCode = p[2] >> 4, srCode = p[2] & 15, chCode = p[3] >> 4, ssCode = (p[3] >> 1) & 7;
+    if(bsCode == 0 || srCode == 15 || chCode > 10 || ssCode == 3 || (p[3] & 1)) return false;
+    uint8_t c = p[4], len;
+    uint64_t v;
+    if(!(c & 0x80))          {v = c;        len = 1;} // UTF-8 coded frame or sample number
+    else if((c & 0xE0) == 0xC0) {v = c & 0x1F; len = 2;}
+    else if((c & 0xF0) == 0xE0) {v = c & 0x0F; len = 3;}
+    else if((c & 0xF8) == 0xF0) {v = c & 0x07; len = 4;}
+    else if((c & 0xFC) == 0xF8) {v = c & 0x03; len = 5;}
+    else if((c & 0xFE) == 0xFC) {v = c & 0x01; len = 6;}
+    else if(c == 0xFE)          {v = 0;        len = 7;}
+    else return false;
+    for(uint8_t k = 1; k < len; k++) {
+        if((p[4 + k] & 0xC0) != 0x80) return false;
+        v = (v << 6) | (p[4 + k] & 0x3F);
+    }
+    uint32_t i = 4 + len;
+    if(bsCode == 6) i += 1;
+    if(bsCode == 7) i += 2;
+    if(srCode == 12) i += 1;
+    if(srCode == 13 || srCode == 14) i += 2;
+    if(crc8(p, i) != p[i]) return false;
+    *number = v;
+    *variable = p[1] & 1;
+    return true;
+}
+
+static uint32_t flac_blockSize(const uint8_t* p) { // of a valid frame header
+    uint8_t bsCode = p[2] >> 4;
+    if(bsCode == 1) return 192;
+    if(bsCode <= 5) return 576 << (bsCode - 2);
+    if(bsCode >= 8) return 256 << (bsCode - 8);
+    uint32_t i = 5; // the UTF-8 number ends at the first byte without 10xxxxxx
+    while((p[i] & 0xC0) == 0x80) i++;
+    return bsCode == 6 ? p[i] + 1 : be16(p + i) + 1;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void SeekIndex::reset() {
+    m_format = SI_NONE;
+    m_complete = false;
+    m_reads = 0;
+    m_rate = 0;
+    m_durationMs = 0;
+    m_numPoints = 0;
+    m_cur = point_t();
+    m_hasToc = false;
+    m_points.reset();
+    m_block.buf.reset();
+    m_block.len = 0;
+    table_t* tables[4] = {&m_stts, &m_stsc, &m_stco, &m_stsz};
+    for(table_t* t : tables) {t->cache.buf.reset(); t->cache.len = 0; t->count = 0;}
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool SeekIndex::allocate() {
+    m_format = SI_NONE;
+    if(!m_read) return false;
+    if(!m_points.valid()) m_points.alloc_array(MAX_POINTS, "seekIndex");
+    if(!m_block.buf.valid()) {m_block.buf.alloc(BLOCK_SIZE, "seekBlock"); m_block.size = BLOCK_SIZE;}
+    m_block.len = 0;
+    m_numPoints = 0;
+    m_complete = false;
+    m_reads = 0;
+    m_durationMs = 0;
+    m_cur = point_t();
+    m_hasToc = false;
+    m_tocBytes = 0;
+    m_blockSize = 0;
+    m_totalSamples = 0;
+    m_preSkip = 0;
+    m_sampleSize = 0;
+    return m_points.valid() && m_block.buf.valid();
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+const uint8_t* SeekIndex::get(cache_t& c, uint32_t pos, uint32_t n) { // n bytes at pos, nullptr at the end of the file
+    if(covers(c, pos, n)) return c.buf.get() + (pos - c.pos);
+    if(n > c.size) return nullptr;
+    int32_t res = m_read(m_user, pos, c.buf.get(), c.size);
+    m_reads++;
+    if(res < (int32_t)n) {c.len = 0; return nullptr;}
+    c.pos = pos;
+    c.len = res;
+    return c.buf.get();
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void SeekIndex::addPoint(const point_t& p) {
+    if(m_numPoints && p.time < m_points[m_numPoints - 1].time + m_step) return;
+    if(m_numPoints == MAX_POINTS) { // keep every second point
+        for(uint16_t i = 0; i < MAX_POINTS / 2; i++) m_points[i] = m_points[2 * i];
+        m_numPoints = MAX_POINTS / 2;
+        m_step *= 2;
+        if(p.time < m_points[m_numPoints - 1].time + m_step) return;
+    }
+    m_points[m_numPoints++] = p;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+int32_t SeekIndex::findPoint(uint64_t time) const {
+    int32_t lo = 0, hi = m_numPoints - 1, res = -1;
+    while(lo <= hi) {
+        int32_t mid = (lo + hi) / 2;
+        if(m_points[mid].time <= time) {res = mid; lo = mid + 1;}
+        else hi = mid - 1;
+    }
+    return res;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool SeekIndex::beginMP3(uint32_t dataStart, uint32_t dataEnd) {
+    if(!allocate()) return false;
+    m_dataStart = dataStart;
+    m_dataEnd = dataEnd;
+    const uint8_t* p = get(m_block, dataStart, 4);
+    if(!p) return false;
+    mp3Hdr_t h, h2;
+    uint32_t i = 0;
+    for(; i + 4 <= m_block.len; i++) { // the first frame, two headers in a row
+        if(!mp3_header(p + i, &h)) continue;
+        if(i + h.len + 4 > m_block.len) break;
+        if(mp3_header(p + i + h.len, &h2) && h2.id == h.id && h2.rate == h.rate) break;
+    }
+    if(i + 4 > m_block.len || !mp3_header(p + i, &h)) return false;
+    m_rate = h.rate;
+    m_spf = h.spf;
+    m_mp3Id = h.id;
+    m_step = m_rate; // one second
+    m_dataStart = dataStart + i;
+    m_cur.pos = m_dataStart;
+
+    // Xing or Info frame (VBR and CBR from LAME), VBRI (Fraunhofer), both are a frame without audio in front of the stream
+    const uint8_t* f = get(m_block, m_cur.pos, 4 + 36 + 26);
+    uint32_t frames = 0;
+    if(f) {
+        uint32_t side = (m_spf == 1152) ? (h.mono ? 17 : 32) : (h.mono ? 9 : 17);
+        const uint8_t* x = f + 4 + side;
+        const uint8_t* v = f + 4 + 32;
+        if(!memcmp(x, "Xing", 4) || !memcmp(x, "Info", 4)) {
+            const uint8_t* q = get(m_block, m_cur.pos, 4 + side + 8 + 108);
+            if(q) {
+                x = q + 4 + side;
+                uint32_t flags = be32(x + 4);
+                x += 8;
+                if(flags & 1) {frames = be32(x); x += 4;}
+                if(flags & 2) {m_tocBytes = be32(x); x += 4;}
+                if(flags & 4) {memcpy(m_toc, x, 100); m_hasToc = true;}
+            }
+        }
+        else if(!memcmp(v, "VBRI", 4)) {
+            m_tocBytes = be32(v + 10);
+            frames = be32(v + 14);
+            uint32_t entries = be16(v + 18), scale = be16(v + 20), entrySize = be16(v + 22), fpe = be16(v + 24);
+            const uint8_t* q = get(m_block, m_cur.pos + 4 + 32 + 26, entries * entrySize);
+            if(q && entries && frames && m_tocBytes && entrySize >= 1 && entrySize <= 4) { // to a TOC of 100 entries as Xing
+                uint32_t entry = 0, bytes = 0, frame = 0;
+                for(uint8_t pct = 0; pct < 100; pct++) {
+                    uint32_t target = (uint64_t)frames * pct / 100;
+                    while(entry < entries && frame + fpe <= target) {
+                        uint32_t e = 0;
+                        for(uint32_t k = 0; k < entrySize; k++) e = (e << 8) | q[entry * entrySize + k];
+                        bytes += e * scale;
+                        frame += fpe;
+                        entry++;
+                    }
+                    uint32_t toc = (uint64_t)bytes * 256 / m_tocBytes;
+                    m_toc[pct] = toc > 255 ? 255 : toc;
+                }
+                m_hasToc = true;
+            }
+        }
+    }
+    if(!m_tocBytes) m_tocBytes = dataEnd - m_cur.pos;
+    if(frames) m_durationMs = (uint64_t)frames * m_spf * 1000 / m_rate;
+    m_format = SI_MP3;
+    return true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool SeekIndex::mp3Walk(point_t& c, uint64_t target) { // from frame c to the frame that contains target, or the last one
+    mp3Hdr_t h;
+    const uint8_t* p = get(m_block, c.pos, 4);
+    if(!p || !mp3_header(p, &h) || h.id != m_mp3Id || h.rate != m_rate) return false; // c is no frame
+    while(c.time + m_spf <= target) {
+        uint32_t next = c.pos + h.len;
+        if(next + 4 > m_dataEnd) break;
+        p = get(m_block, next, 4);
+        if(!p || !mp3_header(p, &h) || h.id != m_mp3Id || h.rate != m_rate) break; // ID3v1 tag or the end
+        c.pos = next;
+        c.frame++;
+        c.time += m_spf;
+    }
+    return true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool SeekIndex::beginFLAC(uint32_t dataStart, uint32_t dataEnd, uint32_t sampleRate, uint64_t totalSamples, uint32_t seekTablePos,
+                          uint32_t seekTableLen) {
+    if(!sampleRate || !allocate()) return false;
+    m_dataStart = dataStart;
+    m_dataEnd = dataEnd;
+    m_rate = sampleRate;
+    m_totalSamples = totalSamples;
+    m_step = 1;
+    const uint8_t* p = get(m_block, dataStart, 16);
+    uint64_t number;
+    bool variable;
+    if(!p || !flac_header(p, m_block.len, &number, &variable)) return false;
+    m_blockSize = flac_blockSize(p);
+    point_t pt = {};
+    pt.pos = dataStart;
+    addPoint(pt);
+    for(uint32_t i = 0; i + 18 <= seekTableLen; i += 18) { // SEEKTABLE: sample, offset from the first frame, samples
+        const uint8_t* s = get(m_block, seekTablePos + i, 18);
+        if(!s) break;
+        uint64_t sample = be64(s), offset = be64(s + 8);
+        if(sample == UINT64_MAX) break;  // placeholder, the rest too
+        if(sample > UINT32_MAX || dataStart + offset >= dataEnd) break;
+        pt.time = sample;
+        pt.pos = dataStart + offset;
+        if(pt.time > m_points[m_numPoints - 1].time) addPoint(pt);
+    }
+    if(totalSamples) m_durationMs = totalSamples * 1000 / sampleRate;
+    m_complete = true; // nothing to build
+    m_format = SI_FLAC;
+    return true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool SeekIndex::beginOGG(uint32_t dataStart, uint32_t dataEnd) {
+    if(!allocate()) return false;
+    m_dataStart = dataStart;
+    m_dataEnd = dataEnd;
+    const uint8_t* p = get(m_block, dataStart, 27 + 1 + 19);
+    if(!p || memcmp(p, "OggS", 4) || p[4] != 0) return false;
+    uint32_t nSeg = p[26];
+    p = get(m_block, dataStart, 27 + nSeg + 30);
+    if(!p) return false;
+    const uint8_t* packet = p + 27 + nSeg;
+    m_serial = le32(p + 14);
+    m_preSkip = 0;
+    if(!memcmp(packet, "OpusHead", 8)) {m_rate = 48000; m_preSkip = le16(packet + 10);} // the granule counts at 48kHz
+    else if(!memcmp(packet, "\x01vorbis", 7)) m_rate = le32(packet + 12);
+    else return false;
+    if(!m_rate) return false;
+    m_format = SI_OGG;
+
+    // the granule position of the last page is the length
+    probe_t last;
+    for(uint32_t n = 1; n <= 16 && !m_durationMs; n++) {
+        if(dataEnd < dataStart + n * (BLOCK_SIZE - 27)) break;
+        uint32_t from = dataEnd - n * (BLOCK_SIZE - 27);
+        probe_t pg;
+        uint32_t at = from;
+        bool found = false;
+        while(probe(at, from + BLOCK_SIZE, &pg)) {last = pg; found = true; at = pg.pos + pg.len;}
+        if(found && last.time > m_preSkip) m_durationMs = (last.time - m_preSkip) * 1000 / m_rate;
+    }
+    m_complete = true; // nothing to build
+    return true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool SeekIndex::probe(uint32_t pos, uint32_t end, probe_t* pg) {
+    // FLAC: the first frame header at pos ... end, OGG: the first page of the stream with a granule position
+    const uint32_t need = (m_format == SI_OGG) ? 27 : 16; // page header without the segment table, longest frame header
+    uint32_t limit = end < m_dataEnd ? end : m_dataEnd;
+    uint32_t scanned = 0;
+    while(pos + need <= limit && scanned < 16 * BLOCK_SIZE) {
+        uint32_t n = m_dataEnd - pos < BLOCK_SIZE ? m_dataEnd - pos : BLOCK_SIZE;
+        const uint8_t* p = get(m_block, pos, n);
+        if(!p) return false;
+        uint32_t i = 0, skipTo = 0;
+        for(; i + need <= n && pos + i < limit; i++) {
+            if(need == 16) { // FLAC
+                uint64_t number;
+                bool variable;
+                if(p[i] != 0xFF || !flac_header(p + i, n - i, &number, &variable)) continue;
+                uint64_t sample = variable ? number : number * m_blockSize;
+                if(m_totalSamples && sample >= m_totalSamples) continue; // no frame header, a sync pattern in the data
+                pg->time = sample;
+                pg->pos = pos + i;
+                pg->len = 0;
+                return true;
+            }
+            if(p[i] != 'O' || memcmp(p + i, "OggS", 4) || p[i + 4] != 0) continue;
+            uint8_t nSeg = p[i + 26];
+            const uint8_t* h = get(m_block, pos + i, 27 + nSeg); // the segment table, the block may move
+            if(!h) return false;
+            uint32_t len = 27 + nSeg;
+            for(uint32_t s = 0; s < nSeg; s++) len += h[27 + s];
+            uint64_t granule = le64(h + 6);
+            if(le32(h + 14) != m_serial || granule == UINT64_MAX) {skipTo = pos + i + len; break;} // another stream, no packet ends here
+            pg->time = granule;
+            pg->pos = pos + i;
+            pg->len = len;
+            return true;
+        }
+        if(skipTo) {scanned += skipTo - pos; pos = skipTo; continue;}
+        if(i == 0) break;
+        pos += i;
+        scanned += i;
+    }
+    return false;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool SeekIndex::bisect(uint64_t target, probe_t lo, uint32_t hi, probe_t* res) {
+    // lo: a frame or page at or before the target, hi: the frames or pages from here on are after it
+    probe_t q;
+    for(uint8_t i = 0; i < 40 && hi > lo.pos + BLOCK_SIZE; i++) {
+        uint32_t mid = lo.pos + (hi - lo.pos) / 2;
+        if(!probe(mid, hi, &q)) {hi = mid; continue;}
+        if(q.time <= target) lo = q;
+        else hi = mid;
+    }
+    for(uint8_t i = 0; i < 64; i++) { // the rest frame by frame
+        if(!probe(lo.pos + (lo.len ? lo.len : 1), m_dataEnd, &q) || q.time > target) break;
+        lo = q;
+    }
+    *res = lo;
+    return true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool SeekIndex::beginM4A(uint32_t mdhdPos, uint32_t sttsPos, uint32_t stscPos, uint32_t stcoPos, uint32_t stszPos) {
+    if(!mdhdPos || !sttsPos || !stscPos || !stcoPos || !stszPos || !allocate()) return false;
+    const uint8_t* p = get(m_block, mdhdPos, 44);
+    if(!p || memcmp(p + 4, "mdhd", 4)) return false;
+    uint64_t duration;
+    if(p[8] == 1) {m_rate = be32(p + 28); duration = be64(p + 32);}
+    else          {m_rate = be32(p + 20); duration = be32(p + 24);}
+    if(!m_rate) return false;
+    m_durationMs = duration * 1000 / m_rate;
+    m_step = m_rate;
+
+    struct { table_t* t; uint32_t pos; const char* name; uint8_t entrySize; } tables[4] = {
+        {&m_stts, sttsPos, "stts", 8}, {&m_stsc, stscPos, "stsc", 12}, {&m_stco, stcoPos, "stco", 4}, {&m_stsz, stszPos, "stsz", 4}};
+    for(auto& tb : tables) {
+        p = get(m_block, tb.pos, 20);
+        if(!p) return false;
+        if(tb.t == &m_stco && !memcmp(p + 4, "co64", 4)) tb.entrySize = 8;
+        else if(memcmp(p + 4, tb.name, 4)) return false;
+        if(tb.t == &m_stsz) {
+            m_sampleSize = be32(p + 12);
+            tb.t->count = be32(p + 16);
+            tb.t->pos = tb.pos + 20;
+        }
+        else {
+            tb.t->count = be32(p + 12);
+            tb.t->pos = tb.pos + 16;
+        }
+        tb.t->entrySize = tb.entrySize;
+        tb.t->cache.len = 0;
+        if(!tb.t->cache.buf.valid()) {tb.t->cache.buf.alloc(TABLE_CACHE, "seekTable"); tb.t->cache.size = TABLE_CACHE;}
+        if(!tb.t->cache.buf.valid()) return false;
+    }
+    m_numFrames = m_stsz.count;
+    if(!m_numFrames || !m_stts.count || !m_stsc.count || !m_stco.count) return false;
+    const uint8_t* e = m4aEntry(m_stco, 0);
+    if(!e) return false;
+    m_cur.pos = m_stco.entrySize == 8 ? (uint32_t)be64(e) : be32(e);
+    m_format = SI_M4A;
+    return true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+const uint8_t* SeekIndex::m4aEntry(table_t& t, uint32_t idx) {
+    if(idx >= t.count) return nullptr;
+    uint32_t pos = t.pos + idx * t.entrySize;
+    if(covers(t.cache, pos, t.entrySize)) return t.cache.buf.get() + (pos - t.cache.pos);
+    uint32_t n = (t.count - idx) * t.entrySize; // read the table ahead, not more
+    if(n > t.cache.size) n = t.cache.size - t.cache.size % t.entrySize;
+    t.cache.len = 0;
+    int32_t res = m_read(m_user, pos, t.cache.buf.get(), n);
+    m_reads++;
+    if(res < (int32_t)t.entrySize) return nullptr;
+    t.cache.pos = pos;
+    t.cache.len = res;
+    return t.cache.buf.get();
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool SeekIndex::m4aNext(point_t& c) { // to the next frame (AAC access unit): stsz, stts, stsc and stco
+    if(c.frame + 1 >= m_numFrames) return false;
+    const uint8_t* e;
+    uint32_t size = m_sampleSize;
+    if(!size) {if(!(e = m4aEntry(m_stsz, c.frame))) return false; size = be32(e);}
+    if(!(e = m4aEntry(m_stts, c.stts))) return false;
+    uint32_t sttsCount = be32(e), delta = be32(e + 4);
+    if(!(e = m4aEntry(m_stsc, c.stsc))) return false;
+    uint32_t spc = be32(e + 4);
+    c.pos += size;
+    c.time += delta;
+    c.frame++;
+    if(c.frame - c.sttsFirst >= sttsCount) {c.stts++; c.sttsFirst = c.frame;}
+    if(++c.inChunk >= spc) {
+        c.chunk++;
+        c.inChunk = 0;
+        if((e = m4aEntry(m_stsc, c.stsc + 1)) && be32(e) - 1 <= c.chunk) c.stsc++; // first chunk counts from 1
+        if(!(e = m4aEntry(m_stco, c.chunk))) return false;
+        c.pos = m_stco.entrySize == 8 ? (uint32_t)be64(e) : be32(e);
+    }
+    return true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool SeekIndex::build() {
+    if(m_complete || (m_format != SI_MP3 && m_format != SI_M4A)) return false;
+    uint32_t reads = m_reads;
+    mp3Hdr_t h;
+    while(m_reads == reads) { // one block per call
+        if(m_format == SI_MP3) {
+            const uint8_t* p = (m_cur.pos + 4 <= m_dataEnd) ? get(m_block, m_cur.pos, 4) : nullptr;
+            if(!p || !mp3_header(p, &h) || h.id != m_mp3Id || h.rate != m_rate) {m_complete = true; break;} // ID3v1 tag or the end
+            addPoint(m_cur);
+            m_cur.pos += h.len;
+            m_cur.frame++;
+            m_cur.time += m_spf;
+        }
+        else {
+            addPoint(m_cur);
+            if(!m4aNext(m_cur)) {m_complete = true; break;}
+        }
+    }
+    return !m_complete;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool SeekIndex::seek(uint32_t ms, uint32_t* pos, uint32_t* landedMs, bool* exact) {
+    if(m_format == SI_NONE) return false;
+    uint64_t target = (uint64_t)ms * m_rate / 1000;
+    if(exact) *exact = true;
+
+    if(m_format == SI_FLAC || m_format == SI_OGG) {
+        if(m_format == SI_OGG) target += m_preSkip;
+        if(m_totalSamples && target >= m_totalSamples) target = m_totalSamples - 1;
+        probe_t lo, res;
+        uint32_t hi = m_dataEnd;
+        int32_t i = findPoint(target);
+        if(m_format == SI_FLAC && i >= 0) {
+            lo.time = m_points[i].time;
+            lo.pos = m_points[i].pos;
+            if(i + 1 < m_numPoints) hi = m_points[i + 1].pos + 1; // the next seek point is after the target
+        }
+        else if(!probe(m_dataStart, m_dataEnd, &lo) || lo.time > target) { // the header pages end at granule 0
+            return false;
+        }
+        bisect(target, lo, hi, &res);
+        if(m_format == SI_FLAC) {
+            *pos = res.pos;
+            *landedMs = res.time * 1000 / m_rate;
+        }
+        else { // decoding starts with the page after the last one that ends before the target
+            *pos = res.pos + res.len;
+            *landedMs = (res.time > m_preSkip ? res.time - m_preSkip : 0) * 1000 / m_rate;
+        }
+        return true;
+    }
+
+    // MP3, M4A: walk from the last point before the target
+    point_t c = {};
+    int32_t i = findPoint(target);
+    if(m_complete || target < m_cur.time) {
+        if(i < 0) return false;
+        c = m_points[i];
+    }
+    else if(target - m_cur.time <= m_step) c = m_cur; // a little after the built part
+    else if(m_format == SI_MP3 && m_hasToc && m_durationMs) { // not yet indexed, estimate with the TOC
+        float pct = (float)ms * 100 / m_durationMs;
+        if(pct > 99.99f) pct = 99.99f;
+        uint8_t k = (uint8_t)pct;
+        float a = m_toc[k], b = (k < 99) ? m_toc[k + 1] : 256;
+        float x = a + (b - a) * (pct - k);
+        *pos = m_dataStart + (uint32_t)(x * m_tocBytes / 256);
+        *landedMs = ms;
+        if(exact) *exact = false;
+        return true;
+    }
+    else return false;
+
+    if(m_format == SI_MP3) {
+        if(!mp3Walk(c, target)) return false;
+    }
+    else {
+        point_t n = c;
+        for(uint32_t k = 0; k < 0x10000 && m4aNext(n) && n.time <= target; k++) c = n;
+    }
+    *pos = c.pos;
+    *landedMs = (uint64_t)c.time * 1000 / m_rate;
+    return true;
+}
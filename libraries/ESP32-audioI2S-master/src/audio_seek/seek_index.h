@@ -0,0 +1,124 @@
+/*
+ * seek_index.h
+ *
+ * Time -> file position of the frame (MP3, AAC in M4A, FLAC) or the page (OGG) that contains it, for local files.
+ * begin...() gets the positions the header parser of Audio found and reads the rest through the reader callback:
+ * the Xing or VBRI TOC of MP3, the tables stts, stsc, stco and stsz of M4A, the SEEKTABLE of FLAC, the first and
+ * the last page of OGG. MP3 and M4A are indexed lazily: each build() reads one block, walks the frame headers (MP3)
+ * or the sample tables (M4A) and keeps one point per step, at most MAX_POINTS (the step doubles if they are full).
+ * seek() walks from the last point before the target to the frame, FLAC and OGG are bisected over the sample number
+ * in the frame header or the granule position of the page, between the points of the SEEKTABLE if there is one.
+ * A seek reads a bounded number of blocks and lands on the start of the frame that contains the target, OGG on the
+ * page after the last one that ends before it. As long as the MP3 walk has not reached the target, the TOC gives
+ * an estimate and the caller searches the sync word as before.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "../psram_unique_ptr.hpp"
+
+class SeekIndex {
+public:
+    typedef int32_t (*read_t)(void* user, uint32_t pos, uint8_t* buf, uint32_t len); // bytes read at pos, < 0: error
+
+    enum : uint8_t { SI_NONE = 0, SI_MP3 = 1, SI_M4A = 2, SI_FLAC = 3, SI_OGG = 4 };
+    static const uint16_t MAX_POINTS = 512;
+    static const uint32_t BLOCK_SIZE = 4096;     // one read of the frame walk, the bisection and the build
+    static const uint32_t TABLE_CACHE = 512;     // one read of an M4A table
+
+    void        setReader(read_t read, void* user) { m_read = read; m_user = user; }
+    void        reset();                         // frees the index and the buffers
+    bool        beginMP3(uint32_t dataStart, uint32_t dataEnd);
+    bool        beginFLAC(uint32_t dataStart, uint32_t dataEnd, uint32_t sampleRate, uint64_t totalSamples, uint32_t seekTablePos = 0,
+                          uint32_t seekTableLen = 0); // seekTablePos: first seek point of the SEEKTABLE block
+    bool        beginM4A(uint32_t mdhdPos, uint32_t sttsPos, uint32_t stscPos, uint32_t stcoPos, uint32_t stszPos); // atom positions
+    bool        beginOGG(uint32_t dataStart, uint32_t dataEnd); // OPUS or VORBIS
+    bool        build();                         // reads one block, returns true while there is more to do
+    bool        seek(uint32_t ms, uint32_t* pos, uint32_t* landedMs, bool* exact = nullptr); // false: no index, estimate the position
+
+    uint8_t     format() const { return m_format; }
+    bool        isComplete() const { return m_complete; }
+    uint32_t    durationMs() const { return m_durationMs; } // Xing/VBRI frames, mdhd, STREAMINFO or the last OGG page, 0: unknown
+    uint16_t    numPoints() const { return m_numPoints; }
+    uint32_t    reads() const { return m_reads; }           // blocks read since begin...()
+
+private:
+    typedef struct _point {     // no member initializers: ps_ptr clears it with memset
+        uint32_t time;          // first sample of the frame (MP3, FLAC), units of the media timescale (M4A)
+        uint32_t pos;           // file position of the frame
+        uint32_t frame;         // MP3, M4A: number of the frame, the state of the table walk follows
+        uint32_t chunk;         // M4A: chunk of the frame (stco)
+        uint32_t inChunk;       // M4A: frame within the chunk
+        uint32_t stsc;          // M4A: entry of stsc for this chunk
+        uint32_t stts;          // M4A: entry of stts for this frame
+        uint32_t sttsFirst;     // M4A: first frame of this stts entry
+    } point_t;
+
+    typedef struct _probe {     // frame header (FLAC) or page (OGG) found by probe()
+        uint64_t time = 0;      // FLAC: first sample, OGG: granule position (last sample)
+        uint32_t pos = 0;
+        uint32_t len = 0;       // OGG: length of the page
+    } probe_t;
+
+    typedef struct _cache {     // a window of the file
+        ps_ptr<uint8_t> buf;
+        uint32_t size = 0;
+        uint32_t pos = 0;
+        uint32_t len = 0;
+    } cache_t;
+
+    typedef struct _table {     // M4A sample table
+        uint32_t pos = 0;       // first entry
+        uint32_t count = 0;
+        uint8_t  entrySize = 0;
+        cache_t  cache;
+    } table_t;
+
+    bool            allocate();
+    const uint8_t*  get(cache_t& c, uint32_t pos, uint32_t n);
+    bool            covers(const cache_t& c, uint32_t pos, uint32_t n) const { return c.len && pos >= c.pos && pos + n <= c.pos + c.len; }
+    void            addPoint(const point_t& p);
+    int32_t         findPoint(uint64_t time) const; // last point at or before time, -1: none
+
+    bool            mp3Walk(point_t& c, uint64_t target);
+    bool            m4aNext(point_t& c);
+    const uint8_t*  m4aEntry(table_t& t, uint32_t idx);
+    bool            probe(uint32_t pos, uint32_t end, probe_t* p); // first frame or page at pos ... end
+    bool            bisect(uint64_t target, probe_t lo, uint32_t hi, probe_t* res);
+
+    read_t          m_read = nullptr;
+    void*           m_user = nullptr;
+    uint8_t         m_format = SI_NONE;
+    bool            m_complete = false;
+    uint32_t        m_reads = 0;
+    uint32_t        m_dataStart = 0;
+    uint32_t        m_dataEnd = 0;
+    uint32_t        m_rate = 0;              // time units per second
+    uint32_t        m_durationMs = 0;
+    uint32_t        m_step = 0;              // time between two points
+    ps_ptr<point_t> m_points;
+    uint16_t        m_numPoints = 0;
+    point_t         m_cur = {};              // MP3, M4A: the build has reached this frame
+    cache_t         m_block;
+
+    // MP3
+    uint32_t        m_spf = 0;               // samples per frame
+    uint8_t         m_mp3Id = 0;             // version and layer bits of the first frame
+    bool            m_hasToc = false;
+    uint8_t         m_toc[100] = {};         // Xing, VBRI converted: file position of each percent * 256 / m_tocBytes
+    uint32_t        m_tocBytes = 0;
+
+    // FLAC
+    uint32_t        m_blockSize = 0;         // of the first frame, fixed block size streams count frames
+    uint64_t        m_totalSamples = 0;
+
+    // OGG
+    uint32_t        m_serial = 0;
+    uint32_t        m_preSkip = 0;           // OPUS
+
+    // M4A
+    table_t         m_stts, m_stsc, m_stco, m_stsz;
+    uint32_t        m_sampleSize = 0;        // stsz: all frames have this size, no table
+    uint32_t        m_numFrames = 0;
+};
@@ -0,0 +1,155 @@
+/*
+ * audio_stats.cpp
+ *
+ * Statistics of the stages of Audio, see audio_stats.h
+ */
+
+#include "audio_stats.h"
+#include "Arduino.h"
+
+static inline uint8_t hist_bin(uint32_t us) { // floor(log2(us))
+    if(us < 2) return 0;
+    uint8_t k = 31 - __builtin_clz(us);
+    return k < AUDIO_HIST_BINS ? k : AUDIO_HIST_BINS - 1;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint32_t audio_hist_t::percentileUs(uint8_t p) const {
+    if(!count) return 0;
+    if(p > 100) p = 100;
+    uint64_t rank = ((uint64_t)count * p + 99) / 100; // the rank-th smallest value
+    if(!rank) rank = 1;
+    uint64_t n = 0;
+    for(uint8_t k = 0; k < AUDIO_HIST_BINS - 1; k++) {
+        n += bin[k];
+        if(n >= rank) return min((uint32_t)(2u << k) - 1, maxUs);
+    }
+    return maxUs;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioStats::hist_t::add(uint32_t us) {
+    inc(bin[hist_bin(us)]);
+    inc(count);
+    if(us > maxUs.load(std::memory_order_relaxed)) maxUs.store(us, std::memory_order_relaxed);
+    fracUs += us;
+    if(fracUs >= 1000) {inc(sumMs, fracUs / 1000); fracUs %= 1000;}
+}
+
+void AudioStats::hist_t::clear() {
+    for(uint8_t k = 0; k < AUDIO_HIST_BINS; k++) bin[k].store(0, std::memory_order_relaxed);
+    count.store(0, std::memory_order_relaxed);
+    maxUs.store(0, std::memory_order_relaxed);
+    sumMs.store(0, std::memory_order_relaxed);
+    fracUs = 0;
+}
+
+void AudioStats::hist_t::copy(audio_hist_t& h) const {
+    for(uint8_t k = 0; k < AUDIO_HIST_BINS; k++) h.bin[k] = bin[k].load(std::memory_order_relaxed);
+    h.count = count.load(std::memory_order_relaxed);
+    h.maxUs = maxUs.load(std::memory_order_relaxed);
+    h.sumMs = sumMs.load(std::memory_order_relaxed);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioStats::reset(uint32_t nowMs) {
+    resetFetch(nowMs);
+    resetAudio(nowMs);
+    m_resetsApplied = m_resetRequests.load(std::memory_order_relaxed);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioStats::requestReset(uint32_t nowMs) {
+    // a new stream while the audio task may write: the audio values are reset by the audio task itself, so that a
+    // connect never has to wait for it (Audio takes mutex_audioTask and mutex_playAudioData in opposite orders)
+    resetFetch(nowMs);
+    m_resetRequests.store(m_resetRequests.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+bool AudioStats::applyReset() {
+    uint32_t n = m_resetRequests.load(std::memory_order_acquire);
+    if(n == m_resetsApplied) return false;
+    resetAudio(m_startMs.load(std::memory_order_relaxed));
+    m_resetsApplied = n;
+    return true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioStats::resetFetch(uint32_t nowMs) {
+    m_startMs.store(nowMs, std::memory_order_relaxed);
+    m_bytes.store(0, std::memory_order_relaxed);
+    m_bytesPerSec.store(0, std::memory_order_relaxed);
+    m_rateMs.store(nowMs, std::memory_order_relaxed);
+    m_windowMs = nowMs;
+    m_windowBytes = 0;
+    m_read.clear();
+}
+
+void AudioStats::resetAudio(uint32_t nowMs) {
+    m_inBuffMin.store(UINT32_MAX, std::memory_order_relaxed);
+    for(uint8_t i = 0; i < AUDIO_FILL_HISTORY; i++) m_fillHistory[i].store(0, std::memory_order_relaxed);
+    m_fillCount.store(0, std::memory_order_relaxed);
+    m_secondMs = nowMs;
+    m_secondMin = 100;
+    for(uint8_t c = 0; c < AUDIO_STATS_CODECS; c++) m_decode[c].clear();
+    m_decodeErrors.store(0, std::memory_order_relaxed);
+    m_decoding = false;
+    m_resyncs.store(0, std::memory_order_relaxed);
+    m_bytesSkipped.store(0, std::memory_order_relaxed);
+    m_i2sWrite.clear();
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioStats::fetched(uint32_t bytes, uint32_t us, uint32_t nowMs) {
+    m_read.add(us);
+    inc(m_bytes, bytes);
+
+    m_windowBytes += bytes;
+    uint32_t elapsed = nowMs - m_windowMs;
+    if(elapsed >= 1000) {
+        m_bytesPerSec.store((uint64_t)m_windowBytes * 1000 / elapsed, std::memory_order_relaxed);
+        m_rateMs.store(nowMs, std::memory_order_relaxed);
+        m_windowBytes = 0;
+        m_windowMs = nowMs;
+    }
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioStats::inBuffFill(uint32_t filled, uint32_t size, uint32_t nowMs) {
+    if(filled < m_inBuffMin.load(std::memory_order_relaxed)) m_inBuffMin.store(filled, std::memory_order_relaxed);
+
+    if(nowMs - m_secondMs >= 1000) { // one entry per second, a pause of the task gives no entries
+        uint32_t n = m_fillCount.load(std::memory_order_relaxed);
+        m_fillHistory[n % AUDIO_FILL_HISTORY].store(m_secondMin, std::memory_order_relaxed);
+        m_fillCount.store(n + 1, std::memory_order_release); // the entry before the count
+        m_secondMs = nowMs;
+        m_secondMin = 100;
+    }
+    uint8_t percent = size ? (uint64_t)filled * 100 / size : 0;
+    if(percent < m_secondMin) m_secondMin = percent;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioStats::decoded(uint8_t codec, uint32_t us) {
+    if(codec >= AUDIO_STATS_CODECS) return;
+    m_decode[codec].add(us);
+    m_decoding = true;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AudioStats::snapshot(audio_stats_t& s, uint32_t nowMs) const {
+    s.periodMs = nowMs - m_startMs.load(std::memory_order_relaxed);
+    s.bytesFetched = m_bytes.load(std::memory_order_relaxed);
+    s.bytesPerSec = nowMs - m_rateMs.load(std::memory_order_relaxed) < 2000 ? m_bytesPerSec.load(std::memory_order_relaxed) : 0;
+    m_read.copy(s.readUs);
+
+    s.inBuffSize = 0; // InBuff and the underruns are filled in by Audio
+    s.inBuffFilled = 0;
+    uint32_t minFilled = m_inBuffMin.load(std::memory_order_relaxed);
+    s.inBuffMinFilled = minFilled == UINT32_MAX ? 0 : minFilled;
+    uint32_t n = m_fillCount.load(std::memory_order_acquire);
+    s.fillHistoryLen = n < AUDIO_FILL_HISTORY ? n : AUDIO_FILL_HISTORY;
+    for(uint8_t i = 0; i < AUDIO_FILL_HISTORY; i++) {
+        s.fillHistory[i] = i < s.fillHistoryLen ? m_fillHistory[(n - 1 - i) % AUDIO_FILL_HISTORY].load(std::memory_order_relaxed) : 0;
+    }
+
+    for(uint8_t c = 0; c < AUDIO_STATS_CODECS; c++) m_decode[c].copy(s.decodeUs[c]);
+    s.decodeErrors = m_decodeErrors.load(std::memory_order_relaxed);
+    s.resyncs = m_resyncs.load(std::memory_order_relaxed);
+    s.bytesSkipped = m_bytesSkipped.load(std::memory_order_relaxed);
+
+    m_i2sWrite.copy(s.i2sWriteUs);
+    s.inBuffUnderruns = 0;
+    s.i2sUnderruns = 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * audio_stats.h
+ *
+ * Counters and histograms of the stages of Audio, to tell whether a stream stutters because of the network or the SD
+ * card, the decoder or I2S: the fetch (bytes per second, microseconds per read of the file or the client), InBuff (fill
+ * level, the lowest fill of each of the last 60 seconds), the decoders (microseconds per frame of each codec, errors,
+ * resyncs of findNextSync()) and I2S (microseconds i2s_channel_write() blocked). Each value has one writer, the fetch
+ * side (loop() or the fetch task) or the audio task, and is a relaxed atomic that only this writer stores to, so an
+ * update is a few loads and stores without a lock and the statistics are always on. snapshot() copies them for the
+ * application from any task; values written at that moment may be one update apart from each other. A new stream
+ * resets the fetch values at once (requestReset()) and the audio values when the audio task gets to applyReset().
+ * Times are log2 histograms: bin k counts 2^k ... 2^(k+1) - 1 us (bin 0 also 0 us), the last bin everything above.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+static const uint8_t AUDIO_HIST_BINS = 16;       // the last bin: 32.8ms and more
+static const uint8_t AUDIO_STATS_CODECS = 10;    // Audio::getCodec()
+static const uint8_t AUDIO_FILL_HISTORY = 60;    // seconds
+
+typedef struct _audio_hist {
+    uint32_t    bin[AUDIO_HIST_BINS];
+    uint32_t    count;
+    uint32_t    maxUs;
+    uint32_t    sumMs;                           // wraps after 49 days
+    uint32_t    meanUs() const { return count ? (uint64_t)sumMs * 1000 / count : 0; }
+    uint32_t    percentileUs(uint8_t p) const;   // upper edge of the bin with the p-th percentile, maxUs in the last bin
+} audio_hist_t;
+
+typedef struct _audio_stats {                    // Audio::getStats(), since the stream started
+    uint32_t     periodMs;
+    // fetch: loop() or the fetch task
+    uint32_t     bytesFetched;                   // wraps at 4GB, take differences
+    uint32_t     bytesPerSec;                    // of the last full second, 0 if nothing arrived for two seconds
+    audio_hist_t readUs;                         // per read of the file or the client into InBuff
+    // InBuff
+    uint32_t     inBuffSize;                     // InBuff at the time of the snapshot
+    uint32_t     inBuffFilled;
+    uint32_t     inBuffMinFilled;                // the lowest fill the audio task has seen
+    uint8_t      fillHistory[AUDIO_FILL_HISTORY]; // lowest fill of each second in percent, [0]: the last full second
+    uint8_t      fillHistoryLen;
+    uint32_t     inBuffUnderruns;                // see Audio::inBufferUnderruns()
+    // decoders
+    audio_hist_t decodeUs[AUDIO_STATS_CODECS];   // per frame, index: Audio::getCodec()
+    uint32_t     decodeErrors;
+    uint32_t     resyncs;                        // the decoder lost the frame sync and findNextSync() searched again
+    uint32_t     bytesSkipped;                   // by findNextSync()
+    // I2S
+    audio_hist_t i2sWriteUs;                     // i2s_channel_write() blocked, the DMA buffers were full
+    uint32_t     i2sUnderruns;                   // see Audio::i2sUnderruns()
+} audio_stats_t;
+
+class AudioStats {
+public:
+    void        reset(uint32_t nowMs);           // no writer may run
+    void        requestReset(uint32_t nowMs);    // a new stream: resets the fetch values, the fetch side must be held off
+    bool        applyReset();                    // audio task: resets its values after requestReset(), true if it did
+    // fetch side
+    void        fetched(uint32_t bytes, uint32_t us, uint32_t nowMs);
+    // audio task
+    void        inBuffFill(uint32_t filled, uint32_t size, uint32_t nowMs); // once per playAudioData()
+    void        decoded(uint8_t codec, uint32_t us);
+    void        decodeError() { inc(m_decodeErrors); }
+    void        synced() { if(m_decoding) inc(m_resyncs); } // findNextSync() found the frame sync, the first one starts the stream
+    void        skipped(uint32_t bytes) { inc(m_bytesSkipped, bytes); } // findNextSync() searched past these bytes
+    void        i2sWrite(uint32_t us) { m_i2sWrite.add(us); }
+    // any task
+    void        snapshot(audio_stats_t& s, uint32_t nowMs) const;
+
+private:
+    typedef std::atomic<uint32_t> counter_t;
+
+    typedef struct _hist {
+        counter_t   bin[AUDIO_HIST_BINS];
+        counter_t   count;
+        counter_t   maxUs;
+        counter_t   sumMs;
+        uint32_t    fracUs = 0;                  // writer only: the part of the sum below one ms
+        void        add(uint32_t us);
+        void        clear();
+        void        copy(audio_hist_t& h) const;
+    } hist_t;
+
+    static void inc(counter_t& c, uint32_t n = 1) { c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed); }
+    void        resetFetch(uint32_t nowMs);
+    void        resetAudio(uint32_t nowMs);
+
+    counter_t       m_startMs;
+    counter_t       m_resetRequests;             // requestReset() counts, applyReset() catches up
+    uint32_t        m_resetsApplied = 0;         // audio task
+    // fetch side
+    counter_t       m_bytes;
+    counter_t       m_bytesPerSec;
+    counter_t       m_rateMs;                    // m_bytesPerSec was published at this time
+    uint32_t        m_windowMs = 0;
+    uint32_t        m_windowBytes = 0;
+    hist_t          m_read;
+    // audio task
+    counter_t       m_inBuffMin;
+    std::atomic<uint8_t> m_fillHistory[AUDIO_FILL_HISTORY];
+    counter_t       m_fillCount;                 // seconds recorded, the newest is m_fillHistory[(m_fillCount - 1) % 60]
+    uint32_t        m_secondMs = 0;
+    uint8_t         m_secondMin = 100;
+    hist_t          m_decode[AUDIO_STATS_CODECS];
+    bool            m_decoding = false;          // a frame was decoded, a sync from now on is a resync
+    counter_t       m_decodeErrors, m_resyncs, m_bytesSkipped;
+    hist_t          m_i2sWrite;
+};
@@ -11,124 +11,87 @@
  */
 #include "flac_decoder.h"
 #include "vector"
+#include <type_traits>
 using namespace std;
 
-ps_ptr<FLACFrameHeader_t> FLACFrameHeader;
-ps_ptr<FLACMetadataBlock_t> FLACMetadataBlock;
-
-vector<uint32_t> s_flacSegmTableVec;
-vector<int32_t>  coefs;
-vector<uint32_t> s_flacBlockPicItem;
-uint64_t         s_flac_bitBuffer = 0;
-uint32_t         s_flacBitrate = 0;
-uint32_t         s_flacBlockPicLenUntilFrameEnd = 0;
-uint32_t         s_flacCurrentFilePos = 0;
-uint32_t         s_flacBlockPicPos = 0;
-uint32_t         s_flacBlockPicLen = 0;
-uint32_t         s_flacAudioDataStart = 0;
-int32_t          s_flacRemainBlockPicLen = 0;
 const uint16_t   s_flacOutBuffSize = 2048;
-uint16_t         s_numOfOutSamples = 0;
-uint16_t         s_flacValidSamples = 0;
-uint16_t         s_rIndex = 0;
-uint16_t         s_offset = 0;
-uint8_t          s_flacStatus = 0;
-uint8_t*         s_flacInptr;
-float            s_flacCompressionRatio = 0;
-uint8_t          s_flacBitBufferLen = 0;
-bool             s_f_flacParseOgg = false;
-bool             s_f_bitReaderError = false;
-uint8_t          s_flac_pageSegments = 0;
-ps_ptr<char>     s_flacStreamTitle = {};
-ps_ptr<char>     s_flacVendorString = {};
-bool             s_f_flacNewStreamtitle = false;
-bool             s_f_flacFirstCall = true;
-bool             s_f_oggWrapper = false;
-bool             s_f_lastMetaDataBlock = false;
-bool             s_f_flacNewMetadataBlockPicture = false;
-uint8_t          s_flacPageNr = 0;
-std::vector<ps_ptr<int32_t>> s_samplesBuffer;
-uint16_t         s_maxBlocksize = FLAC_MAX_BLOCKSIZE;
-int32_t          s_nBytes = 0;
 
 //----------------------------------------------------------------------------------------------------------------------
 //          FLAC INI SECTION
 //----------------------------------------------------------------------------------------------------------------------
 
-bool FLACDecoder_AllocateBuffers(void){
+bool FLACDecoder::allocateBuffers(void){
 
-    FLACFrameHeader.alloc();
-    FLACMetadataBlock.alloc();
+    m_FLACFrameHeader.alloc();
+    m_FLACMetadataBlock.alloc();
 
-    s_samplesBuffer.resize(FLAC_MAX_CHANNELS);
+    m_samplesBuffer.resize(FLAC_MAX_CHANNELS);
     for (int32_t i = 0; i < FLAC_MAX_CHANNELS; i++){
-        s_samplesBuffer[i].alloc(s_maxBlocksize  * sizeof(int32_t));
-        if(!s_samplesBuffer[i]){ // ps_ptr<T> sollte operator bool() überladen
+        m_samplesBuffer[i].alloc(m_maxBlocksize  * sizeof(int32_t));
+        if(!m_samplesBuffer[i]){ // ps_ptr<T> sollte operator bool() überladen
             FLAC_LOG_ERROR("not enough memory to allocate flacdecoder buffers");
-            s_samplesBuffer.clear(); // Vektor leeren und alle ps_ptr Objekte zerstören
+            m_samplesBuffer.clear(); // Vektor leeren und alle ps_ptr Objekte zerstören
             return false;
         }
     }
 
-    FLACDecoder_ClearBuffer();
+    clearBuffers();
     FLACDecoder_setDefaults();
-    s_flacPageNr = 0;
+    m_flacPageNr = 0;
     return true;
 }
 //----------------------------------------------------------------------------------------------------------------------
-void FLACDecoder_ClearBuffer(){
-    FLACFrameHeader.zero_mem();
-    FLACMetadataBlock.zero_mem();
+void FLACDecoder::clearBuffers(){
+    m_FLACFrameHeader.zero_mem();
+    m_FLACMetadataBlock.zero_mem();
 
     for (int32_t i = 0; i < FLAC_MAX_CHANNELS; i++){
-        s_samplesBuffer[i].zero_mem();
+        m_samplesBuffer[i].zero_mem();
     }
 
-    s_flacSegmTableVec.clear(); s_flacSegmTableVec.shrink_to_fit();
-    s_flacStatus = DECODE_FRAME;
+    m_flacSegmTableVec.clear(); m_flacSegmTableVec.shrink_to_fit();
+    m_flacStatus = DECODE_FRAME;
     return;
 }
 //----------------------------------------------------------------------------------------------------------------------
-void FLACDecoder_FreeBuffers(){
-    FLACFrameHeader.reset();
-    FLACMetadataBlock.reset();
-    s_flacStreamTitle.reset();
-    s_flacVendorString.reset();
-
-    s_samplesBuffer.clear(); s_samplesBuffer.shrink_to_fit();
-    coefs.clear(); coefs.shrink_to_fit();
-    s_flacSegmTableVec.clear(); s_flacSegmTableVec.shrink_to_fit();
-    s_flacBlockPicItem.clear(); s_flacBlockPicItem.shrink_to_fit();
+void FLACDecoder::freeBuffers(){
+    m_FLACFrameHeader.reset();
+    m_FLACMetadataBlock.reset();
+    m_flacStreamTitle.reset();
+    m_flacVendorString.reset();
+
+    m_samplesBuffer.clear(); m_samplesBuffer.shrink_to_fit();
+    m_flacSegmTableVec.clear(); m_flacSegmTableVec.shrink_to_fit();
+    m_flacBlockPicItem.clear(); m_flacBlockPicItem.shrink_to_fit();
 }
 //----------------------------------------------------------------------------------------------------------------------
-void FLACDecoder_setDefaults(){
-    coefs.clear(); coefs.shrink_to_fit();
-    s_flacSegmTableVec.clear(); s_flacSegmTableVec.shrink_to_fit();
-    s_flacBlockPicItem.clear(); s_flacBlockPicItem.shrink_to_fit();
-    s_flac_bitBuffer = 0;
-    s_flacBitrate = 0;
-    s_flacBlockPicLenUntilFrameEnd = 0;
-    s_flacCurrentFilePos = 0;
-    s_flacBlockPicPos = 0;
-    s_flacBlockPicLen = 0;
-    s_flacRemainBlockPicLen = 0;
-    s_flacAudioDataStart = 0;
-    s_numOfOutSamples = 0;
-    s_offset = 0;
-    s_flacValidSamples = 0;
-    s_rIndex = 0;
-    s_flacStatus = DECODE_FRAME;
-    s_flacCompressionRatio = 0;
-    s_flacBitBufferLen = 0;
-    s_flac_pageSegments = 0;
-    s_f_flacNewStreamtitle = false;
-    s_f_flacFirstCall = true;
-    s_f_oggWrapper = false;
-    s_f_lastMetaDataBlock = false;
-    s_f_flacNewMetadataBlockPicture = false;
-    s_f_flacParseOgg = false;
-    s_f_bitReaderError = false;
-    s_nBytes = 0;
+void FLACDecoder::FLACDecoder_setDefaults(){
+    m_flacSegmTableVec.clear(); m_flacSegmTableVec.shrink_to_fit();
+    m_flacBlockPicItem.clear(); m_flacBlockPicItem.shrink_to_fit();
+    m_flac_bitBuffer = 0;
+    m_flacBitrate = 0;
+    m_flacBlockPicLenUntilFrameEnd = 0;
+    m_flacCurrentFilePos = 0;
+    m_flacBlockPicPos = 0;
+    m_flacBlockPicLen = 0;
+    m_flacRemainBlockPicLen = 0;
+    m_flacAudioDataStart = 0;
+    m_numOfOutSamples = 0;
+    m_offset = 0;
+    m_flacValidSamples = 0;
+    m_rIndex = 0;
+    m_flacStatus = DECODE_FRAME;
+    m_flacCompressionRatio = 0;
+    m_flacBitBufferLen = 0;
+    m_flac_pageSegments = 0;
+    m_f_flacNewStreamtitle = false;
+    m_f_flacFirstCall = true;
+    m_f_oggWrapper = false;
+    m_f_lastMetaDataBlock = false;
+    m_f_flacNewMetadataBlockPicture = false;
+    m_f_flacParseOgg = false;
+    m_f_bitReaderError = false;
+    m_nBytes = 0;
 }
 //----------------------------------------------------------------------------------------------------------------------
 //            B I T R E A D E R
@@ -139,70 +102,134 @@ const uint32_t mask[] = {0x00000000, 0x00000001, 0x00000003, 0x00000007, 0x00000
                          0x001fffff, 0x003fffff, 0x007fffff, 0x00ffffff, 0x01ffffff, 0x03ffffff, 0x07ffffff,
                          0x0fffffff, 0x1fffffff, 0x3fffffff, 0x7fffffff, 0xffffffff};
 
-uint32_t readUint(uint8_t nBits, int32_t *bytesLeft){
-    while (s_flacBitBufferLen < nBits){
-        uint8_t temp = *(s_flacInptr + s_rIndex);
-        s_rIndex++;
-        (*bytesLeft)--;
-        if(*bytesLeft < 0) { FLAC_LOG_ERROR("error in bitreader"); s_f_bitReaderError = true; break;}
-        s_flac_bitBuffer = (s_flac_bitBuffer << 8) | temp;
-        s_flacBitBufferLen += 8;
+// The bit cache m_flac_bitBuffer holds m_flacBitBufferLen bits (up to 64), the next bit to read is the highest of them.
+// While more than 8 bytes are left, it is refilled with 8 bytes at once, at the end of the data byte by byte. Every
+// byte in the cache is already counted in bytesLeft, bitReaderReturnBytes() gives the unread bytes back at the frame end.
+static inline bool bitReaderFill(uint64_t& cache, uint8_t& len, const uint8_t*& in, int32_t& left) {
+    if (left >= 8) {
+        uint8_t n = (64 - len) >> 3; // whole bytes that fit into the cache
+        if (!n) return true;
+        uint64_t word;
+        memcpy(&word, in, 8);
+        word = __builtin_bswap64(word); // big endian
+        cache = (n == 8) ? word : (cache << (8 * n)) | (word >> (64 - 8 * n));
+        len += 8 * n;
+        in += n;
+        left -= n;
+        return true;
     }
-    s_flacBitBufferLen -= nBits;
-    uint32_t result = s_flac_bitBuffer >> s_flacBitBufferLen;
-    if (nBits < 32)
-        result &= mask[nBits];
-    return result;
+    if (left <= 0) return false;
+    while (len <= 56 && left > 0) {
+        cache = (cache << 8) | *in++;
+        len += 8;
+        left--;
+    }
+    return true;
+}
+
+uint32_t FLACDecoder::readUint(uint8_t nBits, int32_t *bytesLeft){
+    if (m_flacBitBufferLen < nBits) {
+        const uint8_t* in = m_flacInptr + m_rIndex;
+        bitReaderFill(m_flac_bitBuffer, m_flacBitBufferLen, in, *bytesLeft);
+        m_rIndex = in - m_flacInptr;
+        if (m_flacBitBufferLen < nBits) { FLAC_LOG_ERROR("error in bitreader"); m_f_bitReaderError = true; m_flacBitBufferLen = 0; return 0;}
+    }
+    if (!nBits) return 0;
+    m_flacBitBufferLen -= nBits;
+    return (uint32_t)(m_flac_bitBuffer >> m_flacBitBufferLen) & mask[nBits];
 }
 
-int32_t readSignedInt(int32_t nBits, int32_t* bytesLeft){
+int32_t FLACDecoder::readSignedInt(int32_t nBits, int32_t* bytesLeft){
+    if (!nBits) return 0;
     int32_t temp = readUint(nBits, bytesLeft) << (32 - nBits);
     temp = temp >> (32 - nBits); // The C++ compiler uses the sign bit to fill vacated bit positions
     return temp;
 }
 
-int64_t readRiceSignedInt(uint8_t param, int32_t* bytesLeft){
-    long val = 0;
-    while (readUint(1, bytesLeft) == 0)
-        val++;
-    val = (val << param) | readUint(param, bytesLeft);
-    return (val >> 1) ^ -(val & 1);
+// Decodes count Rice coded residuals with a local copy of the bit cache. The unary part (quotient) is counted with
+// count leading zeros instead of bit by bit.
+bool FLACDecoder::readRicePartition(int32_t* out, int32_t count, uint8_t param, int32_t* bytesLeft){
+    uint64_t       cache = m_flac_bitBuffer;
+    uint8_t        len = m_flacBitBufferLen;
+    const uint8_t* in = m_flacInptr + m_rIndex;
+    int32_t        left = *bytesLeft;
+    bool           ok = true;
+
+    for (int32_t i = 0; i < count; i++) {
+        uint32_t q = 0;
+        while (true) {
+            if (!len && !bitReaderFill(cache, len, in, left)) {ok = false; break;}
+            uint64_t v = cache << (64 - len); // next bit at the top
+            if (v) {
+                uint8_t zeros = __builtin_clzll(v);
+                q += zeros;
+                len -= zeros + 1;
+                break;
+            }
+            q += len;
+            len = 0;
+        }
+        if (!ok) break;
+        uint32_t val = q << param;
+        if (param) {
+            if (len < param) {
+                bitReaderFill(cache, len, in, left);
+                if (len < param) {ok = false; break;}
+            }
+            len -= param;
+            val |= (uint32_t)(cache >> len) & mask[param];
+        }
+        out[i] = (int32_t)(val >> 1) ^ -(int32_t)(val & 1);
+    }
+    m_flac_bitBuffer = cache;
+    m_flacBitBufferLen = len;
+    m_rIndex = in - m_flacInptr;
+    *bytesLeft = left;
+    if (!ok) { FLAC_LOG_ERROR("error in bitreader"); m_f_bitReaderError = true;}
+    return ok;
+}
+
+void FLACDecoder::bitReaderReturnBytes(int32_t* bytesLeft) {
+    uint8_t n = m_flacBitBufferLen >> 3;
+    m_rIndex -= n;
+    *bytesLeft += n;
+    m_flacBitBufferLen -= 8 * n;
 }
 
-void alignToByte() {
-    s_flacBitBufferLen -= s_flacBitBufferLen % 8;
+void FLACDecoder::alignToByte() {
+    m_flacBitBufferLen -= m_flacBitBufferLen % 8;
 }
 //----------------------------------------------------------------------------------------------------------------------
 //              F L A C - D E C O D E R
 //----------------------------------------------------------------------------------------------------------------------
-void FLACSetRawBlockParams(uint8_t Chans, uint32_t SampRate, uint8_t BPS, uint32_t tsis, uint32_t AuDaLength){
-    FLACMetadataBlock->numChannels = Chans;
-    FLACMetadataBlock->sampleRate = SampRate;
-    FLACMetadataBlock->bitsPerSample = BPS;
-    FLACMetadataBlock->totalSamples = tsis;  // total samples in stream
-    FLACMetadataBlock->audioDataLength = AuDaLength;
+void FLACDecoder::setRawBlockParams(uint8_t Chans, uint32_t SampRate, uint8_t BPS, uint32_t tsis, uint32_t AuDaLength){
+    m_FLACMetadataBlock->numChannels = Chans;
+    m_FLACMetadataBlock->sampleRate = SampRate;
+    m_FLACMetadataBlock->bitsPerSample = BPS;
+    m_FLACMetadataBlock->totalSamples = tsis;  // total samples in stream
+    m_FLACMetadataBlock->audioDataLength = AuDaLength;
 }
 //----------------------------------------------------------------------------------------------------------------------
-void FLACDecoderReset(){ // set var to default
+void FLACDecoder::reset(){ // set var to default
     FLACDecoder_setDefaults();
-    FLACDecoder_ClearBuffer();
+    clearBuffers();
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t FLACFindSyncWord(unsigned char *buf, int32_t nBytes) {
+int32_t FLACDecoder::findSyncWord(unsigned char *buf, int32_t nBytes) {
 
     int32_t i = FLAC_specialIndexOf(buf, "OggS", nBytes);
-    if(i == 0) {s_f_bitReaderError = false; return 0;}  // flag has ogg wrapper
+    if(i == 0) {m_f_bitReaderError = false; return 0;}  // flag has ogg wrapper
 
-    if(s_f_oggWrapper && i > 0){
-        s_f_bitReaderError = false;
+    if(m_f_oggWrapper && i > 0){
+        m_f_bitReaderError = false;
         return i;
     }
     else{
          /* find byte-aligned sync code - need 14 matching bits */
         for (i = 0; i < nBytes - 1; i++) {
             if ((buf[i + 0] & 0xFF) == 0xFF  && (buf[i + 1] & 0xFC) == 0xF8) { // <14> Sync code '11111111111110xx'
-                if(i) FLACDecoderReset();
-            //    s_f_bitReaderError = false;
+                if(i) reset();
+            //    m_f_bitReaderError = false;
                 return i;
             }
         }
@@ -210,7 +237,7 @@ int32_t FLACFindSyncWord(unsigned char *buf, int32_t nBytes) {
     return -1;
 }
 //----------------------------------------------------------------------------------------------------------------------
-boolean FLACFindMagicWord(unsigned char* buf, int32_t nBytes){
+boolean FLACDecoder::FLACFindMagicWord(unsigned char* buf, int32_t nBytes){
     int32_t idx = FLAC_specialIndexOf(buf, "fLaC", nBytes);
     if(idx >0){ // Metadatablock follows
         idx += 4;
@@ -227,17 +254,17 @@ boolean FLACFindMagicWord(unsigned char* buf, int32_t nBytes){
     return false;
 }
 //----------------------------------------------------------------------------------------------------------------------
-char* FLACgetStreamTitle(){
-    if(s_f_flacNewStreamtitle){
-        s_f_flacNewStreamtitle = false;
-        return s_flacStreamTitle.get();
+char* FLACDecoder::getStreamTitle(){
+    if(m_f_flacNewStreamtitle){
+        m_f_flacNewStreamtitle = false;
+        return m_flacStreamTitle.get();
     }
     return NULL;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t FLACparseOGG(uint8_t *inbuf, int32_t *bytesLeft){  // reference https://www.xiph.org/ogg/doc/rfc3533.txt
+int32_t FLACDecoder::FLACparseOGG(uint8_t *inbuf, int32_t *bytesLeft){  // reference https://www.xiph.org/ogg/doc/rfc3533.txt
 
-    s_f_flacParseOgg = false;
+    m_f_flacParseOgg = false;
     int32_t idx = FLAC_specialIndexOf(inbuf, "OggS", 6);
     if(idx != 0){FLAC_LOG_ERROR("Flac decoder asyncron, \"OggS\" not found"); return FLAC_ERR;}
 
@@ -267,8 +294,8 @@ int32_t FLACparseOGG(uint8_t *inbuf, int32_t *bytesLeft){  // reference https://
 
     // read the segment table (contains pageSegments bytes),  1...251: Length of the frame in bytes,
     // 255: A second byte is needed.  The total length is first_byte + second byte
-    s_flacSegmTableVec.clear();
-    s_flacSegmTableVec.shrink_to_fit();
+    m_flacSegmTableVec.clear();
+    m_flacSegmTableVec.shrink_to_fit();
     for(int32_t i = 0; i < pageSegments; i++){
         int32_t n = *(inbuf + 27 + i);
         while(*(inbuf + 27 + i) == 255){
@@ -276,9 +303,9 @@ int32_t FLACparseOGG(uint8_t *inbuf, int32_t *bytesLeft){  // reference https://
             if(i == pageSegments) break;
             n+= *(inbuf + 27 + i);
         }
-        s_flacSegmTableVec.insert(s_flacSegmTableVec.begin(), n);
+        m_flacSegmTableVec.insert(m_flacSegmTableVec.begin(), n);
     }
-    // for(int32_t i = 0; i< s_flacSegmTableVec.size(); i++){FLAC_LOG_INFO("%i", s_flacSegmTableVec[i]);}
+    // for(int32_t i = 0; i< m_flacSegmTableVec.size(); i++){FLAC_LOG_INFO("%i", m_flacSegmTableVec[i]);}
 
     bool     continuedPage = headerType & 0x01; // set: page contains data of a packet continued from the previous page
     bool     firstPage     = headerType & 0x02; // set: this is the first page of a logical bitstream (bos)
@@ -288,29 +315,29 @@ int32_t FLACparseOGG(uint8_t *inbuf, int32_t *bytesLeft){  // reference https://
 
     // FLAC_LOG_INFO("firstPage %i, continuedPage %i, lastPage %i", firstPage, continuedPage, lastPage);
 
-    if(firstPage) s_flacPageNr = 0;
+    if(firstPage) m_flacPageNr = 0;
 
     uint32_t headerSize = pageSegments + 27;
 
     *bytesLeft -= headerSize;
-    s_flacCurrentFilePos += headerSize;
+    m_flacCurrentFilePos += headerSize;
     return FLAC_NONE; // no error
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------------------------
-vector<uint32_t> FLACgetMetadataBlockPicture(){
-    if(s_f_flacNewMetadataBlockPicture){
-        s_f_flacNewMetadataBlockPicture = false;
-        return s_flacBlockPicItem;
+vector<uint32_t> FLACDecoder::getMetadataBlockPicture(){
+    if(m_f_flacNewMetadataBlockPicture){
+        m_f_flacNewMetadataBlockPicture = false;
+        return m_flacBlockPicItem;
     }
-    if(s_flacBlockPicItem.size() > 0){
-        s_flacBlockPicItem.clear();
-        s_flacBlockPicItem.shrink_to_fit();
+    if(m_flacBlockPicItem.size() > 0){
+        m_flacBlockPicItem.clear();
+        m_flacBlockPicItem.shrink_to_fit();
     }
-    return s_flacBlockPicItem;
+    return m_flacBlockPicItem;
 }
 //----------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t parseFlacFirstPacket(uint8_t *inbuf, int16_t nBytes){ // 4.2.2. Identification header   https://xiph.org/flac/ogg_mapping.html
+int32_t FLACDecoder::parseFlacFirstPacket(uint8_t *inbuf, int16_t nBytes){ // 4.2.2. Identification header   https://xiph.org/flac/ogg_mapping.html
 
     int32_t ret = 0;
     int32_t idx = FLAC_specialIndexOf(inbuf, "fLaC", nBytes);
@@ -325,7 +352,7 @@ int32_t parseFlacFirstPacket(uint8_t *inbuf, int16_t nBytes){ // 4.2.2. Identifi
     return ret;
 }
 //----------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
+int32_t FLACDecoder::parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
     int8_t   ret = FLAC_PARSE_OGG_DONE;
     uint16_t pos = 0;
     int32_t  blockLength = 0;
@@ -350,7 +377,7 @@ int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
 
     while(true){
         mdBlockHeader         = *(inbuf + pos);
-        s_f_lastMetaDataBlock = mdBlockHeader & 0b10000000; // FLAC_LOG_INFO("lastMdBlockFlag %i", s_f_lastMetaDataBlock);
+        m_f_lastMetaDataBlock = mdBlockHeader & 0b10000000; // FLAC_LOG_INFO("lastMdBlockFlag %i", m_f_lastMetaDataBlock);
         blockType             = mdBlockHeader & 0b01111111; // FLAC_LOG_INFO("blockType %i", blockType);
 
         blockLength        = *(inbuf + pos + 1) << 16;
@@ -404,10 +431,10 @@ int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
                 maxBlocksize += *(inbuf + pos + 3);
                 //FLAC_LOG_INFO("minBlocksize %i", minBlocksize);
                 //FLAC_LOG_INFO("maxBlocksize %i", maxBlocksize);
-                FLACMetadataBlock->minblocksize = minBlocksize;
-                FLACMetadataBlock->maxblocksize = maxBlocksize;
+                m_FLACMetadataBlock->minblocksize = minBlocksize;
+                m_FLACMetadataBlock->maxblocksize = maxBlocksize;
 
-                if(maxBlocksize > s_maxBlocksize){FLAC_LOG_ERROR("s_blocksize is too big: %i bytes, max block size: %i", maxBlocksize, s_maxBlocksize); return FLAC_ERR;}
+                if(maxBlocksize > m_maxBlocksize){FLAC_LOG_ERROR("s_blocksize is too big: %i bytes, max block size: %i", maxBlocksize, m_maxBlocksize); return FLAC_ERR;}
 
                 minFrameSize  = *(inbuf + pos + 4) << 16;
                 minFrameSize += *(inbuf + pos + 5) << 8;
@@ -417,22 +444,22 @@ int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
                 maxFrameSize += *(inbuf + pos + 9);
                 //FLAC_LOG_INFO("minFrameSize %i", minFrameSize);
                 //FLAC_LOG_INFO("maxFrameSize %i", maxFrameSize);
-                FLACMetadataBlock->minframesize = minFrameSize;
-                FLACMetadataBlock->maxframesize = maxFrameSize;
+                m_FLACMetadataBlock->minframesize = minFrameSize;
+                m_FLACMetadataBlock->maxframesize = maxFrameSize;
 
                 sampleRate   =  *(inbuf + pos + 10) << 12;
                 sampleRate  +=  *(inbuf + pos + 11) << 4;
                 sampleRate  += (*(inbuf + pos + 12) & 0xF0) >> 4;
                 //FLAC_LOG_INFO("sampleRate %i", sampleRate);
-                FLACMetadataBlock->sampleRate = sampleRate;
+                m_FLACMetadataBlock->sampleRate = sampleRate;
 
                 nrOfChannels = ((*(inbuf + pos + 12) & 0x0E) >> 1) + 1;
                 //FLAC_LOG_INFO("nrOfChannels %i", nrOfChannels);
-                FLACMetadataBlock->numChannels = nrOfChannels;
+                m_FLACMetadataBlock->numChannels = nrOfChannels;
 
                 bitsPerSample  =  (*(inbuf + pos + 12) & 0x01) << 5;
                 bitsPerSample += ((*(inbuf + pos + 13) & 0xF0) >> 4) + 1;
-                FLACMetadataBlock->bitsPerSample = bitsPerSample;
+                m_FLACMetadataBlock->bitsPerSample = bitsPerSample;
                 //FLAC_LOG_INFO("bitsPerSample %i", bitsPerSample);
 
                 totalSamplesInStream  = (uint64_t)(*(inbuf + pos + 17) & 0x0F) << 32;
@@ -441,7 +468,7 @@ int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
                 totalSamplesInStream += (*(inbuf + pos + 15)) << 8;
                 totalSamplesInStream += (*(inbuf + pos + 16));
                 //FLAC_LOG_INFO("totalSamplesInStream %lli", totalSamplesInStream);
-                FLACMetadataBlock->totalSamples = totalSamplesInStream;
+                m_FLACMetadataBlock->totalSamples = totalSamplesInStream;
 
                 //FLAC_LOG_INFO("nBytes %i, blockLength %i", nBytes, blockLength);
                 pos += blockLength;
@@ -457,9 +484,9 @@ int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
                 if(vendorLength > 1024){
                     FLAC_LOG_INFO("vendorLength > 1024 bytes");
                 }
-                s_flacVendorString.alloc(vendorLength + 1); s_flacVendorString.clear();
-                s_flacVendorString.copy_from((char*)inbuf + pos + 4, vendorLength, "s_flacVendorString");
-                // FLAC_LOG_VERBOSE("Vendor: %s", s_flacVendorString.c_get());
+                m_flacVendorString.alloc(vendorLength + 1); m_flacVendorString.clear();
+                m_flacVendorString.copy_from((char*)inbuf + pos + 4, vendorLength, "m_flacVendorString");
+                // FLAC_LOG_VERBOSE("Vendor: %s", m_flacVendorString.c_get());
 
                 pos += 4 + vendorLength;
                 userCommentListLength  = *(inbuf + pos + 3) << 24;
@@ -505,39 +532,39 @@ int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
                     }
                     if((FLAC_specialIndexOf(inbuf + pos + 4, "METADATA_BLOCK_PICTURE", 23) == 0) || (FLAC_specialIndexOf(inbuf + pos + 4, "metadata_block_picture", 23) == 0)){
                         FLAC_LOG_VERBOSE("METADATA_BLOCK_PICTURE found, commemtStringLength %i", commemtStringLength);
-                        s_flacBlockPicLen = commemtStringLength - 23;
-                        s_flacBlockPicPos = s_flacCurrentFilePos + pos + 4 + 23;
-                        s_flacBlockPicLenUntilFrameEnd = nBytes - (pos + 23);
-                        if(s_flacBlockPicLen < s_flacBlockPicLenUntilFrameEnd) s_flacBlockPicLenUntilFrameEnd = s_flacBlockPicLen;
-                        s_flacRemainBlockPicLen = s_flacBlockPicLen - s_flacBlockPicLenUntilFrameEnd;
-                        //FLAC_LOG_INFO("s_flacBlockPicPos %i, s_flacBlockPicLen %i", s_flacBlockPicPos, s_flacBlockPicLen);
-                        //FLAC_LOG_INFO("s_flacBlockPicLenUntilFrameEnd %i, s_flacRemainBlockPicLen %i", s_flacBlockPicLenUntilFrameEnd, s_flacRemainBlockPicLen);
-                        if(s_flacRemainBlockPicLen <= 0) s_f_lastMetaDataBlock = true; // exeption:: goto audiopage after commemt if lastMetaDataFlag is not set
-                        if(s_flacBlockPicLen){
-                            s_flacBlockPicItem.clear();
-                            s_flacBlockPicItem.shrink_to_fit();
-                            s_flacBlockPicItem.push_back(s_flacBlockPicPos);
-                            s_flacBlockPicItem.push_back(s_flacBlockPicLenUntilFrameEnd);
+                        m_flacBlockPicLen = commemtStringLength - 23;
+                        m_flacBlockPicPos = m_flacCurrentFilePos + pos + 4 + 23;
+                        m_flacBlockPicLenUntilFrameEnd = nBytes - (pos + 23);
+                        if(m_flacBlockPicLen < m_flacBlockPicLenUntilFrameEnd) m_flacBlockPicLenUntilFrameEnd = m_flacBlockPicLen;
+                        m_flacRemainBlockPicLen = m_flacBlockPicLen - m_flacBlockPicLenUntilFrameEnd;
+                        //FLAC_LOG_INFO("m_flacBlockPicPos %i, m_flacBlockPicLen %i", m_flacBlockPicPos, m_flacBlockPicLen);
+                        //FLAC_LOG_INFO("m_flacBlockPicLenUntilFrameEnd %i, m_flacRemainBlockPicLen %i", m_flacBlockPicLenUntilFrameEnd, m_flacRemainBlockPicLen);
+                        if(m_flacRemainBlockPicLen <= 0) m_f_lastMetaDataBlock = true; // exeption:: goto audiopage after commemt if lastMetaDataFlag is not set
+                        if(m_flacBlockPicLen){
+                            m_flacBlockPicItem.clear();
+                            m_flacBlockPicItem.shrink_to_fit();
+                            m_flacBlockPicItem.push_back(m_flacBlockPicPos);
+                            m_flacBlockPicItem.push_back(m_flacBlockPicLenUntilFrameEnd);
                         }
                     }
                     pos += 4 + commemtStringLength;
                     // FLAC_LOG_VERBOSE("nBytes %i, pos %i, commemtStringLength %i", nBytes, pos, commemtStringLength);
                 }
                 if(vb[1].valid() && vb[0].valid()){ // artist and title
-                    s_flacStreamTitle.assign(vb[1].c_get());
-                    s_flacStreamTitle.append(" - ");
-                    s_flacStreamTitle.append(vb[0].c_get());
-                    s_f_flacNewStreamtitle = true;
+                    m_flacStreamTitle.assign(vb[1].c_get());
+                    m_flacStreamTitle.append(" - ");
+                    m_flacStreamTitle.append(vb[0].c_get());
+                    m_f_flacNewStreamtitle = true;
                 }
                 else if(vb[1].valid()){
-                    s_flacStreamTitle.assign(vb[1].c_get());
-                    s_f_flacNewStreamtitle = true;
+                    m_flacStreamTitle.assign(vb[1].c_get());
+                    m_f_flacNewStreamtitle = true;
                 }
                 else if(vb[0].valid()){
-                    s_flacStreamTitle.assign(vb[0].c_get());
-                    s_f_flacNewStreamtitle = true;
+                    m_flacStreamTitle.assign(vb[0].c_get());
+                    m_f_flacNewStreamtitle = true;
                 }
-                if(!s_flacBlockPicLen && s_flacSegmTableVec.size() == 1) s_f_lastMetaDataBlock = true; // exeption:: goto audiopage after commemt if lastMetaDataFlag is not set
+                if(!m_flacBlockPicLen && m_flacSegmTableVec.size() == 1) m_f_lastMetaDataBlock = true; // exeption:: goto audiopage after commemt if lastMetaDataFlag is not set
                 if(ret == FLAC_PARSE_OGG_DONE) return ret;
                 break;
 
@@ -553,79 +580,78 @@ int32_t parseMetaDataBlockHeader(uint8_t *inbuf, int16_t nBytes){
     return 0;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int8_t FLACDecode(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){ //  MAIN LOOP
+int8_t FLACDecoder::decode(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){ //  MAIN LOOP
 
     int32_t                ret = 0;
     uint32_t           segmLen = 0;
-    static uint32_t segmLenTmp = 0;
 
-    if(s_f_flacFirstCall){ // determine if ogg or flag
-        s_f_flacFirstCall = false;
-        s_nBytes = 0;
-        segmLenTmp = 0;
+    if(m_f_flacFirstCall){ // determine if ogg or flag
+        m_f_flacFirstCall = false;
+        m_nBytes = 0;
+        m_segmLenTmp = 0;
         if(FLAC_specialIndexOf(inbuf, "OggS", 5) == 0){
-            s_f_oggWrapper = true;
-            s_f_flacParseOgg = true;
+            m_f_oggWrapper = true;
+            m_f_flacParseOgg = true;
         }
     }
 
-    if(s_f_oggWrapper){
+    if(m_f_oggWrapper){
 
-        if(segmLenTmp){ // can't skip more than 16K
-            if(segmLenTmp > FLAC_MAX_BLOCKSIZE){
-                s_flacCurrentFilePos += FLAC_MAX_BLOCKSIZE;
+        if(m_segmLenTmp){ // can't skip more than 16K
+            if(m_segmLenTmp > FLAC_MAX_BLOCKSIZE){
+                m_flacCurrentFilePos += FLAC_MAX_BLOCKSIZE;
                 *bytesLeft -= FLAC_MAX_BLOCKSIZE;
-                segmLenTmp -= FLAC_MAX_BLOCKSIZE;
+                m_segmLenTmp -= FLAC_MAX_BLOCKSIZE;
             }
             else{
-                s_flacCurrentFilePos += segmLenTmp;
-                *bytesLeft -= segmLenTmp;
-                segmLenTmp  = 0;
+                m_flacCurrentFilePos += m_segmLenTmp;
+                *bytesLeft -= m_segmLenTmp;
+                m_segmLenTmp  = 0;
             }
             return FLAC_PARSE_OGG_DONE;
         }
 
-        if(s_nBytes > 0){
-            int16_t diff = s_nBytes;
-            if(s_flacAudioDataStart == 0){
-                s_flacAudioDataStart = s_flacCurrentFilePos;
+        if(m_nBytes > 0){
+            int16_t diff = m_nBytes;
+            if(m_flacAudioDataStart == 0){
+                m_flacAudioDataStart = m_flacCurrentFilePos;
             }
-            ret = FLACDecodeNative(inbuf, &s_nBytes, outbuf);
-            diff -= s_nBytes;
-            s_flacCurrentFilePos += diff;
+            ret = FLACDecodeNative(inbuf, &m_nBytes, outbuf);
+            diff -= m_nBytes;
+            m_flacCurrentFilePos += diff;
             *bytesLeft -= diff;
             return ret;
         }
-        if(s_nBytes < 0){FLAC_LOG_ERROR("Flac decoder asynchron"); return FLAC_ERR;}
+        if(m_nBytes < 0){FLAC_LOG_ERROR("Flac decoder asynchron"); return FLAC_ERR;}
 
-        if(s_f_flacParseOgg == true){
-            s_f_flacParseOgg = false;
+        if(m_f_flacParseOgg == true){
+            m_f_flacParseOgg = false;
             ret = FLACparseOGG(inbuf, bytesLeft);
             if(ret == FLAC_NONE) return FLAC_PARSE_OGG_DONE; // ok
             else return ret;  // error
         }
         //-------------------------------------------------------
-        if(!s_flacSegmTableVec.size()) FLAC_LOG_ERROR("size is 0");
-        segmLen = s_flacSegmTableVec.back();
-        s_flacSegmTableVec.pop_back();
-        if(!s_flacSegmTableVec.size()) s_f_flacParseOgg = true;
+        if(!m_flacSegmTableVec.size()) FLAC_LOG_ERROR("size is 0");
+        segmLen = m_flacSegmTableVec.back();
+        m_flacSegmTableVec.pop_back();
+        if(!m_flacSegmTableVec.size()) m_f_flacParseOgg = true;
         //-------------------------------------------------------
 
-        if(s_flacRemainBlockPicLen <= 0 && !s_f_flacNewMetadataBlockPicture) {
-            if(s_flacBlockPicItem.size() > 0) { // get blockpic data
+        if(m_flacRemainBlockPicLen <= 0 && !m_f_flacNewMetadataBlockPicture) {
+            if(m_flacBlockPicItem.size() > 0) { // get blockpic data
                 // FLAC_LOG_INFO("---------------------------------------------------------------------------");
-                // FLAC_LOG_INFO("metadata blockpic found at pos %i, size %i bytes", s_flacBlockPicPos, s_flacBlockPicLen);
-                // for(int32_t i = 0; i < s_flacBlockPicItem.size(); i += 2) { FLAC_LOG_INFO("segment %02i, pos %07i, len %05i", i / 2, s_flacBlockPicItem[i], s_flacBlockPicItem[i + 1]); }
+                // FLAC_LOG_INFO("metadata blockpic found at pos %i, size %i bytes", m_flacBlockPicPos, m_flacBlockPicLen);
+                // for(int32_t i = 0; i < m_flacBlockPicItem.size(); i += 2) { FLAC_LOG_INFO("segment %02i, pos %07i, len %05i", i / 2, m_flacBlockPicItem[i], m_flacBlockPicItem[i + 1]); }
                 // FLAC_LOG_INFO("---------------------------------------------------------------------------");
-                s_f_flacNewMetadataBlockPicture = true;
+                m_f_flacNewMetadataBlockPicture = true;
             }
         }
 
-        switch(s_flacPageNr) {
+        switch(m_flacPageNr) {
             case 0:
                 ret = parseFlacFirstPacket(inbuf, segmLen);
                 if(ret == segmLen) {
-                    s_flacPageNr = 1;
+                    m_flacPageNr = 1;
                     ret = FLAC_PARSE_OGG_DONE;
                     break;
                 }
@@ -635,142 +661,146 @@ int8_t FLACDecode(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){ //  MAIN
                 if(ret < segmLen){
                     segmLen -= ret;
                     *bytesLeft -= ret;
-                    s_flacCurrentFilePos += ret;
+                    m_flacCurrentFilePos += ret;
                     inbuf += ret;
-                    s_flacPageNr = 1;
+                    m_flacPageNr = 1;
                 } /* fallthrough */
             case 1:
-                if(s_flacRemainBlockPicLen > 0){
-                    s_flacRemainBlockPicLen -= segmLen;
-                    //FLAC_LOG_INFO("s_flacCurrentFilePos %i, len %i, s_flacRemainBlockPicLen %i", s_flacCurrentFilePos, segmLen, s_flacRemainBlockPicLen);
-                    s_flacBlockPicItem.push_back(s_flacCurrentFilePos);
-                    s_flacBlockPicItem.push_back(segmLen);
-                    if(s_flacRemainBlockPicLen <= 0){s_flacPageNr = 2;}
+                if(m_flacRemainBlockPicLen > 0){
+                    m_flacRemainBlockPicLen -= segmLen;
+                    //FLAC_LOG_INFO("m_flacCurrentFilePos %i, len %i, m_flacRemainBlockPicLen %i", m_flacCurrentFilePos, segmLen, m_flacRemainBlockPicLen);
+                    m_flacBlockPicItem.push_back(m_flacCurrentFilePos);
+                    m_flacBlockPicItem.push_back(segmLen);
+                    if(m_flacRemainBlockPicLen <= 0){m_flacPageNr = 2;}
                     ret = FLAC_PARSE_OGG_DONE;
                     break;
                 }
                 ret = parseMetaDataBlockHeader(inbuf, segmLen);
-                if(s_f_lastMetaDataBlock) s_flacPageNr = 2;
+                if(m_f_lastMetaDataBlock) m_flacPageNr = 2;
                 break;
             case 2:
-                s_nBytes = segmLen;
+                m_nBytes = segmLen;
                 return FLAC_PARSE_OGG_DONE;
                 break;
         }
         if(segmLen > FLAC_MAX_BLOCKSIZE){
-            segmLenTmp = segmLen;
+            m_segmLenTmp = segmLen;
             return FLAC_PARSE_OGG_DONE;
         }
         *bytesLeft -= segmLen;
-        s_flacCurrentFilePos += segmLen;
+        m_flacCurrentFilePos += segmLen;
         return ret;
     }
     ret = FLACDecodeNative(inbuf, bytesLeft, outbuf);
     return ret;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int8_t FLACDecodeNative(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){
+int8_t FLACDecoder::FLACDecodeNative(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){
 
     int32_t bl = *bytesLeft;
-    static int32_t sbl = 0;
 
-    if(s_flacStatus != OUT_SAMPLES){
-        s_rIndex = 0;
-        s_flacInptr = inbuf;
+    if(m_flacStatus != OUT_SAMPLES){
+        m_rIndex = 0;
+        m_flacInptr = inbuf;
     }
 
-    while(s_flacStatus == DECODE_FRAME){// Read a ton of header fields, and ignore most of them
+    while(m_flacStatus == DECODE_FRAME){// Read a ton of header fields, and ignore most of them
         int32_t ret = flacDecodeFrame (inbuf, bytesLeft);
         if(ret != 0) return ret;
         if(*bytesLeft < FLAC_MAX_BLOCKSIZE) return FLAC_DECODE_FRAMES_LOOP; // need more data
-        sbl += bl - *bytesLeft;
+        m_sbl += bl - *bytesLeft;
     }
 
-    if(s_flacStatus == DECODE_SUBFRAMES){
+    if(m_flacStatus == DECODE_SUBFRAMES){
         // Decode each channel's subframe, then skip footer
         int32_t ret = decodeSubframes(bytesLeft);
         if(ret != 0) return ret;
-        s_flacStatus = OUT_SAMPLES;
-        sbl += bl - *bytesLeft;
+        alignToByte();
+        bitReaderReturnBytes(bytesLeft); // the bytes read ahead belong to the frame footer, they are read after the output
+        m_flacStatus = OUT_SAMPLES;
+        m_sbl += bl - *bytesLeft;
     }
 
-    if(s_flacStatus == OUT_SAMPLES){  // Write the decoded samples
+    if(m_flacStatus == OUT_SAMPLES){  // Write the decoded samples
         // blocksize can be much greater than outbuff, so we can't stuff all in once
         // therefore we need often more than one loop (split outputblock into pieces)
         uint32_t blockSize;
-        if(s_numOfOutSamples < s_flacOutBuffSize + s_offset) blockSize = s_numOfOutSamples - s_offset;
+        if(m_numOfOutSamples < s_flacOutBuffSize + m_offset) blockSize = m_numOfOutSamples - m_offset;
         else blockSize = s_flacOutBuffSize;
 
+        uint8_t reduce = m_FLACMetadataBlock->bitsPerSample > 16 ? m_FLACMetadataBlock->bitsPerSample - 16 : 0; // 20/24 bit to 16 bit
         for (int32_t i = 0; i < blockSize; i++) {
-            for (int32_t j = 0; j < FLACMetadataBlock->numChannels; j++) {
-                int32_t val = s_samplesBuffer[j][i + s_offset];
-                if (FLACMetadataBlock->bitsPerSample == 8) val += 128;
+            for (int32_t j = 0; j < m_FLACMetadataBlock->numChannels; j++) {
+                int32_t val = m_samplesBuffer[j][i + m_offset] >> reduce;
+                if (m_FLACMetadataBlock->bitsPerSample == 8) val += 128;
                 outbuf[2*i+j] = val;
             }
         }
 
-        s_flacValidSamples = blockSize * FLACMetadataBlock->numChannels;
-        s_offset += blockSize;
-        if(sbl > 0){
-            s_flacCompressionRatio = (float)((s_flacValidSamples * 2) * FLACMetadataBlock->numChannels) / sbl; // valid samples are 16 bit
-            sbl = 0;
-            s_flacBitrate = FLACMetadataBlock->sampleRate * FLACMetadataBlock->bitsPerSample * FLACMetadataBlock->numChannels;
-            s_flacBitrate /= s_flacCompressionRatio;
-      //      FLAC_LOG_INFO("s_flacBitrate %i, s_flacCompressionRatio %f, FLACMetadataBlock->sampleRate %i ", s_flacBitrate, s_flacCompressionRatio, FLACMetadataBlock->sampleRate);
+        m_flacValidSamples = blockSize * m_FLACMetadataBlock->numChannels;
+        m_offset += blockSize;
+        if(m_sbl > 0){
+            m_flacCompressionRatio = (float)((m_flacValidSamples * 2) * m_FLACMetadataBlock->numChannels) / m_sbl; // valid samples are 16 bit
+            m_sbl = 0;
+            m_flacBitrate = m_FLACMetadataBlock->sampleRate * m_FLACMetadataBlock->bitsPerSample * m_FLACMetadataBlock->numChannels;
+            m_flacBitrate /= m_flacCompressionRatio;
+      //      FLAC_LOG_INFO("m_flacBitrate %i, m_flacCompressionRatio %f, m_FLACMetadataBlock->sampleRate %i ", m_flacBitrate, m_flacCompressionRatio, m_FLACMetadataBlock->sampleRate);
         }
-        if(s_offset != s_numOfOutSamples) return GIVE_NEXT_LOOP;
-        if(s_offset > s_numOfOutSamples) { FLAC_LOG_ERROR("offset has a wrong value"); }
-        s_offset = 0;
+        if(m_offset != m_numOfOutSamples) return GIVE_NEXT_LOOP;
+        if(m_offset > m_numOfOutSamples) { FLAC_LOG_ERROR("offset has a wrong value"); }
+        m_offset = 0;
     }
 
     alignToByte();
-    readUint(16, bytesLeft);
+    readUint(16, bytesLeft); // frame footer, CRC-16
+    bitReaderReturnBytes(bytesLeft); // the next frame starts behind the CRC
 
-//    s_flacCompressionRatio = (float)m_bytesDecoded / (float)s_numOfOutSamples * FLACMetadataBlock->numChannels * (16/8);
-//    FLAC_LOG_INFO("s_flacCompressionRatio % f", s_flacCompressionRatio);
-    s_flacStatus = DECODE_FRAME;
+//    m_flacCompressionRatio = (float)m_bytesDecoded / (float)m_numOfOutSamples * m_FLACMetadataBlock->numChannels * (16/8);
+//    FLAC_LOG_INFO("m_flacCompressionRatio % f", m_flacCompressionRatio);
+    m_flacStatus = DECODE_FRAME;
     return FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int8_t flacDecodeFrame(uint8_t *inbuf, int32_t *bytesLeft){
+int8_t FLACDecoder::flacDecodeFrame(uint8_t *inbuf, int32_t *bytesLeft){
     if(FLAC_specialIndexOf(inbuf, "OggS", *bytesLeft) == 0){ // async? => new sync is OggS => reset and decode (not page 0 or 1)
-        FLACDecoderReset();
-        s_flacPageNr = 2;
+        reset();
+        m_flacPageNr = 2;
         return FLAC_OGG_SYNC_FOUND;
     }
+    m_flacBitBufferLen = 0; // a frame starts at inbuf
     readUint(14 + 1, bytesLeft); // synccode + reserved bit
-    FLACFrameHeader->blockingStrategy = readUint(1, bytesLeft);
-    FLACFrameHeader->blockSizeCode = readUint(4, bytesLeft);
-    FLACFrameHeader->sampleRateCode = readUint(4, bytesLeft);
-    FLACFrameHeader->chanAsgn = readUint(4, bytesLeft);
-    FLACFrameHeader->sampleSizeCode = readUint(3, bytesLeft);
-    if(!FLACMetadataBlock->numChannels){
-        if(FLACFrameHeader->chanAsgn == 0) FLACMetadataBlock->numChannels = 1;
-        if(FLACFrameHeader->chanAsgn == 1) FLACMetadataBlock->numChannels = 2;
-        if(FLACFrameHeader->chanAsgn > 7)  FLACMetadataBlock->numChannels = 2;
+    m_FLACFrameHeader->blockingStrategy = readUint(1, bytesLeft);
+    m_FLACFrameHeader->blockSizeCode = readUint(4, bytesLeft);
+    m_FLACFrameHeader->sampleRateCode = readUint(4, bytesLeft);
+    m_FLACFrameHeader->chanAsgn = readUint(4, bytesLeft);
+    m_FLACFrameHeader->sampleSizeCode = readUint(3, bytesLeft);
+    if(!m_FLACMetadataBlock->numChannels){
+        if(m_FLACFrameHeader->chanAsgn == 0) m_FLACMetadataBlock->numChannels = 1;
+        if(m_FLACFrameHeader->chanAsgn == 1) m_FLACMetadataBlock->numChannels = 2;
+        if(m_FLACFrameHeader->chanAsgn > 7)  m_FLACMetadataBlock->numChannels = 2;
     }
-    if(FLACMetadataBlock->numChannels < 1) {FLAC_LOG_ERROR("Flac unknown channel assignment, ch: %i", FLACMetadataBlock->numChannels); return FLAC_STOP;}
-        if(!FLACMetadataBlock->bitsPerSample){
-        if(FLACFrameHeader->sampleSizeCode == 1) FLACMetadataBlock->bitsPerSample =  8;
-        if(FLACFrameHeader->sampleSizeCode == 2) FLACMetadataBlock->bitsPerSample = 12;
-        if(FLACFrameHeader->sampleSizeCode == 4) FLACMetadataBlock->bitsPerSample = 16;
-        if(FLACFrameHeader->sampleSizeCode == 5) FLACMetadataBlock->bitsPerSample = 20;
-        if(FLACFrameHeader->sampleSizeCode == 6) FLACMetadataBlock->bitsPerSample = 24;
+    if(m_FLACMetadataBlock->numChannels < 1) {FLAC_LOG_ERROR("Flac unknown channel assignment, ch: %i", m_FLACMetadataBlock->numChannels); return FLAC_STOP;}
+        if(!m_FLACMetadataBlock->bitsPerSample){
+        if(m_FLACFrameHeader->sampleSizeCode == 1) m_FLACMetadataBlock->bitsPerSample =  8;
+        if(m_FLACFrameHeader->sampleSizeCode == 2) m_FLACMetadataBlock->bitsPerSample = 12;
+        if(m_FLACFrameHeader->sampleSizeCode == 4) m_FLACMetadataBlock->bitsPerSample = 16;
+        if(m_FLACFrameHeader->sampleSizeCode == 5) m_FLACMetadataBlock->bitsPerSample = 20;
+        if(m_FLACFrameHeader->sampleSizeCode == 6) m_FLACMetadataBlock->bitsPerSample = 24;
     }
-    if(FLACMetadataBlock->bitsPerSample > 16) {FLAC_LOG_ERROR("Flac, bits per sample > 16, bps: %i", FLACMetadataBlock->bitsPerSample); return FLAC_STOP;}
-    if(FLACMetadataBlock->bitsPerSample < 8 ) {FLAC_LOG_ERROR("Flac, bits per sample <8, bps: %i", FLACMetadataBlock->bitsPerSample); return FLAC_STOP;}
-    if(!FLACMetadataBlock->sampleRate){
-        if(FLACFrameHeader->sampleRateCode == 1)  FLACMetadataBlock->sampleRate =  88200;
-        if(FLACFrameHeader->sampleRateCode == 2)  FLACMetadataBlock->sampleRate = 176400;
-        if(FLACFrameHeader->sampleRateCode == 3)  FLACMetadataBlock->sampleRate = 192000;
-        if(FLACFrameHeader->sampleRateCode == 4)  FLACMetadataBlock->sampleRate =   8000;
-        if(FLACFrameHeader->sampleRateCode == 5)  FLACMetadataBlock->sampleRate =  16000;
-        if(FLACFrameHeader->sampleRateCode == 6)  FLACMetadataBlock->sampleRate =  22050;
-        if(FLACFrameHeader->sampleRateCode == 7)  FLACMetadataBlock->sampleRate =  24000;
-        if(FLACFrameHeader->sampleRateCode == 8)  FLACMetadataBlock->sampleRate =  32000;
-        if(FLACFrameHeader->sampleRateCode == 9)  FLACMetadataBlock->sampleRate =  44100;
-        if(FLACFrameHeader->sampleRateCode == 10) FLACMetadataBlock->sampleRate =  48000;
-        if(FLACFrameHeader->sampleRateCode == 11) FLACMetadataBlock->sampleRate =  96000;
+    if(m_FLACMetadataBlock->bitsPerSample > 24) {FLAC_LOG_ERROR("Flac, bits per sample > 24, bps: %i", m_FLACMetadataBlock->bitsPerSample); return FLAC_STOP;}
+    if(m_FLACMetadataBlock->bitsPerSample < 8 ) {FLAC_LOG_ERROR("Flac, bits per sample <8, bps: %i", m_FLACMetadataBlock->bitsPerSample); return FLAC_STOP;}
+    if(!m_FLACMetadataBlock->sampleRate){
+        if(m_FLACFrameHeader->sampleRateCode == 1)  m_FLACMetadataBlock->sampleRate =  88200;
+        if(m_FLACFrameHeader->sampleRateCode == 2)  m_FLACMetadataBlock->sampleRate = 176400;
+        if(m_FLACFrameHeader->sampleRateCode == 3)  m_FLACMetadataBlock->sampleRate = 192000;
+        if(m_FLACFrameHeader->sampleRateCode == 4)  m_FLACMetadataBlock->sampleRate =   8000;
+        if(m_FLACFrameHeader->sampleRateCode == 5)  m_FLACMetadataBlock->sampleRate =  16000;
+        if(m_FLACFrameHeader->sampleRateCode == 6)  m_FLACMetadataBlock->sampleRate =  22050;
+        if(m_FLACFrameHeader->sampleRateCode == 7)  m_FLACMetadataBlock->sampleRate =  24000;
+        if(m_FLACFrameHeader->sampleRateCode == 8)  m_FLACMetadataBlock->sampleRate =  32000;
+        if(m_FLACFrameHeader->sampleRateCode == 9)  m_FLACMetadataBlock->sampleRate =  44100;
+        if(m_FLACFrameHeader->sampleRateCode == 10) m_FLACMetadataBlock->sampleRate =  48000;
+        if(m_FLACFrameHeader->sampleRateCode == 11) m_FLACMetadataBlock->sampleRate =  96000;
     }
     readUint(1, bytesLeft);
     uint32_t temp = (readUint(8, bytesLeft) << 24);
@@ -783,116 +813,117 @@ int8_t flacDecodeFrame(uint8_t *inbuf, int32_t *bytesLeft){
     }
     count--;
     for (int32_t i = 0; i < count; i++) readUint(8, bytesLeft);
-    s_numOfOutSamples = 0;
-    if (FLACFrameHeader->blockSizeCode == 1)
-        s_numOfOutSamples = 192;
-    else if (2 <= FLACFrameHeader->blockSizeCode && FLACFrameHeader->blockSizeCode <= 5)
-        s_numOfOutSamples = 576 << (FLACFrameHeader->blockSizeCode - 2);
-    else if (FLACFrameHeader->blockSizeCode == 6)
-        s_numOfOutSamples = readUint(8, bytesLeft) + 1;
-    else if (FLACFrameHeader->blockSizeCode == 7)
-        s_numOfOutSamples = readUint(16, bytesLeft) + 1;
-    else if (8 <= FLACFrameHeader->blockSizeCode && FLACFrameHeader->blockSizeCode <= 15)
-        s_numOfOutSamples = 256 << (FLACFrameHeader->blockSizeCode - 8);
+    m_numOfOutSamples = 0;
+    if (m_FLACFrameHeader->blockSizeCode == 1)
+        m_numOfOutSamples = 192;
+    else if (2 <= m_FLACFrameHeader->blockSizeCode && m_FLACFrameHeader->blockSizeCode <= 5)
+        m_numOfOutSamples = 576 << (m_FLACFrameHeader->blockSizeCode - 2);
+    else if (m_FLACFrameHeader->blockSizeCode == 6)
+        m_numOfOutSamples = readUint(8, bytesLeft) + 1;
+    else if (m_FLACFrameHeader->blockSizeCode == 7)
+        m_numOfOutSamples = readUint(16, bytesLeft) + 1;
+    else if (8 <= m_FLACFrameHeader->blockSizeCode && m_FLACFrameHeader->blockSizeCode <= 15)
+        m_numOfOutSamples = 256 << (m_FLACFrameHeader->blockSizeCode - 8);
     else{
-        FLAC_LOG_ERROR("Flac, reserved blocksize unsupported, block size code: %i", FLACFrameHeader->blockSizeCode);
+        FLAC_LOG_ERROR("Flac, reserved blocksize unsupported, block size code: %i", m_FLACFrameHeader->blockSizeCode);
         return FLAC_ERR;
     }
-    if(s_numOfOutSamples > FLAC_MAX_OUTBUFFSIZE){
-        FLAC_LOG_ERROR("Flac, blockSizeOut too big ,%i bytes", s_numOfOutSamples);
+    if(m_numOfOutSamples > FLAC_MAX_OUTBUFFSIZE){
+        FLAC_LOG_ERROR("Flac, blockSizeOut too big ,%i bytes", m_numOfOutSamples);
         return FLAC_ERR;
     }
-    if(FLACFrameHeader->sampleRateCode == 12)
+    if(m_FLACFrameHeader->sampleRateCode == 12)
         readUint(8, bytesLeft);
-    else if (FLACFrameHeader->sampleRateCode == 13 || FLACFrameHeader->sampleRateCode == 14){
+    else if (m_FLACFrameHeader->sampleRateCode == 13 || m_FLACFrameHeader->sampleRateCode == 14){
         readUint(16, bytesLeft);
     }
     readUint(8, bytesLeft);
-    s_flacStatus = DECODE_SUBFRAMES;
+    m_flacStatus = DECODE_SUBFRAMES;
     return FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint32_t FLACGetOutputSamps(){
-    uint32_t vs = s_flacValidSamples;
-    s_flacValidSamples=0;
+uint32_t FLACDecoder::getOutputSamps(){
+    uint32_t vs = m_flacValidSamples;
+    m_flacValidSamples=0;
     return vs;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint64_t FLACGetTotoalSamplesInStream(){
-    if(!FLACMetadataBlock) return 0;
-    return FLACMetadataBlock->totalSamples;
+uint64_t FLACDecoder::getTotalSamplesInStream(){
+    if(!m_FLACMetadataBlock) return 0;
+    return m_FLACMetadataBlock->totalSamples;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint8_t FLACGetBitsPerSample(){
-    if(!FLACMetadataBlock) return 0;
-    return FLACMetadataBlock->bitsPerSample;
+uint8_t FLACDecoder::getBitsPerSample(){ // of the output, 20 and 24 bit sources are reduced to 16 bit
+    if(!m_FLACMetadataBlock) return 0;
+    if(m_FLACMetadataBlock->bitsPerSample > 16) return 16;
+    return m_FLACMetadataBlock->bitsPerSample;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint8_t FLACGetChannels(){
-    if(!FLACMetadataBlock) return 0;
-    return FLACMetadataBlock->numChannels;
+uint8_t FLACDecoder::getChannels(){
+    if(!m_FLACMetadataBlock) return 0;
+    return m_FLACMetadataBlock->numChannels;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint32_t FLACGetSampRate(){
-    if(!FLACMetadataBlock) return 0;
-    return FLACMetadataBlock->sampleRate;
+uint32_t FLACDecoder::getSampRate(){
+    if(!m_FLACMetadataBlock) return 0;
+    return m_FLACMetadataBlock->sampleRate;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint32_t FLACGetBitRate(){
-    return s_flacBitrate;
+uint32_t FLACDecoder::getBitRate(){
+    return m_flacBitrate;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint32_t FLACGetAudioDataStart(){
-    return s_flacAudioDataStart;
+uint32_t FLACDecoder::getAudioDataStart(){
+    return m_flacAudioDataStart;
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint32_t FLACGetAudioFileDuration() {
-    if(FLACGetSampRate()){ // DIV0
-        uint32_t afd = FLACGetTotoalSamplesInStream()/ FLACGetSampRate(); // AudioFileDuration
+uint32_t FLACDecoder::getAudioFileDuration() {
+    if(getSampRate()){ // DIV0
+        uint32_t afd = getTotalSamplesInStream()/ getSampRate(); // AudioFileDuration
         return afd;
     }
     return 0;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int8_t decodeSubframes(int32_t* bytesLeft){
-    if(FLACFrameHeader->chanAsgn <= 7) {
-        for (int32_t ch = 0; ch < FLACMetadataBlock->numChannels; ch++)
-            decodeSubframe(FLACMetadataBlock->bitsPerSample, ch, bytesLeft);
+int8_t FLACDecoder::decodeSubframes(int32_t* bytesLeft){
+    if(m_FLACFrameHeader->chanAsgn <= 7) {
+        for (int32_t ch = 0; ch < m_FLACMetadataBlock->numChannels; ch++)
+            decodeSubframe(m_FLACMetadataBlock->bitsPerSample, ch, bytesLeft);
     }
-    else if (8 <= FLACFrameHeader->chanAsgn && FLACFrameHeader->chanAsgn <= 10) {
-        decodeSubframe(FLACMetadataBlock->bitsPerSample + (FLACFrameHeader->chanAsgn == 9 ? 1 : 0), 0, bytesLeft);
-        decodeSubframe(FLACMetadataBlock->bitsPerSample + (FLACFrameHeader->chanAsgn == 9 ? 0 : 1), 1, bytesLeft);
-        if(FLACFrameHeader->chanAsgn == 8) {
-            for (int32_t i = 0; i < s_numOfOutSamples; i++)
-                s_samplesBuffer[1][i] = (
-                        s_samplesBuffer[0][i] -
-                        s_samplesBuffer[1][i]);
+    else if (8 <= m_FLACFrameHeader->chanAsgn && m_FLACFrameHeader->chanAsgn <= 10) {
+        decodeSubframe(m_FLACMetadataBlock->bitsPerSample + (m_FLACFrameHeader->chanAsgn == 9 ? 1 : 0), 0, bytesLeft);
+        decodeSubframe(m_FLACMetadataBlock->bitsPerSample + (m_FLACFrameHeader->chanAsgn == 9 ? 0 : 1), 1, bytesLeft);
+        if(m_FLACFrameHeader->chanAsgn == 8) {
+            for (int32_t i = 0; i < m_numOfOutSamples; i++)
+                m_samplesBuffer[1][i] = (
+                        m_samplesBuffer[0][i] -
+                        m_samplesBuffer[1][i]);
         }
-        else if (FLACFrameHeader->chanAsgn == 9) {
-            for (int32_t i = 0; i < s_numOfOutSamples; i++)
-                s_samplesBuffer[0][i] += s_samplesBuffer[1][i];
+        else if (m_FLACFrameHeader->chanAsgn == 9) {
+            for (int32_t i = 0; i < m_numOfOutSamples; i++)
+                m_samplesBuffer[0][i] += m_samplesBuffer[1][i];
         }
-        else if (FLACFrameHeader->chanAsgn == 10) {
-            for (int32_t i = 0; i < s_numOfOutSamples; i++) {
-                int32_t side =  s_samplesBuffer[1][i];
-                int32_t right = s_samplesBuffer[0][i] - (side >> 1);
-                s_samplesBuffer[1][i] = right;
-                s_samplesBuffer[0][i] = right + side;
+        else if (m_FLACFrameHeader->chanAsgn == 10) {
+            for (int32_t i = 0; i < m_numOfOutSamples; i++) {
+                int32_t side =  m_samplesBuffer[1][i];
+                int32_t right = m_samplesBuffer[0][i] - (side >> 1);
+                m_samplesBuffer[1][i] = right;
+                m_samplesBuffer[0][i] = right + side;
             }
         }
         else {
-            FLAC_LOG_ERROR("Flac, unknown channel assignment, %i", FLACFrameHeader->chanAsgn);
+            FLAC_LOG_ERROR("Flac, unknown channel assignment, %i", m_FLACFrameHeader->chanAsgn);
             return FLAC_ERR;
         }
     }
     else{
-        FLAC_LOG_ERROR("Flac reserved channel assignment, %i", FLACFrameHeader->chanAsgn);
+        FLAC_LOG_ERROR("Flac reserved channel assignment, %i", m_FLACFrameHeader->chanAsgn);
         return FLAC_ERR;
     }
     return FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int8_t decodeSubframe(uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft) {
+int8_t FLACDecoder::decodeSubframe(uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft) {
     int8_t ret = 0;
     readUint(1, bytesLeft);                // Zero bit padding, to prevent sync-fooling string of 1s
     uint8_t type = readUint(6, bytesLeft); // Subframe type: 000000 : SUBFRAME_CONSTANT
@@ -911,15 +942,16 @@ int8_t decodeSubframe(uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft) {
     }
     sampleDepth -= shift;
 
+    int32_t* samples = m_samplesBuffer[ch].get();
     if(type == 0){  // Constant coding
         int32_t s= readSignedInt(sampleDepth, bytesLeft);                                    // SUBFRAME_CONSTANT
-        for(int32_t i = 0; i < s_numOfOutSamples; i++){
-            s_samplesBuffer[ch][i] = s;
+        for(int32_t i = 0; i < m_numOfOutSamples; i++){
+            samples[i] = s;
         }
     }
     else if (type == 1) {  // Verbatim coding
-        for (int32_t i = 0; i < s_numOfOutSamples; i++)
-            s_samplesBuffer[ch][i] = readSignedInt(sampleDepth, bytesLeft);                  // SUBFRAME_VERBATIM
+        for (int32_t i = 0; i < m_numOfOutSamples; i++)
+            samples[i] = readSignedInt(sampleDepth, bytesLeft);                  // SUBFRAME_VERBATIM
     }
     else if (8 <= type && type <= 12){
         ret = decodeFixedPredictionSubframe(type - 8, sampleDepth, ch, bytesLeft);           // SUBFRAME_FIXED
@@ -934,50 +966,45 @@ int8_t decodeSubframe(uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft) {
         return FLAC_ERR;
     }
     if(shift>0){
-        for (int32_t i = 0; i < s_numOfOutSamples; i++){
-            s_samplesBuffer[ch][i] <<= shift;
+        for (int32_t i = 0; i < m_numOfOutSamples; i++){
+            samples[i] <<= shift;
         }
     }
     return FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------------------------------------
-int8_t decodeFixedPredictionSubframe(uint8_t predOrder, uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft) {     // SUBFRAME_FIXED
+int8_t FLACDecoder::decodeFixedPredictionSubframe(uint8_t predOrder, uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft) {     // SUBFRAME_FIXED
 
     uint8_t ret = 0;
+    if(predOrder > 4) {FLAC_LOG_ERROR("Flac preorder too big: %i", predOrder); return FLAC_ERR;} // Error: preorder > 4"
     for(uint8_t i = 0; i < predOrder; i++)
-        s_samplesBuffer[ch][i] = readSignedInt(sampleDepth, bytesLeft); // Unencoded warm-up samples (n = frame's bits-per-sample * predictor order).
+        m_samplesBuffer[ch][i] = readSignedInt(sampleDepth, bytesLeft); // Unencoded warm-up samples (n = frame's bits-per-sample * predictor order).
     ret = decodeResiduals(predOrder, ch, bytesLeft);
     if(ret) return ret;
-    coefs.clear(); coefs.shrink_to_fit();
-    if(predOrder == 0) coefs.resize(0);
-    if(predOrder == 1) coefs.push_back(1);  // FIXED_PREDICTION_COEFFICIENTS
-    if(predOrder == 2){coefs.push_back(2); coefs.push_back(-1);}
-    if(predOrder == 3){coefs.push_back(3); coefs.push_back(-3); coefs.push_back(1);}
-    if(predOrder == 4){coefs.push_back(4); coefs.push_back(-6); coefs.push_back(4); coefs.push_back(-1);}
-    if(predOrder > 4) {FLAC_LOG_ERROR("Flac preorder too big: %i", predOrder); return FLAC_ERR;} // Error: preorder > 4"
-    restoreLinearPrediction(ch, 0);
+    restoreFixedPrediction(ch, predOrder);
     return FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int8_t decodeLinearPredictiveCodingSubframe(int32_t lpcOrder, int32_t sampleDepth, uint8_t ch, int32_t* bytesLeft){
+int8_t FLACDecoder::decodeLinearPredictiveCodingSubframe(int32_t lpcOrder, int32_t sampleDepth, uint8_t ch, int32_t* bytesLeft){
 
     int8_t ret = 0;
     for (int32_t i = 0; i < lpcOrder; i++){
-        s_samplesBuffer[ch][i] = readSignedInt(sampleDepth, bytesLeft); // Unencoded warm-up samples (n = frame's bits-per-sample * lpc order).
+        m_samplesBuffer[ch][i] = readSignedInt(sampleDepth, bytesLeft); // Unencoded warm-up samples (n = frame's bits-per-sample * lpc order).
     }
     int32_t precision = readUint(4, bytesLeft) + 1;                         // (Quantized linear predictor coefficients' precision in bits)-1 (1111 = invalid).
     int32_t shift = readSignedInt(5, bytesLeft);                            // Quantized linear predictor coefficient shift needed in bits (NOTE: this number is signed two's-complement).
-    coefs.clear(); coefs.shrink_to_fit();
+    if(precision == 16) {FLAC_LOG_ERROR("Flac, invalid LPC precision"); return FLAC_ERR;}
+    if(shift < 0) {FLAC_LOG_ERROR("Flac, negative LPC shift: %i", shift); return FLAC_ERR;}
     for (uint8_t i = 0; i < lpcOrder; i++){
-        coefs.push_back(readSignedInt(precision, bytesLeft));           // Unencoded predictor coefficients (n = qlp coeff precision * lpc order) (NOTE: the coefficients are signed two's-complement).
+        m_flacCoefs[i] = readSignedInt(precision, bytesLeft);               // Unencoded predictor coefficients (n = qlp coeff precision * lpc order) (NOTE: the coefficients are signed two's-complement).
     }
     ret = decodeResiduals(lpcOrder, ch, bytesLeft);
     if(ret) return ret;
-    restoreLinearPrediction(ch, shift);
+    restoreLinearPrediction(ch, lpcOrder, shift, sampleDepth);
     return FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int8_t decodeResiduals(uint8_t warmup, uint8_t ch, int32_t* bytesLeft) {
+int8_t FLACDecoder::decodeResiduals(uint8_t warmup, uint8_t ch, int32_t* bytesLeft) {
 
     int32_t method = readUint(2, bytesLeft);                          // Residual coding method:
                                                                   // 00 : partitioned Rice coding with 4-bit Rice parameter; RESIDUAL_CODING_METHOD_PARTITIONED_RICE follows
@@ -989,47 +1016,79 @@ int8_t decodeResiduals(uint8_t warmup, uint8_t ch, int32_t* bytesLeft) {
     int32_t partitionOrder = readUint(4, bytesLeft);                  // Partition order
     int32_t numPartitions = 1 << partitionOrder;                      // There will be 2^order partitions.
 
-    if (s_numOfOutSamples % numPartitions != 0){
+    if (m_numOfOutSamples % numPartitions != 0){
         FLAC_LOG_ERROR("Flac, wrong rice partition number");
         return FLAC_ERR;                  //Error: Block size not divisible by number of Rice partitions
     }
-    int32_t partitionSize = s_numOfOutSamples / numPartitions;
+    int32_t partitionSize = m_numOfOutSamples / numPartitions;
+    int32_t* samples = m_samplesBuffer[ch].get();
 
     for (int32_t i = 0; i < numPartitions; i++) {
         int32_t start = i * partitionSize + (i == 0 ? warmup : 0);
         int32_t end = (i + 1) * partitionSize;
 
         int32_t param = readUint(paramBits, bytesLeft);
+        if(m_f_bitReaderError) break;
         if (param < escapeParam) {
-            for (int32_t j = start; j < end; j++){
-                if(s_f_bitReaderError) break;
-                s_samplesBuffer[ch][j] = readRiceSignedInt(param, bytesLeft);
-            }
+            if(!readRicePartition(samples + start, end - start, param, bytesLeft)) break;
         }
         else {
             int32_t numBits = readUint(5, bytesLeft);                 // Escape code, meaning the partition is in unencoded binary form using n bits per sample; n follows as a 5-bit number.
             for (int32_t j = start; j < end; j++){
-                if(s_f_bitReaderError) break;
-                s_samplesBuffer[ch][j] = readSignedInt(numBits, bytesLeft);
+                if(m_f_bitReaderError) break;
+                samples[j] = readSignedInt(numBits, bytesLeft);
             }
         }
     }
-    if(s_f_bitReaderError) {FLAC_LOG_ERROR("Flac bitreader underflow"); return FLAC_ERR;}
+    if(m_f_bitReaderError) {FLAC_LOG_ERROR("Flac bitreader underflow"); return FLAC_ERR;}
     return FLAC_NONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
-void restoreLinearPrediction(uint8_t ch, uint8_t shift) {
-
-    for (int32_t i = coefs.size(); i < s_numOfOutSamples; i++) {
-        int32_t sum = 0;
-        for (int32_t j = 0; j < coefs.size(); j++){
-            sum += s_samplesBuffer[ch][i - 1 - j] * coefs[j];
-        }
-        s_samplesBuffer[ch][i] += (sum >> shift);
+void FLACDecoder::restoreFixedPrediction(uint8_t ch, uint8_t order) {
+    uint32_t* s = (uint32_t*)m_samplesBuffer[ch].get(); // wraps around instead of overflowing on broken streams
+    int32_t  n = m_numOfOutSamples;
+    switch(order) { // FIXED_PREDICTION_COEFFICIENTS
+        case 1: for (int32_t i = 1; i < n; i++) s[i] += s[i - 1]; break;
+        case 2: for (int32_t i = 2; i < n; i++) s[i] += 2 * s[i - 1] - s[i - 2]; break;
+        case 3: for (int32_t i = 3; i < n; i++) s[i] += 3 * (s[i - 1] - s[i - 2]) + s[i - 3]; break;
+        case 4: for (int32_t i = 4; i < n; i++) s[i] += 4 * (s[i - 1] + s[i - 3]) - 6 * s[i - 2] - s[i - 4]; break;
+        default: break; // order 0: the residuals are the samples
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------
+// LPC restore kernel, ORDER > 0 is known at compile time and the inner loop is unrolled, ORDER == 0 takes the order
+// from the stream. T is the accumulator, uint32_t (wraps around on broken streams) or int64_t if the prediction can
+// exceed 32 bit (20/24 bit sources).
+template <int32_t ORDER, typename T>
+static void restoreLPC(int32_t* s, int32_t n, const int32_t* coefs, int32_t order, uint8_t shift) {
+    if (ORDER) order = ORDER;
+    for (int32_t i = order; i < n; i++) {
+        T sum = 0;
+        for (int32_t j = 0; j < (ORDER ? ORDER : order); j++) sum += (T)coefs[j] * (T)s[i - 1 - j];
+        s[i] = (uint32_t)s[i] + (uint32_t)((std::make_signed_t<T>)sum >> shift);
     }
 }
+
+typedef void (*restoreLPC_t)(int32_t*, int32_t, const int32_t*, int32_t, uint8_t);
+static const restoreLPC_t s_restoreLPC32[13] = {restoreLPC<0, uint32_t>,  restoreLPC<1, uint32_t>,  restoreLPC<2, uint32_t>,  restoreLPC<3, uint32_t>,
+                                                restoreLPC<4, uint32_t>,  restoreLPC<5, uint32_t>,  restoreLPC<6, uint32_t>,  restoreLPC<7, uint32_t>,
+                                                restoreLPC<8, uint32_t>,  restoreLPC<9, uint32_t>,  restoreLPC<10, uint32_t>, restoreLPC<11, uint32_t>,
+                                                restoreLPC<12, uint32_t>};
+static const restoreLPC_t s_restoreLPC64[13] = {restoreLPC<0, int64_t>,  restoreLPC<1, int64_t>,  restoreLPC<2, int64_t>,  restoreLPC<3, int64_t>,
+                                                restoreLPC<4, int64_t>,  restoreLPC<5, int64_t>,  restoreLPC<6, int64_t>,  restoreLPC<7, int64_t>,
+                                                restoreLPC<8, int64_t>,  restoreLPC<9, int64_t>,  restoreLPC<10, int64_t>, restoreLPC<11, int64_t>,
+                                                restoreLPC<12, int64_t>};
+
+void FLACDecoder::restoreLinearPrediction(uint8_t ch, uint8_t order, uint8_t shift, uint8_t sampleDepth) {
+    // |prediction| <= 2^(sampleDepth - 1) * sum(|coef|), 32 bit are enough if sampleDepth + log2(sum(|coef|)) <= 32
+    uint32_t absSum = 0;
+    for (uint8_t j = 0; j < order; j++) absSum += abs(m_flacCoefs[j]);
+    uint8_t bits = sampleDepth + (absSum > 1 ? 32 - __builtin_clz(absSum - 1) : 0);
+    const restoreLPC_t* kernel = bits <= 32 ? s_restoreLPC32 : s_restoreLPC64;
+    kernel[order <= 12 ? order : 0](m_samplesBuffer[ch].get(), m_numOfOutSamples, m_flacCoefs, order, shift);
+}
 //----------------------------------------------------------------------------------------------------------------------
-int32_t FLAC_specialIndexOf(uint8_t* base, const char* str, int32_t baselen, bool exact){
+int32_t FLACDecoder::FLAC_specialIndexOf(uint8_t* base, const char* str, int32_t baselen, bool exact){
     int32_t result = 0;  // seek for str in buffer or in header up to baselen, not nullterninated
     if (strlen(str) > baselen) return -1; // if exact == true seekstr in buffer must have "\0" at the end
     for (int32_t i = 0; i < baselen - strlen(str); i++){
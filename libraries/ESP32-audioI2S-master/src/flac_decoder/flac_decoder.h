@@ -137,41 +137,88 @@ typedef struct FLACFrameHeader_t {
 
 }FLACFrameHeader_t;
 
-int32_t          FLACFindSyncWord(unsigned char* buf, int32_t nBytes);
-boolean          FLACFindMagicWord(unsigned char* buf, int32_t nBytes);
-char*            FLACgetStreamTitle();
-int32_t          FLACparseOGG(uint8_t* inbuf, int32_t* bytesLeft);
-vector<uint32_t> FLACgetMetadataBlockPicture();
-int32_t          parseFlacFirstPacket(uint8_t* inbuf, int16_t nBytes);
-int32_t          parseMetaDataBlockHeader(uint8_t* inbuf, int16_t nBytes);
-bool             FLACDecoder_AllocateBuffers(void);
-void             FLACDecoder_setDefaults();
-void             FLACDecoder_ClearBuffer();
-void             FLACDecoder_FreeBuffers();
-void             FLACSetRawBlockParams(uint8_t Chans, uint32_t SampRate, uint8_t BPS, uint32_t tsis, uint32_t AuDaLength);
-void             FLACDecoderReset();
-int8_t           FLACDecode(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
-int8_t           FLACDecodeNative(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
-int8_t           flacDecodeFrame(uint8_t* inbuf, int32_t* bytesLeft);
-uint32_t         FLACGetOutputSamps();
-uint64_t         FLACGetTotoalSamplesInStream();
-uint8_t          FLACGetBitsPerSample();
-uint8_t          FLACGetChannels();
-uint32_t         FLACGetSampRate();
-uint32_t         FLACGetBitRate();
-uint32_t         FLACGetAudioDataStart();
-uint32_t         FLACGetAudioFileDuration();
-uint32_t         readUint(uint8_t nBits, int32_t* bytesLeft);
-int32_t          readSignedInt(int32_t nBits, int32_t* bytesLeft);
-int64_t          readRiceSignedInt(uint8_t param, int32_t* bytesLeft);
-void             alignToByte();
-int8_t           decodeSubframes(int32_t* bytesLeft);
-int8_t           decodeSubframe(uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft);
-int8_t           decodeFixedPredictionSubframe(uint8_t predOrder, uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft);
-int8_t           decodeLinearPredictiveCodingSubframe(int32_t lpcOrder, int32_t sampleDepth, uint8_t ch, int32_t* bytesLeft);
-int8_t           decodeResiduals(uint8_t warmup, uint8_t ch, int32_t* bytesLeft);
-void             restoreLinearPrediction(uint8_t ch, uint8_t shift);
-int32_t          FLAC_specialIndexOf(uint8_t* base, const char* str, int32_t baselen, bool exact = false);
+// Decoder instance, all state of a stream lives in the object. Several instances can decode different streams
+// concurrently (e.g. in tasks on both cores), one instance must not be used by two tasks at the same time.
+class FLACDecoder {
+public:
+    bool             allocateBuffers();
+    void             freeBuffers();
+    void             clearBuffers();
+    void             reset();
+    void             setRawBlockParams(uint8_t Chans, uint32_t SampRate, uint8_t BPS, uint32_t tsis, uint32_t AuDaLength);
+    int32_t          findSyncWord(unsigned char* buf, int32_t nBytes);
+    int8_t           decode(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
+    uint32_t         getOutputSamps();
+    uint8_t          getBitsPerSample();
+    uint8_t          getChannels();
+    uint32_t         getSampRate();
+    uint32_t         getBitRate();
+    uint32_t         getAudioDataStart();
+    uint32_t         getAudioFileDuration();
+    uint64_t         getTotalSamplesInStream();
+    char*            getStreamTitle();
+    vector<uint32_t> getMetadataBlockPicture();
+
+private:
+    boolean          FLACFindMagicWord(unsigned char* buf, int32_t nBytes);
+    int32_t          FLACparseOGG(uint8_t* inbuf, int32_t* bytesLeft);
+    int32_t          parseFlacFirstPacket(uint8_t* inbuf, int16_t nBytes);
+    int32_t          parseMetaDataBlockHeader(uint8_t* inbuf, int16_t nBytes);
+    void             FLACDecoder_setDefaults();
+    int8_t           FLACDecodeNative(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
+    int8_t           flacDecodeFrame(uint8_t* inbuf, int32_t* bytesLeft);
+    uint32_t         readUint(uint8_t nBits, int32_t* bytesLeft);
+    int32_t          readSignedInt(int32_t nBits, int32_t* bytesLeft);
+    bool             readRicePartition(int32_t* out, int32_t count, uint8_t param, int32_t* bytesLeft);
+    void             alignToByte();
+    void             bitReaderReturnBytes(int32_t* bytesLeft);
+    int8_t           decodeSubframes(int32_t* bytesLeft);
+    int8_t           decodeSubframe(uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft);
+    int8_t           decodeFixedPredictionSubframe(uint8_t predOrder, uint8_t sampleDepth, uint8_t ch, int32_t* bytesLeft);
+    int8_t           decodeLinearPredictiveCodingSubframe(int32_t lpcOrder, int32_t sampleDepth, uint8_t ch, int32_t* bytesLeft);
+    int8_t           decodeResiduals(uint8_t warmup, uint8_t ch, int32_t* bytesLeft);
+    void             restoreFixedPrediction(uint8_t ch, uint8_t order);
+    void             restoreLinearPrediction(uint8_t ch, uint8_t order, uint8_t shift, uint8_t sampleDepth);
+    int32_t          FLAC_specialIndexOf(uint8_t* base, const char* str, int32_t baselen, bool exact = false);
+
+    ps_ptr<FLACFrameHeader_t>   m_FLACFrameHeader;
+    ps_ptr<FLACMetadataBlock_t> m_FLACMetadataBlock;
+    vector<uint32_t> m_flacSegmTableVec;
+    int32_t          m_flacCoefs[32] = {}; // quantized LPC coefficients of the current subframe
+    vector<uint32_t> m_flacBlockPicItem;
+    uint64_t         m_flac_bitBuffer = 0;
+    uint32_t         m_flacBitrate = 0;
+    uint32_t         m_flacBlockPicLenUntilFrameEnd = 0;
+    uint32_t         m_flacCurrentFilePos = 0;
+    uint32_t         m_flacBlockPicPos = 0;
+    uint32_t         m_flacBlockPicLen = 0;
+    uint32_t         m_flacAudioDataStart = 0;
+    int32_t          m_flacRemainBlockPicLen = 0;
+    uint16_t         m_numOfOutSamples = 0;
+    uint16_t         m_flacValidSamples = 0;
+    uint16_t         m_rIndex = 0;
+    uint16_t         m_offset = 0;
+    uint8_t          m_flacStatus = 0;
+    uint8_t*         m_flacInptr = nullptr;
+    float            m_flacCompressionRatio = 0;
+    uint8_t          m_flacBitBufferLen = 0;
+    bool             m_f_flacParseOgg = false;
+    bool             m_f_bitReaderError = false;
+    uint8_t          m_flac_pageSegments = 0;
+    ps_ptr<char>     m_flacStreamTitle = {};
+    ps_ptr<char>     m_flacVendorString = {};
+    bool             m_f_flacNewStreamtitle = false;
+    bool             m_f_flacFirstCall = true;
+    bool             m_f_oggWrapper = false;
+    bool             m_f_lastMetaDataBlock = false;
+    bool             m_f_flacNewMetadataBlockPicture = false;
+    uint8_t          m_flacPageNr = 0;
+    std::vector<ps_ptr<int32_t>> m_samplesBuffer;
+    uint16_t         m_maxBlocksize = FLAC_MAX_BLOCKSIZE;
+    int32_t          m_nBytes = 0;
+    uint32_t         m_segmLenTmp = 0;
+    int32_t          m_sbl = 0;
+};
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
     // 📌📌📌  L O G G I N G   📌📌📌
@@ -36,22 +36,19 @@ const uint8_t  m_NGRANS_MPEG1           =2;
 const uint8_t  m_NGRANS_MPEG2           =1;
 const uint32_t m_SQRTHALF               =0x5a82799a;  // sqrt(0.5) in Q31 format
 
+static const char* mpeg_version_table[] = {
+    "MPEG-1",      // 0
+    "MPEG-2",      // 1
+    "MPEG-2.5",    // 2
+    "MPEG-INVALID" // 3
+};
 
-MP3FrameInfo_t *m_MP3FrameInfo;
-SFBandTable_t m_SFBandTable;
-StereoMode_t m_sMode;  /* mono/stereo mode */
-MPEGVersion_t m_MPEGVersion;  /* version ID */
-FrameHeader_t *m_FrameHeader;
-SideInfoSub_t m_SideInfoSub[m_MAX_NGRAN][m_MAX_NCHAN];
-SideInfo_t *m_SideInfo;
-CriticalBandInfo_t m_CriticalBandInfo[m_MAX_NCHAN];  /* filled in dequantizer, used in joint stereo reconstruction */
-DequantInfo_t *m_DequantInfo;
-HuffmanInfo_t *m_HuffmanInfo;
-IMDCTInfo_t *m_IMDCTInfo;
-ScaleFactorInfoSub_t m_ScaleFactorInfoSub[m_MAX_NGRAN][m_MAX_NCHAN];
-ScaleFactorJS_t *m_ScaleFactorJS;
-SubbandInfo_t *m_SubbandInfo;
-MP3DecInfo_t *m_MP3DecInfo;
+static const char* layer_table[] = {
+    "Unknown",   // 0
+    "Layer I",   // 1
+    "Layer II",  // 2
+    "Layer III"  // 3
+};
 
 const uint16_t huffTable[4242] PROGMEM = {
     /* huffTable01[9] */
@@ -692,7 +689,7 @@ const uint32_t m_dcttab[48] PROGMEM = { // faster in ROM
  * B I T S T R E A M
  **********************************************************************************************************************/
 
-void SetBitstreamPointer(BitStreamInfo_t *bsi, int32_t nBytes, uint8_t *buf) {
+void MP3Decoder::SetBitstreamPointer(BitStreamInfo_t *bsi, int32_t nBytes, uint8_t *buf) {
     /* init bitstream */
     bsi->bytePtr = buf;
     bsi->iCache = 0; /* 4-byte uint32_t */
@@ -700,7 +697,7 @@ void SetBitstreamPointer(BitStreamInfo_t *bsi, int32_t nBytes, uint8_t *buf) {
     bsi->nBytes = nBytes;
 }
 //----------------------------------------------------------------------------------------------------------------------
-void RefillBitstreamCache(BitStreamInfo_t *bsi) {
+void MP3Decoder::RefillBitstreamCache(BitStreamInfo_t *bsi) {
    int32_t nBytes = bsi->nBytes;
     /* optimize for common case, independent of machine endian-ness */
     if (nBytes >= 4) {
@@ -722,7 +719,7 @@ void RefillBitstreamCache(BitStreamInfo_t *bsi) {
     }
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint32_t GetBits(BitStreamInfo_t *bsi, int32_t nBits) {
+uint32_t MP3Decoder::GetBits(BitStreamInfo_t *bsi, int32_t nBits) {
     uint32_t data, lowBits;
 
     nBits &= 0x1f; /* nBits mod 32 to avoid unpredictable results like >> by negative amount */
@@ -740,7 +737,7 @@ uint32_t GetBits(BitStreamInfo_t *bsi, int32_t nBits) {
     return data;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t CalcBitsUsed(BitStreamInfo_t *bsi, uint8_t *startBuf, int32_t startOffset){
+int32_t MP3Decoder::CalcBitsUsed(BitStreamInfo_t *bsi, uint8_t *startBuf, int32_t startOffset){
    int32_t bitsUsed;
     bitsUsed = (bsi->bytePtr - startBuf) * 8;
     bitsUsed -= bsi->cachedBits;
@@ -748,11 +745,11 @@ int32_t CalcBitsUsed(BitStreamInfo_t *bsi, uint8_t *startBuf, int32_t startOffse
     return bitsUsed;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t CheckPadBit(){
+int32_t MP3Decoder::CheckPadBit(){
     return (m_FrameHeader->paddingBit ? 1 : 0);
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t UnpackFrameHeader(uint8_t *buf){
+int32_t MP3Decoder::UnpackFrameHeader(uint8_t *buf){
    int32_t verIdx;
     /* validate pointers and sync word */
     if ((buf[0] & m_SYNCWORDH) != m_SYNCWORDH || (buf[1] & m_SYNCWORDL) != m_SYNCWORDL){return -1;}
@@ -805,7 +802,7 @@ int32_t UnpackFrameHeader(uint8_t *buf){
     }
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t UnpackSideInfo( uint8_t *buf) {
+int32_t MP3Decoder::UnpackSideInfo( uint8_t *buf) {
    int32_t gr, ch, bd, nBytes;
     BitStreamInfo_t bitStreamInfo, *bsi;
 
@@ -900,7 +897,7 @@ int32_t UnpackSideInfo( uint8_t *buf) {
  *                (make sure dequantizer follows same convention)
  *              Illegal Intensity Position = 7 (always) for MPEG1 scale factors
  **********************************************************************************************************************/
-void UnpackSFMPEG1(BitStreamInfo_t *bsi, SideInfoSub_t *sis,
+void MP3Decoder::UnpackSFMPEG1(BitStreamInfo_t *bsi, SideInfoSub_t *sis,
                    ScaleFactorInfoSub_t *sfis, int32_t *scfsi, int32_t gr, ScaleFactorInfoSub_t *sfisGr0){
    int32_t sfb;
    int32_t slen0, slen1;
@@ -983,7 +980,7 @@ void UnpackSFMPEG1(BitStreamInfo_t *bsi, SideInfoSub_t *sis,
  *
  * Notes:       Illegal Intensity Position = (2^slen) - 1 for MPEG2 scale factors
  **********************************************************************************************************************/
-void UnpackSFMPEG2(BitStreamInfo_t *bsi, SideInfoSub_t *sis,
+void MP3Decoder::UnpackSFMPEG2(BitStreamInfo_t *bsi, SideInfoSub_t *sis,
                    ScaleFactorInfoSub_t *sfis, int32_t gr, int32_t ch, int32_t modeExt, ScaleFactorJS_t *sfjs){
 
    int32_t i, sfb, sfcIdx, btIdx, nrIdx;// iipTest;
@@ -1135,7 +1132,7 @@ void UnpackSFMPEG2(BitStreamInfo_t *bsi, SideInfoSub_t *sis,
  *
  * Return:      length (in bytes) of scale factor data, -1 if null input pointers
  **********************************************************************************************************************/
-int32_t UnpackScaleFactors( uint8_t *buf, int32_t *bitOffset, int32_t bitsAvail, int32_t gr, int32_t ch){
+int32_t MP3Decoder::UnpackScaleFactors( uint8_t *buf, int32_t *bitOffset, int32_t bitsAvail, int32_t gr, int32_t ch){
    int32_t bitsUsed;
     uint8_t *startBuf;
     BitStreamInfo_t bitStreamInfo, *bsi;
@@ -1167,7 +1164,7 @@ int32_t UnpackScaleFactors( uint8_t *buf, int32_t *bitOffset, int32_t bitsAvail,
  ****************************************************************************************************************************************************/
 
 /*****************************************************************************************************************************************************
- * Function:    MP3FindSyncWord
+ * Function:    findSyncWord
  *
  * Description: locate the next byte-alinged sync word in the raw mp3 stream
  *
@@ -1179,7 +1176,7 @@ int32_t UnpackScaleFactors( uint8_t *buf, int32_t *bitOffset, int32_t bitsAvail,
  * Return:      offset to first sync word (bytes from start of buf)
  *              -1 if sync not found after searching nBytes
  ****************************************************************************************************************************************************/
-int32_t MP3FindSyncWord(uint8_t *buf, int32_t nBytes) {
+int32_t MP3Decoder::findSyncWord(uint8_t *buf, int32_t nBytes) {
 
     // Auxiliary function for extracting bits, byte 'value', 'start_bit' is that bit from the left (0-7), 'num_bits' is the number of bits
     // auto extract_bits = [&](uint8_t byte, uint8_t start_bit, uint8_t num_bits) {
@@ -1483,7 +1480,7 @@ int32_t MP3FindSyncWord(uint8_t *buf, int32_t nBytes) {
  *                this function once (first frame) then store the result (nSlots)
  *                and just use it from then on
  ****************************************************************************************************************************************************/
-int32_t MP3FindFreeSync(uint8_t *buf, uint8_t firstFH[4], int32_t nBytes){
+int32_t MP3Decoder::MP3FindFreeSync(uint8_t *buf, uint8_t firstFH[4], int32_t nBytes){
    int32_t offset = 0;
     uint8_t *bufPtr = buf;
 
@@ -1493,7 +1490,7 @@ int32_t MP3FindFreeSync(uint8_t *buf, uint8_t firstFH[4], int32_t nBytes){
      *      in next header must match current header)
      */
     while (1) {
-        offset = MP3FindSyncWord(bufPtr, nBytes);
+        offset = findSyncWord(bufPtr, nBytes);
         bufPtr += offset;
         if (offset < 0) {
             return -1;
@@ -1523,9 +1520,9 @@ int32_t MP3FindFreeSync(uint8_t *buf, uint8_t firstFH[4], int32_t nBytes){
  *
  * Return:      none
  *
- * Notes:       call this right after calling MP3Decode
+ * Notes:       call this right after calling decode
  **********************************************************************************************************************/
-void MP3GetLastFrameInfo() {
+void MP3Decoder::MP3GetLastFrameInfo() {
     if (m_MP3DecInfo->layer != 3){
         m_MP3FrameInfo->bitrate=0;
         m_MP3FrameInfo->nChans=0;
@@ -1545,18 +1542,18 @@ void MP3GetLastFrameInfo() {
         m_MP3FrameInfo->version=m_MPEGVersion;
     }
 }
-int32_t MP3GetSampRate(){return m_MP3FrameInfo->samprate;}
-int32_t MP3GetChannels(){return m_MP3FrameInfo->nChans;}
-int32_t MP3GetBitsPerSample(){return m_MP3FrameInfo->bitsPerSample;}
-int32_t MP3GetBitrate(){return m_MP3FrameInfo->bitrate;}
-int32_t MP3GetOutputSamps(){return m_MP3FrameInfo->outputSamps;}
+int32_t MP3Decoder::getSampRate(){return m_MP3FrameInfo->samprate;}
+int32_t MP3Decoder::getChannels(){return m_MP3FrameInfo->nChans;}
+int32_t MP3Decoder::getBitsPerSample(){return m_MP3FrameInfo->bitsPerSample;}
+int32_t MP3Decoder::getBitRate(){return m_MP3FrameInfo->bitrate;}
+int32_t MP3Decoder::getOutputSamps(){return m_MP3FrameInfo->outputSamps;}
 
-const char* MP3GetLayer(){
+const char* MP3Decoder::getLayer(){
     const char* layer_str = layer_table[m_MP3FrameInfo->layer];  // 0: Reserviert, 1: Layer III, 2: Layer II, 3: Layer I
     return layer_str;
 }
 
-const char* MP3GetMPEGVersion(){
+const char* MP3Decoder::getMPEGVersion(){
     const char* mpeg_version_str = mpeg_version_table[m_MP3FrameInfo->version]; // 0: MPEG-2.5, 1: Reserviert, 2: MPEG-2 (ISO/IEC 13818-3), 3: MPEG-1 (ISO/IEC 11172-3)
     return mpeg_version_str;
 }
@@ -1566,13 +1563,13 @@ const char* MP3GetMPEGVersion(){
  * Description: parse MP3 frame header
  *
  * Inputs:        pointer to buffer containing valid MP3 frame header (located using
- *                MP3FindSyncWord(), above)
+ *                findSyncWord(), above)
  *
  * Outputs:     filled-in MP3FrameInfo struct
  *
  * Return:      error code, defined in mp3dec.h (0 means no error, < 0 means error)
  **********************************************************************************************************************/
-int32_t MP3GetNextFrameInfo(uint8_t *buf) {
+int32_t MP3Decoder::MP3GetNextFrameInfo(uint8_t *buf) {
 
     if (UnpackFrameHeader( buf) == -1 || m_MP3DecInfo->layer != 3){
         MP3_LOG_ERROR("MP3 invalid frameheader");
@@ -1594,13 +1591,13 @@ int32_t MP3GetNextFrameInfo(uint8_t *buf) {
  *
  * Return:      none
  **********************************************************************************************************************/
-void MP3ClearBadFrame(int16_t *outbuf) {
+void MP3Decoder::MP3ClearBadFrame(int16_t *outbuf) {
    int32_t i;
     for (i = 0; i < m_MP3DecInfo->nGrans * m_MP3DecInfo->nGranSamps * m_MP3DecInfo->nChans; i++)
         outbuf[i] = 0;
 }
 /***********************************************************************************************************************
- * Function:    MP3Decode
+ * Function:    decode
  *
  * Description: decode one frame of MP3 data
  *
@@ -1618,16 +1615,15 @@ void MP3ClearBadFrame(int16_t *outbuf) {
  * Notes:       switching useSize on and off between frames in the same stream
  *                is not supported (bit reservoir is not maintained if useSize on)
  **********************************************************************************************************************/
-int32_t MP3Decode( uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){
+int32_t MP3Decoder::decode( uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){
 
-    // int pos = MP3FindSyncWord(inbuf, *bytesLeft);
+    // int pos = findSyncWord(inbuf, *bytesLeft);
     // if(pos > 0){*bytesLeft -= pos; MP3_INFO("skip %i bytes", pos); return MP3_NONE; }
     // if(pos < 0){MP3_INFO("skip %i max bytes", *bytesLeft);  *bytesLeft = 0; return MP3_NONE; }
 
     int32_t offset, bitOffset, mainBits, gr, ch, fhBytes, siBytes, freeFrameBytes;
     int32_t prevBitOffset, sfBlockBits, huffBlockBits;
     uint8_t *mainPtr;
-    static uint8_t underflowCounter = 0; // http://macslons-irish-pub-radio.stream.laut.fm/macslons-irish-pub-radio
 
     /* unpack frame header */
     fhBytes = UnpackFrameHeader(inbuf);
@@ -1695,7 +1691,7 @@ int32_t MP3Decode( uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){
         /* fill main data buffer with enough new data for this frame */
         if (m_MP3DecInfo->mainDataBytes >= m_MP3DecInfo->mainDataBegin) {
             /* adequate "old" main data available (i.e. bit reservoir) */
-            underflowCounter = 0;
+            m_underflowCounter = 0;
             memmove(m_MP3DecInfo->mainBuf,
                     m_MP3DecInfo->mainBuf + m_MP3DecInfo->mainDataBytes - m_MP3DecInfo->mainDataBegin,
                     m_MP3DecInfo->mainDataBegin);
@@ -1708,12 +1704,12 @@ int32_t MP3Decode( uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){
             mainPtr = m_MP3DecInfo->mainBuf;
         } else {
             /* not enough data in bit reservoir from previous frames (perhaps starting in middle of file) */
-            underflowCounter ++;
+            m_underflowCounter ++;
             memcpy(m_MP3DecInfo->mainBuf + m_MP3DecInfo->mainDataBytes, inbuf, m_MP3DecInfo->nSlots);
             m_MP3DecInfo->mainDataBytes += m_MP3DecInfo->nSlots;
             inbuf += m_MP3DecInfo->nSlots;
             *bytesLeft -= (m_MP3DecInfo->nSlots);
-            if(underflowCounter < 4){
+            if(m_underflowCounter < 4){
                 return MP3_NONE;
             }
             MP3ClearBadFrame( outbuf);
@@ -1781,7 +1777,7 @@ int32_t MP3Decode( uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){
 }
 
 /***********************************************************************************************************************
- * Function:    MP3Decoder_ClearBuffer
+ * Function:    clearBuffers
  *
  * Description: clear all the memory needed for the MP3 decoder
  *
@@ -1792,7 +1788,7 @@ int32_t MP3Decode( uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf){
  * Return:      none
  *
  **********************************************************************************************************************/
-void MP3Decoder_ClearBuffer(void) {
+void MP3Decoder::clearBuffers(void) {
 
     /* important to do this - DSP primitives assume a bunch of state variables are 0 on first use */
     memset( m_MP3DecInfo,         0, sizeof(MP3DecInfo_t));                                    //Clear MP3DecInfo
@@ -1813,7 +1809,7 @@ void MP3Decoder_ClearBuffer(void) {
 
 }
 /***********************************************************************************************************************
- * Function:    MP3Decoder_AllocateBuffers
+ * Function:    allocateBuffers
  *
  * Description: allocate all the memory needed for the MP3 decoder
  *
@@ -1839,7 +1835,7 @@ void MP3Decoder_ClearBuffer(void) {
         heap_caps_malloc_prefer(size, 2, MALLOC_CAP_DEFAULT|MALLOC_CAP_INTERNAL, MALLOC_CAP_DEFAULT|MALLOC_CAP_SPIRAM)
 #endif
 
-bool MP3Decoder_AllocateBuffers(void) {
+bool MP3Decoder::allocateBuffers(void) {
     if(!m_MP3DecInfo)       {m_MP3DecInfo    = (MP3DecInfo_t*)    __malloc_heap_psram(sizeof(MP3DecInfo_t)   );}
     if(!m_FrameHeader)      {m_FrameHeader   = (FrameHeader_t*)   __malloc_heap_psram(sizeof(FrameHeader_t)  );}
     if(!m_SideInfo)         {m_SideInfo      = (SideInfo_t*)      __malloc_heap_psram(sizeof(SideInfo_t)     );}
@@ -1852,15 +1848,15 @@ bool MP3Decoder_AllocateBuffers(void) {
 
     if(!m_MP3DecInfo || !m_FrameHeader || !m_SideInfo || !m_ScaleFactorJS || !m_HuffmanInfo ||
        !m_DequantInfo || !m_IMDCTInfo || !m_SubbandInfo || !m_MP3FrameInfo) {
-        MP3Decoder_FreeBuffers();
+        freeBuffers();
         MP3_LOG_ERROR("not enough memory to allocate mp3decoder buffers");
         return false;
     }
-    MP3Decoder_ClearBuffer();
+    clearBuffers();
     return true;
 }
 /***********************************************************************************************************************
- * Function:    MP3Decoder_IsInit
+ * Function:    isInit
  *
  * Description: returns MP3 decoder initialization status
  *
@@ -1871,7 +1867,7 @@ bool MP3Decoder_AllocateBuffers(void) {
  * Return:      true if buffers allocated, otherwise false
 
  **********************************************************************************************************************/
-bool MP3Decoder_IsInit(void) {
+bool MP3Decoder::isInit(void) {
     if(!m_MP3DecInfo || !m_FrameHeader || !m_SideInfo || !m_ScaleFactorJS || !m_HuffmanInfo ||
        !m_DequantInfo || !m_IMDCTInfo || !m_SubbandInfo || !m_MP3FrameInfo) {
         return false;
@@ -1879,7 +1875,7 @@ bool MP3Decoder_IsInit(void) {
     return true;
 }
 /***********************************************************************************************************************
- * Function:    MP3Decoder_FreeBuffers
+ * Function:    freeBuffers
  *
  * Description: frees all the memory used by the MP3 decoder
  *
@@ -1891,7 +1887,7 @@ bool MP3Decoder_IsInit(void) {
  *
  * Notes:       safe to call even if some buffers were not allocated
  **********************************************************************************************************************/
-void MP3Decoder_FreeBuffers()
+void MP3Decoder::freeBuffers()
 {
 //    uint32_t i = ESP.getFreeHeap();
 
@@ -1934,7 +1930,7 @@ void MP3Decoder_FreeBuffers()
  **********************************************************************************************************************/
 // no improvement with section=data
 
-int32_t DecodeHuffmanPairs(int32_t *xy, int32_t nVals, int32_t tabIdx, int32_t bitsLeft, uint8_t *buf, int32_t bitOffset){
+int32_t MP3Decoder::DecodeHuffmanPairs(int32_t *xy, int32_t nVals, int32_t tabIdx, int32_t bitsLeft, uint8_t *buf, int32_t bitOffset){
    int32_t i, x, y;
    int32_t cachedBits, padBits, len, startBits, linBits, maxBits, minBits;
     HuffTabType_t tabType;
@@ -2177,7 +2173,7 @@ int32_t DecodeHuffmanPairs(int32_t *xy, int32_t nVals, int32_t tabIdx, int32_t b
  * Notes:        si_huff.bit tests every vwxy output in both quad tables
  **********************************************************************************************************************/
 // no improvement with section=data
-int32_t DecodeHuffmanQuads(int32_t *vwxy, int32_t nVals, int32_t tabIdx, int32_t bitsLeft, uint8_t *buf, int32_t bitOffset){
+int32_t MP3Decoder::DecodeHuffmanQuads(int32_t *vwxy, int32_t nVals, int32_t tabIdx, int32_t bitsLeft, uint8_t *buf, int32_t bitOffset){
    int32_t i, v, w, x, y;
    int32_t len, maxBits, cachedBits, padBits;
     uint32_t cache;
@@ -2289,7 +2285,7 @@ int32_t DecodeHuffmanQuads(int32_t *vwxy, int32_t nVals, int32_t tabIdx, int32_t
  *                out of bits prematurely (invalid bitstream)
  **********************************************************************************************************************/
 // .data about 1ms faster per frame
-int32_t DecodeHuffman(uint8_t *buf, int32_t *bitOffset, int32_t huffBlockBits, int32_t gr, int32_t ch){
+int32_t MP3Decoder::DecodeHuffman(uint8_t *buf, int32_t *bitOffset, int32_t huffBlockBits, int32_t gr, int32_t ch){
 
    int32_t r1Start, r2Start, rEnd[4]; /* region boundaries */
    int32_t i, w, bitsUsed, bitsLeft;
@@ -2391,7 +2387,7 @@ int32_t DecodeHuffman(uint8_t *buf, int32_t *bitOffset, int32_t huffBlockBits, i
  *              Equivalently, we can think of the dequantized coefficients as
  *                Q(DQ_FRACBITS_OUT - 15) with no implicit bias.
  **********************************************************************************************************************/
-int32_t MP3Dequantize(int32_t gr){
+int32_t MP3Decoder::MP3Dequantize(int32_t gr){
    int32_t i, ch, nSamps, mOut[2];
     CriticalBandInfo_t *cbi;
     cbi = &m_CriticalBandInfo[0];
@@ -2479,7 +2475,7 @@ int32_t MP3Dequantize(int32_t gr){
  *
  * Return:      bitwise-OR of the unsigned outputs (for guard bit calculations)
  **********************************************************************************************************************/
-int32_t DequantBlock(int32_t *inbuf, int32_t *outbuf, int32_t num, int32_t scale){
+int32_t MP3Decoder::DequantBlock(int32_t *inbuf, int32_t *outbuf, int32_t num, int32_t scale){
    int32_t tab4[4];
    int32_t scalef, scalei, shift;
    int32_t sx, x, y;
@@ -2582,7 +2578,7 @@ int32_t DequantBlock(int32_t *inbuf, int32_t *outbuf, int32_t num, int32_t scale
  *
  * Notes:       dequantized samples in Q(DQ_FRACBITS_OUT) format
  **********************************************************************************************************************/
-int32_t DequantChannel(int32_t *sampleBuf, int32_t *workBuf, int32_t *nonZeroBound,  SideInfoSub_t *sis, ScaleFactorInfoSub_t *sfis,
+int32_t MP3Decoder::DequantChannel(int32_t *sampleBuf, int32_t *workBuf, int32_t *nonZeroBound,  SideInfoSub_t *sis, ScaleFactorInfoSub_t *sfis,
                                                                                               CriticalBandInfo_t *cbi)
 {
    int32_t i, j, w, cb;
@@ -2736,7 +2732,7 @@ int32_t DequantChannel(int32_t *sampleBuf, int32_t *workBuf, int32_t *nonZeroBou
  *
  * Notes:       assume at least 1 GB in input
  **********************************************************************************************************************/
-void MidSideProc(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps, int32_t mOut[2]){
+void MP3Decoder::MidSideProc(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps, int32_t mOut[2]){
    int32_t i, xr, xl, mOutL, mOutR;
 
     /* L = (M+S)/sqrt(2), R = (M-S)/sqrt(2)
@@ -2775,7 +2771,7 @@ void MidSideProc(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps, int32_t mO
  * Notes:       assume at least 1 GB in input
  *
  **********************************************************************************************************************/
-void IntensityProcMPEG1(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,  ScaleFactorInfoSub_t *sfis,
+void MP3Decoder::IntensityProcMPEG1(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,  ScaleFactorInfoSub_t *sfis,
                                                     CriticalBandInfo_t *cbi, int32_t midSideFlag, int32_t mixFlag, int32_t mOut[2])
 {
    int32_t i = 0, j = 0, n = 0, cb = 0, w = 0;
@@ -2889,7 +2885,7 @@ void IntensityProcMPEG1(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,  Sc
  * Notes:       assume at least 1 GB in input
  *
  **********************************************************************************************************************/
-void IntensityProcMPEG2(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,
+void MP3Decoder::IntensityProcMPEG2(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,
          ScaleFactorInfoSub_t *sfis, CriticalBandInfo_t *cbi,
         ScaleFactorJS_t *sfjs, int32_t midSideFlag, int32_t mixFlag, int32_t mOut[2]) {
    int32_t i, j, k, n, r, cb, w;
@@ -3013,7 +3009,7 @@ void IntensityProcMPEG2(int32_t x[m_MAX_NCHAN][m_MAX_NSAMP], int32_t nSamps,
  **********************************************************************************************************************/
 // a little bit faster in RAM (< 1 ms per block)
 /* __attribute__ ((section (".data"))) */
-void AntiAlias(int32_t *x, int32_t nBfly){
+void MP3Decoder::AntiAlias(int32_t *x, int32_t nBfly){
    int32_t k, a0, b0, c0, c1;
     const uint32_t *c;
 
@@ -3112,7 +3108,7 @@ void AntiAlias(int32_t *x, int32_t nBfly){
  *                sign bit, short blocks can have one addition but max gain < 1.0)
  **********************************************************************************************************************/
 
-void WinPrevious(int32_t *xPrev, int32_t *xPrevWin, int32_t btPrev){
+void MP3Decoder::WinPrevious(int32_t *xPrev, int32_t *xPrevWin, int32_t btPrev){
    int32_t i, x, *xp, *xpwLo, *xpwHi, wLo, wHi;
     const uint32_t *wpLo, *wpHi;
 
@@ -3174,7 +3170,7 @@ void WinPrevious(int32_t *xPrev, int32_t *xPrevWin, int32_t btPrev){
  * Return:      updated mOut (from new outputs y)
  **********************************************************************************************************************/
 
-int32_t FreqInvertRescale(int32_t *y, int32_t *xPrev, int32_t blockIdx, int32_t es) {
+int32_t MP3Decoder::FreqInvertRescale(int32_t *y, int32_t *xPrev, int32_t blockIdx, int32_t es) {
 
 	if (es == 0) {
 		/* fast case - frequency invert only (no rescaling) */
@@ -3210,7 +3206,7 @@ int32_t FreqInvertRescale(int32_t *y, int32_t *xPrev, int32_t blockIdx, int32_t
 
 
 /* require at least 3 guard bits in x[] to ensure no overflow */
-void idct9(int32_t *x) {
+void MP3Decoder::idct9(int32_t *x) {
    int32_t a1, a2, a3, a4, a5, a6, a7, a8, a9;
    int32_t a10, a11, a12, a13, a14, a15, a16, a17, a18;
    int32_t a19, a20, a21, a22, a23, a24, a25, a26, a27;
@@ -3322,7 +3318,7 @@ void idct9(int32_t *x) {
  **********************************************************************************************************************/
 // barely faster in RAM
 
-int32_t IMDCT36(int32_t *xCurr, int32_t *xPrev, int32_t *y, int32_t btCurr, int32_t btPrev, int32_t blockIdx, int32_t gb){
+int32_t MP3Decoder::IMDCT36(int32_t *xCurr, int32_t *xPrev, int32_t *y, int32_t btCurr, int32_t btPrev, int32_t blockIdx, int32_t gb){
    int32_t i, es, xBuf[18], xPrevWin[18];
    int32_t acc1, acc2, s, d, t, mOut;
    int32_t xo, xe, c, *xp, yLo, yHi;
@@ -3425,7 +3421,7 @@ int32_t IMDCT36(int32_t *xCurr, int32_t *xPrev, int32_t *y, int32_t btCurr, int3
 /* 12-point inverse DCT, used in IMDCT12x3()
  * 4 input guard bits will ensure no overflow
  */
-void imdct12(int32_t *x, int32_t *out) {
+void MP3Decoder::imdct12(int32_t *x, int32_t *out) {
    int32_t a0, a1, a2;
    int32_t x0, x1, x2, x3, x4, x5;
 
@@ -3502,7 +3498,7 @@ void imdct12(int32_t *x, int32_t *out) {
  * Return:      mOut (OR of abs(y) for all y calculated here)
  **********************************************************************************************************************/
 // barely faster in RAM
-int32_t IMDCT12x3(int32_t *xCurr, int32_t *xPrev, int32_t *y, int32_t btPrev, int32_t blockIdx, int32_t gb){
+int32_t MP3Decoder::IMDCT12x3(int32_t *xCurr, int32_t *xPrev, int32_t *y, int32_t btPrev, int32_t blockIdx, int32_t gb){
    int32_t i, es, mOut, yLo, xBuf[18], xPrevWin[18]; /* need temp buffer for reordering short blocks */
     const uint32_t *wp;
     es = 0;
@@ -3590,7 +3586,7 @@ int32_t IMDCT12x3(int32_t *xCurr, int32_t *xPrev, int32_t *y, int32_t btPrev, in
  * Return:      number of non-zero IMDCT blocks calculated in this call
  *                (including overlap-add)
  **********************************************************************************************************************/
-int32_t HybridTransform(int32_t *xCurr, int32_t *xPrev, int32_t y[m_BLOCK_SIZE][m_NBANDS], SideInfoSub_t *sis, BlockCount_t *bc){
+int32_t MP3Decoder::HybridTransform(int32_t *xCurr, int32_t *xPrev, int32_t y[m_BLOCK_SIZE][m_NBANDS], SideInfoSub_t *sis, BlockCount_t *bc){
    int32_t xPrevWin[18], currWinIdx, prevWinIdx;
    int32_t i, j, nBlocksOut, nonZero, mOut;
    int32_t fiBit, xp;
@@ -3691,7 +3687,7 @@ int32_t HybridTransform(int32_t *xCurr, int32_t *xPrev, int32_t y[m_BLOCK_SIZE][
  **********************************************************************************************************************/
 // a bit faster in RAM
 /*__attribute__ ((section (".data")))*/
-int32_t IMDCT(int32_t gr, int32_t ch) {
+int32_t MP3Decoder::IMDCT(int32_t gr, int32_t ch) {
    int32_t nBfly, blockCutoff;
     BlockCount_t bc;
 
@@ -3762,7 +3758,7 @@ int32_t IMDCT(int32_t gr, int32_t ch) {
  *
  * Return:      0 on success,  -1 if null input pointers
  **********************************************************************************************************************/
-int32_t Subband(int16_t *pcmBuf) {
+int32_t MP3Decoder::Subband(int16_t *pcmBuf) {
    int32_t b;
     if (m_MP3DecInfo->nChans == 2) {
         /* stereo */
@@ -3830,7 +3826,7 @@ int32_t Subband(int16_t *pcmBuf) {
 
 static const uint8_t FDCT32s1s2[16] = {5,3,3,2,2,1,1,1, 1,1,1,1,1,2,2,4};
 
-void FDCT32(int32_t *buf, int32_t *dest, int32_t offset, int32_t oddBlock, int32_t gb) {
+void MP3Decoder::FDCT32(int32_t *buf, int32_t *dest, int32_t offset, int32_t oddBlock, int32_t gb) {
     int32_t i, s, tmp, es;
     const int32_t *cptr = (const int32_t*)m_dcttab;
     int32_t a0, a1, a2, a3, a4, a5, a6, a7;
@@ -3966,7 +3962,7 @@ void FDCT32(int32_t *buf, int32_t *dest, int32_t offset, int32_t oddBlock, int32
  * P O L Y P H A S E
  **********************************************************************************************************************/
 inline
-short ClipToShort(int32_t x, int32_t fracBits){
+short MP3Decoder::ClipToShort(int32_t x, int32_t fracBits){
 
     /* assumes you've already rounded (x += (1 << (fracBits-1))) */
     x >>= fracBits;
@@ -4001,7 +3997,7 @@ short ClipToShort(int32_t x, int32_t fracBits){
  *
  * Return:      none
  **********************************************************************************************************************/
-void PolyphaseMono(int16_t *pcm, int32_t *vbuf, const uint32_t *coefBase){
+void MP3Decoder::PolyphaseMono(int16_t *pcm, int32_t *vbuf, const uint32_t *coefBase){
    int32_t i;
     const uint32_t *coef;
    int32_t *vb1;
@@ -4066,7 +4062,7 @@ void PolyphaseMono(int16_t *pcm, int32_t *vbuf, const uint32_t *coefBase){
  *
  * Notes:       interleaves PCM samples LRLRLR...
  **********************************************************************************************************************/
-void PolyphaseStereo(int16_t *pcm, int32_t *vbuf, const uint32_t *coefBase){
+void MP3Decoder::PolyphaseStereo(int16_t *pcm, int32_t *vbuf, const uint32_t *coefBase){
    int32_t i;
     const uint32_t *coef;
    int32_t *vb1;
@@ -4142,7 +4138,7 @@ void PolyphaseStereo(int16_t *pcm, int32_t *vbuf, const uint32_t *coefBase){
  * Return:      main_data_begin
  *
  **********************************************************************************************************************/
-int MP3_AnalyzeFrame(const uint8_t *frame_data, size_t frame_len) {
+int MP3Decoder::MP3_AnalyzeFrame(const uint8_t *frame_data, size_t frame_len) {
     if (frame_len < 4) {
         MP3_LOG_ERROR("Error: Frame data too short for header (need 4 bytes, got %zu).\n", frame_len);
         return -3; // Frame too short for header
@@ -33,10 +33,6 @@
 #include "celt.h"
 #include "opus_decoder.h"
 
-celt_raw_ptr<CELTDecoder_t> s_celtDec; // unique pointer
-band_ctx_t     s_band_ctx;
-ec_ctx_t      *s_ec_ptr;
-ec_ctx_t       s_ec;
 
 const uint32_t CELT_GET_AND_CLEAR_ERROR_REQUEST = 10007;
 const uint32_t CELT_SET_CHANNELS_REQUEST        = 10008;
@@ -656,27 +652,52 @@ uint32_t celt_pvq_u_row(uint32_t row, uint32_t data){
 
 
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-bool CELTDecoder_AllocateBuffers(void) {
+// Largest amount of temporary arrays in use at the same time while decoding a frame (stereo, 20ms):
+// the arrays of celt_decode_with_ec() plus the largest of clt_compute_allocation(), quant_all_bands() and
+// celt_synthesis()/deemphasis(). Each array is rounded up to 8 bytes, as ps_scratch does.
+static size_t celt_scratch_size() {
+    auto a8 = [](size_t bytes) { return (bytes + 7) & ~(size_t)7; };
+    const size_t C = 2;
+    const size_t nbEBands = m_CELTMode.nbEBands;
+    const size_t M = 1 << m_CELTMode.maxLM;
+    const size_t N = M * m_CELTMode.shortMdctSize;
+    const size_t widestBand = M * (eband5ms[nbEBands] - eband5ms[nbEBands - 1]);
+
+    size_t frame = 6 * a8(nbEBands * sizeof(int32_t))   // tf_res, cap, offsets, fine_quant, pulses, fine_priority
+                 + a8(C * nbEBands)                      // collapse_masks
+                 + a8(C * N * sizeof(int16_t));          // X
+    size_t alloc = 4 * a8(nbEBands * sizeof(int32_t));  // bits1, bits2, thresh, trim_offset
+    size_t bands = a8(C * M * eband5ms[nbEBands - 1] * sizeof(int16_t)) // norm
+                 + 6 * a8(ALLOC_NONE * sizeof(int16_t))                  // lowband_scratch, X_save ... norm_save2
+                 + max(a8(widestBand * sizeof(int16_t)), a8((widestBand + 3) * sizeof(int32_t))); // (de)interleave_hadamard, alg_unquant
+    size_t synth = a8(N * sizeof(int32_t));             // freq, then the scratch of deemphasis()
+    return frame + max(max(alloc, bands), synth);
+}
+//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+bool CeltDecoder::allocateBuffers(void) {
     size_t omd = celt_decoder_get_size(2);
-    s_celtDec.alloc(omd, "CELTDecoder");
-    if (s_celtDec.valid()) {
-        // OPUS_LOG_INFO("Allocated %zu bytes", s_celtDec.size());
-        s_celtDec.clear();  // mem zero
-        return true;
+    m_celtDec.alloc(omd, "CELTDecoder");
+    if (m_celtDec.valid()) {
+        // OPUS_LOG_INFO("Allocated %zu bytes", m_celtDec.size());
+        m_celtDec.clear();  // mem zero
+        m_celtScratch.alloc(celt_scratch_size(), "CELTScratch");
+        if (m_celtScratch.size()) return true;
+        omd = celt_scratch_size();
     }
     OPUS_LOG_ERROR("oom for %i bytes", omd);
     return false;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void CELTDecoder_ClearBuffer(void){
-    s_celtDec.clear();  // mem zero
+void CeltDecoder::clearBuffers(void){
+    m_celtDec.clear();  // mem zero
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void CELTDecoder_FreeBuffers(){
-    s_celtDec.reset();
+void CeltDecoder::freeBuffers(){
+    m_celtDec.reset();
+    m_celtScratch.reset();
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void exp_rotation1(int16_t *X, int32_t len, int32_t stride, int16_t c, int16_t s) {
+void CeltDecoder::exp_rotation1(int16_t *X, int32_t len, int32_t stride, int16_t c, int16_t s) {
     int32_t i;
     int16_t ms;
     int16_t *Xptr;
@@ -699,7 +720,7 @@ void exp_rotation1(int16_t *X, int32_t len, int32_t stride, int16_t c, int16_t s
     }
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void exp_rotation(int16_t *X, int32_t len, int32_t dir, int32_t stride, int32_t K, int32_t spread) {
+void CeltDecoder::exp_rotation(int16_t *X, int32_t len, int32_t dir, int32_t stride, int32_t K, int32_t spread) {
     const int32_t SPREAD_FACTOR[3] = {15, 10, 5};
     int32_t i;
     int16_t c, s;
@@ -737,7 +758,7 @@ void exp_rotation(int16_t *X, int32_t len, int32_t dir, int32_t stride, int32_t
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 /** Takes the pitch vector and the decoded residual vector, computes the gain that will give ||p+g*y||=1 and mixes the residual with the pitch. */
-void normalise_residual(int32_t * iy, int16_t * X, int32_t N, int32_t Ryy, int16_t gain) {
+void CeltDecoder::normalise_residual(int32_t * iy, int16_t * X, int32_t N, int32_t Ryy, int16_t gain) {
     int32_t i;
     int32_t k;
     int32_t t;
@@ -752,7 +773,7 @@ void normalise_residual(int32_t * iy, int16_t * X, int32_t N, int32_t Ryy, int16
     while (++i < N);
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-uint32_t extract_collapse_mask(int32_t *iy, int32_t N, int32_t B) {
+uint32_t CeltDecoder::extract_collapse_mask(int32_t *iy, int32_t N, int32_t B) {
     uint32_t collapse_mask;
     int32_t N0;
     int32_t i;
@@ -774,13 +795,13 @@ uint32_t extract_collapse_mask(int32_t *iy, int32_t N, int32_t B) {
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 /** Decode pulse vector and combine the result with the pitch vector to produce the final normalised signal in the current band. */
-uint32_t alg_unquant(int16_t *X, int32_t N, int32_t K, int32_t spread, int32_t B, int16_t gain) {
+uint32_t CeltDecoder::alg_unquant(int16_t *X, int32_t N, int32_t K, int32_t spread, int32_t B, int16_t gain) {
     int32_t Ryy;
     uint32_t collapse_mask;
 
     assert2(K > 0, "alg_unquant() needs at least one pulse");
     assert2(N > 1, "alg_unquant() needs at least two dimensions");
-    auto iy = celt_malloc_arr<int32_t>((N + 3) * sizeof(int32_t));
+    auto iy = celt_scratch_arr<int32_t>(N + 3);
 
     Ryy = decode_pulses(iy.get(), N, K);
     normalise_residual(iy.get(), X, N, Ryy, gain);
@@ -789,7 +810,7 @@ uint32_t alg_unquant(int16_t *X, int32_t N, int32_t K, int32_t spread, int32_t B
     return collapse_mask;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void renormalise_vector(int16_t *X, int32_t N, int16_t gain) {
+void CeltDecoder::renormalise_vector(int16_t *X, int32_t N, int16_t gain) {
     int32_t i;
     int32_t k;
     int32_t E;
@@ -809,7 +830,7 @@ void renormalise_vector(int16_t *X, int32_t N, int16_t gain) {
     /*return celt_sqrt(E);*/
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-int32_t resampling_factor(int32_t rate){
+int32_t CeltDecoder::resampling_factor(int32_t rate){
     int32_t ret;
     switch (rate){
         case 48000: ret = 1;  break;
@@ -822,7 +843,7 @@ int32_t resampling_factor(int32_t rate){
     return ret;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void comb_filter_const_c(int32_t *y, int32_t *x, int32_t T, int32_t N, int16_t g10, int16_t g11, int16_t g12) {
+void CeltDecoder::comb_filter_const_c(int32_t *y, int32_t *x, int32_t T, int32_t N, int16_t g10, int16_t g11, int16_t g12) {
     int32_t x0, x1, x2, x3, x4;
     int32_t i;
     x4 = x[-T - 2];
@@ -840,7 +861,7 @@ void comb_filter_const_c(int32_t *y, int32_t *x, int32_t T, int32_t N, int16_t g
     }
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void comb_filter(int32_t *y, int32_t *x, int32_t T0, int32_t T1, int32_t N, int16_t g0, int16_t g1, int32_t tapset0, int32_t tapset1){
+void CeltDecoder::comb_filter(int32_t *y, int32_t *x, int32_t T0, int32_t T1, int32_t N, int16_t g0, int16_t g1, int32_t tapset0, int32_t tapset1){
     int32_t i;
     /* printf ("%d %d %f %f\n", T0, T1, g0, g1); */
     uint8_t  overlap = m_CELTMode.overlap; // =120
@@ -903,7 +924,7 @@ const signed char tf_select_table[4][8] = {
     {0, -2, 0, -3, 3, 0, 1, -1},  /* 20 ms */
 };
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void init_caps(int32_t *cap, int32_t LM, int32_t C) {
+void CeltDecoder::init_caps(int32_t *cap, int32_t LM, int32_t C) {
     int32_t i;
     for (i = 0; i < m_CELTMode.nbEBands; i++)
     {
@@ -913,12 +934,12 @@ void init_caps(int32_t *cap, int32_t LM, int32_t C) {
     }
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-uint32_t celt_lcg_rand(uint32_t seed) {
+uint32_t CeltDecoder::celt_lcg_rand(uint32_t seed) {
     return 1664525 * seed + 1013904223;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 /* This is a cos() approximation designed to be bit-exact on any platform. Bit exactness with this approximation is important because it has an impact on the bit allocation */
-int16_t bitexact_cos(int16_t x) {
+int16_t CeltDecoder::bitexact_cos(int16_t x) {
     int32_t tmp;
     int16_t x2;
     tmp = (4096 + ((int32_t)(x) * (x))) >> 13;
@@ -929,7 +950,7 @@ int16_t bitexact_cos(int16_t x) {
     return 1 + x2;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-int32_t bitexact_log2tan(int32_t isin, int32_t icos) {
+int32_t CeltDecoder::bitexact_log2tan(int32_t isin, int32_t icos) {
     int32_t lc;
     int32_t ls;
     lc = EC_ILOG(icos);
@@ -940,7 +961,7 @@ int32_t bitexact_log2tan(int32_t isin, int32_t icos) {
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 /* De-normalise the energy to produce the synthesis from the unit-energy bands */
-void denormalise_bands(const int16_t * X, int32_t * freq,
+void CeltDecoder::denormalise_bands(const int16_t * X, int32_t * freq,
                        const int16_t *bandLogE, int32_t start, int32_t end, int32_t M, int32_t downsample, int32_t silence) {
     int32_t i, N;
     int32_t bound;
@@ -1002,7 +1023,7 @@ void denormalise_bands(const int16_t * X, int32_t * freq,
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 /* This prevents energy collapse for transients with multiple short MDCTs */
-void anti_collapse(int16_t *X_, uint8_t *collapse_masks, int32_t LM, int32_t C, int32_t size, int32_t start,
+void CeltDecoder::anti_collapse(int16_t *X_, uint8_t *collapse_masks, int32_t LM, int32_t C, int32_t size, int32_t start,
                    int32_t end, const int16_t *logE, const int16_t *prev1logE, const int16_t *prev2logE, const int32_t *pulses,
                    uint32_t seed){
     int32_t c, i, j, k;
@@ -1079,7 +1100,7 @@ void anti_collapse(int16_t *X_, uint8_t *collapse_masks, int32_t LM, int32_t C,
 /* Compute the weights to use for optimizing normalized distortion across channels. We use the amplitude to weight   square distortion, which means that we use the square root of the value we would
    have been using if we wanted to minimize the MSE in the non-normalized domain. This roughly corresponds to some quick-and-dirty perceptual experiments I ran to measure inter-aural masking
    (there doesn't seem to be any published data on the topic). */
-void compute_channel_weights(int32_t Ex, int32_t Ey, int16_t w[2]) {
+void CeltDecoder::compute_channel_weights(int32_t Ex, int32_t Ey, int16_t w[2]) {
     int32_t minE;
     int32_t shift;
 
@@ -1094,7 +1115,7 @@ void compute_channel_weights(int32_t Ex, int32_t Ey, int16_t w[2]) {
     w[1] = VSHR32(Ey, shift);
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void stereo_split(int16_t * X, int16_t * Y, int32_t N) {
+void CeltDecoder::stereo_split(int16_t * X, int16_t * Y, int32_t N) {
     int32_t j;
     for (j = 0; j < N; j++) {
         int32_t r, l;
@@ -1105,7 +1126,7 @@ void stereo_split(int16_t * X, int16_t * Y, int32_t N) {
     }
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void stereo_merge(int16_t * X, int16_t * Y, int16_t mid, int32_t N){
+void CeltDecoder::stereo_merge(int16_t * X, int16_t * Y, int16_t mid, int32_t N){
     int32_t j;
     int32_t xp = 0, side = 0;
     int32_t El, Er;
@@ -1154,11 +1175,11 @@ void stereo_merge(int16_t * X, int16_t * Y, int16_t mid, int32_t N){
    The lines are for N=2, 4, 8, 16 */
 const int32_t ordery_table[] = { 1, 0, 3, 0, 2, 1, 7, 0, 4, 3, 6, 1, 5, 2, 15, 0, 8, 7, 12, 3, 11, 4, 14, 1, 9, 6, 13, 2, 10, 5,};
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void deinterleave_hadamard(int16_t *X, int32_t N0, int32_t stride, int32_t hadamard){
+void CeltDecoder::deinterleave_hadamard(int16_t *X, int32_t N0, int32_t stride, int32_t hadamard){
     int32_t i, j;
     int32_t N;
     N = N0 * stride;
-    auto tmp = celt_malloc_arr<int16_t>(N * sizeof(int16_t*));
+    auto tmp = celt_scratch_arr<int16_t>(N);
     assert(stride > 0);
     if (hadamard) {
         const int32_t *ordery = ordery_table + stride - 2;
@@ -1175,11 +1196,11 @@ void deinterleave_hadamard(int16_t *X, int32_t N0, int32_t stride, int32_t hadam
     memcpy(X, tmp.get(), N * sizeof(*X));
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void interleave_hadamard(int16_t *X, int32_t N0, int32_t stride, int32_t hadamard){
+void CeltDecoder::interleave_hadamard(int16_t *X, int32_t N0, int32_t stride, int32_t hadamard){
     int32_t i, j;
     int32_t N;
     N = N0 * stride;
-    auto tmp = celt_malloc_arr<int16_t>(N * sizeof(int16_t*));
+    auto tmp = celt_scratch_arr<int16_t>(N);
     if (hadamard) {
         const int32_t *ordery = ordery_table + stride - 2;
         for (i = 0; i < stride; i++)
@@ -1194,7 +1215,7 @@ void interleave_hadamard(int16_t *X, int32_t N0, int32_t stride, int32_t hadamar
     memcpy(X, tmp.get(), N * sizeof(*X));
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void haar1(int16_t *X, int32_t N0, int32_t stride) {
+void CeltDecoder::haar1(int16_t *X, int32_t N0, int32_t stride) {
     int32_t i, j;
     N0 >>= 1;
     for (i = 0; i < stride; i++)
@@ -1207,7 +1228,7 @@ void haar1(int16_t *X, int32_t N0, int32_t stride) {
         }
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-int32_t compute_qn(int32_t N, int32_t b, int32_t offset, int32_t pulse_cap, int32_t stereo) {
+int32_t CeltDecoder::compute_qn(int32_t N, int32_t b, int32_t offset, int32_t pulse_cap, int32_t stereo) {
     const int16_t exp2_table8[8] =
         {16384, 17866, 19483, 21247, 23170, 25267, 27554, 30048};
     int32_t qn, qb;
@@ -1233,7 +1254,7 @@ int32_t compute_qn(int32_t N, int32_t b, int32_t offset, int32_t pulse_cap, int3
     return qn;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void compute_theta(struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, int32_t *b, int32_t B,
+void CeltDecoder::compute_theta(struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, int32_t *b, int32_t B,
                           int32_t __B0, int32_t LM, int32_t stereo, int32_t *fill) {
     int32_t qn;
     int32_t itheta = 0;
@@ -1247,8 +1268,8 @@ void compute_theta(struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, in
     int32_t i;
     int32_t intensity;
 
-    i = s_band_ctx.i;
-    intensity = s_band_ctx.intensity;
+    i = m_band_ctx.i;
+    intensity = m_band_ctx.intensity;
 
     /* Decide on the resolution to give to the split parameter theta */
     pulse_cap = logN400[i] + LM * (1 << BITRES);
@@ -1308,13 +1329,13 @@ void compute_theta(struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, in
     }
     else if (stereo) {
 
-        if (*b > 2 << BITRES && s_band_ctx.remaining_bits > 2 << BITRES) {
+        if (*b > 2 << BITRES && m_band_ctx.remaining_bits > 2 << BITRES) {
             inv = ec_dec_bit_logp(2);
         }
         else
             inv = 0;
         /* inv flag override to avoid problems with downmixing. */
-        if (s_band_ctx.disable_inv)
+        if (m_band_ctx.disable_inv)
             inv = 0;
         itheta = 0;
     }
@@ -1349,7 +1370,7 @@ void compute_theta(struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, in
     sctx->qalloc = qalloc;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-uint32_t quant_band_n1(int16_t *X, int16_t *Y, int32_t b,  int16_t *lowband_out) {
+uint32_t CeltDecoder::quant_band_n1(int16_t *X, int16_t *Y, int32_t b,  int16_t *lowband_out) {
     int32_t c;
     int32_t stereo;
     int16_t *x = X;
@@ -1358,12 +1379,12 @@ uint32_t quant_band_n1(int16_t *X, int16_t *Y, int32_t b,  int16_t *lowband_out)
     c = 0;
     do {
         int32_t sign = 0;
-        if (s_band_ctx.remaining_bits >= 1 << BITRES) {
+        if (m_band_ctx.remaining_bits >= 1 << BITRES) {
             sign = ec_dec_bits(1);
-            s_band_ctx.remaining_bits -= 1 << BITRES;
+            m_band_ctx.remaining_bits -= 1 << BITRES;
             b -= 1 << BITRES;
         }
-        if (s_band_ctx.resynth)
+        if (m_band_ctx.resynth)
             x[0] = sign ? -NORM_SCALING : NORM_SCALING;
         x = Y;
     } while (++c < 1 + stereo);
@@ -1374,7 +1395,7 @@ uint32_t quant_band_n1(int16_t *X, int16_t *Y, int32_t b,  int16_t *lowband_out)
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 /* This function is responsible for encoding and decoding a mono partition. It can split the band in two and transmit  the energy difference with the two half-bands.
    It can be called recursively so bands can end up being split in 8 parts. */
-uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM,
+uint32_t CeltDecoder::quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM,
                                 int16_t gain, int32_t fill){
     const uint8_t *cache;
     int32_t q;
@@ -1387,8 +1408,8 @@ uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *l
     int32_t i;
     int32_t spread;
 
-    i = s_band_ctx.i;
-    spread = s_band_ctx.spread;
+    i = m_band_ctx.i;
+    spread = m_band_ctx.spread;
 
     /* If we need 1.5 more bit than we can produce, split the band in two. */
     cache = cache_bits50 + cache_index50[(LM + 1) * m_CELTMode.nbEBands + i];
@@ -1428,16 +1449,16 @@ uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *l
         }
         mbits = max((int32_t)0, min(b, (b - delta) / 2));
         sbits = b - mbits;
-        s_band_ctx.remaining_bits -= qalloc;
+        m_band_ctx.remaining_bits -= qalloc;
 
         if (lowband)
             next_lowband2 = lowband + N; /* >32-bit split case */
 
-        rebalance = s_band_ctx.remaining_bits;
+        rebalance = m_band_ctx.remaining_bits;
         if (mbits >= sbits)  {
             cm = quant_partition(X, N, mbits, B, lowband, LM,
                                  MULT16_16_P15(gain, mid), fill);
-            rebalance = mbits - (rebalance - s_band_ctx.remaining_bits);
+            rebalance = mbits - (rebalance - m_band_ctx.remaining_bits);
             if (rebalance > 3 << BITRES && itheta != 0)
                 sbits += rebalance - (3 << BITRES);
             cm |= quant_partition(Y, N, sbits, B, next_lowband2, LM,
@@ -1448,7 +1469,7 @@ uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *l
             cm = quant_partition(Y, N, sbits, B, next_lowband2, LM,
                                  MULT16_16_P15(gain, side), fill >> B)
                  << (_B0 >> 1);
-            rebalance = sbits - (rebalance - s_band_ctx.remaining_bits);
+            rebalance = sbits - (rebalance - m_band_ctx.remaining_bits);
             if (rebalance > 3 << BITRES && itheta != 16384)
                 mbits += rebalance - (3 << BITRES);
             cm |= quant_partition(X, N, mbits, B, lowband, LM,
@@ -1459,14 +1480,14 @@ uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *l
         /* This is the basic no-split case */
         q = bits2pulses(i, LM, b);
         curr_bits = pulses2bits(i, LM, q);
-        s_band_ctx.remaining_bits -= curr_bits;
+        m_band_ctx.remaining_bits -= curr_bits;
 
         /* Ensures we can never bust the budget */
-        while (s_band_ctx.remaining_bits < 0 && q > 0) {
-            s_band_ctx.remaining_bits += curr_bits;
+        while (m_band_ctx.remaining_bits < 0 && q > 0) {
+            m_band_ctx.remaining_bits += curr_bits;
             q--;
             curr_bits = pulses2bits(i, LM, q);
-            s_band_ctx.remaining_bits -= curr_bits;
+            m_band_ctx.remaining_bits -= curr_bits;
         }
 
         if (q != 0) {
@@ -1478,7 +1499,7 @@ uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *l
         else {
             /* If there's no pulse, fill the band anyway */
             int32_t j;
-            if (s_band_ctx.resynth)
+            if (m_band_ctx.resynth)
             {
                 uint32_t cm_mask;
                 /* B can be as large as 16, so this shift might overflow an int32_t on a 16-bit platform; use a long to get defined behavior.*/
@@ -1491,8 +1512,8 @@ uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *l
                     if (lowband == NULL) {
                         /* Noise */
                         for (j = 0; j < N; j++) {
-                            s_band_ctx.seed = celt_lcg_rand(s_band_ctx.seed);
-                            X[j] = (int16_t)((int32_t)s_band_ctx.seed >> 20);
+                            m_band_ctx.seed = celt_lcg_rand(m_band_ctx.seed);
+                            X[j] = (int16_t)((int32_t)m_band_ctx.seed >> 20);
                         }
                         cm = cm_mask;
                     }
@@ -1500,10 +1521,10 @@ uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *l
                         /* Folded spectrum */
                         for (j = 0; j < N; j++) {
                             int16_t tmp;
-                            s_band_ctx.seed = celt_lcg_rand(s_band_ctx.seed);
+                            m_band_ctx.seed = celt_lcg_rand(m_band_ctx.seed);
                             /* About 48 dB below the "normal" folding level */
                             tmp = QCONST16(1.0f / 256, 10);
-                            tmp = (s_band_ctx.seed) & 0x8000 ? tmp : -tmp;
+                            tmp = (m_band_ctx.seed) & 0x8000 ? tmp : -tmp;
                             X[j] = lowband[j] + tmp;
                         }
                         cm = fill;
@@ -1518,7 +1539,7 @@ uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *l
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 /* This function is responsible for encoding and decoding a band for the mono case. */
-uint32_t quant_band(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM,
+uint32_t CeltDecoder::quant_band(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM,
                            int16_t *lowband_out, int16_t gain, int16_t *lowband_scratch, int32_t fill) {
     int32_t N0 = N;
     int32_t N_B = N;
@@ -1531,7 +1552,7 @@ uint32_t quant_band(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowban
     int32_t k;
     int32_t tf_change;
 
-    tf_change = s_band_ctx.tf_change;
+    tf_change = m_band_ctx.tf_change;
 
     longBlocks = _B0 == 1;
 
@@ -1582,7 +1603,7 @@ uint32_t quant_band(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowban
 
     cm = quant_partition(X, N, b, B, lowband, LM, gain, fill);
 
-    if (s_band_ctx.resynth) {
+    if (m_band_ctx.resynth) {
         /* Undo the sample reorganization going from time order to frequency order */
         if (_B0 > 1)
             interleave_hadamard(X, N_B >> recombine, _B0 << recombine, longBlocks);
@@ -1620,7 +1641,7 @@ uint32_t quant_band(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowban
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 /* This function is responsible for encoding and decoding a band for the stereo case. */
-uint32_t quant_band_stereo(int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t B, int16_t *lowband,
+uint32_t CeltDecoder::quant_band_stereo(int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t B, int16_t *lowband,
                                   int32_t LM, int16_t *lowband_out, int16_t *lowband_scratch, int32_t fill) {
     int32_t imid = 0, iside = 0;
     int32_t inv = 0;
@@ -1662,7 +1683,7 @@ uint32_t quant_band_stereo(int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t
             sbits = 1 << BITRES;
         mbits -= sbits;
         c = itheta > 8192;
-        s_band_ctx.remaining_bits -= qalloc + sbits;
+        m_band_ctx.remaining_bits -= qalloc + sbits;
 
         x2 = c ? Y : X;
         y2 = c ? X : Y;
@@ -1676,7 +1697,7 @@ uint32_t quant_band_stereo(int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t
         /* We don't split N=2 bands, so cm is either 1 or 0 (for a fold-collapse), and there's no need to worry about mixing with the other channel. */
         y2[0] = -sign * x2[1];
         y2[1] = sign * x2[0];
-        if (s_band_ctx.resynth) {
+        if (m_band_ctx.resynth) {
             int16_t tmp;
             X[0] = MULT16_16_Q15(mid, X[0]);
             X[1] = MULT16_16_Q15(mid, X[1]);
@@ -1696,14 +1717,14 @@ uint32_t quant_band_stereo(int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t
 
         mbits = max((int32_t)0, min(b, (b - delta) / 2));
         sbits = b - mbits;
-        s_band_ctx.remaining_bits -= qalloc;
+        m_band_ctx.remaining_bits -= qalloc;
 
-        rebalance = s_band_ctx.remaining_bits;
+        rebalance = m_band_ctx.remaining_bits;
         if (mbits >= sbits) {
             /* In stereo mode, we do not apply a scaling to the mid because we need the normalized mid for folding later. */
             cm = quant_band(X, N, mbits, B, lowband, LM, lowband_out, 32767,
                             lowband_scratch, fill);
-            rebalance = mbits - (rebalance - s_band_ctx.remaining_bits);
+            rebalance = mbits - (rebalance - m_band_ctx.remaining_bits);
             if (rebalance > 3 << BITRES && itheta != 0)
                 sbits += rebalance - (3 << BITRES);
 
@@ -1714,7 +1735,7 @@ uint32_t quant_band_stereo(int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t
         else {
             /* For a stereo split, the high bits of fill are always zero, so no folding will be done to the side. */
             cm = quant_band(Y, N, sbits, B, NULL, LM, NULL, side, NULL, fill >> B);
-            rebalance = sbits - (rebalance - s_band_ctx.remaining_bits);
+            rebalance = sbits - (rebalance - m_band_ctx.remaining_bits);
             if (rebalance > 3 << BITRES && itheta != 16384)
                 mbits += rebalance - (3 << BITRES);
             /* In stereo mode, we do not apply a scaling to the mid because we need the normalized mid for folding later. */
@@ -1722,7 +1743,7 @@ uint32_t quant_band_stereo(int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t
                              lowband_scratch, fill);
         }
     }
-    if (s_band_ctx.resynth) {
+    if (m_band_ctx.resynth) {
         if (N != 2)
             stereo_merge(X, Y, mid, N);
         if (inv)
@@ -1735,7 +1756,7 @@ uint32_t quant_band_stereo(int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t
     return cm;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void special_hybrid_folding(int16_t *norm, int16_t *norm2, int32_t start, int32_t M, int32_t dual_stereo){
+void CeltDecoder::special_hybrid_folding(int16_t *norm, int16_t *norm2, int32_t start, int32_t M, int32_t dual_stereo){
     int32_t n1, n2;
     const int16_t * eBands = eband5ms;
     n1 = M * (eBands[start + 1] - eBands[start]);
@@ -1746,7 +1767,7 @@ void special_hybrid_folding(int16_t *norm, int16_t *norm2, int32_t start, int32_
         memcpy(&norm2[n1], &norm2[2 * n1 - n2], (n2 - n1) * sizeof(*norm2));
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void quant_all_bands(int32_t start, int32_t end, int16_t *X_, int16_t *Y_, uint8_t *collapse_masks, const int32_t *bandE, int32_t *pulses, int32_t shortBlocks, int32_t spread, int32_t dual_stereo,
+void CeltDecoder::quant_all_bands(int32_t start, int32_t end, int16_t *X_, int16_t *Y_, uint8_t *collapse_masks, const int32_t *bandE, int32_t *pulses, int32_t shortBlocks, int32_t spread, int32_t dual_stereo,
                      int32_t intensity, int32_t *tf_res, int32_t total_bits, int32_t balance,  int32_t LM, int32_t codedBands, uint32_t *seed, int32_t complexity, int32_t disable_inv){
     int32_t i;
     int32_t remaining_bits;
@@ -1768,7 +1789,7 @@ void quant_all_bands(int32_t start, int32_t end, int16_t *X_, int16_t *Y_, uint8
     norm_offset = M * eBands[start];
     /* No need to allocate norm for the last band because we don't need an
        output in that band. */
-    auto _norm = celt_malloc_arr<int16_t>(C * (M * eBands[m_CELTMode.nbEBands - 1] - norm_offset) * sizeof(int16_t));
+    auto _norm = celt_scratch_arr<int16_t>(C * (M * eBands[m_CELTMode.nbEBands - 1] - norm_offset));
     norm = _norm.get();
     norm2 = norm + M * eBands[m_CELTMode.nbEBands - 1] - norm_offset;
 
@@ -1776,25 +1797,25 @@ void quant_all_bands(int32_t start, int32_t end, int16_t *X_, int16_t *Y_, uint8
        decoding the last band. */
     resynth_alloc = ALLOC_NONE;
 
-    auto _lowband_scratch = celt_malloc_arr<int16_t>(resynth_alloc * sizeof(int16_t));
+    auto _lowband_scratch = celt_scratch_arr<int16_t>(resynth_alloc);
     lowband_scratch = X_ + M * eBands[m_CELTMode.nbEBands - 1];
 
-    auto X_save =     celt_malloc_arr<int16_t>(resynth_alloc * sizeof(int16_t));
-    auto Y_save =     celt_malloc_arr<int16_t>(resynth_alloc * sizeof(int16_t));
-    auto X_save2 =    celt_malloc_arr<int16_t>(resynth_alloc * sizeof(int16_t));
-    auto Y_save2 =    celt_malloc_arr<int16_t>(resynth_alloc * sizeof(int16_t));
-    auto norm_save2 = celt_malloc_arr<int16_t>(resynth_alloc * sizeof(int16_t));
+    auto X_save =     celt_scratch_arr<int16_t>(resynth_alloc);
+    auto Y_save =     celt_scratch_arr<int16_t>(resynth_alloc);
+    auto X_save2 =    celt_scratch_arr<int16_t>(resynth_alloc);
+    auto Y_save2 =    celt_scratch_arr<int16_t>(resynth_alloc);
+    auto norm_save2 = celt_scratch_arr<int16_t>(resynth_alloc);
 
     lowband_offset = 0;
-    s_band_ctx.bandE = bandE;
-    s_band_ctx.intensity = intensity;
-    s_band_ctx.seed = *seed;
-    s_band_ctx.spread = spread;
-    s_band_ctx.disable_inv = disable_inv;
-    s_band_ctx.resynth = resynth;
-    s_band_ctx.theta_round = 0;
+    m_band_ctx.bandE = bandE;
+    m_band_ctx.intensity = intensity;
+    m_band_ctx.seed = *seed;
+    m_band_ctx.spread = spread;
+    m_band_ctx.disable_inv = disable_inv;
+    m_band_ctx.resynth = resynth;
+    m_band_ctx.theta_round = 0;
     /* Avoid injecting noise in the first band on transients. */
-    s_band_ctx.avoid_split_noise = B > 1;
+    m_band_ctx.avoid_split_noise = B > 1;
     for (i = start; i < end; i++){
         int32_t tell;
         int32_t b;
@@ -1807,7 +1828,7 @@ void quant_all_bands(int32_t start, int32_t end, int16_t *X_, int16_t *Y_, uint8
         uint32_t y_cm;
         int32_t last;
 
-        s_band_ctx.i = i;
+        m_band_ctx.i = i;
         last = (i == end - 1);
 
         X = X_ + M * eBands[i];
@@ -1823,7 +1844,7 @@ void quant_all_bands(int32_t start, int32_t end, int16_t *X_, int16_t *Y_, uint8
         if (i != start)
             balance -= tell;
         remaining_bits = total_bits - tell - 1;
-        s_band_ctx.remaining_bits = remaining_bits;
+        m_band_ctx.remaining_bits = remaining_bits;
         if (i <= codedBands - 1){
             curr_balance = celt_sudiv(balance, min((int32_t)3, codedBands - i));
             b = max((int32_t)0, min((int32_t)16383, min(remaining_bits + (int32_t)1, (int32_t)pulses[i] + curr_balance)));
@@ -1838,7 +1859,7 @@ void quant_all_bands(int32_t start, int32_t end, int16_t *X_, int16_t *Y_, uint8
             special_hybrid_folding(norm, norm2, start, M, dual_stereo);
 
         tf_change = tf_res[i];
-        s_band_ctx.tf_change = tf_change;
+        m_band_ctx.tf_change = tf_change;
         if (i >= m_CELTMode.effEBands) {
             X = norm;
             if (Y_ != NULL)
@@ -1893,7 +1914,7 @@ void quant_all_bands(int32_t start, int32_t end, int16_t *X_, int16_t *Y_, uint8
         }
         else {
             if (Y != NULL) {
-                s_band_ctx.theta_round = 0;
+                m_band_ctx.theta_round = 0;
                 x_cm = quant_band_stereo(X, Y, N, b, B,
                     effective_lowband != -1 ? norm + effective_lowband : NULL, LM,
                     last ? NULL : norm + M * eBands[i] - norm_offset, lowband_scratch, x_cm | y_cm);
@@ -1913,41 +1934,40 @@ void quant_all_bands(int32_t start, int32_t end, int16_t *X_, int16_t *Y_, uint8
         update_lowband = b > (N << BITRES);
         /* We only need to avoid noise on a split for the first band. After that, we
            have folding. */
-        s_band_ctx.avoid_split_noise = 0;
+        m_band_ctx.avoid_split_noise = 0;
     }
-    *seed = s_band_ctx.seed;
+    *seed = m_band_ctx.seed;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-int32_t celt_decoder_get_size(int32_t channels){
-    static int32_t size;
-    size = sizeof(CELTDecoder_t) + (channels * (DECODE_BUFFER_SIZE + m_CELTMode.overlap) - 1) * sizeof(int32_t)
+int32_t CeltDecoder::celt_decoder_get_size(int32_t channels){
+    int32_t size = sizeof(CELTDecoder_t) + (channels * (DECODE_BUFFER_SIZE + m_CELTMode.overlap) - 1) * sizeof(int32_t)
            + channels * 24 * sizeof(int16_t) + 4 * 2 * m_CELTMode.nbEBands * sizeof(int16_t);
     return size;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-int32_t celt_decoder_init(int32_t channels){
-
-    s_celtDec.clear();
-
-    s_celtDec->downsample = 1; //resampling_factor(Fs);
-    s_celtDec->channels = channels;
-    if(channels == 1) s_celtDec->disable_inv = 1; else s_celtDec->disable_inv = 0; // 1 mono ,  0 stereo
-    s_celtDec->end = m_CELTMode.nbEBands; // 21
-    s_celtDec->error = 0;
-    s_celtDec->overlap = m_CELTMode.overlap;
-    s_celtDec->postfilter_gain = 0;
-    s_celtDec->postfilter_gain_old = 0;
-    s_celtDec->postfilter_period = 0;
-    s_celtDec->postfilter_tapset = 0;
-    s_celtDec->postfilter_tapset_old = 0;
-    s_celtDec->preemph_memD[0] = 0;
-    s_celtDec->preemph_memD[1] = 0;
-    s_celtDec->rng = 0;
-    s_celtDec->signalling = 1;
-    s_celtDec->start = 0;
-    s_celtDec->end = m_CELTMode.effEBands;
-    s_celtDec->stream_channels = channels;
-    s_celtDec->_decode_mem[0] = 0;
+int32_t CeltDecoder::celt_decoder_init(int32_t channels){
+
+    m_celtDec.clear();
+
+    m_celtDec->downsample = 1; //resampling_factor(Fs);
+    m_celtDec->channels = channels;
+    if(channels == 1) m_celtDec->disable_inv = 1; else m_celtDec->disable_inv = 0; // 1 mono ,  0 stereo
+    m_celtDec->end = m_CELTMode.nbEBands; // 21
+    m_celtDec->error = 0;
+    m_celtDec->overlap = m_CELTMode.overlap;
+    m_celtDec->postfilter_gain = 0;
+    m_celtDec->postfilter_gain_old = 0;
+    m_celtDec->postfilter_period = 0;
+    m_celtDec->postfilter_tapset = 0;
+    m_celtDec->postfilter_tapset_old = 0;
+    m_celtDec->preemph_memD[0] = 0;
+    m_celtDec->preemph_memD[1] = 0;
+    m_celtDec->rng = 0;
+    m_celtDec->signalling = 1;
+    m_celtDec->start = 0;
+    m_celtDec->end = m_CELTMode.effEBands;
+    m_celtDec->stream_channels = channels;
+    m_celtDec->_decode_mem[0] = 0;
 
     int32_t ret = celt_decoder_ctl(OPUS_RESET_STATE);
     if(ret < 0) return ret;
@@ -1957,7 +1977,7 @@ int32_t celt_decoder_init(int32_t channels){
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 /* Special case for stereo with no downsampling and no accumulation. This is quite common and we can make it faster by  processing both channels in the same loop, reducing overhead due to the
    dependency loop in the IIR filter. */
-void deemphasis_stereo_simple(int32_t *in[], int16_t *pcm, int32_t N, const int16_t coef0, int32_t *mem) {
+void CeltDecoder::deemphasis_stereo_simple(int32_t *in[], int16_t *pcm, int32_t N, const int16_t coef0, int32_t *mem) {
     int32_t * x0;
     int32_t * x1;
     int32_t m0, m1;
@@ -1980,7 +2000,7 @@ void deemphasis_stereo_simple(int32_t *in[], int16_t *pcm, int32_t N, const int1
     mem[1] = m1;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void deemphasis(int32_t *in[], int16_t *pcm, int32_t N, int32_t C, int32_t downsample, const int16_t *coef,
+void CeltDecoder::deemphasis(int32_t *in[], int16_t *pcm, int32_t N, int32_t C, int32_t downsample, const int16_t *coef,
                int32_t *mem, int32_t accum) {
     int32_t c;
     int32_t Nd;
@@ -1993,7 +2013,7 @@ void deemphasis(int32_t *in[], int16_t *pcm, int32_t N, int32_t C, int32_t downs
         return;
     }
 
-    auto scratch = celt_malloc_arr<int32_t>(N * sizeof(int32_t*));
+    auto scratch = celt_scratch_arr<int32_t>(N);
     coef0 = coef[0];
     Nd = N / downsample;
     c = 0;
@@ -2049,7 +2069,7 @@ void deemphasis(int32_t *in[], int16_t *pcm, int32_t N, int32_t C, int32_t downs
     } while (++c < C);
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void celt_synthesis(int16_t *X, int32_t *out_syn[], int16_t *oldBandE, int32_t start,
+void CeltDecoder::celt_synthesis(int16_t *X, int32_t *out_syn[], int16_t *oldBandE, int32_t start,
                            int32_t effEnd, int32_t C, int32_t CC, int32_t isTransient, int32_t LM, int32_t downsample, int32_t silence){
     int32_t c, i;
     int32_t M;
@@ -2063,7 +2083,7 @@ void celt_synthesis(int16_t *X, int32_t *out_syn[], int16_t *oldBandE, int32_t s
     overlap =  m_CELTMode.overlap;
     nbEBands = m_CELTMode.nbEBands;
     N = m_CELTMode.shortMdctSize << LM;
-    auto freq = celt_malloc_arr<int32_t>(N * sizeof(int32_t*)); /**< Interleaved signal MDCTs */
+    auto freq = celt_scratch_arr<int32_t>(N); /**< Interleaved signal MDCTs */
     M = 1 << LM;
 
     if (isTransient) {
@@ -2120,7 +2140,7 @@ void celt_synthesis(int16_t *X, int32_t *out_syn[], int16_t *oldBandE, int32_t s
     } while (++c < CC);
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void tf_decode(int32_t start, int32_t end, int32_t isTransient, int32_t *tf_res, int32_t LM){
+void CeltDecoder::tf_decode(int32_t start, int32_t end, int32_t isTransient, int32_t *tf_res, int32_t LM){
     int32_t i, curr, tf_select;
     int32_t tf_select_rsv;
     int32_t tf_changed;
@@ -2128,7 +2148,7 @@ void tf_decode(int32_t start, int32_t end, int32_t isTransient, int32_t *tf_res,
     uint32_t budget;
     uint32_t tell;
 
-    budget = s_ec.storage * 8;
+    budget = m_ec.storage * 8;
     tell = ec_tell();
     logp = isTransient ? 2 : 4;
     tf_select_rsv = LM > 0 && tell + logp + 1 <= budget;
@@ -2154,7 +2174,7 @@ void tf_decode(int32_t start, int32_t end, int32_t isTransient, int32_t *tf_res,
     }
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-int32_t celt_decode_with_ec(int16_t * outbuf, int32_t frame_size) {
+int32_t CeltDecoder::celt_decode_with_ec(int16_t * outbuf, int32_t frame_size) {
     int32_t c, i, N;
     int32_t spread_decision;
     int32_t bits;
@@ -2166,7 +2186,7 @@ int32_t celt_decode_with_ec(int16_t * outbuf, int32_t frame_size) {
     int32_t shortBlocks;
     int32_t isTransient;
     int32_t intra_ener;
-    const int32_t CC = s_celtDec->channels;
+    const int32_t CC = m_celtDec->channels;
     int32_t LM, M;
     int32_t start;
     int32_t end;
@@ -2185,16 +2205,18 @@ int32_t celt_decode_with_ec(int16_t * outbuf, int32_t frame_size) {
     int32_t anti_collapse_rsv;
     int32_t anti_collapse_on = 0;
     int32_t silence;
-    const uint8_t  C = s_celtDec->stream_channels; // =channels=2
+    const uint8_t  C = m_celtDec->stream_channels; // =channels=2
     const uint8_t  nbEBands = m_CELTMode.nbEBands; // =21
     const uint8_t  overlap = m_CELTMode.overlap; // =120
     const int16_t *eBands = eband5ms;
 
-    start = s_celtDec->start;
+    m_celtScratch.rewind(); // new frame, no temporary array is in use
+
+    start = m_celtDec->start;
     end = m_CELTMode.effEBands;
-    frame_size *= s_celtDec->downsample;
+    frame_size *= m_celtDec->downsample;
 
-    lpc = (int16_t *)(s_celtDec->_decode_mem + (DECODE_BUFFER_SIZE + overlap) * CC);
+    lpc = (int16_t *)(m_celtDec->_decode_mem + (DECODE_BUFFER_SIZE + overlap) * CC);
     oldBandE = lpc + CC * LPC_ORDER;
     oldLogE = oldBandE + 2 * nbEBands;
     oldLogE2 = oldLogE + 2 * nbEBands;
@@ -2208,30 +2230,30 @@ int32_t celt_decode_with_ec(int16_t * outbuf, int32_t frame_size) {
 
     M = 1 << LM;
 
-    if(s_ec.storage > 1275 || outbuf == NULL) {OPUS_LOG_ERROR("Opus Celt bas arg"); return OPUS_ERR;}
+    if(m_ec.storage > 1275 || outbuf == NULL) {OPUS_LOG_ERROR("Opus Celt bas arg"); return OPUS_ERR;}
 
     N = M * m_CELTMode.shortMdctSize;
     c = 0;
     do {
-        decode_mem[c] = s_celtDec->_decode_mem + c * (DECODE_BUFFER_SIZE + overlap);  // todo
+        decode_mem[c] = m_celtDec->_decode_mem + c * (DECODE_BUFFER_SIZE + overlap);  // todo
         out_syn[c] = decode_mem[c] + DECODE_BUFFER_SIZE - N;
     } while (++c < CC);
 
-    if(s_ec.storage <= 1) {OPUS_LOG_ERROR("Opus Celt bas arg"); return OPUS_ERR;}
+    if(m_ec.storage <= 1) {OPUS_LOG_ERROR("Opus Celt bas arg"); return OPUS_ERR;}
 
     effEnd = end;
     if (effEnd > m_CELTMode.effEBands)
         effEnd = m_CELTMode.effEBands;
 
     /* Check if there are at least two packets received consecutively before turning on the pitch-based PLC */
-    s_celtDec->skip_plc = s_celtDec->loss_count != 0;
+    m_celtDec->skip_plc = m_celtDec->loss_count != 0;
 
     if (C == 1) {
         for (i = 0; i < nbEBands; i++)
             oldBandE[i] = max(oldBandE[i], oldBandE[nbEBands + i]);
     }
 
-    total_bits = s_ec.storage * 8;
+    total_bits = m_ec.storage * 8;
     tell = ec_tell();
 
     if (tell >= total_bits)
@@ -2242,8 +2264,8 @@ int32_t celt_decode_with_ec(int16_t * outbuf, int32_t frame_size) {
         silence = 0;
     if (silence)  {
         /* Pretend we've read all the remaining bits */
-        tell = s_ec.storage * 8;
-        s_ec.nbits_total += tell - ec_tell();
+        tell = m_ec.storage * 8;
+        m_ec.nbits_total += tell - ec_tell();
     }
 
     postfilter_gain = 0;
@@ -2280,18 +2302,18 @@ int32_t celt_decode_with_ec(int16_t * outbuf, int32_t frame_size) {
     /* Get band energies */
     unquant_coarse_energy(start, end, oldBandE, intra_ener, C, LM);
 
-    auto tf_res = celt_malloc_arr<int32_t>(nbEBands * sizeof(int32_t));
+    auto tf_res = celt_scratch_arr<int32_t>(nbEBands);
     tf_decode(start, end, isTransient, tf_res.get(), LM);
 
     tell = ec_tell();
     spread_decision = SPREAD_NORMAL;
     if (tell + 4 <= total_bits) spread_decision = ec_dec_icdf(spread_icdf, 5);
 
-    auto cap = celt_malloc_arr<int32_t>(nbEBands * sizeof(int32_t));
+    auto cap = celt_scratch_arr<int32_t>(nbEBands);
 
     init_caps(cap.get(), LM, C);
 
-    auto offsets = celt_malloc_arr<int32_t>(nbEBands * sizeof(int32_t));
+    auto offsets = celt_scratch_arr<int32_t>(nbEBands);
 
     dynalloc_logp = 6;
     total_bits <<= BITRES;
@@ -2322,16 +2344,16 @@ int32_t celt_decode_with_ec(int16_t * outbuf, int32_t frame_size) {
             dynalloc_logp = max((int32_t)2, dynalloc_logp - 1);
     }
 
-    auto fine_quant = celt_malloc_arr<int32_t>(nbEBands * sizeof(int32_t));
+    auto fine_quant = celt_scratch_arr<int32_t>(nbEBands);
 
     alloc_trim = tell + (6 << BITRES) <= total_bits ? ec_dec_icdf(trim_icdf, 7) : 5;
 
-    bits = (((int32_t)s_ec.storage * 8) << BITRES) - ec_tell_frac() - 1;
+    bits = (((int32_t)m_ec.storage * 8) << BITRES) - ec_tell_frac() - 1;
     anti_collapse_rsv = isTransient && LM >= 2 && bits >= ((LM + 2) << BITRES) ? (1 << BITRES) : 0;
     bits -= anti_collapse_rsv;
 
-    auto pulses = celt_malloc_arr<int32_t>(nbEBands * sizeof(int32_t));
-    auto fine_priority = celt_malloc_arr<int32_t>(nbEBands * sizeof(int32_t));
+    auto pulses = celt_scratch_arr<int32_t>(nbEBands);
+    auto fine_priority = celt_scratch_arr<int32_t>(nbEBands);
 
     codedBands = clt_compute_allocation(start, end, offsets.get(), cap.get(),
                                         alloc_trim, &intensity, &dual_stereo, bits, &balance, pulses.get(),
@@ -2345,25 +2367,25 @@ int32_t celt_decode_with_ec(int16_t * outbuf, int32_t frame_size) {
     } while (++c < CC);
 
     /* Decode fixed codebook */
-    auto collapse_masks = celt_malloc_arr<uint8_t>(C * nbEBands * sizeof(uint8_t));
+    auto collapse_masks = celt_scratch_arr<uint8_t>(C * nbEBands);
 
-    auto X = celt_malloc_arr<int16_t>(C * N * sizeof(int16_t)); /**< Interleaved normalised MDCTs */
+    auto X = celt_scratch_arr<int16_t>(C * N); /**< Interleaved normalised MDCTs */
 
     quant_all_bands(start, end, X.get(), C == 2 ? X.get() + N : NULL, collapse_masks.get(),
                     NULL, pulses.get(), shortBlocks, spread_decision, dual_stereo, intensity, tf_res.get(),
-                    s_ec.storage * (8 << BITRES) - anti_collapse_rsv, balance, LM, codedBands, &s_celtDec->rng, 0,
-                    s_celtDec->disable_inv);
+                    m_ec.storage * (8 << BITRES) - anti_collapse_rsv, balance, LM, codedBands, &m_celtDec->rng, 0,
+                    m_celtDec->disable_inv);
 
     if (anti_collapse_rsv > 0) {
         anti_collapse_on = ec_dec_bits(1);
     }
 
     unquant_energy_finalise(start, end, oldBandE,
-                            fine_quant.get(), fine_priority.get(), s_ec.storage * 8 - ec_tell(), C);
+                            fine_quant.get(), fine_priority.get(), m_ec.storage * 8 - ec_tell(), C);
 
     if (anti_collapse_on)
         anti_collapse(X.get(), collapse_masks.get(), LM, C, N,
-                      start, end, oldBandE, oldLogE, oldLogE2, pulses.get(), s_celtDec->rng);
+                      start, end, oldBandE, oldLogE, oldLogE2, pulses.get(), m_celtDec->rng);
 
     if (silence) {
         for (i = 0; i < C * nbEBands; i++)
@@ -2371,29 +2393,29 @@ int32_t celt_decode_with_ec(int16_t * outbuf, int32_t frame_size) {
     }
 
     celt_synthesis(X.get(), out_syn, oldBandE, start, effEnd,
-                   C, CC, isTransient, LM, s_celtDec->downsample, silence);
+                   C, CC, isTransient, LM, m_celtDec->downsample, silence);
 
     c = 0;
     do  {
-        s_celtDec->postfilter_period = max(s_celtDec->postfilter_period, (int32_t)COMBFILTER_MINPERIOD);
-        s_celtDec->postfilter_period_old = max(s_celtDec->postfilter_period_old, (int32_t)COMBFILTER_MINPERIOD);
-        comb_filter(out_syn[c], out_syn[c], s_celtDec->postfilter_period_old, s_celtDec->postfilter_period,m_CELTMode.shortMdctSize,
-                    s_celtDec->postfilter_gain_old, s_celtDec->postfilter_gain, s_celtDec->postfilter_tapset_old, s_celtDec->postfilter_tapset);
+        m_celtDec->postfilter_period = max(m_celtDec->postfilter_period, (int32_t)COMBFILTER_MINPERIOD);
+        m_celtDec->postfilter_period_old = max(m_celtDec->postfilter_period_old, (int32_t)COMBFILTER_MINPERIOD);
+        comb_filter(out_syn[c], out_syn[c], m_celtDec->postfilter_period_old, m_celtDec->postfilter_period,m_CELTMode.shortMdctSize,
+                    m_celtDec->postfilter_gain_old, m_celtDec->postfilter_gain, m_celtDec->postfilter_tapset_old, m_celtDec->postfilter_tapset);
         if (LM != 0)
-            comb_filter(out_syn[c] + m_CELTMode.shortMdctSize, out_syn[c] + m_CELTMode.shortMdctSize, s_celtDec->postfilter_period, postfilter_pitch, N - m_CELTMode.shortMdctSize,
-                        s_celtDec->postfilter_gain, postfilter_gain, s_celtDec->postfilter_tapset, postfilter_tapset);
+            comb_filter(out_syn[c] + m_CELTMode.shortMdctSize, out_syn[c] + m_CELTMode.shortMdctSize, m_celtDec->postfilter_period, postfilter_pitch, N - m_CELTMode.shortMdctSize,
+                        m_celtDec->postfilter_gain, postfilter_gain, m_celtDec->postfilter_tapset, postfilter_tapset);
 
     } while (++c < CC);
-    s_celtDec->postfilter_period_old = s_celtDec->postfilter_period;
-    s_celtDec->postfilter_gain_old = s_celtDec->postfilter_gain;
-    s_celtDec->postfilter_tapset_old = s_celtDec->postfilter_tapset;
-    s_celtDec->postfilter_period = postfilter_pitch;
-    s_celtDec->postfilter_gain = postfilter_gain;
-    s_celtDec->postfilter_tapset = postfilter_tapset;
+    m_celtDec->postfilter_period_old = m_celtDec->postfilter_period;
+    m_celtDec->postfilter_gain_old = m_celtDec->postfilter_gain;
+    m_celtDec->postfilter_tapset_old = m_celtDec->postfilter_tapset;
+    m_celtDec->postfilter_period = postfilter_pitch;
+    m_celtDec->postfilter_gain = postfilter_gain;
+    m_celtDec->postfilter_tapset = postfilter_tapset;
     if (LM != 0) {
-        s_celtDec->postfilter_period_old = s_celtDec->postfilter_period;
-        s_celtDec->postfilter_gain_old = s_celtDec->postfilter_gain;
-        s_celtDec->postfilter_tapset_old = s_celtDec->postfilter_tapset;
+        m_celtDec->postfilter_period_old = m_celtDec->postfilter_period;
+        m_celtDec->postfilter_gain_old = m_celtDec->postfilter_gain;
+        m_celtDec->postfilter_tapset_old = m_celtDec->postfilter_tapset;
     }
 
     if (C == 1)
@@ -2405,7 +2427,7 @@ int32_t celt_decode_with_ec(int16_t * outbuf, int32_t frame_size) {
         memcpy(oldLogE2, oldLogE, 2 * nbEBands * sizeof(*oldLogE2));
         memcpy(oldLogE, oldBandE, 2 * nbEBands * sizeof(*oldLogE));
         /* In normal circumstances, we only allow the noise floor to increase by up to 2.4 dB/second, but when we're in DTX, we allow up to 6 dB increase for each update.*/
-        if (s_celtDec->loss_count < 10)
+        if (m_celtDec->loss_count < 10)
             max_background_increase = M * QCONST16(0.001f, DB_SHIFT);
         else
             max_background_increase = QCONST16(1.f, DB_SHIFT);
@@ -2429,18 +2451,18 @@ int32_t celt_decode_with_ec(int16_t * outbuf, int32_t frame_size) {
             oldLogE[c * nbEBands + i] = oldLogE2[c * nbEBands + i] = -QCONST16(28.f, DB_SHIFT);
         }
     } while (++c < 2);
-    s_celtDec->rng = s_ec.rng;
+    m_celtDec->rng = m_ec.rng;
 
-    deemphasis(out_syn, outbuf, N, CC, s_celtDec->downsample, m_CELTMode.preemph, s_celtDec->preemph_memD, 0);
-    s_celtDec->loss_count = 0;
-    if (ec_tell() > 8 * s_ec.storage)
+    deemphasis(out_syn, outbuf, N, CC, m_celtDec->downsample, m_CELTMode.preemph, m_celtDec->preemph_memD, 0);
+    m_celtDec->loss_count = 0;
+    if (ec_tell() > 8 * m_ec.storage)
         return OPUS_INTERNAL_ERROR;
-    if (s_ec.error)
-        s_celtDec->error = 1;
-    return frame_size / s_celtDec->downsample;
+    if (m_ec.error)
+        m_celtDec->error = 1;
+    return frame_size / m_celtDec->downsample;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-int32_t celt_decoder_ctl(int32_t request, ...) {
+int32_t CeltDecoder::celt_decoder_ctl(int32_t request, ...) {
     va_list ap;
 
     va_start(ap, request);
@@ -2448,53 +2470,53 @@ int32_t celt_decoder_ctl(int32_t request, ...) {
         case CELT_SET_START_BAND_REQUEST: {
             int32_t value = va_arg(ap, int32_t);
             if (value < 0 || value >= m_CELTMode.nbEBands) goto bad_arg;
-            s_celtDec->start = value;
+            m_celtDec->start = value;
         } break;
         case CELT_SET_END_BAND_REQUEST: {
             int32_t value = va_arg(ap, int32_t);
             if (value < 1 || value > m_CELTMode.nbEBands) goto bad_arg;
-            s_celtDec->end = value;
+            m_celtDec->end = value;
         } break;
         case CELT_SET_CHANNELS_REQUEST: {
             int32_t value = va_arg(ap, int32_t);
             if (value < 1 || value > 2) goto bad_arg;
-            s_celtDec->stream_channels = value;
+            m_celtDec->stream_channels = value;
         } break;
         case CELT_GET_AND_CLEAR_ERROR_REQUEST: {
             int32_t *value = va_arg(ap, int32_t *);
             if (value == NULL) goto bad_arg;
-            *value = s_celtDec->error;
-            s_celtDec->error = 0;
+            *value = m_celtDec->error;
+            m_celtDec->error = 0;
         } break;
         case OPUS_GET_LOOKAHEAD_REQUEST: {
             int32_t *value = va_arg(ap, int32_t *);
             if (value == NULL) goto bad_arg;
-            *value = s_celtDec->overlap / s_celtDec->downsample;
+            *value = m_celtDec->overlap / m_celtDec->downsample;
         } break;
         case OPUS_RESET_STATE: {
             int32_t i;
             int16_t *lpc, *oldBandE, *oldLogE, *oldLogE2;
-            lpc = (int16_t *)(s_celtDec->_decode_mem + (DECODE_BUFFER_SIZE + s_celtDec->overlap) * s_celtDec->channels);
-            oldBandE = lpc + s_celtDec->channels * LPC_ORDER;
+            lpc = (int16_t *)(m_celtDec->_decode_mem + (DECODE_BUFFER_SIZE + m_celtDec->overlap) * m_celtDec->channels);
+            oldBandE = lpc + m_celtDec->channels * LPC_ORDER;
             oldLogE = oldBandE + 2 * m_CELTMode.nbEBands;
             oldLogE2 = oldLogE + 2 * m_CELTMode.nbEBands;
 
-            s_celtDec->rng = 0;
-            s_celtDec->error = 0;
-            s_celtDec->postfilter_period = 0;
-            s_celtDec->postfilter_period_old = 0;
-            s_celtDec->postfilter_gain = 0;
-            s_celtDec->postfilter_gain_old = 0;
-            s_celtDec->postfilter_tapset = 0;
-            s_celtDec->postfilter_tapset_old = 0;
+            m_celtDec->rng = 0;
+            m_celtDec->error = 0;
+            m_celtDec->postfilter_period = 0;
+            m_celtDec->postfilter_period_old = 0;
+            m_celtDec->postfilter_gain = 0;
+            m_celtDec->postfilter_gain_old = 0;
+            m_celtDec->postfilter_tapset = 0;
+            m_celtDec->postfilter_tapset_old = 0;
 
             for (i = 0; i < 2 * m_CELTMode.nbEBands; i++) oldLogE[i] = oldLogE2[i] = -QCONST16(28.f, DB_SHIFT);
-            s_celtDec->skip_plc = 1;
+            m_celtDec->skip_plc = 1;
         } break;
         case OPUS_GET_PITCH_REQUEST: {
             int32_t *value = va_arg(ap, int32_t *);
             if (value == NULL) goto bad_arg;
-            *value = s_celtDec->postfilter_period;
+            *value = m_celtDec->postfilter_period;
         } break;
         case CELT_GET_MODE_REQUEST: {
             const CELTMode_t **value = va_arg(ap, const CELTMode_t **);
@@ -2503,26 +2525,26 @@ int32_t celt_decoder_ctl(int32_t request, ...) {
         } break;
         case CELT_SET_SIGNALLING_REQUEST: {
             int32_t value = va_arg(ap, int32_t);
-            s_celtDec->signalling = value;
+            m_celtDec->signalling = value;
         } break;
         case OPUS_GET_FINAL_RANGE_REQUEST: {
             uint32_t *value = va_arg(ap, uint32_t *);
             if (value == 0) goto bad_arg;
-            *value = s_celtDec->rng;
+            *value = m_celtDec->rng;
         } break;
         case OPUS_SET_PHASE_INVERSION_DISABLED_REQUEST: {
             int32_t value = va_arg(ap, int32_t);
             if (value < 0 || value > 1) {
                 goto bad_arg;
             }
-            s_celtDec->disable_inv = value;
+            m_celtDec->disable_inv = value;
         } break;
         case OPUS_GET_PHASE_INVERSION_DISABLED_REQUEST: {
             int32_t *value = va_arg(ap, int32_t *);
             if (!value) {
                 goto bad_arg;
             }
-            *value = s_celtDec->disable_inv;
+            *value = m_celtDec->disable_inv;
         } break;
         default:
             goto bad_request;
@@ -2537,7 +2559,7 @@ bad_request:
     return OPUS_UNIMPLEMENTED;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-int32_t cwrsi(int32_t _n, int32_t _k, uint32_t _i, int32_t *_y) {
+int32_t CeltDecoder::cwrsi(int32_t _n, int32_t _k, uint32_t _i, int32_t *_y) {
     uint32_t p;
     int32_t s;
     int32_t k0;
@@ -2614,132 +2636,132 @@ int32_t cwrsi(int32_t _n, int32_t _k, uint32_t _i, int32_t *_y) {
     return yy;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-int32_t decode_pulses(int32_t *_y, int32_t _n, int32_t _k) {
+int32_t CeltDecoder::decode_pulses(int32_t *_y, int32_t _n, int32_t _k) {
     return cwrsi(_n, _k, ec_dec_uint(CELT_PVQ_V(_n, _k)), _y);
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 /* This is a faster version of ec_tell_frac() that takes advantage of the low (1/8 bit) resolution to use just a linear function followed by a lookup to determine the exact transition thresholds. */
-uint32_t ec_tell_frac() {
+uint32_t CeltDecoder::ec_tell_frac() {
     const uint32_t correction[8] = {35733, 38967, 42495, 46340, 50535, 55109, 60097, 65535};
     uint32_t nbits;
     uint32_t r;
     int32_t l;
     uint32_t b;
-    nbits = s_ec.nbits_total << BITRES;
-    l = EC_ILOG(s_ec.rng);
-    r = s_ec.rng >> (l - 16);
+    nbits = m_ec.nbits_total << BITRES;
+    l = EC_ILOG(m_ec.rng);
+    r = m_ec.rng >> (l - 16);
     b = (r >> 12) - 8;
     b += r > correction[b];
     l = (l << 3) + b;
     return nbits - l;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-int32_t ec_read_byte() { return s_ec.offs < s_ec.storage ? s_ec.buf[s_ec.offs++] : 0; }
+int32_t CeltDecoder::ec_read_byte() { return m_ec.offs < m_ec.storage ? m_ec.buf[m_ec.offs++] : 0; }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-int32_t ec_read_byte_from_end() {
-    return s_ec.end_offs < s_ec.storage ? s_ec.buf[s_ec.storage - ++(s_ec.end_offs)] : 0;
+int32_t CeltDecoder::ec_read_byte_from_end() {
+    return m_ec.end_offs < m_ec.storage ? m_ec.buf[m_ec.storage - ++(m_ec.end_offs)] : 0;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 /*Normalizes the contents of val and rng so that rng lies entirely in the high-order symbol.*/
-void ec_dec_normalize() {
+void CeltDecoder::ec_dec_normalize() {
     /*If the range is too small, rescale it and input some bits.*/
-    while (s_ec.rng <= EC_CODE_BOT) {
+    while (m_ec.rng <= EC_CODE_BOT) {
         int32_t sym;
-        s_ec.nbits_total += EC_SYM_BITS;
-        s_ec.rng <<= EC_SYM_BITS;
+        m_ec.nbits_total += EC_SYM_BITS;
+        m_ec.rng <<= EC_SYM_BITS;
         /*Use up the remaining bits from our last symbol.*/
-        sym = s_ec.rem;
+        sym = m_ec.rem;
         /*Read the next value from the input.*/
-        s_ec.rem = ec_read_byte();
+        m_ec.rem = ec_read_byte();
         /*Take the rest of the bits we need from this new symbol.*/
-        sym = (sym << EC_SYM_BITS | s_ec.rem) >> (EC_SYM_BITS - EC_CODE_EXTRA);
+        sym = (sym << EC_SYM_BITS | m_ec.rem) >> (EC_SYM_BITS - EC_CODE_EXTRA);
         /*And subtract them from val, capped to be less than EC_CODE_TOP.*/
-        s_ec.val = ((s_ec.val << EC_SYM_BITS) + (EC_SYM_MAX & ~sym)) & (EC_CODE_TOP - 1);
+        m_ec.val = ((m_ec.val << EC_SYM_BITS) + (EC_SYM_MAX & ~sym)) & (EC_CODE_TOP - 1);
     }
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void ec_dec_init(uint8_t *_buf, uint32_t _storage) {
+void CeltDecoder::ec_dec_init(uint8_t *_buf, uint32_t _storage) {
 
-    s_ec.buf = _buf;
-    s_ec.storage = _storage;
-    s_ec.end_offs = 0;
-    s_ec.end_window = 0;
-    s_ec.nend_bits = 0;
-    s_ec.nbits_total = EC_CODE_BITS + 1 - ((EC_CODE_BITS - EC_CODE_EXTRA) / EC_SYM_BITS) * EC_SYM_BITS;
-    s_ec.offs = 0;
-    s_ec.rng = 1U << EC_CODE_EXTRA;
-    s_ec.rem = ec_read_byte();
-    s_ec.val = s_ec.rng - 1 - (s_ec.rem >> (EC_SYM_BITS - EC_CODE_EXTRA));
-    s_ec.error = 0;
+    m_ec.buf = _buf;
+    m_ec.storage = _storage;
+    m_ec.end_offs = 0;
+    m_ec.end_window = 0;
+    m_ec.nend_bits = 0;
+    m_ec.nbits_total = EC_CODE_BITS + 1 - ((EC_CODE_BITS - EC_CODE_EXTRA) / EC_SYM_BITS) * EC_SYM_BITS;
+    m_ec.offs = 0;
+    m_ec.rng = 1U << EC_CODE_EXTRA;
+    m_ec.rem = ec_read_byte();
+    m_ec.val = m_ec.rng - 1 - (m_ec.rem >> (EC_SYM_BITS - EC_CODE_EXTRA));
+    m_ec.error = 0;
     /*Normalize the interval.*/
     ec_dec_normalize();
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-uint32_t ec_decode(uint32_t _ft) {
+uint32_t CeltDecoder::ec_decode(uint32_t _ft) {
     uint32_t s;
-    s_ec.ext = celt_udiv(s_ec.rng, _ft);
-    s = (uint32_t)(s_ec.val / s_ec.ext);
+    m_ec.ext = celt_udiv(m_ec.rng, _ft);
+    s = (uint32_t)(m_ec.val / m_ec.ext);
     return _ft - EC_MINI(s + 1, _ft);
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-uint32_t ec_decode_bin(uint32_t _bits) {
+uint32_t CeltDecoder::ec_decode_bin(uint32_t _bits) {
     uint32_t s;
-    s_ec.ext = s_ec.rng >> _bits;
-    s = (uint32_t)(s_ec.val / s_ec.ext);
+    m_ec.ext = m_ec.rng >> _bits;
+    s = (uint32_t)(m_ec.val / m_ec.ext);
     return (1U << _bits) - EC_MINI(s + 1U, 1U << _bits);
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void ec_dec_update(uint32_t _fl, uint32_t _fh, uint32_t _ft) {
+void CeltDecoder::ec_dec_update(uint32_t _fl, uint32_t _fh, uint32_t _ft) {
     uint32_t s;
-    s = s_ec.ext *  (_ft - _fh);
-    s_ec.val -= s;
+    s = m_ec.ext *  (_ft - _fh);
+    m_ec.val -= s;
 
     if(_fl > 0){
-        s_ec.rng = s_ec.ext * (_fh - _fl);
+        m_ec.rng = m_ec.ext * (_fh - _fl);
     }
     else{
-        s_ec.rng = s_ec.rng - s;
+        m_ec.rng = m_ec.rng - s;
     }
     ec_dec_normalize();
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 /*The probability of having a "one" is 1/(1<<_logp).*/
-int32_t ec_dec_bit_logp( uint32_t _logp) {
+int32_t CeltDecoder::ec_dec_bit_logp( uint32_t _logp) {
     uint32_t r;
     uint32_t d;
     uint32_t s;
     int32_t ret;
-    r = s_ec.rng;
-    d = s_ec.val;
+    r = m_ec.rng;
+    d = m_ec.val;
     s = r >> _logp;
     ret = d < s;
-    if (!ret) s_ec.val = d - s;
-    s_ec.rng = ret ? s : r - s;
+    if (!ret) m_ec.val = d - s;
+    m_ec.rng = ret ? s : r - s;
     ec_dec_normalize();
     return ret;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-int32_t ec_dec_icdf(const uint8_t *_icdf, uint32_t _ftb) {
+int32_t CeltDecoder::ec_dec_icdf(const uint8_t *_icdf, uint32_t _ftb) {
     uint32_t r;
     uint32_t d;
     uint32_t s;
     uint32_t t;
     int32_t ret;
-    s = s_ec.rng;
-    d = s_ec.val;
+    s = m_ec.rng;
+    d = m_ec.val;
     r = s >> _ftb;
     ret = -1;
     do {
         t = s;
         s = r * _icdf[++ret];
     } while (d < s);
-    s_ec.val = d - s;
-    s_ec.rng = t - s;
+    m_ec.val = d - s;
+    m_ec.rng = t - s;
     ec_dec_normalize();
     return ret;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-uint32_t ec_dec_uint(uint32_t _ft) {
+uint32_t CeltDecoder::ec_dec_uint(uint32_t _ft) {
     uint32_t ft;
     uint32_t s;
     int32_t ftb;
@@ -2755,7 +2777,7 @@ uint32_t ec_dec_uint(uint32_t _ft) {
         ec_dec_update(s, s + 1, ft);
         t = (uint32_t)s << ftb | ec_dec_bits(ftb);
         if (t <= _ft) return t;
-        s_ec.error = 1;
+        m_ec.error = 1;
         return _ft;
     } else {
         _ft++;
@@ -2765,12 +2787,12 @@ uint32_t ec_dec_uint(uint32_t _ft) {
     }
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-uint32_t ec_dec_bits(uint32_t _bits) {
+uint32_t CeltDecoder::ec_dec_bits(uint32_t _bits) {
     uint32_t window;
     int32_t available;
     uint32_t ret;
-    window = s_ec.end_window;
-    available = s_ec.nend_bits;
+    window = m_ec.end_window;
+    available = m_ec.nend_bits;
     if ((uint32_t)available < _bits) {
         do {
             window |= (uint32_t)ec_read_byte_from_end() << available;
@@ -2780,13 +2802,13 @@ uint32_t ec_dec_bits(uint32_t _bits) {
     ret = (uint32_t)window & (((uint32_t)1 << _bits) - 1U);
     window >>= _bits;
     available -= _bits;
-    s_ec.end_window = window;
-    s_ec.nend_bits = available;
-    s_ec.nbits_total += _bits;
+    m_ec.end_window = window;
+    m_ec.nend_bits = available;
+    m_ec.nbits_total += _bits;
     return ret;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void kf_bfly2(kiss_fft_cpx *Fout, int32_t m, int32_t N) {
+void CeltDecoder::kf_bfly2(kiss_fft_cpx *Fout, int32_t m, int32_t N) {
     kiss_fft_cpx *Fout2;
     int32_t i;
     (void)m;
@@ -2822,7 +2844,7 @@ void kf_bfly2(kiss_fft_cpx *Fout, int32_t m, int32_t N) {
     }
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void kf_bfly4(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *tw, int32_t m, int32_t N, int32_t mm) {
+void CeltDecoder::kf_bfly4(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *tw, int32_t m, int32_t N, int32_t mm) {
     int32_t i;
 
     if (m == 1) {
@@ -2879,7 +2901,7 @@ void kf_bfly4(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *tw
     }
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void kf_bfly3(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *tw, int32_t m, int32_t N, int32_t mm) {
+void CeltDecoder::kf_bfly3(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *tw, int32_t m, int32_t N, int32_t mm) {
     int32_t i;
     size_t k;
     const size_t m2 = 2 * m;
@@ -2922,7 +2944,7 @@ void kf_bfly3(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *tw
     }
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void kf_bfly5(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *tff, int32_t m, int32_t N, int32_t mm) {
+void CeltDecoder::kf_bfly5(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *tff, int32_t m, int32_t N, int32_t mm) {
     kiss_fft_cpx *Fout0, *Fout1, *Fout2, *Fout3, *Fout4;
     int32_t i, u;
     kiss_fft_cpx scratch[13];
@@ -2989,7 +3011,7 @@ void kf_bfly5(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *tf
     }
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void opus_fft_impl(const kiss_fft_state *tff, kiss_fft_cpx *fout) {
+void CeltDecoder::opus_fft_impl(const kiss_fft_state *tff, kiss_fft_cpx *fout) {
     int32_t m2, m;
     int32_t p;
     int32_t L;
@@ -2997,7 +3019,7 @@ void opus_fft_impl(const kiss_fft_state *tff, kiss_fft_cpx *fout) {
     int32_t i;
     int32_t shift;
 
-    /* s_celtDec->shift can be -1 */
+    /* m_celtDec->shift can be -1 */
     shift = tff->shift > 0 ? tff->shift : 0;
 
     fstride[0] = 1;
@@ -3033,13 +3055,13 @@ void opus_fft_impl(const kiss_fft_state *tff, kiss_fft_cpx *fout) {
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 /* When called, decay is positive and at most 11456. */
-uint32_t ec_laplace_get_freq1(uint32_t fs0, int32_t decay) {
+uint32_t CeltDecoder::ec_laplace_get_freq1(uint32_t fs0, int32_t decay) {
     uint32_t ft;
     ft = 32768 - LAPLACE_MINP * (2 * LAPLACE_NMIN) - fs0;
     return ft * (int32_t)(16384 - decay) >> 15;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-int32_t ec_laplace_decode(uint32_t fs, int32_t decay) {
+int32_t CeltDecoder::ec_laplace_decode(uint32_t fs, int32_t decay) {
     int32_t val = 0;
     uint32_t fl;
     uint32_t fm;
@@ -3078,7 +3100,7 @@ int32_t ec_laplace_decode(uint32_t fs, int32_t decay) {
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 /*Compute floor(sqrt(_val)) with exact arithmetic. _val must be greater than 0. This has been tested on all possible 32-bit inputs greater than 0.*/
-uint32_t isqrt32(uint32_t _val) {
+uint32_t CeltDecoder::isqrt32(uint32_t _val) {
     uint32_t b;
     uint32_t g;
     int32_t bshift;
@@ -3101,7 +3123,7 @@ uint32_t isqrt32(uint32_t _val) {
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 /** Reciprocal sqrt approximation in the range [0.25,1) (Q16 in, Q14 out) */
-int16_t celt_rsqrt_norm(int32_t x) {
+int16_t CeltDecoder::celt_rsqrt_norm(int32_t x) {
     int16_t n;
     int16_t r;
     int16_t r2;
@@ -3123,7 +3145,7 @@ int16_t celt_rsqrt_norm(int32_t x) {
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 /** Sqrt approximation (QX input, QX/2 output) */
-int32_t celt_sqrt(int32_t x) {
+int32_t CeltDecoder::celt_sqrt(int32_t x) {
     int32_t k;
     int16_t n;
     int32_t rt;
@@ -3153,7 +3175,7 @@ inline int16_t _celt_cos_pi_2(int16_t x) {
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-int16_t celt_cos_norm(int32_t x) {
+int16_t CeltDecoder::celt_cos_norm(int32_t x) {
     x = x & 0x0001ffff;
     if (x > SHL32(EXTEND32(1), 16)) x = SUB32(SHL32(EXTEND32(1), 17), x);
     if (x & 0x00007fff) {
@@ -3196,7 +3218,7 @@ int32_t celt_rcp(int32_t x) {
     return VSHR32(EXTEND32(r), i - 16);
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void clt_mdct_backward(int32_t *in, int32_t * out, int32_t overlap, int32_t shift, int32_t stride) {
+void CeltDecoder::clt_mdct_backward(int32_t *in, int32_t * out, int32_t overlap, int32_t shift, int32_t stride) {
     int32_t i;
     int32_t N, N2, N4;
     const int16_t *trig;
@@ -3290,7 +3312,7 @@ void clt_mdct_backward(int32_t *in, int32_t * out, int32_t overlap, int32_t shif
     }
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-int32_t interp_bits2pulses( int32_t start, int32_t end, int32_t skip_start, const int32_t *bits1, const int32_t *bits2, const int32_t *thresh, const int32_t *cap, int32_t total, int32_t *_balance,
+int32_t CeltDecoder::interp_bits2pulses( int32_t start, int32_t end, int32_t skip_start, const int32_t *bits1, const int32_t *bits2, const int32_t *thresh, const int32_t *cap, int32_t total, int32_t *_balance,
                             int32_t skip_rsv, int32_t *intensity, int32_t intensity_rsv, int32_t *dual_stereo, int32_t dual_stereo_rsv, int32_t *bits, int32_t *ebits, int32_t *fine_priority,
                             int32_t C, int32_t LM, int32_t encode, int32_t prev, int32_t signalBandwidth) {
     int32_t psum;
@@ -3515,7 +3537,7 @@ int32_t interp_bits2pulses( int32_t start, int32_t end, int32_t skip_start, cons
     return codedBands;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-int32_t clt_compute_allocation(int32_t start, int32_t end, const int32_t *offsets, const int32_t *cap, int32_t alloc_trim, int32_t *intensity, int32_t *dual_stereo, int32_t total, int32_t *balance,
+int32_t CeltDecoder::clt_compute_allocation(int32_t start, int32_t end, const int32_t *offsets, const int32_t *cap, int32_t alloc_trim, int32_t *intensity, int32_t *dual_stereo, int32_t total, int32_t *balance,
                                int32_t *pulses, int32_t *ebits, int32_t *fine_priority, int32_t C, int32_t LM, int32_t encode, int32_t prev, int32_t signalBandwidth) {
     int32_t lo, hi, len, j;
     int32_t codedBands;
@@ -3542,10 +3564,10 @@ int32_t clt_compute_allocation(int32_t start, int32_t end, const int32_t *offset
             total -= dual_stereo_rsv;
         }
     }
-    auto bits1       = celt_malloc_arr<int32_t>(len * sizeof(int32_t));
-    auto bits2       = celt_malloc_arr<int32_t>(len * sizeof(int32_t));
-    auto thresh      = celt_malloc_arr<int32_t>(len * sizeof(int32_t));
-    auto trim_offset = celt_malloc_arr<int32_t>(len * sizeof(int32_t));
+    auto bits1       = celt_scratch_arr<int32_t>(len);
+    auto bits2       = celt_scratch_arr<int32_t>(len);
+    auto thresh      = celt_scratch_arr<int32_t>(len);
+    auto trim_offset = celt_scratch_arr<int32_t>(len);
 
     for (j = start; j < end; j++) {
         /* Below this threshold, we're sure not to allocate any PVQ bits */
@@ -3605,7 +3627,7 @@ int32_t clt_compute_allocation(int32_t start, int32_t end, const int32_t *offset
     return codedBands;
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void unquant_coarse_energy(int32_t start, int32_t end, int16_t *oldEBands, int32_t intra, int32_t C, int32_t LM) {
+void CeltDecoder::unquant_coarse_energy(int32_t start, int32_t end, int16_t *oldEBands, int32_t intra, int32_t C, int32_t LM) {
     const uint8_t *prob_model = e_prob_model[LM][intra];
     int32_t i, c;
     int32_t prev[2] = {0, 0};
@@ -3622,7 +3644,7 @@ void unquant_coarse_energy(int32_t start, int32_t end, int16_t *oldEBands, int32
         coef = pred_coef[LM];
     }
 
-    budget = s_ec.storage * 8;
+    budget = m_ec.storage * 8;
 
     /* Decode at a fixed coarse resolution */
     for (i = start; i < end; i++) {
@@ -3656,7 +3678,7 @@ void unquant_coarse_energy(int32_t start, int32_t end, int16_t *oldEBands, int32
     }
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void unquant_fine_energy(int32_t start, int32_t end, int16_t *oldEBands, int32_t *fine_quant, int32_t C) {
+void CeltDecoder::unquant_fine_energy(int32_t start, int32_t end, int16_t *oldEBands, int32_t *fine_quant, int32_t C) {
     int32_t i, c;
     /* Decode finer resolution */
     for (i = start; i < end; i++) {
@@ -3673,7 +3695,7 @@ void unquant_fine_energy(int32_t start, int32_t end, int16_t *oldEBands, int32_t
     }
 }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-void unquant_energy_finalise(int32_t start, int32_t end, int16_t *oldEBands, int32_t *fine_quant,
+void CeltDecoder::unquant_energy_finalise(int32_t start, int32_t end, int16_t *oldEBands, int32_t *fine_quant,
                              int32_t *fine_priority, int32_t bits_left, int32_t C) {
     int32_t i, prio, c;
 
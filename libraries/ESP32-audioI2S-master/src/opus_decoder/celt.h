@@ -36,6 +36,7 @@
 
 #include "Arduino.h"
 #include <memory>
+#include "../psram_unique_ptr.hpp"
 
 #define OPUS_OK                0
 #define OPUS_BAD_ARG          -1
@@ -394,7 +395,6 @@ int32_t celt_rcp(int32_t x);
 extern const signed char tf_select_table[4][8];
 extern const uint32_t SMALL_DIV_TABLE[129];
 extern const uint8_t LOG2_FRAC_TABLE[24];
-extern ec_ctx_t s_ec;
 
 /* Prototypes and inlines*/
 
@@ -417,10 +417,6 @@ static inline int16_t sig2word16(int32_t x){
    return EXTRACT16(x);
 }
 
-static inline int32_t ec_tell(){
-  return s_ec.nbits_total-EC_ILOG(s_ec.rng);
-}
-
 /* Atan approximation using a 4th order polynomial. Input is in Q15 format and normalized by pi/4. Output is in
    Q15 format */
 static inline int16_t celt_atan01(int16_t x) {
@@ -579,16 +575,6 @@ struct Celt_PsramDeleter { // PSRAM deleter for Unique_PTR
 };
 template<typename T>
 using celt_ptr_arr = std::unique_ptr<T[], Celt_PsramDeleter>;
-//——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
-    // Request memory for an array of T
-    template <typename T>
-    std::unique_ptr<T[], Celt_PsramDeleter> celt_malloc_arr(std::size_t count) {
-        T* raw = static_cast<T*>(ps_malloc(sizeof(T) * count));
-        if (!raw) {
-            log_e("silk_malloc_array: OOM, no space for %zu bytes", sizeof(T) * count);
-        }
-        return std::unique_ptr<T[], Celt_PsramDeleter>(raw);
-    }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 template <typename T>
 class celt_raw_ptr {
@@ -659,99 +645,113 @@ public:
 };
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 
-bool CELTDecoder_AllocateBuffers(void);
-void CELTDecoder_ClearBuffer(void);
-void CELTDecoder_FreeBuffers();
-void exp_rotation1(int16_t *X, int32_t len, int32_t stride, int16_t c, int16_t s);
-void exp_rotation(int16_t *X, int32_t len, int32_t dir, int32_t stride, int32_t K, int32_t spread);
-void normalise_residual(int32_t * iy, int16_t * X, int32_t N, int32_t Ryy, int16_t gain);
-uint32_t extract_collapse_mask(int32_t *iy, int32_t N, int32_t B);
-uint32_t alg_unquant(int16_t *X, int32_t N, int32_t K, int32_t spread, int32_t B, int16_t gain);
-void renormalise_vector(int16_t *X, int32_t N, int16_t gain);
-int32_t resampling_factor(int32_t rate);
-void comb_filter_const_c(int32_t *y, int32_t *x, int32_t T, int32_t N, int16_t g10, int16_t g11, int16_t g12);
-void comb_filter(int32_t *y, int32_t *x, int32_t T0, int32_t T1, int32_t N, int16_t g0, int16_t g1, int32_t tapset0, int32_t tapset1);
-void init_caps(int32_t *cap, int32_t LM, int32_t C);
-uint32_t celt_lcg_rand(uint32_t seed);
-int16_t bitexact_cos(int16_t x);
-int32_t bitexact_log2tan(int32_t isin, int32_t icos);
-void denormalise_bands(const int16_t * X, int32_t * freq,
-                       const int16_t *bandLogE, int32_t start, int32_t end, int32_t M, int32_t downsample, int32_t silence);
-void anti_collapse(int16_t *X_, uint8_t *collapse_masks, int32_t LM, int32_t C, int32_t size, int32_t start,
-                   int32_t end, const int16_t *logE, const int16_t *prev1logE, const int16_t *prev2logE, const int32_t *pulses, uint32_t seed);
-void compute_channel_weights(int32_t Ex, int32_t Ey, int16_t w[2]);
-void stereo_split(int16_t * X, int16_t * Y, int32_t N);
-void stereo_merge(int16_t * X, int16_t * Y, int16_t mid, int32_t N);
-void deinterleave_hadamard(int16_t *X, int32_t N0, int32_t stride, int32_t hadamard);
-void interleave_hadamard(int16_t *X, int32_t N0, int32_t stride, int32_t hadamard);
-void haar1(int16_t *X, int32_t N0, int32_t stride);
-int32_t compute_qn(int32_t N, int32_t b, int32_t offset, int32_t pulse_cap, int32_t stereo);
-void compute_theta(struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, int32_t *b, int32_t B,
-                   int32_t __B0, int32_t LM, int32_t stereo, int32_t *fill);
-uint32_t quant_band_n1( int16_t *X, int16_t *Y, int32_t b, int16_t *lowband_out);
-uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM,
-                         int16_t gain, int32_t fill);
-uint32_t quant_band(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM,
-                    int16_t *lowband_out, int16_t gain, int16_t *lowband_scratch, int32_t fill);
-uint32_t quant_band_stereo(int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t B, int16_t *lowband,
-                           int32_t LM, int16_t *lowband_out, int16_t *lowband_scratch, int32_t fill);
-void special_hybrid_folding(int16_t *norm, int16_t *norm2, int32_t start, int32_t M, int32_t dual_stereo);
-void quant_all_bands(int32_t start, int32_t end, int16_t *X_, int16_t *Y_,
-                     uint8_t *collapse_masks, const int32_t *bandE, int32_t *pulses, int32_t shortBlocks, int32_t spread,
-                     int32_t dual_stereo, int32_t intensity, int32_t *tf_res, int32_t total_bits, int32_t balance,
-                     int32_t LM, int32_t codedBands, uint32_t *seed, int32_t complexity, int32_t disable_inv);
-int32_t celt_decoder_get_size(int32_t channels);
-int32_t celt_decoder_init(int32_t channels);
-void deemphasis_stereo_simple(int32_t *in[], int16_t *pcm, int32_t N, const int16_t coef0, int32_t *mem);
-void deemphasis(int32_t *in[], int16_t *pcm, int32_t N, int32_t C, int32_t downsample, const int16_t *coef,
-                int32_t *mem, int32_t accum);
-void celt_synthesis(int16_t *X, int32_t *out_syn[], int16_t *oldBandE, int32_t start,
-                    int32_t effEnd, int32_t C, int32_t CC, int32_t isTransient, int32_t LM, int32_t downsample, int32_t silence);
-void tf_decode(int32_t start, int32_t end, int32_t isTransient, int32_t *tf_res, int32_t LM);
-int32_t celt_decode_with_ec(int16_t * pcm, int32_t frame_size);
-int32_t celt_decoder_ctl(int32_t request, ...);
-int32_t cwrsi(int32_t _n, int32_t _k, uint32_t _i, int32_t *_y);
-int32_t decode_pulses(int32_t *_y, int32_t _n, int32_t _k);
-uint32_t ec_tell_frac();
-int32_t ec_read_byte();
-int32_t ec_read_byte_from_end();
-void ec_dec_normalize();
-void ec_dec_init(uint8_t *_buf, uint32_t _storage);
-uint32_t ec_decode(uint32_t _ft);
-uint32_t ec_decode_bin(uint32_t _bits);
-void ec_dec_update(uint32_t _fl, uint32_t _fh, uint32_t _ft);
-int32_t ec_dec_bit_logp(uint32_t _logp);
-int32_t ec_dec_icdf(const uint8_t *_icdf, uint32_t _ftb);
-uint32_t ec_dec_uint(uint32_t _ft);
-uint32_t ec_dec_bits(uint32_t _bits);
-void kf_bfly2(kiss_fft_cpx *Fout, int32_t m, int32_t N);
-void kf_bfly4(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *st, int32_t m, int32_t N, int32_t mm);
-void kf_bfly3(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *st, int32_t m, int32_t N, int32_t mm);
-void kf_bfly5(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *st, int32_t m, int32_t N, int32_t mm);
-void opus_fft_impl(const kiss_fft_state *st, kiss_fft_cpx *fout);
-uint32_t ec_laplace_get_freq1(uint32_t fs0, int32_t decay);
-int32_t ec_laplace_decode(uint32_t fs, int32_t decay);
-uint32_t isqrt32(uint32_t _val);
-int16_t celt_rsqrt_norm(int32_t x);
-int32_t celt_sqrt(int32_t x);
-int16_t celt_cos_norm(int32_t x);
-int32_t celt_rcp(int32_t x);
-void     clt_mdct_backward(int32_t *in, int32_t *out, int32_t overlap, int32_t shift, int32_t stride);
-void exp_rotation1(int16_t *X, int32_t len, int32_t stride, int16_t c, int16_t s);
-void exp_rotation(int16_t *X, int32_t len, int32_t dir, int32_t stride, int32_t K, int32_t spread);
-void normalise_residual(int32_t * iy, int16_t * X, int32_t N, int32_t Ryy, int16_t gain);
-uint32_t extract_collapse_mask(int32_t *iy, int32_t N, int32_t B);
-void renormalise_vector(int16_t *X, int32_t N, int16_t gain);
-int32_t interp_bits2pulses(int32_t start, int32_t end, int32_t skip_start, const int32_t *bits1, const int32_t *bits2,
-                       const int32_t *thresh, const int32_t *cap, int32_t total, int32_t *_balance, int32_t skip_rsv,
-                       int32_t *intensity, int32_t intensity_rsv, int32_t *dual_stereo, int32_t dual_stereo_rsv, int32_t *bits,
-                       int32_t *ebits, int32_t *fine_priority, int32_t C, int32_t LM, int32_t encode, int32_t prev,
-                       int32_t signalBandwidth);
-int32_t clt_compute_allocation(int32_t start, int32_t end, const int32_t *offsets, const int32_t *cap, int32_t alloc_trim,
-                           int32_t *intensity, int32_t *dual_stereo, int32_t total, int32_t *balance, int32_t *pulses, int32_t *ebits,
-                           int32_t *fine_priority, int32_t C, int32_t LM, int32_t encode, int32_t prev, int32_t signalBandwidth);
-void unquant_coarse_energy(int32_t start, int32_t end, int16_t *oldEBands, int32_t intra, int32_t C,
-                           int32_t LM);
-void unquant_fine_energy(int32_t start, int32_t end, int16_t *oldEBands, int32_t *fine_quant, int32_t C);
-void unquant_energy_finalise(int32_t start, int32_t end, int16_t *oldEBands, int32_t *fine_quant,
-                             int32_t *fine_priority, int32_t bits_left, int32_t C);
+// CELT layer of the OPUS decoder, owned by OPUSDecoder. The range decoder (m_ec) is shared with the SILK layer of
+// the same stream.
+class CeltDecoder {
+public:
+    bool allocateBuffers();
+    void clearBuffers();
+    void freeBuffers();
+    int32_t celt_decoder_init(int32_t channels);
+    int32_t celt_decoder_ctl(int32_t request, ...);
+    int32_t celt_decode_with_ec(int16_t * pcm, int32_t frame_size);
+    void ec_dec_init(uint8_t *_buf, uint32_t _storage);
+    int32_t ec_dec_bit_logp(uint32_t _logp);
+    int32_t ec_dec_icdf(const uint8_t *_icdf, uint32_t _ftb);
+    int32_t ec_tell() { return m_ec.nbits_total - EC_ILOG(m_ec.rng); }
+
+private:
+    void exp_rotation1(int16_t *X, int32_t len, int32_t stride, int16_t c, int16_t s);
+    void exp_rotation(int16_t *X, int32_t len, int32_t dir, int32_t stride, int32_t K, int32_t spread);
+    void normalise_residual(int32_t * iy, int16_t * X, int32_t N, int32_t Ryy, int16_t gain);
+    uint32_t extract_collapse_mask(int32_t *iy, int32_t N, int32_t B);
+    uint32_t alg_unquant(int16_t *X, int32_t N, int32_t K, int32_t spread, int32_t B, int16_t gain);
+    void renormalise_vector(int16_t *X, int32_t N, int16_t gain);
+    int32_t resampling_factor(int32_t rate);
+    void comb_filter_const_c(int32_t *y, int32_t *x, int32_t T, int32_t N, int16_t g10, int16_t g11, int16_t g12);
+    void comb_filter(int32_t *y, int32_t *x, int32_t T0, int32_t T1, int32_t N, int16_t g0, int16_t g1, int32_t tapset0, int32_t tapset1);
+    void init_caps(int32_t *cap, int32_t LM, int32_t C);
+    uint32_t celt_lcg_rand(uint32_t seed);
+    int16_t bitexact_cos(int16_t x);
+    int32_t bitexact_log2tan(int32_t isin, int32_t icos);
+    void denormalise_bands(const int16_t * X, int32_t * freq,
+                           const int16_t *bandLogE, int32_t start, int32_t end, int32_t M, int32_t downsample, int32_t silence);
+    void anti_collapse(int16_t *X_, uint8_t *collapse_masks, int32_t LM, int32_t C, int32_t size, int32_t start,
+                       int32_t end, const int16_t *logE, const int16_t *prev1logE, const int16_t *prev2logE, const int32_t *pulses, uint32_t seed);
+    void compute_channel_weights(int32_t Ex, int32_t Ey, int16_t w[2]);
+    void stereo_split(int16_t * X, int16_t * Y, int32_t N);
+    void stereo_merge(int16_t * X, int16_t * Y, int16_t mid, int32_t N);
+    void deinterleave_hadamard(int16_t *X, int32_t N0, int32_t stride, int32_t hadamard);
+    void interleave_hadamard(int16_t *X, int32_t N0, int32_t stride, int32_t hadamard);
+    void haar1(int16_t *X, int32_t N0, int32_t stride);
+    int32_t compute_qn(int32_t N, int32_t b, int32_t offset, int32_t pulse_cap, int32_t stereo);
+    void compute_theta(struct split_ctx *sctx, int16_t *X, int16_t *Y, int32_t N, int32_t *b, int32_t B,
+                       int32_t __B0, int32_t LM, int32_t stereo, int32_t *fill);
+    uint32_t quant_band_n1( int16_t *X, int16_t *Y, int32_t b, int16_t *lowband_out);
+    uint32_t quant_partition(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM,
+                             int16_t gain, int32_t fill);
+    uint32_t quant_band(int16_t *X, int32_t N, int32_t b, int32_t B, int16_t *lowband, int32_t LM,
+                        int16_t *lowband_out, int16_t gain, int16_t *lowband_scratch, int32_t fill);
+    uint32_t quant_band_stereo(int16_t *X, int16_t *Y, int32_t N, int32_t b, int32_t B, int16_t *lowband,
+                               int32_t LM, int16_t *lowband_out, int16_t *lowband_scratch, int32_t fill);
+    void special_hybrid_folding(int16_t *norm, int16_t *norm2, int32_t start, int32_t M, int32_t dual_stereo);
+    void quant_all_bands(int32_t start, int32_t end, int16_t *X_, int16_t *Y_,
+                         uint8_t *collapse_masks, const int32_t *bandE, int32_t *pulses, int32_t shortBlocks, int32_t spread,
+                         int32_t dual_stereo, int32_t intensity, int32_t *tf_res, int32_t total_bits, int32_t balance,
+                         int32_t LM, int32_t codedBands, uint32_t *seed, int32_t complexity, int32_t disable_inv);
+    int32_t celt_decoder_get_size(int32_t channels);
+    void deemphasis_stereo_simple(int32_t *in[], int16_t *pcm, int32_t N, const int16_t coef0, int32_t *mem);
+    void deemphasis(int32_t *in[], int16_t *pcm, int32_t N, int32_t C, int32_t downsample, const int16_t *coef,
+                    int32_t *mem, int32_t accum);
+    void celt_synthesis(int16_t *X, int32_t *out_syn[], int16_t *oldBandE, int32_t start,
+                        int32_t effEnd, int32_t C, int32_t CC, int32_t isTransient, int32_t LM, int32_t downsample, int32_t silence);
+    void tf_decode(int32_t start, int32_t end, int32_t isTransient, int32_t *tf_res, int32_t LM);
+    int32_t cwrsi(int32_t _n, int32_t _k, uint32_t _i, int32_t *_y);
+    int32_t decode_pulses(int32_t *_y, int32_t _n, int32_t _k);
+    uint32_t ec_tell_frac();
+    int32_t ec_read_byte();
+    int32_t ec_read_byte_from_end();
+    void ec_dec_normalize();
+    uint32_t ec_decode(uint32_t _ft);
+    uint32_t ec_decode_bin(uint32_t _bits);
+    void ec_dec_update(uint32_t _fl, uint32_t _fh, uint32_t _ft);
+    uint32_t ec_dec_uint(uint32_t _ft);
+    uint32_t ec_dec_bits(uint32_t _bits);
+    void kf_bfly2(kiss_fft_cpx *Fout, int32_t m, int32_t N);
+    void kf_bfly4(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *st, int32_t m, int32_t N, int32_t mm);
+    void kf_bfly3(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *st, int32_t m, int32_t N, int32_t mm);
+    void kf_bfly5(kiss_fft_cpx *Fout, const size_t fstride, const kiss_fft_state *st, int32_t m, int32_t N, int32_t mm);
+    void opus_fft_impl(const kiss_fft_state *st, kiss_fft_cpx *fout);
+    uint32_t ec_laplace_get_freq1(uint32_t fs0, int32_t decay);
+    int32_t ec_laplace_decode(uint32_t fs, int32_t decay);
+    uint32_t isqrt32(uint32_t _val);
+    int16_t celt_rsqrt_norm(int32_t x);
+    int32_t celt_sqrt(int32_t x);
+    int16_t celt_cos_norm(int32_t x);
+    void     clt_mdct_backward(int32_t *in, int32_t *out, int32_t overlap, int32_t shift, int32_t stride);
+    int32_t interp_bits2pulses(int32_t start, int32_t end, int32_t skip_start, const int32_t *bits1, const int32_t *bits2,
+                           const int32_t *thresh, const int32_t *cap, int32_t total, int32_t *_balance, int32_t skip_rsv,
+                           int32_t *intensity, int32_t intensity_rsv, int32_t *dual_stereo, int32_t dual_stereo_rsv, int32_t *bits,
+                           int32_t *ebits, int32_t *fine_priority, int32_t C, int32_t LM, int32_t encode, int32_t prev,
+                           int32_t signalBandwidth);
+    int32_t clt_compute_allocation(int32_t start, int32_t end, const int32_t *offsets, const int32_t *cap, int32_t alloc_trim,
+                               int32_t *intensity, int32_t *dual_stereo, int32_t total, int32_t *balance, int32_t *pulses, int32_t *ebits,
+                               int32_t *fine_priority, int32_t C, int32_t LM, int32_t encode, int32_t prev, int32_t signalBandwidth);
+    void unquant_coarse_energy(int32_t start, int32_t end, int16_t *oldEBands, int32_t intra, int32_t C,
+                               int32_t LM);
+    void unquant_fine_energy(int32_t start, int32_t end, int16_t *oldEBands, int32_t *fine_quant, int32_t C);
+    void unquant_energy_finalise(int32_t start, int32_t end, int16_t *oldEBands, int32_t *fine_quant,
+                                 int32_t *fine_priority, int32_t bits_left, int32_t C);
+
+    // Temporary array of count elements T, taken from m_celtScratch and given back when it goes out of scope
+    template <typename T>
+    ps_scratch::array<T> celt_scratch_arr(std::size_t count) {
+        return m_celtScratch.get<T>(count);
+    }
+
+    celt_raw_ptr<CELTDecoder_t> m_celtDec; // unique pointer
+    ps_scratch     m_celtScratch; // temporary arrays of celt_decode_with_ec()
+    band_ctx_t     m_band_ctx = {};
+    ec_ctx_t       m_ec = {};
+};
+
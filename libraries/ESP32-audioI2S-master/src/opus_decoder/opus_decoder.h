@@ -7,6 +7,8 @@
 #include <string.h>
 #include <vector>
 #include "../psram_unique_ptr.hpp"
+#include "celt.h"
+#include "silk.h"
 
 extern __attribute__((weak)) void audio_info(const char*);
 
@@ -33,36 +35,90 @@ typedef struct _odp3 {
     uint16_t samplesPerFrame;
 } odp3;
 
-bool             OPUSDecoder_AllocateBuffers();
-void             OPUSDecoder_FreeBuffers();
-void             OPUSDecoder_ClearBuffers();
-void             OPUSsetDefaults();
-int32_t          OPUSDecode(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
-int32_t          opusDecodePage0(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength);
-int32_t          opusDecodePage3(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength, int16_t *outbuf);
-int8_t           opus_FramePacking_Code0(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame);
-int8_t           opus_FramePacking_Code1(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount);
-int8_t           opus_FramePacking_Code2(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount);
-int8_t           opus_FramePacking_Code3(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount);
-uint8_t          OPUSGetChannels();
-uint32_t         OPUSGetSampRate();
-uint8_t          OPUSGetBitsPerSample();
-uint32_t         OPUSGetBitRate();
-uint16_t         OPUSGetOutputSamps();
-uint32_t         OPUSGetAudioDataStart();
-const char*      OPUSgetStreamTitle();
-uint16_t         OPUSgetMode();
-std::vector<uint32_t> OPUSgetMetadataBlockPicture();
-int32_t          OPUSFindSyncWord(unsigned char* buf, int32_t nBytes);
-int32_t          OPUSparseOGG(uint8_t* inbuf, int32_t* bytesLeft);
-int32_t          parseOpusHead(uint8_t* inbuf, int32_t nBytes);
-int32_t          parseOpusComment(uint8_t* inbuf, int32_t nBytes);
-int8_t           parseOpusTOC(uint8_t TOC_Byte);
-int32_t          opus_packet_get_samples_per_frame(const uint8_t* data, int32_t Fs);
-
-// some helper functions
-int32_t OPUS_specialIndexOf(uint8_t* base, const char* str, int32_t baselen, bool exact = false);
-
+// Decoder instance, all state of a stream lives in the object. Several instances can decode different streams
+// concurrently (e.g. in tasks on both cores), one instance must not be used by two tasks at the same time.
+class OPUSDecoder {
+public:
+    ~OPUSDecoder() { freeBuffers(); }
+    bool             allocateBuffers();
+    void             freeBuffers();
+    void             clearBuffers();
+    int32_t          findSyncWord(unsigned char* buf, int32_t nBytes);
+    int32_t          decode(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
+    uint8_t          getChannels();
+    uint32_t         getSampRate();
+    uint8_t          getBitsPerSample();
+    uint32_t         getBitRate();
+    uint16_t         getOutputSamps();
+    uint32_t         getAudioDataStart();
+    const char*      getStreamTitle();
+    uint16_t         getMode();
+    std::vector<uint32_t> getMetadataBlockPicture();
+
+private:
+    void             OPUSsetDefaults();
+    int32_t          opusDecodePage0(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength);
+    int32_t          opusDecodePage3(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength, int16_t *outbuf);
+    int8_t           opus_FramePacking_Code0(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame);
+    int8_t           opus_FramePacking_Code1(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount);
+    int8_t           opus_FramePacking_Code2(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount);
+    int8_t           opus_FramePacking_Code3(uint8_t *inbuf, int32_t *bytesLeft, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame, uint8_t* frameCount);
+    int32_t          OPUSparseOGG(uint8_t* inbuf, int32_t* bytesLeft);
+    int32_t          parseOpusHead(uint8_t* inbuf, int32_t nBytes);
+    int32_t          parseOpusComment(uint8_t* inbuf, int32_t nBytes);
+    int8_t           parseOpusTOC(uint8_t TOC_Byte);
+    int32_t          opus_packet_get_samples_per_frame(const uint8_t* data, int32_t Fs);
+    // some helper functions
+    int32_t          OPUS_specialIndexOf(uint8_t* base, const char* str, int32_t baselen, bool exact = false);
+    int32_t          opus_decode_frame(uint8_t *inbuf, int16_t *outbuf, int32_t packetLen, uint16_t samplesPerFrame);
+
+    CeltDecoder      m_celt;
+    SilkDecoder      m_silk{m_celt}; // decodes from the range decoder of m_celt
+
+    uint8_t          m_opusChannels = 0;
+    uint8_t          m_opusCountCode = 0;
+    uint8_t          m_opusPageNr = 0;
+    uint8_t          m_frameCount = 0;
+    uint8_t          m_opusSegmentTableSize = 0;
+    uint16_t         m_mode = 0;
+    uint16_t         m_opusOggHeaderSize = 0;
+    uint16_t         m_bandWidth = 0;
+    uint16_t         m_internalSampleRate = 0;
+    uint16_t         m_endband = 0;
+    uint32_t         m_opusSamplerate = 0;
+    uint32_t         m_opusSegmentLength = 0;
+    uint32_t         m_opusCurrentFilePos = 0;
+    uint32_t         m_opusAudioDataStart = 0;
+    uint32_t         m_opusBlockPicPos = 0;
+    uint32_t         m_opusBlockLen = 0;
+    bool             m_f_opusParseOgg = false;
+    bool             m_f_newSteamTitle = false;               // streamTitle
+    bool             m_f_opusNewMetadataBlockPicture = false; // new metadata block picture
+    bool             m_f_opusStereoFlag = false;
+    bool             m_f_continuedPage = false;
+    bool             m_f_firstPage = false;
+    bool             m_f_lastPage = false;
+    bool             m_f_nextChunk = false;
+    int8_t           m_opusError = 0;
+    int16_t          m_opusSegmentTableRdPtr = -1;
+    int16_t          m_prev_mode = 0;
+    int32_t          m_opusValidSamples = 0;
+    int32_t          m_opusBlockPicLen = 0;
+    int32_t          m_blockPicLenUntilFrameEnd = 0;
+    int32_t          m_opusRemainBlockPicLen = 0;
+    int32_t          m_opusCommentBlockSize = 0;
+    float            m_opusCompressionRatio = 0;
+
+    ps_ptr<char>     m_streamTitle;
+    ps_ptr<uint16_t> m_opusSegmentTable;
+    ps_ptr<int16_t>  m_opusPcmSilk; // SILK part of a hybrid frame
+
+    ofp2  m_ofp2 = {}; // used in opus_FramePacking_Code2
+    ofp3  m_ofp3 = {}; // used in opus_FramePacking_Code3
+    odp3  m_odp3 = {}; // used in opusDecodePage3
+
+    std::vector <uint32_t>m_opusBlockPicItem;
+};
 
 enum : int8_t { OPUS_END = 120,
                 OPUS_CONTINUE = 10,
@@ -14,25 +14,14 @@ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
 
 #include "Arduino.h"
 #include "silk.h"
+#include "opus_decoder.h"
 
-silk_ptr_arr<silk_resampler_state_struct_t> s_resampler_state;
-silk_ptr_arr<silk_decoder_state_t>          s_channel_state;
-silk_ptr_obj<silk_decoder_t>                s_silk_decoder;
-silk_ptr_obj<silk_decoder_control_t>        s_silk_decoder_control;
-silk_ptr_obj<silk_DecControlStruct_t>       s_silk_DecControlStruct;
-
-uint8_t            s_channelsInternal = 0;
-uint8_t            s_payloadSize_ms = 0;
-uint8_t            s_API_channels = 0;
-uint32_t           s_silk_internalSampleRate = 0;
-uint32_t           s_API_sampleRate = 0;
-uint32_t           s_prevPitchLag = 0;
 
 
 
 /* Coefficients for 2-band filter bank based on first-order allpass filters */
-int16_t A_fb1_20 = 5394 << 1;
-int16_t A_fb1_21 = -24290; /* (int16_t)(20623 << 1) */
+const int16_t A_fb1_20 = 5394 << 1;
+const int16_t A_fb1_21 = -24290; /* (int16_t)(20623 << 1) */
 
 const int16_t HARM_ATT_Q15[NB_ATT] = {32440, 31130};              /* 0.99, 0.95 */
 const int16_t PLC_RAND_ATTENUATE_V_Q15[NB_ATT] = {31130, 26214};  /* 0.95, 0.8 */
@@ -426,33 +415,60 @@ const silk_NLSF_CB_struct silk_NLSF_CB_NB_MB = {
     silk_NLSF_DELTA_MIN_NB_MB_Q15,
 };
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-bool SILKDecoder_AllocateBuffers(){
-    s_resampler_state       = silk_malloc_arr<silk_resampler_state_struct_t>(DECODER_NUM_CHANNELS);
-    s_channel_state         = silk_malloc_arr<silk_decoder_state_t>(DECODER_NUM_CHANNELS);
-    s_silk_decoder          = silk_malloc_obj<silk_decoder_t>();
-    s_silk_decoder_control  = silk_malloc_obj<silk_decoder_control_t>();
-    s_silk_DecControlStruct = silk_malloc_obj<silk_DecControlStruct_t>();
+// Largest amount of temporary arrays in use at the same time in silk_Decode() (stereo, 20ms at 16kHz internal rate):
+// samplesOut1_tmp_storage1 plus either the largest of silk_decode_frame() or the output buffers and the resampler.
+// Each array is rounded up to 8 bytes, as ps_scratch does.
+static size_t silk_scratch_size() {
+    auto a8 = [](size_t bytes) { return (bytes + 7) & ~(size_t)7; };
+    const size_t frame = MAX_FRAME_LENGTH;
+    const size_t ltp = LTP_MEM_LENGTH_MS * MAX_FS_KHZ;
+    const size_t subfr = MAX_SUB_FRAME_LENGTH;
+    const size_t storage = a8(DECODER_NUM_CHANNELS * (frame + 2) * sizeof(int16_t)); // samplesOut1_tmp_storage1/2
+
+    size_t pulses = 2 * a8(MAX_NB_SHELL_BLOCKS * sizeof(int32_t));                                 // silk_decode_pulses()
+    size_t nlsf = 2 * a8(SILK_MAX_ORDER_LPC * sizeof(int32_t)) + 2 * a8((SILK_MAX_ORDER_LPC / 2 + 1) * sizeof(int32_t)); // silk_NLSF2A()
+    size_t core = a8(ltp * sizeof(int16_t)) + a8((ltp + frame) * sizeof(int32_t))
+                + a8(subfr * sizeof(int32_t)) + a8((subfr + MAX_LPC_ORDER) * sizeof(int32_t));  // silk_decode_core()
+    size_t plc = a8((ltp + frame) * sizeof(int32_t)) + a8(ltp * sizeof(int16_t)) + a8(2 * subfr * sizeof(int16_t)); // silk_PLC_conceal()
+    size_t cng = a8((frame + MAX_LPC_ORDER) * sizeof(int32_t));                                    // silk_CNG()
+    size_t decode = max(max(max(pulses, nlsf), max(core, plc)), cng);
+
+    size_t resampler = max(max(a8((2 * MAX_FS_KHZ * RESAMPLER_MAX_BATCH_SIZE_MS + RESAMPLER_ORDER_FIR_12) * sizeof(int16_t)), // IIR_FIR
+                               a8((MAX_FS_KHZ * RESAMPLER_MAX_BATCH_SIZE_MS + RESAMPLER_DOWN_ORDER_FIR2) * sizeof(int32_t))),  // down_FIR
+                           a8((RESAMPLER_MAX_BATCH_SIZE_IN + ORDER_FIR) * sizeof(int32_t)));                                 // down2_3
+    size_t output = a8(MAX_API_FS_KHZ * MAX_FRAME_LENGTH_MS * sizeof(int16_t)) + storage + resampler;     // samplesOut2_tmp, storage2
+    return storage + max(decode, output);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool SilkDecoder::allocateBuffers(){
+    m_resampler_state       = silk_malloc_arr<silk_resampler_state_struct_t>(DECODER_NUM_CHANNELS);
+    m_channel_state         = silk_malloc_arr<silk_decoder_state_t>(DECODER_NUM_CHANNELS);
+    m_silk_decoder          = silk_malloc_obj<silk_decoder_t>();
+    m_silk_decoder_control  = silk_malloc_obj<silk_decoder_control_t>();
+    m_silk_DecControlStruct = silk_malloc_obj<silk_DecControlStruct_t>();
+    m_silkScratch.alloc(silk_scratch_size(), "SILKScratch");
     return true;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void SILKDecoder_ClearBuffers(){
-    memset(s_resampler_state.get(), 0, sizeof(silk_resampler_state_struct_t) * DECODER_NUM_CHANNELS);
-    memset(s_channel_state.get(), 0, sizeof(silk_decoder_state_t) * DECODER_NUM_CHANNELS);
-    memset(s_silk_decoder.get(), 0, sizeof(silk_decoder_t));
-    memset(s_silk_decoder_control.get(), 0, sizeof(silk_decoder_control_t));
-    memset(s_silk_DecControlStruct.get(), 0, sizeof(silk_DecControlStruct_t));
+void SilkDecoder::clearBuffers(){
+    memset(m_resampler_state.get(), 0, sizeof(silk_resampler_state_struct_t) * DECODER_NUM_CHANNELS);
+    memset(m_channel_state.get(), 0, sizeof(silk_decoder_state_t) * DECODER_NUM_CHANNELS);
+    memset(m_silk_decoder.get(), 0, sizeof(silk_decoder_t));
+    memset(m_silk_decoder_control.get(), 0, sizeof(silk_decoder_control_t));
+    memset(m_silk_DecControlStruct.get(), 0, sizeof(silk_DecControlStruct_t));
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void SILKDecoder_FreeBuffers(){
-    s_resampler_state.reset();
-    s_channel_state.reset();
-    s_silk_decoder.reset();
-    s_silk_decoder_control.reset();
-    s_silk_DecControlStruct.reset();
+void SilkDecoder::freeBuffers(){
+    m_resampler_state.reset();
+    m_channel_state.reset();
+    m_silk_decoder.reset();
+    m_silk_decoder_control.reset();
+    m_silk_DecControlStruct.reset();
+    m_silkScratch.reset();
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Split signal into two decimated bands using first-order allpass filters */
-void silk_ana_filt_bank_1(const int16_t* in,   /* I    Input signal [N]        */
+void SilkDecoder::silk_ana_filt_bank_1(const int16_t* in,   /* I    Input signal [N]        */
                           int32_t*       S,    /* I/O  State vector [2]        */
                           int16_t*       outL, /* O    Low band [N/2]          */
                           int16_t*       outH, /* O    High band [N/2]         */
@@ -488,7 +504,7 @@ void silk_ana_filt_bank_1(const int16_t* in,   /* I    Input signal [N]        *
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Second order ARMA filter, alternative implementation */
-void silk_biquad_alt_stride1(const int16_t* in,    /* I     input signal                 */
+void SilkDecoder::silk_biquad_alt_stride1(const int16_t* in,    /* I     input signal                 */
                              const int32_t* B_Q28, /* I     MA coefficients [3]          */
                              const int32_t* A_Q28, /* I     AR coefficients [2]          */
                              int32_t*       S,     /* I/O   State vector [2]             */
@@ -523,7 +539,7 @@ void silk_biquad_alt_stride1(const int16_t* in,    /* I     input signal
     }
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void silk_biquad_alt_stride2_c(const int16_t* in,    /* I     input signal                 */
+void SilkDecoder::silk_biquad_alt_stride2_c(const int16_t* in,    /* I     input signal                 */
                                const int32_t* B_Q28, /* I     MA coefficients [3]          */
                                const int32_t* A_Q28, /* I     AR coefficients [2]          */
                                int32_t*       S,     /* I/O   State vector [4]             */
@@ -566,7 +582,7 @@ void silk_biquad_alt_stride2_c(const int16_t* in,    /* I     input signal
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Chirp (bandwidth expand) LP AR filter */
-void silk_bwexpander_32(int32_t*      ar,       /* I/O  AR filter to be expanded (without leading 1)                */
+void SilkDecoder::silk_bwexpander_32(int32_t*      ar,       /* I/O  AR filter to be expanded (without leading 1)                */
                         const int32_t d,        /* I    Length of ar                                                */
                         int32_t       chirp_Q16 /* I    Chirp factor in Q16                                         */
 ) {
@@ -581,7 +597,7 @@ void silk_bwexpander_32(int32_t*      ar,       /* I/O  AR filter to be expanded
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Chirp (bandwidth expand) LP AR filter */
-void silk_bwexpander(int16_t*      ar,       /* I/O  AR filter to be expanded (without leading 1)                */
+void SilkDecoder::silk_bwexpander(int16_t*      ar,       /* I/O  AR filter to be expanded (without leading 1)                */
                      const int32_t d,        /* I    Length of ar                                                */
                      int32_t       chirp_Q16 /* I    Chirp factor (typically in the range 0 to 1)                */
 ) {
@@ -597,18 +613,18 @@ void silk_bwexpander(int16_t*      ar,       /* I/O  AR filter to be expanded (w
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Decode mid/side predictors */
-void silk_stereo_decode_pred(int32_t pred_Q13[]  /* O    Predictors                                  */
+void SilkDecoder::silk_stereo_decode_pred(int32_t pred_Q13[]  /* O    Predictors                                  */
 ) {
     int32_t n, ix[2][3];
     int32_t low_Q13, step_Q13;
 
     /* Entropy decoding */
-    n = ec_dec_icdf(silk_stereo_pred_joint_iCDF, 8);
+    n = m_celt.ec_dec_icdf(silk_stereo_pred_joint_iCDF, 8);
     ix[0][2] = silk_DIV32_16(n, 5);
     ix[1][2] = n - 5 * ix[0][2];
     for (n = 0; n < 2; n++) {
-        ix[n][0] = ec_dec_icdf(silk_uniform3_iCDF, 8);
-        ix[n][1] = ec_dec_icdf(silk_uniform5_iCDF, 8);
+        ix[n][0] = m_celt.ec_dec_icdf(silk_uniform3_iCDF, 8);
+        ix[n][1] = m_celt.ec_dec_icdf(silk_uniform5_iCDF, 8);
     }
 
     /* Dequantize */
@@ -624,14 +640,14 @@ void silk_stereo_decode_pred(int32_t pred_Q13[]  /* O    Predictors
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Decode mid-only flag */
-void silk_stereo_decode_mid_only(int32_t *decode_only_mid /* O    Flag that only mid channel has been coded   */
+void SilkDecoder::silk_stereo_decode_mid_only(int32_t *decode_only_mid /* O    Flag that only mid channel has been coded   */
 ) {
     /* Decode flag that only mid channel is coded */
-    *decode_only_mid = ec_dec_icdf(silk_stereo_only_code_mid_iCDF, 8);
+    *decode_only_mid = m_celt.ec_dec_icdf(silk_stereo_only_code_mid_iCDF, 8);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* helper function for NLSF2A(intermediate polynomial, Q[dd+1], vector of interleaved 2*cos(LSFs), QA_[d], polynomial order (= 1/2 * filter order)  ) */
-void silk_NLSF2A_find_poly(int32_t* out, const int32_t* cLSF, int32_t dd) {
+void SilkDecoder::silk_NLSF2A_find_poly(int32_t* out, const int32_t* cLSF, int32_t dd) {
     int32_t k, n;
     int32_t ftmp;
     uint8_t QA16 = 16;
@@ -647,18 +663,18 @@ void silk_NLSF2A_find_poly(int32_t* out, const int32_t* cLSF, int32_t dd) {
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* compute whitening filter coefficients from normalized line spectral frequencies(monic whitening filter coefficients in Q12, normalized line spectral frequencies in Q15, filter order) */
-void silk_NLSF2A(int16_t* a_Q12, const int16_t* NLSF, const int32_t  d) {
+void SilkDecoder::silk_NLSF2A(int16_t* a_Q12, const int16_t* NLSF, const int32_t  d) {
     /* This ordering was found to maximize quality. It improves numerical accuracy of silk_NLSF2A_find_poly() compared to "standard" ordering. */
     const unsigned char ordering16[16] = {0, 15, 8, 7, 4, 11, 12, 3, 2, 13, 10, 5, 6, 9, 14, 1};
     const unsigned char ordering10[10] = {0, 9, 6, 3, 4, 5, 8, 1, 2, 7};
     const unsigned char*       ordering;
     uint8_t                    QA16 = 16;
     int32_t                    k, i, dd;
-    auto                       cos_LSF_QA = silk_malloc_arr<int32_t>(sizeof(int32_t) * SILK_MAX_ORDER_LPC);
-    auto                       P = silk_malloc_arr<int32_t>(sizeof(int32_t) * (SILK_MAX_ORDER_LPC / 2 + 1));
-    auto                       Q = silk_malloc_arr<int32_t>(sizeof(int32_t) * (SILK_MAX_ORDER_LPC / 2 + 1));
+    auto                       cos_LSF_QA = silk_scratch_arr<int32_t>(SILK_MAX_ORDER_LPC);
+    auto                       P = silk_scratch_arr<int32_t>(SILK_MAX_ORDER_LPC / 2 + 1);
+    auto                       Q = silk_scratch_arr<int32_t>(SILK_MAX_ORDER_LPC / 2 + 1);
     int32_t                    Ptmp, Qtmp, f_int, f_frac, cos_val, delta;
-    auto                       a32_QA1 = silk_malloc_arr<int32_t>(sizeof(int32_t) * SILK_MAX_ORDER_LPC);
+    auto                       a32_QA1 = silk_scratch_arr<int32_t>(SILK_MAX_ORDER_LPC);
 
     assert(LSF_COS_TAB_SZ_FIX == 128);
     assert(d == 10 || d == 16);
@@ -713,7 +729,7 @@ void silk_NLSF2A(int16_t* a_Q12, const int16_t* NLSF, const int32_t  d) {
 }
 //----------------------------------------------------------------------------------------------------------------------
 /* Decode side-information parameters from payload */
-void silk_decode_indices(uint8_t n,
+void SilkDecoder::silk_decode_indices(uint8_t n,
                          int32_t FrameIndex,        /* I    Frame number                                */
                          int32_t decode_LBRR,       /* I    Flag indicating LBRR data is being decoded  */
                          int32_t condCoding         /* I    The type of conditional coding to use       */
@@ -726,13 +742,13 @@ void silk_decode_indices(uint8_t n,
     /*******************************************/
     /* Decode signal type and quantizer offset */
     /*******************************************/
-    if (decode_LBRR || s_channel_state[n].VAD_flags[FrameIndex]) {
-        Ix = ec_dec_icdf(silk_type_offset_VAD_iCDF, 8) + 2;
+    if (decode_LBRR || m_channel_state[n].VAD_flags[FrameIndex]) {
+        Ix = m_celt.ec_dec_icdf(silk_type_offset_VAD_iCDF, 8) + 2;
     } else {
-        Ix = ec_dec_icdf(silk_type_offset_no_VAD_iCDF, 8);
+        Ix = m_celt.ec_dec_icdf(silk_type_offset_no_VAD_iCDF, 8);
     }
-    s_channel_state[n].indices.signalType = (int8_t)silk_RSHIFT(Ix, 1);
-    s_channel_state[n].indices.quantOffsetType = (int8_t)(Ix & 1);
+    m_channel_state[n].indices.signalType = (int8_t)silk_RSHIFT(Ix, 1);
+    m_channel_state[n].indices.quantOffsetType = (int8_t)(Ix & 1);
 
     /****************/
     /* Decode gains */
@@ -740,184 +756,184 @@ void silk_decode_indices(uint8_t n,
     /* First subframe */
     if(condCoding == CODE_CONDITIONALLY) {
         /* Conditional coding */
-        s_channel_state[n].indices.GainsIndices[0] = (int8_t)ec_dec_icdf(silk_delta_gain_iCDF, 8);
+        m_channel_state[n].indices.GainsIndices[0] = (int8_t)m_celt.ec_dec_icdf(silk_delta_gain_iCDF, 8);
     } else {
         /* Independent coding, in two stages: MSB bits followed by 3 LSBs */
-        s_channel_state[n].indices.GainsIndices[0] =
-            (int8_t)silk_LSHIFT(ec_dec_icdf(silk_gain_iCDF[s_channel_state[n].indices.signalType], 8), 3);
-        s_channel_state[n].indices.GainsIndices[0] += (int8_t)ec_dec_icdf(silk_uniform8_iCDF, 8);
+        m_channel_state[n].indices.GainsIndices[0] =
+            (int8_t)silk_LSHIFT(m_celt.ec_dec_icdf(silk_gain_iCDF[m_channel_state[n].indices.signalType], 8), 3);
+        m_channel_state[n].indices.GainsIndices[0] += (int8_t)m_celt.ec_dec_icdf(silk_uniform8_iCDF, 8);
     }
 
     /* Remaining subframes */
-    for (i = 1; i < s_channel_state[n].nb_subfr; i++) {
-        s_channel_state[n].indices.GainsIndices[i] = (int8_t)ec_dec_icdf(silk_delta_gain_iCDF, 8);
+    for (i = 1; i < m_channel_state[n].nb_subfr; i++) {
+        m_channel_state[n].indices.GainsIndices[i] = (int8_t)m_celt.ec_dec_icdf(silk_delta_gain_iCDF, 8);
     }
 
     /**********************/
     /* Decode LSF Indices */
     /**********************/
-    s_channel_state[n].indices.NLSFIndices[0] = (int8_t)ec_dec_icdf(
-        &s_channel_state[n].psNLSF_CB->CB1_iCDF[(s_channel_state[n].indices.signalType >> 1) * s_channel_state[n].psNLSF_CB->nVectors], 8);
-    silk_NLSF_unpack(ec_ix, pred_Q8, s_channel_state[n].psNLSF_CB, s_channel_state[n].indices.NLSFIndices[0]);
-    assert(s_channel_state[n].psNLSF_CB->order == s_channel_state[n].LPC_order);
-    for (i = 0; i < s_channel_state[n].psNLSF_CB->order; i++) {
-        Ix = ec_dec_icdf(&s_channel_state[n].psNLSF_CB->ec_iCDF[ec_ix[i]], 8);
+    m_channel_state[n].indices.NLSFIndices[0] = (int8_t)m_celt.ec_dec_icdf(
+        &m_channel_state[n].psNLSF_CB->CB1_iCDF[(m_channel_state[n].indices.signalType >> 1) * m_channel_state[n].psNLSF_CB->nVectors], 8);
+    silk_NLSF_unpack(ec_ix, pred_Q8, m_channel_state[n].psNLSF_CB, m_channel_state[n].indices.NLSFIndices[0]);
+    assert(m_channel_state[n].psNLSF_CB->order == m_channel_state[n].LPC_order);
+    for (i = 0; i < m_channel_state[n].psNLSF_CB->order; i++) {
+        Ix = m_celt.ec_dec_icdf(&m_channel_state[n].psNLSF_CB->ec_iCDF[ec_ix[i]], 8);
         if (Ix == 0) {
-            Ix -= ec_dec_icdf(silk_NLSF_EXT_iCDF, 8);
+            Ix -= m_celt.ec_dec_icdf(silk_NLSF_EXT_iCDF, 8);
         } else if (Ix == 2 * NLSF_QUANT_MAX_AMPLITUDE) {
-            Ix += ec_dec_icdf(silk_NLSF_EXT_iCDF, 8);
+            Ix += m_celt.ec_dec_icdf(silk_NLSF_EXT_iCDF, 8);
         }
-        s_channel_state[n].indices.NLSFIndices[i + 1] = (int8_t)(Ix - NLSF_QUANT_MAX_AMPLITUDE);
+        m_channel_state[n].indices.NLSFIndices[i + 1] = (int8_t)(Ix - NLSF_QUANT_MAX_AMPLITUDE);
     }
 
     /* Decode LSF interpolation factor */
-    if (s_channel_state[n].nb_subfr == MAX_NB_SUBFR) {
-        s_channel_state[n].indices.NLSFInterpCoef_Q2 = (int8_t)ec_dec_icdf(silk_NLSF_interpolation_factor_iCDF, 8);
+    if (m_channel_state[n].nb_subfr == MAX_NB_SUBFR) {
+        m_channel_state[n].indices.NLSFInterpCoef_Q2 = (int8_t)m_celt.ec_dec_icdf(silk_NLSF_interpolation_factor_iCDF, 8);
     } else {
-        s_channel_state[n].indices.NLSFInterpCoef_Q2 = 4;
+        m_channel_state[n].indices.NLSFInterpCoef_Q2 = 4;
     }
 
-    if(s_channel_state[n].indices.signalType == TYPE_VOICED) {
+    if(m_channel_state[n].indices.signalType == TYPE_VOICED) {
         /*********************/
         /* Decode pitch lags */
         /*********************/
         /* Get lag index */
         decode_absolute_lagIndex = 1;
-        if(condCoding == CODE_CONDITIONALLY && s_channel_state[n].ec_prevSignalType == TYPE_VOICED) {
+        if(condCoding == CODE_CONDITIONALLY && m_channel_state[n].ec_prevSignalType == TYPE_VOICED) {
             /* Decode Delta index */
-            delta_lagIndex = (int16_t)ec_dec_icdf(silk_pitch_delta_iCDF, 8);
+            delta_lagIndex = (int16_t)m_celt.ec_dec_icdf(silk_pitch_delta_iCDF, 8);
             if (delta_lagIndex > 0) {
                 delta_lagIndex = delta_lagIndex - 9;
-                s_channel_state[n].indices.lagIndex = (int16_t)(s_channel_state[n].ec_prevLagIndex + delta_lagIndex);
+                m_channel_state[n].indices.lagIndex = (int16_t)(m_channel_state[n].ec_prevLagIndex + delta_lagIndex);
                 decode_absolute_lagIndex = 0;
             }
         }
         if(decode_absolute_lagIndex) {
             /* Absolute decoding */
-            s_channel_state[n].indices.lagIndex =
-                (int16_t)ec_dec_icdf(silk_pitch_lag_iCDF, 8) * silk_RSHIFT(s_channel_state[n].fs_kHz, 1);
-            s_channel_state[n].indices.lagIndex += (int16_t)ec_dec_icdf(s_channel_state[n].pitch_lag_low_bits_iCDF, 8);
+            m_channel_state[n].indices.lagIndex =
+                (int16_t)m_celt.ec_dec_icdf(silk_pitch_lag_iCDF, 8) * silk_RSHIFT(m_channel_state[n].fs_kHz, 1);
+            m_channel_state[n].indices.lagIndex += (int16_t)m_celt.ec_dec_icdf(m_channel_state[n].pitch_lag_low_bits_iCDF, 8);
         }
-        s_channel_state[n].ec_prevLagIndex = s_channel_state[n].indices.lagIndex;
+        m_channel_state[n].ec_prevLagIndex = m_channel_state[n].indices.lagIndex;
 
         /* Get countour index */
-        s_channel_state[n].indices.contourIndex = (int8_t)ec_dec_icdf(s_channel_state[n].pitch_contour_iCDF, 8);
+        m_channel_state[n].indices.contourIndex = (int8_t)m_celt.ec_dec_icdf(m_channel_state[n].pitch_contour_iCDF, 8);
 
         /********************/
         /* Decode LTP gains */
         /********************/
         /* Decode PERIndex value */
-        s_channel_state[n].indices.PERIndex = (int8_t)ec_dec_icdf(silk_LTP_per_index_iCDF, 8);
+        m_channel_state[n].indices.PERIndex = (int8_t)m_celt.ec_dec_icdf(silk_LTP_per_index_iCDF, 8);
 
-        for (k = 0; k < s_channel_state[n].nb_subfr; k++) {
-            s_channel_state[n].indices.LTPIndex[k] =
-                (int8_t)ec_dec_icdf(silk_LTP_gain_iCDF_ptrs[s_channel_state[n].indices.PERIndex], 8);
+        for (k = 0; k < m_channel_state[n].nb_subfr; k++) {
+            m_channel_state[n].indices.LTPIndex[k] =
+                (int8_t)m_celt.ec_dec_icdf(silk_LTP_gain_iCDF_ptrs[m_channel_state[n].indices.PERIndex], 8);
         }
 
         /**********************/
         /* Decode LTP scaling */
         /**********************/
         if (condCoding == CODE_INDEPENDENTLY) {
-            s_channel_state[n].indices.LTP_scaleIndex = (int8_t)ec_dec_icdf(silk_LTPscale_iCDF, 8);
+            m_channel_state[n].indices.LTP_scaleIndex = (int8_t)m_celt.ec_dec_icdf(silk_LTPscale_iCDF, 8);
         } else {
-            s_channel_state[n].indices.LTP_scaleIndex = 0;
+            m_channel_state[n].indices.LTP_scaleIndex = 0;
         }
     }
-    s_channel_state[n].ec_prevSignalType = s_channel_state[n].indices.signalType;
+    m_channel_state[n].ec_prevSignalType = m_channel_state[n].indices.signalType;
 
     /***************/
     /* Decode seed */
     /***************/
-    s_channel_state[n].indices.Seed = (int8_t)ec_dec_icdf(silk_uniform4_iCDF, 8);
+    m_channel_state[n].indices.Seed = (int8_t)m_celt.ec_dec_icdf(silk_uniform4_iCDF, 8);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-void silk_decode_parameters(uint8_t n, int32_t condCoding) {
+void SilkDecoder::silk_decode_parameters(uint8_t n, int32_t condCoding) {
     int32_t       i, k, Ix;
     int16_t       pNLSF_Q15[MAX_LPC_ORDER], pNLSF0_Q15[MAX_LPC_ORDER];
     const int8_t* cbk_ptr_Q7;
 
     /* Dequant Gains */
-    silk_gains_dequant(s_silk_decoder_control->Gains_Q16, s_channel_state[n].indices.GainsIndices, &s_channel_state[n].LastGainIndex, condCoding == CODE_CONDITIONALLY, s_channel_state[n].nb_subfr);
+    silk_gains_dequant(m_silk_decoder_control->Gains_Q16, m_channel_state[n].indices.GainsIndices, &m_channel_state[n].LastGainIndex, condCoding == CODE_CONDITIONALLY, m_channel_state[n].nb_subfr);
 
     /****************/
     /* Decode NLSFs */
     /****************/
-    silk_NLSF_decode(pNLSF_Q15, s_channel_state[n].indices.NLSFIndices, s_channel_state[n].psNLSF_CB);
+    silk_NLSF_decode(pNLSF_Q15, m_channel_state[n].indices.NLSFIndices, m_channel_state[n].psNLSF_CB);
 
     /* Convert NLSF parameters to AR prediction filter coefficients */
-    silk_NLSF2A(s_silk_decoder_control->PredCoef_Q12[1], pNLSF_Q15, s_channel_state[n].LPC_order);
+    silk_NLSF2A(m_silk_decoder_control->PredCoef_Q12[1], pNLSF_Q15, m_channel_state[n].LPC_order);
 
     /* If just reset, e.g., because internal Fs changed, do not allow interpolation */
     /* improves the case of packet loss in the first frame after a switch           */
-    if(s_channel_state[n].first_frame_after_reset == 1) { s_channel_state[n].indices.NLSFInterpCoef_Q2 = 4; }
+    if(m_channel_state[n].first_frame_after_reset == 1) { m_channel_state[n].indices.NLSFInterpCoef_Q2 = 4; }
 
-    if(s_channel_state[n].indices.NLSFInterpCoef_Q2 < 4) {
+    if(m_channel_state[n].indices.NLSFInterpCoef_Q2 < 4) {
         /* Calculation of the interpolated NLSF0 vector from the interpolation factor, the previous NLSF1, and the current NLSF1 */
-        for(i = 0; i < s_channel_state[n].LPC_order; i++) { pNLSF0_Q15[i] = s_channel_state[n].prevNLSF_Q15[i] + silk_RSHIFT(silk_MUL(s_channel_state[n].indices.NLSFInterpCoef_Q2, pNLSF_Q15[i] - s_channel_state[n].prevNLSF_Q15[i]), 2); }
+        for(i = 0; i < m_channel_state[n].LPC_order; i++) { pNLSF0_Q15[i] = m_channel_state[n].prevNLSF_Q15[i] + silk_RSHIFT(silk_MUL(m_channel_state[n].indices.NLSFInterpCoef_Q2, pNLSF_Q15[i] - m_channel_state[n].prevNLSF_Q15[i]), 2); }
 
         /* Convert NLSF parameters to AR prediction filter coefficients */
-        silk_NLSF2A(s_silk_decoder_control->PredCoef_Q12[0], pNLSF0_Q15, s_channel_state[n].LPC_order);
+        silk_NLSF2A(m_silk_decoder_control->PredCoef_Q12[0], pNLSF0_Q15, m_channel_state[n].LPC_order);
     }
     else {
         /* Copy LPC coefficients for first half from second half */
-        memcpy(s_silk_decoder_control->PredCoef_Q12[0], s_silk_decoder_control->PredCoef_Q12[1], s_channel_state[n].LPC_order * sizeof(int16_t));
+        memcpy(m_silk_decoder_control->PredCoef_Q12[0], m_silk_decoder_control->PredCoef_Q12[1], m_channel_state[n].LPC_order * sizeof(int16_t));
     }
-    memcpy(s_channel_state[n].prevNLSF_Q15, pNLSF_Q15, s_channel_state[n].LPC_order * sizeof(int16_t));
+    memcpy(m_channel_state[n].prevNLSF_Q15, pNLSF_Q15, m_channel_state[n].LPC_order * sizeof(int16_t));
 
     /* After a packet loss do BWE of LPC coefs */
-    if(s_channel_state[n].lossCnt) {
-        silk_bwexpander(s_silk_decoder_control->PredCoef_Q12[0], s_channel_state[n].LPC_order, BWE_AFTER_LOSS_Q16);
-        silk_bwexpander(s_silk_decoder_control->PredCoef_Q12[1], s_channel_state[n].LPC_order, BWE_AFTER_LOSS_Q16);
+    if(m_channel_state[n].lossCnt) {
+        silk_bwexpander(m_silk_decoder_control->PredCoef_Q12[0], m_channel_state[n].LPC_order, BWE_AFTER_LOSS_Q16);
+        silk_bwexpander(m_silk_decoder_control->PredCoef_Q12[1], m_channel_state[n].LPC_order, BWE_AFTER_LOSS_Q16);
     }
 
-    if(s_channel_state[n].indices.signalType == TYPE_VOICED) {
+    if(m_channel_state[n].indices.signalType == TYPE_VOICED) {
         /*********************/
         /* Decode pitch lags */
         /*********************/
 
         /* Decode pitch values */
-        silk_decode_pitch(s_channel_state[n].indices.lagIndex, s_channel_state[n].indices.contourIndex, s_silk_decoder_control->pitchL, s_channel_state[n].fs_kHz, s_channel_state[n].nb_subfr);
+        silk_decode_pitch(m_channel_state[n].indices.lagIndex, m_channel_state[n].indices.contourIndex, m_silk_decoder_control->pitchL, m_channel_state[n].fs_kHz, m_channel_state[n].nb_subfr);
 
         /* Decode Codebook Index */
-        cbk_ptr_Q7 = silk_LTP_vq_ptrs_Q7[s_channel_state[n].indices.PERIndex]; /* set pointer to start of codebook */
+        cbk_ptr_Q7 = silk_LTP_vq_ptrs_Q7[m_channel_state[n].indices.PERIndex]; /* set pointer to start of codebook */
 
-        for(k = 0; k < s_channel_state[n].nb_subfr; k++) {
-            Ix = s_channel_state[n].indices.LTPIndex[k];
-            for(i = 0; i < LTP_ORDER; i++) { s_silk_decoder_control->LTPCoef_Q14[k * LTP_ORDER + i] = silk_LSHIFT(cbk_ptr_Q7[Ix * LTP_ORDER + i], 7); }
+        for(k = 0; k < m_channel_state[n].nb_subfr; k++) {
+            Ix = m_channel_state[n].indices.LTPIndex[k];
+            for(i = 0; i < LTP_ORDER; i++) { m_silk_decoder_control->LTPCoef_Q14[k * LTP_ORDER + i] = silk_LSHIFT(cbk_ptr_Q7[Ix * LTP_ORDER + i], 7); }
         }
 
         /**********************/
         /* Decode LTP scaling */
         /**********************/
-        Ix = s_channel_state[n].indices.LTP_scaleIndex;
-        s_silk_decoder_control->LTP_scale_Q14 = silk_LTPScales_table_Q14[Ix];
+        Ix = m_channel_state[n].indices.LTP_scaleIndex;
+        m_silk_decoder_control->LTP_scale_Q14 = silk_LTPScales_table_Q14[Ix];
     }
     else {
-        memset(s_silk_decoder_control->pitchL, 0, s_channel_state[n].nb_subfr * sizeof(int32_t));
-        memset(s_silk_decoder_control->LTPCoef_Q14, 0, LTP_ORDER * s_channel_state[n].nb_subfr * sizeof(int16_t));
-        s_channel_state[n].indices.PERIndex = 0;
-        s_silk_decoder_control->LTP_scale_Q14 = 0;
+        memset(m_silk_decoder_control->pitchL, 0, m_channel_state[n].nb_subfr * sizeof(int32_t));
+        memset(m_silk_decoder_control->LTPCoef_Q14, 0, LTP_ORDER * m_channel_state[n].nb_subfr * sizeof(int16_t));
+        m_channel_state[n].indices.PERIndex = 0;
+        m_silk_decoder_control->LTP_scale_Q14 = 0;
     }
 }
 //----------------------------------------------------------------------------------------------------------------------
 /* Decode quantization indices of excitation */
 
-void silk_decode_pulses(int16_t pulses[],              /* O    Excitation signal                           */
+void SilkDecoder::silk_decode_pulses(int16_t pulses[],              /* O    Excitation signal                           */
                         const int32_t signalType,      /* I    Sigtype                                     */
                         const int32_t quantOffsetType, /* I    quantOffsetType                             */
                         const int32_t frame_length     /* I    Frame length                                */
 ) {
     int32_t i, j, k, iter, abs_q, nLS, RateLevelIndex;
-    auto sum_pulses = silk_malloc_arr<int32_t>(MAX_NB_SHELL_BLOCKS * sizeof(int32_t));
-    auto nLshifts   = silk_malloc_arr<int32_t>(MAX_NB_SHELL_BLOCKS * sizeof(int32_t));
+    auto sum_pulses = silk_scratch_arr<int32_t>(MAX_NB_SHELL_BLOCKS);
+    auto nLshifts   = silk_scratch_arr<int32_t>(MAX_NB_SHELL_BLOCKS);
     int16_t *pulses_ptr;
     const uint8_t *cdf_ptr;
 
     /*********************/
     /* Decode rate level */
     /*********************/
-    RateLevelIndex = ec_dec_icdf(silk_rate_levels_iCDF[signalType >> 1], 8);
+    RateLevelIndex = m_celt.ec_dec_icdf(silk_rate_levels_iCDF[signalType >> 1], 8);
 
     /* Calculate number of shell blocks */
     assert(1 << LOG2_SHELL_CODEC_FRAME_LENGTH == SHELL_CODEC_FRAME_LENGTH);
@@ -933,14 +949,14 @@ void silk_decode_pulses(int16_t pulses[],              /* O    Excitation signal
     cdf_ptr = silk_pulses_per_block_iCDF[RateLevelIndex];
     for(i = 0; i < iter; i++) {
         nLshifts[i] = 0;
-        sum_pulses[i] = ec_dec_icdf(cdf_ptr, 8);
+        sum_pulses[i] = m_celt.ec_dec_icdf(cdf_ptr, 8);
 
         /* LSB indication */
         while(sum_pulses[i] == SILK_MAX_PULSES + 1) {
             nLshifts[i]++;
             /* When we've already got 10 LSBs, we shift the table to not allow (SILK_MAX_PULSES + 1) */
             sum_pulses[i] =
-                ec_dec_icdf(silk_pulses_per_block_iCDF[N_RATE_LEVELS - 1] + (nLshifts[i] == 10), 8);
+                m_celt.ec_dec_icdf(silk_pulses_per_block_iCDF[N_RATE_LEVELS - 1] + (nLshifts[i] == 10), 8);
         }
     }
 
@@ -967,7 +983,7 @@ void silk_decode_pulses(int16_t pulses[],              /* O    Excitation signal
                 abs_q = pulses_ptr[k];
                 for(j = 0; j < nLS; j++) {
                     abs_q = silk_LSHIFT(abs_q, 1);
-                    abs_q += ec_dec_icdf(silk_lsb_iCDF, 8);
+                    abs_q += m_celt.ec_dec_icdf(silk_lsb_iCDF, 8);
                 }
                 pulses_ptr[k] = abs_q;
             }
@@ -983,65 +999,65 @@ void silk_decode_pulses(int16_t pulses[],              /* O    Excitation signal
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Set decoder sampling rate (Decoder state pointer , Sampling frequency (kHz) , API Sampling frequency (Hz))*/
-int32_t silk_decoder_set_fs(uint8_t n, int32_t fs_kHz, int32_t fs_API_Hz) {
+int32_t SilkDecoder::silk_decoder_set_fs(uint8_t n, int32_t fs_kHz, int32_t fs_API_Hz) {
     int32_t frame_length, ret = 0;
 
     assert(fs_kHz == 8 || fs_kHz == 12 || fs_kHz == 16);
-    assert(s_channel_state[n].nb_subfr == MAX_NB_SUBFR || s_channel_state[n].nb_subfr == MAX_NB_SUBFR / 2);
+    assert(m_channel_state[n].nb_subfr == MAX_NB_SUBFR || m_channel_state[n].nb_subfr == MAX_NB_SUBFR / 2);
 
     /* New (sub)frame length */
-    s_channel_state[n].subfr_length = silk_SMULBB(SUB_FRAME_LENGTH_MS, fs_kHz);
-    frame_length = silk_SMULBB(s_channel_state[n].nb_subfr, s_channel_state[n].subfr_length);
+    m_channel_state[n].subfr_length = silk_SMULBB(SUB_FRAME_LENGTH_MS, fs_kHz);
+    frame_length = silk_SMULBB(m_channel_state[n].nb_subfr, m_channel_state[n].subfr_length);
 
     /* Initialize resampler when switching internal or external sampling frequency */
-    if(s_channel_state[n].fs_kHz != fs_kHz || s_channel_state[n].fs_API_hz != fs_API_Hz) {
+    if(m_channel_state[n].fs_kHz != fs_kHz || m_channel_state[n].fs_API_hz != fs_API_Hz) {
         /* Initialize the resampler for dec_API.c preparing resampling from fs_kHz to API_fs_Hz */
 
         ret += silk_resampler_init(n, silk_SMULBB(fs_kHz, 1000), fs_API_Hz, 0);
 
-        s_channel_state[n].fs_API_hz = fs_API_Hz;
+        m_channel_state[n].fs_API_hz = fs_API_Hz;
     }
 
-    if(s_channel_state[n].fs_kHz != fs_kHz || frame_length != s_channel_state[n].frame_length) {
+    if(m_channel_state[n].fs_kHz != fs_kHz || frame_length != m_channel_state[n].frame_length) {
         if(fs_kHz == 8) {
-            if(s_channel_state[n].nb_subfr == MAX_NB_SUBFR) { s_channel_state[n].pitch_contour_iCDF = silk_pitch_contour_NB_iCDF; }
-            else { s_channel_state[n].pitch_contour_iCDF = silk_pitch_contour_10_ms_NB_iCDF; }
+            if(m_channel_state[n].nb_subfr == MAX_NB_SUBFR) { m_channel_state[n].pitch_contour_iCDF = silk_pitch_contour_NB_iCDF; }
+            else { m_channel_state[n].pitch_contour_iCDF = silk_pitch_contour_10_ms_NB_iCDF; }
         }
         else {
-            if(s_channel_state[n].nb_subfr == MAX_NB_SUBFR) { s_channel_state[n].pitch_contour_iCDF = silk_pitch_contour_iCDF; }
-            else { s_channel_state[n].pitch_contour_iCDF = silk_pitch_contour_10_ms_iCDF; }
+            if(m_channel_state[n].nb_subfr == MAX_NB_SUBFR) { m_channel_state[n].pitch_contour_iCDF = silk_pitch_contour_iCDF; }
+            else { m_channel_state[n].pitch_contour_iCDF = silk_pitch_contour_10_ms_iCDF; }
         }
-        if(s_channel_state[n].fs_kHz != fs_kHz) {
-            s_channel_state[n].ltp_mem_length = silk_SMULBB(LTP_MEM_LENGTH_MS, fs_kHz);
+        if(m_channel_state[n].fs_kHz != fs_kHz) {
+            m_channel_state[n].ltp_mem_length = silk_SMULBB(LTP_MEM_LENGTH_MS, fs_kHz);
             if(fs_kHz == 8 || fs_kHz == 12) {
-                s_channel_state[n].LPC_order = MIN_LPC_ORDER;
-                s_channel_state[n].psNLSF_CB = &silk_NLSF_CB_NB_MB;
+                m_channel_state[n].LPC_order = MIN_LPC_ORDER;
+                m_channel_state[n].psNLSF_CB = &silk_NLSF_CB_NB_MB;
             }
             else {
-                s_channel_state[n].LPC_order = MAX_LPC_ORDER;
-                s_channel_state[n].psNLSF_CB = &silk_NLSF_CB_WB;
+                m_channel_state[n].LPC_order = MAX_LPC_ORDER;
+                m_channel_state[n].psNLSF_CB = &silk_NLSF_CB_WB;
             }
-            if(fs_kHz == 16) { s_channel_state[n].pitch_lag_low_bits_iCDF = silk_uniform8_iCDF; }
-            else if(fs_kHz == 12) { s_channel_state[n].pitch_lag_low_bits_iCDF = silk_uniform6_iCDF; }
-            else if(fs_kHz == 8) { s_channel_state[n].pitch_lag_low_bits_iCDF = silk_uniform4_iCDF; }
+            if(fs_kHz == 16) { m_channel_state[n].pitch_lag_low_bits_iCDF = silk_uniform8_iCDF; }
+            else if(fs_kHz == 12) { m_channel_state[n].pitch_lag_low_bits_iCDF = silk_uniform6_iCDF; }
+            else if(fs_kHz == 8) { m_channel_state[n].pitch_lag_low_bits_iCDF = silk_uniform4_iCDF; }
             else {
                 /* unsupported sampling rate */
                 assert(0);
             }
-            s_channel_state[n].first_frame_after_reset = 1;
-            s_channel_state[n].lagPrev = 100;
-            s_channel_state[n].LastGainIndex = 10;
-            s_channel_state[n].prevSignalType = TYPE_NO_VOICE_ACTIVITY;
-            memset(s_channel_state[n].outBuf, 0, sizeof(s_channel_state[n].outBuf));
-            memset(s_channel_state[n].sLPC_Q14_buf, 0, sizeof(s_channel_state[n].sLPC_Q14_buf));
+            m_channel_state[n].first_frame_after_reset = 1;
+            m_channel_state[n].lagPrev = 100;
+            m_channel_state[n].LastGainIndex = 10;
+            m_channel_state[n].prevSignalType = TYPE_NO_VOICE_ACTIVITY;
+            memset(m_channel_state[n].outBuf, 0, sizeof(m_channel_state[n].outBuf));
+            memset(m_channel_state[n].sLPC_Q14_buf, 0, sizeof(m_channel_state[n].sLPC_Q14_buf));
         }
 
-        s_channel_state[n].fs_kHz = fs_kHz;
-        s_channel_state[n].frame_length = frame_length;
+        m_channel_state[n].fs_kHz = fs_kHz;
+        m_channel_state[n].frame_length = frame_length;
     }
 
     /* Check that settings are valid */
-    assert(s_channel_state[n].frame_length > 0 && s_channel_state[n].frame_length <= MAX_FRAME_LENGTH);
+    assert(m_channel_state[n].frame_length > 0 && m_channel_state[n].frame_length <= MAX_FRAME_LENGTH);
 
     return ret;
 }
@@ -1064,7 +1080,7 @@ inline int32_t combine_and_check(                            /* return ok
     return 0;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void silk_quant_LTP_gains(int16_t       B_Q14[MAX_NB_SUBFR * LTP_ORDER],              /* O    Quantized LTP gains             */
+void SilkDecoder::silk_quant_LTP_gains(int16_t       B_Q14[MAX_NB_SUBFR * LTP_ORDER],              /* O    Quantized LTP gains             */
                           int8_t        cbk_index[MAX_NB_SUBFR],                      /* O    Codebook Index                  */
                           int8_t*       periodicity_index,                            /* O    Periodicity Index               */
                           int32_t*      sum_log_gain_Q7,                              /* I/O  Cumulative max prediction gain  */
@@ -1151,13 +1167,13 @@ void silk_quant_LTP_gains(int16_t       B_Q14[MAX_NB_SUBFR * LTP_ORDER],
     *pred_gain_dB_Q7 = (int32_t)silk_SMULBB(-3, silk_lin2log(res_nrg_Q15) - (15 << 7));
 }
 //----------------------------------------------------------------------------------------------------------------------
-inline void decode_split(int16_t *p_child1,         /* O    pulse amplitude of first child subframe     */
+inline void SilkDecoder::decode_split(int16_t *p_child1,         /* O    pulse amplitude of first child subframe     */
                                      int16_t *p_child2,         /* O    pulse amplitude of second child subframe    */
                                      const int32_t p,           /* I    pulse amplitude of current subframe         */
                                      const uint8_t *shell_table /* I    table of shell cdfs                         */
 ) {
     if (p > 0) {
-        p_child1[0] = ec_dec_icdf(&shell_table[silk_shell_code_table_offsets[p]], 8);
+        p_child1[0] = m_celt.ec_dec_icdf(&shell_table[silk_shell_code_table_offsets[p]], 8);
         p_child2[0] = p - p_child1[0];
     }
     else {
@@ -1167,7 +1183,7 @@ inline void decode_split(int16_t *p_child1,         /* O    pulse amplitude of f
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Shell decoder, operates on one shell code frame of 16 pulses */
-void silk_shell_decoder(int16_t *pulses0,     /* O    data: nonnegative pulse amplitudes          */
+void SilkDecoder::silk_shell_decoder(int16_t *pulses0,     /* O    data: nonnegative pulse amplitudes          */
                         const int32_t pulses4 /* I    number of pulses per pulse-subframe         */
 ) {
     int16_t pulses3[2], pulses2[4], pulses1[8];
@@ -1192,7 +1208,7 @@ void silk_shell_decoder(int16_t *pulses0,     /* O    data: nonnegative pulse am
 }
 //----------------------------------------------------------------------------------------------------------------------
 /* Quantize mid/side predictors */
-void silk_stereo_quant_pred(int32_t pred_Q13[], /* I/O  Predictors (out: quantized)                 */
+void SilkDecoder::silk_stereo_quant_pred(int32_t pred_Q13[], /* I/O  Predictors (out: quantized)                 */
                             int8_t ix[2][3]     /* O    Quantization indices                        */
 ) {
     int32_t i, j, n;
@@ -1231,7 +1247,7 @@ void silk_stereo_quant_pred(int32_t pred_Q13[], /* I/O  Predictors (out: quantiz
 }
 //----------------------------------------------------------------------------------------------------------------------
 /* Helper function, interpolates the filter taps */
-void silk_LP_interpolate_filter_taps(int32_t B_Q28[TRANSITION_NB], int32_t A_Q28[TRANSITION_NA],
+void SilkDecoder::silk_LP_interpolate_filter_taps(int32_t B_Q28[TRANSITION_NB], int32_t A_Q28[TRANSITION_NA],
                                             const int32_t ind, const int32_t fac_Q16) {
     int32_t nb, na;
 
@@ -1274,7 +1290,7 @@ void silk_LP_interpolate_filter_taps(int32_t B_Q28[TRANSITION_NB], int32_t A_Q28
 /* piece-wise linear interpolation between elliptic filters */
 /* Start by setting psEncC->mode <> 0;                      */
 /* Deactivate by setting psEncC->mode = 0;                  */
-void silk_LP_variable_cutoff(silk_LP_state* psLP,        /* I/O  LP filter state                             */
+void SilkDecoder::silk_LP_variable_cutoff(silk_LP_state* psLP,        /* I/O  LP filter state                             */
                              int16_t*       frame,       /* I/O  Low-pass filtered output signal             */
                              const int32_t  frame_length /* I    Frame length                                */
 ) {
@@ -1310,7 +1326,7 @@ void silk_LP_variable_cutoff(silk_LP_state* psLP,        /* I/O  LP filter state
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Generates excitation for CNG LPC synthesis */
-void silk_CNG_exc(int32_t  exc_Q14[],     /* O    CNG excitation signal Q10                   */
+void SilkDecoder::silk_CNG_exc(int32_t  exc_Q14[],     /* O    CNG excitation signal Q10                   */
                          int32_t  exc_buf_Q14[], /* I    Random samples buffer Q10                   */
                          int32_t  length,        /* I    Length                                      */
                          int32_t* rand_seed      /* I/O  Seed to random index generator              */
@@ -1332,60 +1348,60 @@ void silk_CNG_exc(int32_t  exc_Q14[],     /* O    CNG excitation signal Q10
     *rand_seed = seed;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void silk_CNG_Reset(uint8_t n) {
+void SilkDecoder::silk_CNG_Reset(uint8_t n) {
     int32_t i, NLSF_step_Q15, NLSF_acc_Q15;
 
-    NLSF_step_Q15 = silk_DIV32_16(silk_int16_MAX, s_channel_state[n].LPC_order + 1);
+    NLSF_step_Q15 = silk_DIV32_16(silk_int16_MAX, m_channel_state[n].LPC_order + 1);
     NLSF_acc_Q15 = 0;
-    for(i = 0; i < s_channel_state[n].LPC_order; i++) {
+    for(i = 0; i < m_channel_state[n].LPC_order; i++) {
         NLSF_acc_Q15 += NLSF_step_Q15;
-        s_channel_state[n].sCNG.CNG_smth_NLSF_Q15[i] = NLSF_acc_Q15;
+        m_channel_state[n].sCNG.CNG_smth_NLSF_Q15[i] = NLSF_acc_Q15;
     }
-    s_channel_state[n].sCNG.CNG_smth_Gain_Q16 = 0;
-    s_channel_state[n].sCNG.rand_seed = 3176576;
+    m_channel_state[n].sCNG.CNG_smth_Gain_Q16 = 0;
+    m_channel_state[n].sCNG.rand_seed = 3176576;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /* Updates CNG estimate, and applies the CNG when packet was lost   */
-void silk_CNG(uint8_t n, int16_t frame[], int32_t length ) {
+void SilkDecoder::silk_CNG(uint8_t n, int16_t frame[], int32_t length ) {
     int32_t          i, subfr;
     int32_t          LPC_pred_Q10, max_Gain_Q16, gain_Q16, gain_Q10;
     int16_t          A_Q12[MAX_LPC_ORDER];
-    silk_CNG_struct* psCNG = &s_channel_state[n].sCNG;
+    silk_CNG_struct* psCNG = &m_channel_state[n].sCNG;
 
-    if(s_channel_state[n].fs_kHz != psCNG->fs_kHz) {
+    if(m_channel_state[n].fs_kHz != psCNG->fs_kHz) {
         /* Reset state */
         silk_CNG_Reset(n);
 
-        psCNG->fs_kHz = s_channel_state[n].fs_kHz;
+        psCNG->fs_kHz = m_channel_state[n].fs_kHz;
     }
-    if(s_channel_state[n].lossCnt == 0 && s_channel_state[n].prevSignalType == TYPE_NO_VOICE_ACTIVITY) {
+    if(m_channel_state[n].lossCnt == 0 && m_channel_state[n].prevSignalType == TYPE_NO_VOICE_ACTIVITY) {
         /* Update CNG parameters */
 
         /* Smoothing of LSF's  */
-        for(i = 0; i < s_channel_state[n].LPC_order; i++) { psCNG->CNG_smth_NLSF_Q15[i] += silk_SMULWB((int32_t)s_channel_state[n].prevNLSF_Q15[i] - (int32_t)psCNG->CNG_smth_NLSF_Q15[i], CNG_NLSF_SMTH_Q16); }
+        for(i = 0; i < m_channel_state[n].LPC_order; i++) { psCNG->CNG_smth_NLSF_Q15[i] += silk_SMULWB((int32_t)m_channel_state[n].prevNLSF_Q15[i] - (int32_t)psCNG->CNG_smth_NLSF_Q15[i], CNG_NLSF_SMTH_Q16); }
         /* Find the subframe with the highest gain */
         max_Gain_Q16 = 0;
         subfr = 0;
-        for(i = 0; i < s_channel_state[n].nb_subfr; i++) {
-            if(s_silk_decoder_control->Gains_Q16[i] > max_Gain_Q16) {
-                max_Gain_Q16 = s_silk_decoder_control->Gains_Q16[i];
+        for(i = 0; i < m_channel_state[n].nb_subfr; i++) {
+            if(m_silk_decoder_control->Gains_Q16[i] > max_Gain_Q16) {
+                max_Gain_Q16 = m_silk_decoder_control->Gains_Q16[i];
                 subfr = i;
             }
         }
         /* Update CNG excitation buffer with excitation from this subframe */
-        memmove(&psCNG->CNG_exc_buf_Q14[s_channel_state[n].subfr_length], psCNG->CNG_exc_buf_Q14, (s_channel_state[n].nb_subfr - 1) * s_channel_state[n].subfr_length * sizeof(int32_t));
-        memcpy(psCNG->CNG_exc_buf_Q14, &s_channel_state[n].exc_Q14[subfr * s_channel_state[n].subfr_length], s_channel_state[n].subfr_length * sizeof(int32_t));
+        memmove(&psCNG->CNG_exc_buf_Q14[m_channel_state[n].subfr_length], psCNG->CNG_exc_buf_Q14, (m_channel_state[n].nb_subfr - 1) * m_channel_state[n].subfr_length * sizeof(int32_t));
+        memcpy(psCNG->CNG_exc_buf_Q14, &m_channel_state[n].exc_Q14[subfr * m_channel_state[n].subfr_length], m_channel_state[n].subfr_length * sizeof(int32_t));
 
         /* Smooth gains */
-        for(i = 0; i < s_channel_state[n].nb_subfr; i++) { psCNG->CNG_smth_Gain_Q16 += silk_SMULWB(s_silk_decoder_control->Gains_Q16[i] - psCNG->CNG_smth_Gain_Q16, CNG_GAIN_SMTH_Q16); }
+        for(i = 0; i < m_channel_state[n].nb_subfr; i++) { psCNG->CNG_smth_Gain_Q16 += silk_SMULWB(m_silk_decoder_control->Gains_Q16[i] - psCNG->CNG_smth_Gain_Q16, CNG_GAIN_SMTH_Q16); }
     }
     /* Add CNG when packet is lost or during DTX */
-    if(s_channel_state[n].lossCnt) {
-        auto CNG_sig_Q14 = silk_malloc_arr<int32_t>(length + MAX_LPC_ORDER * sizeof(int32_t));
+    if(m_channel_state[n].lossCnt) {
+        auto CNG_sig_Q14 = silk_scratch_arr<int32_t>(length + MAX_LPC_ORDER);
 
         /* Generate CNG excitation */
-        gain_Q16 = silk_SMULWW(s_channel_state[n].sPLC.randScale_Q14, s_channel_state[n].sPLC.prevGain_Q16[1]);
+        gain_Q16 = silk_SMULWW(m_channel_state[n].sPLC.randScale_Q14, m_channel_state[n].sPLC.prevGain_Q16[1]);
         if(gain_Q16 >= (1 << 21) || psCNG->CNG_smth_Gain_Q16 > (1 << 23)) {
             gain_Q16 = silk_SMULTT(gain_Q16, gain_Q16);
             gain_Q16 = silk_SUB_LSHIFT32(silk_SMULTT(psCNG->CNG_smth_Gain_Q16, psCNG->CNG_smth_Gain_Q16), gain_Q16, 5);
@@ -1401,14 +1417,14 @@ void silk_CNG(uint8_t n, int16_t frame[], int32_t length ) {
         silk_CNG_exc(CNG_sig_Q14.get() + MAX_LPC_ORDER, psCNG->CNG_exc_buf_Q14, length, &psCNG->rand_seed);
 
         /* Convert CNG NLSF to filter representation */
-        silk_NLSF2A(A_Q12, psCNG->CNG_smth_NLSF_Q15, s_channel_state[n].LPC_order);
+        silk_NLSF2A(A_Q12, psCNG->CNG_smth_NLSF_Q15, m_channel_state[n].LPC_order);
 
         /* Generate CNG signal, by synthesis filtering */
         memcpy(CNG_sig_Q14.get(), psCNG->CNG_synth_state, MAX_LPC_ORDER * sizeof(int32_t));
-        assert(s_channel_state[n].LPC_order == 10 || s_channel_state[n].LPC_order == 16);
+        assert(m_channel_state[n].LPC_order == 10 || m_channel_state[n].LPC_order == 16);
         for(i = 0; i < length; i++) {
             /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
-            LPC_pred_Q10 = silk_RSHIFT(s_channel_state[n].LPC_order, 1);
+            LPC_pred_Q10 = silk_RSHIFT(m_channel_state[n].LPC_order, 1);
             LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, CNG_sig_Q14[MAX_LPC_ORDER + i - 1], A_Q12[0]);
             LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, CNG_sig_Q14[MAX_LPC_ORDER + i - 2], A_Q12[1]);
             LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, CNG_sig_Q14[MAX_LPC_ORDER + i - 3], A_Q12[2]);
@@ -1419,7 +1435,7 @@ void silk_CNG(uint8_t n, int16_t frame[], int32_t length ) {
             LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, CNG_sig_Q14[MAX_LPC_ORDER + i - 8], A_Q12[7]);
             LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, CNG_sig_Q14[MAX_LPC_ORDER + i - 9], A_Q12[8]);
             LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, CNG_sig_Q14[MAX_LPC_ORDER + i - 10], A_Q12[9]);
-            if(s_channel_state[n].LPC_order == 16) {
+            if(m_channel_state[n].LPC_order == 16) {
                 LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, CNG_sig_Q14[MAX_LPC_ORDER + i - 11], A_Q12[10]);
                 LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, CNG_sig_Q14[MAX_LPC_ORDER + i - 12], A_Q12[11]);
                 LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, CNG_sig_Q14[MAX_LPC_ORDER + i - 13], A_Q12[12]);
@@ -1436,12 +1452,12 @@ void silk_CNG(uint8_t n, int16_t frame[], int32_t length ) {
         }
         memcpy(psCNG->CNG_synth_state, &CNG_sig_Q14[length], MAX_LPC_ORDER * sizeof(int32_t));
     }
-    else { memset(psCNG->CNG_synth_state, 0, s_channel_state[n].LPC_order * sizeof(int32_t)); }
+    else { memset(psCNG->CNG_synth_state, 0, m_channel_state[n].LPC_order * sizeof(int32_t)); }
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /* Decodes signs of excitation */
-void silk_decode_signs(int16_t pulses[],              /* I/O  pulse signal                                */
+void SilkDecoder::silk_decode_signs(int16_t pulses[],              /* I/O  pulse signal                                */
                        int32_t length,                /* I    length of input                             */
                        const int32_t signalType,      /* I    Signal type                                 */
                        const int32_t quantOffsetType, /* I    Quantization offset type                    */
@@ -1465,7 +1481,7 @@ void silk_decode_signs(int16_t pulses[],              /* I/O  pulse signal
                 if(q_ptr[j] > 0) {
                     /* attach sign */
                     /* implementation with shift, subtraction, multiplication */
-                    q_ptr[j] *= silk_dec_map(ec_dec_icdf(icdf, 8));
+                    q_ptr[j] *= silk_dec_map(m_celt.ec_dec_icdf(icdf, 8));
                 }
             }
         }
@@ -1473,20 +1489,26 @@ void silk_decode_signs(int16_t pulses[],              /* I/O  pulse signal
     }
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void silk_setRawParams(uint8_t channels, uint8_t API_channels, uint8_t payloadSize_ms, uint32_t internalSampleRate, uint32_t API_samleRate){
-    s_channelsInternal = channels;
-    s_API_channels = API_channels;
-    s_payloadSize_ms = payloadSize_ms;
-    s_silk_internalSampleRate = internalSampleRate;
-    s_API_sampleRate = API_samleRate;
+void SilkDecoder::silk_setRawParams(uint8_t channels, uint8_t API_channels, uint8_t payloadSize_ms, uint32_t internalSampleRate, uint32_t API_samleRate){
+    m_channelsInternal = channels;
+    m_API_channels = API_channels;
+    m_payloadSize_ms = payloadSize_ms;
+    m_silk_internalSampleRate = internalSampleRate;
+    m_API_sampleRate = API_samleRate;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-uint32_t silk_getPrevPitchLag(){
-    return s_prevPitchLag;
+void SilkDecoder::silk_setDecControl(int32_t nChannelsAPI, int32_t nChannelsInternal, int32_t API_sampleRate){
+    m_silk_DecControlStruct->nChannelsAPI = nChannelsAPI;
+    m_silk_DecControlStruct->nChannelsInternal = nChannelsInternal;
+    m_silk_DecControlStruct->API_sampleRate = API_sampleRate;
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+uint32_t SilkDecoder::silk_getPrevPitchLag(){
+    return m_prevPitchLag;
 }
 //----------------------------------------------------------------------------------------------------------------------
 /* Decode a frame */
-int32_t silk_Decode(                                   /* O    Returns error code                              */
+int32_t SilkDecoder::silk_Decode(                                   /* O    Returns error code                              */
 
                     int32_t lostFlag,                  /* I    0: no loss, 1 loss, 2 decode fec                */
                     int32_t newPacketFlag,             /* I    Indicates first decoder call for this packet    */
@@ -1500,99 +1522,101 @@ int32_t silk_Decode(                                   /* O    Returns error cod
     int16_t* samplesOut1_tmp[2];
     int32_t MS_pred_Q13[2] = {0};
     int16_t *resample_out_ptr;
-    //silk_decoder_state_t *s_channel_state = s_channel_state;
+    //silk_decoder_state_t *m_channel_state = m_channel_state;
     int32_t has_side;
     int32_t stereo_to_mono;
     int delay_stack_alloc;
 
-    assert(s_silk_DecControlStruct->nChannelsInternal == 1 || s_silk_DecControlStruct->nChannelsInternal == 2);
+    assert(m_silk_DecControlStruct->nChannelsInternal == 1 || m_silk_DecControlStruct->nChannelsInternal == 2);
+
+    m_silkScratch.rewind(); // new frame, no temporary array is in use
 
     /**********************************/
     /* Test if first frame in payload */
     /**********************************/
     if (newPacketFlag) {
-        for (n = 0; n < s_silk_DecControlStruct->nChannelsInternal; n++) {
-            s_channel_state[n].nFramesDecoded = 0; /* Used to count frames in packet */
+        for (n = 0; n < m_silk_DecControlStruct->nChannelsInternal; n++) {
+            m_channel_state[n].nFramesDecoded = 0; /* Used to count frames in packet */
         }
     }
 
     /* If Mono -> Stereo transition in bitstream: init state of second channel */
-    if (s_silk_DecControlStruct->nChannelsInternal > s_silk_decoder.get()->nChannelsInternal) {
+    if (m_silk_DecControlStruct->nChannelsInternal > m_silk_decoder.get()->nChannelsInternal) {
         ret += silk_init_decoder(1);
     }
 
-    stereo_to_mono = s_silk_DecControlStruct->nChannelsInternal == 1 && s_silk_decoder.get()->nChannelsInternal == 2 &&
-                     (s_silk_internalSampleRate == 1000 * s_channel_state[0].fs_kHz);
+    stereo_to_mono = m_silk_DecControlStruct->nChannelsInternal == 1 && m_silk_decoder.get()->nChannelsInternal == 2 &&
+                     (m_silk_internalSampleRate == 1000 * m_channel_state[0].fs_kHz);
 
-    if (s_channel_state[0].nFramesDecoded == 0) {
-        for (n = 0; n < s_silk_DecControlStruct->nChannelsInternal; n++) {
+    if (m_channel_state[0].nFramesDecoded == 0) {
+        for (n = 0; n < m_silk_DecControlStruct->nChannelsInternal; n++) {
             int32_t fs_kHz_dec;
-            if (s_payloadSize_ms == 0) {
+            if (m_payloadSize_ms == 0) {
                 /* Assuming packet loss, use 10 ms */
-                s_channel_state[n].nFramesPerPacket = 1;
-                s_channel_state[n].nb_subfr = 2;
-            } else if (s_payloadSize_ms == 10) {
-                s_channel_state[n].nFramesPerPacket = 1;
-                s_channel_state[n].nb_subfr = 2;
-            } else if (s_payloadSize_ms == 20) {
-                s_channel_state[n].nFramesPerPacket = 1;
-                s_channel_state[n].nb_subfr = 4;
-            } else if (s_payloadSize_ms == 40) {
-                s_channel_state[n].nFramesPerPacket = 2;
-                s_channel_state[n].nb_subfr = 4;
-            } else if (s_payloadSize_ms== 60) {
-                s_channel_state[n].nFramesPerPacket = 3;
-                s_channel_state[n].nb_subfr = 4;
+                m_channel_state[n].nFramesPerPacket = 1;
+                m_channel_state[n].nb_subfr = 2;
+            } else if (m_payloadSize_ms == 10) {
+                m_channel_state[n].nFramesPerPacket = 1;
+                m_channel_state[n].nb_subfr = 2;
+            } else if (m_payloadSize_ms == 20) {
+                m_channel_state[n].nFramesPerPacket = 1;
+                m_channel_state[n].nb_subfr = 4;
+            } else if (m_payloadSize_ms == 40) {
+                m_channel_state[n].nFramesPerPacket = 2;
+                m_channel_state[n].nb_subfr = 4;
+            } else if (m_payloadSize_ms== 60) {
+                m_channel_state[n].nFramesPerPacket = 3;
+                m_channel_state[n].nb_subfr = 4;
             } else {
                 OPUS_LOG_ERROR("Opus SILK: invalid frame size");
                 return OPUS_ERR;
             }
-            fs_kHz_dec = (s_silk_internalSampleRate >> 10) + 1;
+            fs_kHz_dec = (m_silk_internalSampleRate >> 10) + 1;
             if (fs_kHz_dec != 8 && fs_kHz_dec != 12 && fs_kHz_dec != 16) {
                 OPUS_LOG_ERROR("Opus SILK, invalid sampling frequency: %i", fs_kHz_dec);
                 return OPUS_ERR;
             }
-            ret += silk_decoder_set_fs(n, fs_kHz_dec, s_silk_DecControlStruct->API_sampleRate);
+            ret += silk_decoder_set_fs(n, fs_kHz_dec, m_silk_DecControlStruct->API_sampleRate);
         }
     }
 
-    if (s_silk_DecControlStruct->nChannelsAPI == 2 && s_silk_DecControlStruct->nChannelsInternal == 2 &&
-        (s_silk_decoder->nChannelsAPI == 1 || s_silk_decoder->nChannelsInternal == 1)) {
-        silk_memset(s_silk_decoder->sStereo.pred_prev_Q13, 0, sizeof(s_silk_decoder->sStereo.pred_prev_Q13));
-        silk_memset(s_silk_decoder->sStereo.sSide, 0, sizeof(s_silk_decoder->sStereo.sSide));
-        silk_memcpy(&s_resampler_state[n], &s_resampler_state[n],
+    if (m_silk_DecControlStruct->nChannelsAPI == 2 && m_silk_DecControlStruct->nChannelsInternal == 2 &&
+        (m_silk_decoder->nChannelsAPI == 1 || m_silk_decoder->nChannelsInternal == 1)) {
+        silk_memset(m_silk_decoder->sStereo.pred_prev_Q13, 0, sizeof(m_silk_decoder->sStereo.pred_prev_Q13));
+        silk_memset(m_silk_decoder->sStereo.sSide, 0, sizeof(m_silk_decoder->sStereo.sSide));
+        silk_memcpy(&m_resampler_state[n], &m_resampler_state[n],
                     sizeof(silk_resampler_state_struct_t));
     }
-    s_silk_decoder->nChannelsAPI = s_silk_DecControlStruct->nChannelsAPI;
-    s_silk_decoder->nChannelsInternal = s_silk_DecControlStruct->nChannelsInternal;
+    m_silk_decoder->nChannelsAPI = m_silk_DecControlStruct->nChannelsAPI;
+    m_silk_decoder->nChannelsInternal = m_silk_DecControlStruct->nChannelsInternal;
 
-    if (s_silk_DecControlStruct->API_sampleRate > (int32_t)MAX_API_FS_KHZ * 1000 || s_silk_DecControlStruct->API_sampleRate < 8000) {
-        OPUS_LOG_ERROR("Opus SILK, invalid sampling rate: %i", s_silk_DecControlStruct->API_sampleRate);
+    if (m_silk_DecControlStruct->API_sampleRate > (int32_t)MAX_API_FS_KHZ * 1000 || m_silk_DecControlStruct->API_sampleRate < 8000) {
+        OPUS_LOG_ERROR("Opus SILK, invalid sampling rate: %i", m_silk_DecControlStruct->API_sampleRate);
         ret = OPUS_ERR;
 
         return (ret);
     }
 
-    if (lostFlag != FLAG_PACKET_LOST && s_channel_state[0].nFramesDecoded == 0) {
+    if (lostFlag != FLAG_PACKET_LOST && m_channel_state[0].nFramesDecoded == 0) {
         /* First decoder call for this payload */
         /* Decode VAD flags and LBRR flag */
-        for (n = 0; n < s_silk_DecControlStruct->nChannelsInternal; n++) {
-            for (i = 0; i < s_channel_state[n].nFramesPerPacket; i++) {
-                s_channel_state[n].VAD_flags[i] = ec_dec_bit_logp(1);
+        for (n = 0; n < m_silk_DecControlStruct->nChannelsInternal; n++) {
+            for (i = 0; i < m_channel_state[n].nFramesPerPacket; i++) {
+                m_channel_state[n].VAD_flags[i] = m_celt.ec_dec_bit_logp(1);
             }
-            s_channel_state[n].LBRR_flag = ec_dec_bit_logp(1);
+            m_channel_state[n].LBRR_flag = m_celt.ec_dec_bit_logp(1);
         }
         /* Decode LBRR flags */
-        for (n = 0; n < s_silk_DecControlStruct->nChannelsInternal; n++) {
-            silk_memset(s_channel_state[n].LBRR_flags, 0, sizeof(s_channel_state[n].LBRR_flags));
-            if (s_channel_state[n].LBRR_flag) {
-                if (s_channel_state[n].nFramesPerPacket == 1) {
-                    s_channel_state[n].LBRR_flags[0] = 1;
+        for (n = 0; n < m_silk_DecControlStruct->nChannelsInternal; n++) {
+            silk_memset(m_channel_state[n].LBRR_flags, 0, sizeof(m_channel_state[n].LBRR_flags));
+            if (m_channel_state[n].LBRR_flag) {
+                if (m_channel_state[n].nFramesPerPacket == 1) {
+                    m_channel_state[n].LBRR_flags[0] = 1;
                 } else {
                     LBRR_symbol =
-                        ec_dec_icdf(silk_LBRR_flags_iCDF_ptr[s_channel_state[n].nFramesPerPacket - 2], 8) + 1;
-                    for (i = 0; i < s_channel_state[n].nFramesPerPacket; i++) {
-                        s_channel_state[n].LBRR_flags[i] = silk_RSHIFT(LBRR_symbol, i) & 1;
+                        m_celt.ec_dec_icdf(silk_LBRR_flags_iCDF_ptr[m_channel_state[n].nFramesPerPacket - 2], 8) + 1;
+                    for (i = 0; i < m_channel_state[n].nFramesPerPacket; i++) {
+                        m_channel_state[n].LBRR_flags[i] = silk_RSHIFT(LBRR_symbol, i) & 1;
                     }
                 }
             }
@@ -1600,27 +1624,27 @@ int32_t silk_Decode(                                   /* O    Returns error cod
 
         if (lostFlag == FLAG_DECODE_NORMAL) {
             /* Regular decoding: skip all LBRR data */
-            for (i = 0; i < s_channel_state[0].nFramesPerPacket; i++) {
-                for (n = 0; n < s_silk_DecControlStruct->nChannelsInternal; n++) {
-                    if (s_channel_state[n].LBRR_flags[i]) {
+            for (i = 0; i < m_channel_state[0].nFramesPerPacket; i++) {
+                for (n = 0; n < m_silk_DecControlStruct->nChannelsInternal; n++) {
+                    if (m_channel_state[n].LBRR_flags[i]) {
                         int16_t pulses[MAX_FRAME_LENGTH];
                         int32_t condCoding;
 
-                        if (s_silk_DecControlStruct->nChannelsInternal == 2 && n == 0) {
+                        if (m_silk_DecControlStruct->nChannelsInternal == 2 && n == 0) {
                             silk_stereo_decode_pred(MS_pred_Q13);
-                            if (s_channel_state[1].LBRR_flags[i] == 0) {
+                            if (m_channel_state[1].LBRR_flags[i] == 0) {
                                 silk_stereo_decode_mid_only(&decode_only_middle);
                             }
                         }
                         /* Use conditional coding if previous frame available */
-                        if (i > 0 && s_channel_state[n].LBRR_flags[i - 1]) {
+                        if (i > 0 && m_channel_state[n].LBRR_flags[i - 1]) {
                             condCoding = CODE_CONDITIONALLY;
                         } else {
                             condCoding = CODE_INDEPENDENTLY;
                         }
                         silk_decode_indices(n, i, 1, condCoding);
-                        silk_decode_pulses(pulses, s_channel_state[n].indices.signalType,
-                                           s_channel_state[n].indices.quantOffsetType, s_channel_state[n].frame_length);
+                        silk_decode_pulses(pulses, m_channel_state[n].indices.signalType,
+                                           m_channel_state[n].indices.quantOffsetType, m_channel_state[n].frame_length);
                     }
                 }
             }
@@ -1628,71 +1652,71 @@ int32_t silk_Decode(                                   /* O    Returns error cod
     }
 
     /* Get MS predictor index */
-    if (s_silk_DecControlStruct->nChannelsInternal == 2) {
+    if (m_silk_DecControlStruct->nChannelsInternal == 2) {
         if (lostFlag == FLAG_DECODE_NORMAL ||
-            (lostFlag == FLAG_DECODE_LBRR && s_channel_state[0].LBRR_flags[s_channel_state[0].nFramesDecoded] == 1)) {
+            (lostFlag == FLAG_DECODE_LBRR && m_channel_state[0].LBRR_flags[m_channel_state[0].nFramesDecoded] == 1)) {
             silk_stereo_decode_pred(MS_pred_Q13);
             /* For LBRR data, decode mid-only flag only if side-channel's LBRR flag is false */
-            if ((lostFlag == FLAG_DECODE_NORMAL && s_channel_state[1].VAD_flags[s_channel_state[0].nFramesDecoded] == 0) ||
-                (lostFlag == FLAG_DECODE_LBRR && s_channel_state[1].LBRR_flags[s_channel_state[0].nFramesDecoded] == 0)) {
+            if ((lostFlag == FLAG_DECODE_NORMAL && m_channel_state[1].VAD_flags[m_channel_state[0].nFramesDecoded] == 0) ||
+                (lostFlag == FLAG_DECODE_LBRR && m_channel_state[1].LBRR_flags[m_channel_state[0].nFramesDecoded] == 0)) {
                 silk_stereo_decode_mid_only(&decode_only_middle);
             } else {
                 decode_only_middle = 0;
             }
         } else {
             for (n = 0; n < 2; n++) {
-                MS_pred_Q13[n] = s_silk_decoder->sStereo.pred_prev_Q13[n];
+                MS_pred_Q13[n] = m_silk_decoder->sStereo.pred_prev_Q13[n];
             }
         }
     }
 
     /* Reset side channel decoder prediction memory for first frame with side coding */
-    if (s_silk_DecControlStruct->nChannelsInternal == 2 && decode_only_middle == 0 && s_silk_decoder->prev_decode_only_middle == 1) {
-        silk_memset(s_channel_state[1].outBuf, 0, sizeof(s_channel_state[1].outBuf));
-        silk_memset(s_channel_state[1].sLPC_Q14_buf, 0, sizeof(s_channel_state[1].sLPC_Q14_buf));
-        s_channel_state[1].lagPrev = 100;
-        s_channel_state[1].LastGainIndex = 10;
-        s_channel_state[1].prevSignalType = TYPE_NO_VOICE_ACTIVITY;
-        s_channel_state[1].first_frame_after_reset = 1;
+    if (m_silk_DecControlStruct->nChannelsInternal == 2 && decode_only_middle == 0 && m_silk_decoder->prev_decode_only_middle == 1) {
+        silk_memset(m_channel_state[1].outBuf, 0, sizeof(m_channel_state[1].outBuf));
+        silk_memset(m_channel_state[1].sLPC_Q14_buf, 0, sizeof(m_channel_state[1].sLPC_Q14_buf));
+        m_channel_state[1].lagPrev = 100;
+        m_channel_state[1].LastGainIndex = 10;
+        m_channel_state[1].prevSignalType = TYPE_NO_VOICE_ACTIVITY;
+        m_channel_state[1].first_frame_after_reset = 1;
     }
 
     /* Check if the temp buffer fits into the output PCM buffer. If it fits,
        we can delay allocating the temp buffer until after the SILK peak stack
        usage. We need to use a < and not a <= because of the two extra samples. */
-    delay_stack_alloc = s_silk_DecControlStruct->internalSampleRate * s_silk_DecControlStruct->nChannelsInternal <
-                        s_silk_DecControlStruct->API_sampleRate * s_silk_DecControlStruct->nChannelsAPI;
+    delay_stack_alloc = m_silk_DecControlStruct->internalSampleRate * m_silk_DecControlStruct->nChannelsInternal <
+                        m_silk_DecControlStruct->API_sampleRate * m_silk_DecControlStruct->nChannelsAPI;
 
-    size_t samplesOut1_tmp_storage1_len = delay_stack_alloc ? ALLOC_NONE : s_silk_DecControlStruct->nChannelsInternal * (s_channel_state[0].frame_length + 2);
-    auto samplesOut1_tmp_storage1 = silk_malloc_arr<int16_t>(samplesOut1_tmp_storage1_len * sizeof(int16_t));
+    size_t samplesOut1_tmp_storage1_len = delay_stack_alloc ? ALLOC_NONE : m_silk_DecControlStruct->nChannelsInternal * (m_channel_state[0].frame_length + 2);
+    auto samplesOut1_tmp_storage1 = silk_scratch_arr<int16_t>(samplesOut1_tmp_storage1_len);
 
     if (delay_stack_alloc) {
         samplesOut1_tmp[0] = samplesOut;
-        samplesOut1_tmp[1] = samplesOut + s_channel_state[0].frame_length + 2;
+        samplesOut1_tmp[1] = samplesOut + m_channel_state[0].frame_length + 2;
     } else {
         samplesOut1_tmp[0] = samplesOut1_tmp_storage1.get();
-        samplesOut1_tmp[1] = samplesOut1_tmp_storage1.get() + s_channel_state[0].frame_length + 2;
+        samplesOut1_tmp[1] = samplesOut1_tmp_storage1.get() + m_channel_state[0].frame_length + 2;
     }
 
     if (lostFlag == FLAG_DECODE_NORMAL) {
         has_side = !decode_only_middle;
     } else {
         has_side =
-            !s_silk_decoder->prev_decode_only_middle || (s_silk_DecControlStruct->nChannelsInternal == 2 && lostFlag == FLAG_DECODE_LBRR &&
-                                                s_channel_state[1].LBRR_flags[s_channel_state[1].nFramesDecoded] == 1);
+            !m_silk_decoder->prev_decode_only_middle || (m_silk_DecControlStruct->nChannelsInternal == 2 && lostFlag == FLAG_DECODE_LBRR &&
+                                                m_channel_state[1].LBRR_flags[m_channel_state[1].nFramesDecoded] == 1);
     }
     /* Call decoder for one frame */
-    for (n = 0; n < s_silk_DecControlStruct->nChannelsInternal; n++) {
+    for (n = 0; n < m_silk_DecControlStruct->nChannelsInternal; n++) {
         if (n == 0 || has_side) {
             int32_t FrameIndex;
             int32_t condCoding;
 
-            FrameIndex = s_channel_state[0].nFramesDecoded - n;
+            FrameIndex = m_channel_state[0].nFramesDecoded - n;
             /* Use independent coding if no previous frame available */
             if (FrameIndex <= 0) {
                 condCoding = CODE_INDEPENDENTLY;
             } else if (lostFlag == FLAG_DECODE_LBRR) {
-                condCoding = s_channel_state[n].LBRR_flags[FrameIndex - 1] ? CODE_CONDITIONALLY : CODE_INDEPENDENTLY;
-            } else if (n > 0 && s_silk_decoder->prev_decode_only_middle) {
+                condCoding = m_channel_state[n].LBRR_flags[FrameIndex - 1] ? CODE_CONDITIONALLY : CODE_INDEPENDENTLY;
+            } else if (n > 0 && m_silk_decoder->prev_decode_only_middle) {
                 /* If we skipped a side frame in this packet, we don't
                    need LTP scaling; the LTP state is well-defined. */
                 condCoding = CODE_INDEPENDENTLY_NO_LTP_SCALING;
@@ -1704,58 +1728,58 @@ int32_t silk_Decode(                                   /* O    Returns error cod
         } else {
             silk_memset(&samplesOut1_tmp[n][2], 0, nSamplesOutDec * sizeof(int16_t));
         }
-        s_channel_state[n].nFramesDecoded++;
+        m_channel_state[n].nFramesDecoded++;
     }
 
-    if (s_silk_DecControlStruct->nChannelsAPI == 2 && s_silk_DecControlStruct->nChannelsInternal == 2) {
+    if (m_silk_DecControlStruct->nChannelsAPI == 2 && m_silk_DecControlStruct->nChannelsInternal == 2) {
         /* Convert Mid/Side to Left/Right */
-        silk_stereo_MS_to_LR(&s_silk_decoder->sStereo, samplesOut1_tmp[0], samplesOut1_tmp[1], MS_pred_Q13,
-                             s_channel_state[0].fs_kHz, nSamplesOutDec);
+        silk_stereo_MS_to_LR(&m_silk_decoder->sStereo, samplesOut1_tmp[0], samplesOut1_tmp[1], MS_pred_Q13,
+                             m_channel_state[0].fs_kHz, nSamplesOutDec);
     } else {
         /* Buffering */
-        silk_memcpy(samplesOut1_tmp[0], s_silk_decoder->sStereo.sMid, 2 * sizeof(int16_t));
-        silk_memcpy(s_silk_decoder->sStereo.sMid, &samplesOut1_tmp[0][nSamplesOutDec], 2 * sizeof(int16_t));
+        silk_memcpy(samplesOut1_tmp[0], m_silk_decoder->sStereo.sMid, 2 * sizeof(int16_t));
+        silk_memcpy(m_silk_decoder->sStereo.sMid, &samplesOut1_tmp[0][nSamplesOutDec], 2 * sizeof(int16_t));
     }
 
     /* Number of output samples */
-    *nSamplesOut = silk_DIV32(nSamplesOutDec * s_silk_DecControlStruct->API_sampleRate, silk_SMULBB(s_channel_state[0].fs_kHz, 1000));
+    *nSamplesOut = silk_DIV32(nSamplesOutDec * m_silk_DecControlStruct->API_sampleRate, silk_SMULBB(m_channel_state[0].fs_kHz, 1000));
 
     /* Set up pointers to temp buffers */
-    size_t samplesOut2_tmp_len = s_silk_DecControlStruct->nChannelsAPI == 2 ? *nSamplesOut : ALLOC_NONE;
-    auto samplesOut2_tmp = silk_malloc_arr<int16_t>(samplesOut2_tmp_len * sizeof(int16_t));
+    size_t samplesOut2_tmp_len = m_silk_DecControlStruct->nChannelsAPI == 2 ? *nSamplesOut : ALLOC_NONE;
+    auto samplesOut2_tmp = silk_scratch_arr<int16_t>(samplesOut2_tmp_len);
 
-    if (s_silk_DecControlStruct->nChannelsAPI == 2) {
+    if (m_silk_DecControlStruct->nChannelsAPI == 2) {
         resample_out_ptr = samplesOut2_tmp.get();
     } else {
         resample_out_ptr = samplesOut;
     }
 
-    size_t samplesOut1_tmp_storage2_len = delay_stack_alloc ? s_silk_DecControlStruct->nChannelsInternal * (s_channel_state[0].frame_length + 2) : ALLOC_NONE;
-    auto samplesOut1_tmp_storage2 = silk_malloc_arr<int16_t>(samplesOut1_tmp_storage2_len * sizeof(int16_t));
+    size_t samplesOut1_tmp_storage2_len = delay_stack_alloc ? m_silk_DecControlStruct->nChannelsInternal * (m_channel_state[0].frame_length + 2) : ALLOC_NONE;
+    auto samplesOut1_tmp_storage2 = silk_scratch_arr<int16_t>(samplesOut1_tmp_storage2_len);
 
     if (delay_stack_alloc) {
-    //    size_t val1 = s_silk_DecControlStruct->nChannelsInternal * (s_channel_state[0].frame_length + 2);
+    //    size_t val1 = m_silk_DecControlStruct->nChannelsInternal * (m_channel_state[0].frame_length + 2);
         size_t val2 = samplesOut1_tmp_storage2_len *sizeof(int16_t);
         //size_t n = val1 * val2;
         memcpy(samplesOut1_tmp_storage2.get(), samplesOut, val2);
         samplesOut1_tmp[0] = samplesOut1_tmp_storage2.get();
-        samplesOut1_tmp[1] = samplesOut1_tmp_storage2.get() + s_channel_state[0].frame_length + 2;
+        samplesOut1_tmp[1] = samplesOut1_tmp_storage2.get() + m_channel_state[0].frame_length + 2;
     }
-    for (n = 0; n < silk_min(s_silk_DecControlStruct->nChannelsAPI, s_silk_DecControlStruct->nChannelsInternal); n++) {
+    for (n = 0; n < silk_min(m_silk_DecControlStruct->nChannelsAPI, m_silk_DecControlStruct->nChannelsInternal); n++) {
 
         /* Resample decoded signal to API_sampleRate */
         ret +=
             silk_resampler(n, resample_out_ptr, &samplesOut1_tmp[n][1], nSamplesOutDec);
 
         /* Interleave if stereo output and stereo stream */
-        if (s_silk_DecControlStruct->nChannelsAPI == 2) {
+        if (m_silk_DecControlStruct->nChannelsAPI == 2) {
             for (i = 0; i < *nSamplesOut; i++) {
                 samplesOut[n + 2 * i] = resample_out_ptr[i];
             }
         }
     }
     /* Create two channel output from mono stream */
-    if (s_silk_DecControlStruct->nChannelsAPI == 2 && s_silk_DecControlStruct->nChannelsInternal == 1) {
+    if (m_silk_DecControlStruct->nChannelsAPI == 2 && m_silk_DecControlStruct->nChannelsInternal == 1) {
         if (stereo_to_mono) {
             /* Resample right channel for newly collapsed stereo just in case
                we weren't doing collapsing when switching to mono */
@@ -1772,25 +1796,25 @@ int32_t silk_Decode(                                   /* O    Returns error cod
         }
     }
     /* Export pitch lag, measured at 48 kHz sampling rate */
-    if (s_channel_state[0].prevSignalType == TYPE_VOICED) {
+    if (m_channel_state[0].prevSignalType == TYPE_VOICED) {
         int mult_tab[3] = {6, 4, 3};
-        s_silk_DecControlStruct->prevPitchLag = s_channel_state[0].lagPrev * mult_tab[(s_channel_state[0].fs_kHz - 8) >> 2];
+        m_silk_DecControlStruct->prevPitchLag = m_channel_state[0].lagPrev * mult_tab[(m_channel_state[0].fs_kHz - 8) >> 2];
     } else {
-        s_silk_DecControlStruct->prevPitchLag = 0;
+        m_silk_DecControlStruct->prevPitchLag = 0;
     }
 
     if (lostFlag == FLAG_PACKET_LOST) {
         /* On packet loss, remove the gain clamping to prevent having the energy "bounce back"
            if we lose packets when the energy is going down */
-        for (i = 0; i < s_silk_decoder->nChannelsInternal; i++) s_channel_state[i].LastGainIndex = 10;
+        for (i = 0; i < m_silk_decoder->nChannelsInternal; i++) m_channel_state[i].LastGainIndex = 10;
     } else {
-        s_silk_decoder->prev_decode_only_middle = decode_only_middle;
+        m_silk_decoder->prev_decode_only_middle = decode_only_middle;
     }
     return ret;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Decoder functions */
-int32_t silk_Get_Decoder_Size(int32_t* decSizeBytes) {
+int32_t SilkDecoder::silk_Get_Decoder_Size(int32_t* decSizeBytes) {
     int32_t ret = SILK_NO_ERROR;
 
     *decSizeBytes = sizeof(silk_decoder_t) + sizeof(silk_decoder_state_t);
@@ -1800,73 +1824,73 @@ int32_t silk_Get_Decoder_Size(int32_t* decSizeBytes) {
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /* Reset decoder state */
-int32_t silk_InitDecoder() {
+int32_t SilkDecoder::silk_InitDecoder() {
     int32_t n, ret = SILK_NO_ERROR;
-   // s_channel_state = (silk_decoder_state_t*) &decState->s_channel_state;
+   // m_channel_state = (silk_decoder_state_t*) &decState->m_channel_state;
 
     for (n = 0; n < DECODER_NUM_CHANNELS; n++) {
         ret = silk_init_decoder(n);
     }
-    memset(&s_silk_decoder->sStereo, 0, sizeof(s_silk_decoder->sStereo));
-    s_silk_decoder->prev_decode_only_middle = 0;
+    memset(&m_silk_decoder->sStereo, 0, sizeof(m_silk_decoder->sStereo));
+    m_silk_decoder->prev_decode_only_middle = 0;
     return ret;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /* Core decoder. Performs inverse NSQ operation LTP + LPC */
-void silk_decode_core(uint8_t n, int16_t xq[], const int16_t pulses[MAX_FRAME_LENGTH]) {
+void SilkDecoder::silk_decode_core(uint8_t n, int16_t xq[], const int16_t pulses[MAX_FRAME_LENGTH]) {
     int32_t i, k, lag = 0, start_idx, sLTP_buf_idx, NLSF_interpolation_flag, signalType;
     int16_t *A_Q12, *B_Q14, *pxq, A_Q12_tmp[MAX_LPC_ORDER];
     int32_t  LTP_pred_Q13, LPC_pred_Q10, Gain_Q10, inv_gain_Q31, gain_adj_Q16, rand_seed, offset_Q10;
     int32_t *pred_lag_ptr, *pexc_Q14, *pres_Q14;
 
-    assert(s_channel_state[n].prev_gain_Q16 != 0);
+    assert(m_channel_state[n].prev_gain_Q16 != 0);
 
-    auto sLTP     = silk_malloc_arr<int16_t>(s_channel_state[n].ltp_mem_length * sizeof(int16_t));
-    auto sLTP_Q15 = silk_malloc_arr<int32_t>(s_channel_state[n].ltp_mem_length + s_channel_state[n].frame_length * sizeof(int32_t));
-    auto res_Q14  = silk_malloc_arr<int32_t>(s_channel_state[n].subfr_length * sizeof(int32_t));
-    auto sLPC_Q14 = silk_malloc_arr<int32_t>(s_channel_state[n].subfr_length + MAX_LPC_ORDER * sizeof(int32_t));
+    auto sLTP     = silk_scratch_arr<int16_t>(m_channel_state[n].ltp_mem_length);
+    auto sLTP_Q15 = silk_scratch_arr<int32_t>(m_channel_state[n].ltp_mem_length + m_channel_state[n].frame_length);
+    auto res_Q14  = silk_scratch_arr<int32_t>(m_channel_state[n].subfr_length);
+    auto sLPC_Q14 = silk_scratch_arr<int32_t>(m_channel_state[n].subfr_length + MAX_LPC_ORDER);
 
-    offset_Q10 = silk_Quantization_Offsets_Q10[s_channel_state[n].indices.signalType >> 1][s_channel_state[n].indices.quantOffsetType];
+    offset_Q10 = silk_Quantization_Offsets_Q10[m_channel_state[n].indices.signalType >> 1][m_channel_state[n].indices.quantOffsetType];
 
-    if(s_channel_state[n].indices.NLSFInterpCoef_Q2 < 1 << 2) { NLSF_interpolation_flag = 1; }
+    if(m_channel_state[n].indices.NLSFInterpCoef_Q2 < 1 << 2) { NLSF_interpolation_flag = 1; }
     else { NLSF_interpolation_flag = 0; }
 
     /* Decode excitation */
-    rand_seed = s_channel_state[n].indices.Seed;
-    for(i = 0; i < s_channel_state[n].frame_length; i++) {
+    rand_seed = m_channel_state[n].indices.Seed;
+    for(i = 0; i < m_channel_state[n].frame_length; i++) {
         rand_seed = silk_RAND(rand_seed);
-        s_channel_state[n].exc_Q14[i] = silk_LSHIFT((int32_t)pulses[i], 14);
-        if(s_channel_state[n].exc_Q14[i] > 0) { s_channel_state[n].exc_Q14[i] -= QUANT_LEVEL_ADJUST_Q10 << 4; }
-        else if(s_channel_state[n].exc_Q14[i] < 0) { s_channel_state[n].exc_Q14[i] += QUANT_LEVEL_ADJUST_Q10 << 4; }
-        s_channel_state[n].exc_Q14[i] += offset_Q10 << 4;
-        if(rand_seed < 0) { s_channel_state[n].exc_Q14[i] = -s_channel_state[n].exc_Q14[i]; }
+        m_channel_state[n].exc_Q14[i] = silk_LSHIFT((int32_t)pulses[i], 14);
+        if(m_channel_state[n].exc_Q14[i] > 0) { m_channel_state[n].exc_Q14[i] -= QUANT_LEVEL_ADJUST_Q10 << 4; }
+        else if(m_channel_state[n].exc_Q14[i] < 0) { m_channel_state[n].exc_Q14[i] += QUANT_LEVEL_ADJUST_Q10 << 4; }
+        m_channel_state[n].exc_Q14[i] += offset_Q10 << 4;
+        if(rand_seed < 0) { m_channel_state[n].exc_Q14[i] = -m_channel_state[n].exc_Q14[i]; }
 
         rand_seed = silk_ADD32_ovflw(rand_seed, pulses[i]);
     }
 
     /* Copy LPC state */
-    memcpy(sLPC_Q14.get(), s_channel_state[n].sLPC_Q14_buf, MAX_LPC_ORDER * sizeof(int32_t));
+    memcpy(sLPC_Q14.get(), m_channel_state[n].sLPC_Q14_buf, MAX_LPC_ORDER * sizeof(int32_t));
 
-    pexc_Q14 = s_channel_state[n].exc_Q14;
+    pexc_Q14 = m_channel_state[n].exc_Q14;
     pxq = xq;
-    sLTP_buf_idx =s_channel_state[n].ltp_mem_length;
+    sLTP_buf_idx =m_channel_state[n].ltp_mem_length;
     /* Loop over subframes */
-    for(k = 0; k < s_channel_state[n].nb_subfr; k++) {
+    for(k = 0; k < m_channel_state[n].nb_subfr; k++) {
         pres_Q14 = res_Q14.get();
-        A_Q12 = s_silk_decoder_control->PredCoef_Q12[k >> 1];
+        A_Q12 = m_silk_decoder_control->PredCoef_Q12[k >> 1];
 
         /* Preload LPC coeficients to array on stack. Gives small performance gain */
-        memcpy(A_Q12_tmp, A_Q12,s_channel_state[n].LPC_order * sizeof(int16_t));
-        B_Q14 = &s_silk_decoder_control->LTPCoef_Q14[k * LTP_ORDER];
-        signalType = s_channel_state[n].indices.signalType;
+        memcpy(A_Q12_tmp, A_Q12,m_channel_state[n].LPC_order * sizeof(int16_t));
+        B_Q14 = &m_silk_decoder_control->LTPCoef_Q14[k * LTP_ORDER];
+        signalType = m_channel_state[n].indices.signalType;
 
-        Gain_Q10 = silk_RSHIFT(s_silk_decoder_control->Gains_Q16[k], 6);
-        inv_gain_Q31 = silk_INVERSE32_varQ(s_silk_decoder_control->Gains_Q16[k], 47);
+        Gain_Q10 = silk_RSHIFT(m_silk_decoder_control->Gains_Q16[k], 6);
+        inv_gain_Q31 = silk_INVERSE32_varQ(m_silk_decoder_control->Gains_Q16[k], 47);
 
         /* Calculate gain adjustment factor */
-        if (s_silk_decoder_control->Gains_Q16[k] != s_channel_state[n].prev_gain_Q16) {
-            gain_adj_Q16 = silk_DIV32_varQ(s_channel_state[n].prev_gain_Q16, s_silk_decoder_control->Gains_Q16[k], 16);
+        if (m_silk_decoder_control->Gains_Q16[k] != m_channel_state[n].prev_gain_Q16) {
+            gain_adj_Q16 = silk_DIV32_varQ(m_channel_state[n].prev_gain_Q16, m_silk_decoder_control->Gains_Q16[k], 16);
 
             /* Scale short term state */
             for(i = 0; i < MAX_LPC_ORDER; i++) { sLPC_Q14[i] = silk_SMULWW(gain_adj_Q16, sLPC_Q14[i]); }
@@ -1875,37 +1899,37 @@ void silk_decode_core(uint8_t n, int16_t xq[], const int16_t pulses[MAX_FRAME_LE
 
         /* Save inv_gain */
         assert(inv_gain_Q31 != 0);
-        s_channel_state[n].prev_gain_Q16 = s_silk_decoder_control->Gains_Q16[k];
+        m_channel_state[n].prev_gain_Q16 = m_silk_decoder_control->Gains_Q16[k];
 
         /* Avoid abrupt transition from voiced PLC to unvoiced normal decoding */
-        if(s_channel_state[n].lossCnt && s_channel_state[n].prevSignalType == TYPE_VOICED && s_channel_state[n].indices.signalType != TYPE_VOICED && k < MAX_NB_SUBFR / 2) {
+        if(m_channel_state[n].lossCnt && m_channel_state[n].prevSignalType == TYPE_VOICED && m_channel_state[n].indices.signalType != TYPE_VOICED && k < MAX_NB_SUBFR / 2) {
             memset(B_Q14, 0, LTP_ORDER * sizeof(int16_t));
             B_Q14[LTP_ORDER / 2] = SILK_FIX_CONST(0.25, 14);
 
             signalType = TYPE_VOICED;
-            s_silk_decoder_control->pitchL[k] = s_channel_state[n].lagPrev;
+            m_silk_decoder_control->pitchL[k] = m_channel_state[n].lagPrev;
         }
 
         if(signalType == TYPE_VOICED) {
             /* Voiced */
-            lag = s_silk_decoder_control->pitchL[k];
+            lag = m_silk_decoder_control->pitchL[k];
 
             /* Re-whitening */
             if(k == 0 || (k == 2 && NLSF_interpolation_flag)) {
                 /* Rewhiten with new A coefs */
-                start_idx = s_channel_state[n].ltp_mem_length - lag - s_channel_state[n].LPC_order - LTP_ORDER / 2;
+                start_idx = m_channel_state[n].ltp_mem_length - lag - m_channel_state[n].LPC_order - LTP_ORDER / 2;
                 assert(start_idx > 0);
 
-                if(k == 2) { memcpy(&s_channel_state[n].outBuf[s_channel_state[n].ltp_mem_length], xq, 2 * s_channel_state[n].subfr_length * sizeof(int16_t)); }
+                if(k == 2) { memcpy(&m_channel_state[n].outBuf[m_channel_state[n].ltp_mem_length], xq, 2 * m_channel_state[n].subfr_length * sizeof(int16_t)); }
 
-                silk_LPC_analysis_filter(&sLTP[start_idx], &s_channel_state[n].outBuf[start_idx + k * s_channel_state[n].subfr_length], A_Q12, s_channel_state[n].ltp_mem_length - start_idx, s_channel_state[n].LPC_order);
+                silk_LPC_analysis_filter(&sLTP[start_idx], &m_channel_state[n].outBuf[start_idx + k * m_channel_state[n].subfr_length], A_Q12, m_channel_state[n].ltp_mem_length - start_idx, m_channel_state[n].LPC_order);
 
                 /* After rewhitening the LTP state is unscaled */
                 if(k == 0) {
                     /* Do LTP downscaling to reduce inter-packet dependency */
-                    inv_gain_Q31 = silk_LSHIFT(silk_SMULWB(inv_gain_Q31, s_silk_decoder_control->LTP_scale_Q14), 2);
+                    inv_gain_Q31 = silk_LSHIFT(silk_SMULWB(inv_gain_Q31, m_silk_decoder_control->LTP_scale_Q14), 2);
                 }
-                for(i = 0; i < lag + LTP_ORDER / 2; i++) { sLTP_Q15[sLTP_buf_idx - i - 1] = silk_SMULWB(inv_gain_Q31, sLTP[s_channel_state[n].ltp_mem_length - i - 1]); }
+                for(i = 0; i < lag + LTP_ORDER / 2; i++) { sLTP_Q15[sLTP_buf_idx - i - 1] = silk_SMULWB(inv_gain_Q31, sLTP[m_channel_state[n].ltp_mem_length - i - 1]); }
             }
             else {
                 /* Update LTP state when Gain changes */
@@ -1919,7 +1943,7 @@ void silk_decode_core(uint8_t n, int16_t xq[], const int16_t pulses[MAX_FRAME_LE
         if(signalType == TYPE_VOICED) {
             /* Set up pointer */
             pred_lag_ptr = &sLTP_Q15[sLTP_buf_idx - lag + LTP_ORDER / 2];
-            for(i = 0; i < s_channel_state[n].subfr_length; i++) {
+            for(i = 0; i < m_channel_state[n].subfr_length; i++) {
                 /* Unrolled loop */
                 /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
                 LTP_pred_Q13 = 2;
@@ -1940,11 +1964,11 @@ void silk_decode_core(uint8_t n, int16_t xq[], const int16_t pulses[MAX_FRAME_LE
         }
         else { pres_Q14 = pexc_Q14; }
 
-        for(i = 0; i < s_channel_state[n].subfr_length; i++) {
+        for(i = 0; i < m_channel_state[n].subfr_length; i++) {
             /* Short-term prediction */
-            assert(s_channel_state[n].LPC_order == 10 || s_channel_state[n].LPC_order == 16);
+            assert(m_channel_state[n].LPC_order == 10 || m_channel_state[n].LPC_order == 16);
             /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
-            LPC_pred_Q10 = silk_RSHIFT(s_channel_state[n].LPC_order, 1);
+            LPC_pred_Q10 = silk_RSHIFT(m_channel_state[n].LPC_order, 1);
             LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14[MAX_LPC_ORDER + i - 1], A_Q12_tmp[0]);
             LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14[MAX_LPC_ORDER + i - 2], A_Q12_tmp[1]);
             LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14[MAX_LPC_ORDER + i - 3], A_Q12_tmp[2]);
@@ -1955,7 +1979,7 @@ void silk_decode_core(uint8_t n, int16_t xq[], const int16_t pulses[MAX_FRAME_LE
             LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14[MAX_LPC_ORDER + i - 8], A_Q12_tmp[7]);
             LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14[MAX_LPC_ORDER + i - 9], A_Q12_tmp[8]);
             LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14[MAX_LPC_ORDER + i - 10], A_Q12_tmp[9]);
-            if(s_channel_state[n].LPC_order == 16) {
+            if(m_channel_state[n].LPC_order == 16) {
                 LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14[MAX_LPC_ORDER + i - 11], A_Q12_tmp[10]);
                 LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14[MAX_LPC_ORDER + i - 12], A_Q12_tmp[11]);
                 LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14[MAX_LPC_ORDER + i - 13], A_Q12_tmp[12]);
@@ -1972,41 +1996,41 @@ void silk_decode_core(uint8_t n, int16_t xq[], const int16_t pulses[MAX_FRAME_LE
         }
 
         /* Update LPC filter state */
-        silk_memcpy(sLPC_Q14.get(), &sLPC_Q14[s_channel_state[n].subfr_length], MAX_LPC_ORDER * sizeof(int32_t));
-        pexc_Q14 += s_channel_state[n].subfr_length;
-        pxq += s_channel_state[n].subfr_length;
+        silk_memcpy(sLPC_Q14.get(), &sLPC_Q14[m_channel_state[n].subfr_length], MAX_LPC_ORDER * sizeof(int32_t));
+        pexc_Q14 += m_channel_state[n].subfr_length;
+        pxq += m_channel_state[n].subfr_length;
     }
 
     /* Save LPC state */
-    memcpy(s_channel_state[n].sLPC_Q14_buf, sLPC_Q14.get(), MAX_LPC_ORDER * sizeof(int32_t));
+    memcpy(m_channel_state[n].sLPC_Q14_buf, sLPC_Q14.get(), MAX_LPC_ORDER * sizeof(int32_t));
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Decode frame */
-int32_t silk_decode_frame(uint8_t n,
+int32_t SilkDecoder::silk_decode_frame(uint8_t n,
                           int16_t pOut[],            /* O    Pointer to output speech frame              */
                           int32_t *pN,               /* O    Pointer to size of output frame             */
                           int32_t lostFlag,          /* I    0: no loss, 1 loss, 2 decode fec            */
                           int32_t condCoding         /* I    The type of conditional coding to use       */
 ) {
     int32_t L, mv_len, ret = 0;
-    L = s_channel_state[n].frame_length;
-    s_silk_decoder_control->LTP_scale_Q14 = 0;
+    L = m_channel_state[n].frame_length;
+    m_silk_decoder_control->LTP_scale_Q14 = 0;
 
     /* Safety checks */
     assert(L > 0 && L <= MAX_FRAME_LENGTH);
 
-    if(lostFlag == FLAG_DECODE_NORMAL || (lostFlag == FLAG_DECODE_LBRR && s_channel_state[n].LBRR_flags[s_channel_state[n].nFramesDecoded] == 1)) {
+    if(lostFlag == FLAG_DECODE_NORMAL || (lostFlag == FLAG_DECODE_LBRR && m_channel_state[n].LBRR_flags[m_channel_state[n].nFramesDecoded] == 1)) {
         int16_t pulses[(L + SHELL_CODEC_FRAME_LENGTH - 1) & ~(SHELL_CODEC_FRAME_LENGTH - 1)];
         /*********************************************/
         /* Decode quantization indices of side info  */
         /*********************************************/
-        silk_decode_indices(n, s_channel_state[n].nFramesDecoded, lostFlag, condCoding);
+        silk_decode_indices(n, m_channel_state[n].nFramesDecoded, lostFlag, condCoding);
 
         /*********************************************/
         /* Decode quantization indices of excitation */
         /*********************************************/
-        silk_decode_pulses(pulses, s_channel_state[n].indices.signalType, s_channel_state[n].indices.quantOffsetType,
-                           s_channel_state[n].frame_length);
+        silk_decode_pulses(pulses, m_channel_state[n].indices.signalType, m_channel_state[n].indices.quantOffsetType,
+                           m_channel_state[n].frame_length);
 
         /********************************************/
         /* Decode parameters and pulse signal       */
@@ -2023,26 +2047,26 @@ int32_t silk_decode_frame(uint8_t n,
         /********************************************************/
         silk_PLC(n, pOut, 0);
 
-        s_channel_state[n].lossCnt = 0;
-        s_channel_state[n].prevSignalType = s_channel_state[n].indices.signalType;
-        assert(s_channel_state[n].prevSignalType >= 0 && s_channel_state[n].prevSignalType <= 2);
+        m_channel_state[n].lossCnt = 0;
+        m_channel_state[n].prevSignalType = m_channel_state[n].indices.signalType;
+        assert(m_channel_state[n].prevSignalType >= 0 && m_channel_state[n].prevSignalType <= 2);
 
         /* A frame has been decoded without errors */
-        s_channel_state[n].first_frame_after_reset = 0;
+        m_channel_state[n].first_frame_after_reset = 0;
     }
     else {
         /* Handle packet loss by extrapolation */
-        s_channel_state[n].indices.signalType = s_channel_state[n].prevSignalType;
+        m_channel_state[n].indices.signalType = m_channel_state[n].prevSignalType;
         silk_PLC(n, pOut, 1);
     }
 
     /*************************/
     /* Update output buffer. */
     /*************************/
-    assert(s_channel_state[n].ltp_mem_length >= s_channel_state[n].frame_length);
-    mv_len = s_channel_state[n].ltp_mem_length - s_channel_state[n].frame_length;
-    memmove(s_channel_state[n].outBuf, &s_channel_state[n].outBuf[s_channel_state[n].frame_length], mv_len * sizeof(int16_t));
-    memcpy(&s_channel_state[n].outBuf[mv_len], pOut, s_channel_state[n].frame_length * sizeof(int16_t));
+    assert(m_channel_state[n].ltp_mem_length >= m_channel_state[n].frame_length);
+    mv_len = m_channel_state[n].ltp_mem_length - m_channel_state[n].frame_length;
+    memmove(m_channel_state[n].outBuf, &m_channel_state[n].outBuf[m_channel_state[n].frame_length], mv_len * sizeof(int16_t));
+    memcpy(&m_channel_state[n].outBuf[mv_len], pOut, m_channel_state[n].frame_length * sizeof(int16_t));
 
     /************************************************/
     /* Comfort noise generation / estimation        */
@@ -2055,7 +2079,7 @@ int32_t silk_decode_frame(uint8_t n,
     silk_PLC_glue_frames(n, pOut, L);
 
     /* Update some decoder state variables */
-    s_channel_state[n].lagPrev = s_silk_decoder_control->pitchL[s_channel_state[n].nb_subfr - 1];
+    m_channel_state[n].lagPrev = m_silk_decoder_control->pitchL[m_channel_state[n].nb_subfr - 1];
 
     /* Set output frame length */
     *pN = L;
@@ -2063,7 +2087,7 @@ int32_t silk_decode_frame(uint8_t n,
     return ret;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void silk_decode_pitch(int16_t       lagIndex,     /* I                                                                */
+void SilkDecoder::silk_decode_pitch(int16_t       lagIndex,     /* I                                                                */
                        int8_t        contourIndex, /* O                                                                */
                        int32_t       pitch_lags[], /* O    4 pitch values                                              */
                        const int32_t Fs_kHz,       /* I    sampling frequency (kHz)                                    */
@@ -2106,7 +2130,7 @@ void silk_decode_pitch(int16_t       lagIndex,     /* I
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Gain scalar quantization with hysteresis, uniform on log scale */
-void silk_gains_quant(int8_t        ind[MAX_NB_SUBFR],      /* O    gain indices                                */
+void SilkDecoder::silk_gains_quant(int8_t        ind[MAX_NB_SUBFR],      /* O    gain indices                                */
                       int32_t       gain_Q16[MAX_NB_SUBFR], /* I/O  gains (quantized out)                       */
                       int8_t*       prev_ind,               /* I/O  last index in previous frame                */
                       const int32_t conditional,            /* I    first gain is delta coded if 1              */
@@ -2156,7 +2180,7 @@ void silk_gains_quant(int8_t        ind[MAX_NB_SUBFR],      /* O    gain indices
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /* Gains scalar dequantization, uniform on log scale */
-void silk_gains_dequant(int32_t       gain_Q16[MAX_NB_SUBFR], /* O    quantized gains                             */
+void SilkDecoder::silk_gains_dequant(int32_t       gain_Q16[MAX_NB_SUBFR], /* O    quantized gains                             */
                         const int8_t  ind[MAX_NB_SUBFR],      /* I    gain indices                                */
                         int8_t*       prev_ind,               /* I/O  last index in previous frame                */
                         const int32_t conditional,            /* I    first gain is delta coded if 1              */
@@ -2187,7 +2211,7 @@ void silk_gains_dequant(int32_t       gain_Q16[MAX_NB_SUBFR], /* O    quantized
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /* Compute unique identifier of gain indices vector */
-int32_t silk_gains_ID(                                 /* O    returns unique identifier of gains          */
+int32_t SilkDecoder::silk_gains_ID(                                 /* O    returns unique identifier of gains          */
                       const int8_t  ind[MAX_NB_SUBFR], /* I    gain indices                                */
                       const int32_t nb_subfr           /* I    number of subframes                         */
 ) {
@@ -2200,13 +2224,13 @@ int32_t silk_gains_ID(                                 /* O    returns unique id
     return gainsID;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t silk_init_decoder(uint8_t n) {
+int32_t SilkDecoder::silk_init_decoder(uint8_t n) {
     /* Clear the entire encoder state, except anything copied */
-    memset(&s_channel_state[n], 0, sizeof(silk_decoder_state_t));
+    memset(&m_channel_state[n], 0, sizeof(silk_decoder_state_t));
 
     /* Used to deactivate LSF interpolation */
-    s_channel_state[n].first_frame_after_reset = 1;
-    s_channel_state[n].prev_gain_Q16 = 65536;
+    m_channel_state[n].first_frame_after_reset = 1;
+    m_channel_state[n].prev_gain_Q16 = 65536;
 
     /* Reset CNG state */
     silk_CNG_Reset(n);
@@ -2217,7 +2241,7 @@ int32_t silk_init_decoder(uint8_t n) {
     return (0);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t silk_inner_prod_aligned_scale(const int16_t* const inVec1, /*    I input vector 1 */
+int32_t SilkDecoder::silk_inner_prod_aligned_scale(const int16_t* const inVec1, /*    I input vector 1 */
                                       const int16_t* const inVec2, /*    I input vector 2 */
                                       const int32_t        scale,  /*    I number of bits to shift         */
                                       const int32_t        len     /*    I vector lengths            */
@@ -2229,7 +2253,7 @@ int32_t silk_inner_prod_aligned_scale(const int16_t* const inVec1, /*    I input
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Interpolate two vectors */
-void silk_interpolate(int16_t       xi[MAX_LPC_ORDER], /* O    interpolated vector                         */
+void SilkDecoder::silk_interpolate(int16_t       xi[MAX_LPC_ORDER], /* O    interpolated vector                         */
                       const int16_t x0[MAX_LPC_ORDER], /* I    first vector                                */
                       const int16_t x1[MAX_LPC_ORDER], /* I    second vector                               */
                       const int32_t ifact_Q2,          /* I    interp. factor, weight on 2nd vector        */
@@ -2244,7 +2268,7 @@ void silk_interpolate(int16_t       xi[MAX_LPC_ORDER], /* O    interpolated vect
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-int32_t silk_lin2log(const int32_t inLin /* I  input in linear scale                                         */
+int32_t SilkDecoder::silk_lin2log(const int32_t inLin /* I  input in linear scale                                         */
 ) {
     int32_t lz, frac_Q7;
 
@@ -2256,7 +2280,7 @@ int32_t silk_lin2log(const int32_t inLin /* I  input in linear scale
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /* Approximation of 2^() (very close inverse of silk_lin2log()) Convert input to a linear scale    */
-int32_t silk_log2lin(const int32_t inLog_Q7) {
+int32_t SilkDecoder::silk_log2lin(const int32_t inLog_Q7) {
     int32_t out, frac_Q7;
 
     if(inLog_Q7 < 0) { return 0; }
@@ -2276,7 +2300,7 @@ int32_t silk_log2lin(const int32_t inLog_Q7) {
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-void silk_LPC_analysis_filter(int16_t*       out, /* O    Output signal                                               */
+void SilkDecoder::silk_LPC_analysis_filter(int16_t*       out, /* O    Output signal                                               */
                               const int16_t* in,  /* I    Input signal                                                */
                               const int16_t* B,   /* I    MA prediction coefficients, Q12 [order]                     */
                               const int32_t  len, /* I    Signal length                                               */
@@ -2322,7 +2346,7 @@ void silk_LPC_analysis_filter(int16_t*       out, /* O    Output signal
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /* Convert int32 coefficients to int16 coefs and make sure there's no wrap-around */
-void silk_LPC_fit(int16_t*      a_QOUT, /* O    Output signal                                               */
+void SilkDecoder::silk_LPC_fit(int16_t*      a_QOUT, /* O    Output signal                                               */
                   int32_t*      a_QIN,  /* I/O  Input signal                                                */
                   const int32_t QOUT,   /* I    Input Q domain                                              */
                   const int32_t QIN,    /* I    Input Q domain                                              */
@@ -2367,7 +2391,7 @@ void silk_LPC_fit(int16_t*      a_QOUT, /* O    Output signal
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Compute inverse of LPC prediction gain, and                          */
 /* test if LPC coefficients are stable (all poles within unit circle)   */
-int32_t LPC_inverse_pred_gain_QA_c(                                        /* O   Returns inverse prediction gain in energy domain, Q30    */
+int32_t SilkDecoder::LPC_inverse_pred_gain_QA_c(                                        /* O   Returns inverse prediction gain in energy domain, Q30    */
                                           int32_t       A_QA[SILK_MAX_ORDER_LPC], /* I   Prediction coefficients */
                                           const int32_t order                     /* I   Prediction order               */
 ) {
@@ -2433,7 +2457,7 @@ int32_t LPC_inverse_pred_gain_QA_c(                                        /* O
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* For input in Q12 domain */
-int32_t silk_LPC_inverse_pred_gain_c(                      /* O   Returns inverse prediction gain in energy domain, Q30        */
+int32_t SilkDecoder::silk_LPC_inverse_pred_gain_c(                      /* O   Returns inverse prediction gain in energy domain, Q30        */
                                      const int16_t* A_Q12, /* I   Prediction coefficients, Q12 [order] */
                                      const int32_t  order  /* I   Prediction order   */
 ) {
@@ -2453,7 +2477,7 @@ int32_t silk_LPC_inverse_pred_gain_c(                      /* O   Returns invers
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Predictive dequantizer for NLSF residuals */
-void silk_NLSF_residual_dequant(                                   /* O    Returns RD value in Q30                     */
+void SilkDecoder::silk_NLSF_residual_dequant(                                   /* O    Returns RD value in Q30                     */
                                 int16_t       x_Q10[],             /* O    Output [ order ]                            */
                                 const int8_t  indices[],           /* I    Quantization indices [ order ]              */
                                 const uint8_t pred_coef_Q8[],      /* I    Backward predictor coefs [ order ]          */
@@ -2474,7 +2498,7 @@ void silk_NLSF_residual_dequant(                                   /* O    Retur
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* NLSF vector decoder */
-void silk_NLSF_decode(int16_t*                   pNLSF_Q15,   /* O    Quantized NLSF vector [ LPC_ORDER ]         */
+void SilkDecoder::silk_NLSF_decode(int16_t*                   pNLSF_Q15,   /* O    Quantized NLSF vector [ LPC_ORDER ]         */
                       int8_t*                    NLSFIndices, /* I    Codebook path vector [ LPC_ORDER + 1 ]      */
                       const silk_NLSF_CB_struct* psNLSF_CB    /* I    Codebook object                             */
 ) {
@@ -2505,7 +2529,7 @@ void silk_NLSF_decode(int16_t*                   pNLSF_Q15,   /* O    Quantized
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Delayed-decision quantizer for NLSF residuals */
-int32_t silk_NLSF_del_dec_quant(                                      /* O    Returns RD value in Q25                     */
+int32_t SilkDecoder::silk_NLSF_del_dec_quant(                                      /* O    Returns RD value in Q25                     */
                                 int8_t        indices[],              /* O    Quantization indices [ order ]              */
                                 const int16_t x_Q10[],                /* I    Input [ order ]                             */
                                 const int16_t w_Q5[],                 /* I    Weights [ order ]                           */
@@ -2684,7 +2708,7 @@ int32_t silk_NLSF_del_dec_quant(                                      /* O    Re
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* NLSF stabilizer, for a single input data vector */
-void silk_NLSF_stabilize(int16_t*       NLSF_Q15,      /* I/O   Unstable/stabilized normalized LSF vector in Q15 [L]       */
+void SilkDecoder::silk_NLSF_stabilize(int16_t*       NLSF_Q15,      /* I/O   Unstable/stabilized normalized LSF vector in Q15 [L]       */
                          const int16_t* NDeltaMin_Q15, /* I     Min distance vector, NDeltaMin_Q15[L] must be >= 1 [L+1]   */
                          const int32_t  L              /* I     Number of NLSF parameters in the input vector              */
 ) {
@@ -2770,7 +2794,7 @@ void silk_NLSF_stabilize(int16_t*       NLSF_Q15,      /* I/O   Unstable/stabili
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Unpack predictor values and indices for entropy coding tables */
-void silk_NLSF_unpack(int16_t                    ec_ix[],   /* O    Indices to entropy tables [ LPC_ORDER ]     */
+void SilkDecoder::silk_NLSF_unpack(int16_t                    ec_ix[],   /* O    Indices to entropy tables [ LPC_ORDER ]     */
                       uint8_t                    pred_Q8[], /* O    LSF predictor [ LPC_ORDER ]                 */
                       const silk_NLSF_CB_struct* psNLSF_CB, /* I    Codebook object                             */
                       const int32_t              CB1_index  /* I    Index of vector in first LSF codebook       */
@@ -2790,7 +2814,7 @@ void silk_NLSF_unpack(int16_t                    ec_ix[],   /* O    Indices to e
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Laroia low complexity NLSF weights */
-void silk_NLSF_VQ_weights_laroia(int16_t*       pNLSFW_Q_OUT, /* O     Pointer to input vector weights [D]    */
+void SilkDecoder::silk_NLSF_VQ_weights_laroia(int16_t*       pNLSFW_Q_OUT, /* O     Pointer to input vector weights [D]    */
                                  const int16_t* pNLSF_Q15,    /* I     Pointer to input vector         [D] */
                                  const int32_t  D             /* I     Input vector dimension (even)                              */
 ) {
@@ -2829,7 +2853,7 @@ void silk_NLSF_VQ_weights_laroia(int16_t*       pNLSFW_Q_OUT, /* O     Pointer t
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Compute quantization errors for an LPC_order element input vector for a VQ codebook */
-void silk_NLSF_VQ(int32_t       err_Q24[],  /* O    Quantization errors [K]                     */
+void SilkDecoder::silk_NLSF_VQ(int32_t       err_Q24[],  /* O    Quantization errors [K]                     */
                   const int16_t in_Q15[],   /* I    Input vectors to be quantized [LPC_order]   */
                   const uint8_t pCB_Q8[],   /* I    Codebook vectors [K*LPC_order]              */
                   const int16_t pWght_Q9[], /* I    Codebook weights [K*LPC_order]              */
@@ -2870,20 +2894,20 @@ void silk_NLSF_VQ(int32_t       err_Q24[],  /* O    Quantization errors [K]
     }
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void silk_PLC_Reset(uint8_t n) { /* I/O Decoder state        */
-    s_channel_state[n].sPLC.pitchL_Q8 = silk_LSHIFT(s_channel_state[n].frame_length, 8 - 1);
-    s_channel_state[n].sPLC.prevGain_Q16[0] = SILK_FIX_CONST(1, 16);
-    s_channel_state[n].sPLC.prevGain_Q16[1] = SILK_FIX_CONST(1, 16);
-    s_channel_state[n].sPLC.subfr_length = 20;
-    s_channel_state[n].sPLC.nb_subfr = 2;
+void SilkDecoder::silk_PLC_Reset(uint8_t n) { /* I/O Decoder state        */
+    m_channel_state[n].sPLC.pitchL_Q8 = silk_LSHIFT(m_channel_state[n].frame_length, 8 - 1);
+    m_channel_state[n].sPLC.prevGain_Q16[0] = SILK_FIX_CONST(1, 16);
+    m_channel_state[n].sPLC.prevGain_Q16[1] = SILK_FIX_CONST(1, 16);
+    m_channel_state[n].sPLC.subfr_length = 20;
+    m_channel_state[n].sPLC.nb_subfr = 2;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-void silk_PLC(uint8_t n, int16_t frame[], int32_t lost) {
+void SilkDecoder::silk_PLC(uint8_t n, int16_t frame[], int32_t lost) {
     /* PLC control function */
-    if(s_channel_state[n].fs_kHz != s_channel_state[n].sPLC.fs_kHz) {
+    if(m_channel_state[n].fs_kHz != m_channel_state[n].sPLC.fs_kHz) {
         silk_PLC_Reset(n);
-        s_channel_state[n].sPLC.fs_kHz = s_channel_state[n].fs_kHz;
+        m_channel_state[n].sPLC.fs_kHz = m_channel_state[n].fs_kHz;
     }
 
     if(lost) {
@@ -2892,7 +2916,7 @@ void silk_PLC(uint8_t n, int16_t frame[], int32_t lost) {
         /****************************/
         silk_PLC_conceal(n, frame);
 
-        s_channel_state[n].lossCnt++;
+        m_channel_state[n].lossCnt++;
     }
     else {
         /****************************/
@@ -2903,26 +2927,26 @@ void silk_PLC(uint8_t n, int16_t frame[], int32_t lost) {
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Update state of PLC                            */
-void silk_PLC_update(uint8_t n) {
+void SilkDecoder::silk_PLC_update(uint8_t n) {
     int32_t          LTP_Gain_Q14, temp_LTP_Gain_Q14;
     int32_t          i, j;
     silk_PLC_struct* psPLC;
 
-    psPLC = &s_channel_state[n].sPLC;
+    psPLC = &m_channel_state[n].sPLC;
 
     /* Update parameters used in case of packet loss */
-    s_channel_state[n].prevSignalType = s_channel_state[n].indices.signalType;
+    m_channel_state[n].prevSignalType = m_channel_state[n].indices.signalType;
     LTP_Gain_Q14 = 0;
-    if(s_channel_state[n].indices.signalType == TYPE_VOICED) {
+    if(m_channel_state[n].indices.signalType == TYPE_VOICED) {
         /* Find the parameters for the last subframe which contains a pitch pulse */
-        for(j = 0; j * s_channel_state[n].subfr_length < s_silk_decoder_control->pitchL[s_channel_state[n].nb_subfr - 1]; j++) {
-            if(j == s_channel_state[n].nb_subfr) { break; }
+        for(j = 0; j * m_channel_state[n].subfr_length < m_silk_decoder_control->pitchL[m_channel_state[n].nb_subfr - 1]; j++) {
+            if(j == m_channel_state[n].nb_subfr) { break; }
             temp_LTP_Gain_Q14 = 0;
-            for(i = 0; i < LTP_ORDER; i++) { temp_LTP_Gain_Q14 += s_silk_decoder_control->LTPCoef_Q14[(s_channel_state[n].nb_subfr - 1 - j) * LTP_ORDER + i]; }
+            for(i = 0; i < LTP_ORDER; i++) { temp_LTP_Gain_Q14 += m_silk_decoder_control->LTPCoef_Q14[(m_channel_state[n].nb_subfr - 1 - j) * LTP_ORDER + i]; }
             if(temp_LTP_Gain_Q14 > LTP_Gain_Q14) {
                 LTP_Gain_Q14 = temp_LTP_Gain_Q14;
-                memcpy(psPLC->LTPCoef_Q14, &s_silk_decoder_control->LTPCoef_Q14[silk_SMULBB(s_channel_state[n].nb_subfr - 1 - j, LTP_ORDER)], LTP_ORDER * sizeof(int16_t));
-                psPLC->pitchL_Q8 = silk_LSHIFT(s_silk_decoder_control->pitchL[s_channel_state[n].nb_subfr - 1 - j], 8);
+                memcpy(psPLC->LTPCoef_Q14, &m_silk_decoder_control->LTPCoef_Q14[silk_SMULBB(m_channel_state[n].nb_subfr - 1 - j, LTP_ORDER)], LTP_ORDER * sizeof(int16_t));
+                psPLC->pitchL_Q8 = silk_LSHIFT(m_silk_decoder_control->pitchL[m_channel_state[n].nb_subfr - 1 - j], 8);
             }
         }
 
@@ -2948,26 +2972,26 @@ void silk_PLC_update(uint8_t n) {
         }
     }
     else {
-        psPLC->pitchL_Q8 = silk_LSHIFT(silk_SMULBB(s_channel_state[n].fs_kHz, 18), 8);
+        psPLC->pitchL_Q8 = silk_LSHIFT(silk_SMULBB(m_channel_state[n].fs_kHz, 18), 8);
         memset(psPLC->LTPCoef_Q14, 0, LTP_ORDER * sizeof(int16_t));
     }
 
     /* Save LPC coeficients */
-    memcpy(psPLC->prevLPC_Q12, s_silk_decoder_control->PredCoef_Q12[1], s_channel_state[n].LPC_order * sizeof(int16_t));
-    psPLC->prevLTP_scale_Q14 = s_silk_decoder_control->LTP_scale_Q14;
+    memcpy(psPLC->prevLPC_Q12, m_silk_decoder_control->PredCoef_Q12[1], m_channel_state[n].LPC_order * sizeof(int16_t));
+    psPLC->prevLTP_scale_Q14 = m_silk_decoder_control->LTP_scale_Q14;
 
     /* Save last two gains */
-    memcpy(psPLC->prevGain_Q16, &s_silk_decoder_control->Gains_Q16[s_channel_state[n].nb_subfr - 2], 2 * sizeof(int32_t));
+    memcpy(psPLC->prevGain_Q16, &m_silk_decoder_control->Gains_Q16[m_channel_state[n].nb_subfr - 2], 2 * sizeof(int32_t));
 
-    psPLC->subfr_length = s_channel_state[n].subfr_length;
-    psPLC->nb_subfr = s_channel_state[n].nb_subfr;
+    psPLC->subfr_length = m_channel_state[n].subfr_length;
+    psPLC->nb_subfr = m_channel_state[n].nb_subfr;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-void silk_PLC_energy(int32_t* energy1, int32_t* shift1, int32_t* energy2, int32_t* shift2, const int32_t* exc_Q14, const int32_t* prevGain_Q10, int subfr_length, int nb_subfr) {
+void SilkDecoder::silk_PLC_energy(int32_t* energy1, int32_t* shift1, int32_t* energy2, int32_t* shift2, const int32_t* exc_Q14, const int32_t* prevGain_Q10, int subfr_length, int nb_subfr) {
     int i, k;
     int16_t* exc_buf_ptr;
-    auto exc_buf = silk_malloc_arr<int16_t>(2 * subfr_length * sizeof(int16_t));
+    auto exc_buf = silk_scratch_arr<int16_t>(2 * subfr_length);
     /* Find random noise component */
     /* Scale previous excitation signal */
     exc_buf_ptr = exc_buf.get();
@@ -2981,7 +3005,7 @@ void silk_PLC_energy(int32_t* energy1, int32_t* shift1, int32_t* energy2, int32_
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-void silk_PLC_conceal(uint8_t n, int16_t frame[]) {
+void SilkDecoder::silk_PLC_conceal(uint8_t n, int16_t frame[]) {
     int32_t  i, j, k;
     int32_t  lag, idx, sLTP_buf_idx, shift1, shift2;
     int32_t  rand_seed, harm_Gain_Q15, rand_Gain_Q15, inv_gain_Q30;
@@ -2991,26 +3015,26 @@ void silk_PLC_conceal(uint8_t n, int16_t frame[]) {
     int16_t* B_Q14;
     int32_t* sLPC_Q14_ptr;
     int16_t  A_Q12[MAX_LPC_ORDER];
-    silk_PLC_struct* psPLC = &s_channel_state[n].sPLC;
+    silk_PLC_struct* psPLC = &m_channel_state[n].sPLC;
     int32_t          prevGain_Q10[2];
 
-    auto sLTP_Q14 = silk_malloc_arr<int32_t>(s_channel_state[n].ltp_mem_length + s_channel_state[n].frame_length * sizeof(int32_t));
-    auto sLTP = silk_malloc_arr<int16_t>(s_channel_state[n].ltp_mem_length * sizeof(int16_t));
+    auto sLTP_Q14 = silk_scratch_arr<int32_t>(m_channel_state[n].ltp_mem_length + m_channel_state[n].frame_length);
+    auto sLTP = silk_scratch_arr<int16_t>(m_channel_state[n].ltp_mem_length);
 
     prevGain_Q10[0] = silk_RSHIFT(psPLC->prevGain_Q16[0], 6);
     prevGain_Q10[1] = silk_RSHIFT(psPLC->prevGain_Q16[1], 6);
 
-    if(s_channel_state[n].first_frame_after_reset) { memset(psPLC->prevLPC_Q12, 0, sizeof(psPLC->prevLPC_Q12)); }
+    if(m_channel_state[n].first_frame_after_reset) { memset(psPLC->prevLPC_Q12, 0, sizeof(psPLC->prevLPC_Q12)); }
 
-    silk_PLC_energy(&energy1, &shift1, &energy2, &shift2, s_channel_state[n].exc_Q14, prevGain_Q10, s_channel_state[n].subfr_length, s_channel_state[n].nb_subfr);
+    silk_PLC_energy(&energy1, &shift1, &energy2, &shift2, m_channel_state[n].exc_Q14, prevGain_Q10, m_channel_state[n].subfr_length, m_channel_state[n].nb_subfr);
 
     if(silk_RSHIFT(energy1, shift2) < silk_RSHIFT(energy2, shift1)) {
         /* First sub-frame has lowest energy */
-        rand_ptr = &s_channel_state[n].exc_Q14[silk_max_int(0, (psPLC->nb_subfr - 1) * psPLC->subfr_length - RAND_BUF_SIZE)];
+        rand_ptr = &m_channel_state[n].exc_Q14[silk_max_int(0, (psPLC->nb_subfr - 1) * psPLC->subfr_length - RAND_BUF_SIZE)];
     }
     else {
         /* Second sub-frame has lowest energy */
-        rand_ptr = &s_channel_state[n].exc_Q14[silk_max_int(0, psPLC->nb_subfr * psPLC->subfr_length - RAND_BUF_SIZE)];
+        rand_ptr = &m_channel_state[n].exc_Q14[silk_max_int(0, psPLC->nb_subfr * psPLC->subfr_length - RAND_BUF_SIZE)];
     }
 
     /* Set up Gain to random noise component */
@@ -3018,22 +3042,22 @@ void silk_PLC_conceal(uint8_t n, int16_t frame[]) {
     rand_scale_Q14 = psPLC->randScale_Q14;
 
     /* Set up attenuation gains */
-    harm_Gain_Q15 = HARM_ATT_Q15[silk_min_int(NB_ATT - 1, s_channel_state[n].lossCnt)];
-    if(s_channel_state[n].prevSignalType == TYPE_VOICED) { rand_Gain_Q15 = PLC_RAND_ATTENUATE_V_Q15[silk_min_int(NB_ATT - 1, s_channel_state[n].lossCnt)]; }
-    else { rand_Gain_Q15 = PLC_RAND_ATTENUATE_UV_Q15[silk_min_int(NB_ATT - 1, s_channel_state[n].lossCnt)]; }
+    harm_Gain_Q15 = HARM_ATT_Q15[silk_min_int(NB_ATT - 1, m_channel_state[n].lossCnt)];
+    if(m_channel_state[n].prevSignalType == TYPE_VOICED) { rand_Gain_Q15 = PLC_RAND_ATTENUATE_V_Q15[silk_min_int(NB_ATT - 1, m_channel_state[n].lossCnt)]; }
+    else { rand_Gain_Q15 = PLC_RAND_ATTENUATE_UV_Q15[silk_min_int(NB_ATT - 1, m_channel_state[n].lossCnt)]; }
 
     /* LPC concealment. Apply BWE to previous LPC */
-    silk_bwexpander(psPLC->prevLPC_Q12, s_channel_state[n].LPC_order, SILK_FIX_CONST(BWE_COEF, 16));
+    silk_bwexpander(psPLC->prevLPC_Q12, m_channel_state[n].LPC_order, SILK_FIX_CONST(BWE_COEF, 16));
 
     /* Preload LPC coeficients to array on stack. Gives small performance gain */
-    memcpy(A_Q12, psPLC->prevLPC_Q12, s_channel_state[n].LPC_order * sizeof(int16_t));
+    memcpy(A_Q12, psPLC->prevLPC_Q12, m_channel_state[n].LPC_order * sizeof(int16_t));
 
     /* First Lost frame */
-    if(s_channel_state[n].lossCnt == 0) {
+    if(m_channel_state[n].lossCnt == 0) {
         rand_scale_Q14 = 1 << 14;
 
         /* Reduce random noise Gain for voiced frames */
-        if(s_channel_state[n].prevSignalType == TYPE_VOICED) {
+        if(m_channel_state[n].prevSignalType == TYPE_VOICED) {
             for(i = 0; i < LTP_ORDER; i++) { rand_scale_Q14 -= B_Q14[i]; }
             rand_scale_Q14 = silk_max_16(3277, rand_scale_Q14); /* 0.2 */
             rand_scale_Q14 = (int16_t)silk_RSHIFT(silk_SMULBB(rand_scale_Q14, psPLC->prevLTP_scale_Q14), 14);
@@ -3042,7 +3066,7 @@ void silk_PLC_conceal(uint8_t n, int16_t frame[]) {
             /* Reduce random noise for unvoiced frames with high LPC gain */
             int32_t invGain_Q30, down_scale_Q30;
 
-            invGain_Q30 = silk_LPC_inverse_pred_gain(psPLC->prevLPC_Q12, s_channel_state[n].LPC_order);
+            invGain_Q30 = silk_LPC_inverse_pred_gain(psPLC->prevLPC_Q12, m_channel_state[n].LPC_order);
 
             down_scale_Q30 = silk_min_32(silk_RSHIFT((int32_t)1 << 30, LOG2_INV_LPC_GAIN_HIGH_THRES), invGain_Q30);
             down_scale_Q30 = silk_max_32(silk_RSHIFT((int32_t)1 << 30, LOG2_INV_LPC_GAIN_LOW_THRES), down_scale_Q30);
@@ -3054,24 +3078,24 @@ void silk_PLC_conceal(uint8_t n, int16_t frame[]) {
 
     rand_seed = psPLC->rand_seed;
     lag = silk_RSHIFT_ROUND(psPLC->pitchL_Q8, 8);
-    sLTP_buf_idx = s_channel_state[n].ltp_mem_length;
+    sLTP_buf_idx = m_channel_state[n].ltp_mem_length;
 
     /* Rewhiten LTP state */
-    idx = s_channel_state[n].ltp_mem_length - lag - s_channel_state[n].LPC_order - LTP_ORDER / 2;
+    idx = m_channel_state[n].ltp_mem_length - lag - m_channel_state[n].LPC_order - LTP_ORDER / 2;
     assert(idx > 0);
-    silk_LPC_analysis_filter(&sLTP[idx], &s_channel_state[n].outBuf[idx], A_Q12, s_channel_state[n].ltp_mem_length - idx, s_channel_state[n].LPC_order);
+    silk_LPC_analysis_filter(&sLTP[idx], &m_channel_state[n].outBuf[idx], A_Q12, m_channel_state[n].ltp_mem_length - idx, m_channel_state[n].LPC_order);
     /* Scale LTP state */
     inv_gain_Q30 = silk_INVERSE32_varQ(psPLC->prevGain_Q16[1], 46);
     inv_gain_Q30 = silk_min(inv_gain_Q30, silk_int32_MAX >> 1);
-    for(i = idx + s_channel_state[n].LPC_order; i < s_channel_state[n].ltp_mem_length; i++) { sLTP_Q14[i] = silk_SMULWB(inv_gain_Q30, sLTP[i]); }
+    for(i = idx + m_channel_state[n].LPC_order; i < m_channel_state[n].ltp_mem_length; i++) { sLTP_Q14[i] = silk_SMULWB(inv_gain_Q30, sLTP[i]); }
 
     /***************************/
     /* LTP synthesis filtering */
     /***************************/
-    for(k = 0; k < s_channel_state[n].nb_subfr; k++) {
+    for(k = 0; k < m_channel_state[n].nb_subfr; k++) {
         /* Set up pointer */
         pred_lag_ptr = &sLTP_Q14[sLTP_buf_idx - lag + LTP_ORDER / 2];
-        for(i = 0; i < s_channel_state[n].subfr_length; i++) {
+        for(i = 0; i < m_channel_state[n].subfr_length; i++) {
             /* Unrolled loop */
             /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
             LTP_pred_Q12 = 2;
@@ -3091,30 +3115,30 @@ void silk_PLC_conceal(uint8_t n, int16_t frame[]) {
 
         /* Gradually reduce LTP gain */
         for(j = 0; j < LTP_ORDER; j++) { B_Q14[j] = silk_RSHIFT(silk_SMULBB(harm_Gain_Q15, B_Q14[j]), 15); }
-        if(s_channel_state[n].indices.signalType != TYPE_NO_VOICE_ACTIVITY) {
+        if(m_channel_state[n].indices.signalType != TYPE_NO_VOICE_ACTIVITY) {
             /* Gradually reduce excitation gain */
             rand_scale_Q14 = silk_RSHIFT(silk_SMULBB(rand_scale_Q14, rand_Gain_Q15), 15);
         }
 
         /* Slowly increase pitch lag */
         psPLC->pitchL_Q8 = silk_SMLAWB(psPLC->pitchL_Q8, psPLC->pitchL_Q8, PITCH_DRIFT_FAC_Q16);
-        psPLC->pitchL_Q8 = silk_min_32(psPLC->pitchL_Q8, silk_LSHIFT(silk_SMULBB(MAX_PITCH_LAG_MS, s_channel_state[n].fs_kHz), 8));
+        psPLC->pitchL_Q8 = silk_min_32(psPLC->pitchL_Q8, silk_LSHIFT(silk_SMULBB(MAX_PITCH_LAG_MS, m_channel_state[n].fs_kHz), 8));
         lag = silk_RSHIFT_ROUND(psPLC->pitchL_Q8, 8);
     }
 
     /***************************/
     /* LPC synthesis filtering */
     /***************************/
-    sLPC_Q14_ptr = &sLTP_Q14[s_channel_state[n].ltp_mem_length - MAX_LPC_ORDER];
+    sLPC_Q14_ptr = &sLTP_Q14[m_channel_state[n].ltp_mem_length - MAX_LPC_ORDER];
 
     /* Copy LPC state */
-    memcpy(sLPC_Q14_ptr, s_channel_state[n].sLPC_Q14_buf, MAX_LPC_ORDER * sizeof(int32_t));
+    memcpy(sLPC_Q14_ptr, m_channel_state[n].sLPC_Q14_buf, MAX_LPC_ORDER * sizeof(int32_t));
 
-    assert(s_channel_state[n].LPC_order >= 10); /* check that unrolling works */
-    for(i = 0; i < s_channel_state[n].frame_length; i++) {
+    assert(m_channel_state[n].LPC_order >= 10); /* check that unrolling works */
+    for(i = 0; i < m_channel_state[n].frame_length; i++) {
         /* partly unrolled */
         /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
-        LPC_pred_Q10 = silk_RSHIFT(s_channel_state[n].LPC_order, 1);
+        LPC_pred_Q10 = silk_RSHIFT(m_channel_state[n].LPC_order, 1);
         LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14_ptr[MAX_LPC_ORDER + i - 1], A_Q12[0]);
         LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14_ptr[MAX_LPC_ORDER + i - 2], A_Q12[1]);
         LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14_ptr[MAX_LPC_ORDER + i - 3], A_Q12[2]);
@@ -3125,7 +3149,7 @@ void silk_PLC_conceal(uint8_t n, int16_t frame[]) {
         LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14_ptr[MAX_LPC_ORDER + i - 8], A_Q12[7]);
         LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14_ptr[MAX_LPC_ORDER + i - 9], A_Q12[8]);
         LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14_ptr[MAX_LPC_ORDER + i - 10], A_Q12[9]);
-        for(j = 10; j < s_channel_state[n].LPC_order; j++) { LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14_ptr[MAX_LPC_ORDER + i - j - 1], A_Q12[j]); }
+        for(j = 10; j < m_channel_state[n].LPC_order; j++) { LPC_pred_Q10 = silk_SMLAWB(LPC_pred_Q10, sLPC_Q14_ptr[MAX_LPC_ORDER + i - j - 1], A_Q12[j]); }
 
         /* Add prediction to LPC excitation */
         sLPC_Q14_ptr[MAX_LPC_ORDER + i] = silk_ADD_SAT32(sLPC_Q14_ptr[MAX_LPC_ORDER + i], silk_LSHIFT_SAT32(LPC_pred_Q10, 4));
@@ -3135,31 +3159,31 @@ void silk_PLC_conceal(uint8_t n, int16_t frame[]) {
     }
 
     /* Save LPC state */
-    memcpy(s_channel_state[n].sLPC_Q14_buf, &sLPC_Q14_ptr[s_channel_state[n].frame_length], MAX_LPC_ORDER * sizeof(int32_t));
+    memcpy(m_channel_state[n].sLPC_Q14_buf, &sLPC_Q14_ptr[m_channel_state[n].frame_length], MAX_LPC_ORDER * sizeof(int32_t));
 
     /**************************************/
     /* Update states                      */
     /**************************************/
     psPLC->rand_seed = rand_seed;
     psPLC->randScale_Q14 = rand_scale_Q14;
-    for(i = 0; i < MAX_NB_SUBFR; i++) { s_silk_decoder_control->pitchL[i] = lag; }
+    for(i = 0; i < MAX_NB_SUBFR; i++) { m_silk_decoder_control->pitchL[i] = lag; }
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Glues concealed frames with new good received frames */
-void silk_PLC_glue_frames(uint8_t n, int16_t frame[], int32_t length) {
+void SilkDecoder::silk_PLC_glue_frames(uint8_t n, int16_t frame[], int32_t length) {
     int32_t          i, energy_shift;
     int32_t          energy;
     silk_PLC_struct* psPLC;
-    psPLC = &s_channel_state[n].sPLC;
+    psPLC = &m_channel_state[n].sPLC;
 
-    if(s_channel_state[n].lossCnt) {
+    if(m_channel_state[n].lossCnt) {
         /* Calculate energy in concealed residual */
         silk_sum_sqr_shift(&psPLC->conc_energy, &psPLC->conc_energy_shift, frame, length);
 
         psPLC->last_frame_lost = 1;
     }
     else {
-        if(s_channel_state[n].sPLC.last_frame_lost) {
+        if(m_channel_state[n].sPLC.last_frame_lost) {
             /* Calculate residual in decoded signal if last frame was lost */
             silk_sum_sqr_shift(&energy, &energy_shift, frame, length);
 
@@ -3196,7 +3220,7 @@ void silk_PLC_glue_frames(uint8_t n, int16_t frame[], int32_t length) {
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Downsample by a factor 2/3, low quality */
-void silk_resampler_down2_3(int32_t*       S,    /* I/O  State vector [ 6 ]                                          */
+void SilkDecoder::silk_resampler_down2_3(int32_t*       S,    /* I/O  State vector [ 6 ]                                          */
                             int16_t*       out,  /* O    Output signal [ floor(2*inLen/3) ]                          */
                             const int16_t* in,   /* I    Input signal [ inLen ]                                      */
                             int32_t        inLen /* I    Number of input samples                                     */
@@ -3204,7 +3228,7 @@ void silk_resampler_down2_3(int32_t*       S,    /* I/O  State vector [ 6 ]
     int32_t nSamplesIn, counter, res_Q6;
     int32_t* buf_ptr;
 
-    auto buf = silk_malloc_arr<int32_t>((RESAMPLER_MAX_BATCH_SIZE_IN + ORDER_FIR) * sizeof(int32_t));
+    auto buf = silk_scratch_arr<int32_t>(RESAMPLER_MAX_BATCH_SIZE_IN + ORDER_FIR);
 
     /* Copy buffered samples to start of buffer */
     memcpy(buf.get(), S, ORDER_FIR * sizeof(int32_t));
@@ -3256,7 +3280,7 @@ void silk_resampler_down2_3(int32_t*       S,    /* I/O  State vector [ 6 ]
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Downsample by a factor 2 */
-void silk_resampler_down2(int32_t*       S,    /* I/O  State vector [ 2 ]                                          */
+void SilkDecoder::silk_resampler_down2(int32_t*       S,    /* I/O  State vector [ 2 ]                                          */
                           int16_t*       out,  /* O    Output signal [ floor(len/2) ]                              */
                           const int16_t* in,   /* I    Input signal [ len ]                                        */
                           int32_t        inLen /* I    Number of input samples                                     */
@@ -3294,7 +3318,7 @@ void silk_resampler_down2(int32_t*       S,    /* I/O  State vector [ 2 ]
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Second order AR filter with single delay elements */
-void silk_resampler_private_AR2(int32_t       S[],      /* I/O  State vector [ 2 ]          */
+void SilkDecoder::silk_resampler_private_AR2(int32_t       S[],      /* I/O  State vector [ 2 ]          */
                                 int32_t       out_Q8[], /* O    Output signal               */
                                 const int16_t in[],     /* I    Input signal                */
                                 const int16_t A_Q14[],  /* I    AR coefficients, Q14        */
@@ -3313,7 +3337,7 @@ void silk_resampler_private_AR2(int32_t       S[],      /* I/O  State vector [ 2
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-int16_t* silk_resampler_private_down_FIR_INTERPOL(int16_t* out, int32_t* buf, const int16_t* FIR_Coefs, int32_t FIR_Order, int32_t FIR_Fracs, int32_t max_index_Q16, int32_t index_increment_Q16) {
+int16_t* SilkDecoder::silk_resampler_private_down_FIR_INTERPOL(int16_t* out, int32_t* buf, const int16_t* FIR_Coefs, int32_t FIR_Order, int32_t FIR_Fracs, int32_t max_index_Q16, int32_t index_increment_Q16) {
     int32_t        index_Q16, res_Q6;
     int32_t*       buf_ptr;
     int32_t        interpol_ind;
@@ -3414,7 +3438,7 @@ int16_t* silk_resampler_private_down_FIR_INTERPOL(int16_t* out, int32_t* buf, co
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Resample with a 2nd order AR filter followed by FIR interpolation */
-void silk_resampler_private_down_FIR(void*         SS,    /* I/O  Resampler state             */
+void SilkDecoder::silk_resampler_private_down_FIR(void*         SS,    /* I/O  Resampler state             */
                                      int16_t       out[], /* O    Output signal               */
                                      const int16_t in[],  /* I    Input signal                */
                                      int32_t       inLen  /* I    Number of input samples     */
@@ -3424,7 +3448,7 @@ void silk_resampler_private_down_FIR(void*         SS,    /* I/O  Resampler stat
     int32_t                      max_index_Q16, index_increment_Q16;
     const int16_t* FIR_Coefs;
 
-    auto buf = silk_malloc_arr<int32_t>(S->batchSize + S->FIR_Order * sizeof(int32_t));
+    auto buf = silk_scratch_arr<int32_t>(S->batchSize + S->FIR_Order);
 
     /* Copy buffered samples to start of buffer */
     memcpy(buf.get(), S->sFIR.i32, S->FIR_Order * sizeof(int32_t));
@@ -3459,7 +3483,7 @@ void silk_resampler_private_down_FIR(void*         SS,    /* I/O  Resampler stat
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-int16_t* silk_resampler_private_IIR_FIR_INTERPOL(int16_t* out, int16_t* buf, int32_t max_index_Q16, int32_t index_increment_Q16) {
+int16_t* SilkDecoder::silk_resampler_private_IIR_FIR_INTERPOL(int16_t* out, int16_t* buf, int32_t max_index_Q16, int32_t index_increment_Q16) {
     int32_t  index_Q16, res_Q15;
     int16_t* buf_ptr;
     int32_t  table_index;
@@ -3483,7 +3507,7 @@ int16_t* silk_resampler_private_IIR_FIR_INTERPOL(int16_t* out, int16_t* buf, int
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Upsample using a combination of allpass-based 2x upsampling and FIR interpolation */
-void silk_resampler_private_IIR_FIR(void*         SS,    /* I/O  Resampler state             */
+void SilkDecoder::silk_resampler_private_IIR_FIR(void*         SS,    /* I/O  Resampler state             */
                                     int16_t       out[], /* O    Output signal               */
                                     const int16_t in[],  /* I    Input signal                */
                                     int32_t       inLen  /* I    Number of input samples     */
@@ -3492,7 +3516,7 @@ void silk_resampler_private_IIR_FIR(void*         SS,    /* I/O  Resampler state
     int32_t                      nSamplesIn;
     int32_t                      max_index_Q16, index_increment_Q16;
 
-    auto buf = silk_malloc_arr<int16_t>(2 * S->batchSize + RESAMPLER_ORDER_FIR_12 * sizeof(int16_t));
+    auto buf = silk_scratch_arr<int16_t>(2 * S->batchSize + RESAMPLER_ORDER_FIR_12);
 
     /* Copy buffered samples to start of buffer */
     memcpy(buf.get(), S->sFIR.i16, RESAMPLER_ORDER_FIR_12 * sizeof(int16_t));
@@ -3523,7 +3547,7 @@ void silk_resampler_private_IIR_FIR(void*         SS,    /* I/O  Resampler state
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Upsample by a factor 2, high quality. Uses 2nd order allpass filters for the 2x upsampling, followed by a      */
 /* notch filter just above Nyquist.                                         */
-void silk_resampler_private_up2_HQ(int32_t*       S,   /* I/O  Resampler state [ 6 ]       */
+void SilkDecoder::silk_resampler_private_up2_HQ(int32_t*       S,   /* I/O  Resampler state [ 6 ]       */
                                    int16_t*       out, /* O    Output signal [ 2 * len ]   */
                                    const int16_t* in,  /* I    Input signal [ len ]        */
                                    int32_t        len  /* I    Number of input samples     */
@@ -3588,7 +3612,7 @@ void silk_resampler_private_up2_HQ(int32_t*       S,   /* I/O  Resampler state [
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-void silk_resampler_private_up2_HQ_wrapper(void*          SS,  /* I/O  Resampler state (unused)    */
+void SilkDecoder::silk_resampler_private_up2_HQ_wrapper(void*          SS,  /* I/O  Resampler state (unused)    */
                                            int16_t*       out, /* O    Output signal [ 2 * len ]   */
                                            const int16_t* in,  /* I    Input signal [ len ]        */
                                            int32_t        len  /* I    Number of input samples     */
@@ -3598,30 +3622,30 @@ void silk_resampler_private_up2_HQ_wrapper(void*          SS,  /* I/O  Resampler
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Initialize/reset the resampler state for a given pair of input/output sampling rates */
-int32_t silk_resampler_init(uint8_t n,
+int32_t SilkDecoder::silk_resampler_init(uint8_t n,
                             int32_t                      Fs_Hz_in,  /* I    Input sampling rate (Hz)                                    */
                             int32_t                      Fs_Hz_out, /* I    Output sampling rate (Hz)                                   */
                             int32_t                      forEnc     /* I    If 1: encoder; if 0: decoder                                */
 ) {
     int32_t up2x;
     /* Clear state */
-    memset(&s_resampler_state[n], 0, sizeof(silk_resampler_state_struct_t));
+    memset(&m_resampler_state[n], 0, sizeof(silk_resampler_state_struct_t));
 
     /* Input checking */
     if(forEnc) {
         if((Fs_Hz_in != 8000 && Fs_Hz_in != 12000 && Fs_Hz_in != 16000 && Fs_Hz_in != 24000 && Fs_Hz_in != 48000) || (Fs_Hz_out != 8000 && Fs_Hz_out != 12000 && Fs_Hz_out != 16000)) { return -1; }
-        s_resampler_state[n].inputDelay = delay_matrix_enc[rateID(Fs_Hz_in)][rateID(Fs_Hz_out)];
+        m_resampler_state[n].inputDelay = delay_matrix_enc[rateID(Fs_Hz_in)][rateID(Fs_Hz_out)];
     }
     else {
         if((Fs_Hz_in != 8000 && Fs_Hz_in != 12000 && Fs_Hz_in != 16000) || (Fs_Hz_out != 8000 && Fs_Hz_out != 12000 && Fs_Hz_out != 16000 && Fs_Hz_out != 24000 && Fs_Hz_out != 48000)) { return -1; }
-        s_resampler_state[n].inputDelay = delay_matrix_dec[rateID(Fs_Hz_in)][rateID(Fs_Hz_out)];
+        m_resampler_state[n].inputDelay = delay_matrix_dec[rateID(Fs_Hz_in)][rateID(Fs_Hz_out)];
     }
 
-    s_resampler_state[n].Fs_in_kHz = silk_DIV32_16(Fs_Hz_in, 1000);
-    s_resampler_state[n].Fs_out_kHz = silk_DIV32_16(Fs_Hz_out, 1000);
+    m_resampler_state[n].Fs_in_kHz = silk_DIV32_16(Fs_Hz_in, 1000);
+    m_resampler_state[n].Fs_out_kHz = silk_DIV32_16(Fs_Hz_out, 1000);
 
     /* Number of samples processed per batch */
-    s_resampler_state[n].batchSize = s_resampler_state[n].Fs_in_kHz * RESAMPLER_MAX_BATCH_SIZE_MS;
+    m_resampler_state[n].batchSize = m_resampler_state[n].Fs_in_kHz * RESAMPLER_MAX_BATCH_SIZE_MS;
 
     /* Find resampler with the right sampling ratio */
     up2x = 0;
@@ -3629,41 +3653,41 @@ int32_t silk_resampler_init(uint8_t n,
         /* Upsample */
         if(Fs_Hz_out == silk_MUL(Fs_Hz_in, 2)) { /* Fs_out : Fs_in = 2 : 1 */
             /* Special case: directly use 2x upsampler */
-            s_resampler_state[n].resampler_function = USE_silk_resampler_private_up2_HQ_wrapper;
+            m_resampler_state[n].resampler_function = USE_silk_resampler_private_up2_HQ_wrapper;
         }
         else {
             /* Default resampler */
-            s_resampler_state[n].resampler_function = USE_silk_resampler_private_IIR_FIR;
+            m_resampler_state[n].resampler_function = USE_silk_resampler_private_IIR_FIR;
             up2x = 1;
         }
     }
     else if(Fs_Hz_out < Fs_Hz_in) {
         /* Downsample */
-        s_resampler_state[n].resampler_function = USE_silk_resampler_private_down_FIR;
+        m_resampler_state[n].resampler_function = USE_silk_resampler_private_down_FIR;
         if(silk_MUL(Fs_Hz_out, 4) == silk_MUL(Fs_Hz_in, 3)) { /* Fs_out : Fs_in = 3 : 4 */
-            s_resampler_state[n].FIR_Fracs = 3;
-            s_resampler_state[n].FIR_Order = RESAMPLER_DOWN_ORDER_FIR0;
-            s_resampler_state[n].Coefs = silk_Resampler_3_4_COEFS;
+            m_resampler_state[n].FIR_Fracs = 3;
+            m_resampler_state[n].FIR_Order = RESAMPLER_DOWN_ORDER_FIR0;
+            m_resampler_state[n].Coefs = silk_Resampler_3_4_COEFS;
         }
-        else if(silk_MUL(Fs_Hz_out, 3) == silk_MUL(Fs_Hz_in, 2)) { /* Fs_out : Fs_in = 2 : 3 */ s_resampler_state[n].FIR_Fracs = 2;
-            s_resampler_state[n].FIR_Order = RESAMPLER_DOWN_ORDER_FIR0;
-            s_resampler_state[n].Coefs = silk_Resampler_2_3_COEFS;
+        else if(silk_MUL(Fs_Hz_out, 3) == silk_MUL(Fs_Hz_in, 2)) { /* Fs_out : Fs_in = 2 : 3 */ m_resampler_state[n].FIR_Fracs = 2;
+            m_resampler_state[n].FIR_Order = RESAMPLER_DOWN_ORDER_FIR0;
+            m_resampler_state[n].Coefs = silk_Resampler_2_3_COEFS;
         }
-        else if(silk_MUL(Fs_Hz_out, 2) == Fs_Hz_in) { /* Fs_out : Fs_in = 1 : 2 */ s_resampler_state[n].FIR_Fracs = 1;
-            s_resampler_state[n].FIR_Order = RESAMPLER_DOWN_ORDER_FIR1;
-            s_resampler_state[n].Coefs = silk_Resampler_1_2_COEFS;
+        else if(silk_MUL(Fs_Hz_out, 2) == Fs_Hz_in) { /* Fs_out : Fs_in = 1 : 2 */ m_resampler_state[n].FIR_Fracs = 1;
+            m_resampler_state[n].FIR_Order = RESAMPLER_DOWN_ORDER_FIR1;
+            m_resampler_state[n].Coefs = silk_Resampler_1_2_COEFS;
         }
-        else if(silk_MUL(Fs_Hz_out, 3) == Fs_Hz_in) { /* Fs_out : Fs_in = 1 : 3 */ s_resampler_state[n].FIR_Fracs = 1;
-            s_resampler_state[n].FIR_Order = RESAMPLER_DOWN_ORDER_FIR2;
-            s_resampler_state[n].Coefs = silk_Resampler_1_3_COEFS;
+        else if(silk_MUL(Fs_Hz_out, 3) == Fs_Hz_in) { /* Fs_out : Fs_in = 1 : 3 */ m_resampler_state[n].FIR_Fracs = 1;
+            m_resampler_state[n].FIR_Order = RESAMPLER_DOWN_ORDER_FIR2;
+            m_resampler_state[n].Coefs = silk_Resampler_1_3_COEFS;
         }
-        else if(silk_MUL(Fs_Hz_out, 4) == Fs_Hz_in) { /* Fs_out : Fs_in = 1 : 4 */ s_resampler_state[n].FIR_Fracs = 1;
-            s_resampler_state[n].FIR_Order = RESAMPLER_DOWN_ORDER_FIR2;
-            s_resampler_state[n].Coefs = silk_Resampler_1_4_COEFS;
+        else if(silk_MUL(Fs_Hz_out, 4) == Fs_Hz_in) { /* Fs_out : Fs_in = 1 : 4 */ m_resampler_state[n].FIR_Fracs = 1;
+            m_resampler_state[n].FIR_Order = RESAMPLER_DOWN_ORDER_FIR2;
+            m_resampler_state[n].Coefs = silk_Resampler_1_4_COEFS;
         }
-        else if(silk_MUL(Fs_Hz_out, 6) == Fs_Hz_in) { /* Fs_out : Fs_in = 1 : 6 */ s_resampler_state[n].FIR_Fracs = 1;
-            s_resampler_state[n].FIR_Order = RESAMPLER_DOWN_ORDER_FIR2;
-            s_resampler_state[n].Coefs = silk_Resampler_1_6_COEFS;
+        else if(silk_MUL(Fs_Hz_out, 6) == Fs_Hz_in) { /* Fs_out : Fs_in = 1 : 6 */ m_resampler_state[n].FIR_Fracs = 1;
+            m_resampler_state[n].FIR_Order = RESAMPLER_DOWN_ORDER_FIR2;
+            m_resampler_state[n].Coefs = silk_Resampler_1_6_COEFS;
         }
         else {
             /* None available */
@@ -3672,19 +3696,19 @@ int32_t silk_resampler_init(uint8_t n,
     }
     else {
         /* Input and output sampling rates are equal: copy */
-        s_resampler_state[n].resampler_function = USE_silk_resampler_copy;
+        m_resampler_state[n].resampler_function = USE_silk_resampler_copy;
     }
 
     /* Ratio of input/output samples */
-    s_resampler_state[n].invRatio_Q16 = silk_LSHIFT32(silk_DIV32(silk_LSHIFT32(Fs_Hz_in, 14 + up2x), Fs_Hz_out), 2);
+    m_resampler_state[n].invRatio_Q16 = silk_LSHIFT32(silk_DIV32(silk_LSHIFT32(Fs_Hz_in, 14 + up2x), Fs_Hz_out), 2);
     /* Make sure the ratio is rounded up */
-    while(silk_SMULWW(s_resampler_state[n].invRatio_Q16, Fs_Hz_out) < silk_LSHIFT32(Fs_Hz_in, up2x)) { s_resampler_state[n].invRatio_Q16++; }
+    while(silk_SMULWW(m_resampler_state[n].invRatio_Q16, Fs_Hz_out) < silk_LSHIFT32(Fs_Hz_in, up2x)) { m_resampler_state[n].invRatio_Q16++; }
 
     return 0;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Resampler: convert from one sampling rate to another Input and output sampling rate are at most 48000 Hz  */
-int32_t silk_resampler(uint8_t n,
+int32_t SilkDecoder::silk_resampler(uint8_t n,
                        int16_t                      out[], /* O    Output signal                                               */
                        const int16_t                in[],  /* I    Input signal                                                */
                        int32_t                      inLen  /* I    Number of input samples                                     */
@@ -3692,38 +3716,38 @@ int32_t silk_resampler(uint8_t n,
     int32_t nSamples;
 
     /* Need at least 1 ms of input data */
-    assert(inLen >= s_resampler_state[n].Fs_in_kHz);
+    assert(inLen >= m_resampler_state[n].Fs_in_kHz);
     /* Delay can't exceed the 1 ms of buffering */
-    assert(s_resampler_state[n].inputDelay <= s_resampler_state[n].Fs_in_kHz);
+    assert(m_resampler_state[n].inputDelay <= m_resampler_state[n].Fs_in_kHz);
 
-    nSamples = s_resampler_state[n].Fs_in_kHz - s_resampler_state[n].inputDelay;
+    nSamples = m_resampler_state[n].Fs_in_kHz - m_resampler_state[n].inputDelay;
 
     /* Copy to delay buffer */
-    memcpy(&s_resampler_state[n].delayBuf[s_resampler_state[n].inputDelay], in, nSamples * sizeof(int16_t));
+    memcpy(&m_resampler_state[n].delayBuf[m_resampler_state[n].inputDelay], in, nSamples * sizeof(int16_t));
 
-    switch(s_resampler_state[n].resampler_function) {
+    switch(m_resampler_state[n].resampler_function) {
         case USE_silk_resampler_private_up2_HQ_wrapper:
-            silk_resampler_private_up2_HQ_wrapper(&s_resampler_state[n], out, s_resampler_state[n].delayBuf, s_resampler_state[n].Fs_in_kHz);
-            silk_resampler_private_up2_HQ_wrapper(&s_resampler_state[n], &out[s_resampler_state[n].Fs_out_kHz], &in[nSamples], inLen - s_resampler_state[n].Fs_in_kHz);
+            silk_resampler_private_up2_HQ_wrapper(&m_resampler_state[n], out, m_resampler_state[n].delayBuf, m_resampler_state[n].Fs_in_kHz);
+            silk_resampler_private_up2_HQ_wrapper(&m_resampler_state[n], &out[m_resampler_state[n].Fs_out_kHz], &in[nSamples], inLen - m_resampler_state[n].Fs_in_kHz);
             break;
         case USE_silk_resampler_private_IIR_FIR:
-            silk_resampler_private_IIR_FIR(&s_resampler_state[n], out, s_resampler_state[n].delayBuf, s_resampler_state[n].Fs_in_kHz);
-            silk_resampler_private_IIR_FIR(&s_resampler_state[n], &out[s_resampler_state[n].Fs_out_kHz], &in[nSamples], inLen - s_resampler_state[n].Fs_in_kHz);
+            silk_resampler_private_IIR_FIR(&m_resampler_state[n], out, m_resampler_state[n].delayBuf, m_resampler_state[n].Fs_in_kHz);
+            silk_resampler_private_IIR_FIR(&m_resampler_state[n], &out[m_resampler_state[n].Fs_out_kHz], &in[nSamples], inLen - m_resampler_state[n].Fs_in_kHz);
             break;
         case USE_silk_resampler_private_down_FIR:
-            silk_resampler_private_down_FIR(&s_resampler_state[n], out, s_resampler_state[n].delayBuf, s_resampler_state[n].Fs_in_kHz);
-            silk_resampler_private_down_FIR(&s_resampler_state[n], &out[s_resampler_state[n].Fs_out_kHz], &in[nSamples], inLen - s_resampler_state[n].Fs_in_kHz);
+            silk_resampler_private_down_FIR(&m_resampler_state[n], out, m_resampler_state[n].delayBuf, m_resampler_state[n].Fs_in_kHz);
+            silk_resampler_private_down_FIR(&m_resampler_state[n], &out[m_resampler_state[n].Fs_out_kHz], &in[nSamples], inLen - m_resampler_state[n].Fs_in_kHz);
             break;
-        default: memcpy(out, s_resampler_state[n].delayBuf, s_resampler_state[n].Fs_in_kHz * sizeof(int16_t)); memcpy(&out[s_resampler_state[n].Fs_out_kHz], &in[nSamples], (inLen - s_resampler_state[n].Fs_in_kHz) * sizeof(int16_t));
+        default: memcpy(out, m_resampler_state[n].delayBuf, m_resampler_state[n].Fs_in_kHz * sizeof(int16_t)); memcpy(&out[m_resampler_state[n].Fs_out_kHz], &in[nSamples], (inLen - m_resampler_state[n].Fs_in_kHz) * sizeof(int16_t));
     }
 
     /* Copy to delay buffer */
-    memcpy(s_resampler_state[n].delayBuf, &in[inLen - s_resampler_state[n].inputDelay], s_resampler_state[n].inputDelay * sizeof(int16_t));
+    memcpy(m_resampler_state[n].delayBuf, &in[inLen - m_resampler_state[n].inputDelay], m_resampler_state[n].inputDelay * sizeof(int16_t));
 
     return 0;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t silk_sigm_Q15(int32_t in_Q5) {
+int32_t SilkDecoder::silk_sigm_Q15(int32_t in_Q5) {
     int32_t ind;
     if(in_Q5 < 0) {
         /* Negative input */
@@ -3747,7 +3771,7 @@ int32_t silk_sigm_Q15(int32_t in_Q5) {
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // silk_insertion_sort_increasing(Unsorted / Sorted vector, Index vector for the sorted elements, Vector length, Number of correctly sorted positions )
-void silk_insertion_sort_increasing(int32_t* a, int32_t* idx, const int32_t L, const int32_t K){
+void SilkDecoder::silk_insertion_sort_increasing(int32_t* a, int32_t* idx, const int32_t L, const int32_t K){
     int32_t value;
     int32_t i, j;
 
@@ -3785,7 +3809,7 @@ void silk_insertion_sort_increasing(int32_t* a, int32_t* idx, const int32_t L, c
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* This function is only used by the fixed-point build */
-void silk_insertion_sort_decreasing_int16(int16_t*      a,   /* I/O   Unsorted / Sorted vector      */
+void SilkDecoder::silk_insertion_sort_decreasing_int16(int16_t*      a,   /* I/O   Unsorted / Sorted vector      */
                                           int32_t*      idx, /* O     Index vector for the sorted elements    */
                                           const int32_t L,   /* I     Vector length */
                                           const int32_t K    /* I     Number of correctly sorted positions  */
@@ -3828,7 +3852,7 @@ void silk_insertion_sort_decreasing_int16(int16_t*      a,   /* I/O   Unsorted /
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-void silk_insertion_sort_increasing_all_values_int16(int16_t*      a, /* I/O   Unsorted / Sorted vector     */
+void SilkDecoder::silk_insertion_sort_increasing_all_values_int16(int16_t*      a, /* I/O   Unsorted / Sorted vector     */
                                                      const int32_t L  /* I     Vector length */
 ) {
     int32_t value;
@@ -3847,7 +3871,7 @@ void silk_insertion_sort_increasing_all_values_int16(int16_t*      a, /* I/O   U
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Compute number of bits to right shift the sum of squares of a vector */
 /* of int16s to make it fit in an int32                                 */
-void silk_sum_sqr_shift(int32_t*       energy, /* O   Energy of x, after shifting to the right                     */
+void SilkDecoder::silk_sum_sqr_shift(int32_t*       energy, /* O   Energy of x, after shifting to the right                     */
                         int32_t*       shift,  /* O   Number of bits right shift applied to energy                 */
                         const int16_t* x,      /* I   Input vector                                                 */
                         int32_t        len     /* I   Length of input vector                                       */
@@ -3894,7 +3918,7 @@ void silk_sum_sqr_shift(int32_t*       energy, /* O   Energy of x, after shiftin
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Entropy constrained matrix-weighted VQ, hard-coded to 5-element vectors, for a single input data vector */
-void silk_VQ_WMat_EC_c(int8_t*        ind,          /* O    index of best codebook vector               */
+void SilkDecoder::silk_VQ_WMat_EC_c(int8_t*        ind,          /* O    index of best codebook vector               */
                        int32_t*       res_nrg_Q15,  /* O    best residual energy                        */
                        int32_t*       rate_dist_Q8, /* O    best total bitrate                          */
                        int32_t*       gain_Q7,      /* O    sum of absolute LTP coefficients            */
@@ -3992,7 +4016,7 @@ void silk_VQ_WMat_EC_c(int8_t*        ind,          /* O    index of best codebo
 }
 //-----------------------------------------------------------------------------------------------------------
 /* Find least-squares prediction gain for one signal based on another and quantize it */
-int32_t silk_stereo_find_predictor(                                /* O    Returns predictor in Q13                    */
+int32_t SilkDecoder::silk_stereo_find_predictor(                                /* O    Returns predictor in Q13                    */
                                    int32_t*      ratio_Q14,        /* O    Ratio of residual and mid energies          */
                                    const int16_t x[],              /* I    Basis signal                                */
                                    const int16_t y[],              /* I    Target signal                               */
@@ -4036,7 +4060,7 @@ int32_t silk_stereo_find_predictor(                                /* O    Retur
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Convert adaptive Mid/Side representation to Left/Right stereo signal */
-void silk_stereo_MS_to_LR(stereo_dec_state* state,       /* I/O  State                                       */
+void SilkDecoder::silk_stereo_MS_to_LR(stereo_dec_state* state,       /* I/O  State                                       */
                           int16_t           x1[],        /* I/O  Left input signal, becomes mid signal       */
                           int16_t           x2[],        /* I/O  Right input signal, becomes side signal     */
                           const int32_t     pred_Q13[],  /* I    Predictors                                  */
@@ -4087,7 +4111,7 @@ void silk_stereo_MS_to_LR(stereo_dec_state* state,       /* I/O  State
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 /* Initialization of the Silk VAD */
-int32_t silk_VAD_Init(                           /* O    Return value, 0 if success                  */
+int32_t SilkDecoder::silk_VAD_Init(                           /* O    Return value, 0 if success                  */
                       silk_VAD_state* psSilk_VAD /* I/O  Pointer to Silk VAD state                   */
 ) {
     int32_t b, ret = 0;
@@ -29,7 +29,6 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <Arduino.h>
 
 #include "celt.h"
-#include "opus_decoder.h"
 #include <memory>
 
 
@@ -1011,6 +1010,7 @@ using silk_ptr_obj = std::unique_ptr<T, Silk_PsramDeleter>;
         return std::unique_ptr<T[], Silk_PsramDeleter>(raw);
     }
 
+
     template <typename T>
     silk_ptr_obj<T> silk_malloc_obj() {
         T* raw = static_cast<T*>(ps_malloc(sizeof(T)));
@@ -1021,104 +1021,133 @@ using silk_ptr_obj = std::unique_ptr<T, Silk_PsramDeleter>;
     }
 //——————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
 
-bool SILKDecoder_AllocateBuffers();
-void SILKDecoder_ClearBuffers();
-void SILKDecoder_FreeBuffers();
-void silk_ana_filt_bank_1(const int16_t *in, int32_t *S, int16_t *outL, int16_t *outH, const int32_t N);
-void silk_biquad_alt_stride1(const int16_t *in, const int32_t *B_Q28, const int32_t *A_Q28, int32_t *S,
-                             int16_t *out, const int32_t len);
-void silk_biquad_alt_stride2_c(const int16_t *in, const int32_t *B_Q28, const int32_t *A_Q28, int32_t *S,
-                               int16_t *out, const int32_t len);
-void silk_bwexpander_32(int32_t *ar, const int32_t d, int32_t chirp_Q16);
-void silk_bwexpander(int16_t *ar, const int32_t d, int32_t chirp_Q16);
-void silk_stereo_decode_pred(int32_t pred_Q13[]);
-void silk_stereo_decode_mid_only(int32_t *decode_only_mid);
-void silk_PLC_Reset(uint8_t n);
-void silk_PLC(uint8_t n, int16_t frame[], int32_t lost);
-void silk_PLC_glue_frames(uint8_t, int16_t frame[], int32_t length);
-void silk_LP_interpolate_filter_taps(int32_t B_Q28[TRANSITION_NB], int32_t A_Q28[TRANSITION_NA], const int32_t ind, const int32_t fac_Q16);
-void silk_LP_variable_cutoff(silk_LP_state *psLP, int16_t *frame, const int32_t frame_length);
-void silk_NLSF_unpack(int16_t ec_ix[], uint8_t pred_Q8[], const silk_NLSF_CB_struct *psNLSF_CB, const int32_t CB1_index);
-void silk_NLSF_decode(int16_t *pNLSF_Q15, int8_t *NLSFIndices, const silk_NLSF_CB_struct   *psNLSF_CB);
-int32_t silk_decoder_set_fs(uint8_t n, int32_t fs_kHz, int32_t fs_API_Hz);
-void silk_decode_indices(uint8_t n, int32_t FrameIndex, int32_t decode_LBRR, int32_t condCoding);
-void silk_decode_parameters(uint8_t n, int32_t condCoding);
-void silk_decode_core(uint8_t n, int16_t xq[], const int16_t pulses[MAX_FRAME_LENGTH]);
-void silk_decode_pulses(int16_t pulses[], const int32_t signalType, const int32_t quantOffsetType, const int32_t frame_length);
-int32_t silk_init_decoder(uint8_t n);
-int32_t silk_NLSF_del_dec_quant(int8_t indices[], const int16_t x_Q10[], const int16_t w_Q5[],
-                                const uint8_t pred_coef_Q8[], const int16_t ec_ix[], const uint8_t ec_rates_Q5[],
-                                const int32_t quant_step_size_Q16, const int16_t inv_quant_step_size_Q6,
-                                const int32_t mu_Q20, const int16_t order);
-void silk_NLSF_VQ(int32_t err_Q26[], const int16_t in_Q15[], const uint8_t pCB_Q8[], const int16_t pWght_Q9[],
-                  const int32_t K, const int32_t LPC_order);
-void silk_LP_variable_cutoff(silk_LP_state *psLP, int16_t *frame, const int32_t frame_length);
-int32_t silk_VAD_Init(silk_VAD_state *psSilk_VAD);
-void silk_stereo_MS_to_LR(stereo_dec_state *state, int16_t x1[], int16_t x2[], const int32_t pred_Q13[], int32_t fs_kHz,
-                          int32_t frame_length);
-int32_t silk_stereo_find_predictor(int32_t *ratio_Q14, const int16_t x[], const int16_t y[], int32_t mid_res_amp_Q0[], int32_t length, int32_t smooth_coef_Q16);
-void silk_stereo_quant_pred(int32_t pred_Q13[], int8_t ix[2][3]);
-void silk_stereo_decode_pred(int32_t pred_Q13[]);
-void silk_stereo_decode_mid_only(int32_t *decode_only_mid);
-void silk_decode_signs(int16_t pulses[], int32_t length, const int32_t signalType, const int32_t quantOffsetType, const int32_t sum_pulses[MAX_NB_SHELL_BLOCKS]);
-void silk_shell_decoder(int16_t *pulses0, const int32_t pulses4);
-void silk_gains_quant(int8_t ind[MAX_NB_SUBFR], int32_t gain_Q16[MAX_NB_SUBFR], int8_t *prev_ind, const int32_t conditional, const int32_t nb_subfr);
-void silk_gains_dequant(int32_t gain_Q16[MAX_NB_SUBFR], const int8_t ind[MAX_NB_SUBFR], int8_t *prev_ind, const int32_t conditional, const int32_t nb_subfr);
-int32_t silk_gains_ID(const int8_t ind[MAX_NB_SUBFR], const int32_t nb_subfr);
-void silk_interpolate(int16_t xi[MAX_LPC_ORDER], const int16_t x0[MAX_LPC_ORDER], const int16_t x1[MAX_LPC_ORDER], const int32_t ifact_Q2, const int32_t d);
-void silk_quant_LTP_gains(int16_t B_Q14[MAX_NB_SUBFR * LTP_ORDER], int8_t cbk_index[MAX_NB_SUBFR],
-                          int8_t *periodicity_index, int32_t *sum_gain_dB_Q7, int32_t *pred_gain_dB_Q7,
-                          const int32_t XX_Q17[MAX_NB_SUBFR * LTP_ORDER * LTP_ORDER],
-                          const int32_t xX_Q17[MAX_NB_SUBFR * LTP_ORDER], const int32_t subfr_len,
-                          const int32_t nb_subfr);
-void silk_VQ_WMat_EC_c(int8_t *ind, int32_t *res_nrg_Q15, int32_t *rate_dist_Q8, int32_t *gain_Q7,
-                       const int32_t *XX_Q17, const int32_t *xX_Q17, const int8_t *cb_Q7, const uint8_t *cb_gain_Q7,
-                       const uint8_t *cl_Q5, const int32_t subfr_len, const int32_t max_gain_Q7, const int32_t L);
-void silk_CNG_Reset(uint8_t n);
-void silk_CNG(uint8_t n, int16_t frame[], int32_t length);
-int32_t silk_Get_Decoder_Size(int32_t *decSizeBytes);
-int32_t silk_InitDecoder();
-void silk_setRawParams(uint8_t channels, uint8_t API_channels, uint8_t payloadSize_ms, uint32_t internalSampleRate, uint32_t API_samleRate);
-int32_t silk_Decode(int32_t lostFlag, int32_t newPacketFlag, int16_t *samplesOut, int32_t *nSamplesOut);
-void silk_NLSF2A_find_poly(int32_t *out, const int32_t *cLSF, int32_t dd);
-void silk_NLSF2A(int16_t *a_Q12, const int16_t *NLSF, const int32_t d);
-void silk_CNG_exc(int32_t exc_Q14[], int32_t exc_buf_Q14[], int32_t length, int32_t *rand_seed);
-int32_t silk_decode_frame(uint8_t n, int16_t pOut[], int32_t *pN, int32_t lostFlag,
-                          int32_t condCoding);
-void silk_decode_pitch(int16_t lagIndex, int8_t contourIndex, int32_t pitch_lags[], const int32_t Fs_kHz, const int32_t nb_subfr);
-int32_t silk_inner_prod_aligned_scale(const int16_t *const inVec1, const int16_t *const inVec2, const int32_t scale, const int32_t len);
-int32_t silk_lin2log(const int32_t inLin);
-int32_t silk_log2lin(const int32_t inLog_Q7);
-void silk_LPC_analysis_filter(int16_t *out, const int16_t *in, const int16_t *B, const int32_t len, const int32_t d);
-void silk_LPC_fit(int16_t *a_QOUT, int32_t *a_QIN, const int32_t QOUT, const int32_t QIN, const int32_t d);
-int32_t LPC_inverse_pred_gain_QA_c(int32_t A_QA[SILK_MAX_ORDER_LPC], const int32_t order);
-int32_t silk_LPC_inverse_pred_gain_c(const int16_t *A_Q12, const int32_t order);
-void silk_NLSF_residual_dequant(int16_t x_Q10[], const int8_t indices[], const uint8_t pred_coef_Q8[],
-                                       const int32_t quant_step_size_Q16, const int16_t order);
-void silk_NLSF_stabilize(int16_t *NLSF_Q15, const int16_t *NDeltaMin_Q15, const int32_t L);
-void silk_NLSF_VQ_weights_laroia(int16_t *pNLSFW_Q_OUT, const int16_t *pNLSF_Q15, const int32_t D);
-void silk_PLC_update(uint8_t n);
-void silk_PLC_energy(int32_t *energy1, int32_t *shift1, int32_t *energy2, int32_t *shift2,
-                            const int32_t *exc_Q14, const int32_t *prevGain_Q10, int subfr_length, int nb_subfr);
-void silk_PLC_conceal(uint8_t n, int16_t frame[]);
-void silk_resampler_down2_3(int32_t *S, int16_t *out, const int16_t *in, int32_t inLen);
-void silk_resampler_down2(int32_t *S, int16_t *out, const int16_t *in, int32_t inLen);
-void silk_resampler_private_AR2(int32_t S[], int32_t out_Q8[], const int16_t in[], const int16_t A_Q14[], int32_t len);
-int16_t *silk_resampler_private_down_FIR_INTERPOL(int16_t *out, int32_t *buf, const int16_t *FIR_Coefs,
-                                                         int32_t FIR_Order, int32_t FIR_Fracs, int32_t max_index_Q16,
-                                                         int32_t index_increment_Q16);
-void silk_resampler_private_down_FIR(void *SS, int16_t out[], const int16_t in[], int32_t inLen);
-int16_t *silk_resampler_private_IIR_FIR_INTERPOL(int16_t *out, int16_t *buf, int32_t max_index_Q16,
-                                                        int32_t index_increment_Q16);
-void silk_resampler_private_IIR_FIR(void *SS, int16_t out[], const int16_t in[], int32_t inLen);
-void silk_resampler_private_up2_HQ(int32_t *S, int16_t *out, const int16_t *in, int32_t len);
-void silk_resampler_private_up2_HQ_wrapper(void *SS, int16_t *out, const int16_t *in, int32_t len);
-int32_t silk_resampler_init(uint8_t n, int32_t Fs_Hz_in, int32_t Fs_Hz_out, int32_t forEnc);
-int32_t silk_resampler(uint8_t n, int16_t out[], const int16_t in[], int32_t inLen);
-int32_t silk_sigm_Q15(int32_t in_Q5);
-void silk_insertion_sort_increasing(int32_t *a, int32_t *idx, const int32_t L, const int32_t K);
-void silk_insertion_sort_decreasing_int16(int16_t *a, int32_t *idx, const int32_t L, const int32_t K);
-void silk_insertion_sort_increasing_all_values_int16(int16_t *a, const int32_t L);
-void silk_sum_sqr_shift(int32_t *energy, int32_t *shift, const int16_t *x, int32_t len);
+// SILK layer of the OPUS decoder, owned by OPUSDecoder. It reads from the range decoder of the CELT layer of the same
+// stream.
+class SilkDecoder {
+public:
+    explicit SilkDecoder(CeltDecoder& celt) : m_celt(celt) {}
+    bool allocateBuffers();
+    void clearBuffers();
+    void freeBuffers();
+    int32_t silk_InitDecoder();
+    void silk_setRawParams(uint8_t channels, uint8_t API_channels, uint8_t payloadSize_ms, uint32_t internalSampleRate, uint32_t API_samleRate);
+    void silk_setDecControl(int32_t nChannelsAPI, int32_t nChannelsInternal, int32_t API_sampleRate);
+    int32_t silk_Decode(int32_t lostFlag, int32_t newPacketFlag, int16_t *samplesOut, int32_t *nSamplesOut);
+    uint32_t silk_getPrevPitchLag();
+
+private:
+    void silk_ana_filt_bank_1(const int16_t *in, int32_t *S, int16_t *outL, int16_t *outH, const int32_t N);
+    void silk_biquad_alt_stride1(const int16_t *in, const int32_t *B_Q28, const int32_t *A_Q28, int32_t *S,
+                                 int16_t *out, const int32_t len);
+    void silk_biquad_alt_stride2_c(const int16_t *in, const int32_t *B_Q28, const int32_t *A_Q28, int32_t *S,
+                                   int16_t *out, const int32_t len);
+    void silk_bwexpander_32(int32_t *ar, const int32_t d, int32_t chirp_Q16);
+    void silk_bwexpander(int16_t *ar, const int32_t d, int32_t chirp_Q16);
+    void silk_stereo_decode_pred(int32_t pred_Q13[]);
+    void silk_stereo_decode_mid_only(int32_t *decode_only_mid);
+    void silk_PLC_Reset(uint8_t n);
+    void silk_PLC(uint8_t n, int16_t frame[], int32_t lost);
+    void silk_PLC_glue_frames(uint8_t, int16_t frame[], int32_t length);
+    void silk_LP_interpolate_filter_taps(int32_t B_Q28[TRANSITION_NB], int32_t A_Q28[TRANSITION_NA], const int32_t ind, const int32_t fac_Q16);
+    void silk_LP_variable_cutoff(silk_LP_state *psLP, int16_t *frame, const int32_t frame_length);
+    void silk_NLSF_unpack(int16_t ec_ix[], uint8_t pred_Q8[], const silk_NLSF_CB_struct *psNLSF_CB, const int32_t CB1_index);
+    void silk_NLSF_decode(int16_t *pNLSF_Q15, int8_t *NLSFIndices, const silk_NLSF_CB_struct   *psNLSF_CB);
+    int32_t silk_decoder_set_fs(uint8_t n, int32_t fs_kHz, int32_t fs_API_Hz);
+    void silk_decode_indices(uint8_t n, int32_t FrameIndex, int32_t decode_LBRR, int32_t condCoding);
+    void silk_decode_parameters(uint8_t n, int32_t condCoding);
+    void silk_decode_core(uint8_t n, int16_t xq[], const int16_t pulses[MAX_FRAME_LENGTH]);
+    void silk_decode_pulses(int16_t pulses[], const int32_t signalType, const int32_t quantOffsetType, const int32_t frame_length);
+    int32_t silk_init_decoder(uint8_t n);
+    int32_t silk_NLSF_del_dec_quant(int8_t indices[], const int16_t x_Q10[], const int16_t w_Q5[],
+                                    const uint8_t pred_coef_Q8[], const int16_t ec_ix[], const uint8_t ec_rates_Q5[],
+                                    const int32_t quant_step_size_Q16, const int16_t inv_quant_step_size_Q6,
+                                    const int32_t mu_Q20, const int16_t order);
+    void silk_NLSF_VQ(int32_t err_Q26[], const int16_t in_Q15[], const uint8_t pCB_Q8[], const int16_t pWght_Q9[],
+                      const int32_t K, const int32_t LPC_order);
+    int32_t silk_VAD_Init(silk_VAD_state *psSilk_VAD);
+    void silk_stereo_MS_to_LR(stereo_dec_state *state, int16_t x1[], int16_t x2[], const int32_t pred_Q13[], int32_t fs_kHz,
+                              int32_t frame_length);
+    int32_t silk_stereo_find_predictor(int32_t *ratio_Q14, const int16_t x[], const int16_t y[], int32_t mid_res_amp_Q0[], int32_t length, int32_t smooth_coef_Q16);
+    void silk_stereo_quant_pred(int32_t pred_Q13[], int8_t ix[2][3]);
+    void silk_decode_signs(int16_t pulses[], int32_t length, const int32_t signalType, const int32_t quantOffsetType, const int32_t sum_pulses[MAX_NB_SHELL_BLOCKS]);
+    void silk_shell_decoder(int16_t *pulses0, const int32_t pulses4);
+    void silk_gains_quant(int8_t ind[MAX_NB_SUBFR], int32_t gain_Q16[MAX_NB_SUBFR], int8_t *prev_ind, const int32_t conditional, const int32_t nb_subfr);
+    void silk_gains_dequant(int32_t gain_Q16[MAX_NB_SUBFR], const int8_t ind[MAX_NB_SUBFR], int8_t *prev_ind, const int32_t conditional, const int32_t nb_subfr);
+    int32_t silk_gains_ID(const int8_t ind[MAX_NB_SUBFR], const int32_t nb_subfr);
+    void silk_interpolate(int16_t xi[MAX_LPC_ORDER], const int16_t x0[MAX_LPC_ORDER], const int16_t x1[MAX_LPC_ORDER], const int32_t ifact_Q2, const int32_t d);
+    void silk_quant_LTP_gains(int16_t B_Q14[MAX_NB_SUBFR * LTP_ORDER], int8_t cbk_index[MAX_NB_SUBFR],
+                              int8_t *periodicity_index, int32_t *sum_gain_dB_Q7, int32_t *pred_gain_dB_Q7,
+                              const int32_t XX_Q17[MAX_NB_SUBFR * LTP_ORDER * LTP_ORDER],
+                              const int32_t xX_Q17[MAX_NB_SUBFR * LTP_ORDER], const int32_t subfr_len,
+                              const int32_t nb_subfr);
+    void silk_VQ_WMat_EC_c(int8_t *ind, int32_t *res_nrg_Q15, int32_t *rate_dist_Q8, int32_t *gain_Q7,
+                           const int32_t *XX_Q17, const int32_t *xX_Q17, const int8_t *cb_Q7, const uint8_t *cb_gain_Q7,
+                           const uint8_t *cl_Q5, const int32_t subfr_len, const int32_t max_gain_Q7, const int32_t L);
+    void silk_CNG_Reset(uint8_t n);
+    void silk_CNG(uint8_t n, int16_t frame[], int32_t length);
+    int32_t silk_Get_Decoder_Size(int32_t *decSizeBytes);
+    void silk_NLSF2A_find_poly(int32_t *out, const int32_t *cLSF, int32_t dd);
+    void silk_NLSF2A(int16_t *a_Q12, const int16_t *NLSF, const int32_t d);
+    void silk_CNG_exc(int32_t exc_Q14[], int32_t exc_buf_Q14[], int32_t length, int32_t *rand_seed);
+    int32_t silk_decode_frame(uint8_t n, int16_t pOut[], int32_t *pN, int32_t lostFlag,
+                              int32_t condCoding);
+    void silk_decode_pitch(int16_t lagIndex, int8_t contourIndex, int32_t pitch_lags[], const int32_t Fs_kHz, const int32_t nb_subfr);
+    int32_t silk_inner_prod_aligned_scale(const int16_t *const inVec1, const int16_t *const inVec2, const int32_t scale, const int32_t len);
+    int32_t silk_lin2log(const int32_t inLin);
+    int32_t silk_log2lin(const int32_t inLog_Q7);
+    void silk_LPC_analysis_filter(int16_t *out, const int16_t *in, const int16_t *B, const int32_t len, const int32_t d);
+    void silk_LPC_fit(int16_t *a_QOUT, int32_t *a_QIN, const int32_t QOUT, const int32_t QIN, const int32_t d);
+    int32_t LPC_inverse_pred_gain_QA_c(int32_t A_QA[SILK_MAX_ORDER_LPC], const int32_t order);
+    int32_t silk_LPC_inverse_pred_gain_c(const int16_t *A_Q12, const int32_t order);
+    void silk_NLSF_residual_dequant(int16_t x_Q10[], const int8_t indices[], const uint8_t pred_coef_Q8[],
+                                           const int32_t quant_step_size_Q16, const int16_t order);
+    void silk_NLSF_stabilize(int16_t *NLSF_Q15, const int16_t *NDeltaMin_Q15, const int32_t L);
+    void silk_NLSF_VQ_weights_laroia(int16_t *pNLSFW_Q_OUT, const int16_t *pNLSF_Q15, const int32_t D);
+    void silk_PLC_update(uint8_t n);
+    void silk_PLC_energy(int32_t *energy1, int32_t *shift1, int32_t *energy2, int32_t *shift2,
+                                const int32_t *exc_Q14, const int32_t *prevGain_Q10, int subfr_length, int nb_subfr);
+    void silk_PLC_conceal(uint8_t n, int16_t frame[]);
+    void silk_resampler_down2_3(int32_t *S, int16_t *out, const int16_t *in, int32_t inLen);
+    void silk_resampler_down2(int32_t *S, int16_t *out, const int16_t *in, int32_t inLen);
+    void silk_resampler_private_AR2(int32_t S[], int32_t out_Q8[], const int16_t in[], const int16_t A_Q14[], int32_t len);
+    int16_t *silk_resampler_private_down_FIR_INTERPOL(int16_t *out, int32_t *buf, const int16_t *FIR_Coefs,
+                                                             int32_t FIR_Order, int32_t FIR_Fracs, int32_t max_index_Q16,
+                                                             int32_t index_increment_Q16);
+    void silk_resampler_private_down_FIR(void *SS, int16_t out[], const int16_t in[], int32_t inLen);
+    int16_t *silk_resampler_private_IIR_FIR_INTERPOL(int16_t *out, int16_t *buf, int32_t max_index_Q16,
+                                                            int32_t index_increment_Q16);
+    void silk_resampler_private_IIR_FIR(void *SS, int16_t out[], const int16_t in[], int32_t inLen);
+    void silk_resampler_private_up2_HQ(int32_t *S, int16_t *out, const int16_t *in, int32_t len);
+    void silk_resampler_private_up2_HQ_wrapper(void *SS, int16_t *out, const int16_t *in, int32_t len);
+    int32_t silk_resampler_init(uint8_t n, int32_t Fs_Hz_in, int32_t Fs_Hz_out, int32_t forEnc);
+    int32_t silk_resampler(uint8_t n, int16_t out[], const int16_t in[], int32_t inLen);
+    int32_t silk_sigm_Q15(int32_t in_Q5);
+    void silk_insertion_sort_increasing(int32_t *a, int32_t *idx, const int32_t L, const int32_t K);
+    void silk_insertion_sort_decreasing_int16(int16_t *a, int32_t *idx, const int32_t L, const int32_t K);
+    void silk_insertion_sort_increasing_all_values_int16(int16_t *a, const int32_t L);
+    void silk_sum_sqr_shift(int32_t *energy, int32_t *shift, const int16_t *x, int32_t len);
+    void decode_split(int16_t *p_child1, int16_t *p_child2, const int32_t p, const uint8_t *shell_table);
+
+    // Temporary array of count elements T, taken from m_silkScratch and given back when it goes out of scope
+    template <typename T>
+    ps_scratch::array<T> silk_scratch_arr(std::size_t count) {
+        return m_silkScratch.get<T>(count);
+    }
 
+    silk_ptr_arr<silk_resampler_state_struct_t> m_resampler_state;
+    silk_ptr_arr<silk_decoder_state_t>          m_channel_state;
+    silk_ptr_obj<silk_decoder_t>                m_silk_decoder;
+    silk_ptr_obj<silk_decoder_control_t>        m_silk_decoder_control;
+    silk_ptr_obj<silk_DecControlStruct_t>       m_silk_DecControlStruct;
+    ps_scratch                                  m_silkScratch; // temporary arrays of silk_Decode()
+
+    uint8_t            m_channelsInternal = 0;
+    uint8_t            m_payloadSize_ms = 0;
+    uint8_t            m_API_channels = 0;
+    uint32_t           m_silk_internalSampleRate = 0;
+    uint32_t           m_API_sampleRate = 0;
+    uint32_t           m_prevPitchLag = 0;
+
+    CeltDecoder&       m_celt;  // owns the range decoder
+};
 
@@ -2278,4 +2278,107 @@ private:
     }
 };
 
+// —————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
+//
+// 📌📌📌   S C R A T C H   📌📌📌
+//
+// Scratch memory for the temporary arrays of a decoder. One block is allocated once (in PSRAM if available) and
+// handed out like a stack, so decoding a frame needs no heap operation. An array goes back to the scratch when it
+// goes out of scope, the arrays must therefore be released in the reverse order of their allocation, as local
+// variables are.
+//
+// ps_scratch s_scratch;
+// s_scratch.alloc(8192, "s_scratch");         // once, e.g. in XXX_AllocateBuffers()
+//
+// void decode_frame(size_t N) {
+//     s_scratch.rewind();                     // optional, at the entry of a frame
+//     auto tmp = s_scratch.get<int32_t>(N);   // N elements, 8 byte aligned
+//     tmp[0] = 1;
+// }                                           // tmp is released here
+//
+// s_scratch.reset();                          // in XXX_FreeBuffers()
+//
+// If the block is too small the array is taken from the heap (log_w) and high_water() returns the size needed.
+//
+
+class ps_scratch {
+public:
+    template <typename T>
+    class array {
+    public:
+        array() = default;
+        array(array&& other) noexcept : m_owner(other.m_owner), m_ptr(other.m_ptr), m_mark(other.m_mark), m_heap(other.m_heap) {
+            other.m_ptr = nullptr;
+        }
+        array(const array&) = delete;
+        array& operator=(const array&) = delete;
+        array& operator=(array&&) = delete;
+        ~array() { release(); }
+
+        T* get() const { return m_ptr; }
+        T& operator[](size_t i) const { return m_ptr[i]; }
+        explicit operator bool() const { return m_ptr != nullptr; }
+
+    private:
+        friend class ps_scratch;
+        array(ps_scratch* owner, T* ptr, size_t mark, bool heap) : m_owner(owner), m_ptr(ptr), m_mark(mark), m_heap(heap) {}
+        void release() {
+            if (!m_ptr) return;
+            if (m_heap) free(m_ptr);
+            else m_owner->m_top = m_mark;
+            m_ptr = nullptr;
+        }
+        ps_scratch* m_owner = nullptr;
+        T*          m_ptr = nullptr;
+        size_t      m_mark = 0;  // top of the scratch before this array
+        bool        m_heap = false;
+    };
+
+    ps_scratch() = default;
+    ps_scratch(const ps_scratch&) = delete;
+    ps_scratch& operator=(const ps_scratch&) = delete;
+
+    void alloc(size_t size, const char* name = nullptr) {
+        m_mem.alloc(size, name);
+        m_size = m_mem.valid() ? size : 0;
+        m_top = 0;
+        m_high_water = 0;
+    }
+
+    void reset() {
+        m_mem.reset();
+        m_size = 0;
+        m_top = 0;
+    }
+
+    // forgets all arrays, only where none of them is in use anymore
+    void rewind() { m_top = 0; }
+
+    template <typename T>
+    array<T> get(size_t count) {
+        size_t start = (m_top + 7) & ~(size_t)7;
+        size_t bytes = count * sizeof(T);
+        if (start + bytes > m_high_water) m_high_water = start + bytes;
+        if (start + bytes <= m_size) {
+            size_t mark = m_top;
+            m_top = start + bytes;
+            return array<T>(this, reinterpret_cast<T*>(m_mem.get() + start), mark, false);
+        }
+        if (m_size) log_w("ps_scratch: %u bytes needed, %u available", (unsigned)(start + bytes), (unsigned)m_size);
+        T* raw = static_cast<T*>(ps_malloc(bytes ? bytes : 1));
+        if (!raw) log_e("ps_scratch: OOM, no space for %u bytes", (unsigned)bytes);
+        return array<T>(this, raw, 0, true);
+    }
+
+    size_t size() const { return m_size; }
+    size_t in_use() const { return m_top; }
+    size_t high_water() const { return m_high_water; } // largest size needed since alloc()
+
+private:
+    ps_ptr<uint8_t> m_mem;
+    size_t          m_size = 0;
+    size_t          m_top = 0;
+    size_t          m_high_water = 0;
+};
+
 #endif
\ No newline at end of file
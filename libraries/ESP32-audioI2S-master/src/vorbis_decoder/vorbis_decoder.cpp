@@ -27,225 +27,163 @@
 #include "../psram_unique_ptr.hpp"
 using namespace std;
 
-// global vars
-bool      s_f_vorbisNewSteamTitle = false;  // streamTitle
-bool      s_f_vorbisNewMetadataBlockPicture = false;
-bool      s_f_oggFirstPage = false;
-bool      s_f_oggContinuedPage = false;
-bool      s_f_oggLastPage = false;
-bool      s_f_parseOggDone = true;
-bool      s_f_lastSegmentTable = false;
-bool      s_f_vorbisStr_found = false;
-uint16_t  s_identificatonHeaderLength = 0;
-uint16_t  s_vorbisCommentHeaderLength = 0;
-uint16_t  s_setupHeaderLength = 0;
-uint8_t   s_pageNr = 0;
-uint16_t  s_oggHeaderSize = 0;
-uint8_t   s_vorbisChannels = 0;
-uint16_t  s_vorbisSamplerate = 0;
-uint16_t  s_lastSegmentTableLen = 0;
-
-uint32_t  s_vorbisBitRate = 0;
-uint32_t  s_vorbisSegmentLength = 0;
-uint32_t  s_vorbisBlockPicLenUntilFrameEnd = 0;
-uint32_t  s_vorbisCurrentFilePos = 0;
-uint32_t  s_vorbisAudioDataStart = 0;
-
-int32_t   s_vorbisValidSamples = 0;
-int32_t   s_commentBlockSegmentSize = 0;
-uint8_t   s_vorbisOldMode = 0;
-uint32_t  s_blocksizes[2];
-uint32_t  s_vorbisBlockPicPos = 0;
-uint32_t  s_vorbisBlockPicLen = 0;
-int32_t   s_vorbisRemainBlockPicLen = 0;
-int32_t   s_commentLength = 0;
-
-uint8_t   s_nrOfCodebooks = 0;
-uint8_t   s_nrOfFloors = 0;
-uint8_t   s_nrOfResidues = 0;
-uint8_t   s_nrOfMaps = 0;
-uint8_t   s_nrOfModes = 0;
-
-
-uint16_t  s_oggPage3Len = 0; // length of the current audio segment
-uint8_t   s_vorbisSegmentTableSize = 0;
-int16_t   s_vorbisSegmentTableRdPtr = -1;
-int8_t    s_vorbisError = 0;
-float     s_vorbisCompressionRatio = 0;
-
-bitReader_t            s_bitReader;
-
-ps_ptr<char>                  s_vorbisChbuf;
-ps_ptr<uint8_t>               s_lastSegmentTable;
-ps_ptr<uint16_t>              s_vorbisSegmentTable;
-ps_ptr<codebook_t>            s_codebooks;
-ps_ptr<ps_ptr<vorbis_info_floor_t>> s_floor_param;
-ps_ptr<int8_t>                s_floor_type;
-ps_ptr<vorbis_info_residue_t> s_residue_param;
-ps_ptr<vorbis_info_mapping_t> s_map_param;
-ps_ptr<vorbis_info_mode_t>    s_mode_param;
-ps_ptr<vorbis_dsp_state_t>    s_dsp_state;
-
-vector<uint32_t>s_vorbisBlockPicItem;
-
-
-bool VORBISDecoder_AllocateBuffers(){
-    s_vorbisSegmentTable.alloc(256 * sizeof(uint16_t)); s_vorbisSegmentTable.clear();
-    s_lastSegmentTable.alloc(4096);
+bool VORBISDecoder::allocateBuffers(){
+    m_vorbisSegmentTable.alloc(256 * sizeof(uint16_t)); m_vorbisSegmentTable.clear();
+    m_lastSegmentTable.alloc(4096);
     VORBISsetDefaults();
     return true;
 }
-void VORBISDecoder_FreeBuffers(){
+void VORBISDecoder::freeBuffers(){
     clearGlobalConfigurations();
-    if(s_vorbisChbuf.valid())       s_vorbisChbuf.reset();
-    if(s_lastSegmentTable.valid())  s_lastSegmentTable.reset();
-    if(s_vorbisSegmentTable.valid())s_vorbisSegmentTable.reset();
-    if(s_codebooks.valid())         s_codebooks.reset();
-    if(s_floor_param.valid())       s_floor_param.reset();
-    if(s_floor_type.valid())        s_floor_type.reset();
-    if(s_residue_param.valid())     s_residue_param.reset();
-    if(s_map_param.valid())         s_map_param.reset();
-    if(s_mode_param.valid())        s_mode_param.reset();
-    if(s_dsp_state.valid())         s_dsp_state.reset();
-}
-void VORBISDecoder_ClearBuffers(){
+    if(m_vorbisChbuf.valid())       m_vorbisChbuf.reset();
+    if(m_lastSegmentTable.valid())  m_lastSegmentTable.reset();
+    if(m_vorbisSegmentTable.valid())m_vorbisSegmentTable.reset();
+    if(m_codebooks.valid())         m_codebooks.reset();
+    if(m_floor_param.valid())       m_floor_param.reset();
+    if(m_floor_type.valid())        m_floor_type.reset();
+    if(m_residue_param.valid())     m_residue_param.reset();
+    if(m_map_param.valid())         m_map_param.reset();
+    if(m_mode_param.valid())        m_mode_param.reset();
+    if(m_dsp_state.valid())         m_dsp_state.reset();
+}
+void VORBISDecoder::clearBuffers(){
     bitReader_clear();
-    s_lastSegmentTable.clear();
-    s_vorbisSegmentTable.clear();
-    s_vorbisSegmentTableSize = 0;
-    s_vorbisSegmentTableRdPtr = -1;}
-
-void VORBISsetDefaults(){
-    s_pageNr = 0;
-    s_f_vorbisNewSteamTitle = false;  // streamTitle
-    s_f_vorbisNewMetadataBlockPicture = false;
-    s_f_lastSegmentTable = false;
-    s_f_parseOggDone = false;
-    s_f_oggFirstPage = false;
-    s_f_oggContinuedPage = false;
-    s_f_oggLastPage = false;
-    s_f_vorbisStr_found = false;
-    if(s_dsp_state.valid()){vorbis_dsp_destroy(s_dsp_state);}
-    s_vorbisChannels = 0;
-    s_vorbisSamplerate = 0;
-    s_vorbisBitRate = 0;
-    s_vorbisSegmentLength = 0;
-    s_vorbisValidSamples = 0;
-    s_vorbisSegmentTableSize = 0;
-    s_vorbisCurrentFilePos = 0;
-    s_vorbisAudioDataStart = 0;
-    s_vorbisOldMode = 0xFF;
-    s_vorbisSegmentTableRdPtr = -1;
-    s_vorbisError = 0;
-    s_lastSegmentTableLen = 0;
-    s_vorbisBlockPicPos = 0;
-    s_vorbisBlockPicLen = 0;
-    s_vorbisBlockPicLenUntilFrameEnd = 0;
-    s_commentBlockSegmentSize = 0;
-    s_vorbisBlockPicItem.clear();
-    s_vorbisBlockPicItem.shrink_to_fit();
-
-    VORBISDecoder_ClearBuffers();
-}
-
-void clearGlobalConfigurations() { // mode, mapping, floor etc
-    vorbis_book_clear(s_codebooks);
-    vorbis_dsp_destroy(s_dsp_state);
-
-    if(s_nrOfFloors) {
-        for(int32_t i = 0; i < s_nrOfFloors; i++){
-            s_floor_param[i]->_class.reset();
-            s_floor_param[i]->partitionclass.reset();
-            s_floor_param[i]->postlist.reset();
-            s_floor_param[i]->forward_index.reset();
-            s_floor_param[i]->hineighbor.reset();
-            s_floor_param[i]->loneighbor.reset();
-            s_floor_param[i].reset();
-        }
-        s_floor_param.reset();
-        s_nrOfFloors = 0;
-    }
-
-    if(s_nrOfResidues) {
-        for(int32_t i = 0; i < s_nrOfResidues; i++){
-            s_residue_param[i].stagemasks.reset();
-            s_residue_param[i].stagebooks.reset();
-        }
-        s_residue_param.reset();
-        s_nrOfResidues = 0;
-    }
-
-    if(s_nrOfMaps) {
-        for(int32_t i = 0; i < s_nrOfMaps; i++){
-            s_map_param[i].chmuxlist.reset();
-            s_map_param[i].submaplist.reset();
-            s_map_param[i].coupling.reset();
-        }
-        s_map_param.reset();
-        s_nrOfMaps = 0;
-    }
-
-    if(s_floor_type.valid()) s_floor_type.reset();
-    if(s_residue_param.valid()) s_residue_param.reset();
-    if(s_map_param.valid()) s_map_param.reset();
-    if(s_mode_param.valid()) s_mode_param.reset();
+    m_lastSegmentTable.clear();
+    m_vorbisSegmentTable.clear();
+    m_vorbisSegmentTableSize = 0;
+    m_vorbisSegmentTableRdPtr = -1;}
+
+void VORBISDecoder::VORBISsetDefaults(){
+    m_pageNr = 0;
+    m_f_vorbisNewSteamTitle = false;  // streamTitle
+    m_f_vorbisNewMetadataBlockPicture = false;
+    m_f_lastSegmentTable = false;
+    m_f_parseOggDone = false;
+    m_f_oggFirstPage = false;
+    m_f_oggContinuedPage = false;
+    m_f_oggLastPage = false;
+    m_f_vorbisStr_found = false;
+    if(m_dsp_state.valid()){vorbis_dsp_destroy(m_dsp_state);}
+    m_vorbisChannels = 0;
+    m_vorbisSamplerate = 0;
+    m_vorbisBitRate = 0;
+    m_vorbisSegmentLength = 0;
+    m_vorbisValidSamples = 0;
+    m_vorbisSegmentTableSize = 0;
+    m_vorbisCurrentFilePos = 0;
+    m_vorbisAudioDataStart = 0;
+    m_vorbisOldMode = 0xFF;
+    m_vorbisSegmentTableRdPtr = -1;
+    m_vorbisError = 0;
+    m_lastSegmentTableLen = 0;
+    m_vorbisBlockPicPos = 0;
+    m_vorbisBlockPicLen = 0;
+    m_vorbisBlockPicLenUntilFrameEnd = 0;
+    m_commentBlockSegmentSize = 0;
+    m_vorbisBlockPicItem.clear();
+    m_vorbisBlockPicItem.shrink_to_fit();
+
+    clearBuffers();
+}
+
+void VORBISDecoder::clearGlobalConfigurations() { // mode, mapping, floor etc
+    vorbis_book_clear(m_codebooks);
+    vorbis_dsp_destroy(m_dsp_state);
+
+    if(m_nrOfFloors) {
+        for(int32_t i = 0; i < m_nrOfFloors; i++){
+            m_floor_param[i]->_class.reset();
+            m_floor_param[i]->partitionclass.reset();
+            m_floor_param[i]->postlist.reset();
+            m_floor_param[i]->forward_index.reset();
+            m_floor_param[i]->hineighbor.reset();
+            m_floor_param[i]->loneighbor.reset();
+            m_floor_param[i].reset();
+        }
+        m_floor_param.reset();
+        m_nrOfFloors = 0;
+    }
+
+    if(m_nrOfResidues) {
+        for(int32_t i = 0; i < m_nrOfResidues; i++){
+            m_residue_param[i].stagemasks.reset();
+            m_residue_param[i].stagebooks.reset();
+        }
+        m_residue_param.reset();
+        m_nrOfResidues = 0;
+    }
+
+    if(m_nrOfMaps) {
+        for(int32_t i = 0; i < m_nrOfMaps; i++){
+            m_map_param[i].chmuxlist.reset();
+            m_map_param[i].submaplist.reset();
+            m_map_param[i].coupling.reset();
+        }
+        m_map_param.reset();
+        m_nrOfMaps = 0;
+    }
+
+    if(m_floor_type.valid()) m_floor_type.reset();
+    if(m_residue_param.valid()) m_residue_param.reset();
+    if(m_map_param.valid()) m_map_param.reset();
+    if(m_mode_param.valid()) m_mode_param.reset();
 }
 //----------------------------------------------------------------------------------------------------------------------
 
-int32_t VORBISDecode(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf) {
+int32_t VORBISDecoder::decode(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf) {
 
     int32_t ret = 0;
     int32_t segmentLength = 0;
 
-    if(s_commentBlockSegmentSize) {
-        if(s_commentBlockSegmentSize > 8192) {
-            s_commentBlockSegmentSize -= 8192;
-            s_commentLength -= 8192;
+    if(m_commentBlockSegmentSize) {
+        if(m_commentBlockSegmentSize > 8192) {
+            m_commentBlockSegmentSize -= 8192;
+            m_commentLength -= 8192;
             *bytesLeft -= 8192;
-            s_vorbisCurrentFilePos += 8192;
+            m_vorbisCurrentFilePos += 8192;
         }
         else {
-            *bytesLeft -= s_commentBlockSegmentSize;
-            s_vorbisCurrentFilePos += s_commentBlockSegmentSize;
-            s_commentLength -= s_commentBlockSegmentSize;
-            s_commentBlockSegmentSize = 0;
+            *bytesLeft -= m_commentBlockSegmentSize;
+            m_vorbisCurrentFilePos += m_commentBlockSegmentSize;
+            m_commentLength -= m_commentBlockSegmentSize;
+            m_commentBlockSegmentSize = 0;
         }
-        if(s_vorbisRemainBlockPicLen <= 0 && !s_f_vorbisNewMetadataBlockPicture) {
-            if(s_vorbisBlockPicItem.size() > 0) { // get blockpic data
+        if(m_vorbisRemainBlockPicLen <= 0 && !m_f_vorbisNewMetadataBlockPicture) {
+            if(m_vorbisBlockPicItem.size() > 0) { // get blockpic data
                 // VORBIS_LOG_INFO("---------------------------------------------------------------------------");
-                // VORBIS_LOG_INFO("metadata blockpic found at pos %i, size %i bytes", s_vorbisBlockPicPos, s_vorbisBlockPicLen);
-                // for(int32_t i = 0; i < s_vorbisBlockPicItem.size(); i += 2) { VORBIS_LOG_INFO("segment %02i, pos %07i, len %05i", i / 2, s_vorbisBlockPicItem[i], s_vorbisBlockPicItem[i + 1]); }
+                // VORBIS_LOG_INFO("metadata blockpic found at pos %i, size %i bytes", m_vorbisBlockPicPos, m_vorbisBlockPicLen);
+                // for(int32_t i = 0; i < m_vorbisBlockPicItem.size(); i += 2) { VORBIS_LOG_INFO("segment %02i, pos %07i, len %05i", i / 2, m_vorbisBlockPicItem[i], m_vorbisBlockPicItem[i + 1]); }
                 // VORBIS_LOG_INFO("---------------------------------------------------------------------------");
-                s_f_vorbisNewMetadataBlockPicture = true;
+                m_f_vorbisNewMetadataBlockPicture = true;
             }
         }
         return VORBIS_PARSE_OGG_DONE;
     }
 
-    if(!s_vorbisSegmentTableSize) {
-        s_vorbisSegmentTableRdPtr = -1; // back to the parking position
+    if(!m_vorbisSegmentTableSize) {
+        m_vorbisSegmentTableRdPtr = -1; // back to the parking position
         ret = VORBISparseOGG(inbuf, bytesLeft);
-        s_f_parseOggDone = true;
-        if(!s_vorbisSegmentTableSize) {/* VORBIS_LOG_WARN("OggS without segments?") */; }
+        m_f_parseOggDone = true;
+        if(!m_vorbisSegmentTableSize) {/* VORBIS_LOG_WARN("OggS without segments?") */; }
         return ret;
     }
 
     // With the last segment of a table, we don't know whether it will be continued in the next Ogg page.
-    // So the last segment is saved. s_lastSegmentTableLen specifies the size of the last saved segment.
+    // So the last segment is saved. m_lastSegmentTableLen specifies the size of the last saved segment.
     // If the next Ogg Page does not contain a 'continuedPage', the last segment is played first. However,
     // if 'continuedPage' is set, the first segment of the new page is added to the saved segment and played.
-    if(!s_lastSegmentTableLen){
-        if(s_vorbisSegmentTableSize) {
-            s_vorbisSegmentTableRdPtr++;
-            s_vorbisSegmentTableSize--;
-            segmentLength = s_vorbisSegmentTable[s_vorbisSegmentTableRdPtr];
+    if(!m_lastSegmentTableLen){
+        if(m_vorbisSegmentTableSize) {
+            m_vorbisSegmentTableRdPtr++;
+            m_vorbisSegmentTableSize--;
+            segmentLength = m_vorbisSegmentTable[m_vorbisSegmentTableRdPtr];
         }
     }
 
-    if(s_pageNr < 4)
-        if(VORBIS_specialIndexOf(inbuf, "vorbis", 10) == 1) s_pageNr++;
+    if(m_pageNr < 4)
+        if(VORBIS_specialIndexOf(inbuf, "vorbis", 10) == 1) m_pageNr++;
 
-    switch(s_pageNr) {
+    switch(m_pageNr) {
         case 0:
             ret = VORBIS_PARSE_OGG_DONE; // do nothing
             break;
@@ -261,18 +199,18 @@ int32_t VORBISDecode(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf) {
         case 4:
             ret = vorbisDecodePage4(inbuf, bytesLeft, segmentLength, outbuf); // decode audio
             break;
-        default: VORBIS_LOG_ERROR("unknown page %s", s_pageNr); ret = VORBIS_ERR; break;
+        default: VORBIS_LOG_ERROR("unknown page %s", m_pageNr); ret = VORBIS_ERR; break;
     }
     return ret;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t vorbisDecodePage1(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength){
+int32_t VORBISDecoder::vorbisDecodePage1(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength){
     int32_t ret = VORBIS_PARSE_OGG_DONE;
     clearGlobalConfigurations(); // if a new codebook is required, delete the old one
     int32_t idx = VORBIS_specialIndexOf(inbuf, "vorbis", 10);
     if(idx == 1) {
         // VORBIS_LOG_INFO("first packet (identification segmentLength) %i", segmentLength);
-        s_identificatonHeaderLength = segmentLength;
+        m_identificatonHeaderLength = segmentLength;
         ret = parseVorbisFirstPacket(inbuf, segmentLength);
     }
     else {
@@ -281,191 +219,191 @@ int32_t vorbisDecodePage1(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLe
     }
 
     *bytesLeft -= segmentLength;
-    s_vorbisCurrentFilePos += segmentLength;
+    m_vorbisCurrentFilePos += segmentLength;
     return ret;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t vorbisDecodePage2(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength){
+int32_t VORBISDecoder::vorbisDecodePage2(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength){
     int32_t ret = VORBIS_PARSE_OGG_DONE;
     int32_t idx = VORBIS_specialIndexOf(inbuf, "vorbis", 10);
     if(idx == 1) {
-        s_vorbisBlockPicItem.clear();
-        s_vorbisBlockPicItem.shrink_to_fit();
-        s_f_vorbisStr_found = true;
-        s_vorbisCommentHeaderLength = segmentLength;
+        m_vorbisBlockPicItem.clear();
+        m_vorbisBlockPicItem.shrink_to_fit();
+        m_f_vorbisStr_found = true;
+        m_vorbisCommentHeaderLength = segmentLength;
         ret = parseVorbisComment(inbuf, segmentLength);
-        s_commentBlockSegmentSize = segmentLength;
-         int32_t pLen = _min((int32_t)s_vorbisBlockPicLen, s_vorbisBlockPicLenUntilFrameEnd);
-        if(s_vorbisBlockPicLen && pLen > 0){
-            s_vorbisBlockPicItem.push_back(s_vorbisBlockPicPos);
-            s_vorbisBlockPicItem.push_back(pLen);
+        m_commentBlockSegmentSize = segmentLength;
+         int32_t pLen = _min((int32_t)m_vorbisBlockPicLen, m_vorbisBlockPicLenUntilFrameEnd);
+        if(m_vorbisBlockPicLen && pLen > 0){
+            m_vorbisBlockPicItem.push_back(m_vorbisBlockPicPos);
+            m_vorbisBlockPicItem.push_back(pLen);
         }
-        s_vorbisRemainBlockPicLen = s_vorbisBlockPicLen - pLen;
+        m_vorbisRemainBlockPicLen = m_vorbisBlockPicLen - pLen;
         ret = VORBIS_PARSE_OGG_DONE;
     }
     else {
-        s_commentBlockSegmentSize = segmentLength;
-        uint32_t pLen = min(s_vorbisRemainBlockPicLen, (int32_t)segmentLength);
-        if(s_vorbisRemainBlockPicLen && pLen > 0){
-            s_vorbisBlockPicItem.push_back(s_vorbisCurrentFilePos);
-            s_vorbisBlockPicItem.push_back(pLen);
+        m_commentBlockSegmentSize = segmentLength;
+        uint32_t pLen = min(m_vorbisRemainBlockPicLen, (int32_t)segmentLength);
+        if(m_vorbisRemainBlockPicLen && pLen > 0){
+            m_vorbisBlockPicItem.push_back(m_vorbisCurrentFilePos);
+            m_vorbisBlockPicItem.push_back(pLen);
         }
-        s_vorbisRemainBlockPicLen -= segmentLength;
+        m_vorbisRemainBlockPicLen -= segmentLength;
         ret = VORBIS_PARSE_OGG_DONE;
     }
     return ret;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t vorbisDecodePage3(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength){
+int32_t VORBISDecoder::vorbisDecodePage3(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength){
     int32_t ret = VORBIS_PARSE_OGG_DONE;
     int32_t idx = VORBIS_specialIndexOf(inbuf, "vorbis", 10);
-    s_oggPage3Len = segmentLength;
+    m_oggPage3Len = segmentLength;
     if(idx == 1) {
         // VORBIS_LOG_INFO("third packet (setup segmentLength) %i", segmentLength);
-        s_setupHeaderLength = segmentLength;
+        m_setupHeaderLength = segmentLength;
         bitReader_setData(inbuf, segmentLength);
         if(segmentLength == 4080) {
             // that is 16*255 bytes and thus the maximum segment size
             // it is possible that there is another block starting with 'OggS' in which there is information
             // about codebooks. It is possible that there is another block starting with 'OggS' in which
             // there is information about codebooks.
-            int32_t l = continuedOggPackets(inbuf + s_oggPage3Len);
+            int32_t l = continuedOggPackets(inbuf + m_oggPage3Len);
             *bytesLeft -= l;
-            s_vorbisCurrentFilePos += l;
-            s_oggPage3Len += l;
-            s_setupHeaderLength += l;
-            bitReader_setData(inbuf, s_oggPage3Len);
-            // VORBIS_LOG_INFO("s_oggPage3Len %i", s_oggPage3Len);
-            s_pageNr++;
+            m_vorbisCurrentFilePos += l;
+            m_oggPage3Len += l;
+            m_setupHeaderLength += l;
+            bitReader_setData(inbuf, m_oggPage3Len);
+            // VORBIS_LOG_INFO("m_oggPage3Len %i", m_oggPage3Len);
+            m_pageNr++;
         }
         ret = parseVorbisCodebook();
     }
     else {VORBIS_LOG_ERROR("no \"vorbis\" something went wrong, segmentLenght: %i", segmentLength); ret = VORBIS_ERR; }
-    s_pageNr = 4;
-    s_dsp_state = vorbis_dsp_create();
+    m_pageNr = 4;
+    m_dsp_state = vorbis_dsp_create();
 
     *bytesLeft -= segmentLength;
-    s_vorbisCurrentFilePos += segmentLength;
+    m_vorbisCurrentFilePos += segmentLength;
     return ret;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-int32_t vorbisDecodePage4(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength, int16_t* outbuf){
+int32_t VORBISDecoder::vorbisDecodePage4(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength, int16_t* outbuf){
 
-    if(s_vorbisAudioDataStart == 0){
-        s_vorbisAudioDataStart = s_vorbisCurrentFilePos;
+    if(m_vorbisAudioDataStart == 0){
+        m_vorbisAudioDataStart = m_vorbisCurrentFilePos;
     }
 
     int32_t ret = 0;
-    if(s_f_parseOggDone) { // first loop after VORBISparseOGG()
-        if(s_f_oggContinuedPage) {
-            if(s_lastSegmentTableLen > 0 || segmentLength > 0) {
-                if(s_lastSegmentTableLen + segmentLength > 1024) {VORBIS_LOG_ERROR("continued page too big, %i", s_lastSegmentTableLen + segmentLength); return VORBIS_ERR;}
-                memcpy(s_lastSegmentTable.get() + s_lastSegmentTableLen, inbuf, segmentLength);
-                bitReader_setData(s_lastSegmentTable.get(), s_lastSegmentTableLen + segmentLength);
-                ret = vorbis_dsp_synthesis(s_lastSegmentTable.get(), s_lastSegmentTableLen + segmentLength, outbuf);
+    if(m_f_parseOggDone) { // first loop after VORBISparseOGG()
+        if(m_f_oggContinuedPage) {
+            if(m_lastSegmentTableLen > 0 || segmentLength > 0) {
+                if(m_lastSegmentTableLen + segmentLength > 1024) {VORBIS_LOG_ERROR("continued page too big, %i", m_lastSegmentTableLen + segmentLength); return VORBIS_ERR;}
+                memcpy(m_lastSegmentTable.get() + m_lastSegmentTableLen, inbuf, segmentLength);
+                bitReader_setData(m_lastSegmentTable.get(), m_lastSegmentTableLen + segmentLength);
+                ret = vorbis_dsp_synthesis(m_lastSegmentTable.get(), m_lastSegmentTableLen + segmentLength, outbuf);
                 uint16_t outBuffSize = 2048 * 2;
-                s_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
-                s_lastSegmentTableLen = 0;
+                m_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
+                m_lastSegmentTableLen = 0;
                 if(!ret && !segmentLength) ret = VORBIS_CONTINUE;
             }
-            else { // s_lastSegmentTableLen is 0 and segmentLength is 0
-                s_vorbisValidSamples = 0;
+            else { // m_lastSegmentTableLen is 0 and segmentLength is 0
+                m_vorbisValidSamples = 0;
                 ret = VORBIS_CONTINUE;
             }
-            s_f_oggContinuedPage = false;
+            m_f_oggContinuedPage = false;
         }
         else { // last segment without continued Page
-            if(s_lastSegmentTableLen) {
-                bitReader_setData(s_lastSegmentTable.get(), s_lastSegmentTableLen);
-                ret = vorbis_dsp_synthesis(s_lastSegmentTable.get(), s_lastSegmentTableLen, outbuf);
+            if(m_lastSegmentTableLen) {
+                bitReader_setData(m_lastSegmentTable.get(), m_lastSegmentTableLen);
+                ret = vorbis_dsp_synthesis(m_lastSegmentTable.get(), m_lastSegmentTableLen, outbuf);
                 uint16_t outBuffSize = 2048 * 2;
-                s_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
-                s_lastSegmentTableLen = 0;
+                m_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
+                m_lastSegmentTableLen = 0;
                 if(ret == OV_ENOTAUDIO || ret == 0) ret = VORBIS_CONTINUE; // if no error send continue
             }
             else {
                 bitReader_setData(inbuf, segmentLength);
                 ret = vorbis_dsp_synthesis(inbuf, segmentLength, outbuf);
                 uint16_t outBuffSize = 2048 * 2;
-                s_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
+                m_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
                 ret = 0;
             }
         }
     }
-    else { // not s_f_parseOggDone
-        if(s_vorbisSegmentTableSize || s_f_lastSegmentTable) {
-            // if(s_f_oggLastPage) VORBIS_LOG_INFO("last page");
+    else { // not m_f_parseOggDone
+        if(m_vorbisSegmentTableSize || m_f_lastSegmentTable) {
+            // if(m_f_oggLastPage) VORBIS_LOG_INFO("last page");
             bitReader_setData(inbuf, segmentLength);
             ret = vorbis_dsp_synthesis(inbuf, segmentLength, outbuf);
             uint16_t outBuffSize = 2048 * 2;
-            s_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
+            m_vorbisValidSamples = vorbis_dsp_pcmout(outbuf, outBuffSize);
             ret = 0;
         }
         else { // last segment
             if(segmentLength) {
-                memcpy(s_lastSegmentTable.get(), inbuf, segmentLength);
-                s_lastSegmentTableLen = segmentLength;
-                s_vorbisValidSamples = 0;
+                memcpy(m_lastSegmentTable.get(), inbuf, segmentLength);
+                m_lastSegmentTableLen = segmentLength;
+                m_vorbisValidSamples = 0;
                 ret = 0;
             }
             else {
-                s_lastSegmentTableLen = 0;
-                s_vorbisValidSamples = 0;
+                m_lastSegmentTableLen = 0;
+                m_vorbisValidSamples = 0;
                 ret = VORBIS_PARSE_OGG_DONE;
             }
         }
-        s_f_oggFirstPage = false;
+        m_f_oggFirstPage = false;
     }
-    s_f_parseOggDone = false;
-    if(s_f_oggLastPage && !s_vorbisSegmentTableSize) { VORBISsetDefaults(); }
+    m_f_parseOggDone = false;
+    if(m_f_oggLastPage && !m_vorbisSegmentTableSize) { VORBISsetDefaults(); }
 
     if(ret != VORBIS_CONTINUE){ // nothing to do here, is playing from lastSegmentBuff
         *bytesLeft -= segmentLength;
-        s_vorbisCurrentFilePos += segmentLength;
+        m_vorbisCurrentFilePos += segmentLength;
     }
     return ret;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
-uint8_t VORBISGetChannels(){
-    return s_vorbisChannels;
+uint8_t VORBISDecoder::getChannels(){
+    return m_vorbisChannels;
 }
-uint32_t VORBISGetSampRate(){
-    return s_vorbisSamplerate;
+uint32_t VORBISDecoder::getSampRate(){
+    return m_vorbisSamplerate;
 }
-uint8_t VORBISGetBitsPerSample(){
+uint8_t VORBISDecoder::getBitsPerSample(){
     return 16;
 }
-uint32_t VORBISGetBitRate(){
-    return s_vorbisBitRate;
+uint32_t VORBISDecoder::getBitRate(){
+    return m_vorbisBitRate;
 }
-uint32_t VORBISGetAudioDataStart(){
-    return s_vorbisAudioDataStart;
+uint32_t VORBISDecoder::getAudioDataStart(){
+    return m_vorbisAudioDataStart;
 }
-uint16_t VORBISGetOutputSamps(){
-    return s_vorbisValidSamples; // 1024
+uint16_t VORBISDecoder::getOutputSamps(){
+    return m_vorbisValidSamples; // 1024
 }
-char* VORBISgetStreamTitle(){
-    if(s_f_vorbisNewSteamTitle){
-        s_f_vorbisNewSteamTitle = false;
-        return s_vorbisChbuf.get();
+char* VORBISDecoder::getStreamTitle(){
+    if(m_f_vorbisNewSteamTitle){
+        m_f_vorbisNewSteamTitle = false;
+        return m_vorbisChbuf.get();
     }
     return NULL;
 }
-vector<uint32_t> VORBISgetMetadataBlockPicture(){
-    if(s_f_vorbisNewMetadataBlockPicture){
-        s_f_vorbisNewMetadataBlockPicture = false;
-        return s_vorbisBlockPicItem;
+vector<uint32_t> VORBISDecoder::getMetadataBlockPicture(){
+    if(m_f_vorbisNewMetadataBlockPicture){
+        m_f_vorbisNewMetadataBlockPicture = false;
+        return m_vorbisBlockPicItem;
     }
-    if(s_vorbisBlockPicItem.size() > 0){
-        s_vorbisBlockPicItem.clear();
-        s_vorbisBlockPicItem.shrink_to_fit();
+    if(m_vorbisBlockPicItem.size() > 0){
+        m_vorbisBlockPicItem.clear();
+        m_vorbisBlockPicItem.shrink_to_fit();
     }
-    return s_vorbisBlockPicItem;
+    return m_vorbisBlockPicItem;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t parseVorbisFirstPacket(uint8_t *inbuf, int16_t nBytes){ // 4.2.2. Identification header
+int32_t VORBISDecoder::parseVorbisFirstPacket(uint8_t *inbuf, int16_t nBytes){ // 4.2.2. Identification header
                                                             // https://xiph.org/vorbis/doc/Vorbis_I_spec.html#x1-820005
     // first bytes are: '.vorbis'
     uint16_t pos = 7;
@@ -498,19 +436,19 @@ int32_t parseVorbisFirstPacket(uint8_t *inbuf, int16_t nBytes){ // 4.2.2. Identi
 
     uint8_t  blocksize   = *(inbuf + pos + 21);
 
-    s_blocksizes[0] = 1 << ( blocksize & 0x0F);
-    s_blocksizes[1] = 1 << ((blocksize & 0xF0) >> 4);
+    m_blocksizes[0] = 1 << ( blocksize & 0x0F);
+    m_blocksizes[1] = 1 << ((blocksize & 0xF0) >> 4);
 
-    if(s_blocksizes[0] < 64){
-        VORBIS_LOG_ERROR("Vorbis, blocksize[0] too low %i", s_blocksizes[0]);
+    if(m_blocksizes[0] < 64){
+        VORBIS_LOG_ERROR("Vorbis, blocksize[0] too low %i", m_blocksizes[0]);
         return -1;
     }
-    if(s_blocksizes[1] < s_blocksizes[0]){
-        VORBIS_LOG_ERROR("Vorbis, s_blocksizes[1] %i is smaller than s_blocksizes[0] %i", s_blocksizes[1], s_blocksizes[0]);
+    if(m_blocksizes[1] < m_blocksizes[0]){
+        VORBIS_LOG_ERROR("Vorbis, m_blocksizes[1] %i is smaller than m_blocksizes[0] %i", m_blocksizes[1], m_blocksizes[0]);
         return -1;
     }
-    if(s_blocksizes[1] > 8192){
-        VORBIS_LOG_ERROR("Vorbis, s_blocksizes[1] is too big: %i", s_blocksizes[1]);
+    if(m_blocksizes[1] > 8192){
+        VORBIS_LOG_ERROR("Vorbis, m_blocksizes[1] is too big: %i", m_blocksizes[1]);
         return -1;
     }
 
@@ -518,21 +456,21 @@ int32_t parseVorbisFirstPacket(uint8_t *inbuf, int16_t nBytes){ // 4.2.2. Identi
         VORBIS_LOG_ERROR("Vorbis, nr of channels is not valid ch=%i", channels);
         return -1;
     }
-    s_vorbisChannels = channels;
+    m_vorbisChannels = channels;
 
     if(sampleRate < 4096 || sampleRate > 64000){
         VORBIS_LOG_ERROR("Vorbis, sampleRate is not valid sr=%i", sampleRate);
         return -1;
     }
-    s_vorbisSamplerate = sampleRate;
+    m_vorbisSamplerate = sampleRate;
 
-    s_vorbisBitRate = br_nominal;
+    m_vorbisBitRate = br_nominal;
 
     return VORBIS_PARSE_OGG_DONE;
 
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t parseVorbisComment(uint8_t *inbuf, int16_t nBytes){      // reference https://xiph.org/vorbis/doc/v-comment.html
+int32_t VORBISDecoder::parseVorbisComment(uint8_t *inbuf, int16_t nBytes){      // reference https://xiph.org/vorbis/doc/v-comment.html
 
     // first bytes are: '.vorbis'
     uint32_t pos = 7;
@@ -545,18 +483,18 @@ int32_t parseVorbisComment(uint8_t *inbuf, int16_t nBytes){      // reference ht
        VORBIS_LOG_WARN("vorbis comment too long, vendorLength %i", vendorLength);
        return 0;
     }
-    s_vorbisChbuf.reset();
-    s_vorbisChbuf.assign((char*)(inbuf + 11), vendorLength);
+    m_vorbisChbuf.reset();
+    m_vorbisChbuf.assign((char*)(inbuf + 11), vendorLength);
     pos += 4 + vendorLength;
-    s_vorbisCommentHeaderLength -= (7 + 4 + vendorLength);
+    m_vorbisCommentHeaderLength -= (7 + 4 + vendorLength);
 
     // VORBIS_LOG_INFO("vendorLength %x", vendorLength);
-    // VORBIS_LOG_INFO("vendorString %s", s_vorbisChbuf);
+    // VORBIS_LOG_INFO("vendorString %s", m_vorbisChbuf);
 
     uint8_t nrOfComments = *(inbuf + pos);
     // VORBIS_LOG_INFO("nrOfComments %i", nrOfComments);
     pos += 4;
-    s_vorbisCommentHeaderLength -= 4;
+    m_vorbisCommentHeaderLength -= 4;
 
     ps_ptr<char>artist;
     ps_ptr<char>title;
@@ -567,61 +505,61 @@ int32_t parseVorbisComment(uint8_t *inbuf, int16_t nBytes){      // reference ht
         commentLength += *(inbuf + pos + 2) << 16;
         commentLength += *(inbuf + pos + 1) << 8;
         commentLength += *(inbuf + pos);
-        s_commentLength = commentLength;
+        m_commentLength = commentLength;
 
         uint8_t cl = min((uint32_t)254, commentLength);
-        s_vorbisChbuf.assign((char*)(inbuf + pos +  4), cl);
+        m_vorbisChbuf.assign((char*)(inbuf + pos +  4), cl);
 
-        // VORBIS_LOG_INFO("commentLength %i comment %s", commentLength, s_vorbisChbuf);
+        // VORBIS_LOG_INFO("commentLength %i comment %s", commentLength, m_vorbisChbuf);
 
-        if(s_vorbisChbuf.starts_with_icase("artist=")){
-            artist.assign(s_vorbisChbuf.get() + 7, commentLength - 7);
-            s_commentLength = 0;
+        if(m_vorbisChbuf.starts_with_icase("artist=")){
+            artist.assign(m_vorbisChbuf.get() + 7, commentLength - 7);
+            m_commentLength = 0;
         }
 
-        if(s_vorbisChbuf.starts_with_icase("title=")){
-            title.assign(s_vorbisChbuf.get() + 6, commentLength - 6);
-            s_commentLength = 0;
+        if(m_vorbisChbuf.starts_with_icase("title=")){
+            title.assign(m_vorbisChbuf.get() + 6, commentLength - 6);
+            m_commentLength = 0;
         }
 
-        if(s_vorbisChbuf.starts_with_icase("metadata_block_picture=")){
-            s_vorbisBlockPicLen = commentLength - 23;
-            s_vorbisBlockPicPos += s_vorbisCurrentFilePos + 4 +pos + 23;
-            s_vorbisBlockPicLenUntilFrameEnd = s_vorbisCommentHeaderLength - 4 - 23;
+        if(m_vorbisChbuf.starts_with_icase("metadata_block_picture=")){
+            m_vorbisBlockPicLen = commentLength - 23;
+            m_vorbisBlockPicPos += m_vorbisCurrentFilePos + 4 +pos + 23;
+            m_vorbisBlockPicLenUntilFrameEnd = m_vorbisCommentHeaderLength - 4 - 23;
         }
         pos += commentLength + 4;
-        s_vorbisCommentHeaderLength -= (4 + commentLength);
+        m_vorbisCommentHeaderLength -= (4 + commentLength);
     }
     if(artist.valid() && title.valid()){
-        s_vorbisChbuf.assign(artist.get());
-        s_vorbisChbuf.append(" - ");
-        s_vorbisChbuf.append(title.get());
-        s_f_vorbisNewSteamTitle = true;
+        m_vorbisChbuf.assign(artist.get());
+        m_vorbisChbuf.append(" - ");
+        m_vorbisChbuf.append(title.get());
+        m_f_vorbisNewSteamTitle = true;
     }
     else if(artist.valid()){
-        s_vorbisChbuf.assign(artist.get());
-        s_f_vorbisNewSteamTitle = true;
+        m_vorbisChbuf.assign(artist.get());
+        m_f_vorbisNewSteamTitle = true;
     }
     else if(title.valid()){
-        s_vorbisChbuf.assign(title.get());
-        s_f_vorbisNewSteamTitle = true;
+        m_vorbisChbuf.assign(title.get());
+        m_f_vorbisNewSteamTitle = true;
     }
     return VORBIS_PARSE_OGG_DONE;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t parseVorbisCodebook(){
+int32_t VORBISDecoder::parseVorbisCodebook(){
 
-    s_bitReader.headptr += 7;
-    s_bitReader.length = s_oggPage3Len;
+    m_bitReader.headptr += 7;
+    m_bitReader.length = m_oggPage3Len;
 
     int32_t i;
     int32_t ret = 0;
 
-    s_nrOfCodebooks = bitReader(8) +1;
-    s_codebooks.alloc(s_nrOfCodebooks * sizeof(codebook_t));
+    m_nrOfCodebooks = bitReader(8) +1;
+    m_codebooks.alloc(m_nrOfCodebooks * sizeof(codebook_t));
 
-    for(i = 0; i < s_nrOfCodebooks; i++){
-        ret = vorbis_book_unpack(s_codebooks.get() + i);
+    for(i = 0; i < m_nrOfCodebooks; i++){
+        ret = vorbis_book_unpack(m_codebooks.get() + i);
         if(ret) VORBIS_LOG_ERROR("Vorbis codebook %i returned  a err", i);
         if(ret) goto err_out;
     }
@@ -636,57 +574,57 @@ int32_t parseVorbisCodebook(){
         }
     }
     /* floor backend settings */
-    s_nrOfFloors  = bitReader(6) + 1;
-    s_floor_param.alloc_array(s_nrOfFloors);
-    s_floor_type.alloc(sizeof(int8_t) * s_nrOfFloors);
-    for(i = 0; i < s_nrOfFloors; i++) {
-        s_floor_type[i] = bitReader(16);
-        if(s_floor_type[i] < 0 || s_floor_type[i] >= VI_FLOORB) {
+    m_nrOfFloors  = bitReader(6) + 1;
+    m_floor_param.alloc_array(m_nrOfFloors);
+    m_floor_type.alloc(sizeof(int8_t) * m_nrOfFloors);
+    for(i = 0; i < m_nrOfFloors; i++) {
+        m_floor_type[i] = bitReader(16);
+        if(m_floor_type[i] < 0 || m_floor_type[i] >= VI_FLOORB) {
             VORBIS_LOG_ERROR("err while reading floors");
             goto err_out;
         }
-        if(s_floor_type[i]){
-            s_floor_param[i] = floor1_info_unpack();
+        if(m_floor_type[i]){
+            m_floor_param[i] = floor1_info_unpack();
         }
         else{
-            s_floor_param[i] = floor0_info_unpack();
+            m_floor_param[i] = floor0_info_unpack();
         }
-        if(!s_floor_param[i].valid()){
+        if(!m_floor_param[i].valid()){
             VORBIS_LOG_ERROR("floor parameter not found");
             goto err_out;
         }
     }
 
     /* residue backend settings */
-    s_nrOfResidues = bitReader(6) + 1;
-    s_residue_param.alloc(sizeof(vorbis_info_residue_t) * s_nrOfResidues);
-    for(i = 0; i < s_nrOfResidues; i++){
-         if(res_unpack(s_residue_param.get() + i)){
+    m_nrOfResidues = bitReader(6) + 1;
+    m_residue_param.alloc(sizeof(vorbis_info_residue_t) * m_nrOfResidues);
+    for(i = 0; i < m_nrOfResidues; i++){
+         if(res_unpack(m_residue_param.get() + i)){
             VORBIS_LOG_ERROR("err while unpacking residues");
             goto err_out;
          }
     }
 
     // /* map backend settings */
-    s_nrOfMaps = bitReader(6) + 1;
-    s_map_param.alloc(sizeof(vorbis_info_mapping_t) * s_nrOfMaps);
-    for(i = 0; i < s_nrOfMaps; i++) {
+    m_nrOfMaps = bitReader(6) + 1;
+    m_map_param.alloc(sizeof(vorbis_info_mapping_t) * m_nrOfMaps);
+    for(i = 0; i < m_nrOfMaps; i++) {
         if(bitReader(16) != 0) goto err_out;
-        if(mapping_info_unpack(s_map_param.get() + i)){
+        if(mapping_info_unpack(m_map_param.get() + i)){
             VORBIS_LOG_ERROR("err while unpacking mappings");
             goto err_out;
         }
     }
 
     /* mode settings */
-    s_nrOfModes = bitReader(6) + 1;
-    s_mode_param.alloc(sizeof(vorbis_info_mode_t) * s_nrOfModes);
-    for(i = 0; i < s_nrOfModes; i++) {
-        s_mode_param[i].blockflag = bitReader(1);
+    m_nrOfModes = bitReader(6) + 1;
+    m_mode_param.alloc(sizeof(vorbis_info_mode_t) * m_nrOfModes);
+    for(i = 0; i < m_nrOfModes; i++) {
+        m_mode_param[i].blockflag = bitReader(1);
         if(bitReader(16)) goto err_out;
         if(bitReader(16)) goto err_out;
-        s_mode_param[i].mapping = bitReader(8);
-        if(s_mode_param[i].mapping >= s_nrOfMaps){
+        m_mode_param[i].mapping = bitReader(8);
+        if(m_mode_param[i].mapping >= m_nrOfMaps){
             VORBIS_LOG_ERROR("too many modes");
             goto err_out;
         }
@@ -696,8 +634,8 @@ int32_t parseVorbisCodebook(){
         VORBIS_LOG_ERROR("codebooks, end bit not found");
         goto err_out;
     }
-    // if(s_setupHeaderLength != s_bitReader.headptr - s_bitReader.data){
-    //     VORBIS_LOG_ERROR("Error reading setup header, assumed %i bytes, read %i bytes", s_setupHeaderLength, s_bitReader.headptr - s_bitReader.data);
+    // if(m_setupHeaderLength != m_bitReader.headptr - m_bitReader.data){
+    //     VORBIS_LOG_ERROR("Error reading setup header, assumed %i bytes, read %i bytes", m_setupHeaderLength, m_bitReader.headptr - m_bitReader.data);
     //     goto err_out;
     // }
     /* top level EOP check */
@@ -706,20 +644,20 @@ int32_t parseVorbisCodebook(){
 
 err_out:
     //    vorbis_info_clear(vi);
-    VORBIS_LOG_ERROR("err in codebook!  at pos %d", s_bitReader.headptr - s_bitReader.data);
+    VORBIS_LOG_ERROR("err in codebook!  at pos %d", m_bitReader.headptr - m_bitReader.data);
     return (OV_EBADHEADER);
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t VORBISparseOGG(uint8_t *inbuf, int32_t *bytesLeft){
+int32_t VORBISDecoder::VORBISparseOGG(uint8_t *inbuf, int32_t *bytesLeft){
                                                            // reference https://www.xiph.org/ogg/doc/rfc3533.txt
     int32_t ret = 0; (void)ret;
 
     int32_t idx = VORBIS_specialIndexOf(inbuf, "OggS", 8192);
     if(idx != 0){
-        if(s_f_oggContinuedPage){VORBIS_LOG_ERROR("Vorbis decoder asynchron, 'OggS' not found"); return VORBIS_ERR;}
+        if(m_f_oggContinuedPage){VORBIS_LOG_ERROR("Vorbis decoder asynchron, 'OggS' not found"); return VORBIS_ERR;}
         inbuf += idx;
         *bytesLeft -= idx;
-        s_vorbisCurrentFilePos += idx;
+        m_vorbisCurrentFilePos += idx;
     }
 
     int16_t segmentTableWrPtr = -1;
@@ -750,7 +688,7 @@ int32_t VORBISparseOGG(uint8_t *inbuf, int32_t *bytesLeft){
 
     // read the segment table (contains pageSegments bytes),  1...251: Length of the frame in bytes,
     // 255: A second byte is needed.  The total length is first_byte + second byte
-    s_vorbisSegmentLength = 0;
+    m_vorbisSegmentLength = 0;
     segmentTableWrPtr = -1;
 
     for(int32_t i = 0; i < pageSegments; i++){
@@ -761,11 +699,11 @@ int32_t VORBISparseOGG(uint8_t *inbuf, int32_t *bytesLeft){
             n+= *(inbuf + 27 + i);
         }
         segmentTableWrPtr++;
-        s_vorbisSegmentTable[segmentTableWrPtr] = n;
-        s_vorbisSegmentLength += n;
+        m_vorbisSegmentTable[segmentTableWrPtr] = n;
+        m_vorbisSegmentLength += n;
     }
-    s_vorbisSegmentTableSize = segmentTableWrPtr + 1;
-    s_vorbisCompressionRatio = (float)(960 * 2 * pageSegments)/s_vorbisSegmentLength;  // const 960 validBytes out
+    m_vorbisSegmentTableSize = segmentTableWrPtr + 1;
+    m_vorbisCompressionRatio = (float)(960 * 2 * pageSegments)/m_vorbisSegmentLength;  // const 960 validBytes out
 
     bool     continuedPage = headerType & 0x01; // set: page contains data of a packet continued from the previous page
     bool     firstPage     = headerType & 0x02; // set: this is the first page of a logical bitstream (bos)
@@ -773,27 +711,27 @@ int32_t VORBISparseOGG(uint8_t *inbuf, int32_t *bytesLeft){
 
     uint16_t headerSize    = pageSegments + 27;
 
-    // VORBIS_LOG_INFO("headerSize %i, s_vorbisSegmentLength %i, s_vorbisSegmentTableSize %i", headerSize, s_vorbisSegmentLength, s_vorbisSegmentTableSize);
+    // VORBIS_LOG_INFO("headerSize %i, m_vorbisSegmentLength %i, m_vorbisSegmentTableSize %i", headerSize, m_vorbisSegmentLength, m_vorbisSegmentTableSize);
     if(firstPage || continuedPage || lastPage){
     // VORBIS_LOG_INFO("firstPage %i  continuedPage %i  lastPage %i", firstPage, continuedPage, lastPage);
     }
 
     *bytesLeft -= headerSize;
     inbuf += headerSize;
-    s_vorbisCurrentFilePos += headerSize;
- //   if(s_pageNr < 4 && !continuedPage) s_pageNr++;
+    m_vorbisCurrentFilePos += headerSize;
+ //   if(m_pageNr < 4 && !continuedPage) m_pageNr++;
 
-    s_f_oggFirstPage = firstPage;
-    s_f_oggContinuedPage = continuedPage;
-    s_f_oggLastPage = lastPage;
-    s_oggHeaderSize = headerSize;
+    m_f_oggFirstPage = firstPage;
+    m_f_oggContinuedPage = continuedPage;
+    m_f_oggLastPage = lastPage;
+    m_oggHeaderSize = headerSize;
 
-    if(firstPage) s_pageNr = 0;
+    if(firstPage) m_pageNr = 0;
 
     return VORBIS_PARSE_OGG_DONE; // no error
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint16_t continuedOggPackets(uint8_t *inbuf){
+uint16_t VORBISDecoder::continuedOggPackets(uint8_t *inbuf){
 
     // skip OggS header to pageSegments
     // VORBIS_LOG_INFO("%c%c%c%c", *(inbuf+0), *(inbuf+1), *(inbuf+2), *(inbuf+3));
@@ -828,7 +766,7 @@ uint16_t continuedOggPackets(uint8_t *inbuf){
     return 0;
 }
 //----------------------------------------------------------------------------------------------------------------------
-int32_t VORBISFindSyncWord(unsigned char *buf, int32_t nBytes){
+int32_t VORBISDecoder::findSyncWord(unsigned char *buf, int32_t nBytes){
     // assume we have a ogg wrapper
     int32_t idx = VORBIS_specialIndexOf(buf, "OggS", nBytes);
     if(idx >= 0){ // Magic Word found
@@ -840,7 +778,7 @@ int32_t VORBISFindSyncWord(unsigned char *buf, int32_t nBytes){
     return VORBIS_ERR;
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t vorbis_book_unpack(codebook_t *s) {
+int32_t VORBISDecoder::vorbis_book_unpack(codebook_t *s) {
     ps_ptr<char> lengthlist;
     uint8_t quantvals = 0;
     int32_t i, j;
@@ -1043,13 +981,13 @@ int32_t vorbis_book_unpack(codebook_t *s) {
     return 0; // ok
 _errout:
 _eofout:
-    vorbis_book_clear(s_codebooks);
+    vorbis_book_clear(m_codebooks);
     return VORBIS_ERR; // error
 }
 //---------------------------------------------------------------------------------------------------------------------
 
 //----------------------------------------------------------------------------------------------------------------------
-int32_t VORBIS_specialIndexOf(uint8_t* base, const char* str, int32_t baselen, bool exact){
+int32_t VORBISDecoder::VORBIS_specialIndexOf(uint8_t* base, const char* str, int32_t baselen, bool exact){
     int32_t result = -1;  // seek for str in buffer or in header up to baselen, not nullterninated
     if (strlen(str) > baselen) return -1; // if exact == true seekstr in buffer must have "\0" at the end
     for (int32_t i = 0; i < baselen - strlen(str); i++){
@@ -1073,42 +1011,42 @@ const uint32_t mask[] = {0x00000000, 0x00000001, 0x00000003, 0x00000007, 0x00000
                          0x0fffffff, 0x1fffffff, 0x3fffffff, 0x7fffffff, 0xffffffff};
 
 
-void bitReader_clear(){
-    s_bitReader.data = NULL;
-    s_bitReader.headptr = NULL;
-    s_bitReader.length = 0;
-    s_bitReader.headend = 0;
-    s_bitReader.headbit = 0;
+void VORBISDecoder::bitReader_clear(){
+    m_bitReader.data = NULL;
+    m_bitReader.headptr = NULL;
+    m_bitReader.length = 0;
+    m_bitReader.headend = 0;
+    m_bitReader.headbit = 0;
 }
 
-void bitReader_setData(uint8_t *buff, uint16_t buffSize){
-    s_bitReader.data = buff;
-    s_bitReader.headptr = buff;
-    s_bitReader.length = buffSize;
-    s_bitReader.headend = buffSize * 8;
-    s_bitReader.headbit = 0;
+void VORBISDecoder::bitReader_setData(uint8_t *buff, uint16_t buffSize){
+    m_bitReader.data = buff;
+    m_bitReader.headptr = buff;
+    m_bitReader.length = buffSize;
+    m_bitReader.headend = buffSize * 8;
+    m_bitReader.headbit = 0;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 /* Read in bits without advancing the bitptr; bits <= 32 */
-int32_t bitReader_look(uint16_t nBits){
+int32_t VORBISDecoder::bitReader_look(uint16_t nBits){
     uint32_t m = mask[nBits];
     int32_t  ret = 0;
 
-    nBits += s_bitReader.headbit;
+    nBits += m_bitReader.headbit;
 
-    if(nBits >= s_bitReader.headend << 3) {
-        uint8_t       *ptr = s_bitReader.headptr;
+    if(nBits >= m_bitReader.headend << 3) {
+        uint8_t       *ptr = m_bitReader.headptr;
         if(nBits) {
-            ret = *ptr++ >> s_bitReader.headbit;
+            ret = *ptr++ >> m_bitReader.headbit;
             if(nBits > 8) {
-                ret |= *ptr++ << (8 - s_bitReader.headbit);
+                ret |= *ptr++ << (8 - m_bitReader.headbit);
                 if(nBits > 16) {
-                    ret |= *ptr++ << (16 - s_bitReader.headbit);
+                    ret |= *ptr++ << (16 - m_bitReader.headbit);
                     if(nBits > 24) {
-                         ret |= *ptr++ << (24 - s_bitReader.headbit);
-                        if(nBits > 32 && s_bitReader.headbit) {
-                            ret |= *ptr << (32 - s_bitReader.headbit);
+                         ret |= *ptr++ << (24 - m_bitReader.headbit);
+                        if(nBits > 32 && m_bitReader.headbit) {
+                            ret |= *ptr << (32 - m_bitReader.headbit);
                         }
                     }
                 }
@@ -1117,14 +1055,14 @@ int32_t bitReader_look(uint16_t nBits){
     }
     else {
         /* make this a switch jump-table */
-        ret = s_bitReader.headptr[0] >> s_bitReader.headbit;
+        ret = m_bitReader.headptr[0] >> m_bitReader.headbit;
         if(nBits > 8) {
-            ret |= s_bitReader.headptr[1] << (8 - s_bitReader.headbit);
+            ret |= m_bitReader.headptr[1] << (8 - m_bitReader.headbit);
             if(nBits > 16) {
-                ret |= s_bitReader.headptr[2] << (16 - s_bitReader.headbit);
+                ret |= m_bitReader.headptr[2] << (16 - m_bitReader.headbit);
                 if(nBits > 24) {
-                    ret |= s_bitReader.headptr[3] << (24 - s_bitReader.headbit);
-                    if(nBits > 32 && s_bitReader.headbit) ret |= s_bitReader.headptr[4] << (32 - s_bitReader.headbit);
+                    ret |= m_bitReader.headptr[3] << (24 - m_bitReader.headbit);
+                    if(nBits > 32 && m_bitReader.headbit) ret |= m_bitReader.headptr[4] << (32 - m_bitReader.headbit);
                 }
             }
         }
@@ -1135,26 +1073,26 @@ int32_t bitReader_look(uint16_t nBits){
 }
 
 /* bits <= 32 */
-int32_t bitReader(uint16_t nBits) {
+int32_t VORBISDecoder::bitReader(uint16_t nBits) {
     int32_t ret = bitReader_look(nBits);
     if(bitReader_adv(nBits) < 0) return -1;
     return (ret);
 }
 
 /* limited to 32 at a time */
-int8_t bitReader_adv(uint16_t nBits) {
-    nBits += s_bitReader.headbit;
-    s_bitReader.headbit = nBits & 7;
-    s_bitReader.headend -= (nBits >> 3);
-    s_bitReader.headptr += (nBits >> 3);
-    if(s_bitReader.headend < 1){
+int8_t VORBISDecoder::bitReader_adv(uint16_t nBits) {
+    nBits += m_bitReader.headbit;
+    m_bitReader.headbit = nBits & 7;
+    m_bitReader.headend -= (nBits >> 3);
+    m_bitReader.headptr += (nBits >> 3);
+    if(m_bitReader.headend < 1){
         return -1;
         VORBIS_LOG_ERROR("error in bitreader");
     }
     return 0;
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t ilog(uint32_t v) {
+int32_t VORBISDecoder::ilog(uint32_t v) {
     int32_t ret = 0;
     if(v) --v;
     while(v) {
@@ -1164,7 +1102,7 @@ int32_t ilog(uint32_t v) {
     return (ret);
 }
 //----------------------------------------------------------------------------------------------------------------------
-uint8_t _ilog(uint32_t v) {
+uint8_t VORBISDecoder::_ilog(uint32_t v) {
     uint8_t ret = 0;
     while(v) {
         ret++;
@@ -1176,7 +1114,7 @@ uint8_t _ilog(uint32_t v) {
 /* 32 bit float (not IEEE; nonnormalized mantissa + biased exponent) : neeeeeee eeemmmmm mmmmmmmm mmmmmmmm
  Why not IEEE?  It's just not that important here. */
 
-int32_t _float32_unpack(int32_t val, int32_t *point) {
+int32_t VORBISDecoder::_float32_unpack(int32_t val, int32_t *point) {
     int32_t mant = val & 0x1fffff;
     bool    sign = val < 0;
 
@@ -1194,7 +1132,7 @@ int32_t _float32_unpack(int32_t val, int32_t *point) {
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* choose the smallest supported node size that fits our decode table. Legal bytewidths are 1/1 1/2 2/2 2/4 4/4 */
-int32_t _determine_node_bytes(uint32_t used, uint8_t leafwidth) {
+int32_t VORBISDecoder::_determine_node_bytes(uint32_t used, uint8_t leafwidth) {
     /* special case small books to size 4 to avoid multiple special cases in repack */
     if(used < 2) return 4;
 
@@ -1204,12 +1142,12 @@ int32_t _determine_node_bytes(uint32_t used, uint8_t leafwidth) {
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* convenience/clarity; leaves are specified as multiple of node word size (1 or 2) */
-int32_t _determine_leaf_words(int32_t nodeb, int32_t leafwidth) {
+int32_t VORBISDecoder::_determine_leaf_words(int32_t nodeb, int32_t leafwidth) {
     if(leafwidth > nodeb) return 2;
     return 1;
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t _make_decode_table(codebook_t *s, char *lengthlist, uint8_t quantvals, int32_t maptype) {
+int32_t VORBISDecoder::_make_decode_table(codebook_t *s, char *lengthlist, uint8_t quantvals, int32_t maptype) {
     ps_ptr<uint32_t>work;
 
     if(s->dec_nodeb == 4) {
@@ -1316,7 +1254,7 @@ int32_t _make_decode_table(codebook_t *s, char *lengthlist, uint8_t quantvals, i
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* given a list of word lengths, number of used entries, and byte width of a leaf, generate the decode table */
-int32_t _make_words(char *l, uint16_t n, uint32_t *work, uint8_t quantvals, codebook_t *b, int32_t maptype) {
+int32_t VORBISDecoder::_make_words(char *l, uint16_t n, uint32_t *work, uint8_t quantvals, codebook_t *b, int32_t maptype) {
 
     int32_t  i, j, count = 0;
     uint32_t top = 0;
@@ -1380,7 +1318,7 @@ int32_t _make_words(char *l, uint16_t n, uint32_t *work, uint8_t quantvals, code
     return 0;
 }
 //---------------------------------------------------------------------------------------------------------------------
-uint32_t decpack(int32_t entry, int32_t used_entry, uint8_t quantvals, codebook_t *b, int32_t maptype) {
+uint32_t VORBISDecoder::decpack(int32_t entry, int32_t used_entry, uint8_t quantvals, codebook_t *b, int32_t maptype) {
     uint32_t ret = 0;
 
     switch(b->dec_type) {
@@ -1434,7 +1372,7 @@ uint32_t decpack(int32_t entry, int32_t used_entry, uint8_t quantvals, codebook_
  codebooks like that */
 /* there might be a straightforward one-line way to do the below that's portable and totally safe against roundoff, but
  I haven't thought of it.  Therefore, we opt on the side of caution */
-uint8_t _book_maptype1_quantvals(codebook_t *b) {
+uint8_t VORBISDecoder::_book_maptype1_quantvals(codebook_t *b) {
     /* get us a starting hint, we'll polish it below */
     uint8_t bits = _ilog(b->entries);
     uint8_t vals = b->entries >> ((bits - 1) * (b->dim - 1) / b->dim);
@@ -1455,16 +1393,16 @@ uint8_t _book_maptype1_quantvals(codebook_t *b) {
     }
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t oggpack_eop() {
-    if(s_bitReader.headptr -s_bitReader.data  > s_setupHeaderLength){
-        VORBIS_LOG_INFO("s_bitReader.headptr %i, s_setupHeaderLength %i", s_bitReader.headptr, s_setupHeaderLength);
+int32_t VORBISDecoder::oggpack_eop() {
+    if(m_bitReader.headptr -m_bitReader.data  > m_setupHeaderLength){
+        VORBIS_LOG_INFO("m_bitReader.headptr %i, m_setupHeaderLength %i", m_bitReader.headptr, m_setupHeaderLength);
         VORBIS_LOG_INFO("ogg package 3 overflow");
          return -1;
     }
     return 0;
 }
 //---------------------------------------------------------------------------------------------------------------------
- ps_ptr<vorbis_info_floor_t> floor0_info_unpack() {
+ps_ptr<vorbis_info_floor_t> VORBISDecoder::floor0_info_unpack() {
 
     int32_t j;
 
@@ -1485,7 +1423,7 @@ int32_t oggpack_eop() {
 
     for(j = 0; j < info->numbooks; j++) {
         info->books[j] = bitReader(8);
-        if(info->books[j] >= s_nrOfCodebooks) goto err_out;
+        if(info->books[j] >= m_nrOfCodebooks) goto err_out;
     }
 
     if(oggpack_eop()) goto err_out;
@@ -1495,7 +1433,7 @@ err_out:
     return {};
 }
 //---------------------------------------------------------------------------------------------------------------------
-ps_ptr<vorbis_info_floor_t> floor1_info_unpack() {
+ps_ptr<vorbis_info_floor_t> VORBISDecoder::floor1_info_unpack() {
 
     ps_ptr<uint8_t> B;
     int32_t j, k, count = 0, maxclass = -1, rangebits;
@@ -1523,10 +1461,10 @@ ps_ptr<vorbis_info_floor_t> floor1_info_unpack() {
         else{
             info->_class[j].class_book = 0;
         }
-        if(info->_class[j].class_book >= s_nrOfCodebooks) goto err_out;
+        if(info->_class[j].class_book >= m_nrOfCodebooks) goto err_out;
         for(k = 0; k < (1 << info->_class[j].class_subs); k++) {
             info->_class[j].class_subbook[k] = (uint8_t)bitReader(8) - 1;
-            if(info->_class[j].class_subbook[k] >= s_nrOfCodebooks && info->_class[j].class_subbook[k] != 0xff) goto err_out;
+            if(info->_class[j].class_subbook[k] >= m_nrOfCodebooks && info->_class[j].class_subbook[k] != 0xff) goto err_out;
         }
     }
 
@@ -1588,7 +1526,7 @@ err_out:
     return {};
 }
 //---------------------------------------------------------------------------------------------------------------------
-void vorbis_mergesort(uint8_t* index, uint16_t* vals, uint16_t n) {
+void VORBISDecoder::vorbis_mergesort(uint8_t* index, uint16_t* vals, uint16_t n) {
     uint16_t i, j;
     ps_ptr<uint8_t> B_mem;
     B_mem.alloc(n * sizeof(uint8_t), "vorbis_temp");
@@ -1628,7 +1566,7 @@ void vorbis_mergesort(uint8_t* index, uint16_t* vals, uint16_t n) {
 
 //---------------------------------------------------------------------------------------------------------------------
 /* vorbis_info is for range checking */
-int32_t res_unpack(vorbis_info_residue_t *info){
+int32_t VORBISDecoder::res_unpack(vorbis_info_residue_t *info){
     int32_t               j, k;
     memset(info, 0, sizeof(*info));
 
@@ -1639,7 +1577,7 @@ int32_t res_unpack(vorbis_info_residue_t *info){
     info->grouping =   bitReader(24) + 1;
     info->partitions = bitReader(6) + 1;
     info->groupbook =  bitReader(8);
-    if(info->groupbook >= s_nrOfCodebooks) goto errout;
+    if(info->groupbook >= m_nrOfCodebooks) goto errout;
 
     info->stagemasks.alloc(info->partitions * sizeof(uint8_t));
     info->stagebooks.alloc(info->partitions * 8 * sizeof(uint8_t));
@@ -1654,7 +1592,7 @@ int32_t res_unpack(vorbis_info_residue_t *info){
         for(k = 0; k < 8; k++) {
             if((info->stagemasks[j] >> k) & 1) {
                 uint8_t book = bitReader(8);
-                if(book >= s_nrOfCodebooks) goto errout;
+                if(book >= m_nrOfCodebooks) goto errout;
                 info->stagebooks[j * 8 + k] = book;
                 if(k + 1 > info->stages) info->stages = k + 1;
             }
@@ -1671,7 +1609,7 @@ errout:
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* also responsible for range checking */
-int32_t mapping_info_unpack(vorbis_info_mapping_t *info) {
+int32_t VORBISDecoder::mapping_info_unpack(vorbis_info_mapping_t *info) {
     int32_t               i;
     memset(info, 0, sizeof(*info));
 
@@ -1684,10 +1622,10 @@ int32_t mapping_info_unpack(vorbis_info_mapping_t *info) {
         info->coupling.alloc(info->coupling_steps * sizeof(coupling_step_t));
 
         for(i = 0; i < info->coupling_steps; i++) {
-            int32_t testM = info->coupling[i].mag = bitReader(ilog(s_vorbisChannels));
-            int32_t testA = info->coupling[i].ang = bitReader(ilog(s_vorbisChannels));
+            int32_t testM = info->coupling[i].mag = bitReader(ilog(m_vorbisChannels));
+            int32_t testA = info->coupling[i].ang = bitReader(ilog(m_vorbisChannels));
 
-            if(testM < 0 || testA < 0 || testM == testA || testM >= s_vorbisChannels || testA >= s_vorbisChannels) goto err_out;
+            if(testM < 0 || testA < 0 || testM == testA || testM >= m_vorbisChannels || testA >= m_vorbisChannels) goto err_out;
         }
     }
 
@@ -1695,8 +1633,8 @@ int32_t mapping_info_unpack(vorbis_info_mapping_t *info) {
     /* 2,3:reserved */
 
     if(info->submaps > 1) {
-        info->chmuxlist.alloc(sizeof(uint8_t) * s_vorbisChannels);
-        for(i = 0; i < s_vorbisChannels; i++) {
+        info->chmuxlist.alloc(sizeof(uint8_t) * m_vorbisChannels);
+        for(i = 0; i < m_vorbisChannels; i++) {
             info->chmuxlist[i] = bitReader(4);
             if(info->chmuxlist[i] >= info->submaps) goto err_out;
         }
@@ -1707,9 +1645,9 @@ int32_t mapping_info_unpack(vorbis_info_mapping_t *info) {
         int32_t temp = bitReader(8);
         (void)temp;
         info->submaplist[i].floor = bitReader(8);
-        if(info->submaplist[i].floor >= s_nrOfFloors) goto err_out;
+        if(info->submaplist[i].floor >= m_nrOfFloors) goto err_out;
         info->submaplist[i].residue = bitReader(8);
-        if(info->submaplist[i].residue >= s_nrOfResidues) goto err_out;
+        if(info->submaplist[i].residue >= m_nrOfResidues) goto err_out;
     }
 
     return 0;
@@ -1721,27 +1659,38 @@ err_out:
 //      ⏫⏫⏫    O G G      I M P L     A B O V E  ⏫⏫⏫
 //      ⏬⏬⏬ V O R B I S   I M P L     B E L O W  ⏬⏬⏬
 //---------------------------------------------------------------------------------------------------------------------
-ps_ptr<vorbis_dsp_state_t> vorbis_dsp_create() {
+ps_ptr<vorbis_dsp_state_t> VORBISDecoder::vorbis_dsp_create() {
     ps_ptr<vorbis_dsp_state_t> v;
     v.alloc(sizeof(vorbis_dsp_state_t));
     v.clear();
 
-    v->work.alloc(s_vorbisChannels * sizeof(ps_ptr<int32_t>));
+    v->work.alloc(m_vorbisChannels * sizeof(ps_ptr<int32_t>));
     v->work.clear();  // Important!
 
-    v->mdctright.alloc(s_vorbisChannels * sizeof(ps_ptr<int32_t>));
+    v->mdctright.alloc(m_vorbisChannels * sizeof(ps_ptr<int32_t>));
     v->mdctright.clear();  // Important!
 
-    for (uint8_t i = 0; i < s_vorbisChannels; ++i) {
-        const size_t work_size = (s_blocksizes[1] >> 1) * sizeof(int32_t);
+    for (uint8_t i = 0; i < m_vorbisChannels; ++i) {
+        const size_t work_size = (m_blocksizes[1] >> 1) * sizeof(int32_t);
         v->work.at(i).alloc(work_size);
         v->work.at(i).clear();
 
-        const size_t mdct_size = (s_blocksizes[1] >> 2) * sizeof(int32_t);
+        const size_t mdct_size = (m_blocksizes[1] >> 2) * sizeof(int32_t);
         v->mdctright.at(i).alloc(mdct_size);
         v->mdctright.at(i).clear();
     }
 
+    // pcmbundle, zerobundle, nonzero, floormemo and the floor memos of all channels, see mapping_inverse()
+    v->floormemo_size = 0;
+    for (uint8_t i = 0; m_floor_param.valid() && i < m_nrOfFloors; ++i) {
+        if (!m_floor_param[i].valid()) continue; // setup header not complete
+        int32_t memosize = m_floor_type[i] ? floor1_memosize(m_floor_param[i]) : floor0_memosize(m_floor_param[i]);
+        v->floormemo_size = max(v->floormemo_size, memosize);
+    }
+    auto a8 = [](size_t bytes) { return (bytes + 7) & ~(size_t)7; };
+    m_scratch.alloc(2 * a8(m_vorbisChannels * sizeof(int32_t*)) + 2 * a8(m_vorbisChannels * sizeof(int32_t)) +
+                    a8(m_vorbisChannels * v->floormemo_size * sizeof(int32_t)), "vorbis_scratch");
+
     // Initialize state
     v->lW = 0;
     v->W = 0;
@@ -1751,33 +1700,34 @@ ps_ptr<vorbis_dsp_state_t> vorbis_dsp_create() {
     return v;
 }
 //---------------------------------------------------------------------------------------------------------------------
-void vorbis_dsp_destroy(ps_ptr<vorbis_dsp_state_t> &v) {
+void VORBISDecoder::vorbis_dsp_destroy(ps_ptr<vorbis_dsp_state_t> &v) {
     if(!v.valid())return;
 
-    for (uint8_t i = 0; i < s_vorbisChannels; ++i) {
+    for (uint8_t i = 0; i < m_vorbisChannels; ++i) {
         v->work.at(i).reset();
         v->mdctright.at(i).reset();
     }
+    m_scratch.reset();
     v->mdctright.reset();
     v->work.reset();
     v.reset();
 }
 //---------------------------------------------------------------------------------------------------------------------
-void vorbis_book_clear(ps_ptr<codebook_t> &v){
+void VORBISDecoder::vorbis_book_clear(ps_ptr<codebook_t> &v){
     if(!v.valid())return;
     int s = 0;
-    for(int i = 0; i < s_nrOfCodebooks; i++){
+    for(int i = 0; i < m_nrOfCodebooks; i++){
         if(v[i].q_val.valid())    {s += v[i].q_val.size();     v[i].q_val.reset();}
         if(v[i].dec_table.valid()){s += v[i].dec_table.size(); v[i].dec_table.reset();}
     }
     if(v->dec_table.valid())   {s += v->dec_table.size(); v->dec_table.reset();}
     if(v->q_val.valid())       {s += v ->q_val.size(); v ->q_val.reset();}
     s += v.size(); v.reset();
-    s_nrOfCodebooks = 0;
+    m_nrOfCodebooks = 0;
     // VORBIS_LOG_INFO("free codebook_t %i bytes", s);
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t vorbis_dsp_synthesis(uint8_t* inbuf, uint16_t len, int16_t* outbuf) {
+int32_t VORBISDecoder::vorbis_dsp_synthesis(uint8_t* inbuf, uint16_t len, int16_t* outbuf) {
 
     int32_t mode, i;
 
@@ -1788,16 +1738,16 @@ int32_t vorbis_dsp_synthesis(uint8_t* inbuf, uint16_t len, int16_t* outbuf) {
     }
 
     /* read our mode and pre/post windowsize */
-    mode = bitReader(ilog(s_nrOfModes));
-    if(mode == -1 || mode >= s_nrOfModes) return OV_EBADPACKET;
+    mode = bitReader(ilog(m_nrOfModes));
+    if(mode == -1 || mode >= m_nrOfModes) return OV_EBADPACKET;
 
     /* shift information we still need from last window */
-    s_dsp_state->lW = s_dsp_state->W;
-    s_dsp_state->W = s_mode_param[mode].blockflag;
-    for(i = 0; i < s_vorbisChannels; i++){
-        mdct_shift_right(s_blocksizes[s_dsp_state->lW], s_dsp_state->work[i].get(), s_dsp_state->mdctright[i].get());
+    m_dsp_state->lW = m_dsp_state->W;
+    m_dsp_state->W = m_mode_param[mode].blockflag;
+    for(i = 0; i < m_vorbisChannels; i++){
+        mdct_shift_right(m_blocksizes[m_dsp_state->lW], m_dsp_state->work[i].get(), m_dsp_state->mdctright[i].get());
     }
-    if(s_dsp_state->W) {
+    if(m_dsp_state->W) {
         int32_t temp;
         bitReader(1);
         temp = bitReader(1);
@@ -1806,22 +1756,22 @@ int32_t vorbis_dsp_synthesis(uint8_t* inbuf, uint16_t len, int16_t* outbuf) {
 
     /* packet decode and portions of synthesis that rely on only this block */
     {
-        mapping_inverse(s_map_param.get() + s_mode_param[mode].mapping);
+        mapping_inverse(m_map_param.get() + m_mode_param[mode].mapping);
 
-        if(s_dsp_state->out_begin == -1) {
-            s_dsp_state->out_begin = 0;
-            s_dsp_state->out_end = 0;
+        if(m_dsp_state->out_begin == -1) {
+            m_dsp_state->out_begin = 0;
+            m_dsp_state->out_end = 0;
         }
         else {
-            s_dsp_state->out_begin = 0;
-            s_dsp_state->out_end = s_blocksizes[s_dsp_state->lW] / 4 + s_blocksizes[s_dsp_state->W] / 4;
+            m_dsp_state->out_begin = 0;
+            m_dsp_state->out_end = m_blocksizes[m_dsp_state->lW] / 4 + m_blocksizes[m_dsp_state->W] / 4;
         }
     }
 
     return (0);
 }
 //---------------------------------------------------------------------------------------------------------------------
-void mdct_shift_right(int32_t n, int32_t *in, int32_t *right) {
+void VORBISDecoder::mdct_shift_right(int32_t n, int32_t *in, int32_t *right) {
     int32_t i;
     n >>= 2;
     in += 1;
@@ -1829,18 +1779,21 @@ void mdct_shift_right(int32_t n, int32_t *in, int32_t *right) {
     for(i = 0; i < n; i++) right[i] = in[i << 1];
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t mapping_inverse(vorbis_info_mapping_t *info) {
+int32_t VORBISDecoder::mapping_inverse(vorbis_info_mapping_t *info) {
 
     int32_t     i, j;
-    int32_t n = s_blocksizes[s_dsp_state->W];
+    int32_t n = m_blocksizes[m_dsp_state->W];
 
-    ps_ptr<int32_t*> pcmbundle;  pcmbundle.alloc_array(s_vorbisChannels);
-    ps_ptr<int32_t>  zerobundle; zerobundle.alloc(sizeof(int32_t) * s_vorbisChannels);
-    ps_ptr<int32_t>  nonzero;    nonzero.alloc(sizeof(int32_t) * s_vorbisChannels);
-    ps_ptr<ps_ptr<int32_t>> floormemo; floormemo.alloc_array(s_vorbisChannels);
+    ps_scratch& scratch = m_scratch;
+    scratch.rewind(); // new packet, no temporary array is in use
+    auto pcmbundle  = scratch.get<int32_t*>(m_vorbisChannels);
+    auto floormemo  = scratch.get<int32_t*>(m_vorbisChannels);
+    auto zerobundle = scratch.get<int32_t>(m_vorbisChannels);
+    auto nonzero    = scratch.get<int32_t>(m_vorbisChannels);
+    auto memo       = scratch.get<int32_t>(m_vorbisChannels * m_dsp_state->floormemo_size);
 
     /* recover the spectral envelope; store it in the PCM vector for now */
-    for(i = 0; i < s_vorbisChannels; i++) {
+    for(i = 0; i < m_vorbisChannels; i++) {
 
         int32_t submap = 0;
         int32_t floorno;
@@ -1848,21 +1801,19 @@ int32_t mapping_inverse(vorbis_info_mapping_t *info) {
         if(info->submaps > 1) submap = info->chmuxlist[i];
         floorno = info->submaplist[submap].floor;
 
-        if(s_floor_type[floorno]) {
+        if(m_floor_type[floorno]) {
             /* floor 1 */
-            floormemo[i].alloc(sizeof(*floormemo[i]) * floor1_memosize(s_floor_param[floorno]));
-            floormemo[i] = floor1_inverse1(s_floor_param[floorno], floormemo[i].get());
+            floormemo[i] = floor1_inverse1(m_floor_param[floorno], memo.get() + i * m_dsp_state->floormemo_size);
         }
         else {
             /* floor 0 */
-            floormemo[i].alloc(sizeof(*floormemo[i]) * floor0_memosize(s_floor_param[floorno]));
-            floormemo[i] = floor0_inverse1(s_floor_param[floorno], floormemo[i].get());
+            floormemo[i] = floor0_inverse1(m_floor_param[floorno], memo.get() + i * m_dsp_state->floormemo_size);
         }
 
-        if(floormemo[i].get()) nonzero[i] = 1;
+        if(floormemo[i]) nonzero[i] = 1;
         else
             nonzero[i] = 0;
-        memset(s_dsp_state->work[i].get(), 0, sizeof(*s_dsp_state->work[i]) * n / 2);
+        memset(m_dsp_state->work[i].get(), 0, sizeof(*m_dsp_state->work[i]) * n / 2);
     }
 
     /* channel coupling can 'dirty' the nonzero listing */
@@ -1876,15 +1827,15 @@ int32_t mapping_inverse(vorbis_info_mapping_t *info) {
     /* recover the residue into our working vectors */
     for(i = 0; i < info->submaps; i++) {
         uint8_t ch_in_bundle = 0;
-        for(j = 0; j < s_vorbisChannels; j++) {
+        for(j = 0; j < m_vorbisChannels; j++) {
             if(!info->chmuxlist.get() || info->chmuxlist[j] == i) {
                 if(nonzero[j]) zerobundle[ch_in_bundle] = 1;
                 else
                     zerobundle[ch_in_bundle] = 0;
-                pcmbundle[ch_in_bundle++] = s_dsp_state->work[j].get();
+                pcmbundle[ch_in_bundle++] = m_dsp_state->work[j].get();
             }
         }
-        res_inverse(s_residue_param.get() + info->submaplist[i].residue, pcmbundle.get(), zerobundle.get(), ch_in_bundle);
+        res_inverse(m_residue_param.get() + info->submaplist[i].residue, pcmbundle.get(), zerobundle.get(), ch_in_bundle);
     }
 
     // for(j=0;j<vi->channels;j++)
@@ -1892,8 +1843,8 @@ int32_t mapping_inverse(vorbis_info_mapping_t *info) {
 
     /* channel coupling */
     for(i = info->coupling_steps - 1; i >= 0; i--) {
-        int32_t *pcmM = s_dsp_state->work[info->coupling[i].mag].get();
-        int32_t *pcmA = s_dsp_state->work[info->coupling[i].ang].get();
+        int32_t *pcmM = m_dsp_state->work[info->coupling[i].mag].get();
+        int32_t *pcmA = m_dsp_state->work[info->coupling[i].ang].get();
 
         for(j = 0; j < n / 2; j++) {
             int32_t mag = pcmM[j];
@@ -1924,23 +1875,22 @@ int32_t mapping_inverse(vorbis_info_mapping_t *info) {
 
     /* compute and apply spectral envelope */
 
-    for(i = 0; i < s_vorbisChannels; i++) {
-        int32_t *pcm = s_dsp_state->work[i].get();
+    for(i = 0; i < m_vorbisChannels; i++) {
+        int32_t *pcm = m_dsp_state->work[i].get();
         int32_t      submap = 0;
         int32_t      floorno;
 
         if(info->submaps > 1) submap = info->chmuxlist[i];
         floorno = info->submaplist[submap].floor;
 
-        if(s_floor_type[floorno]) {
+        if(m_floor_type[floorno]) {
             /* floor 1 */
-            floor1_inverse2(s_floor_param[floorno], floormemo[i].get(), pcm);
+            floor1_inverse2(m_floor_param[floorno], floormemo[i], pcm);
         }
         else {
             /* floor 0 */
-            floor0_inverse2(s_floor_param[floorno], floormemo[i].get(), pcm);
+            floor0_inverse2(m_floor_param[floorno], floormemo[i], pcm);
         }
-        floormemo[i].reset();
     }
 
     // for(j=0;j<vi->channels;j++)
@@ -1948,8 +1898,8 @@ int32_t mapping_inverse(vorbis_info_mapping_t *info) {
 
     /* transform the PCM data; takes PCM vector, vb; modifies PCM vector */
     /* only MDCT right now.... */
-    for(i = 0; i < s_vorbisChannels; i++){
-        mdct_backward(n, s_dsp_state->work[i].get());
+    for(i = 0; i < m_vorbisChannels; i++){
+        mdct_backward(n, m_dsp_state->work[i].get());
     }
 
     // for(j=0;j<vi->channels;j++)
@@ -1959,15 +1909,15 @@ int32_t mapping_inverse(vorbis_info_mapping_t *info) {
     return (0);
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t floor0_memosize(ps_ptr<vorbis_info_floor_t>& i) {
+int32_t VORBISDecoder::floor0_memosize(ps_ptr<vorbis_info_floor_t>& i) {
     return i.get()->order + 1;
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t floor1_memosize(ps_ptr<vorbis_info_floor_t>& i) {
+int32_t VORBISDecoder::floor1_memosize(ps_ptr<vorbis_info_floor_t>& i) {
     return i.get()->posts;
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t *floor0_inverse1(ps_ptr<vorbis_info_floor_t>& i, int32_t *lsp) {
+int32_t *VORBISDecoder::floor0_inverse1(ps_ptr<vorbis_info_floor_t>& i, int32_t *lsp) {
     vorbis_info_floor_t *info = (vorbis_info_floor_t *)i.get();
     int32_t                 j;
 
@@ -1979,7 +1929,7 @@ int32_t *floor0_inverse1(ps_ptr<vorbis_info_floor_t>& i, int32_t *lsp) {
         int32_t     booknum = bitReader(_ilog(info->numbooks));
 
         if(booknum != -1 && booknum < info->numbooks) { /* be paranoid */
-            codebook_t        *b = s_codebooks.get() + info->books[booknum];
+            codebook_t        *b = m_codebooks.get() + info->books[booknum];
             int32_t           last = 0;
 
             if(vorbis_book_decodev_set(b, lsp, info->order, -24) == -1) goto eop;
@@ -1996,13 +1946,13 @@ eop:
     return (NULL);
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t *floor1_inverse1(ps_ptr<vorbis_info_floor_t>& in, int32_t *fit_value) {
+int32_t *VORBISDecoder::floor1_inverse1(ps_ptr<vorbis_info_floor_t>& in, int32_t *fit_value) {
     vorbis_info_floor_t *info = (vorbis_info_floor_t *)in.get();
 
     int32_t                 quant_look[4] = {256, 128, 86, 64};
     int32_t                 i, j, k;
     int32_t                 quant_q = quant_look[info->mult - 1];
-    codebook_t         *books = s_codebooks.get();
+    codebook_t         *books = m_codebooks.get();
 
     /* unpack wrapped/predicted values from stream */
     if(bitReader(1) == 1) {
@@ -2072,12 +2022,12 @@ eop:
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* returns the [original, not compacted] entry number or -1 on eof *********/
-int32_t vorbis_book_decode(codebook_t* book) {
+int32_t VORBISDecoder::vorbis_book_decode(codebook_t* book) {
     if(book->dec_type) return -1;
     return decode_packed_entry_number(book);
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t decode_packed_entry_number(codebook_t *book) {
+int32_t VORBISDecoder::decode_packed_entry_number(codebook_t *book) {
     uint32_t chase = 0;
     int32_t      read = book->dec_maxlength;
     int32_t  lok = bitReader_look(read), i;
@@ -2164,7 +2114,7 @@ int32_t decode_packed_entry_number(codebook_t *book) {
     return (VORBIS_ERR);
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t render_point(int32_t x0, int32_t x1, int32_t y0, int32_t y1, int32_t x) {
+int32_t VORBISDecoder::render_point(int32_t x0, int32_t x1, int32_t y0, int32_t y1, int32_t x) {
     y0 &= 0x7fff; /* mask off flag */
     y1 &= 0x7fff;
 
@@ -2182,7 +2132,7 @@ int32_t render_point(int32_t x0, int32_t x1, int32_t y0, int32_t y1, int32_t x)
 //---------------------------------------------------------------------------------------------------------------------
 /* unlike the others, we guard against n not being an integer number * of <dim> internally rather than in the upper
  layer (called only by * floor0) */
-int32_t vorbis_book_decodev_set(codebook_t *book, int32_t *a, int32_t n, int32_t point) {
+int32_t VORBISDecoder::vorbis_book_decodev_set(codebook_t *book, int32_t *a, int32_t n, int32_t point) {
     if(book->used_entries > 0) {
         int32_t *v = (int32_t *)alloca(sizeof(*v) * book->dim);
         int32_t      i;
@@ -2201,7 +2151,7 @@ int32_t vorbis_book_decodev_set(codebook_t *book, int32_t *a, int32_t n, int32_t
     return 0;
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t decode_map(codebook_t *s, int32_t *v, int32_t point) {
+int32_t VORBISDecoder::decode_map(codebook_t *s, int32_t *v, int32_t point) {
 
     uint32_t entry = decode_packed_entry_number(s);
 
@@ -2265,14 +2215,14 @@ int32_t decode_map(codebook_t *s, int32_t *v, int32_t point) {
     return 0;
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t res_inverse(vorbis_info_residue_t *info, int32_t **in, int32_t *nonzero, uint8_t ch) {
+int32_t VORBISDecoder::res_inverse(vorbis_info_residue_t *info, int32_t **in, int32_t *nonzero, uint8_t ch) {
     int32_t               j, k, s;
     uint8_t           m = 0, n = 0;
     uint8_t           used = 0;
-    codebook_t         *phrasebook = s_codebooks.get() + info->groupbook;
+    codebook_t         *phrasebook = m_codebooks.get() + info->groupbook;
     uint32_t          samples_per_partition = info->grouping;
     uint8_t           partitions_per_word = phrasebook->dim;
-    uint32_t          pcmend = s_blocksizes[s_dsp_state->W];
+    uint32_t          pcmend = m_blocksizes[m_dsp_state->W];
 
 
     if(info->type < 2) {
@@ -2325,7 +2275,7 @@ int32_t res_inverse(vorbis_info_residue_t *info, int32_t **in, int32_t *nonzero,
                             for(j = 0; j < ch; j++) {
                                 uint32_t offset = info->begin + i * samples_per_partition;
                                 if(info->stagemasks[(int32_t)partword[j][i]] & (1 << s)) {
-                                    codebook_t *stagebook = s_codebooks.get() + info->stagebooks[(partword[j][i] << 3) + s];
+                                    codebook_t *stagebook = m_codebooks.get() + info->stagebooks[(partword[j][i] << 3) + s];
                                     if(info->type) {
                                         if(vorbis_book_decodev_add(stagebook, in[j] + offset,
                                                                    samples_per_partition, -8) == -1)
@@ -2386,7 +2336,7 @@ int32_t res_inverse(vorbis_info_residue_t *info, int32_t **in, int32_t *nonzero,
                     /* now we decode residual values for the partitions */
                     for(k = 0; k < partitions_per_word && i < partvals; k++, i++)
                         if(info->stagemasks[(int32_t)partword[i]] & (1 << s)) {
-                            codebook_t *stagebook = s_codebooks.get() + info->stagebooks[(partword[i] << 3) + s];
+                            codebook_t *stagebook = m_codebooks.get() + info->stagebooks[(partword[i] << 3) + s];
                             if(vorbis_book_decodevv_add(stagebook, in, i * samples_per_partition + beginoff, ch,
                                                         samples_per_partition, -8) == -1)
                                 goto eopbreak;
@@ -2401,7 +2351,7 @@ eopbreak:
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* decode vector / dim granularity guarding is done in the upper layer */
-int32_t vorbis_book_decodev_add(codebook_t *book, int32_t *a, int32_t n, int32_t point) {
+int32_t VORBISDecoder::vorbis_book_decodev_add(codebook_t *book, int32_t *a, int32_t n, int32_t point) {
     if(book->used_entries > 0) {
         int32_t *v = (int32_t *)alloca(sizeof(*v) * book->dim);
         uint32_t i;
@@ -2416,7 +2366,7 @@ int32_t vorbis_book_decodev_add(codebook_t *book, int32_t *a, int32_t n, int32_t
 //---------------------------------------------------------------------------------------------------------------------
 /* returns 0 on OK or -1 on eof */
 /* decode vector / dim granularity guarding is done in the upper layer */
-int32_t vorbis_book_decodevs_add(codebook_t *book, int32_t *a, int32_t n, int32_t point) {
+int32_t VORBISDecoder::vorbis_book_decodevs_add(codebook_t *book, int32_t *a, int32_t n, int32_t point) {
     if(book->used_entries > 0) {
         int32_t      step = n / book->dim;
         int32_t *v = (int32_t *)alloca(sizeof(*v) * book->dim);
@@ -2430,7 +2380,7 @@ int32_t vorbis_book_decodevs_add(codebook_t *book, int32_t *a, int32_t n, int32_
     return 0;
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t floor0_inverse2(ps_ptr<vorbis_info_floor_t>& i, int32_t *lsp, int32_t *out) {
+int32_t VORBISDecoder::floor0_inverse2(ps_ptr<vorbis_info_floor_t>& i, int32_t *lsp, int32_t *out) {
     vorbis_info_floor_t *info = (vorbis_info_floor_t *)i.get();
 
 
@@ -2438,19 +2388,19 @@ int32_t floor0_inverse2(ps_ptr<vorbis_info_floor_t>& i, int32_t *lsp, int32_t *o
         int32_t amp = lsp[info->order];
 
         /* take the coefficients back to a spectral envelope curve */
-        vorbis_lsp_to_curve(out, s_blocksizes[s_dsp_state->W] / 2, info->barkmap, lsp, info->order, amp, info->ampdB,
+        vorbis_lsp_to_curve(out, m_blocksizes[m_dsp_state->W] / 2, info->barkmap, lsp, info->order, amp, info->ampdB,
                             info->rate >> 1);
         return (1);
     }
-    memset(out, 0, sizeof(*out) * s_blocksizes[s_dsp_state->W] / 2);
+    memset(out, 0, sizeof(*out) * m_blocksizes[m_dsp_state->W] / 2);
     return (0);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-int32_t floor1_inverse2(ps_ptr<vorbis_info_floor_t>& in, int32_t *fit_value, int32_t *out) {
+int32_t VORBISDecoder::floor1_inverse2(ps_ptr<vorbis_info_floor_t>& in, int32_t *fit_value, int32_t *out) {
     vorbis_info_floor_t *info = (vorbis_info_floor_t *)in.get();
 
-    int32_t               n = s_blocksizes[s_dsp_state->W] / 2;
+    int32_t               n = m_blocksizes[m_dsp_state->W] / 2;
     int32_t               j;
 
     if(fit_value) {
@@ -2479,7 +2429,7 @@ int32_t floor1_inverse2(ps_ptr<vorbis_info_floor_t>& in, int32_t *fit_value, int
     return (0);
 }
 //---------------------------------------------------------------------------------------------------------------------
-void render_line(int32_t n, int32_t x0, int32_t x1, int32_t y0, int32_t y1, int32_t *d) {
+void VORBISDecoder::render_line(int32_t n, int32_t x0, int32_t x1, int32_t y0, int32_t y1, int32_t *d) {
     int32_t dy = y1 - y0;
     int32_t adx = x1 - x0;
     int32_t ady = abs(dy);
@@ -2528,10 +2478,10 @@ const uint8_t MLOOP_2[64] = {
 const uint8_t MLOOP_3[8] = {0, 1, 2, 2, 3, 3, 3, 3};
 
 /* interpolated 1./sqrt(p) where .5 <= a < 1. (.100000... to .111111...) in 16.16 format returns in m.8 format */
-int32_t ADJUST_SQRT2[2] = {8192, 5792};
+const int32_t ADJUST_SQRT2[2] = {8192, 5792};
 
 //---------------------------------------------------------------------------------------------------------------------
-void vorbis_lsp_to_curve(int32_t *curve, int32_t n, int32_t ln, int32_t *lsp, int32_t m, int32_t amp, int32_t ampoffset,
+void VORBISDecoder::vorbis_lsp_to_curve(int32_t *curve, int32_t n, int32_t ln, int32_t *lsp, int32_t m, int32_t amp, int32_t ampoffset,
                          int32_t nyq) {
     /* 0 <= m < 256 */
 
@@ -2689,7 +2639,7 @@ void vorbis_lsp_to_curve(int32_t *curve, int32_t n, int32_t ln, int32_t *lsp, in
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* used in init only; interpolate the int32_t way */
-int32_t toBARK(int32_t n) {
+int32_t VORBISDecoder::toBARK(int32_t n) {
     int32_t i;
     for(i = 0; i < 54; i++)
         if(n >= barklook[i] && n < barklook[i + 1]) break;
@@ -2700,7 +2650,7 @@ int32_t toBARK(int32_t n) {
 //---------------------------------------------------------------------------------------------------------------------
 /* interpolated lookup based cos function, domain 0 to PI only */
 /* a is in 0.16 format, where 0==0, 2^^16-1==PI, return 0.14 */
-int32_t vorbis_coslook_i(int32_t a) {
+int32_t VORBISDecoder::vorbis_coslook_i(int32_t a) {
     int32_t i = a >> COS_LOOKUP_I_SHIFT;
     int32_t d = a & COS_LOOKUP_I_MASK;
     return COS_LOOKUP_I[i] - ((d * (COS_LOOKUP_I[i] - COS_LOOKUP_I[i + 1])) >> COS_LOOKUP_I_SHIFT);
@@ -2708,7 +2658,7 @@ int32_t vorbis_coslook_i(int32_t a) {
 //---------------------------------------------------------------------------------------------------------------------
 /* interpolated half-wave lookup based cos function */
 /* a is in 0.16 format, where 0==0, 2^^16==PI, return .LSP_FRACBITS */
-int32_t vorbis_coslook2_i(int32_t a) {
+int32_t VORBISDecoder::vorbis_coslook2_i(int32_t a) {
     int32_t i = a >> COS_LOOKUP_I_SHIFT;
     int32_t d = a & COS_LOOKUP_I_MASK;
     return ((COS_LOOKUP_I[i] << COS_LOOKUP_I_SHIFT) - d * (COS_LOOKUP_I[i] - COS_LOOKUP_I[i + 1])) >>
@@ -2718,13 +2668,13 @@ int32_t vorbis_coslook2_i(int32_t a) {
 /* interpolated lookup based fromdB function, domain -140dB to 0dB only */
 /* a is in n.12 format */
 
-int32_t vorbis_fromdBlook_i(int32_t a) {
+int32_t VORBISDecoder::vorbis_fromdBlook_i(int32_t a) {
     if(a > 0) return 0x7fffffff;
     if(a < -573440) return 0;  // replacement for if(a < (-140 << 12)) return 0;
     return FLOOR_fromdB_LOOKUP[((a + (140 << 12)) * 467) >> 20];
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t vorbis_invsqlook_i(int32_t a, int32_t e) {
+int32_t VORBISDecoder::vorbis_invsqlook_i(int32_t a, int32_t e) {
     int32_t i = (a & 0x7fff) >> (INVSQ_LOOKUP_I_SHIFT - 1);
     int32_t d = a & INVSQ_LOOKUP_I_MASK;                                /*  0.10 */
     int32_t val = INVSQ_LOOKUP_I[i] -                                   /*  1.16 */
@@ -2735,7 +2685,7 @@ int32_t vorbis_invsqlook_i(int32_t a, int32_t e) {
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* partial; doesn't perform last-step deinterleave/unrolling. That can be done more efficiently during pcm output */
-void mdct_backward(int32_t n, int32_t *in) {
+void VORBISDecoder::mdct_backward(int32_t n, int32_t *in) {
     int32_t shift;
     int32_t step;
 
@@ -2751,7 +2701,7 @@ void mdct_backward(int32_t n, int32_t *in) {
     mdct_step8(in, n, step);
 }
 //---------------------------------------------------------------------------------------------------------------------
-void presymmetry(int32_t *in, int32_t n2, int32_t step) {
+void VORBISDecoder::presymmetry(int32_t *in, int32_t n2, int32_t step) {
     int32_t       *aX;
     int32_t       *bX;
     const int32_t *T;
@@ -2793,7 +2743,7 @@ void presymmetry(int32_t *in, int32_t n2, int32_t step) {
     } while(aX >= in + n4);
 }
 //---------------------------------------------------------------------------------------------------------------------
-void mdct_butterflies(int32_t *x, int32_t points, int32_t shift) {
+void VORBISDecoder::mdct_butterflies(int32_t *x, int32_t points, int32_t shift) {
     int32_t stages = 8 - shift;
     int32_t i, j;
 
@@ -2805,7 +2755,7 @@ void mdct_butterflies(int32_t *x, int32_t points, int32_t shift) {
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* N/stage point generic N stage butterfly (in place, 2 register) */
-void mdct_butterfly_generic(int32_t *x, int32_t points, int32_t step) {
+void VORBISDecoder::mdct_butterfly_generic(int32_t *x, int32_t points, int32_t step) {
     const int32_t *T = sincos_lookup0;
     int32_t       *x1 = x + points - 4;
     int32_t       *x2 = x + (points >> 1) - 4;
@@ -2844,7 +2794,7 @@ void mdct_butterfly_generic(int32_t *x, int32_t points, int32_t step) {
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* 32 point butterfly (in place, 4 register) */
-void mdct_butterfly_32(int32_t *x) {
+void VORBISDecoder::mdct_butterfly_32(int32_t *x) {
     int32_t r0, r1, r2, r3;
 
     r0 = x[16] - x[17];
@@ -2900,7 +2850,7 @@ void mdct_butterfly_32(int32_t *x) {
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* 16 point butterfly (in place, 4 register) */
-void mdct_butterfly_16(int32_t *x) {
+void VORBISDecoder::mdct_butterfly_16(int32_t *x) {
     int32_t r0, r1, r2, r3;
 
     r0 = x[8] - x[9];
@@ -2934,7 +2884,7 @@ void mdct_butterfly_16(int32_t *x) {
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* 8 point butterfly (in place) */
-void mdct_butterfly_8(int32_t *x) {
+void VORBISDecoder::mdct_butterfly_8(int32_t *x) {
     int32_t r0 = x[0] + x[1];
     int32_t r1 = x[0] - x[1];
     int32_t r2 = x[2] + x[3];
@@ -2954,7 +2904,7 @@ void mdct_butterfly_8(int32_t *x) {
     x[7] = r6 + r2;
 }
 //---------------------------------------------------------------------------------------------------------------------
-void mdct_bitreverse(int32_t *x, int32_t n, int32_t shift) {
+void VORBISDecoder::mdct_bitreverse(int32_t *x, int32_t n, int32_t shift) {
     int32_t      bit = 0;
     int32_t *w = x + (n >> 1);
 
@@ -2977,12 +2927,12 @@ void mdct_bitreverse(int32_t *x, int32_t n, int32_t shift) {
     } while(w > x);
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t bitrev12(int32_t x) {
+int32_t VORBISDecoder::bitrev12(int32_t x) {
     uint8_t bitrev[16] = {0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15};
     return bitrev[x >> 8] | (bitrev[(x & 0x0f0) >> 4] << 4) | (((int32_t)bitrev[x & 0x00f]) << 8);
 }
 //---------------------------------------------------------------------------------------------------------------------
-void mdct_step7(int32_t *x, int32_t n, int32_t step) {
+void VORBISDecoder::mdct_step7(int32_t *x, int32_t n, int32_t step) {
     int32_t       *w0 = x;
     int32_t       *w1 = x + (n >> 1);
     const int32_t *T = (step >= 4) ? (sincos_lookup0 + (step >> 1)) : sincos_lookup1;
@@ -3027,7 +2977,7 @@ void mdct_step7(int32_t *x, int32_t n, int32_t step) {
     } while(w0 < w1);
 }
 //---------------------------------------------------------------------------------------------------------------------
-void mdct_step8(int32_t *x, int32_t n, int32_t step) {
+void VORBISDecoder::mdct_step8(int32_t *x, int32_t n, int32_t step) {
     const int32_t *T;
     const int32_t *V;
     int32_t       *iX = x + (n >> 1);
@@ -3112,7 +3062,7 @@ void mdct_step8(int32_t *x, int32_t n, int32_t step) {
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* decode vector / dim granularity guarding is done in the upper layer */
-int32_t vorbis_book_decodevv_add(codebook_t *book, int32_t **a, int32_t offset, uint8_t ch, int32_t n, int32_t point) {
+int32_t VORBISDecoder::vorbis_book_decodevv_add(codebook_t *book, int32_t **a, int32_t offset, uint8_t ch, int32_t n, int32_t point) {
     if(book->used_entries > 0) {
         int32_t *v = (int32_t *)alloca(sizeof(*v) * book->dim);
         int32_t  i;
@@ -3135,9 +3085,9 @@ int32_t vorbis_book_decodevv_add(codebook_t *book, int32_t **a, int32_t offset,
 }
 //---------------------------------------------------------------------------------------------------------------------
 /* pcm==0 indicates we just want the pending samples, no more */
-int32_t vorbis_dsp_pcmout(int16_t *outBuff, int32_t outBuffSize) {
-    if(s_dsp_state->out_begin > -1 && s_dsp_state->out_begin < s_dsp_state->out_end) {
-        int32_t n = s_dsp_state->out_end - s_dsp_state->out_begin;
+int32_t VORBISDecoder::vorbis_dsp_pcmout(int16_t *outBuff, int32_t outBuffSize) {
+    if(m_dsp_state->out_begin > -1 && m_dsp_state->out_begin < m_dsp_state->out_end) {
+        int32_t n = m_dsp_state->out_end - m_dsp_state->out_begin;
 
         if(outBuff) {
             int32_t i;
@@ -3145,14 +3095,14 @@ int32_t vorbis_dsp_pcmout(int16_t *outBuff, int32_t outBuffSize) {
                 n = outBuffSize;
                 VORBIS_LOG_ERROR("outBufferSize too small, must be min %i (int16_t) words", n);
             }
-            for(i = 0; i < s_vorbisChannels; i++){
-                mdct_unroll_lap(s_blocksizes[0], s_blocksizes[1],
-                                s_dsp_state->lW, s_dsp_state->W, s_dsp_state->work[i].get(),
-                                s_dsp_state->mdctright[i].get(), _vorbis_window(s_blocksizes[0] >> 1),
-                                _vorbis_window(s_blocksizes[1] >> 1),
-                                outBuff + i, s_vorbisChannels,
-                                s_dsp_state->out_begin,
-                                s_dsp_state->out_begin + n);
+            for(i = 0; i < m_vorbisChannels; i++){
+                mdct_unroll_lap(m_blocksizes[0], m_blocksizes[1],
+                                m_dsp_state->lW, m_dsp_state->W, m_dsp_state->work[i].get(),
+                                m_dsp_state->mdctright[i].get(), _vorbis_window(m_blocksizes[0] >> 1),
+                                _vorbis_window(m_blocksizes[1] >> 1),
+                                outBuff + i, m_vorbisChannels,
+                                m_dsp_state->out_begin,
+                                m_dsp_state->out_begin + n);
             }
         }
         return (n);
@@ -3160,7 +3110,7 @@ int32_t vorbis_dsp_pcmout(int16_t *outBuff, int32_t outBuffSize) {
     return (0);
 }
 //---------------------------------------------------------------------------------------------------------------------
-int32_t *_vorbis_window(int32_t left) {
+int32_t *VORBISDecoder::_vorbis_window(int32_t left) {
     switch(left) {
         case 32:
             return (int32_t *)vwin64;
@@ -3183,7 +3133,7 @@ int32_t *_vorbis_window(int32_t left) {
     }
 }
 //---------------------------------------------------------------------------------------------------------------------
-void mdct_unroll_lap(int32_t n0, int32_t n1, int32_t lW, int32_t W, int32_t *in, int32_t *right, const int32_t *w0, const int32_t *w1, int16_t *out,
+void VORBISDecoder::mdct_unroll_lap(int32_t n0, int32_t n1, int32_t lW, int32_t W, int32_t *in, int32_t *right, const int32_t *w0, const int32_t *w1, int16_t *out,
                      int32_t step, int32_t start, /* samples, this frame */
                      int32_t end /* samples, this frame */) {
     int32_t       *l = in + (W && lW ? n1 >> 1 : n0 >> 1);
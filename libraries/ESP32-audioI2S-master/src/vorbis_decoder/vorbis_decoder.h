@@ -159,6 +159,7 @@ typedef struct {  // mode
 typedef struct _vorbis_dsp_state{  // vorbis_dsp_state buffers the current vorbis audio analysis/synthesis state.
     ps_ptr<ps_ptr<int32_t>> work;
     ps_ptr<ps_ptr<int32_t>> mdctright;
+    int32_t    floormemo_size; // largest floor memo of the stream, elements per channel
     int32_t    lW = 0; // last window
     int32_t    W = 0;  // window
     int32_t    out_begin = -1;
@@ -216,100 +217,165 @@ inline int32_t CLIP_TO_15(int32_t x) {
 
 //----------------------------------------------------------------------------------------------------------------------
 
-// ogg impl
-bool                  VORBISDecoder_AllocateBuffers();
-void                  VORBISDecoder_FreeBuffers();
-void                  VORBISDecoder_ClearBuffers();
-void                  VORBISsetDefaults();
-void                  clearGlobalConfigurations();
-int32_t               VORBISDecode(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
-uint8_t               VORBISGetChannels();
-uint32_t              VORBISGetSampRate();
-uint32_t              VORBISGetAudioDataStart();
-uint8_t               VORBISGetBitsPerSample();
-uint32_t              VORBISGetBitRate();
-uint16_t              VORBISGetOutputSamps();
-char*                 VORBISgetStreamTitle();
-vector<uint32_t>      VORBISgetMetadataBlockPicture();
-int32_t               VORBISFindSyncWord(unsigned char* buf, int32_t nBytes);
-int32_t               VORBISparseOGG(uint8_t* inbuf, int32_t* bytesLeft);
-int32_t               vorbisDecodePage1(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength);
-int32_t               vorbisDecodePage2(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength);
-int32_t               vorbisDecodePage3(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength);
-int32_t               vorbisDecodePage4(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength, int16_t* outbuf);
-int32_t               parseVorbisComment(uint8_t* inbuf, int16_t nBytes);
-int32_t               parseVorbisCodebook();
-int32_t               parseVorbisFirstPacket(uint8_t* inbuf, int16_t nBytes);
-uint16_t              continuedOggPackets(uint8_t* inbuf);
-int32_t               vorbis_book_unpack(codebook_t* s);
-uint32_t              decpack(int32_t entry, int32_t used_entry, uint8_t quantvals, codebook_t* b, int32_t maptype);
-int32_t               oggpack_eop();
-ps_ptr<vorbis_info_floor_t> floor0_info_unpack();
-ps_ptr<vorbis_info_floor_t> floor1_info_unpack();
-void                  vorbis_mergesort(uint8_t *index, uint16_t *vals, uint16_t n);
-int32_t               res_unpack(vorbis_info_residue_t* info);
-int32_t               mapping_info_unpack(vorbis_info_mapping_t* info);
-
-// vorbis decoder impl
-int32_t               vorbis_dsp_synthesis(uint8_t* inbuf, uint16_t len, int16_t* outbuf);
-ps_ptr<vorbis_dsp_state_t> vorbis_dsp_create();
-void                  vorbis_dsp_destroy(ps_ptr<vorbis_dsp_state_t> &v);
-void                  vorbis_book_clear(ps_ptr<codebook_t> &v);
-void                  mdct_shift_right(int32_t n, int32_t* in, int32_t* right);
-int32_t               mapping_inverse(vorbis_info_mapping_t* info);
-int32_t               floor0_memosize(ps_ptr<vorbis_info_floor_t>& i);
-int32_t               floor1_memosize(ps_ptr<vorbis_info_floor_t>& i);
-int32_t*              floor0_inverse1(ps_ptr<vorbis_info_floor_t>& i, int32_t* lsp);
-int32_t*              floor1_inverse1(ps_ptr<vorbis_info_floor_t>& in, int32_t* fit_value);
-int32_t               vorbis_book_decode(codebook_t* book);
-int32_t               decode_packed_entry_number(codebook_t* book);
-int32_t               render_point(int32_t x0, int32_t x1, int32_t y0, int32_t y1, int32_t x);
-int32_t               vorbis_book_decodev_set(codebook_t* book, int32_t* a, int32_t n, int32_t point);
-int32_t               decode_map(codebook_t* s, int32_t* v, int32_t point);
-int32_t               res_inverse(vorbis_info_residue_t* info, int32_t** in, int32_t* nonzero, uint8_t ch);
-int32_t               vorbis_book_decodev_add(codebook_t* book, int32_t* a, int32_t n, int32_t point);
-int32_t               vorbis_book_decodevs_add(codebook_t* book, int32_t* a, int32_t n, int32_t point);
-int32_t               floor0_inverse2(ps_ptr<vorbis_info_floor_t>& i, int32_t* lsp, int32_t* out);
-int32_t               floor1_inverse2(ps_ptr<vorbis_info_floor_t>& in, int32_t* fit_value, int32_t* out);
-void                  render_line(int32_t n, int32_t x0, int32_t x1, int32_t y0, int32_t y1, int32_t* d);
-void                  vorbis_lsp_to_curve(int32_t* curve, int32_t n, int32_t ln, int32_t* lsp, int32_t m, int32_t amp, int32_t ampoffset, int32_t nyq);
-int32_t               toBARK(int32_t n);
-int32_t               vorbis_coslook_i(int32_t a);
-int32_t               vorbis_coslook2_i(int32_t a);
-int32_t               vorbis_fromdBlook_i(int32_t a);
-int32_t               vorbis_invsqlook_i(int32_t a, int32_t e);
-void                  mdct_backward(int32_t n, int32_t* in);
-void                  presymmetry(int32_t* in, int32_t n2, int32_t step);
-void                  mdct_butterflies(int32_t* x, int32_t points, int32_t shift);
-void                  mdct_butterfly_generic(int32_t* x, int32_t points, int32_t step);
-void                  mdct_butterfly_32(int32_t* x);
-void                  mdct_butterfly_16(int32_t* x);
-void                  mdct_butterfly_8(int32_t* x);
-void                  mdct_bitreverse(int32_t* x, int32_t n, int32_t shift);
-int32_t               bitrev12(int32_t x);
-void                  mdct_step7(int32_t* x, int32_t n, int32_t step);
-void                  mdct_step8(int32_t* x, int32_t n, int32_t step);
-int32_t               vorbis_book_decodevv_add(codebook_t* book, int32_t** a, int32_t offset, uint8_t ch, int32_t n, int32_t point);
-int32_t               vorbis_dsp_pcmout(int16_t* outBuff, int32_t outBuffSize);
-void                  mdct_unroll_lap(int32_t n0, int32_t n1, int32_t lW, int32_t W, int32_t* in, int32_t* right, const int32_t* w0, const int32_t* w1, int16_t* out, int32_t step, int32_t start, /* samples, this frame */
-                                int32_t end /* samples, this frame */);
-
-// some helper functions
-int32_t  VORBIS_specialIndexOf(uint8_t* base, const char* str, int32_t baselen, bool exact = false);
-void     bitReader_clear();
-void     bitReader_setData(uint8_t *buff, uint16_t buffSize);
-int32_t  bitReader(uint16_t bits);
-int32_t  bitReader_look(uint16_t nBits);
-int8_t   bitReader_adv(uint16_t bits);
-uint8_t  _ilog(uint32_t v);
-int32_t  ilog(uint32_t v);
-int32_t  _float32_unpack(int32_t val, int32_t *point);
-int32_t  _determine_node_bytes(uint32_t used, uint8_t leafwidth);
-int32_t  _determine_leaf_words(int32_t nodeb, int32_t leafwidth);
-int32_t  _make_decode_table(codebook_t *s, char *lengthlist, uint8_t quantvals, int32_t maptype);
-int32_t  _make_words(char *l, uint16_t n, uint32_t *r, uint8_t quantvals, codebook_t *b, int32_t maptype);
-uint8_t  _book_maptype1_quantvals(codebook_t *b);
-int32_t *_vorbis_window(int32_t left);
+// Decoder instance, all state of a stream lives in the object. Several instances can decode different streams
+// concurrently (e.g. in tasks on both cores), one instance must not be used by two tasks at the same time.
+class VORBISDecoder {
+public:
+    ~VORBISDecoder() { freeBuffers(); }
+    bool                  allocateBuffers();
+    void                  freeBuffers();
+    void                  clearBuffers();
+    int32_t               findSyncWord(unsigned char* buf, int32_t nBytes);
+    int32_t               decode(uint8_t* inbuf, int32_t* bytesLeft, int16_t* outbuf);
+    uint8_t               getChannels();
+    uint32_t              getSampRate();
+    uint8_t               getBitsPerSample();
+    uint32_t              getBitRate();
+    uint16_t              getOutputSamps();
+    uint32_t              getAudioDataStart();
+    char*                 getStreamTitle();
+    vector<uint32_t>      getMetadataBlockPicture();
+
+private:
+    void                  VORBISsetDefaults();
+    void                  clearGlobalConfigurations();
+    int32_t               VORBISparseOGG(uint8_t* inbuf, int32_t* bytesLeft);
+    int32_t               vorbisDecodePage1(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength);
+    int32_t               vorbisDecodePage2(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength);
+    int32_t               vorbisDecodePage3(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength);
+    int32_t               vorbisDecodePage4(uint8_t* inbuf, int32_t* bytesLeft, uint32_t segmentLength, int16_t* outbuf);
+    int32_t               parseVorbisComment(uint8_t* inbuf, int16_t nBytes);
+    int32_t               parseVorbisCodebook();
+    int32_t               parseVorbisFirstPacket(uint8_t* inbuf, int16_t nBytes);
+    uint16_t              continuedOggPackets(uint8_t* inbuf);
+    int32_t               vorbis_book_unpack(codebook_t* s);
+    uint32_t              decpack(int32_t entry, int32_t used_entry, uint8_t quantvals, codebook_t* b, int32_t maptype);
+    int32_t               oggpack_eop();
+    ps_ptr<vorbis_info_floor_t> floor0_info_unpack();
+    ps_ptr<vorbis_info_floor_t> floor1_info_unpack();
+    void                  vorbis_mergesort(uint8_t *index, uint16_t *vals, uint16_t n);
+    int32_t               res_unpack(vorbis_info_residue_t* info);
+    int32_t               mapping_info_unpack(vorbis_info_mapping_t* info);
+    // vorbis decoder impl
+    int32_t               vorbis_dsp_synthesis(uint8_t* inbuf, uint16_t len, int16_t* outbuf);
+    ps_ptr<vorbis_dsp_state_t> vorbis_dsp_create();
+    void                  vorbis_dsp_destroy(ps_ptr<vorbis_dsp_state_t> &v);
+    void                  vorbis_book_clear(ps_ptr<codebook_t> &v);
+    void                  mdct_shift_right(int32_t n, int32_t* in, int32_t* right);
+    int32_t               mapping_inverse(vorbis_info_mapping_t* info);
+    int32_t               floor0_memosize(ps_ptr<vorbis_info_floor_t>& i);
+    int32_t               floor1_memosize(ps_ptr<vorbis_info_floor_t>& i);
+    int32_t*              floor0_inverse1(ps_ptr<vorbis_info_floor_t>& i, int32_t* lsp);
+    int32_t*              floor1_inverse1(ps_ptr<vorbis_info_floor_t>& in, int32_t* fit_value);
+    int32_t               vorbis_book_decode(codebook_t* book);
+    int32_t               decode_packed_entry_number(codebook_t* book);
+    int32_t               render_point(int32_t x0, int32_t x1, int32_t y0, int32_t y1, int32_t x);
+    int32_t               vorbis_book_decodev_set(codebook_t* book, int32_t* a, int32_t n, int32_t point);
+    int32_t               decode_map(codebook_t* s, int32_t* v, int32_t point);
+    int32_t               res_inverse(vorbis_info_residue_t* info, int32_t** in, int32_t* nonzero, uint8_t ch);
+    int32_t               vorbis_book_decodev_add(codebook_t* book, int32_t* a, int32_t n, int32_t point);
+    int32_t               vorbis_book_decodevs_add(codebook_t* book, int32_t* a, int32_t n, int32_t point);
+    int32_t               floor0_inverse2(ps_ptr<vorbis_info_floor_t>& i, int32_t* lsp, int32_t* out);
+    int32_t               floor1_inverse2(ps_ptr<vorbis_info_floor_t>& in, int32_t* fit_value, int32_t* out);
+    void                  render_line(int32_t n, int32_t x0, int32_t x1, int32_t y0, int32_t y1, int32_t* d);
+    void                  vorbis_lsp_to_curve(int32_t* curve, int32_t n, int32_t ln, int32_t* lsp, int32_t m, int32_t amp, int32_t ampoffset, int32_t nyq);
+    int32_t               toBARK(int32_t n);
+    int32_t               vorbis_coslook_i(int32_t a);
+    int32_t               vorbis_coslook2_i(int32_t a);
+    int32_t               vorbis_fromdBlook_i(int32_t a);
+    int32_t               vorbis_invsqlook_i(int32_t a, int32_t e);
+    void                  mdct_backward(int32_t n, int32_t* in);
+    void                  presymmetry(int32_t* in, int32_t n2, int32_t step);
+    void                  mdct_butterflies(int32_t* x, int32_t points, int32_t shift);
+    void                  mdct_butterfly_generic(int32_t* x, int32_t points, int32_t step);
+    void                  mdct_butterfly_32(int32_t* x);
+    void                  mdct_butterfly_16(int32_t* x);
+    void                  mdct_butterfly_8(int32_t* x);
+    void                  mdct_bitreverse(int32_t* x, int32_t n, int32_t shift);
+    int32_t               bitrev12(int32_t x);
+    void                  mdct_step7(int32_t* x, int32_t n, int32_t step);
+    void                  mdct_step8(int32_t* x, int32_t n, int32_t step);
+    int32_t               vorbis_book_decodevv_add(codebook_t* book, int32_t** a, int32_t offset, uint8_t ch, int32_t n, int32_t point);
+    int32_t               vorbis_dsp_pcmout(int16_t* outBuff, int32_t outBuffSize);
+    void                  mdct_unroll_lap(int32_t n0, int32_t n1, int32_t lW, int32_t W, int32_t* in, int32_t* right, const int32_t* w0, const int32_t* w1, int16_t* out, int32_t step, int32_t start, /* samples, this frame */
+                                    int32_t end /* samples, this frame */);
+    // some helper functions
+    int32_t  VORBIS_specialIndexOf(uint8_t* base, const char* str, int32_t baselen, bool exact = false);
+    void     bitReader_clear();
+    void     bitReader_setData(uint8_t *buff, uint16_t buffSize);
+    int32_t  bitReader(uint16_t bits);
+    int32_t  bitReader_look(uint16_t nBits);
+    int8_t   bitReader_adv(uint16_t bits);
+    uint8_t  _ilog(uint32_t v);
+    int32_t  ilog(uint32_t v);
+    int32_t  _float32_unpack(int32_t val, int32_t *point);
+    int32_t  _determine_node_bytes(uint32_t used, uint8_t leafwidth);
+    int32_t  _determine_leaf_words(int32_t nodeb, int32_t leafwidth);
+    int32_t  _make_decode_table(codebook_t *s, char *lengthlist, uint8_t quantvals, int32_t maptype);
+    int32_t  _make_words(char *l, uint16_t n, uint32_t *r, uint8_t quantvals, codebook_t *b, int32_t maptype);
+    uint8_t  _book_maptype1_quantvals(codebook_t *b);
+    int32_t *_vorbis_window(int32_t left);
+
+    bool      m_f_vorbisNewSteamTitle = false;  // streamTitle
+    bool      m_f_vorbisNewMetadataBlockPicture = false;
+    bool      m_f_oggFirstPage = false;
+    bool      m_f_oggContinuedPage = false;
+    bool      m_f_oggLastPage = false;
+    bool      m_f_parseOggDone = true;
+    bool      m_f_lastSegmentTable = false;
+    bool      m_f_vorbisStr_found = false;
+    uint16_t  m_identificatonHeaderLength = 0;
+    uint16_t  m_vorbisCommentHeaderLength = 0;
+    uint16_t  m_setupHeaderLength = 0;
+    uint8_t   m_pageNr = 0;
+    uint16_t  m_oggHeaderSize = 0;
+    uint8_t   m_vorbisChannels = 0;
+    uint16_t  m_vorbisSamplerate = 0;
+    uint16_t  m_lastSegmentTableLen = 0;
+
+    uint32_t  m_vorbisBitRate = 0;
+    uint32_t  m_vorbisSegmentLength = 0;
+    uint32_t  m_vorbisBlockPicLenUntilFrameEnd = 0;
+    uint32_t  m_vorbisCurrentFilePos = 0;
+    uint32_t  m_vorbisAudioDataStart = 0;
+
+    int32_t   m_vorbisValidSamples = 0;
+    int32_t   m_commentBlockSegmentSize = 0;
+    uint8_t   m_vorbisOldMode = 0;
+    uint32_t  m_blocksizes[2] = {};
+    uint32_t  m_vorbisBlockPicPos = 0;
+    uint32_t  m_vorbisBlockPicLen = 0;
+    int32_t   m_vorbisRemainBlockPicLen = 0;
+    int32_t   m_commentLength = 0;
+
+    uint8_t   m_nrOfCodebooks = 0;
+    uint8_t   m_nrOfFloors = 0;
+    uint8_t   m_nrOfResidues = 0;
+    uint8_t   m_nrOfMaps = 0;
+    uint8_t   m_nrOfModes = 0;
+
+    uint16_t  m_oggPage3Len = 0; // length of the current audio segment
+    uint8_t   m_vorbisSegmentTableSize = 0;
+    int16_t   m_vorbisSegmentTableRdPtr = -1;
+    int8_t    m_vorbisError = 0;
+    float     m_vorbisCompressionRatio = 0;
+
+    bitReader_t            m_bitReader = {};
+
+    ps_ptr<char>                  m_vorbisChbuf;
+    ps_ptr<uint8_t>               m_lastSegmentTable;
+    ps_ptr<uint16_t>              m_vorbisSegmentTable;
+    ps_ptr<codebook_t>            m_codebooks;
+    ps_ptr<ps_ptr<vorbis_info_floor_t>> m_floor_param;
+    ps_ptr<int8_t>                m_floor_type;
+    ps_ptr<vorbis_info_residue_t> m_residue_param;
+    ps_ptr<vorbis_info_mapping_t> m_map_param;
+    ps_ptr<vorbis_info_mode_t>    m_mode_param;
+    ps_ptr<vorbis_dsp_state_t>    m_dsp_state;
+    ps_scratch                    m_scratch;       // temporary arrays of mapping_inverse(), sized in vorbis_dsp_create()
+
+    vector<uint32_t>              m_vorbisBlockPicItem;
+};
 
 // —————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————————
     // 📌📌📌  L O G G I N G   📌📌📌
@@ -144,7 +144,35 @@
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
  *However the opened images might consume additional RAM.
  *0: to disable caching*/
-#define LV_IMG_CACHE_DEF_SIZE 0
+#define LV_IMG_CACHE_DEF_SIZE 16
+
+/*Limit the memory used by the decoded images in the image cache [bytes].
+ *If it's exceeded the least valuable images are closed. Images drawn directly from C arrays don't count.
+ *0: limit only the number of images (LV_IMG_CACHE_DEF_SIZE)*/
+#define LV_IMG_CACHE_DEF_MAX_BYTES (128U * 1024U)
+
+/*Allocators for the image data copied by the image cache to the internal or external RAM.
+ *See `lv_img_cache_set_mem_hint_cb()`. If disabled `lv_mem_alloc()` is used for both.*/
+#define LV_IMG_CACHE_MEM_CUSTOM 1
+#if LV_IMG_CACHE_MEM_CUSTOM
+    #define LV_IMG_CACHE_MEM_CUSTOM_INCLUDE <esp_heap_caps.h>
+    #define LV_IMG_CACHE_MEM_INT_ALLOC(size) heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+    #define LV_IMG_CACHE_MEM_INT_FREE heap_caps_free
+    #define LV_IMG_CACHE_MEM_EXT_ALLOC(size) heap_caps_malloc(size, MALLOC_CAP_SPIRAM)
+    #define LV_IMG_CACHE_MEM_EXT_FREE heap_caps_free
+#endif
+
+/*Number of resolved style properties to cache.
+ *`lv_obj_get_style_prop()` is called many times for every object in each frame and it
+ *searches all the styles of the object (and its parents for inherited properties).
+ *The cache stores the final values by object, part, state and property.
+ *It's invalidated when a style, the state or the parent of an object changes.
+ *A visible widget uses about 30..50 entries, so the size should follow the number of widgets on the screen.
+ *Must be a power of 2. An entry uses 20 bytes on 32 bit systems (placed with `LV_ATTRIBUTE_LARGE_RAM_ARRAY`).
+ *0: to disable caching
+ *With lvgl/tests/bench/style_bench the panel's screen was not faster with 1024 entries than with 256,
+ *so 256 entries (5 kB of internal RAM) are used*/
+#define LV_STYLE_CACHE_SIZE 256
 
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
@@ -286,6 +314,16 @@
 /*1: Draw random colored rectangles over the redrawn areas*/
 #define LV_USE_REFR_DEBUG 0
 
+/*1: Record the duration of the rendering stages into a ring buffer
+ *which can be exported as Chrome trace JSON or as a binary dump over Serial. See `lv_profiler.h`*/
+#define LV_USE_PROFILER 0
+#if LV_USE_PROFILER
+    #define LV_PROFILER_BUF_SIZE 1024
+    #define LV_PROFILER_TICK_CUSTOM 1
+    #define LV_PROFILER_TICK_CUSTOM_INCLUDE "Arduino.h"
+    #define LV_PROFILER_TICK_CUSTOM_SYS_TIME_EXPR (micros())
+#endif
+
 /*Change the built in (v)snprintf functions*/
 #define LV_SPRINTF_CUSTOM 0
 #if LV_SPRINTF_CUSTOM
@@ -401,6 +439,17 @@
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
 
+/*Number of (font, letter) -> glyph ID lookups to cache for the built-in font format.
+ *Finding a glyph needs a search in the character maps, which is done twice for each letter (the letter and the kerning).
+ *Must be a power of 2. 0: cache only the last letter of each font*/
+#define LV_FONT_CMAP_CACHE_SIZE 64
+
+/*Memory to cache the decompressed glyph bitmaps of compressed fonts [bytes]. Requires `LV_USE_FONT_COMPRESSED`.
+ *The glyphs are stored as 8 bpp (A8) bitmaps so they are decompressed only once.
+ *The least recently used glyphs are freed if the limit is reached.
+ *0: disable the cache*/
+#define LV_FONT_GLYPH_CACHE_SIZE 0
+
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 0
 #if LV_USE_FONT_SUBPX
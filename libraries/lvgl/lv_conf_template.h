@@ -146,6 +146,32 @@
  *0: to disable caching*/
 #define LV_IMG_CACHE_DEF_SIZE 0
 
+/*Limit the memory used by the decoded images in the image cache [bytes].
+ *If it's exceeded the least valuable images are closed. Images drawn directly from C arrays don't count.
+ *0: limit only the number of images (LV_IMG_CACHE_DEF_SIZE)*/
+#define LV_IMG_CACHE_DEF_MAX_BYTES 0
+
+/*Allocators for the image data copied by the image cache to the internal or external RAM.
+ *See `lv_img_cache_set_mem_hint_cb()`. If disabled `lv_mem_alloc()` is used for both.*/
+#define LV_IMG_CACHE_MEM_CUSTOM 0
+#if LV_IMG_CACHE_MEM_CUSTOM
+    #define LV_IMG_CACHE_MEM_CUSTOM_INCLUDE <stdlib.h>
+    #define LV_IMG_CACHE_MEM_INT_ALLOC malloc
+    #define LV_IMG_CACHE_MEM_INT_FREE free
+    #define LV_IMG_CACHE_MEM_EXT_ALLOC malloc
+    #define LV_IMG_CACHE_MEM_EXT_FREE free
+#endif
+
+/*Number of resolved style properties to cache.
+ *`lv_obj_get_style_prop()` is called many times for every object in each frame and it
+ *searches all the styles of the object (and its parents for inherited properties).
+ *The cache stores the final values by object, part, state and property.
+ *It's invalidated when a style, the state or the parent of an object changes.
+ *A visible widget uses about 30..50 entries, so the size should follow the number of widgets on the screen.
+ *Must be a power of 2. An entry uses 20 bytes on 32 bit systems (placed with `LV_ATTRIBUTE_LARGE_RAM_ARRAY`).
+ *0: to disable caching*/
+#define LV_STYLE_CACHE_SIZE 0
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS 2
@@ -294,6 +320,22 @@
 /*1: Draw random colored rectangles over the redrawn areas*/
 #define LV_USE_REFR_DEBUG 0
 
+/*1: Record the duration of the rendering stages (layout, objects, masks, blending, flush)
+ *into a ring buffer which can be exported as Chrome trace JSON or as a binary dump.
+ *See `lv_profiler.h`*/
+#define LV_USE_PROFILER 0
+#if LV_USE_PROFILER
+    /*Number of records in the ring buffer. Must be a power of 2*/
+    #define LV_PROFILER_BUF_SIZE 1024
+
+    /*Use a custom microsecond time source instead of `lv_tick_get() * 1000`*/
+    #define LV_PROFILER_TICK_CUSTOM 0
+    #if LV_PROFILER_TICK_CUSTOM
+        #define LV_PROFILER_TICK_CUSTOM_INCLUDE "Arduino.h"         /*Header for the time function*/
+        #define LV_PROFILER_TICK_CUSTOM_SYS_TIME_EXPR (micros())    /*Expression evaluating to current time in us*/
+    #endif
+#endif
+
 /*Change the built in (v)snprintf functions*/
 #define LV_SPRINTF_CUSTOM 0
 #if LV_SPRINTF_CUSTOM
@@ -409,6 +451,17 @@
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
 
+/*Number of (font, letter) -> glyph ID lookups to cache for the built-in font format.
+ *Finding a glyph needs a search in the character maps, which is done twice for each letter (the letter and the kerning).
+ *Must be a power of 2. 0: cache only the last letter of each font*/
+#define LV_FONT_CMAP_CACHE_SIZE 0
+
+/*Memory to cache the decompressed glyph bitmaps of compressed fonts [bytes]. Requires `LV_USE_FONT_COMPRESSED`.
+ *The glyphs are stored as 8 bpp (A8) bitmaps so they are decompressed only once.
+ *The least recently used glyphs are freed if the limit is reached.
+ *0: disable the cache*/
+#define LV_FONT_GLYPH_CACHE_SIZE 0
+
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 0
 #if LV_USE_FONT_SUBPX
@@ -0,0 +1,51 @@
+#!/usr/bin/env python3
+
+'''
+Converts the binary dump of `lv_profiler_export_binary()` to Chrome trace-event JSON.
+The result can be opened in chrome://tracing or https://ui.perfetto.dev
+
+Usage: profiler_bin_to_trace.py dump.bin [trace.json]
+'''
+
+import json
+import struct
+import sys
+
+EVENT_NAMES = ["refr", "layout", "refr_obj", "mask", "blend", "flush"]
+
+
+def convert(data):
+    magic, version, rec_size, cnt, dropped = struct.unpack_from("<4sHHII", data, 0)
+    if magic != b"LVPR":
+        raise ValueError("Not an LVGL profiler dump")
+    if version != 1:
+        raise ValueError("Unsupported version: %d" % version)
+
+    events = []
+    offset = 16
+    for _ in range(cnt):
+        start, dur, obj, cls, event = struct.unpack_from("<IIIIB", data, offset)
+        offset += rec_size
+        name = EVENT_NAMES[event] if event < len(EVENT_NAMES) else "unknown"
+        e = {"name": name, "cat": "lvgl", "ph": "X", "ts": start, "dur": dur, "pid": 0, "tid": 0}
+        if obj:
+            e["args"] = {"obj": "0x%08x" % obj, "class": "0x%08x" % cls}
+        events.append(e)
+
+    return {"traceEvents": events, "displayTimeUnit": "ms", "otherData": {"dropped": dropped}}
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__, file=sys.stderr)
+        exit(1)
+
+    with open(sys.argv[1], "rb") as f:
+        trace = convert(f.read())
+
+    out = open(sys.argv[2], "w") if len(sys.argv) > 2 else sys.stdout
+    json.dump(trace, out)
+
+
+if __name__ == "__main__":
+    main()
@@ -21,6 +21,7 @@
 #include "../misc/lv_gc.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_log.h"
+#include "../misc/lv_profiler.h"
 #include "../hal/lv_hal.h"
 #include "../extra/lv_extra.h"
 #include <stdint.h>
@@ -114,6 +115,10 @@ void lv_init(void)
 
     _lv_anim_core_init();
 
+#if LV_USE_PROFILER
+    _lv_profiler_init();
+#endif
+
     _lv_group_init();
 
     lv_draw_init();
@@ -144,6 +149,8 @@ void lv_init(void)
     /*Initialize the screen refresh system*/
     _lv_refr_init();
 
+    _lv_font_fmt_txt_init();
+
     _lv_img_decoder_init();
 #if LV_IMG_CACHE_DEF_SIZE
     lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
@@ -889,6 +896,7 @@ static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
 
     lv_state_t prev_state = obj->state;
     obj->state = new_state;
+    _lv_style_cache_invalidate();    /*The inherited values of the children might be changed too*/
 
     _lv_style_state_cmp_t cmp_res = _lv_obj_style_state_compare(obj, prev_state, new_state);
     /*If there is no difference in styles there is nothing else to do*/
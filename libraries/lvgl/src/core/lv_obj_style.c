@@ -15,6 +15,13 @@
  *********************/
 #define MY_CLASS &lv_obj_class
 
+#if LV_STYLE_CACHE_SIZE
+    #if (LV_STYLE_CACHE_SIZE & (LV_STYLE_CACHE_SIZE - 1)) != 0 || LV_STYLE_CACHE_SIZE < 2
+        #error "LV_STYLE_CACHE_SIZE must be a power of 2 and at least 2"
+    #endif
+    #define STYLE_CACHE_MASK (LV_STYLE_CACHE_SIZE - 1)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,6 +42,17 @@ typedef enum {
     CACHE_NEED_CHECK = 4,
 } cache_t;
 
+#if LV_STYLE_CACHE_SIZE
+typedef struct {
+    const lv_obj_t * obj;
+    uint32_t version;           /*Value of `_lv_style_cache_get_version()` when the entry was saved*/
+    lv_style_value_t value;
+    lv_style_prop_t prop;
+    lv_state_t state;
+    uint8_t part;               /*`lv_part_t >> 16`*/
+} style_cache_entry_t;
+#endif
+
 /**********************
  *  GLOBAL PROTOTYPES
  **********************/
@@ -45,6 +63,7 @@ typedef enum {
 static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector);
 static _lv_obj_style_t * get_trans_style(lv_obj_t * obj, uint32_t part);
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v);
+static lv_style_value_t get_prop_resolved(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, bool * cacheable);
 static void report_style_change_core(void * style, lv_obj_t * obj);
 static void refresh_children_style(lv_obj_t * obj);
 static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, trans_t * tr_limit);
@@ -59,6 +78,10 @@ static void fade_in_anim_ready(lv_anim_t * a);
  *  STATIC VARIABLES
  **********************/
 static bool style_refr = true;
+#if LV_STYLE_CACHE_SIZE
+    static LV_ATTRIBUTE_LARGE_RAM_ARRAY style_cache_entry_t style_cache[LV_STYLE_CACHE_SIZE];
+    static uint32_t style_cache_version;
+#endif
 
 /**********************
  *      MACROS
@@ -71,6 +94,10 @@ static bool style_refr = true;
 void _lv_obj_style_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_obj_style_trans_ll), sizeof(trans_t));
+#if LV_STYLE_CACHE_SIZE
+    lv_memset_00(style_cache, sizeof(style_cache));
+    style_cache_version = _lv_style_cache_get_version();
+#endif
 }
 
 void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t selector)
@@ -145,6 +172,7 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
         /*The style from the current `i` index is removed, so `i` points to the next style.
          *Therefore it doesn't needs to be incremented*/
     }
+    if(deleted) _lv_style_cache_invalidate();
     if(deleted && prop != LV_STYLE_PROP_INV) {
         lv_obj_refresh_style(obj, part, prop);
     }
@@ -168,6 +196,9 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*Even if the refresh is disabled the cached values are outdated*/
+    _lv_style_cache_invalidate();
+
     if(!style_refr) return;
 
     lv_obj_invalidate(obj);
@@ -222,49 +253,48 @@ void lv_obj_enable_style_refresh(bool en)
 
 lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
 {
-    lv_style_value_t value_act;
-    bool inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
-    lv_style_res_t found = LV_STYLE_RES_NOT_FOUND;
-    while(obj) {
-        found = get_prop_core(obj, part, prop, &value_act);
-        if(found == LV_STYLE_RES_FOUND) break;
-        if(!inheritable) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(found != LV_STYLE_RES_INHERIT && part != LV_PART_MAIN) {
-            part = LV_PART_MAIN;
-            continue;
-        }
+    bool cacheable;
+#if LV_STYLE_CACHE_SIZE
+    /*Objects with `skip_trans` are drawn temporarily in an other state. Don't use the cache for them.*/
+    if(obj->skip_trans) return get_prop_resolved(obj, part, prop, &cacheable);
 
-        /*Check the parent too.*/
-        obj = lv_obj_get_parent(obj);
+    uint32_t version = _lv_style_cache_get_version();
+    if(version < style_cache_version) {
+        /*The version counter has overflown. The entries with the same version might be outdated.*/
+        lv_memset_00(style_cache, sizeof(style_cache));
     }
+    style_cache_version = version;
 
-    if(found != LV_STYLE_RES_FOUND) {
-        if(part == LV_PART_MAIN && (prop == LV_STYLE_WIDTH || prop == LV_STYLE_HEIGHT)) {
-            const lv_obj_class_t * cls = obj->class_p;
-            while(cls) {
-                if(prop == LV_STYLE_WIDTH) {
-                    if(cls->width_def != 0) break;
-                }
-                else {
-                    if(cls->height_def != 0) break;
-                }
-                cls = cls->base_class;
-            }
+    lv_state_t state = obj->state;
+    uint8_t part_id = (uint8_t)(part >> 16);
+    uint32_t h = (uint32_t)((lv_uintptr_t)obj >> 3) ^ ((uint32_t)prop << 16) ^ ((uint32_t)part_id << 8) ^ state;
+    h *= 0x9E3779B1;
+    h ^= h >> 16;
 
-            if(cls) {
-                value_act.num = prop == LV_STYLE_WIDTH ? cls->width_def : cls->height_def;
-            }
-            else {
-                value_act.num = 0;
-            }
-        }
-        else {
-            value_act = lv_style_prop_get_default(prop);
+    /*2-way set associative: check both entries of the set*/
+    style_cache_entry_t * e = &style_cache[h & STYLE_CACHE_MASK & ~1U];
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        if(e[i].obj == obj && e[i].version == version && e[i].prop == prop && e[i].part == part_id && e[i].state == state) {
+            return e[i].value;
         }
     }
-    return value_act;
+
+    lv_style_value_t v = get_prop_resolved(obj, part, prop, &cacheable);
+    if(cacheable) {
+        /*Replace an outdated entry or a pseudo-random one*/
+        if(e[0].version == version) e += e[1].version == version ? (h >> 16) & 1 : 1;
+        e->obj = obj;
+        e->version = version;
+        e->value = v;
+        e->prop = prop;
+        e->part = part_id;
+        e->state = state;
+    }
+    return v;
+#else
+    return get_prop_resolved(obj, part, prop, &cacheable);
+#endif
 }
 
 void lv_obj_set_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_style_value_t value,
@@ -603,6 +633,63 @@ static _lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t se
 }
 
 
+/**
+ * Get the value of a style property by checking the styles of the object and its parents
+ * @param obj       pointer to an object
+ * @param part      a part of the object
+ * @param prop      the property
+ * @param cacheable set to false if an object in the inheritance chain was checked in a temporary state
+ * @return          the value of the property
+ */
+static lv_style_value_t get_prop_resolved(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, bool * cacheable)
+{
+    lv_style_value_t value_act;
+    *cacheable = true;
+    bool inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
+    lv_style_res_t found = LV_STYLE_RES_NOT_FOUND;
+    while(obj) {
+        if(obj->skip_trans) *cacheable = false;
+        found = get_prop_core(obj, part, prop, &value_act);
+        if(found == LV_STYLE_RES_FOUND) break;
+        if(!inheritable) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(found != LV_STYLE_RES_INHERIT && part != LV_PART_MAIN) {
+            part = LV_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        obj = lv_obj_get_parent(obj);
+    }
+
+    if(found != LV_STYLE_RES_FOUND) {
+        if(part == LV_PART_MAIN && (prop == LV_STYLE_WIDTH || prop == LV_STYLE_HEIGHT)) {
+            const lv_obj_class_t * cls = obj->class_p;
+            while(cls) {
+                if(prop == LV_STYLE_WIDTH) {
+                    if(cls->width_def != 0) break;
+                }
+                else {
+                    if(cls->height_def != 0) break;
+                }
+                cls = cls->base_class;
+            }
+
+            if(cls) {
+                value_act.num = prop == LV_STYLE_WIDTH ? cls->width_def : cls->height_def;
+            }
+            else {
+                value_act.num = 0;
+            }
+        }
+        else {
+            value_act = lv_style_prop_get_default(prop);
+        }
+    }
+    return value_act;
+}
+
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v)
 {
     uint8_t group = 1 << _lv_style_get_prop_group(prop);
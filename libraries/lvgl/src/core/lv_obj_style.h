@@ -122,6 +122,7 @@ void lv_obj_enable_style_refresh(bool en);
  * Get the value of a style property. The current state of the object will be considered.
  * Inherited properties will be inherited.
  * If a property is not set a default value will be returned.
+ * If `LV_STYLE_CACHE_SIZE > 0` the resolved values are cached until a style, state or parent changes.
  * @param obj       pointer to an object
  * @param part      a part from which the property should be get
  * @param prop      the property to get
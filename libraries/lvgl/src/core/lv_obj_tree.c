@@ -166,6 +166,7 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     parent->spec_attr->children[lv_obj_get_child_cnt(parent) - 1] = obj;
 
     obj->parent = parent;
+    _lv_style_cache_invalidate();   /*The inherited style properties might be different*/
 
     /*Notify the original parent because one of its children is lost*/
     lv_obj_scrollbar_invalidate(old_parent);
@@ -384,6 +385,9 @@ static void obj_del_core(lv_obj_t * obj)
     /*All children deleted. Now clean up the object specific data*/
     _lv_obj_destruct(obj);
 
+    /*A new object might be created at the same address. Don't let it see the cached styles of this object.*/
+    _lv_style_cache_invalidate();
+
     /*Remove the screen for the screen list*/
     if(obj->parent == NULL) {
         lv_disp_t * disp = lv_obj_get_disp(obj);
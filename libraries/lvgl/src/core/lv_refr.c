@@ -15,6 +15,7 @@
 #include "../misc/lv_mem.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_profiler.h"
 #include "../draw/lv_draw.h"
 #include "../font/lv_font_fmt_txt.h"
 #include "../extra/others/snapshot/lv_snapshot.h"
@@ -287,6 +288,7 @@ void _lv_refr_set_disp_refreshing(lv_disp_t * disp)
 void _lv_disp_refr_timer(lv_timer_t * tmr)
 {
     REFR_TRACE("begin");
+    LV_PROFILER_BEGIN(LV_PROFILER_EVENT_REFR, refr_ts);
 
     uint32_t start = lv_tick_get();
     volatile uint32_t elaps = 0;
@@ -306,17 +308,20 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     }
 
     /*Refresh the screen's layout if required*/
+    LV_PROFILER_BEGIN(LV_PROFILER_EVENT_LAYOUT, layout_ts);
     lv_obj_update_layout(disp_refr->act_scr);
     if(disp_refr->prev_scr) lv_obj_update_layout(disp_refr->prev_scr);
 
     lv_obj_update_layout(disp_refr->top_layer);
     lv_obj_update_layout(disp_refr->sys_layer);
+    LV_PROFILER_END(LV_PROFILER_EVENT_LAYOUT, layout_ts, NULL, NULL);
 
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
         disp_refr->inv_p = 0;
         LV_LOG_WARN("there is no active screen");
         REFR_TRACE("finished");
+        LV_PROFILER_END(LV_PROFILER_EVENT_REFR, refr_ts, NULL, NULL);
         return;
     }
 
@@ -449,6 +454,7 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
 #endif
 
     REFR_TRACE("finished");
+    LV_PROFILER_END(LV_PROFILER_EVENT_REFR, refr_ts, NULL, NULL);
 }
 
 #if LV_USE_PERF_MONITOR
@@ -969,6 +975,7 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 {
     /*Do not refresh hidden objects*/
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+    LV_PROFILER_BEGIN(LV_PROFILER_EVENT_REFR_OBJ, obj_ts);
     lv_layer_type_t layer_type = _lv_obj_get_layer_type(obj);
     if(layer_type == LV_LAYER_TYPE_NONE) {
         lv_obj_redraw(draw_ctx, obj);
@@ -1048,6 +1055,7 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 
         lv_draw_layer_destroy(draw_ctx, layer_ctx);
     }
+    LV_PROFILER_END(LV_PROFILER_EVENT_REFR_OBJ, obj_ts, obj, obj->class_p);
 }
 
 
@@ -1271,6 +1279,7 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
  */
 static void draw_buf_flush(lv_disp_t * disp)
 {
+    LV_PROFILER_BEGIN(LV_PROFILER_EVENT_FLUSH, flush_ts);
     lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
 
     /*Flush the rendered content to the display*/
@@ -1310,6 +1319,7 @@ static void draw_buf_flush(lv_disp_t * disp)
         else
             draw_buf->buf_act = draw_buf->buf1;
     }
+    LV_PROFILER_END(LV_PROFILER_EVENT_FLUSH, flush_ts, NULL, NULL);
 }
 
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
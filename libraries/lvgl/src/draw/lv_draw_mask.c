@@ -12,6 +12,7 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_assert.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_profiler.h"
 
 /*********************
  *      DEFINES
@@ -526,7 +527,9 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
 
     param->circle = entry;
 
+    LV_PROFILER_BEGIN(LV_PROFILER_EVENT_MASK, mask_ts);
     circ_calc_aa4(param->circle, radius);
+    LV_PROFILER_END(LV_PROFILER_EVENT_MASK, mask_ts, NULL, NULL);
 }
 
 /**
@@ -570,6 +573,7 @@ void lv_draw_mask_polygon_init(lv_draw_mask_polygon_param_t * param, const lv_po
     /*Join adjacent points if they are on the same coordinate*/
     lv_point_t * p = lv_mem_alloc(point_cnt * sizeof(lv_point_t));
     if(p == NULL) return;
+    LV_PROFILER_BEGIN(LV_PROFILER_EVENT_MASK, mask_ts);
     uint16_t i;
     uint16_t pcnt = 0;
     p[0] = points[0];
@@ -588,6 +592,7 @@ void lv_draw_mask_polygon_init(lv_draw_mask_polygon_param_t * param, const lv_po
     param->cfg.point_cnt = pcnt;
     param->dsc.cb = (lv_draw_mask_xcb_t)lv_draw_mask_polygon;
     param->dsc.type = LV_DRAW_MASK_TYPE_POLYGON;
+    LV_PROFILER_END(LV_PROFILER_EVENT_MASK, mask_ts, NULL, NULL);
 }
 
 /**********************
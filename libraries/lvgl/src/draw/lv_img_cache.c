@@ -13,19 +13,30 @@
 #include "../hal/lv_hal_tick.h"
 #include "../misc/lv_gc.h"
 
+#if LV_IMG_CACHE_MEM_CUSTOM
+    #include LV_IMG_CACHE_MEM_CUSTOM_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
-/*Decrement life with this value on every open*/
-#define LV_IMG_CACHE_AGING 1
-
 /*Boost life by this factor (multiply time_to_open with this value)*/
 #define LV_IMG_CACHE_LIFE_GAIN 1
 
-/*Don't let life to be greater than this limit because it would require a lot of time to
+/*Don't let life to be greater than the clock + this limit because it would require a lot of time to
  * "die" from very high values*/
 #define LV_IMG_CACHE_LIFE_LIMIT 1000
 
+/*Marks the end of a hash bucket's list*/
+#define HASH_END 0xFFFF
+
+#if LV_IMG_CACHE_MEM_CUSTOM == 0
+    #define LV_IMG_CACHE_MEM_INT_ALLOC lv_mem_alloc
+    #define LV_IMG_CACHE_MEM_INT_FREE  lv_mem_free
+    #define LV_IMG_CACHE_MEM_EXT_ALLOC lv_mem_alloc
+    #define LV_IMG_CACHE_MEM_EXT_FREE  lv_mem_free
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,6 +46,13 @@
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static bool lv_img_cache_match(const void * src1, const void * src2);
+    static uint32_t get_hash(const void * src, lv_color_t color, int32_t frame_id);
+    static void hash_remove(_lv_img_cache_entry_t * entry);
+    static void entry_close(_lv_img_cache_entry_t * entry);
+    static void entry_relocate(_lv_img_cache_entry_t * entry);
+    static uint32_t get_decoded_size(const lv_img_decoder_dsc_t * dsc);
+    static _lv_img_cache_entry_t * get_weakest(const _lv_img_cache_entry_t * except, bool use_empty);
+    static void set_life(_lv_img_cache_entry_t * entry);
 #endif
 
 /**********************
@@ -42,6 +60,12 @@
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static uint16_t entry_cnt;
+    static uint16_t * hash_table;   /*Index of the first entry in each bucket. Allocated after the entries.*/
+    static uint32_t hash_mask;
+    static uint32_t life_clock;     /*Life of the last closed entry*/
+    static uint32_t used_bytes;
+    static uint32_t max_bytes = LV_IMG_CACHE_DEF_MAX_BYTES;
+    static lv_img_cache_mem_hint_cb_t mem_hint_cb;
 #endif
 
 /**********************
@@ -73,43 +97,31 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
 
     _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
 
-    /*Decrement all lifes. Make the entries older*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
-        }
-    }
-
-    for(i = 0; i < entry_cnt; i++) {
-        if(color.full == cache[i].dec_dsc.color.full &&
+    uint32_t hash = get_hash(src, color, frame_id);
+    uint16_t i = hash_table[hash & hash_mask];
+    while(i != HASH_END) {
+        if(cache[i].hash == hash &&
+           color.full == cache[i].dec_dsc.color.full &&
            frame_id == cache[i].dec_dsc.frame_id &&
            lv_img_cache_match(src, cache[i].dec_dsc.src)) {
             /*If opened increment its life.
              *Image difficult to open should live longer to keep avoid frequent their recaching.
              *Therefore increase `life` with `time_to_open`*/
             cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
+            set_life(cached_src);
             LV_LOG_TRACE("image source found in the cache");
-            break;
+            return cached_src;
         }
+        i = cache[i].hash_next;
     }
 
-    /*The image is not cached then cache it now*/
-    if(cached_src) return cached_src;
-
-    /*Find an entry to reuse. Select the entry with the least life*/
-    cached_src = &cache[0];
-    for(i = 1; i < entry_cnt; i++) {
-        if(cache[i].life < cached_src->life) {
-            cached_src = &cache[i];
-        }
-    }
+    /*The image is not cached then cache it now.
+     *Use an empty entry or the entry with the least life*/
+    cached_src = get_weakest(NULL, true);
 
     /*Close the decoder to reuse if it was opened (has a valid source)*/
     if(cached_src->dec_dsc.src) {
-        lv_img_decoder_close(&cached_src->dec_dsc);
+        entry_close(cached_src);
         LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
     }
     else {
@@ -124,12 +136,9 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
     if(open_res == LV_RES_INV) {
         LV_LOG_WARN("Image draw cannot open the image resource");
         lv_memset_00(cached_src, sizeof(_lv_img_cache_entry_t));
-        cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its us*/
         return NULL;
     }
 
-    cached_src->life = 0;
-
     /*If `time_to_open` was not set in the open function set it here*/
     if(cached_src->dec_dsc.time_to_open == 0) {
         cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
@@ -137,6 +146,28 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
 
     if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
 
+#if LV_IMG_CACHE_DEF_SIZE
+    cached_src->mem = LV_IMG_CACHE_MEM_DECODER;
+    entry_relocate(cached_src);
+    cached_src->size = get_decoded_size(&cached_src->dec_dsc);
+    used_bytes += cached_src->size;
+    set_life(cached_src);
+
+    cached_src->hash = hash;
+    cached_src->hash_next = hash_table[hash & hash_mask];
+    hash_table[hash & hash_mask] = (uint16_t)(cached_src - cache);
+
+    /*Close the least valuable images while the memory limit is exceeded.
+     *The new image is kept even if it's larger than the limit because it's about to be drawn.*/
+    while(max_bytes && used_bytes > max_bytes) {
+        _lv_img_cache_entry_t * weakest = get_weakest(cached_src, false);
+        if(weakest == NULL) break;
+        entry_close(weakest);
+        lv_memset_00(weakest, sizeof(_lv_img_cache_entry_t));
+        LV_LOG_INFO("image draw: memory limit reached, close an entry");
+    }
+#endif
+
     return cached_src;
 }
 
@@ -158,17 +189,66 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
         lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
     }
 
-    /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(_lv_img_cache_entry_t) * new_entry_cnt);
+    entry_cnt = 0;
+    hash_table = NULL;
+    used_bytes = 0;
+    life_clock = 0;
+
+    /*The last index is reserved to mark the end of the buckets*/
+    if(new_entry_cnt >= HASH_END) new_entry_cnt = HASH_END - 1;
+
+    /*Use at least as many buckets as entries*/
+    uint32_t bucket_cnt = 1;
+    while(bucket_cnt < new_entry_cnt) bucket_cnt <<= 1;
+
+    /*Reallocate the cache. The hash table is stored after the entries.*/
+    size_t entries_size = sizeof(_lv_img_cache_entry_t) * new_entry_cnt;
+    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(entries_size + bucket_cnt * sizeof(uint16_t));
     LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_img_cache_array));
     if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
-        entry_cnt = 0;
         return;
     }
     entry_cnt = new_entry_cnt;
+    hash_table = (uint16_t *)((uint8_t *)LV_GC_ROOT(_lv_img_cache_array) + entries_size);
+    hash_mask = bucket_cnt - 1;
 
     /*Clean the cache*/
-    lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entry_cnt * sizeof(_lv_img_cache_entry_t));
+    lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entries_size);
+    lv_memset_ff(hash_table, bucket_cnt * sizeof(uint16_t));
+#endif
+}
+
+void lv_img_cache_set_max_bytes(uint32_t new_max_bytes)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(new_max_bytes);
+    LV_LOG_WARN("Can't set the memory limit because the cache is disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+#else
+    max_bytes = new_max_bytes;
+    while(max_bytes && used_bytes > max_bytes) {
+        _lv_img_cache_entry_t * weakest = get_weakest(NULL, false);
+        if(weakest == NULL) break;
+        entry_close(weakest);
+        lv_memset_00(weakest, sizeof(_lv_img_cache_entry_t));
+    }
+#endif
+}
+
+uint32_t lv_img_cache_get_used_bytes(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    return used_bytes;
+#else
+    return 0;
+#endif
+}
+
+void lv_img_cache_set_mem_hint_cb(lv_img_cache_mem_hint_cb_t cb)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    mem_hint_cb = cb;
+#else
+    LV_UNUSED(cb);
 #endif
 }
 
@@ -183,11 +263,12 @@ void lv_img_cache_invalidate_src(const void * src)
 #if LV_IMG_CACHE_DEF_SIZE
     _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
 
+    /*The color and the frame ID is not known so all the entries are checked*/
     uint16_t i;
     for(i = 0; i < entry_cnt; i++) {
         if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
             if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
+                entry_close(&cache[i]);
             }
 
             lv_memset_00(&cache[i], sizeof(_lv_img_cache_entry_t));
@@ -212,4 +293,140 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
         return false;
     return strcmp(src1, src2) == 0;
 }
+
+/**
+ * FNV-1a hash of the image source (the path of files, the address of variables), the color and the frame ID
+ */
+static uint32_t get_hash(const void * src, lv_color_t color, int32_t frame_id)
+{
+    uint32_t h = 2166136261U;
+    if(lv_img_src_get_type(src) == LV_IMG_SRC_FILE) {
+        const uint8_t * s = src;
+        while(*s) {
+            h = (h ^ *s) * 16777619U;
+            s++;
+        }
+    }
+    else {
+        lv_uintptr_t p = (lv_uintptr_t)src;
+        uint32_t i;
+        for(i = 0; i < sizeof(p); i++) {
+            h = (h ^ (uint8_t)p) * 16777619U;
+            p >>= 8;
+        }
+    }
+
+    h = (h ^ (uint32_t)color.full) * 16777619U;
+    h = (h ^ (uint32_t)frame_id) * 16777619U;
+    return h;
+}
+
+static void hash_remove(_lv_img_cache_entry_t * entry)
+{
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint16_t id = (uint16_t)(entry - cache);
+    uint16_t * next_p = &hash_table[entry->hash & hash_mask];
+    while(*next_p != HASH_END) {
+        if(*next_p == id) {
+            *next_p = entry->hash_next;
+            return;
+        }
+        next_p = &cache[*next_p].hash_next;
+    }
+}
+
+/**
+ * Close the image of an entry and remove it from the hash table. The entry is not cleared.
+ */
+static void entry_close(_lv_img_cache_entry_t * entry)
+{
+    hash_remove(entry);
+    used_bytes -= entry->size;
+
+    if(entry->mem == LV_IMG_CACHE_MEM_DECODER) {
+        lv_img_decoder_close(&entry->dec_dsc);
+        return;
+    }
+
+    /*The decoder was closed when the data was copied. Free the copy and the path which was kept.*/
+    if(entry->mem == LV_IMG_CACHE_MEM_INTERNAL) LV_IMG_CACHE_MEM_INT_FREE((void *)entry->dec_dsc.img_data);
+    else LV_IMG_CACHE_MEM_EXT_FREE((void *)entry->dec_dsc.img_data);
+    entry->dec_dsc.img_data = NULL;
+
+    if(entry->dec_dsc.src_type == LV_IMG_SRC_FILE) {
+        lv_mem_free((void *)entry->dec_dsc.src);
+        entry->dec_dsc.src = NULL;
+    }
+}
+
+/**
+ * Copy the data of a fully decoded image to the memory requested by `mem_hint_cb` and close the decoder.
+ */
+static void entry_relocate(_lv_img_cache_entry_t * entry)
+{
+    lv_img_decoder_dsc_t * dsc = &entry->dec_dsc;
+    if(mem_hint_cb == NULL || dsc->img_data == NULL) return;
+
+    lv_img_cache_mem_t mem = mem_hint_cb(dsc);
+    if(mem == LV_IMG_CACHE_MEM_DECODER) return;
+
+    uint32_t size = lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf);
+    if(size == 0) return;
+
+    uint8_t * data = mem == LV_IMG_CACHE_MEM_INTERNAL ? LV_IMG_CACHE_MEM_INT_ALLOC(size) : LV_IMG_CACHE_MEM_EXT_ALLOC(size);
+    if(data == NULL) {
+        LV_LOG_WARN("image cache: couldn't allocate %" LV_PRIu32 " bytes, keep the decoder's data", size);
+        return;
+    }
+    lv_memcpy(data, dsc->img_data, size);
+
+    /*Close only the decoder and keep the source because it's used to find the entry*/
+    if(dsc->decoder->close_cb) dsc->decoder->close_cb(dsc->decoder, dsc);
+    dsc->img_data = data;
+    dsc->user_data = NULL;
+    entry->mem = mem;
+}
+
+/**
+ * Get the memory used by a decoded image. Images used directly from a C array don't use extra memory.
+ */
+static uint32_t get_decoded_size(const lv_img_decoder_dsc_t * dsc)
+{
+    if(dsc->img_data == NULL) return 0;
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE && dsc->img_data == ((const lv_img_dsc_t *)dsc->src)->data) return 0;
+
+    return lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf);
+}
+
+/**
+ * Find an empty entry or the opened entry with the least life
+ * @param except    don't return this entry
+ * @param use_empty true: return an empty entry if there is any; false: consider only the opened entries
+ * @return          the entry to reuse or NULL if there is no such entry
+ */
+static _lv_img_cache_entry_t * get_weakest(const _lv_img_cache_entry_t * except, bool use_empty)
+{
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    _lv_img_cache_entry_t * weakest = NULL;
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        if(&cache[i] == except) continue;
+        if(cache[i].dec_dsc.src == NULL) {
+            if(use_empty) return &cache[i];
+            continue;
+        }
+        /*The lives are in [clock, clock + LIFE_LIMIT] so compare relative to the clock to handle the overflow*/
+        if(weakest == NULL || cache[i].life - life_clock < weakest->life - life_clock) weakest = &cache[i];
+    }
+
+    if(weakest) life_clock = weakest->life;
+    return weakest;
+}
+
+static void set_life(_lv_img_cache_entry_t * entry)
+{
+    uint32_t gain = entry->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
+    if(gain > LV_IMG_CACHE_LIFE_LIMIT) gain = LV_IMG_CACHE_LIFE_LIMIT;
+    entry->life = life_clock + gain;
+}
 #endif
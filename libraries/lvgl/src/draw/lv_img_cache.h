@@ -23,6 +23,17 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/**
+ * Where to keep the data of a cached image
+ */
+enum {
+    LV_IMG_CACHE_MEM_DECODER,   /**< Keep the data where the decoder has put it (e.g. the flash for C arrays)*/
+    LV_IMG_CACHE_MEM_INTERNAL,  /**< Copy the data to the internal (fast) RAM*/
+    LV_IMG_CACHE_MEM_EXTERNAL,  /**< Copy the data to the external (large) RAM, e.g. PSRAM*/
+};
+
+typedef uint8_t lv_img_cache_mem_t;
+
 /**
  * When loading images from the network it can take a long time to download and decode the image.
  *
@@ -31,12 +42,23 @@ extern "C" {
 typedef struct {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information*/
 
-    /** Count the cache entries's life. Add `time_to_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused*/
-    int32_t life;
+    /** Value of the entry. When the entry is used it's set to the "clock" of the cache + `time_to_open`.
+     * If an image needs to be closed the entry with the lowest life is selected and the clock is set to its life.
+     * This way the rarely used and quick to open images are closed first.*/
+    uint32_t life;
+
+    uint32_t size;              /**< Memory used by the decoded image [bytes]*/
+    uint32_t hash;              /**< Hash of the source, color and frame ID*/
+    uint16_t hash_next;         /**< Index of the next entry in the same hash bucket*/
+    lv_img_cache_mem_t mem;     /**< Where the image data is. If not `LV_IMG_CACHE_MEM_DECODER` the decoder is already closed*/
 } _lv_img_cache_entry_t;
 
+/**
+ * Tell where to keep the data of an image in the cache.
+ * Called when a fully decoded image (`dsc->img_data != NULL`) is added to the cache.
+ */
+typedef lv_img_cache_mem_t (*lv_img_cache_mem_hint_cb_t)(const lv_img_decoder_dsc_t * dsc);
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -60,6 +82,29 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
  */
 void lv_img_cache_set_size(uint16_t new_slot_num);
 
+/**
+ * Limit the memory used by the decoded images of the cache.
+ * If the limit is exceeded the least valuable images are closed.
+ * Images whose data is used directly from the source (e.g. C arrays) don't count.
+ * @param max_bytes     the limit in bytes or 0 to limit only the number of images
+ */
+void lv_img_cache_set_max_bytes(uint32_t max_bytes);
+
+/**
+ * Get the memory used by the decoded images of the cache
+ * @return the used memory in bytes
+ */
+uint32_t lv_img_cache_get_used_bytes(void);
+
+/**
+ * Set a callback to tell where to keep the data of the cached images.
+ * E.g. small, frequently drawn images can be copied from the flash to the internal RAM
+ * and the large decoded images can be kept in PSRAM.
+ * The memories are allocated with `LV_IMG_CACHE_MEM_INT/EXT_ALLOC` (see `lv_conf.h`).
+ * @param cb    the callback or NULL to keep the data where the decoder has put it
+ */
+void lv_img_cache_set_mem_hint_cb(lv_img_cache_mem_hint_cb_t cb);
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
@@ -10,6 +10,7 @@
 #include "../../misc/lv_math.h"
 #include "../../hal/lv_hal_disp.h"
 #include "../../core/lv_refr.h"
+#include "../../misc/lv_profiler.h"
 
 /*********************
  *      DEFINES
@@ -104,7 +105,9 @@ void lv_draw_sw_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * d
 
     if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
 
+    LV_PROFILER_BEGIN(LV_PROFILER_EVENT_BLEND, blend_ts);
     ((lv_draw_sw_ctx_t *)draw_ctx)->blend(draw_ctx, dsc);
+    LV_PROFILER_END(LV_PROFILER_EVENT_BLEND, blend_ts, NULL, NULL);
 }
 
 void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx,
@@ -15,9 +15,25 @@
 #include "../misc/lv_utils.h"
 #include "../misc/lv_mem.h"
 
+#include <string.h>
+
 /*********************
  *      DEFINES
  *********************/
+#if (LV_FONT_CMAP_CACHE_SIZE & (LV_FONT_CMAP_CACHE_SIZE - 1)) != 0
+    #error "LV_FONT_CMAP_CACHE_SIZE must be a power of 2"
+#endif
+
+/*Only the glyphs of compressed fonts are cached as the others can be drawn directly*/
+#define GLYPH_CACHE_ENABLED (LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_SIZE)
+
+/*Number of hash buckets of the glyph bitmap cache. Must be a power of 2.*/
+#define GLYPH_CACHE_BUCKETS 64
+
+/*Don't cache larger glyphs to not flush the whole cache with a few large letters*/
+#define GLYPH_CACHE_MAX_ENTRY_SIZE (LV_FONT_GLYPH_CACHE_SIZE / 4)
+
+#define GLYPH_CACHE_ALIGN(x) (((x) + sizeof(lv_uintptr_t) - 1) & ~(sizeof(lv_uintptr_t) - 1))
 
 /**********************
  *      TYPEDEFS
@@ -28,6 +44,25 @@ typedef enum {
     RLE_STATE_COUNTER,
 } rle_state_t;
 
+#if LV_FONT_CMAP_CACHE_SIZE
+typedef struct {
+    const lv_font_fmt_txt_dsc_t * fdsc;     /*NULL if the entry is empty*/
+    uint32_t letter;
+    uint32_t glyph_id;
+} cmap_cache_entry_t;
+#endif
+
+#if GLYPH_CACHE_ENABLED
+/*The entries are stored one after the other in `glyph_cache_mem`, each followed by its A8 bitmap*/
+typedef struct _glyph_cache_entry_t {
+    struct _glyph_cache_entry_t * hash_next;    /*The next entry in the same hash bucket*/
+    const lv_font_fmt_txt_dsc_t * fdsc;         /*NULL if the entry is about to be removed*/
+    uint32_t letter;
+    uint32_t last_used;                         /*`glyph_use_cnt` when the glyph was used last time*/
+    uint32_t size;                              /*Size of the entry with the bitmap, aligned*/
+} glyph_cache_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -37,8 +72,21 @@ static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
 
+#if LV_FONT_CMAP_CACHE_SIZE || GLYPH_CACHE_ENABLED
+    static uint32_t get_hash(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
+#endif
+
+#if GLYPH_CACHE_ENABLED
+    static glyph_cache_entry_t ** get_glyph_bucket(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
+    static bool glyph_cacheable(const lv_font_t * font, const lv_font_fmt_txt_glyph_dsc_t * gdsc);
+    static const uint8_t * glyph_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter,
+                                           const lv_font_fmt_txt_glyph_dsc_t * gdsc);
+    static void glyph_cache_compact(void);
+#endif
+
 #if LV_USE_FONT_COMPRESSED
-    static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp, bool prefilter);
+    static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp, bool prefilter,
+                           bool a8);
     static inline void decompress_line(uint8_t * out, lv_coord_t w);
     static inline uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len);
     static inline void bits_write(uint8_t * out, uint32_t bit_pos, uint8_t val, uint8_t len);
@@ -58,6 +106,17 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static rle_state_t rle_state;
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_CMAP_CACHE_SIZE
+    static cmap_cache_entry_t cmap_cache[LV_FONT_CMAP_CACHE_SIZE];
+#endif
+
+#if GLYPH_CACHE_ENABLED
+    static LV_ATTRIBUTE_LARGE_RAM_ARRAY lv_uintptr_t glyph_cache_mem[LV_FONT_GLYPH_CACHE_SIZE / sizeof(lv_uintptr_t)];
+    static uint32_t glyph_cache_used;   /*The entries are in the first `glyph_cache_used` bytes*/
+    static glyph_cache_entry_t * glyph_buckets[GLYPH_CACHE_BUCKETS];
+    static uint32_t glyph_use_cnt;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -78,7 +137,8 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
  */
 const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unicode_letter)
 {
-    if(unicode_letter == '\t') unicode_letter = ' ';
+    bool is_tab = unicode_letter == '\t';
+    if(is_tab) unicode_letter = ' ';
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
     uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
@@ -86,6 +146,15 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
 
     const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
 
+#if GLYPH_CACHE_ENABLED
+    /*Must be the same condition as in `lv_font_get_glyph_dsc_fmt_txt` which reports the A8 format*/
+    if(!is_tab && glyph_cacheable(font, gdsc)) {
+        return glyph_cache_get(fdsc, unicode_letter, gdsc);
+    }
+#else
+    LV_UNUSED(is_tab);
+#endif
+
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
         return &fdsc->glyph_bitmap[gdsc->bitmap_index];
     }
@@ -125,7 +194,7 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
 
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
         decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
-                   (uint8_t)fdsc->bpp, prefilter);
+                   (uint8_t)fdsc->bpp, prefilter, false);
         return LV_GC_ROOT(_lv_font_decompr_buf);
 #else /*!LV_USE_FONT_COMPRESSED*/
         LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
@@ -186,6 +255,11 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
 
     if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
 
+#if GLYPH_CACHE_ENABLED
+    /*The cached glyphs are decoded to A8*/
+    if(!is_tab && glyph_cacheable(font, gdsc)) dsc_out->bpp = 8;
+#endif
+
     return true;
 }
 
@@ -202,6 +276,42 @@ void _lv_font_clean_up_fmt_txt(void)
 #endif
 }
 
+void _lv_font_fmt_txt_init(void)
+{
+#if LV_FONT_CMAP_CACHE_SIZE
+    lv_memset_00(cmap_cache, sizeof(cmap_cache));
+#endif
+
+#if GLYPH_CACHE_ENABLED
+    glyph_cache_used = 0;
+    glyph_use_cnt = 0;
+    lv_memset_00(glyph_buckets, sizeof(glyph_buckets));
+#endif
+}
+
+void lv_font_fmt_txt_cache_invalidate(const lv_font_t * font)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = font ? font->dsc : NULL;
+    LV_UNUSED(fdsc);
+
+#if LV_FONT_CMAP_CACHE_SIZE
+    uint32_t i;
+    for(i = 0; i < LV_FONT_CMAP_CACHE_SIZE; i++) {
+        if(fdsc == NULL || cmap_cache[i].fdsc == fdsc) cmap_cache[i].fdsc = NULL;
+    }
+#endif
+
+#if GLYPH_CACHE_ENABLED
+    uint32_t ofs;
+    for(ofs = 0; ofs < glyph_cache_used;) {
+        glyph_cache_entry_t * entry = (glyph_cache_entry_t *)((uint8_t *)glyph_cache_mem + ofs);
+        if(fdsc == NULL || entry->fdsc == fdsc) entry->fdsc = NULL;
+        ofs += entry->size;
+    }
+    glyph_cache_compact();
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -215,13 +325,18 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
     /*Check the cache first*/
     if(fdsc->cache && letter == fdsc->cache->last_letter) return fdsc->cache->last_glyph_id;
 
+#if LV_FONT_CMAP_CACHE_SIZE
+    cmap_cache_entry_t * cmap_entry = &cmap_cache[get_hash(fdsc, letter) & (LV_FONT_CMAP_CACHE_SIZE - 1)];
+    if(cmap_entry->fdsc == fdsc && cmap_entry->letter == letter) return cmap_entry->glyph_id;
+#endif
+
+    uint32_t glyph_id = 0;
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
         /*Relative code point*/
         uint32_t rcp = letter - fdsc->cmaps[i].range_start;
         if(rcp > fdsc->cmaps[i].range_length) continue;
-        uint32_t glyph_id = 0;
         if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
             glyph_id = fdsc->cmaps[i].glyph_id_start + rcp;
         }
@@ -251,20 +366,22 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             }
         }
 
-        /*Update the cache*/
-        if(fdsc->cache) {
-            fdsc->cache->last_letter = letter;
-            fdsc->cache->last_glyph_id = glyph_id;
-        }
-        return glyph_id;
+        break;
     }
 
+    /*Update the caches*/
     if(fdsc->cache) {
         fdsc->cache->last_letter = letter;
-        fdsc->cache->last_glyph_id = 0;
+        fdsc->cache->last_glyph_id = glyph_id;
     }
-    return 0;
 
+#if LV_FONT_CMAP_CACHE_SIZE
+    cmap_entry->fdsc = fdsc;
+    cmap_entry->letter = letter;
+    cmap_entry->glyph_id = glyph_id;
+#endif
+
+    return glyph_id;
 }
 
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
@@ -344,6 +461,118 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element)
     else return (int32_t) ref16_p[1] - element16_p[1];
 }
 
+#if LV_FONT_CMAP_CACHE_SIZE || GLYPH_CACHE_ENABLED
+static uint32_t get_hash(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
+    uint32_t h = ((uint32_t)((lv_uintptr_t)fdsc >> 2) ^ letter) * 0x9E3779B1;
+    return h ^ (h >> 16);
+}
+#endif
+
+#if GLYPH_CACHE_ENABLED
+static glyph_cache_entry_t ** get_glyph_bucket(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
+    return &glyph_buckets[get_hash(fdsc, letter) & (GLYPH_CACHE_BUCKETS - 1)];
+}
+
+/**
+ * Tell if a glyph's bitmap should be decompressed to A8 and cached
+ */
+static bool glyph_cacheable(const lv_font_t * font, const lv_font_fmt_txt_glyph_dsc_t * gdsc)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) return false;
+    if(fdsc->bpp >= 8) return false;
+    if(font->subpx != LV_FONT_SUBPX_NONE) return false;
+
+    uint32_t px_cnt = (uint32_t)gdsc->box_w * gdsc->box_h;
+    if(px_cnt == 0) return false;
+    return GLYPH_CACHE_ALIGN(sizeof(glyph_cache_entry_t) + px_cnt) <= GLYPH_CACHE_MAX_ENTRY_SIZE;
+}
+
+/**
+ * Get the A8 bitmap of a glyph from the cache or decode and cache it now.
+ * If there is no free space the least recently used glyphs are removed.
+ */
+static const uint8_t * glyph_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter,
+                                       const lv_font_fmt_txt_glyph_dsc_t * gdsc)
+{
+    glyph_use_cnt++;
+
+    glyph_cache_entry_t * entry = *get_glyph_bucket(fdsc, letter);
+    while(entry) {
+        if(entry->fdsc == fdsc && entry->letter == letter) {
+            entry->last_used = glyph_use_cnt;
+            return (const uint8_t *)(entry + 1);
+        }
+        entry = entry->hash_next;
+    }
+
+    uint32_t size = GLYPH_CACHE_ALIGN(sizeof(glyph_cache_entry_t) + (uint32_t)gdsc->box_w * gdsc->box_h);
+    if(glyph_cache_used + size > sizeof(glyph_cache_mem)) {
+        /*Mark the least recently used glyphs until there is enough space and remove them at once*/
+        uint32_t free_size = sizeof(glyph_cache_mem) - glyph_cache_used;
+        while(free_size < size) {
+            glyph_cache_entry_t * oldest = NULL;
+            uint32_t ofs;
+            for(ofs = 0; ofs < glyph_cache_used;) {
+                glyph_cache_entry_t * e = (glyph_cache_entry_t *)((uint8_t *)glyph_cache_mem + ofs);
+                if(e->fdsc && (oldest == NULL || glyph_use_cnt - e->last_used > glyph_use_cnt - oldest->last_used)) {
+                    oldest = e;
+                }
+                ofs += e->size;
+            }
+            oldest->fdsc = NULL;
+            free_size += oldest->size;
+        }
+        glyph_cache_compact();
+    }
+
+    entry = (glyph_cache_entry_t *)((uint8_t *)glyph_cache_mem + glyph_cache_used);
+    glyph_cache_used += size;
+
+    glyph_cache_entry_t ** bucket = get_glyph_bucket(fdsc, letter);
+    entry->hash_next = *bucket;
+    *bucket = entry;
+    entry->fdsc = fdsc;
+    entry->letter = letter;
+    entry->last_used = glyph_use_cnt;
+    entry->size = size;
+
+    uint8_t * bitmap = (uint8_t *)(entry + 1);
+    bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
+    decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap, gdsc->box_w, gdsc->box_h, (uint8_t)fdsc->bpp,
+               prefilter, true);
+    return bitmap;
+}
+
+/**
+ * Remove the entries whose `fdsc` is NULL by moving the others to their place and rebuild the hash table
+ */
+static void glyph_cache_compact(void)
+{
+    uint8_t * mem = (uint8_t *)glyph_cache_mem;
+    uint32_t rd = 0;
+    uint32_t wr = 0;
+
+    lv_memset_00(glyph_buckets, sizeof(glyph_buckets));
+    while(rd < glyph_cache_used) {
+        glyph_cache_entry_t * entry = (glyph_cache_entry_t *)(mem + rd);
+        uint32_t size = entry->size;
+        if(entry->fdsc) {
+            if(wr != rd) memmove(mem + wr, mem + rd, size);
+            entry = (glyph_cache_entry_t *)(mem + wr);
+            glyph_cache_entry_t ** bucket = get_glyph_bucket(entry->fdsc, entry->letter);
+            entry->hash_next = *bucket;
+            *bucket = entry;
+            wr += size;
+        }
+        rd += size;
+    }
+    glyph_cache_used = wr;
+}
+#endif /*GLYPH_CACHE_ENABLED*/
+
 #if LV_USE_FONT_COMPRESSED
 /**
  * The compress a glyph's bitmap
@@ -352,13 +581,28 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element)
  * @param px_num number of pixels in the glyph (width * height)
  * @param bpp bit per pixel (bpp = 3 will be converted to bpp = 4)
  * @param prefilter true: the lines are XORed
+ * @param a8 true: write one byte per pixel scaled to 0..255 instead of `bpp` bits (only for bpp < 8)
  */
-static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp, bool prefilter)
+static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp, bool prefilter,
+                       bool a8)
 {
     uint32_t wrp = 0;
     uint8_t wr_size = bpp;
     if(bpp == 3) wr_size = 4;
 
+    /*With A8 output every pixel is written to a whole byte.
+     *Map the values to the same opacities the letter drawing uses for `bpp` bit pixels.*/
+    uint8_t a8_map[16];
+    if(a8) {
+        uint8_t i;
+        for(i = 0; i < (1 << bpp); i++) {
+            uint8_t v = 0;
+            bits_write(&v, 0, i, bpp);
+            a8_map[i] = (v >> (8 - wr_size)) * (255 / ((1 << wr_size) - 1));
+        }
+        wr_size = 8;
+    }
+
     rle_init(in, bpp);
 
     uint8_t * line_buf1 = lv_mem_buf_get(w);
@@ -375,7 +619,8 @@ static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord
     lv_coord_t x;
 
     for(x = 0; x < w; x++) {
-        bits_write(out, wrp, line_buf1[x], bpp);
+        if(a8) out[wrp >> 3] = a8_map[line_buf1[x]];
+        else bits_write(out, wrp, line_buf1[x], bpp);
         wrp += wr_size;
     }
 
@@ -385,7 +630,8 @@ static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord
 
             for(x = 0; x < w; x++) {
                 line_buf1[x] = line_buf2[x] ^ line_buf1[x];
-                bits_write(out, wrp, line_buf1[x], bpp);
+                if(a8) out[wrp >> 3] = a8_map[line_buf1[x]];
+                else bits_write(out, wrp, line_buf1[x], bpp);
                 wrp += wr_size;
             }
         }
@@ -393,7 +639,8 @@ static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord
             decompress_line(line_buf1, w);
 
             for(x = 0; x < w; x++) {
-                bits_write(out, wrp, line_buf1[x], bpp);
+                if(a8) out[wrp >> 3] = a8_map[line_buf1[x]];
+                else bits_write(out, wrp, line_buf1[x], bpp);
                 wrp += wr_size;
             }
         }
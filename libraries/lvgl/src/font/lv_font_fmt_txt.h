@@ -225,6 +225,18 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+/**
+ * Initialize the glyph ID and bitmap caches of the built-in font format.
+ */
+void _lv_font_fmt_txt_init(void);
+
+/**
+ * Remove the glyphs of a font from the glyph ID and bitmap caches.
+ * Needs to be called before a font created at run time is freed.
+ * @param font      pointer to a font or NULL to remove all glyphs
+ */
+void lv_font_fmt_txt_cache_invalidate(const lv_font_t * font);
+
 /**********************
  *      MACROS
  **********************/
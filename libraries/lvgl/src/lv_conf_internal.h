@@ -356,6 +356,80 @@
     #endif
 #endif
 
+/*Limit the memory used by the decoded images in the image cache [bytes].
+ *If it's exceeded the least valuable images are closed. Images drawn directly from C arrays don't count.
+ *0: limit only the number of images (LV_IMG_CACHE_DEF_SIZE)*/
+#ifndef LV_IMG_CACHE_DEF_MAX_BYTES
+    #ifdef CONFIG_LV_IMG_CACHE_DEF_MAX_BYTES
+        #define LV_IMG_CACHE_DEF_MAX_BYTES CONFIG_LV_IMG_CACHE_DEF_MAX_BYTES
+    #else
+        #define LV_IMG_CACHE_DEF_MAX_BYTES 0
+    #endif
+#endif
+
+/*Allocators for the image data copied by the image cache to the internal or external RAM.
+ *See `lv_img_cache_set_mem_hint_cb()`. If disabled `lv_mem_alloc()` is used for both.*/
+#ifndef LV_IMG_CACHE_MEM_CUSTOM
+    #ifdef CONFIG_LV_IMG_CACHE_MEM_CUSTOM
+        #define LV_IMG_CACHE_MEM_CUSTOM CONFIG_LV_IMG_CACHE_MEM_CUSTOM
+    #else
+        #define LV_IMG_CACHE_MEM_CUSTOM 0
+    #endif
+#endif
+#if LV_IMG_CACHE_MEM_CUSTOM
+    #ifndef LV_IMG_CACHE_MEM_CUSTOM_INCLUDE
+        #ifdef CONFIG_LV_IMG_CACHE_MEM_CUSTOM_INCLUDE
+            #define LV_IMG_CACHE_MEM_CUSTOM_INCLUDE CONFIG_LV_IMG_CACHE_MEM_CUSTOM_INCLUDE
+        #else
+            #define LV_IMG_CACHE_MEM_CUSTOM_INCLUDE <stdlib.h>
+        #endif
+    #endif
+    #ifndef LV_IMG_CACHE_MEM_INT_ALLOC
+        #ifdef CONFIG_LV_IMG_CACHE_MEM_INT_ALLOC
+            #define LV_IMG_CACHE_MEM_INT_ALLOC CONFIG_LV_IMG_CACHE_MEM_INT_ALLOC
+        #else
+            #define LV_IMG_CACHE_MEM_INT_ALLOC malloc
+        #endif
+    #endif
+    #ifndef LV_IMG_CACHE_MEM_INT_FREE
+        #ifdef CONFIG_LV_IMG_CACHE_MEM_INT_FREE
+            #define LV_IMG_CACHE_MEM_INT_FREE CONFIG_LV_IMG_CACHE_MEM_INT_FREE
+        #else
+            #define LV_IMG_CACHE_MEM_INT_FREE free
+        #endif
+    #endif
+    #ifndef LV_IMG_CACHE_MEM_EXT_ALLOC
+        #ifdef CONFIG_LV_IMG_CACHE_MEM_EXT_ALLOC
+            #define LV_IMG_CACHE_MEM_EXT_ALLOC CONFIG_LV_IMG_CACHE_MEM_EXT_ALLOC
+        #else
+            #define LV_IMG_CACHE_MEM_EXT_ALLOC malloc
+        #endif
+    #endif
+    #ifndef LV_IMG_CACHE_MEM_EXT_FREE
+        #ifdef CONFIG_LV_IMG_CACHE_MEM_EXT_FREE
+            #define LV_IMG_CACHE_MEM_EXT_FREE CONFIG_LV_IMG_CACHE_MEM_EXT_FREE
+        #else
+            #define LV_IMG_CACHE_MEM_EXT_FREE free
+        #endif
+    #endif
+#endif
+
+/*Number of resolved style properties to cache.
+ *`lv_obj_get_style_prop()` is called many times for every object in each frame and it
+ *searches all the styles of the object (and its parents for inherited properties).
+ *The cache stores the final values by object, part, state and property.
+ *It's invalidated when a style, the state or the parent of an object changes.
+ *A visible widget uses about 30..50 entries, so the size should follow the number of widgets on the screen.
+ *Must be a power of 2. An entry uses 20 bytes on 32 bit systems (placed with `LV_ATTRIBUTE_LARGE_RAM_ARRAY`).
+ *0: to disable caching*/
+#ifndef LV_STYLE_CACHE_SIZE
+    #ifdef CONFIG_LV_STYLE_CACHE_SIZE
+        #define LV_STYLE_CACHE_SIZE CONFIG_LV_STYLE_CACHE_SIZE
+    #else
+        #define LV_STYLE_CACHE_SIZE 0
+    #endif
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -796,6 +870,52 @@
     #endif
 #endif
 
+/*1: Record the duration of the rendering stages (layout, objects, masks, blending, flush)
+ *into a ring buffer which can be exported as Chrome trace JSON or as a binary dump.
+ *See `lv_profiler.h`*/
+#ifndef LV_USE_PROFILER
+    #ifdef CONFIG_LV_USE_PROFILER
+        #define LV_USE_PROFILER CONFIG_LV_USE_PROFILER
+    #else
+        #define LV_USE_PROFILER 0
+    #endif
+#endif
+#if LV_USE_PROFILER
+    /*Number of records in the ring buffer. Must be a power of 2*/
+    #ifndef LV_PROFILER_BUF_SIZE
+        #ifdef CONFIG_LV_PROFILER_BUF_SIZE
+            #define LV_PROFILER_BUF_SIZE CONFIG_LV_PROFILER_BUF_SIZE
+        #else
+            #define LV_PROFILER_BUF_SIZE 1024
+        #endif
+    #endif
+
+    /*Use a custom microsecond time source instead of `lv_tick_get() * 1000`*/
+    #ifndef LV_PROFILER_TICK_CUSTOM
+        #ifdef CONFIG_LV_PROFILER_TICK_CUSTOM
+            #define LV_PROFILER_TICK_CUSTOM CONFIG_LV_PROFILER_TICK_CUSTOM
+        #else
+            #define LV_PROFILER_TICK_CUSTOM 0
+        #endif
+    #endif
+    #if LV_PROFILER_TICK_CUSTOM
+        #ifndef LV_PROFILER_TICK_CUSTOM_INCLUDE
+            #ifdef CONFIG_LV_PROFILER_TICK_CUSTOM_INCLUDE
+                #define LV_PROFILER_TICK_CUSTOM_INCLUDE CONFIG_LV_PROFILER_TICK_CUSTOM_INCLUDE
+            #else
+                #define LV_PROFILER_TICK_CUSTOM_INCLUDE "Arduino.h"         /*Header for the time function*/
+            #endif
+        #endif
+        #ifndef LV_PROFILER_TICK_CUSTOM_SYS_TIME_EXPR
+            #ifdef CONFIG_LV_PROFILER_TICK_CUSTOM_SYS_TIME_EXPR
+                #define LV_PROFILER_TICK_CUSTOM_SYS_TIME_EXPR CONFIG_LV_PROFILER_TICK_CUSTOM_SYS_TIME_EXPR
+            #else
+                #define LV_PROFILER_TICK_CUSTOM_SYS_TIME_EXPR (micros())    /*Expression evaluating to current time in us*/
+            #endif
+        #endif
+    #endif
+#endif
+
 /*Change the built in (v)snprintf functions*/
 #ifndef LV_SPRINTF_CUSTOM
     #ifdef CONFIG_LV_SPRINTF_CUSTOM
@@ -1229,6 +1349,29 @@
     #endif
 #endif
 
+/*Number of (font, letter) -> glyph ID lookups to cache for the built-in font format.
+ *Finding a glyph needs a search in the character maps, which is done twice for each letter (the letter and the kerning).
+ *Must be a power of 2. 0: cache only the last letter of each font*/
+#ifndef LV_FONT_CMAP_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_CMAP_CACHE_SIZE
+        #define LV_FONT_CMAP_CACHE_SIZE CONFIG_LV_FONT_CMAP_CACHE_SIZE
+    #else
+        #define LV_FONT_CMAP_CACHE_SIZE 0
+    #endif
+#endif
+
+/*Memory to cache the decompressed glyph bitmaps of compressed fonts [bytes]. Requires `LV_USE_FONT_COMPRESSED`.
+ *The glyphs are stored as 8 bpp (A8) bitmaps so they are decompressed only once.
+ *The least recently used glyphs are freed if the limit is reached.
+ *0: disable the cache*/
+#ifndef LV_FONT_GLYPH_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+        #define LV_FONT_GLYPH_CACHE_SIZE CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+    #else
+        #define LV_FONT_GLYPH_CACHE_SIZE 0
+    #endif
+#endif
+
 /*Enable subpixel rendering*/
 #ifndef LV_USE_FONT_SUBPX
     #ifdef CONFIG_LV_USE_FONT_SUBPX
@@ -0,0 +1,270 @@
+/**
+ * @file lv_profiler.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_profiler.h"
+#if LV_USE_PROFILER
+
+#include "lv_printf.h"
+#include "../hal/lv_hal_tick.h"
+
+#if LV_PROFILER_TICK_CUSTOM
+    #include LV_PROFILER_TICK_CUSTOM_INCLUDE
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#if (LV_PROFILER_BUF_SIZE & (LV_PROFILER_BUF_SIZE - 1)) != 0
+    #error "LV_PROFILER_BUF_SIZE must be a power of 2"
+#endif
+
+#define BUF_MASK (LV_PROFILER_BUF_SIZE - 1)
+
+/*Records are written by the rendering and might be read from an other task.
+ *The data of a record has to be visible before the index which publishes it.*/
+#if defined(__GNUC__)
+    #define PROFILER_BARRIER() __sync_synchronize()
+#else
+    #define PROFILER_BARRIER()
+#endif
+
+/*Size of the buffer used to format the JSON events*/
+#define CHROME_LINE_SIZE 192
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void put_u16(uint8_t * buf, uint16_t v);
+static void put_u32(uint8_t * buf, uint32_t v);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_profiler_record_t records[LV_PROFILER_BUF_SIZE];
+static volatile uint32_t head;  /*Written only by the producer*/
+static volatile uint32_t tail;  /*Written only by the consumer*/
+static volatile uint32_t dropped;   /*Written only by the producer*/
+static volatile uint32_t dropped_at_clear;  /*Written only by the consumer*/
+static volatile uint32_t event_mask;
+static lv_profiler_class_name_cb_t class_name_cb;
+
+static const char * const event_names[_LV_PROFILER_EVENT_LAST] = {
+    [LV_PROFILER_EVENT_REFR] = "refr",
+    [LV_PROFILER_EVENT_LAYOUT] = "layout",
+    [LV_PROFILER_EVENT_REFR_OBJ] = "refr_obj",
+    [LV_PROFILER_EVENT_MASK] = "mask",
+    [LV_PROFILER_EVENT_BLEND] = "blend",
+    [LV_PROFILER_EVENT_FLUSH] = "flush",
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_profiler_init(void)
+{
+    event_mask = 0;
+    head = 0;
+    tail = 0;
+    dropped = 0;
+    dropped_at_clear = 0;
+    class_name_cb = NULL;
+}
+
+void lv_profiler_start(uint32_t mask)
+{
+    event_mask = mask;
+}
+
+void lv_profiler_stop(void)
+{
+    event_mask = 0;
+}
+
+void lv_profiler_clear(void)
+{
+    /*Resetting `dropped` here could lose an increment of the producer, so only the baseline moves*/
+    dropped_at_clear = dropped;
+    tail = head;
+}
+
+uint32_t lv_profiler_get_count(void)
+{
+    return head - tail;
+}
+
+uint32_t lv_profiler_get_dropped(void)
+{
+    return dropped - dropped_at_clear;
+}
+
+bool lv_profiler_read(lv_profiler_record_t * rec)
+{
+    uint32_t t = tail;
+    if(t == head) return false;
+
+    PROFILER_BARRIER();
+    *rec = records[t & BUF_MASK];
+    PROFILER_BARRIER();
+
+    tail = t + 1;
+    return true;
+}
+
+void lv_profiler_set_class_name_cb(lv_profiler_class_name_cb_t cb)
+{
+    class_name_cb = cb;
+}
+
+const char * lv_profiler_event_get_name(lv_profiler_event_t event)
+{
+    if(event >= _LV_PROFILER_EVENT_LAST) return "unknown";
+    return event_names[event];
+}
+
+uint32_t lv_profiler_export_chrome(lv_profiler_write_cb_t write_cb, void * user_data)
+{
+    char line[CHROME_LINE_SIZE];
+    static const char begin[] = "{\"traceEvents\":[\n";
+    write_cb(begin, sizeof(begin) - 1, user_data);
+
+    uint32_t cnt = 0;
+    lv_profiler_record_t rec;
+    while(lv_profiler_read(&rec)) {
+        const char * name = lv_profiler_event_get_name(rec.event);
+        const char * class_name = NULL;
+        if(rec.class_p && class_name_cb) class_name = class_name_cb(rec.class_p);
+
+        int len;
+        if(rec.obj == NULL) {
+            len = lv_snprintf(line, sizeof(line),
+                              "%s{\"name\":\"%s\",\"cat\":\"lvgl\",\"ph\":\"X\",\"ts\":%"LV_PRIu32",\"dur\":%"LV_PRIu32
+                              ",\"pid\":0,\"tid\":0}",
+                              cnt ? ",\n" : "", name, rec.start, rec.duration);
+        }
+        else if(class_name) {
+            len = lv_snprintf(line, sizeof(line),
+                              "%s{\"name\":\"%s\",\"cat\":\"lvgl\",\"ph\":\"X\",\"ts\":%"LV_PRIu32",\"dur\":%"LV_PRIu32
+                              ",\"pid\":0,\"tid\":0,\"args\":{\"obj\":\"%p\"}}",
+                              cnt ? ",\n" : "", class_name, rec.start, rec.duration, rec.obj);
+        }
+        else {
+            len = lv_snprintf(line, sizeof(line),
+                              "%s{\"name\":\"%s\",\"cat\":\"lvgl\",\"ph\":\"X\",\"ts\":%"LV_PRIu32",\"dur\":%"LV_PRIu32
+                              ",\"pid\":0,\"tid\":0,\"args\":{\"obj\":\"%p\",\"class\":\"%p\"}}",
+                              cnt ? ",\n" : "", name, rec.start, rec.duration, rec.obj, rec.class_p);
+        }
+
+        if(len > (int)sizeof(line) - 1) len = sizeof(line) - 1;
+        if(len > 0) write_cb(line, (uint32_t)len, user_data);
+        cnt++;
+    }
+
+    int len = lv_snprintf(line, sizeof(line), "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":%"LV_PRIu32"}}\n",
+                          lv_profiler_get_dropped());
+    if(len > 0) write_cb(line, (uint32_t)len, user_data);
+
+    return cnt;
+}
+
+uint32_t lv_profiler_export_binary(lv_profiler_write_cb_t write_cb, void * user_data)
+{
+    /*Only the records available now are exported to keep the count in the header valid*/
+    uint32_t cnt = lv_profiler_get_count();
+
+    uint8_t buf[LV_PROFILER_BIN_HEADER_SIZE];
+    buf[0] = LV_PROFILER_BIN_MAGIC[0];
+    buf[1] = LV_PROFILER_BIN_MAGIC[1];
+    buf[2] = LV_PROFILER_BIN_MAGIC[2];
+    buf[3] = LV_PROFILER_BIN_MAGIC[3];
+    put_u16(&buf[4], LV_PROFILER_BIN_VERSION);
+    put_u16(&buf[6], LV_PROFILER_BIN_RECORD_SIZE);
+    put_u32(&buf[8], cnt);
+    put_u32(&buf[12], lv_profiler_get_dropped());
+    write_cb(buf, sizeof(buf), user_data);
+
+    uint32_t i;
+    lv_profiler_record_t rec;
+    for(i = 0; i < cnt; i++) {
+        if(!lv_profiler_read(&rec)) break;
+        uint8_t rbuf[LV_PROFILER_BIN_RECORD_SIZE];
+        put_u32(&rbuf[0], rec.start);
+        put_u32(&rbuf[4], rec.duration);
+        /*The pointers are only used to tell the objects apart so the lower 32 bits are enough*/
+        put_u32(&rbuf[8], (uint32_t)(uintptr_t)rec.obj);
+        put_u32(&rbuf[12], (uint32_t)(uintptr_t)rec.class_p);
+        rbuf[16] = rec.event;
+        write_cb(rbuf, sizeof(rbuf), user_data);
+    }
+
+    return i;
+}
+
+uint32_t lv_profiler_tick_get(void)
+{
+#if LV_PROFILER_TICK_CUSTOM
+    return (uint32_t)(LV_PROFILER_TICK_CUSTOM_SYS_TIME_EXPR);
+#else
+    return lv_tick_get() * 1000;
+#endif
+}
+
+uint32_t _lv_profiler_begin(lv_profiler_event_t event)
+{
+    if((event_mask & (1UL << event)) == 0) return LV_PROFILER_TS_INVALID;
+    return lv_profiler_tick_get();
+}
+
+void _lv_profiler_end(lv_profiler_event_t event, uint32_t start, const void * obj, const void * class_p)
+{
+    if(start == LV_PROFILER_TS_INVALID) return;
+
+    uint32_t h = head;
+    if(h - tail >= LV_PROFILER_BUF_SIZE) {
+        dropped++;
+        return;
+    }
+
+    lv_profiler_record_t * rec = &records[h & BUF_MASK];
+    rec->start = start;
+    rec->duration = lv_profiler_tick_get() - start;
+    rec->obj = obj;
+    rec->class_p = class_p;
+    rec->event = (uint8_t)event;
+
+    PROFILER_BARRIER();
+    head = h + 1;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void put_u16(uint8_t * buf, uint16_t v)
+{
+    buf[0] = (uint8_t)(v & 0xFF);
+    buf[1] = (uint8_t)(v >> 8);
+}
+
+static void put_u32(uint8_t * buf, uint32_t v)
+{
+    buf[0] = (uint8_t)(v & 0xFF);
+    buf[1] = (uint8_t)((v >> 8) & 0xFF);
+    buf[2] = (uint8_t)((v >> 16) & 0xFF);
+    buf[3] = (uint8_t)(v >> 24);
+}
+
+#endif /*LV_USE_PROFILER*/
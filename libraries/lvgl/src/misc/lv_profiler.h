@@ -0,0 +1,196 @@
+/**
+ * @file lv_profiler.h
+ * Record the duration of the rendering stages into a ring buffer
+ * and export them as Chrome trace events or as a compact binary dump.
+ */
+
+#ifndef LV_PROFILER_H
+#define LV_PROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if LV_USE_PROFILER
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Returned by `_lv_profiler_begin()` if the event is not recorded*/
+#define LV_PROFILER_TS_INVALID 0xFFFFFFFF
+
+/*Enable all the events in `lv_profiler_start()`*/
+#define LV_PROFILER_EVENT_MASK_ALL 0xFFFFFFFF
+
+/*Header of the binary dump*/
+#define LV_PROFILER_BIN_MAGIC "LVPR"
+#define LV_PROFILER_BIN_VERSION 1
+#define LV_PROFILER_BIN_HEADER_SIZE 16
+#define LV_PROFILER_BIN_RECORD_SIZE 17
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * The measured stages of the rendering
+ */
+typedef enum {
+    LV_PROFILER_EVENT_REFR = 0,     /**< A complete refresh of a display*/
+    LV_PROFILER_EVENT_LAYOUT,       /**< Updating the layout of the screens and layers*/
+    LV_PROFILER_EVENT_REFR_OBJ,     /**< Drawing an object and its children*/
+    LV_PROFILER_EVENT_MASK,         /**< Preparing a mask (e.g. calculating a circle)*/
+    LV_PROFILER_EVENT_BLEND,        /**< Blending an area into the draw buffer*/
+    LV_PROFILER_EVENT_FLUSH,        /**< Waiting for the draw buffer and calling `flush_cb`*/
+    _LV_PROFILER_EVENT_LAST
+} lv_profiler_event_t;
+
+/**
+ * A finished span of a rendering stage
+ */
+typedef struct {
+    uint32_t start;         /**< Begin timestamp [us]*/
+    uint32_t duration;      /**< Duration [us]*/
+    const void * obj;       /**< The object being drawn or NULL*/
+    const void * class_p;   /**< The class of `obj` or NULL*/
+    uint8_t event;          /**< Value from ::lv_profiler_event_t*/
+} lv_profiler_record_t;
+
+/**
+ * Receives the exported data in chunks
+ */
+typedef void (*lv_profiler_write_cb_t)(const void * buf, uint32_t len, void * user_data);
+
+/**
+ * Return a human readable name of an object class or NULL if unknown
+ */
+typedef const char * (*lv_profiler_class_name_cb_t)(const void * class_p);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Init the profiler module. The recording is stopped by default.
+ */
+void _lv_profiler_init(void);
+
+/**
+ * Start recording the given events
+ * @param event_mask    OR-ed `1 << LV_PROFILER_EVENT_...` values or `LV_PROFILER_EVENT_MASK_ALL`
+ */
+void lv_profiler_start(uint32_t event_mask);
+
+/**
+ * Stop recording. The already recorded spans are kept.
+ */
+void lv_profiler_stop(void);
+
+/**
+ * Drop all the recorded spans and reset the dropped counter
+ */
+void lv_profiler_clear(void);
+
+/**
+ * Get the number of spans waiting in the ring buffer
+ * @return number of records
+ */
+uint32_t lv_profiler_get_count(void);
+
+/**
+ * Get the number of spans dropped because the ring buffer was full
+ * @return number of dropped records
+ */
+uint32_t lv_profiler_get_dropped(void);
+
+/**
+ * Remove the oldest record from the ring buffer
+ * @param rec   store the record here
+ * @return      true: `rec` is filled; false: the ring buffer was empty
+ */
+bool lv_profiler_read(lv_profiler_record_t * rec);
+
+/**
+ * Set a callback to name the object classes in the Chrome trace.
+ * Without it the class pointers are printed.
+ * @param cb    the callback or NULL
+ */
+void lv_profiler_set_class_name_cb(lv_profiler_class_name_cb_t cb);
+
+/**
+ * Get the name of an event
+ * @param event an event
+ * @return      the event's name, e.g. "refr_obj"
+ */
+const char * lv_profiler_event_get_name(lv_profiler_event_t event);
+
+/**
+ * Consume the recorded spans and write them as Chrome trace-event JSON
+ * (can be opened in `chrome://tracing` or Perfetto)
+ * @param write_cb  called with the consecutive chunks of the JSON text
+ * @param user_data passed to `write_cb`
+ * @return          number of exported records
+ */
+uint32_t lv_profiler_export_chrome(lv_profiler_write_cb_t write_cb, void * user_data);
+
+/**
+ * Consume the recorded spans and write them in a compact little endian format:
+ * a header of `LV_PROFILER_BIN_HEADER_SIZE` bytes (magic, version, record size, record count, dropped count)
+ * followed by `LV_PROFILER_BIN_RECORD_SIZE` byte records (start, duration, object, class, event).
+ * `scripts/profiler_bin_to_trace.py` converts it to Chrome trace JSON.
+ * @param write_cb  called with the consecutive chunks of the dump
+ * @param user_data passed to `write_cb`
+ * @return          number of exported records
+ */
+uint32_t lv_profiler_export_binary(lv_profiler_write_cb_t write_cb, void * user_data);
+
+/**
+ * Get the profiler's time stamp
+ * @return the current time in microseconds
+ */
+uint32_t lv_profiler_tick_get(void);
+
+/**
+ * Start a span. Use `LV_PROFILER_BEGIN` instead.
+ * @param event the event of the span
+ * @return      the start time stamp or `LV_PROFILER_TS_INVALID` if the event is not recorded
+ */
+uint32_t _lv_profiler_begin(lv_profiler_event_t event);
+
+/**
+ * Finish a span and save it in the ring buffer. Use `LV_PROFILER_END` instead.
+ * @param event     the event of the span
+ * @param start     return value of `_lv_profiler_begin()`
+ * @param obj       the related object or NULL
+ * @param class_p   the class of `obj` or NULL
+ */
+void _lv_profiler_end(lv_profiler_event_t event, uint32_t start, const void * obj, const void * class_p);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#define LV_PROFILER_BEGIN(event, ts) uint32_t ts = _lv_profiler_begin(event)
+#define LV_PROFILER_END(event, ts, obj, class_p) _lv_profiler_end(event, ts, obj, class_p)
+
+#else /*LV_USE_PROFILER*/
+
+#define LV_PROFILER_BEGIN(event, ts)
+#define LV_PROFILER_END(event, ts, obj, class_p)
+
+#endif /*LV_USE_PROFILER*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_PROFILER_H*/
@@ -139,6 +139,7 @@ uint32_t _lv_style_custom_prop_flag_lookup_table_size = 0;
 
 static uint16_t last_custom_prop_id = (uint16_t)_LV_STYLE_LAST_BUILT_IN_PROP;
 static const lv_style_value_t null_style_value = { .num = 0 };
+static uint32_t style_version;
 
 /**********************
  *      MACROS
@@ -160,6 +161,7 @@ void lv_style_init(lv_style_t * style)
 #if LV_USE_ASSERT_STYLE
     style->sentinel = LV_STYLE_SENTINEL_VALUE;
 #endif
+    _lv_style_cache_invalidate();
 }
 
 void lv_style_reset(lv_style_t * style)
@@ -176,6 +178,7 @@ void lv_style_reset(lv_style_t * style)
 #if LV_USE_ASSERT_STYLE
     style->sentinel = LV_STYLE_SENTINEL_VALUE;
 #endif
+    _lv_style_cache_invalidate();
 }
 
 lv_style_prop_t lv_style_register_prop(uint8_t flag)
@@ -234,6 +237,7 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
         if(LV_STYLE_PROP_ID_MASK(style->prop1) == prop) {
             style->prop1 = LV_STYLE_PROP_INV;
             style->prop_cnt = 0;
+            _lv_style_cache_invalidate();
             return true;
         }
         return false;
@@ -273,6 +277,7 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
             }
 
             lv_mem_free(old_values);
+            _lv_style_cache_invalidate();
             return true;
         }
     }
@@ -378,6 +383,16 @@ uint8_t _lv_style_get_prop_group(lv_style_prop_t prop)
     return (uint8_t)group;
 }
 
+void _lv_style_cache_invalidate(void)
+{
+    style_version++;
+}
+
+uint32_t _lv_style_cache_get_version(void)
+{
+    return style_version;
+}
+
 uint8_t _lv_style_prop_lookup_flags(lv_style_prop_t prop)
 {
     extern const uint8_t _lv_style_builtin_prop_flag_lookup_table[];
@@ -422,6 +437,8 @@ static void lv_style_set_prop_internal(lv_style_t * style, lv_style_prop_t prop_
         return;
     }
 
+    _lv_style_cache_invalidate();
+
     lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(prop_and_meta);
 
     if(style->prop_cnt > 1) {
@@ -519,6 +519,18 @@ uint8_t _lv_style_get_prop_group(lv_style_prop_t prop);
  */
 uint8_t _lv_style_prop_lookup_flags(lv_style_prop_t prop);
 
+/**
+ * Tell that a style property, the styles or the state of an object has changed.
+ * It makes the values cached by `lv_obj_get_style_prop()` outdated.
+ */
+void _lv_style_cache_invalidate(void);
+
+/**
+ * Get the version of the styles. It's incremented by `_lv_style_cache_invalidate()`.
+ * @return the current version
+ */
+uint32_t _lv_style_cache_get_version(void);
+
 #include "lv_style_gen.h"
 
 static inline void lv_style_set_size(lv_style_t * style, lv_coord_t value)
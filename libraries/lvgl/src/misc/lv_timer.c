@@ -25,16 +25,32 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool lv_timer_exec(lv_timer_t * timer);
+static void lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
+static uint32_t time_remaining_at(const lv_timer_t * timer, uint32_t now);
+static bool heap_reserve(uint32_t cnt);
+static void heap_set(uint32_t i, lv_timer_t * timer);
+static void heap_sift_up(uint32_t i, uint32_t now);
+static void heap_sift_down(uint32_t i, uint32_t now);
+static void heap_insert(lv_timer_t * timer);
+static void heap_remove(lv_timer_t * timer);
+static void heap_update(lv_timer_t * timer);
+static void heap_park_top(void);
+static void heap_unpark_all(void);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static bool lv_timer_run = false;
 static uint8_t idle_last = 0;
-static bool timer_deleted;
-static bool timer_created;
+
+/*`_lv_timer_heap` is a binary min-heap of the not paused timers ordered by their remaining time.
+ *The timers which already ran in the current `lv_timer_handler()` call are parked after the heap
+ *to run every timer at most once per call. They are pushed back to the heap at the end of the call.*/
+static uint32_t heap_cnt;       /*Number of timers in the heap*/
+static uint32_t parked_cnt;     /*Number of timers parked after the heap*/
+static uint32_t heap_size;      /*Allocated length of `_lv_timer_heap`*/
+static uint32_t timer_cnt;      /*Number of all timers (including the paused ones)*/
 
 /**********************
  *      MACROS
@@ -55,6 +71,11 @@ static bool timer_created;
 void _lv_timer_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_timer_ll), sizeof(lv_timer_t));
+    LV_GC_ROOT(_lv_timer_heap) = NULL;
+    heap_cnt = 0;
+    parked_cnt = 0;
+    heap_size = 0;
+    timer_cnt = 0;
 
     /*Initially enable the lv_timer handling*/
     lv_timer_enable(true);
@@ -95,40 +116,19 @@ uint32_t LV_ATTRIBUTE_TIMER_HANDLER lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    do {
-        timer_deleted             = false;
-        timer_created             = false;
-        LV_GC_ROOT(_lv_timer_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-        while(LV_GC_ROOT(_lv_timer_act)) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), LV_GC_ROOT(_lv_timer_act));
-
-            if(lv_timer_exec(LV_GC_ROOT(_lv_timer_act))) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(timer_created || timer_deleted) {
-                    TIMER_TRACE("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
+    /*Run the ready timers in the order of their deadline*/
+    while(heap_cnt > 0) {
+        lv_timer_t * timer = LV_GC_ROOT(_lv_timer_heap)[0];
+        if(time_remaining_at(timer, lv_tick_get()) > 0) break;
 
-            LV_GC_ROOT(_lv_timer_act) = next; /*Load the next timer*/
-        }
-    } while(LV_GC_ROOT(_lv_timer_act));
+        heap_park_top();
+        lv_timer_exec(timer);
+    }
 
-    uint32_t time_till_next = LV_NO_TIMER_READY;
-    next = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_till_next)
-                time_till_next = delay;
-        }
+    heap_unpark_all();
 
-        next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), next); /*Find the next timer*/
-    }
+    uint32_t time_till_next = LV_NO_TIMER_READY;
+    if(heap_cnt > 0) time_till_next = lv_timer_time_remaining(LV_GC_ROOT(_lv_timer_heap)[0]);
 
     busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(idle_period_start);
@@ -168,6 +168,9 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+    /*Reserve place in the heap for every timer so resuming a timer never allocates*/
+    if(!heap_reserve(timer_cnt + 1)) return NULL;
+
     new_timer = _lv_ll_ins_head(&LV_GC_ROOT(_lv_timer_ll));
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
@@ -178,8 +181,10 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->paused = 0;
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
+    new_timer->heap_index = LV_TIMER_HEAP_NONE;
 
-    timer_created = true;
+    timer_cnt++;
+    heap_insert(new_timer);
 
     return new_timer;
 }
@@ -200,8 +205,12 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
  */
 void lv_timer_del(lv_timer_t * timer)
 {
+    heap_remove(timer);
     _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), timer);
-    timer_deleted = true;
+    timer_cnt--;
+
+    /*Let `lv_timer_exec` know that the running timer was deleted*/
+    if(LV_GC_ROOT(_lv_timer_act) == timer) LV_GC_ROOT(_lv_timer_act) = NULL;
 
     lv_mem_free(timer);
 }
@@ -213,11 +222,13 @@ void lv_timer_del(lv_timer_t * timer)
 void lv_timer_pause(lv_timer_t * timer)
 {
     timer->paused = true;
+    heap_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     timer->paused = false;
+    if(timer->heap_index == LV_TIMER_HEAP_NONE) heap_insert(timer);
 }
 
 /**
@@ -228,6 +239,7 @@ void lv_timer_resume(lv_timer_t * timer)
 void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     timer->period = period;
+    heap_update(timer);
 }
 
 /**
@@ -237,6 +249,7 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 void lv_timer_ready(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get() - timer->period - 1;
+    heap_update(timer);
 }
 
 /**
@@ -247,6 +260,7 @@ void lv_timer_ready(lv_timer_t * timer)
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     timer->repeat_count = repeat_count;
+    heap_update(timer);
 }
 
 /**
@@ -257,6 +271,7 @@ void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 void lv_timer_reset(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get();
+    heap_update(timer);
 }
 
 /**
@@ -293,37 +308,32 @@ lv_timer_t * lv_timer_get_next(lv_timer_t * timer)
  **********************/
 
 /**
- * Execute timer if its remaining time is zero
+ * Execute a ready timer and delete it if its repeat count is over
  * @param timer pointer to lv_timer
- * @return true: execute, false: not executed
  */
-static bool lv_timer_exec(lv_timer_t * timer)
+static void lv_timer_exec(lv_timer_t * timer)
 {
-    if(timer->paused) return false;
-
-    bool exec = false;
-    if(lv_timer_time_remaining(timer) == 0) {
-        /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
-         * but at least the repeat count is zero and the timer can be deleted in the next round*/
-        int32_t original_repeat_count = timer->repeat_count;
-        if(timer->repeat_count > 0) timer->repeat_count--;
-        timer->last_run = lv_tick_get();
-        TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
-        if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
-        TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
-        LV_ASSERT_MEM_INTEGRITY();
-        exec = true;
-    }
+    LV_GC_ROOT(_lv_timer_act) = timer;
 
-    if(timer_deleted == false) { /*The timer might be deleted by itself as well*/
+    /* Decrement the repeat count before executing the timer_cb.
+     * If the timer is deleted `if(timer->repeat_count == 0)` is not executed below*/
+    int32_t original_repeat_count = timer->repeat_count;
+    if(timer->repeat_count > 0) timer->repeat_count--;
+    timer->last_run = lv_tick_get();
+    TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
+    if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
+    TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
+    LV_ASSERT_MEM_INTEGRITY();
+
+    /*The timer might be deleted by itself as well*/
+    if(LV_GC_ROOT(_lv_timer_act) == timer) {
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
             TIMER_TRACE("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
             lv_timer_del(timer);
         }
     }
 
-    return exec;
+    LV_GC_ROOT(_lv_timer_act) = NULL;
 }
 
 /**
@@ -333,9 +343,187 @@ static bool lv_timer_exec(lv_timer_t * timer)
  */
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
 {
-    /*Check if at least 'period' time elapsed*/
-    uint32_t elp = lv_tick_elaps(timer->last_run);
+    return time_remaining_at(timer, lv_tick_get());
+}
+
+/**
+ * Find out how much time remains at a given time before a timer must be run.
+ * The remaining time of every timer decreases equally as the time passes,
+ * so their order doesn't change and it can be used as the key of the heap.
+ * @param timer pointer to lv_timer
+ * @param now the current tick
+ * @return the time remaining, or 0 if it needs to be run again
+ */
+static uint32_t time_remaining_at(const lv_timer_t * timer, uint32_t now)
+{
+    /*Timers with zero repeat count are ready to be deleted*/
+    if(timer->repeat_count == 0) return 0;
+
+    /*Check if at least 'period' time elapsed (the unsigned subtraction handles the overflow of the tick)*/
+    uint32_t elp = now - timer->last_run;
     if(elp >= timer->period)
         return 0;
     return timer->period - elp;
 }
+
+/**
+ * Make sure the heap can store `cnt` timers
+ * @param cnt the required number of timers
+ * @return true: success; false: out of memory
+ */
+static bool heap_reserve(uint32_t cnt)
+{
+    if(cnt <= heap_size) return true;
+
+    uint32_t new_size = heap_size ? heap_size * 2 : 8;
+    while(new_size < cnt) new_size *= 2;
+
+    lv_timer_t ** new_heap = lv_mem_realloc(LV_GC_ROOT(_lv_timer_heap), new_size * sizeof(lv_timer_t *));
+    LV_ASSERT_MALLOC(new_heap);
+    if(new_heap == NULL) return false;
+
+    LV_GC_ROOT(_lv_timer_heap) = new_heap;
+    heap_size = new_size;
+    return true;
+}
+
+static void heap_set(uint32_t i, lv_timer_t * timer)
+{
+    LV_GC_ROOT(_lv_timer_heap)[i] = timer;
+    timer->heap_index = i;
+}
+
+static void heap_sift_up(uint32_t i, uint32_t now)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * timer = heap[i];
+    uint32_t rem = time_remaining_at(timer, now);
+
+    while(i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if(time_remaining_at(heap[parent], now) <= rem) break;
+        heap_set(i, heap[parent]);
+        i = parent;
+    }
+    heap_set(i, timer);
+}
+
+static void heap_sift_down(uint32_t i, uint32_t now)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * timer = heap[i];
+    uint32_t rem = time_remaining_at(timer, now);
+
+    while(1) {
+        uint32_t child = 2 * i + 1;
+        if(child >= heap_cnt) break;
+
+        uint32_t child_rem = time_remaining_at(heap[child], now);
+        if(child + 1 < heap_cnt) {
+            uint32_t right_rem = time_remaining_at(heap[child + 1], now);
+            if(right_rem < child_rem) {
+                child++;
+                child_rem = right_rem;
+            }
+        }
+
+        if(rem <= child_rem) break;
+        heap_set(i, heap[child]);
+        i = child;
+    }
+    heap_set(i, timer);
+}
+
+/**
+ * Add a timer to the heap. The place is already reserved by `lv_timer_create`.
+ * @param timer pointer to a timer which is not in the heap
+ */
+static void heap_insert(lv_timer_t * timer)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+
+    /*Move the first parked timer to the end to make room*/
+    if(parked_cnt > 0) heap_set(heap_cnt + parked_cnt, heap[heap_cnt]);
+
+    heap_set(heap_cnt, timer);
+    heap_cnt++;
+    heap_sift_up(heap_cnt - 1, lv_tick_get());
+}
+
+/**
+ * Remove a timer from the heap or from the parked timers
+ * @param timer pointer to a timer
+ */
+static void heap_remove(lv_timer_t * timer)
+{
+    uint32_t i = timer->heap_index;
+    if(i == LV_TIMER_HEAP_NONE) return;
+
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    if(i >= heap_cnt) {
+        /*Parked: fill the gap with the last parked timer*/
+        parked_cnt--;
+        if(i != heap_cnt + parked_cnt) heap_set(i, heap[heap_cnt + parked_cnt]);
+    }
+    else {
+        /*Fill the gap with the last timer of the heap and the place of that with the last parked timer*/
+        heap_cnt--;
+        if(i != heap_cnt) heap_set(i, heap[heap_cnt]);
+        if(parked_cnt > 0) heap_set(heap_cnt, heap[heap_cnt + parked_cnt]);
+
+        if(i < heap_cnt) {
+            lv_timer_t * moved = heap[i];
+            uint32_t now = lv_tick_get();
+            heap_sift_up(i, now);
+            heap_sift_down(moved->heap_index, now);
+        }
+    }
+
+    timer->heap_index = LV_TIMER_HEAP_NONE;
+}
+
+/**
+ * Restore the order of the heap after the remaining time of a timer has changed
+ * @param timer pointer to a timer
+ */
+static void heap_update(lv_timer_t * timer)
+{
+    /*Paused and parked timers are sorted when they are (re)inserted*/
+    if(timer->heap_index >= heap_cnt) return;
+
+    uint32_t now = lv_tick_get();
+    heap_sift_up(timer->heap_index, now);
+    heap_sift_down(timer->heap_index, now);
+}
+
+/**
+ * Move the first timer of the heap to the parked timers
+ */
+static void heap_park_top(void)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * top = heap[0];
+
+    heap_cnt--;
+    if(heap_cnt > 0) {
+        heap_set(0, heap[heap_cnt]);
+        heap_sift_down(0, lv_tick_get());
+    }
+    /*The first parked place is where the last timer of the heap was*/
+    heap_set(heap_cnt, top);
+    parked_cnt++;
+}
+
+/**
+ * Push back all the parked timers to the heap
+ */
+static void heap_unpark_all(void)
+{
+    uint32_t now = lv_tick_get();
+    while(parked_cnt > 0) {
+        heap_cnt++;
+        parked_cnt--;
+        heap_sift_up(heap_cnt - 1, now);
+    }
+}
+
@@ -27,6 +27,8 @@ extern "C" {
 
 #define LV_NO_TIMER_READY 0xFFFFFFFF
 
+#define LV_TIMER_HEAP_NONE 0xFFFFFFFF
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -47,6 +49,7 @@ typedef struct _lv_timer_t {
     lv_timer_cb_t timer_cb; /**< Timer function*/
     void * user_data; /**< Custom user data*/
     int32_t repeat_count; /**< 1: One time;  -1 : infinity;  n>0: residual times*/
+    uint32_t heap_index; /**< Position in the deadline heap (internal, `LV_TIMER_HEAP_NONE` if paused)*/
     uint32_t paused : 1;
 } lv_timer_t;
 
@@ -0,0 +1,151 @@
+/**
+ * @file font_bench.c
+ * Frame time of a label-heavy screen with the caches of `lv_font_fmt_txt`
+ * (`LV_FONT_CMAP_CACHE_SIZE` and `LV_FONT_GLYPH_CACHE_SIZE`).
+ *
+ * A 466x466 screen with a clock, a temperature and 48 small labels, like the AC and lamp labels of the
+ * panel. All the texts change and the whole screen is redrawn in every frame.
+ *  - plain:       the clock in montserrat 48, the small labels in the default montserrat 14
+ *  - compressed:  the clock and the small labels in montserrat 28 compressed
+ * The best of a few runs is printed to reduce the noise of the host.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define HOR_RES     466
+#define VER_RES     466
+#define FRAMES      200
+#define RUNS        5
+#define SMALL_CNT   48
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const char * name;
+    const lv_font_t * big_font;
+    const lv_font_t * small_font;
+} scenario_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+static double now_ms(void);
+static void labels_create(const scenario_t * sc);
+static void labels_update(uint32_t frame);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t draw_buf_mem[HOR_RES * 40];
+static lv_obj_t * clock_label;
+static lv_obj_t * temp_label;
+static lv_obj_t * small_labels[SMALL_CNT];
+
+static const scenario_t scenarios[] = {
+    {"plain", &lv_font_montserrat_48, &lv_font_montserrat_14},
+    {"compressed", &lv_font_montserrat_28_compressed, &lv_font_montserrat_28_compressed},
+};
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    lv_init();
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, draw_buf_mem, NULL, HOR_RES * 40);
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = HOR_RES;
+    disp_drv.ver_res = VER_RES;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.draw_buf = &draw_buf;
+    lv_disp_drv_register(&disp_drv);
+
+    printf("LV_FONT_CMAP_CACHE_SIZE %d, LV_FONT_GLYPH_CACHE_SIZE %d\n", LV_FONT_CMAP_CACHE_SIZE,
+           LV_FONT_GLYPH_CACHE_SIZE);
+    uint32_t s;
+    for(s = 0; s < sizeof(scenarios) / sizeof(scenarios[0]); s++) {
+        const scenario_t * sc = &scenarios[s];
+        if(argc > 1 && strcmp(argv[1], sc->name) != 0) continue;
+
+        double best = 0;
+        uint32_t run;
+        for(run = 0; run < RUNS; run++) {
+            lv_obj_clean(lv_scr_act());
+            labels_create(sc);
+            lv_refr_now(NULL);
+
+            double t0 = now_ms();
+            uint32_t f;
+            for(f = 0; f < FRAMES; f++) {
+                labels_update(f);
+                lv_obj_invalidate(lv_scr_act());
+                lv_refr_now(NULL);
+            }
+            double t = (now_ms() - t0) / FRAMES;
+            if(run == 0 || t < best) best = t;
+        }
+        printf("  %-10s %7.3f ms/frame\n", sc->name, best);
+    }
+
+    return 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(drv);
+}
+
+static double now_ms(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1000.0 + t.tv_nsec / 1e6;
+}
+
+static void labels_create(const scenario_t * sc)
+{
+    clock_label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(clock_label, sc->big_font, 0);
+    lv_obj_align(clock_label, LV_ALIGN_TOP_MID, 0, 40);
+
+    temp_label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(temp_label, &lv_font_montserrat_24, 0);
+    lv_obj_align(temp_label, LV_ALIGN_CENTER, 0, 0);
+
+    uint32_t i;
+    for(i = 0; i < SMALL_CNT; i++) {
+        small_labels[i] = lv_label_create(lv_scr_act());
+        lv_obj_set_style_text_font(small_labels[i], sc->small_font, 0);
+        lv_obj_set_pos(small_labels[i], 10 + (int32_t)(i % 4) * 115, 100 + (int32_t)(i / 4) * 30);
+    }
+}
+
+static void labels_update(uint32_t frame)
+{
+    lv_label_set_text_fmt(clock_label, "%02d:%02d", (int)(frame / 60) % 24, (int)frame % 60);
+    lv_label_set_text_fmt(temp_label, "%d.%d C", (int)(20 + frame % 5), (int)(frame % 10));
+    uint32_t i;
+    for(i = 0; i < SMALL_CNT; i++) {
+        lv_label_set_text_fmt(small_labels[i], "AC %d: %d%%", (int)i, (int)((frame + i) % 100));
+    }
+}
@@ -0,0 +1,270 @@
+/**
+ * @file style_bench.c
+ * Frame time with the style cache of `lv_obj_get_style_prop()` (`LV_STYLE_CACHE_SIZE`).
+ *
+ * Each scenario runs a number of frames, 16 ms apart, on a 466x466 display:
+ *  - app:      the screen of the smart-home panel: 8 image buttons, 6 labels, 2 containers, an image
+ *              and an arc. The clock label and the arc change in every frame and only they are redrawn.
+ *  - app_full: `app`, but the whole screen is redrawn in every frame.
+ *  - trans:    `app` while the buttons are selected one after the other. Their pressed state has a
+ *              200 ms transition, so a transition always runs and it changes a style in every frame,
+ *              which invalidates the whole cache.
+ *  - grid:     60 buttons with a label, all redrawn in every frame. More widgets than 1024 entries hold.
+ * The best of a few runs is printed to reduce the noise of the host.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define HOR_RES     466
+#define VER_RES     466
+#define FRAMES      200
+#define RUNS        5
+#define FRAME_MS    16
+#define ICON_SIZE   48
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const char * name;
+    void (*create)(void);
+    void (*update)(uint32_t frame);
+    bool full_redraw;
+} scenario_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+static double now_ms(void);
+static void icons_init(void);
+static void app_create(void);
+static void app_update(uint32_t frame);
+static void trans_update(uint32_t frame);
+static void grid_create(void);
+static void grid_update(uint32_t frame);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t draw_buf_mem[HOR_RES * 40];
+static uint8_t icon_map[2][ICON_SIZE * ICON_SIZE * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static lv_img_dsc_t icons[2];
+static lv_obj_t * clock_label;
+static lv_obj_t * arc;
+static lv_obj_t * buttons[8];
+static lv_obj_t * grid_labels[60];
+
+static const scenario_t scenarios[] = {
+    {"app", app_create, app_update, false},
+    {"app_full", app_create, app_update, true},
+    {"trans", app_create, trans_update, false},
+    {"grid", grid_create, grid_update, true},
+};
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    lv_init();
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, draw_buf_mem, NULL, HOR_RES * 40);
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = HOR_RES;
+    disp_drv.ver_res = VER_RES;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.draw_buf = &draw_buf;
+    lv_disp_drv_register(&disp_drv);
+
+    icons_init();
+
+    printf("LV_STYLE_CACHE_SIZE %d\n", LV_STYLE_CACHE_SIZE);
+    uint32_t s;
+    for(s = 0; s < sizeof(scenarios) / sizeof(scenarios[0]); s++) {
+        const scenario_t * sc = &scenarios[s];
+        if(argc > 1 && strcmp(argv[1], sc->name) != 0) continue;
+
+        double best = 0;
+        uint32_t run;
+        for(run = 0; run < RUNS; run++) {
+            lv_obj_clean(lv_scr_act());
+            sc->create();
+            lv_refr_now(NULL);
+
+            double t0 = now_ms();
+            uint32_t f;
+            for(f = 0; f < FRAMES; f++) {
+                sc->update(f);
+                lv_tick_inc(FRAME_MS);
+                lv_anim_refr_now();
+                if(sc->full_redraw) lv_obj_invalidate(lv_scr_act());
+                lv_refr_now(NULL);
+            }
+            double t = (now_ms() - t0) / FRAMES;
+            if(run == 0 || t < best) best = t;
+        }
+        printf("  %-8s %7.3f ms/frame\n", sc->name, best);
+    }
+
+    return 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(drv);
+}
+
+static double now_ms(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1000.0 + t.tv_nsec / 1e6;
+}
+
+/*The icons of the image buttons: a disc, opaque in the middle, in two colors*/
+static void icons_init(void)
+{
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_color_t c = lv_palette_main(i == 0 ? LV_PALETTE_GREY : LV_PALETTE_YELLOW);
+        uint8_t * p = icon_map[i];
+        int32_t x, y;
+        for(y = 0; y < ICON_SIZE; y++) {
+            for(x = 0; x < ICON_SIZE; x++) {
+                int32_t dx = x - ICON_SIZE / 2;
+                int32_t dy = y - ICON_SIZE / 2;
+                int32_t a = 255 - (dx * dx + dy * dy) * 255 / (ICON_SIZE * ICON_SIZE / 4);
+                memcpy(p, &c, sizeof(c));
+                p[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = (uint8_t)LV_CLAMP(0, a, 255);
+                p += LV_IMG_PX_SIZE_ALPHA_BYTE;
+            }
+        }
+        icons[i].header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+        icons[i].header.w = ICON_SIZE;
+        icons[i].header.h = ICON_SIZE;
+        icons[i].data_size = sizeof(icon_map[i]);
+        icons[i].data = icon_map[i];
+    }
+}
+
+static void app_create(void)
+{
+    static const lv_style_prop_t trans_props[] = {LV_STYLE_IMG_RECOLOR_OPA, LV_STYLE_TRANSFORM_ZOOM, 0};
+    static lv_style_transition_dsc_t trans;
+    static lv_style_t style_btn;
+    static lv_style_t style_btn_pr;
+    static bool inited;
+    if(!inited) {
+        lv_style_transition_dsc_init(&trans, trans_props, lv_anim_path_linear, 200, 0, NULL);
+        lv_style_init(&style_btn);
+        lv_style_set_transition(&style_btn, &trans);
+        lv_style_init(&style_btn_pr);
+        lv_style_set_img_recolor(&style_btn_pr, lv_palette_main(LV_PALETTE_AMBER));
+        lv_style_set_img_recolor_opa(&style_btn_pr, LV_OPA_50);
+        lv_style_set_transform_zoom(&style_btn_pr, 280);
+        lv_style_set_transition(&style_btn_pr, &trans);
+        inited = true;
+    }
+
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_t * dial = lv_img_create(scr);
+    lv_img_set_src(dial, LV_SYMBOL_REFRESH);
+    lv_obj_center(dial);
+
+    arc = lv_arc_create(scr);
+    lv_obj_set_size(arc, 420, 420);
+    lv_obj_center(arc);
+
+    uint32_t i;
+    for(i = 0; i < 8; i++) {
+        buttons[i] = lv_imgbtn_create(scr);
+        lv_imgbtn_set_src(buttons[i], LV_IMGBTN_STATE_RELEASED, NULL, &icons[0], NULL);
+        lv_imgbtn_set_src(buttons[i], LV_IMGBTN_STATE_PRESSED, NULL, &icons[1], NULL);
+        lv_obj_set_size(buttons[i], ICON_SIZE, ICON_SIZE);
+        lv_obj_align(buttons[i], LV_ALIGN_CENTER, (int32_t)(i % 4) * 80 - 120, i < 4 ? -60 : 60);
+        lv_obj_add_style(buttons[i], &style_btn, 0);
+        lv_obj_add_style(buttons[i], &style_btn_pr, LV_STATE_PRESSED);
+    }
+
+    lv_obj_t * cont[2];
+    for(i = 0; i < 2; i++) {
+        cont[i] = lv_obj_create(scr);
+        lv_obj_set_size(cont[i], 160, 60);
+        lv_obj_align(cont[i], LV_ALIGN_BOTTOM_MID, i == 0 ? -85 : 85, -50);
+    }
+
+    clock_label = lv_label_create(scr);
+    lv_obj_set_style_text_font(clock_label, &lv_font_montserrat_48, 0);
+    lv_obj_align(clock_label, LV_ALIGN_TOP_MID, 0, 50);
+    lv_obj_t * temp = lv_label_create(scr);
+    lv_obj_set_style_text_font(temp, &lv_font_montserrat_24, 0);
+    lv_label_set_text(temp, "23.5 C");
+    lv_obj_align(temp, LV_ALIGN_TOP_MID, 0, 110);
+    lv_obj_t * all = lv_label_create(scr);
+    lv_label_set_text(all, "All lights");
+    lv_obj_align(all, LV_ALIGN_CENTER, 0, 0);
+    for(i = 0; i < 2; i++) {
+        lv_obj_t * l = lv_label_create(cont[i]);
+        lv_label_set_text(l, i == 0 ? "AC Stan" : "AC Lab");
+        lv_obj_align(l, LV_ALIGN_LEFT_MID, 0, 0);
+        l = lv_label_create(cont[i]);
+        lv_label_set_text(l, "ON");
+        lv_obj_align(l, LV_ALIGN_RIGHT_MID, 0, 0);
+    }
+}
+
+static void app_update(uint32_t frame)
+{
+    lv_label_set_text_fmt(clock_label, "%02d:%02d", (int)(frame / 60) % 24, (int)frame % 60);
+    lv_arc_set_value(arc, (int16_t)(frame % 100));
+}
+
+static void trans_update(uint32_t frame)
+{
+    app_update(frame);
+
+    /*Select the next button before the transitions of the last one end*/
+    if(frame % 10 == 0) {
+        uint32_t i = (frame / 10) % 8;
+        lv_obj_clear_state(buttons[(i + 7) % 8], LV_STATE_PRESSED);
+        lv_obj_add_state(buttons[i], LV_STATE_PRESSED);
+    }
+}
+
+static void grid_create(void)
+{
+    uint32_t i;
+    for(i = 0; i < 60; i++) {
+        lv_obj_t * btn = lv_btn_create(lv_scr_act());
+        lv_obj_set_size(btn, 70, 40);
+        lv_obj_set_pos(btn, 8 + (int32_t)(i % 6) * 76, 8 + (int32_t)(i / 6) * 45);
+        grid_labels[i] = lv_label_create(btn);
+        lv_obj_center(grid_labels[i]);
+    }
+}
+
+static void grid_update(uint32_t frame)
+{
+    uint32_t i;
+    for(i = 0; i < 60; i++) {
+        lv_label_set_text_fmt(grid_labels[i], "%d", (int)((frame + i) % 100));
+    }
+}
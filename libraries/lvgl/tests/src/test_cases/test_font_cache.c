@@ -0,0 +1,123 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_FONT_GLYPH_CACHE_SIZE && LV_USE_FONT_COMPRESSED && LV_FONT_MONTSERRAT_28 && LV_FONT_MONTSERRAT_28_COMPRESSED
+
+#include <string.h>
+
+static uint8_t ref_buf[64 * 64];
+
+/*The compressed font has the same glyphs as the plain font. Decode the plain 4 bpp glyph as the letter drawing does.*/
+static void get_ref_a8(uint32_t letter, const lv_font_glyph_dsc_t * g)
+{
+    const lv_font_t * font = &lv_font_montserrat_28;
+    lv_font_glyph_dsc_t ref_g;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &ref_g, letter, 0));
+    TEST_ASSERT_EQUAL(4, ref_g.bpp);
+    TEST_ASSERT_EQUAL(ref_g.box_w, g->box_w);
+    TEST_ASSERT_EQUAL(ref_g.box_h, g->box_h);
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(ref_buf), ref_g.box_w * ref_g.box_h);
+
+    const uint8_t * in = lv_font_get_glyph_bitmap(font, letter);
+    uint32_t i;
+    for(i = 0; i < (uint32_t)ref_g.box_w * ref_g.box_h; i++) {
+        uint8_t v = (i & 1) ? in[i / 2] & 0x0F : in[i / 2] >> 4;
+        ref_buf[i] = v * 17;
+    }
+}
+
+static void check_glyph(uint32_t letter)
+{
+    const lv_font_t * font = &lv_font_montserrat_28_compressed;
+    lv_font_glyph_dsc_t g;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, letter, 0));
+    if(g.box_w == 0) return;
+    TEST_ASSERT_EQUAL(8, g.bpp);
+
+    const uint8_t * bitmap = lv_font_get_glyph_bitmap(font, letter);
+    TEST_ASSERT_NOT_NULL(bitmap);
+
+    get_ref_a8(letter, &g);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, bitmap, g.box_w * g.box_h);
+}
+
+void setUp(void)
+{
+    lv_font_fmt_txt_cache_invalidate(NULL);
+}
+
+void tearDown(void)
+{
+    lv_font_fmt_txt_cache_invalidate(NULL);
+}
+
+void test_font_cache_decompresses_to_a8(void)
+{
+    uint32_t letter;
+    for(letter = 'A'; letter <= 'z'; letter++) {
+        check_glyph(letter);
+    }
+}
+
+void test_font_cache_hit_returns_same_bitmap(void)
+{
+    const uint8_t * b1 = lv_font_get_glyph_bitmap(&lv_font_montserrat_28_compressed, 'A');
+    const uint8_t * b2 = lv_font_get_glyph_bitmap(&lv_font_montserrat_28_compressed, 'A');
+    TEST_ASSERT_EQUAL_PTR(b1, b2);
+
+    const uint8_t * b3 = lv_font_get_glyph_bitmap(&lv_font_montserrat_28_compressed, 'B');
+    TEST_ASSERT_NOT_EQUAL(b1, b3);
+}
+
+void test_font_cache_eviction_keeps_glyphs_valid(void)
+{
+    /*All the glyphs don't fit into the cache at once*/
+    static const uint32_t symbols[] = {0xF001, 0xF008, 0xF00B, 0xF00C, 0xF00D, 0xF011, 0xF013, 0xF015, 0xF019, 0xF01C};
+    uint32_t round;
+    uint32_t i;
+    for(round = 0; round < 3; round++) {
+        for(i = '!'; i <= '~'; i++) {
+            check_glyph(i);
+            /*Keep using a glyph to see that it survives the compactions*/
+            check_glyph('x');
+        }
+        for(i = 0; i < sizeof(symbols) / sizeof(symbols[0]); i++) {
+            check_glyph(symbols[i]);
+        }
+    }
+}
+
+void test_font_cache_invalidate(void)
+{
+    lv_font_glyph_dsc_t g;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&lv_font_montserrat_28_compressed, &g, 'W', 0));
+    const uint8_t * bitmap = lv_font_get_glyph_bitmap(&lv_font_montserrat_28_compressed, 'W');
+
+    static uint8_t copy[64 * 64];
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(copy), g.box_w * g.box_h);
+    memcpy(copy, bitmap, g.box_w * g.box_h);
+
+    /*Decompressed again to the same result*/
+    lv_font_fmt_txt_cache_invalidate(&lv_font_montserrat_28_compressed);
+    bitmap = lv_font_get_glyph_bitmap(&lv_font_montserrat_28_compressed, 'W');
+    TEST_ASSERT_EQUAL_MEMORY(copy, bitmap, g.box_w * g.box_h);
+}
+
+void test_font_cache_not_cached_glyphs(void)
+{
+    lv_font_glyph_dsc_t g;
+
+    /*Plain fonts are drawn directly*/
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&lv_font_montserrat_28, &g, 'A', 0));
+    TEST_ASSERT_EQUAL(4, g.bpp);
+
+    /*Tabs are drawn with the original format*/
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&lv_font_montserrat_28_compressed, &g, '\t', 0));
+    TEST_ASSERT_EQUAL(4, g.bpp);
+}
+
+#endif
+
+#endif
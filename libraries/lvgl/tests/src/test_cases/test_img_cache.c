@@ -0,0 +1,221 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <string.h>
+
+#define IMG_W       10
+#define IMG_H       10
+#define IMG_PATTERN 0x5A
+
+static lv_img_decoder_t * decoder;
+static uint32_t open_cnt;
+static uint32_t close_cnt;
+static uint32_t img_size;
+
+static lv_img_cache_mem_t hint_internal_cb(const lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(dsc);
+    return LV_IMG_CACHE_MEM_INTERNAL;
+}
+
+/*Decode the "T:..." paths to a solid image. The "T:slow..." images report a long time to open.*/
+static lv_res_t test_info_cb(lv_img_decoder_t * dec, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(dec);
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_FILE) return LV_RES_INV;
+    if(strncmp(src, "T:", 2) != 0) return LV_RES_INV;
+
+    header->w = IMG_W;
+    header->h = IMG_H;
+    header->cf = LV_IMG_CF_TRUE_COLOR;
+    header->always_zero = 0;
+    return LV_RES_OK;
+}
+
+static lv_res_t test_open_cb(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(dec);
+    uint8_t * data = lv_mem_alloc(img_size);
+    TEST_ASSERT_NOT_NULL(data);
+    lv_memset(data, IMG_PATTERN, img_size);
+    dsc->img_data = data;
+    if(strncmp(dsc->src, "T:slow", 6) == 0) dsc->time_to_open = 100;
+    else dsc->time_to_open = 1;
+    open_cnt++;
+    return LV_RES_OK;
+}
+
+static void test_close_cb(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(dec);
+    lv_mem_free((void *)dsc->img_data);
+    dsc->img_data = NULL;
+    close_cnt++;
+}
+
+static _lv_img_cache_entry_t * open_img(const void * src)
+{
+    return _lv_img_cache_open(src, lv_color_black(), 0);
+}
+
+void setUp(void)
+{
+    decoder = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(decoder, test_info_cb);
+    lv_img_decoder_set_open_cb(decoder, test_open_cb);
+    lv_img_decoder_set_close_cb(decoder, test_close_cb);
+
+    lv_img_cache_set_size(8);
+    lv_img_cache_set_max_bytes(0);
+    lv_img_cache_set_mem_hint_cb(NULL);
+
+    open_cnt = 0;
+    close_cnt = 0;
+    img_size = lv_img_buf_get_img_size(IMG_W, IMG_H, LV_IMG_CF_TRUE_COLOR);
+}
+
+void tearDown(void)
+{
+    lv_img_cache_set_mem_hint_cb(NULL);
+    lv_img_cache_set_max_bytes(LV_IMG_CACHE_DEF_MAX_BYTES);
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+    lv_img_decoder_delete(decoder);
+}
+
+void test_img_cache_hit_does_not_reopen(void)
+{
+    _lv_img_cache_entry_t * e1 = open_img("T:a");
+    _lv_img_cache_entry_t * e2 = open_img("T:a");
+
+    TEST_ASSERT_NOT_NULL(e1);
+    TEST_ASSERT_EQUAL_PTR(e1, e2);
+    TEST_ASSERT_EQUAL_UINT32(1, open_cnt);
+
+    /*Other colors are other images*/
+    TEST_ASSERT_NOT_EQUAL(e1, _lv_img_cache_open("T:a", lv_color_white(), 0));
+    TEST_ASSERT_EQUAL_UINT32(2, open_cnt);
+}
+
+void test_img_cache_all_entries_are_found(void)
+{
+    static const char * paths[] = {"T:0", "T:1", "T:2", "T:3", "T:4", "T:5", "T:6", "T:7"};
+    uint32_t i;
+    for(i = 0; i < 8; i++) open_img(paths[i]);
+    for(i = 0; i < 8; i++) open_img(paths[i]);
+    TEST_ASSERT_EQUAL_UINT32(8, open_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, close_cnt);
+    TEST_ASSERT_EQUAL_UINT32(8 * img_size, lv_img_cache_get_used_bytes());
+
+    /*No more free entries*/
+    open_img("T:8");
+    TEST_ASSERT_EQUAL_UINT32(1, close_cnt);
+    TEST_ASSERT_EQUAL_UINT32(8 * img_size, lv_img_cache_get_used_bytes());
+}
+
+void test_img_cache_byte_limit(void)
+{
+    lv_img_cache_set_max_bytes(2 * img_size);
+
+    open_img("T:a");
+    open_img("T:b");
+    TEST_ASSERT_EQUAL_UINT32(0, close_cnt);
+
+    open_img("T:c");
+    TEST_ASSERT_EQUAL_UINT32(1, close_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2 * img_size, lv_img_cache_get_used_bytes());
+
+    /*Lowering the limit closes images right away*/
+    lv_img_cache_set_max_bytes(img_size);
+    TEST_ASSERT_EQUAL_UINT32(2, close_cnt);
+    TEST_ASSERT_EQUAL_UINT32(img_size, lv_img_cache_get_used_bytes());
+
+    /*The last opened image is kept even if it's larger than the limit*/
+    lv_img_cache_set_max_bytes(img_size / 2);
+    TEST_ASSERT_NOT_NULL(open_img("T:d"));
+    TEST_ASSERT_EQUAL_UINT32(img_size, lv_img_cache_get_used_bytes());
+}
+
+void test_img_cache_slow_images_are_kept(void)
+{
+    lv_img_cache_set_max_bytes(2 * img_size);
+
+    open_img("T:slow");
+    open_img("T:b");
+    open_img("T:c");
+    open_img("T:d");
+    TEST_ASSERT_EQUAL_UINT32(4, open_cnt);
+
+    open_img("T:slow");
+    TEST_ASSERT_EQUAL_UINT32(4, open_cnt);
+}
+
+void test_img_cache_invalidate_src(void)
+{
+    open_img("T:a");
+    open_img("T:b");
+
+    lv_img_cache_invalidate_src("T:a");
+    TEST_ASSERT_EQUAL_UINT32(1, close_cnt);
+    TEST_ASSERT_EQUAL_UINT32(img_size, lv_img_cache_get_used_bytes());
+
+    open_img("T:a");
+    open_img("T:b");
+    TEST_ASSERT_EQUAL_UINT32(3, open_cnt);
+
+    lv_img_cache_invalidate_src(NULL);
+    TEST_ASSERT_EQUAL_UINT32(3, close_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_img_cache_get_used_bytes());
+}
+
+void test_img_cache_mem_hint_copies_data(void)
+{
+    lv_img_cache_set_mem_hint_cb(hint_internal_cb);
+
+    _lv_img_cache_entry_t * e = open_img("T:a");
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL(LV_IMG_CACHE_MEM_INTERNAL, e->mem);
+
+    /*The decoder is closed right away and the copy is used*/
+    TEST_ASSERT_EQUAL_UINT32(1, close_cnt);
+    TEST_ASSERT_NOT_NULL(e->dec_dsc.img_data);
+    TEST_ASSERT_EACH_EQUAL_HEX8(IMG_PATTERN, e->dec_dsc.img_data, img_size);
+    TEST_ASSERT_EQUAL_UINT32(img_size, lv_img_cache_get_used_bytes());
+
+    TEST_ASSERT_EQUAL_PTR(e, open_img("T:a"));
+    TEST_ASSERT_EQUAL_UINT32(1, open_cnt);
+
+    /*Closing the entry frees only the copy*/
+    lv_img_cache_invalidate_src("T:a");
+    TEST_ASSERT_EQUAL_UINT32(1, close_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_img_cache_get_used_bytes());
+}
+
+void test_img_cache_c_array(void)
+{
+    static uint8_t pixels[IMG_W * IMG_H * LV_COLOR_SIZE / 8];
+    static lv_img_dsc_t img_dsc;
+    img_dsc.header.w = IMG_W;
+    img_dsc.header.h = IMG_H;
+    img_dsc.header.cf = LV_IMG_CF_TRUE_COLOR;
+    img_dsc.data_size = sizeof(pixels);
+    img_dsc.data = pixels;
+
+    /*The data of C arrays is used directly and doesn't count*/
+    _lv_img_cache_entry_t * e = open_img(&img_dsc);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_PTR(pixels, e->dec_dsc.img_data);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_img_cache_get_used_bytes());
+    lv_img_cache_invalidate_src(&img_dsc);
+
+    /*Unless it's copied to the RAM*/
+    lv_img_cache_set_mem_hint_cb(hint_internal_cb);
+    e = open_img(&img_dsc);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_NOT_EQUAL(pixels, e->dec_dsc.img_data);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(pixels), lv_img_cache_get_used_bytes());
+    lv_img_cache_invalidate_src(&img_dsc);
+}
+
+#endif
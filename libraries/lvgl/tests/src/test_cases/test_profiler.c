@@ -0,0 +1,194 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_PROFILER
+
+#include <string.h>
+
+typedef struct {
+    char buf[64 * 1024];
+    uint32_t len;
+} export_buf_t;
+
+static export_buf_t export_buf;
+
+static void export_cb(const void * data, uint32_t len, void * user_data)
+{
+    export_buf_t * eb = user_data;
+    TEST_ASSERT_LESS_THAN(sizeof(eb->buf), eb->len + len);
+    memcpy(&eb->buf[eb->len], data, len);
+    eb->len += len;
+    eb->buf[eb->len] = '\0';
+}
+
+static const char * class_name_cb(const void * class_p)
+{
+    if(class_p == &lv_label_class) return "lv_label";
+    return NULL;
+}
+
+void setUp(void)
+{
+    lv_profiler_stop();
+    lv_profiler_clear();
+    lv_profiler_set_class_name_cb(NULL);
+    export_buf.len = 0;
+    export_buf.buf[0] = '\0';
+}
+
+void tearDown(void)
+{
+    lv_profiler_stop();
+    lv_profiler_clear();
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_profiler_stopped_records_nothing(void)
+{
+    lv_label_create(lv_scr_act());
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(0, lv_profiler_get_count());
+}
+
+void test_profiler_records_refresh_stages(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "Profiled");
+
+    lv_profiler_start(LV_PROFILER_EVENT_MASK_ALL);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_profiler_stop();
+
+    bool found[_LV_PROFILER_EVENT_LAST] = {false};
+    bool label_found = false;
+    lv_profiler_record_t rec;
+    while(lv_profiler_read(&rec)) {
+        TEST_ASSERT_LESS_THAN(_LV_PROFILER_EVENT_LAST, rec.event);
+        found[rec.event] = true;
+        if(rec.event == LV_PROFILER_EVENT_REFR_OBJ && rec.obj == label) {
+            TEST_ASSERT_EQUAL_PTR(&lv_label_class, rec.class_p);
+            label_found = true;
+        }
+    }
+
+    TEST_ASSERT_TRUE(found[LV_PROFILER_EVENT_REFR]);
+    TEST_ASSERT_TRUE(found[LV_PROFILER_EVENT_LAYOUT]);
+    TEST_ASSERT_TRUE(found[LV_PROFILER_EVENT_REFR_OBJ]);
+    TEST_ASSERT_TRUE(found[LV_PROFILER_EVENT_BLEND]);
+    TEST_ASSERT_TRUE(found[LV_PROFILER_EVENT_FLUSH]);
+    TEST_ASSERT_TRUE(label_found);
+}
+
+void test_profiler_event_mask(void)
+{
+    lv_label_create(lv_scr_act());
+
+    lv_profiler_start(1 << LV_PROFILER_EVENT_FLUSH);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_profiler_stop();
+
+    TEST_ASSERT_GREATER_THAN(0, lv_profiler_get_count());
+    lv_profiler_record_t rec;
+    while(lv_profiler_read(&rec)) {
+        TEST_ASSERT_EQUAL(LV_PROFILER_EVENT_FLUSH, rec.event);
+    }
+}
+
+void test_profiler_ring_buffer_overflow(void)
+{
+    lv_profiler_start(LV_PROFILER_EVENT_MASK_ALL);
+    uint32_t i;
+    for(i = 0; i < LV_PROFILER_BUF_SIZE + 10; i++) {
+        LV_PROFILER_BEGIN(LV_PROFILER_EVENT_MASK, ts);
+        LV_PROFILER_END(LV_PROFILER_EVENT_MASK, ts, NULL, NULL);
+    }
+    lv_profiler_stop();
+
+    TEST_ASSERT_EQUAL_UINT32(LV_PROFILER_BUF_SIZE, lv_profiler_get_count());
+    TEST_ASSERT_EQUAL_UINT32(10, lv_profiler_get_dropped());
+
+    lv_profiler_clear();
+    TEST_ASSERT_EQUAL_UINT32(0, lv_profiler_get_count());
+    TEST_ASSERT_EQUAL_UINT32(0, lv_profiler_get_dropped());
+}
+
+void test_profiler_dropped_counts_from_clear(void)
+{
+    lv_profiler_start(LV_PROFILER_EVENT_MASK_ALL);
+    uint32_t i;
+    for(i = 0; i < LV_PROFILER_BUF_SIZE + 10; i++) {
+        LV_PROFILER_BEGIN(LV_PROFILER_EVENT_MASK, ts);
+        LV_PROFILER_END(LV_PROFILER_EVENT_MASK, ts, NULL, NULL);
+    }
+    lv_profiler_clear();
+
+    /*The counter of the producer is not reset, the new drops are counted from the clear*/
+    for(i = 0; i < LV_PROFILER_BUF_SIZE + 3; i++) {
+        LV_PROFILER_BEGIN(LV_PROFILER_EVENT_MASK, ts);
+        LV_PROFILER_END(LV_PROFILER_EVENT_MASK, ts, NULL, NULL);
+    }
+    lv_profiler_stop();
+
+    TEST_ASSERT_EQUAL_UINT32(3, lv_profiler_get_dropped());
+    lv_profiler_export_chrome(export_cb, &export_buf);
+    TEST_ASSERT_NOT_NULL(strstr(export_buf.buf, "\"dropped\":3}}"));
+}
+
+void test_profiler_export_chrome(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "Trace");
+    lv_profiler_set_class_name_cb(class_name_cb);
+
+    lv_profiler_start(1 << LV_PROFILER_EVENT_REFR_OBJ | 1 << LV_PROFILER_EVENT_REFR);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_profiler_stop();
+
+    uint32_t cnt = lv_profiler_get_count();
+    TEST_ASSERT_EQUAL_UINT32(cnt, lv_profiler_export_chrome(export_cb, &export_buf));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_profiler_get_count());
+
+    TEST_ASSERT_EQUAL_STRING_LEN("{\"traceEvents\":[", export_buf.buf, 16);
+    TEST_ASSERT_NOT_NULL(strstr(export_buf.buf, "\"name\":\"refr\""));
+    TEST_ASSERT_NOT_NULL(strstr(export_buf.buf, "\"name\":\"lv_label\""));
+    TEST_ASSERT_NOT_NULL(strstr(export_buf.buf, "\"name\":\"refr_obj\""));
+    TEST_ASSERT_NOT_NULL(strstr(export_buf.buf, "\"dropped\":0}}"));
+}
+
+void test_profiler_export_binary(void)
+{
+    lv_profiler_start(LV_PROFILER_EVENT_MASK_ALL);
+    LV_PROFILER_BEGIN(LV_PROFILER_EVENT_LAYOUT, ts1);
+    LV_PROFILER_END(LV_PROFILER_EVENT_LAYOUT, ts1, NULL, NULL);
+    LV_PROFILER_BEGIN(LV_PROFILER_EVENT_REFR_OBJ, ts2);
+    LV_PROFILER_END(LV_PROFILER_EVENT_REFR_OBJ, ts2, (void *)0x12345678, (void *)0xABCDEF00);
+    lv_profiler_stop();
+
+    TEST_ASSERT_EQUAL_UINT32(2, lv_profiler_export_binary(export_cb, &export_buf));
+    TEST_ASSERT_EQUAL_UINT32(LV_PROFILER_BIN_HEADER_SIZE + 2 * LV_PROFILER_BIN_RECORD_SIZE, export_buf.len);
+
+    const uint8_t * b = (const uint8_t *)export_buf.buf;
+    TEST_ASSERT_EQUAL_MEMORY(LV_PROFILER_BIN_MAGIC, b, 4);
+    TEST_ASSERT_EQUAL_UINT8(LV_PROFILER_BIN_VERSION, b[4]);
+    TEST_ASSERT_EQUAL_UINT8(LV_PROFILER_BIN_RECORD_SIZE, b[6]);
+    TEST_ASSERT_EQUAL_UINT8(2, b[8]);
+
+    const uint8_t * r1 = b + LV_PROFILER_BIN_HEADER_SIZE;
+    const uint8_t * r2 = r1 + LV_PROFILER_BIN_RECORD_SIZE;
+    TEST_ASSERT_EQUAL_UINT8(LV_PROFILER_EVENT_LAYOUT, r1[16]);
+    TEST_ASSERT_EQUAL_UINT8(LV_PROFILER_EVENT_REFR_OBJ, r2[16]);
+    TEST_ASSERT_EQUAL_UINT8(0x78, r2[8]);
+    TEST_ASSERT_EQUAL_UINT8(0x12, r2[11]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, r2[12]);
+    TEST_ASSERT_EQUAL_UINT8(0xAB, r2[15]);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,145 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static lv_obj_t * parent;
+static lv_obj_t * obj;
+
+/*Don't animate the state changes*/
+static const lv_style_prop_t no_trans_props[] = {0};
+static lv_style_transition_dsc_t no_trans;
+
+void setUp(void)
+{
+    lv_style_transition_dsc_init(&no_trans, no_trans_props, lv_anim_path_linear, 0, 0, NULL);
+    parent = lv_obj_create(lv_scr_act());
+    obj = lv_obj_create(parent);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_style_cache_local_prop_change(void)
+{
+    lv_obj_set_style_bg_opa(obj, 10, 0);
+    TEST_ASSERT_EQUAL(10, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(10, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+
+    lv_obj_set_style_bg_opa(obj, 20, 0);
+    TEST_ASSERT_EQUAL(20, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_BG_OPA, 0);
+    lv_obj_set_style_bg_opa(obj, 30, LV_PART_SCROLLBAR);
+    TEST_ASSERT_EQUAL(30, lv_obj_get_style_bg_opa(obj, LV_PART_SCROLLBAR));
+    TEST_ASSERT_NOT_EQUAL(20, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+}
+
+void test_style_cache_refresh_disabled(void)
+{
+    lv_obj_set_style_pad_top(obj, 5, 0);
+    TEST_ASSERT_EQUAL(5, lv_obj_get_style_pad_top(obj, LV_PART_MAIN));
+
+    lv_obj_enable_style_refresh(false);
+    lv_obj_set_style_pad_top(obj, 6, 0);
+    lv_obj_enable_style_refresh(true);
+    TEST_ASSERT_EQUAL(6, lv_obj_get_style_pad_top(obj, LV_PART_MAIN));
+}
+
+void test_style_cache_shared_style_change(void)
+{
+    static lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_border_width(&style, 3);
+    lv_obj_add_style(obj, &style, 0);
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+
+    /*Without reporting the change too*/
+    lv_style_set_border_width(&style, 4);
+    TEST_ASSERT_EQUAL(4, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+
+    lv_style_remove_prop(&style, LV_STYLE_BORDER_WIDTH);
+    lv_style_set_border_width(&style, 7);
+    lv_obj_report_style_change(&style);
+    TEST_ASSERT_EQUAL(7, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+
+    lv_obj_remove_style(obj, &style, 0);
+    TEST_ASSERT_NOT_EQUAL(7, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+
+    lv_style_reset(&style);
+}
+
+void test_style_cache_state_change(void)
+{
+    lv_obj_set_style_transition(obj, &no_trans, 0);
+    lv_obj_set_style_radius(obj, 1, LV_STATE_DEFAULT);
+    lv_obj_set_style_radius(obj, 2, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(1, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(2, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+
+    lv_obj_clear_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(1, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+}
+
+void test_style_cache_temporary_state(void)
+{
+    lv_obj_set_style_radius(obj, 1, LV_STATE_DEFAULT);
+    lv_obj_set_style_radius(obj, 2, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL(1, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+
+    /*Widgets draw some parts in a different state this way*/
+    lv_state_t state_ori = obj->state;
+    obj->state = LV_STATE_CHECKED;
+    obj->skip_trans = 1;
+    TEST_ASSERT_EQUAL(2, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    obj->state = state_ori;
+    obj->skip_trans = 0;
+
+    TEST_ASSERT_EQUAL(1, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+}
+
+void test_style_cache_inherited_from_parent(void)
+{
+    lv_obj_set_style_text_letter_space(parent, 1, 0);
+    TEST_ASSERT_EQUAL(1, lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN));
+
+    lv_obj_set_style_text_letter_space(parent, 2, 0);
+    TEST_ASSERT_EQUAL(2, lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN));
+
+    lv_obj_set_style_transition(parent, &no_trans, 0);
+    lv_obj_set_style_text_letter_space(parent, 3, LV_STATE_FOCUSED);
+    lv_obj_add_state(parent, LV_STATE_FOCUSED);
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN));
+}
+
+void test_style_cache_parent_change(void)
+{
+    lv_obj_t * parent2 = lv_obj_create(lv_scr_act());
+    lv_obj_t * obj2 = lv_obj_create(parent2);
+    lv_obj_set_style_text_line_space(parent, 4, 0);
+    lv_obj_set_style_text_line_space(parent2, 5, 0);
+    TEST_ASSERT_EQUAL(4, lv_obj_get_style_text_line_space(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(5, lv_obj_get_style_text_line_space(obj2, LV_PART_MAIN));
+
+    lv_obj_set_parent(obj, parent2);
+    lv_obj_set_parent(obj2, parent);
+    TEST_ASSERT_EQUAL(5, lv_obj_get_style_text_line_space(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(4, lv_obj_get_style_text_line_space(obj2, LV_PART_MAIN));
+}
+
+void test_style_cache_deleted_object(void)
+{
+    lv_obj_set_style_text_line_space(parent, 4, 0);
+    TEST_ASSERT_EQUAL(4, lv_obj_get_style_text_line_space(obj, LV_PART_MAIN));
+
+    /*The new object is likely allocated at the same address*/
+    lv_obj_del(obj);
+    obj = lv_obj_create(lv_scr_act());
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_text_line_space(obj, LV_PART_MAIN));
+}
+
+#endif
@@ -0,0 +1,255 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define PAUSED_MAX 16
+
+static lv_timer_t * paused_timers[PAUSED_MAX];
+static uint32_t paused_cnt;
+static uint32_t run_cnt;
+static lv_timer_t * other_timer;
+
+static void count_cb(lv_timer_t * timer)
+{
+    uint32_t * cnt = timer->user_data;
+    (*cnt)++;
+}
+
+static void del_self_cb(lv_timer_t * timer)
+{
+    run_cnt++;
+    lv_timer_del(timer);
+}
+
+static void del_other_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    run_cnt++;
+    if(other_timer) {
+        lv_timer_del(other_timer);
+        other_timer = NULL;
+    }
+}
+
+static void create_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    run_cnt++;
+    other_timer = lv_timer_create(count_cb, 0, &run_cnt);
+}
+
+static void pause_self_cb(lv_timer_t * timer)
+{
+    run_cnt++;
+    lv_timer_pause(timer);
+}
+
+static bool timer_exists(lv_timer_t * timer)
+{
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t) {
+        if(t == timer) return true;
+        t = lv_timer_get_next(t);
+    }
+    return false;
+}
+
+void setUp(void)
+{
+    /*Pause the timers of the display and the input devices to make the tests deterministic*/
+    paused_cnt = 0;
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t) {
+        if(!t->paused && paused_cnt < PAUSED_MAX) {
+            lv_timer_pause(t);
+            paused_timers[paused_cnt++] = t;
+        }
+        t = lv_timer_get_next(t);
+    }
+
+    run_cnt = 0;
+    other_timer = NULL;
+}
+
+void tearDown(void)
+{
+    uint32_t i;
+    for(i = 0; i < paused_cnt; i++) lv_timer_resume(paused_timers[i]);
+}
+
+void test_timer_runs_at_most_once_per_handler(void)
+{
+    lv_timer_t * timer = lv_timer_create(count_cb, 0, &run_cnt);
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+
+    lv_timer_del(timer);
+}
+
+void test_timer_not_ready_is_not_run(void)
+{
+    lv_timer_t * timer = lv_timer_create(count_cb, 100000, &run_cnt);
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(0, run_cnt);
+
+    lv_timer_ready(timer);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+
+    lv_timer_del(timer);
+}
+
+void test_timer_time_till_next(void)
+{
+    lv_timer_t * timer_long = lv_timer_create(count_cb, 100000, &run_cnt);
+    TEST_ASSERT_UINT32_WITHIN(100, 100000, lv_timer_handler());
+
+    lv_timer_t * timer_short = lv_timer_create(count_cb, 50000, &run_cnt);
+    TEST_ASSERT_UINT32_WITHIN(100, 50000, lv_timer_handler());
+
+    lv_timer_set_period(timer_short, 200000);
+    TEST_ASSERT_UINT32_WITHIN(100, 100000, lv_timer_handler());
+
+    lv_timer_pause(timer_long);
+    TEST_ASSERT_UINT32_WITHIN(100, 200000, lv_timer_handler());
+
+    lv_timer_pause(timer_short);
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_handler());
+
+    TEST_ASSERT_EQUAL_UINT32(0, run_cnt);
+
+    lv_timer_del(timer_long);
+    lv_timer_del(timer_short);
+}
+
+void test_timer_repeat_count(void)
+{
+    lv_timer_t * timer = lv_timer_create(count_cb, 0, &run_cnt);
+    lv_timer_set_repeat_count(timer, 2);
+
+    lv_timer_handler();
+    TEST_ASSERT_TRUE(timer_exists(timer));
+    lv_timer_handler();
+    TEST_ASSERT_FALSE(timer_exists(timer));
+    lv_timer_handler();
+
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+}
+
+void test_timer_zero_repeat_count_deletes_on_next_handler(void)
+{
+    lv_timer_t * timer = lv_timer_create(count_cb, 100000, &run_cnt);
+    lv_timer_set_repeat_count(timer, 0);
+
+    lv_timer_handler();
+    TEST_ASSERT_FALSE(timer_exists(timer));
+    TEST_ASSERT_EQUAL_UINT32(0, run_cnt);
+}
+
+void test_timer_pause_and_resume(void)
+{
+    lv_timer_t * timer = lv_timer_create(count_cb, 0, &run_cnt);
+    lv_timer_pause(timer);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(0, run_cnt);
+
+    lv_timer_resume(timer);
+    lv_timer_resume(timer);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+
+    lv_timer_del(timer);
+}
+
+void test_timer_delete_itself(void)
+{
+    lv_timer_t * timer = lv_timer_create(del_self_cb, 0, NULL);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    TEST_ASSERT_FALSE(timer_exists(timer));
+}
+
+void test_timer_delete_other_timer(void)
+{
+    uint32_t other_cnt = 0;
+    other_timer = lv_timer_create(count_cb, 100000, &other_cnt);
+    lv_timer_t * timer = lv_timer_create(del_other_cb, 0, NULL);
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    TEST_ASSERT_NULL(other_timer);
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, other_cnt);
+
+    lv_timer_del(timer);
+}
+
+void test_timer_create_in_callback(void)
+{
+    lv_timer_t * timer = lv_timer_create(create_cb, 100000, NULL);
+    lv_timer_ready(timer);
+
+    /*The new ready timer runs in the same call*/
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+    TEST_ASSERT_TRUE(timer_exists(other_timer));
+
+    lv_timer_del(other_timer);
+    lv_timer_del(timer);
+}
+
+void test_timer_pause_in_callback(void)
+{
+    lv_timer_t * timer = lv_timer_create(pause_self_cb, 0, NULL);
+    lv_timer_handler();
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+
+    lv_timer_resume(timer);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+
+    lv_timer_del(timer);
+}
+
+void test_timer_many(void)
+{
+    enum { TIMER_CNT = 100 };
+    lv_timer_t * timers[TIMER_CNT];
+    uint32_t cnts[TIMER_CNT] = {0};
+    uint32_t i;
+
+    for(i = 0; i < TIMER_CNT; i++) {
+        timers[i] = lv_timer_create(count_cb, 100000 + i * 1000, &cnts[i]);
+    }
+
+    /*Make every third timer ready and delete some others*/
+    for(i = 0; i < TIMER_CNT; i++) {
+        if(i % 3 == 0) lv_timer_ready(timers[i]);
+        else if(i % 7 == 0) {
+            lv_timer_del(timers[i]);
+            timers[i] = NULL;
+        }
+    }
+
+    uint32_t time_till_next = lv_timer_handler();
+    TEST_ASSERT_UINT32_WITHIN(100, 100000, time_till_next);
+
+    for(i = 0; i < TIMER_CNT; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i % 3 == 0 ? 1 : 0, cnts[i]);
+        if(timers[i]) lv_timer_del(timers[i]);
+    }
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "ui_events.h"
+#include "ui_sounds.h"
 #include <Arduino.h>  // For Serial, millis(), etc.
 
 // UI interaction constants (these are local to UI events)
@@ -240,8 +241,10 @@ void lamp_button_event_cb(lv_event_t * e) {
       Serial.println(" DOUBLE-TAP - toggling lamp");
       if (MQTTclient.connected()) {
         toggleLamp(lamp);
+        playUISound(UI_SOUND_NOTIFICATION);
       } else {
         Serial.println("MQTT not connected - cannot toggle lamp");
+        playUISound(UI_SOUND_ERROR);
       }
       lastTapTime[index + 1] = 0;
     } else {
@@ -272,8 +275,10 @@ void ui_acbutton_event_cb(lv_event_t * e) {
     
     if (MQTTclient.connected()) {
       toggleStanAC();
+      playUISound(UI_SOUND_NOTIFICATION);
     } else {
       Serial.println("MQTT not connected - cannot toggle Stan AC");
+      playUISound(UI_SOUND_ERROR);
     }
   }
   else if (event_code == LV_EVENT_PRESSED) {
@@ -298,8 +303,10 @@ void ui_acbuttonOFF_event_cb(lv_event_t * e) {
     
     if (MQTTclient.connected()) {
       toggleLabAC();
+      playUISound(UI_SOUND_NOTIFICATION);
     } else {
       Serial.println("MQTT not connected - cannot toggle Lab AC");
+      playUISound(UI_SOUND_ERROR);
     }
   }
   else if (event_code == LV_EVENT_PRESSED) {
@@ -324,8 +331,10 @@ void ui_SvaSvetla_event_cb(lv_event_t * e) {
     
     if (MQTTclient.connected()) {
       triggerSvaSvetla();
+      playUISound(UI_SOUND_NOTIFICATION);
     } else {
       Serial.println("MQTT not connected - cannot trigger all lights automation");
+      playUISound(UI_SOUND_ERROR);
     }
   }
   else if (event_code == LV_EVENT_PRESSED) {
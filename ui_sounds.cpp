@@ -0,0 +1,52 @@
+#include "ui_sounds.h"
+#include "hardware_config.h"
+
+const uint8_t uiSoundVolume = 80; // 80% of full scale
+
+#if ENABLE_AUDIO_OUTPUT && ENABLE_SD_CARD
+#include <SD_MMC.h>
+#include <Audio.h>
+
+static Audio audio;  // the audio task of the library mixes the sound effects, also when no stream is played
+
+static const char* soundPaths[UI_SOUND_COUNT] = {NOTIFICATION_SOUND, STARTUP_SOUND, ERROR_SOUND};
+static int8_t soundIds[UI_SOUND_COUNT] = {-1, -1, -1};
+
+void initUISounds() {
+  // D1 and D2 share a pin (see hardware_config.h), so the card runs in 1-bit mode
+  SD_MMC.setPins(SD_MMC_CLK_PIN, SD_MMC_CMD_PIN, SD_MMC_D0_PIN);
+  if (!SD_MMC.begin(SD_CARD_MOUNT_POINT, true, false, SDMMC_FREQ_DEFAULT, SD_CARD_MAX_FILES)) {
+    Serial.println("SD card mount failed - UI sounds disabled");
+    return;
+  }
+
+#if ENABLE_AUDIO_MUTE
+  pinMode(AUDIO_MUTE_PIN, OUTPUT);
+  digitalWrite(AUDIO_MUTE_PIN, HIGH); // unmute
+#endif
+  audio.setPinout(AUDIO_I2S_BCK_IO, AUDIO_I2S_WS_IO, AUDIO_I2S_DO_IO, AUDIO_I2S_MCK_IO);
+
+  // The paths in hardware_config.h include the mount point, the FS API expects them relative to it
+  const size_t mountLen = strlen(SD_CARD_MOUNT_POINT);
+  for (int i = 0; i < UI_SOUND_COUNT; i++) {
+    const char* path = soundPaths[i];
+    if (strncmp(path, SD_CARD_MOUNT_POINT, mountLen) == 0) path += mountLen;
+    soundIds[i] = audio.loadSoundEffect(SD_MMC, path);
+    if (soundIds[i] < 0) {
+      Serial.print("UI sound not loaded: ");
+      Serial.println(soundPaths[i]);
+    }
+  }
+}
+
+void playUISound(UISound sound) {
+  if (sound >= UI_SOUND_COUNT || soundIds[sound] < 0) return;
+  audio.playSoundEffect(soundIds[sound], uiSoundVolume);
+}
+
+#else
+
+void initUISounds() {}
+void playUISound(UISound) {}
+
+#endif
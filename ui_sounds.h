@@ -0,0 +1,22 @@
+#ifndef UI_SOUNDS_H
+#define UI_SOUNDS_H
+
+#include <Arduino.h>
+
+// UI sound effects from the SD card (paths in hardware_config.h). The clips are decoded once at startup and mixed
+// over whatever the audio output plays, a sound starts within a few milliseconds and never stops a stream.
+enum UISound {
+  UI_SOUND_NOTIFICATION,
+  UI_SOUND_STARTUP,
+  UI_SOUND_ERROR,
+  UI_SOUND_COUNT
+};
+
+// Volume of the UI sounds in percent, independent of the stream volume
+extern const uint8_t uiSoundVolume;
+
+// Function declarations
+void initUISounds();              // mounts the SD card, starts the I2S output and loads the clips
+void playUISound(UISound sound);  // returns immediately, may be called from LVGL callbacks
+
+#endif